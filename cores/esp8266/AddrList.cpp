@@ -0,0 +1,122 @@
+/*
+ AddrList.cpp - cached snapshot of lwIP netif addresses
+
+ Copyright (c) 2018 david gauchard. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "AddrList.h"
+
+#include <Schedule.h>
+
+esp8266::AddressListImplementation::AddressList addrList;
+
+namespace esp8266
+{
+
+namespace AddressListImplementation
+{
+
+// one configured address of the snapshot; the address value is copied so
+// a comparison doesn't have to dereference a possibly-gone netif
+struct cacheEntry
+{
+    netif* intf;
+    int num;
+    u8_t flags; // to catch up/down flips that keep the address
+    ip_addr_t addr;
+};
+
+static cacheEntry s_cache[AddressList::maxCached];
+static size_t s_count = 0;
+static uint32_t s_generation = 0;
+
+static constexpr size_t maxChangeCB = 3;
+static std::function<void()> s_changeCB[maxChangeCB];
+static size_t s_changeCBCount = 0;
+
+void AddressList::refresh ()
+{
+    cacheEntry fresh[maxCached];
+    size_t n = 0;
+    for (netif* intf = netif_list; intf && n < maxCached; intf = intf->next)
+    {
+        for (int num = 0; num < IF_NUM_ADDRESSES && n < maxCached; num++)
+        {
+            netifWrapper w(intf);
+            w._num = num;
+            const ip_addr_t* a = w.ipFromNetifNum();
+            if (ip_addr_isany(a))
+                continue;
+            fresh[n].intf = intf;
+            fresh[n].num = num;
+            fresh[n].flags = intf->flags;
+            fresh[n].addr = *a;
+            n++;
+        }
+    }
+
+    bool changed = n != s_count;
+    for (size_t i = 0; !changed && i < n; i++)
+        changed = fresh[i].intf != s_cache[i].intf
+               || fresh[i].num != s_cache[i].num
+               || fresh[i].flags != s_cache[i].flags
+               || !ip_addr_cmp(&fresh[i].addr, &s_cache[i].addr);
+    if (!changed)
+        return;
+
+    for (size_t i = 0; i < n; i++)
+        s_cache[i] = fresh[i];
+    s_count = n;
+    s_generation++;
+
+    // the status callback runs in lwIP context: hand the events to loop()
+    for (size_t i = 0; i < s_changeCBCount; i++)
+        schedule_function(s_changeCB[i]);
+}
+
+size_t AddressList::count () const
+{
+    return s_count;
+}
+
+netifWrapper AddressList::cached (size_t i) const
+{
+    if (i >= s_count)
+        return netifWrapper(nullptr);
+    netifWrapper w(s_cache[i].intf);
+    w._num = s_cache[i].num;
+    return w;
+}
+
+uint32_t AddressList::generation () const
+{
+    return s_generation;
+}
+
+bool AddressList::onChange (std::function<void()> cb)
+{
+    if (s_changeCBCount >= maxChangeCB)
+        return false;
+    refresh(); // seed the snapshot so the first event is a real change
+    s_changeCB[s_changeCBCount++] = std::move(cb);
+    return true;
+}
+
+} // AddressListImplementation
+
+} // esp8266
@@ -78,6 +78,8 @@
 #include <IPAddress.h>
 #include <lwip/netif.h>
 
+#include <functional>
+
 #if LWIP_IPV6
 #define IF_NUM_ADDRESSES (1 + LWIP_IPV6_NUM_ADDRESSES)
 #else
@@ -205,6 +207,31 @@ public:
   const_iterator begin () const { return const_iterator(netif_list); }
   const_iterator   end () const { return const_iterator(nullptr); }
 
+  // --- cached snapshot (AddrList.cpp) ---
+  // A table of the configured addresses is refreshed from lwIP's netif
+  // status callback, so steady-state queries are O(1) reads instead of a
+  // netif_list walk per loop().
+
+  static constexpr size_t maxCached = 8;
+
+  // number of configured addresses in the snapshot
+  size_t count () const;
+
+  // i-th cached address, i < count(); wraps a dead netif (_netif nullptr)
+  // when out of range
+  netifWrapper cached (size_t i) const;
+
+  // bumped on every interface or address change: keep the last seen value
+  // and compare for poll-free change detection
+  uint32_t generation () const;
+
+  // invoke cb from loop() context (scheduled) after every interface or
+  // address change; false when the callback slots are exhausted
+  bool onChange (std::function<void()> cb);
+
+  // rescan netif_list into the snapshot; called from the netif status
+  // callback (LwipIntfCB.cpp), public for manual seeding
+  void refresh ();
 };
 
 inline AddressList::const_iterator begin (const AddressList& a) { return a.begin(); }
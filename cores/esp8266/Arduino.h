@@ -171,15 +171,37 @@ void digitalWrite(uint8_t pin, uint8_t val);
 int digitalRead(uint8_t pin);
 int analogRead(uint8_t pin);
 void analogReference(uint8_t mode);
+// Continuous ADC acquisition: timer1-paced sampling into ping-pong buffers,
+// completed buffers delivered to `cb` from the scheduled-function queue.
+// Claims timer1 (mutually exclusive with analogWrite/Tone/Servo) until
+// analogSamplingStop() is called.
+bool analogSamplingStart(uint32_t rate_hz, size_t buffer_len, void (*cb)(uint16_t* samples, size_t count));
+void analogSamplingStop(void);
 void analogWrite(uint8_t pin, int val);
 void analogWriteMode(uint8_t pin, int val, bool openDrain);
 void analogWriteFreq(uint32_t freq);
+// Give 'pin' its own PWM frequency domain and duty range, decoupled from the
+// shared analogWriteFreq()/analogWriteRange() settings, so e.g. 1 kHz 10-bit
+// dimming and 25 kHz 8-bit fan control coexist. freq == 0 returns the pin to
+// the shared settings. See core_esp8266_wiring_pwm.cpp for the NMI load budget.
+void analogWriteFreqPin(uint8_t pin, uint32_t freq, uint32_t range);
 void analogWriteResolution(int res);
 void analogWriteRange(uint32_t range);
 
 unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout);
 unsigned long pulseInLong(uint8_t pin, uint8_t state, unsigned long timeout);
 
+// Asynchronous pulse measurement: arm several pins at once, edges are
+// timestamped by the GPIO interrupt while the sketch keeps running.
+// Poll pulseInAsyncDone()/pulseInAsyncResult() (result is one-shot and
+// re-idles the pin; 0 means timeout), or pass a callback which is invoked
+// from the scheduled-function queue with the width in microseconds.
+typedef void (*pulse_complete_cb_t)(uint8_t pin, unsigned long duration_us);
+bool pulseInAsyncStart(uint8_t pin, uint8_t state, unsigned long timeout, pulse_complete_cb_t callback);
+bool pulseInAsyncDone(uint8_t pin);
+unsigned long pulseInAsyncResult(uint8_t pin);
+void pulseInAsyncStop(uint8_t pin);
+
 void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
 
@@ -254,6 +276,7 @@ uint16_t makeWord(byte h, byte l);
 
 unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout = 1000000L);
 unsigned long pulseInLong(uint8_t pin, uint8_t state, unsigned long timeout = 1000000L);
+bool pulseInAsyncStart(uint8_t pin, uint8_t state, unsigned long timeout = 1000000L, pulse_complete_cb_t callback = nullptr);
 
 void tone(uint8_t _pin, unsigned int frequency, unsigned long duration = 0);
 void tone(uint8_t _pin, int frequency, unsigned long duration = 0);
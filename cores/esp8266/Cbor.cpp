@@ -0,0 +1,521 @@
+/*
+ Cbor.cpp - streaming CBOR (RFC 8949) encoder and incremental decoder
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Cbor.h"
+
+#include <math.h>
+#include <pgmspace.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace
+{
+
+// major types (RFC 8949 section 3)
+constexpr uint8_t MajorUnsigned = 0;
+constexpr uint8_t MajorNegative = 1;
+constexpr uint8_t MajorBytes = 2;
+constexpr uint8_t MajorText = 3;
+constexpr uint8_t MajorArray = 4;
+constexpr uint8_t MajorMap = 5;
+constexpr uint8_t MajorTag = 6;
+constexpr uint8_t MajorSimple = 7;
+
+constexpr uint8_t BreakByte = 0xff;
+constexpr uint64_t Indefinite = ~0ull;
+
+// IEEE 754 half precision, used by compact encoders for e.g. sensor values
+double halfToDouble(uint16_t h)
+{
+    const unsigned exp = (h >> 10) & 0x1f;
+    const unsigned mant = h & 0x3ff;
+    double v;
+    if (exp == 0)
+    {
+        v = ldexp(mant, -24);
+    }
+    else if (exp != 31)
+    {
+        v = ldexp(mant + 1024, exp - 25);
+    }
+    else
+    {
+        v = mant ? NAN : INFINITY;
+    }
+    return (h & 0x8000) ? -v : v;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------
+// CborWriter
+
+// shortest encoding of a major type and its integer argument
+void CborWriter::typeValue(uint8_t major, uint64_t v)
+{
+    const uint8_t m = major << 5;
+    if (v < 24)
+    {
+        _out.write(m | (uint8_t)v);
+        return;
+    }
+    uint8_t extra;
+    if (v <= 0xff)
+    {
+        extra = 1;
+        _out.write(m | 24);
+    }
+    else if (v <= 0xffff)
+    {
+        extra = 2;
+        _out.write(m | 25);
+    }
+    else if (v <= 0xffffffff)
+    {
+        extra = 4;
+        _out.write(m | 26);
+    }
+    else
+    {
+        extra = 8;
+        _out.write(m | 27);
+    }
+    while (extra--)
+    {
+        _out.write((uint8_t)(v >> (8 * extra)));
+    }
+}
+
+CborWriter& CborWriter::beginArray(size_t items)
+{
+    typeValue(MajorArray, items);
+    return *this;
+}
+
+CborWriter& CborWriter::beginMap(size_t pairs)
+{
+    typeValue(MajorMap, pairs);
+    return *this;
+}
+
+CborWriter& CborWriter::beginArrayIndefinite()
+{
+    _out.write((uint8_t)(MajorArray << 5 | 31));
+    ++_depth;
+    return *this;
+}
+
+CborWriter& CborWriter::beginMapIndefinite()
+{
+    _out.write((uint8_t)(MajorMap << 5 | 31));
+    ++_depth;
+    return *this;
+}
+
+CborWriter& CborWriter::end()
+{
+    if (!_depth)
+    {
+        _ok = false;
+        return *this;
+    }
+    _out.write(BreakByte);
+    --_depth;
+    return *this;
+}
+
+CborWriter& CborWriter::value(bool b)
+{
+    _out.write((uint8_t)(MajorSimple << 5 | (b ? 21 : 20)));
+    return *this;
+}
+
+CborWriter& CborWriter::value(long long v)
+{
+    if (v < 0)
+    {
+        typeValue(MajorNegative, ~(uint64_t)v);
+    }
+    else
+    {
+        typeValue(MajorUnsigned, v);
+    }
+    return *this;
+}
+
+CborWriter& CborWriter::value(unsigned long long v)
+{
+    typeValue(MajorUnsigned, v);
+    return *this;
+}
+
+CborWriter& CborWriter::value(float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    _out.write((uint8_t)(MajorSimple << 5 | 26));
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        _out.write((uint8_t)(bits >> shift));
+    }
+    return *this;
+}
+
+CborWriter& CborWriter::value(double v)
+{
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    _out.write((uint8_t)(MajorSimple << 5 | 27));
+    for (int shift = 56; shift >= 0; shift -= 8)
+    {
+        _out.write((uint8_t)(bits >> shift));
+    }
+    return *this;
+}
+
+CborWriter& CborWriter::value(const char* s)
+{
+    if (!s)
+    {
+        return nullValue();
+    }
+    const size_t len = strlen(s);
+    typeValue(MajorText, len);
+    _out.write(s, len);
+    return *this;
+}
+
+CborWriter& CborWriter::value(const String& s)
+{
+    typeValue(MajorText, s.length());
+    _out.write(s.c_str(), s.length());
+    return *this;
+}
+
+CborWriter& CborWriter::value(const __FlashStringHelper* s)
+{
+    if (!s)
+    {
+        return nullValue();
+    }
+    PGM_P p = reinterpret_cast<PGM_P>(s);
+    const size_t len = strlen_P(p);
+    typeValue(MajorText, len);
+    char buf[32];
+    for (size_t off = 0; off < len; off += sizeof(buf))
+    {
+        const size_t n = (len - off < sizeof(buf)) ? len - off : sizeof(buf);
+        memcpy_P(buf, p + off, n);
+        _out.write(buf, n);
+    }
+    return *this;
+}
+
+CborWriter& CborWriter::bytes(const uint8_t* data, size_t len)
+{
+    typeValue(MajorBytes, len);
+    _out.write(data, len);
+    return *this;
+}
+
+CborWriter& CborWriter::nullValue()
+{
+    _out.write((uint8_t)(MajorSimple << 5 | 22));
+    return *this;
+}
+
+CborWriter& CborWriter::undefined()
+{
+    _out.write((uint8_t)(MajorSimple << 5 | 23));
+    return *this;
+}
+
+CborWriter& CborWriter::tag(uint64_t t)
+{
+    typeValue(MajorTag, t);
+    return *this;
+}
+
+// -------------------------------------------------------------------
+// CborReader
+
+bool CborReader::readByte(uint8_t& b)
+{
+    return _in.readBytes(&b, 1) == 1;
+}
+
+// decode the argument following an initial byte: a small immediate value,
+// a 1/2/4/8 byte big-endian integer, or the indefinite-length marker
+bool CborReader::readArgument(uint8_t info, uint64_t& value, bool& indefinite)
+{
+    indefinite = false;
+    if (info < 24)
+    {
+        value = info;
+        return true;
+    }
+    if (info == 31)
+    {
+        indefinite = true;
+        value = 0;
+        return true;
+    }
+    if (info > 27)
+    {
+        return false;  // reserved
+    }
+    const uint8_t extra = 1 << (info - 24);
+    uint8_t buf[8];
+    if (_in.readBytes(buf, extra) != extra)
+    {
+        return false;
+    }
+    value = 0;
+    for (uint8_t i = 0; i < extra; i++)
+    {
+        value = value << 8 | buf[i];
+    }
+    return true;
+}
+
+// deliver a (chunk of a) string through a bounded buffer; 'final' is set
+// for the chunk that completes the whole string
+bool CborReader::streamString(uint64_t len, bool text, bool final)
+{
+    char buf[48];
+    do
+    {
+        const size_t n = (len < sizeof(buf)) ? (size_t)len : sizeof(buf);
+        if (n && _in.readBytes((uint8_t*)buf, n) != n)
+        {
+            return false;
+        }
+        len -= n;
+        if (text)
+        {
+            _visitor.onText(buf, n, final && !len);
+        }
+        else
+        {
+            _visitor.onBytes((const uint8_t*)buf, n, final && !len);
+        }
+    } while (len);
+    return true;
+}
+
+// a complete item was decoded: decrement the enclosing container's count,
+// closing (and cascading through) definite containers that just filled up
+void CborReader::itemDone()
+{
+    while (_depth)
+    {
+        uint64_t& remaining = _stack[_depth - 1];
+        if (remaining == Indefinite || --remaining)
+        {
+            return;
+        }
+        _visitor.onContainerEnd();
+        --_depth;
+    }
+}
+
+bool CborReader::parse()
+{
+    _depth = 0;
+    for (;;)
+    {
+        uint8_t ib;
+        if (!readByte(ib))
+        {
+            return false;
+        }
+
+        if (ib == BreakByte)
+        {
+            if (!_depth || _stack[_depth - 1] != Indefinite)
+            {
+                return false;
+            }
+            --_depth;
+            _visitor.onContainerEnd();
+            if (!_depth)
+            {
+                return true;
+            }
+            itemDone();  // the closed container is an item of its parent
+            if (!_depth)
+            {
+                return true;
+            }
+            continue;
+        }
+
+        const uint8_t major = ib >> 5;
+        uint64_t arg;
+        bool indefinite;
+        if (!readArgument(ib & 0x1f, arg, indefinite))
+        {
+            return false;
+        }
+        if (indefinite && (major < MajorBytes || major == MajorTag))
+        {
+            return false;
+        }
+
+        bool completed = true;
+        switch (major)
+        {
+        case MajorUnsigned:
+            _visitor.onUnsigned(arg);
+            break;
+
+        case MajorNegative:
+            if (arg > (uint64_t)INT64_MAX)
+            {
+                return false;  // not representable as int64_t
+            }
+            _visitor.onNegative(-1 - (int64_t)arg);
+            break;
+
+        case MajorBytes:
+        case MajorText:
+            if (indefinite)
+            {
+                // a series of definite chunks terminated by a break
+                for (;;)
+                {
+                    uint8_t cb;
+                    if (!readByte(cb))
+                    {
+                        return false;
+                    }
+                    if (cb == BreakByte)
+                    {
+                        break;
+                    }
+                    uint64_t chunkLen;
+                    bool chunkIndef;
+                    if ((cb >> 5) != major
+                            || !readArgument(cb & 0x1f, chunkLen, chunkIndef)
+                            || chunkIndef)
+                    {
+                        return false;
+                    }
+                    if (!streamString(chunkLen, major == MajorText, false))
+                    {
+                        return false;
+                    }
+                }
+                // empty terminal chunk so the consumer sees 'last'
+                streamString(0, major == MajorText, true);
+            }
+            else if (!streamString(arg, major == MajorText, true))
+            {
+                return false;
+            }
+            break;
+
+        case MajorArray:
+        case MajorMap:
+        {
+            // a map holds 2 * pairs items
+            if (major == MajorMap)
+            {
+                _visitor.onMap(indefinite ? 0 : arg, indefinite);
+                arg *= 2;
+            }
+            else
+            {
+                _visitor.onArray(indefinite ? 0 : arg, indefinite);
+            }
+            if (!indefinite && !arg)
+            {
+                _visitor.onContainerEnd();
+                break;  // empty container is already a complete item
+            }
+            if (_depth >= MaxDepth)
+            {
+                return false;
+            }
+            _stack[_depth++] = indefinite ? Indefinite : arg;
+            completed = false;
+            break;
+        }
+
+        case MajorTag:
+            _visitor.onTag(arg);
+            completed = false;  // the tag qualifies the item that follows
+            break;
+
+        case MajorSimple:
+            switch (ib & 0x1f)
+            {
+            case 20:
+                _visitor.onBool(false);
+                break;
+            case 21:
+                _visitor.onBool(true);
+                break;
+            case 22:
+                _visitor.onNull();
+                break;
+            case 23:
+                _visitor.onUndefined();
+                break;
+            case 25:
+                _visitor.onFloat(halfToDouble((uint16_t)arg));
+                break;
+            case 26:
+            {
+                float f;
+                uint32_t bits = (uint32_t)arg;
+                memcpy(&f, &bits, sizeof(f));
+                _visitor.onFloat(f);
+                break;
+            }
+            case 27:
+            {
+                double d;
+                memcpy(&d, &arg, sizeof(d));
+                _visitor.onFloat(d);
+                break;
+            }
+            default:
+                // other simple values: valid items, nothing to report
+                break;
+            }
+            break;
+        }
+
+        if (completed)
+        {
+            if (!_depth)
+            {
+                return true;
+            }
+            itemDone();
+            if (!_depth)
+            {
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ Cbor.h - streaming CBOR (RFC 8949) encoder and incremental decoder
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CBOR_H
+#define CBOR_H
+
+#include <Print.h>
+#include <Stream.h>
+#include <WString.h>
+
+// Binary sibling of JsonWriter for machine-to-machine telemetry: the same
+// forward-only, few-bytes-of-state model, but emitting CBOR, which skips
+// all the quoting/escaping/decimal formatting JSON costs and typically
+// lands at half the payload size.  Integer arguments use the shortest
+// CBOR encoding automatically.
+//
+//      CborWriter cbor(udp);
+//      cbor.beginMap(3)
+//          .property(F("uptime"), millis() / 1000)
+//          .property(F("heap"), ESP.getFreeHeap())
+//          .key(F("samples")).beginArray(n);
+//      for (size_t i = 0; i < n; i++)
+//          cbor.value(samples[i]);
+//
+// Container lengths are declared up front (definite-length encoding);
+// when a count is not known in advance use the *Indefinite() variants and
+// close them with end().  Misnested end() calls clear ok() and are
+// ignored, like JsonWriter.
+
+class CborWriter
+{
+public:
+    explicit CborWriter(Print& out) : _out(out) { }
+
+    // definite-length containers: exactly 'items' values (or 'pairs'
+    // key/value pairs) must follow
+    CborWriter& beginArray(size_t items);
+    CborWriter& beginMap(size_t pairs);
+
+    // indefinite-length containers, closed by end()
+    CborWriter& beginArrayIndefinite();
+    CborWriter& beginMapIndefinite();
+    CborWriter& end();
+
+    CborWriter& value(bool b);
+    CborWriter& value(int v) { return value((long long)v); }
+    CborWriter& value(unsigned int v) { return value((unsigned long long)v); }
+    CborWriter& value(long v) { return value((long long)v); }
+    CborWriter& value(unsigned long v) { return value((unsigned long long)v); }
+    CborWriter& value(long long v);
+    CborWriter& value(unsigned long long v);
+    CborWriter& value(float v);   // 32-bit float (0xfa)
+    CborWriter& value(double v);  // 64-bit float (0xfb)
+    CborWriter& value(const char* s);  // nullptr emits null
+    CborWriter& value(const String& s);
+    CborWriter& value(const __FlashStringHelper* s);
+    CborWriter& bytes(const uint8_t* data, size_t len);
+    CborWriter& nullValue();
+    CborWriter& undefined();
+    CborWriter& tag(uint64_t t);  // applies to the next value
+
+    // map keys are ordinary values; these aliases keep call sites readable
+    template<typename K>
+    CborWriter& key(const K& k) { return value(k); }
+    template<typename K, typename V>
+    CborWriter& property(const K& k, const V& v)
+    {
+        value(k);
+        return value(v);
+    }
+
+    // false after an end() without a matching indefinite container or a
+    // nesting overflow
+    bool ok() const { return _ok; }
+
+private:
+    void typeValue(uint8_t major, uint64_t v);
+
+    Print& _out;
+    uint8_t _depth = 0;  // open indefinite containers (definite ones need no close)
+    bool _ok = true;
+};
+
+// Incremental CBOR decoder: pulls one complete item (including nested
+// containers) from a Stream and reports every element to a visitor -
+// no document tree, no allocation.  Text and byte strings arrive in
+// bounded chunks so arbitrarily long strings cost only the chunk buffer;
+// 'last' marks the final chunk.  Visitor methods default to no-ops, so a
+// consumer only overrides what it cares about.
+//
+//      struct Sink : CborReader::Visitor {
+//          void onUnsigned(uint64_t v) override { ... }
+//          void onText(const char* s, size_t len, bool last) override { ... }
+//      } sink;
+//      CborReader reader(udp, sink);
+//      if (!reader.parse()) { /* malformed or timed out */ }
+
+class CborReader
+{
+public:
+    class Visitor
+    {
+    public:
+        virtual void onUnsigned(uint64_t) { }
+        virtual void onNegative(int64_t) { }  // already negative (-1 - n)
+        virtual void onBytes(const uint8_t*, size_t, bool) { }
+        virtual void onText(const char*, size_t, bool) { }
+        // count is the declared length, 0 when indefinite
+        virtual void onArray(size_t, bool indefinite) { (void)indefinite; }
+        virtual void onMap(size_t, bool indefinite) { (void)indefinite; }
+        virtual void onContainerEnd() { }
+        virtual void onTag(uint64_t) { }
+        virtual void onBool(bool) { }
+        virtual void onNull() { }
+        virtual void onUndefined() { }
+        virtual void onFloat(double) { }  // half, single and double floats
+
+    protected:
+        ~Visitor() = default;
+    };
+
+    static constexpr uint8_t MaxDepth = 16;
+
+    CborReader(Stream& in, Visitor& visitor) : _in(in), _visitor(visitor) { }
+
+    // decode one complete item; false on malformed input, a read timeout
+    // (Stream::setTimeout applies) or nesting beyond MaxDepth
+    bool parse();
+
+private:
+    bool readByte(uint8_t& b);
+    bool readArgument(uint8_t info, uint64_t& value, bool& indefinite);
+    bool streamString(uint64_t len, bool text, bool final);
+    void itemDone();  // container count bookkeeping after a completed item
+
+    Stream& _in;
+    Visitor& _visitor;
+    uint64_t _stack[MaxDepth];  // items still expected per depth, ~0 when indefinite
+    uint8_t _depth = 0;
+};
+
+#endif  // CBOR_H
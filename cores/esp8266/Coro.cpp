@@ -0,0 +1,157 @@
+/*
+ Coro.cpp - small cooperative coroutines on top of the cont.S machinery
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Coro.h"
+#include "Arduino.h"
+#include "cont.h"
+#include "debug.h"
+
+#include <new>
+#include <string.h>
+
+static constexpr unsigned CORO_STACKGUARD = 0xfeefeffe;  // same magic as cont_util.cpp
+static constexpr size_t CORO_MIN_STACK = 256;
+
+Coro* Coro::_current = nullptr;
+
+Coro::Coro(std::function<void()> fn, size_t stackSize) : _fn(std::move(fn))
+{
+    // cont.S only dereferences the five header fields of cont_t (offsets
+    // 0..16) plus the struct back pointer it expects one word above
+    // stack_end, so the trimmed ctx_t can be handed to cont_run() and
+    // cont_suspend() as-is.  Keep in sync with cont.S.
+    static_assert(offsetof(ctx_t, pc_suspend) == offsetof(cont_t, pc_suspend)
+                      && offsetof(ctx_t, stack_end) == offsetof(cont_t, stack_end),
+                  "ctx_t must mirror the cont_t header");
+
+    if (!_fn)
+    {
+        return;
+    }
+    if (stackSize < CORO_MIN_STACK)
+    {
+        stackSize = CORO_MIN_STACK;
+    }
+    const size_t words = (stackSize & ~(size_t)15) / 4;
+
+    // [0..1]: overflow guard, then the stack, then (16-aligned) the top
+    // guard and the back pointer cont_norm reads at stack_end[1].
+    _mem = new (std::nothrow) unsigned[words + 2 + 2 + 4 /* alignment margin */];
+    if (!_mem)
+    {
+        return;
+    }
+
+    unsigned* top = (unsigned*)((uintptr_t)(_mem + words + 2 + 4) & ~(uintptr_t)15);
+    _stack = _mem + 2;
+    _stackWords = top - _stack;
+
+    memset(&_ctx, 0, sizeof(_ctx));
+    _ctx.stack_end = top;
+    top[0] = CORO_STACKGUARD;                 // guard2, never below SP
+    top[1] = (unsigned)(uintptr_t)&_ctx;      // struct_start, see cont_norm
+    for (unsigned* pos = _mem; pos < top; ++pos)
+    {
+        *pos = CORO_STACKGUARD;               // paint for the high water mark
+    }
+
+    _state = State::READY;
+}
+
+Coro::~Coro()
+{
+    // Destroying a suspended coroutine abandons its stack frames: locals
+    // living in them do not get their destructors run.
+    delete[] _mem;
+}
+
+void Coro::entry()
+{
+    Coro* self = _current;
+    self->_fn();
+    self->_state = State::DONE;
+    // returning lands in cont_norm, which switches back to resume()
+}
+
+void Coro::checkGuards()
+{
+    if (_mem[0] == CORO_STACKGUARD && _mem[1] == CORO_STACKGUARD
+        && _ctx.stack_end[0] == CORO_STACKGUARD)
+    {
+        return;
+    }
+    __stack_chk_fail();
+    __builtin_unreachable();
+}
+
+bool Coro::resume()
+{
+    if (_state != State::READY || !_stack)
+    {
+        return false;
+    }
+
+    _prev = _current;
+    _current = this;
+    _state = State::RUNNING;
+
+    cont_run(reinterpret_cast<cont_t*>(&_ctx), entry);
+
+    checkGuards();
+    _current = _prev;
+    if (_state == State::RUNNING)
+    {
+        // came back through Coro::yield()
+        _state = State::READY;
+    }
+    return _state == State::READY;
+}
+
+void Coro::yield()
+{
+    if (!_current)
+    {
+        // on the loop stack there is nothing to suspend; ignore, so shared
+        // helper code can run both inside and outside a coroutine
+        return;
+    }
+    cont_suspend(reinterpret_cast<cont_t*>(&_current->_ctx));
+}
+
+void Coro::delay(uint32_t ms)
+{
+    const uint32_t start = millis();
+    await([start, ms]() { return millis() - start >= ms; });
+}
+
+size_t Coro::freeStack() const
+{
+    if (!_stack)
+    {
+        return 0;
+    }
+    size_t words = 0;
+    while (words < _stackWords && _stack[words] == CORO_STACKGUARD)
+    {
+        ++words;
+    }
+    return words * 4;
+}
@@ -0,0 +1,157 @@
+/*
+ Coro.h - small cooperative coroutines on top of the cont.S machinery
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CORO_H
+#define CORO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+// The loop() continuation already context-switches through cont.S; Coro
+// generalizes that to a handful of user coroutines with their own (small,
+// configurable) stacks.  Each coroutine is a function that may suspend
+// itself with Coro::yield() and is driven forward by resume() calls from
+// loop().  This turns the classic giant-switch state machines (display
+// update, modbus poller, cloud sync, ...) into straight-line code that can
+// block on I/O without stalling the others:
+//
+//      Coro poller([]() {
+//          for (;;) {
+//              startAsyncRequest();
+//              Coro::await([]() { return requestDone(); });
+//              handleReply();
+//              Coro::delay(250);
+//          }
+//      }, 1024);
+//
+//      void loop() {
+//          poller.resume();   // runs until the coroutine yields again
+//          display.resume();
+//      }
+//
+// Rules of the road:
+// * resume() only from loop()/CONT context (or from inside another
+//   coroutine, which nests: the inner one must finish its slice before the
+//   outer one continues - that is what yieldTo() does).  Never from an ISR.
+// * Inside a coroutine use Coro::yield()/Coro::delay()/Coro::await();
+//   the global yield()/delay() must not be called there, as they suspend
+//   the loop continuation stack which the coroutine is not running on.
+// * Stacks are small and fixed: size for the deepest call path (printf and
+//   String formatting are stack-hungry).  Both stack ends are guarded and
+//   a trashed guard panics, like the loop continuation does.
+
+class Coro
+{
+public:
+    // A coroutine with its own stack of stackSize bytes (rounded down to a
+    // multiple of 16, minimum 256).  The function starts on the first
+    // resume().  Check *this (or stack()) after construction: allocation
+    // failure leaves an empty coroutine that never runs.
+    Coro(std::function<void()> fn, size_t stackSize = 1024);
+    ~Coro();
+
+    Coro(const Coro&) = delete;
+    Coro& operator=(const Coro&) = delete;
+
+    // Run the coroutine until it yields or returns.  Returns true if it can
+    // be resumed again, false if it has finished (or cannot run).
+    bool resume();
+
+    // True once the coroutine function has returned.
+    bool done() const { return _state == State::DONE; }
+
+    // True while the coroutine is the one currently executing (or is an
+    // outer frame of the currently executing one).
+    bool running() const { return _state == State::RUNNING; }
+
+    explicit operator bool() const { return _stack != nullptr; }
+
+    // Unused stack in bytes at the deepest point seen so far (high water
+    // mark, same painting scheme as cont_get_free_stack()).
+    size_t freeStack() const;
+
+    size_t stackSize() const { return _stackWords * 4; }
+    const void* stack() const { return _stack; }
+
+    // --- to be called from inside a coroutine only ---
+
+    // Suspend the current coroutine; its resume() call returns true.
+    static void yield();
+
+    // The coroutine currently executing, nullptr when on the loop stack.
+    static Coro* current() { return _current; }
+
+    // Suspend the current coroutine whenever the condition is false; the
+    // condition is re-checked once per resume().
+    template<typename F>
+    static void await(F&& condition)
+    {
+        while (!condition())
+        {
+            yield();
+        }
+    }
+
+    // Cooperative delay: yields until ms milliseconds have passed.  Unlike
+    // the global delay() this never blocks the rest of the sketch.
+    static void delay(uint32_t ms);
+
+    // Give the rest of this loop() slice to another coroutine: runs it on
+    // top of the current stack until it yields or finishes, then continues
+    // here.  A no-op if other is already running or done.
+    static void yieldTo(Coro& other) { other.resume(); }
+
+private:
+    // Mirrors the header of cont_t as used by cont.S: only the fields at
+    // offsets 0..16 are touched by the assembly, plus the struct back
+    // pointer it expects at stack_end[1] (see cont_norm).
+    struct ctx_t
+    {
+        void (*pc_ret)(void);
+        unsigned* sp_ret;
+        void (*pc_suspend)(void);
+        unsigned* sp_suspend;
+        unsigned* stack_end;
+    };
+
+    enum class State : uint8_t
+    {
+        READY,
+        RUNNING,
+        DONE,
+    };
+
+    static void entry();
+    void checkGuards();
+
+    ctx_t _ctx;
+    std::function<void()> _fn;
+    unsigned* _mem = nullptr;    // raw allocation, low end = overflow guard
+    unsigned* _stack = nullptr;  // first usable stack word
+    size_t _stackWords = 0;
+    State _state = State::DONE;
+    Coro* _prev = nullptr;  // resume() nesting chain
+
+    static Coro* _current;
+};
+
+#endif  // CORO_H
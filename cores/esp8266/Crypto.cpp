@@ -59,7 +59,8 @@ uint8_t *defaultNonceGenerator(uint8_t *nonceArray, const size_t nonceLength)
         Thus only delayMicroseconds() is used below.
     */
 
-    return ESP.random(nonceArray, nonceLength);
+    // Served from the core entropy pool when possible, which avoids the read pacing described above.
+    return ESP.randomBytes(nonceArray, nonceLength);
 }
 
 experimental::crypto::nonceGeneratorType _nonceGenerator = defaultNonceGenerator;
@@ -181,6 +182,18 @@ void *sha1HashHelper(const void *data, const size_t dataLength, void *resultArra
     br_sha1_out(&context, resultArray);
     return resultArray;
 }
+
+// Advance a rolling 96-bit nonce, treated as a little-endian counter.
+void incrementNonce(uint8_t *nonce)
+{
+    for (uint8_t i = 0; i < 12; ++i)
+    {
+        if (++nonce[i] != 0)
+        {
+            break;
+        }
+    }
+}
 }
 
 namespace experimental
@@ -549,5 +562,150 @@ bool ChaCha20Poly1305::decrypt(void *data, const size_t dataLength, const void *
 
     return true;
 }
+
+
+// #################### Persistent AEAD contexts ####################
+
+ChaCha20Poly1305Context::ChaCha20Poly1305Context(const void *key, const void *keySalt, const size_t keySaltLength)
+{
+    init(key, keySalt, keySaltLength);
+}
+
+void ChaCha20Poly1305Context::init(const void *key, const void *keySalt, const size_t keySaltLength)
+{
+    // Derive the subkey once here so that per-message calls can run the cipher kernel directly.
+    if (keySalt == nullptr)
+    {
+        memcpy(encryptionKey, key, ENCRYPTION_KEY_LENGTH);
+    }
+    else
+    {
+        HKDF hkdfInstance(key, ENCRYPTION_KEY_LENGTH, keySalt, keySaltLength);
+        hkdfInstance.produce(encryptionKey, ENCRYPTION_KEY_LENGTH);
+    }
+
+    getNonceGenerator()(rollingNonce, sizeof rollingNonce);
+}
+
+void ChaCha20Poly1305Context::encrypt(void *data, const size_t dataLength, void *resultingNonce, void *resultingTag, const void *aad, const size_t aadLength)
+{
+    memcpy(resultingNonce, rollingNonce, sizeof rollingNonce);
+    incrementNonce(rollingNonce);
+
+    chacha20Poly1305Kernel(1, data, dataLength, encryptionKey, nullptr, 0, resultingNonce, resultingTag, aad, aadLength);
+}
+
+bool ChaCha20Poly1305Context::decrypt(void *data, const size_t dataLength, const void *encryptionNonce, const void *encryptionTag, const void *aad, const size_t aadLength)
+{
+    const uint8_t *oldTag = (const uint8_t *)encryptionTag;
+    uint8_t newTag[16] {0};
+
+    chacha20Poly1305Kernel(0, data, dataLength, encryptionKey, nullptr, 0, encryptionNonce, newTag, aad, aadLength);
+
+    for (uint32_t i = 0; i < sizeof newTag; ++i)
+    {
+        if (newTag[i] != oldTag[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ChaCha20Poly1305Context::encrypt(AEADMessage *messages, const size_t messageCount)
+{
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+        encrypt(messages[i].data, messages[i].dataLength, messages[i].nonce, messages[i].tag, messages[i].aad, messages[i].aadLength);
+    }
+}
+
+size_t ChaCha20Poly1305Context::decrypt(AEADMessage *messages, const size_t messageCount)
+{
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+        if (!decrypt(messages[i].data, messages[i].dataLength, messages[i].nonce, messages[i].tag, messages[i].aad, messages[i].aadLength))
+        {
+            return i;
+        }
+    }
+
+    return messageCount;
+}
+
+
+// #################### AES-128-GCM AEAD ####################
+
+AES128GCMContext::AES128GCMContext(const void *key)
+{
+    init(key);
+}
+
+void AES128GCMContext::init(const void *key)
+{
+    // Comments mainly from https://www.bearssl.org/apidoc/bearssl__aead_8h.html
+
+    // Expand the AES key schedule once; br_gcm_init() links the GCM context to it, so every
+    // br_gcm_reset() afterwards reuses the schedule instead of recomputing it per message.
+    br_aes_ct_ctr_init(&aesContext, key, KEY_LENGTH);
+    br_gcm_init(&gcmContext, &aesContext.vtable, br_ghash_ctmul32);
+
+    getNonceGenerator()(rollingNonce, sizeof rollingNonce);
+}
+
+void AES128GCMContext::run(const int encrypt, void *data, const size_t dataLength, const void *nonce, const void *aad, const size_t aadLength)
+{
+    // Reset the GCM run with the nonce; implementations and keys are conserved.
+    br_gcm_reset(&gcmContext, nonce, 12);
+
+    // Additional authenticated data must be injected before br_gcm_flip(), which must be called
+    // before the actual encryption or decryption even if no additional data was injected.
+    br_gcm_aad_inject(&gcmContext, aad, aadLength);
+    br_gcm_flip(&gcmContext);
+
+    // Encrypt or decrypt the data in place.
+    br_gcm_run(&gcmContext, encrypt, data, dataLength);
+}
+
+void AES128GCMContext::encrypt(void *data, const size_t dataLength, void *resultingNonce, void *resultingTag, const void *aad, const size_t aadLength)
+{
+    memcpy(resultingNonce, rollingNonce, sizeof rollingNonce);
+    incrementNonce(rollingNonce);
+
+    run(1, data, dataLength, resultingNonce, aad, aadLength);
+
+    // Compute the 16-byte authentication tag. This terminates the GCM run.
+    br_gcm_get_tag(&gcmContext, resultingTag);
+}
+
+bool AES128GCMContext::decrypt(void *data, const size_t dataLength, const void *encryptionNonce, const void *encryptionTag, const void *aad, const size_t aadLength)
+{
+    run(0, data, dataLength, encryptionNonce, aad, aadLength);
+
+    // Compute the tag and compare it (in constant time) with the received one.
+    return br_gcm_check_tag(&gcmContext, encryptionTag);
+}
+
+void AES128GCMContext::encrypt(AEADMessage *messages, const size_t messageCount)
+{
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+        encrypt(messages[i].data, messages[i].dataLength, messages[i].nonce, messages[i].tag, messages[i].aad, messages[i].aadLength);
+    }
+}
+
+size_t AES128GCMContext::decrypt(AEADMessage *messages, const size_t messageCount)
+{
+    for (size_t i = 0; i < messageCount; ++i)
+    {
+        if (!decrypt(messages[i].data, messages[i].dataLength, messages[i].nonce, messages[i].tag, messages[i].aad, messages[i].aadLength))
+        {
+            return i;
+        }
+    }
+
+    return messageCount;
+}
 }
 }
@@ -28,6 +28,8 @@
 
 #include <Arduino.h>
 #include <bearssl/bearssl_kdf.h>
+#include <bearssl/bearssl_block.h>
+#include <bearssl/bearssl_aead.h>
 
 namespace experimental
 {
@@ -840,6 +842,176 @@ struct ChaCha20Poly1305
     */
     static bool decrypt(void *data, const size_t dataLength, const void *key, const void *keySalt, const size_t keySaltLength, const void *encryptionNonce, const void *encryptionTag, const void *aad = nullptr, const size_t aadLength = 0);
 };
+
+
+// #################### Persistent AEAD contexts ####################
+
+/**
+    Descriptor for one message in a batch encrypt/decrypt call.
+
+    For encryption, data/dataLength describe the plaintext (encrypted in place) and nonce/tag point to
+    caller-provided buffers (12 and 16 bytes respectively) that receive the nonce used and the generated tag.
+    For decryption, data/dataLength describe the ciphertext (decrypted in place) and nonce/tag point to
+    the values received alongside it.
+*/
+struct AEADMessage
+{
+    void *data;
+    size_t dataLength;
+    void *nonce;
+    void *tag;
+    const void *aad = nullptr;
+    size_t aadLength = 0;
+};
+
+/**
+    Persistent-state counterpart of ChaCha20Poly1305, intended for workloads that encrypt many small
+    messages under the same key (e.g. a telemetry stream). The static ChaCha20Poly1305 methods re-derive
+    the HKDF subkey and query the nonce generator on every call; for short messages that setup work
+    dominates the actual cipher work. This context derives the subkey once in init() and afterwards rolls
+    its own nonce, so per-message cost is reduced to the cipher kernel itself.
+
+    The rolling nonce starts from a getNonceGenerator() value taken in init() and is incremented as a
+    96-bit little-endian counter for each encrypted message, which guarantees nonce uniqueness within
+    the lifetime of the context. Across contexts (e.g. across reboots) uniqueness rests on the starting
+    value, exactly as with the static ChaCha20Poly1305::encrypt; the same advice applies: provide a
+    per-session keySalt, or replace the nonce generator with something collision-free.
+
+    The context stores the (derived) encryption key in RAM for its whole lifetime. Do not use it when the
+    key must not stay resident.
+*/
+struct ChaCha20Poly1305Context
+{
+    /**
+        Initialize the context. (calls ChaCha20Poly1305Context::init())
+
+        @param key The secret encryption key to use. Must be 32 bytes (ENCRYPTION_KEY_LENGTH) long.
+        @param keySalt The salt to use when generating a subkey from key, see ChaCha20Poly1305::encrypt. Set to nullptr to prevent subkey generation.
+        @param keySaltLength The length of keySalt in bytes.
+    */
+    ChaCha20Poly1305Context(const void *key, const void *keySalt = nullptr, const size_t keySaltLength = 0);
+
+    ChaCha20Poly1305Context(const ChaCha20Poly1305Context &) = delete;
+    ChaCha20Poly1305Context &operator=(const ChaCha20Poly1305Context &) = delete;
+
+    /**
+        (Re)initialize the context with a new key and a fresh rolling nonce.
+        Performs the HKDF subkey derivation (if keySalt is provided) and one nonce generator call;
+        subsequent encrypt()/decrypt() calls do neither.
+    */
+    void init(const void *key, const void *keySalt = nullptr, const size_t keySaltLength = 0);
+
+    /**
+        Encrypt the data array in place, like ChaCha20Poly1305::encrypt, but using the stored key and
+        the next rolling nonce instead of re-deriving and re-generating them.
+
+        @param data An array containing the data to encrypt. The encrypted data is generated in place.
+        @param dataLength The length of the data array in bytes.
+        @param resultingNonce The array that will store the nonce used. Must be able to contain at least 12 bytes. The nonce is not secret and must be passed to the decryption function.
+        @param resultingTag The array that will store the message authentication tag. Must be able to contain at least 16 bytes. The tag is not secret and must be passed to the decryption function.
+        @param aad Additional authenticated data, covered by the MAC but not encrypted. Defaults to nullptr.
+        @param aadLength The length of the aad array in bytes. Defaults to 0.
+    */
+    void encrypt(void *data, const size_t dataLength, void *resultingNonce, void *resultingTag, const void *aad = nullptr, const size_t aadLength = 0);
+
+    /**
+        Decrypt the data array in place, like ChaCha20Poly1305::decrypt, but using the stored key.
+
+        @return True if the decryption was successful (the generated tag matches encryptionTag). False otherwise. Note that the data array is modified regardless of this outcome.
+    */
+    bool decrypt(void *data, const size_t dataLength, const void *encryptionNonce, const void *encryptionTag, const void *aad = nullptr, const size_t aadLength = 0);
+
+    /**
+        Encrypt a batch of messages in one call, amortizing the call overhead over the whole batch.
+        Equivalent to calling encrypt() for each descriptor in order.
+
+        @param messages An array of message descriptors, see AEADMessage.
+        @param messageCount The number of descriptors in messages.
+    */
+    void encrypt(AEADMessage *messages, const size_t messageCount);
+
+    /**
+        Decrypt a batch of messages in one call. Messages are processed in order; processing stops at
+        the first message whose tag does not match, leaving the remaining messages untouched.
+
+        @param messages An array of message descriptors, see AEADMessage.
+        @param messageCount The number of descriptors in messages.
+
+        @return The number of messages successfully authenticated and decrypted. Equal to messageCount if the whole batch verified.
+    */
+    size_t decrypt(AEADMessage *messages, const size_t messageCount);
+
+private:
+
+    uint8_t encryptionKey[ENCRYPTION_KEY_LENGTH];
+    uint8_t rollingNonce[12];
+};
+
+/**
+    AES-128-GCM AEAD with persistent key state, same usage pattern as ChaCha20Poly1305Context.
+    Uses the BearSSL constant-time AES-CTR implementation (br_aes_ct) with GHASH (ctmul32).
+
+    The AES key schedule is expanded once in init() and reused for every message; per-message work is
+    a br_gcm_reset() plus the cipher/GHASH passes over the data. The rolling nonce behaves exactly as
+    in ChaCha20Poly1305Context. Note that unlike the ChaCha20Poly1305 APIs there is no keySalt/HKDF
+    step here: provide a per-session key if key separation is needed.
+*/
+struct AES128GCMContext
+{
+    static constexpr uint8_t KEY_LENGTH = 16;
+
+    /**
+        Initialize the context. (calls AES128GCMContext::init())
+
+        @param key The secret encryption key to use. Must be 16 bytes (KEY_LENGTH) long.
+    */
+    AES128GCMContext(const void *key);
+
+    // br_gcm_context keeps a pointer to the AES key schedule stored in this object.
+    AES128GCMContext(const AES128GCMContext &) = delete;
+    AES128GCMContext &operator=(const AES128GCMContext &) = delete;
+
+    /**
+        (Re)initialize the context with a new key and a fresh rolling nonce.
+        Performs the AES key schedule expansion and one nonce generator call;
+        subsequent encrypt()/decrypt() calls do neither.
+    */
+    void init(const void *key);
+
+    /**
+        Encrypt the data array in place using AES-128-GCM, with the stored key and the next rolling nonce.
+        Parameters as in ChaCha20Poly1305Context::encrypt.
+    */
+    void encrypt(void *data, const size_t dataLength, void *resultingNonce, void *resultingTag, const void *aad = nullptr, const size_t aadLength = 0);
+
+    /**
+        Decrypt the data array in place using AES-128-GCM, with the stored key.
+
+        @return True if the decryption was successful (the generated tag matches encryptionTag). False otherwise. Note that the data array is modified regardless of this outcome.
+    */
+    bool decrypt(void *data, const size_t dataLength, const void *encryptionNonce, const void *encryptionTag, const void *aad = nullptr, const size_t aadLength = 0);
+
+    /**
+        Encrypt a batch of messages in one call. Equivalent to calling encrypt() for each descriptor in order.
+    */
+    void encrypt(AEADMessage *messages, const size_t messageCount);
+
+    /**
+        Decrypt a batch of messages in one call. Messages are processed in order; processing stops at
+        the first message whose tag does not match, leaving the remaining messages untouched.
+
+        @return The number of messages successfully authenticated and decrypted. Equal to messageCount if the whole batch verified.
+    */
+    size_t decrypt(AEADMessage *messages, const size_t messageCount);
+
+private:
+
+    void run(const int encrypt, void *data, const size_t dataLength, const void *nonce, const void *aad, const size_t aadLength);
+
+    br_aes_ct_ctr_keys aesContext;
+    br_gcm_context gcmContext;
+    uint8_t rollingNonce[12];
+};
 }
 }
 #endif
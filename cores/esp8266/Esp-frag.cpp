@@ -21,6 +21,8 @@
 #include "umm_malloc/umm_malloc.h"
 #include "coredecls.h"
 #include "Esp.h"
+#include "Schedule.h"
+#include "interrupts.h"
 
 #if defined(UMM_INFO)
 void EspClass::getHeapStats(uint32_t* hfree, uint32_t* hmax, uint8_t* hfrag)
@@ -60,4 +62,55 @@ uint8_t EspClass::getHeapFragmentation()
 {
   return (uint8_t)umm_fragmentation_metric();
 }
+
+void EspClass::getHeapStats(EspHeapMetrics& stats)
+{
+#if !defined(UMM_INLINE_METRICS)
+    // Without inline metrics the counters come from the umm_info() walk;
+    // run it up front so the locked sampling below stays O(1).
+    umm_info(NULL, false);
+    {
+        esp8266::InterruptLock lock;
+        stats.freeHeap = umm_free_heap_size_core(umm_get_current_heap());
+        stats.maxFreeBlock = umm_max_block_size_core(umm_get_current_heap());
+        stats.fragmentation = (uint8_t)umm_fragmentation_metric_core(umm_get_current_heap());
+    }
+#else
+    // O(1) counters maintained on every alloc/free: sample them under one
+    // interrupt lock so the fields cannot shear against an ISR allocation.
+    {
+        esp8266::InterruptLock lock;
+        stats.freeHeap = umm_free_heap_size_lw();
+        stats.maxFreeBlock = umm_max_block_size_lw();
+        stats.fragmentation = (uint8_t)umm_fragmentation_metric();
+    }
+#endif
+    if (!stats.freeHeap)
+        stats.fragmentation = 0;
+    stats.freeContStack = getFreeContStack();
+}
+
+static std::function<void(const EspHeapMetrics&)> heap_metrics_cb;
+static uint32_t heap_metrics_generation = 0;
+
+void EspClass::onHeapMetrics(const std::function<void(const EspHeapMetrics&)>& callback, uint32_t intervalMs)
+{
+    // Bumping the generation makes any previously scheduled publisher
+    // unregister itself on its next run.
+    uint32_t generation = ++heap_metrics_generation;
+    heap_metrics_cb = callback;
+    if (!callback)
+        return;
+
+    schedule_recurrent_function_us([generation]()
+    {
+        if (generation != heap_metrics_generation)
+            return false;
+
+        EspHeapMetrics metrics;
+        getHeapStats(metrics);  // one coherent snapshot, O(1) with UMM_INLINE_METRICS
+        heap_metrics_cb(metrics);
+        return true;
+    }, intervalMs * 1000);
+}
 #endif
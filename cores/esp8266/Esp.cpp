@@ -28,6 +28,7 @@
 #include "cont.h"
 #include "flash_hal.h"
 #include "coredecls.h"
+#include "Schedule.h"
 #include "umm_malloc/umm_malloc.h"
 #include <pgmspace.h>
 #include "reboot_uart_dwnld.h"
@@ -229,9 +230,106 @@ uint32_t EspClass::getMaxFreeBlockSize(void)
 }
 #endif
 
+bool EspClass::getLoopStats(EspLoopStats* stats)
+{
+#ifdef ESP_LOOP_STATS
+    if (stats) {
+        esp_loop_stats_get(&stats->iterations, &stats->maxCycles, stats->histogram);
+        get_scheduled_recurrent_slowest(&stats->slowestRecurrentPC, &stats->slowestRecurrentCycles);
+    }
+    return true;
+#else
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+    }
+    return false;
+#endif
+}
+
+void EspClass::resetLoopStats()
+{
+#ifdef ESP_LOOP_STATS
+    esp_loop_stats_reset();
+    reset_scheduled_recurrent_slowest();
+#endif
+}
+
+static bool s_auto_light_sleep = false;
+static uint32_t s_als_threshold_ms = 5;
+static uint64_t s_als_slept_us = 0;
+static uint64_t s_als_since_us = 0;
+
+void EspClass::autoLightSleep(bool enable, uint32_t thresholdMs)
+{
+    s_als_threshold_ms = thresholdMs ? thresholdMs : 1;
+    if (enable == s_auto_light_sleep)
+        return;
+    s_auto_light_sleep = enable;
+    if (enable) {
+        // let the SDK nap RF and CPU whenever both contexts go idle
+        wifi_set_sleep_type(LIGHT_SLEEP_T);
+        s_als_slept_us = 0;
+        s_als_since_us = micros64();
+    } else {
+        wifi_set_sleep_type(MODEM_SLEEP_T);
+    }
+}
+
+uint8_t EspClass::getSleepResidency()
+{
+    if (!s_auto_light_sleep)
+        return 0;
+    uint64_t elapsed = micros64() - s_als_since_us;
+    if (!elapsed)
+        return 0;
+    return (uint8_t)((s_als_slept_us * 100) / elapsed);
+}
+
+// called once per loop_wrapper() pass, after loop work and serial events
+extern "C" void esp_auto_light_sleep_idle(void)
+{
+    if (!s_auto_light_sleep || scheduled_functions_pending())
+        return;
+    uint32_t gap_us = compute_scheduled_recurrent_delay_us();
+    uint32_t gap_ms = (gap_us == ~(uint32_t)0) ? 50 : gap_us / 1000;
+    if (gap_ms > 50)
+        gap_ms = 50; // bound serialEvent/uart servicing latency
+    if (gap_ms < s_als_threshold_ms)
+        return;
+    uint64_t before = micros64();
+    // blocks the cont context; the SYS context idles and the SDK may
+    // enter light sleep until the next timer or RF wake source
+    esp_delay(gap_ms);
+    s_als_slept_us += micros64() - before;
+}
+
+bool EspClass::getBootTimeline(EspBootTimeline* timeline)
+{
+    if (!timeline)
+        return false;
+    uint32_t cycles[BOOT_CP_COUNT];
+    esp_boot_timeline_get(cycles);
+    timeline->appEntry    = cycles[BOOT_CP_APP_ENTRY];
+    timeline->userInit    = cycles[BOOT_CP_USER_INIT];
+    timeline->flashInit   = cycles[BOOT_CP_FLASH_INIT];
+    timeline->preinitDone = cycles[BOOT_CP_PREINIT];
+    timeline->sdkInitDone = cycles[BOOT_CP_SDK_DONE];
+    timeline->ctorsDone   = cycles[BOOT_CP_CTORS_DONE];
+    timeline->setupEntry  = cycles[BOOT_CP_SETUP];
+    timeline->setupDone   = cycles[BOOT_CP_SETUP_DONE];
+    return true;
+}
+
 uint32_t EspClass::getFreeContStack()
 {
-    return cont_get_free_stack(g_pcont);
+    // Refreshes and returns the watermark maintained at yield boundaries;
+    // only the stack region used since the last check is scanned.
+    return cont_update_free_stack(g_pcont);
+}
+
+uint32_t EspClass::getContStackDeepestPC()
+{
+    return cont_get_deepest_pc(g_pcont);
 }
 
 void EspClass::resetFreeContStack()
@@ -518,6 +616,22 @@ struct rst_info * EspClass::getResetInfoPtr(void) {
     return &resetInfo;
 }
 
+bool EspClass::enableCrashDump(uint32_t flashAddress) {
+    return crash_blackbox_enable(flashAddress);
+}
+
+bool EspClass::getCrashDump(crash_blackbox_frame_t& header) {
+    return crash_blackbox_check(&header);
+}
+
+size_t EspClass::getCrashDump(crash_blackbox_frame_t& header, uint32_t* stack, size_t maxWords) {
+    return crash_blackbox_read(&header, stack, maxWords);
+}
+
+void EspClass::clearCrashDump() {
+    crash_blackbox_clear();
+}
+
 bool EspClass::eraseConfig(void) {
     const size_t cfgSize = 0x4000;
     size_t cfgAddr = ESP.getFlashChipSize() - cfgSize;
@@ -584,10 +698,49 @@ uint8_t *EspClass::random(uint8_t *resultArray, const size_t outputSizeBytes)
 uint32_t EspClass::random()
 {
   union { uint32_t b32; uint8_t b8[4]; } result;
-  random(result.b8, 4);
+  randomBytes(result.b8, 4);
   return result.b32;
 }
 
+// Core entropy pool: RANDOM_REG32 words harvested one at a time in the idle
+// path of loop_wrapper(), where the mandated read pacing costs nothing, and
+// served in bulk through randomBytes(). Pool state is only touched from the
+// CONT context (loop task), so no locking is needed.
+static uint8_t s_entropy_pool[64];
+static size_t s_entropy_avail = 0;
+
+void esp_entropy_pool_stir(void)
+{
+    if (s_entropy_avail + sizeof(uint32_t) > sizeof(s_entropy_pool))
+        return;
+    // One register read per loop pass keeps the extraction rate far below the
+    // 0.5 MHz ceiling EspClass::random() paces itself to.
+    const uint32_t word = RANDOM_REG32;
+    memcpy(&s_entropy_pool[s_entropy_avail], &word, sizeof(word));
+    s_entropy_avail += sizeof(word);
+}
+
+uint8_t *EspClass::randomBytes(uint8_t *resultArray, const size_t outputSizeBytes)
+{
+  size_t filled = 0;
+
+  // Serve pooled bytes first; they were harvested in idle time, so no pacing
+  // delay is needed here. Consumed bytes are cleared so they cannot be
+  // served twice.
+  while (filled < outputSizeBytes && s_entropy_avail > 0)
+  {
+    --s_entropy_avail;
+    resultArray[filled++] = s_entropy_pool[s_entropy_avail];
+    s_entropy_pool[s_entropy_avail] = 0;
+  }
+
+  // Anything beyond the pooled supply comes from paced register reads.
+  if (filled < outputSizeBytes)
+    random(resultArray + filled, outputSizeBytes - filled);
+
+  return resultArray;
+}
+
 uint32_t EspClass::getSketchSize() {
     static uint32_t result = 0;
     if (result)
@@ -970,6 +1123,15 @@ void EspClass::setExternalHeap()
 #endif
 }
 
+void EspClass::setExternalHeapThreshold(size_t bytes)
+{
+#ifdef UMM_HEAP_EXTERNAL
+    umm_set_vm_threshold(bytes);
+#else
+    (void)bytes;
+#endif
+}
+
 void EspClass::setIramHeap()
 {
 #ifdef UMM_HEAP_IRAM
@@ -1004,3 +1166,41 @@ void EspClass::resetHeap()
     }
 #endif
 }
+
+void EspClass::dumpHeapTrace(Print& out)
+{
+#ifdef UMM_HEAP_TRACE
+    static const char* opNames[] = { "malloc ", "free   ", "realloc", "FAIL   " };
+
+    // Printing may itself allocate; keep the recorder still while reading it out
+    umm_trace_pause(true);
+
+    out.printf_P(PSTR("Heap trace, last %u of %u events (oldest first):\r\n"),
+                 (unsigned)umm_trace_event_count(), UMM_HEAP_TRACE);
+    out.println(F("  op      caller      size        ccount"));
+    UMM_TRACE_EVENT event;
+    for (uint32_t i = 0; umm_trace_event_at(i, &event); i++) {
+        out.printf_P(PSTR("  %s 0x%08x  %-10u  %u\r\n"),
+                     opNames[event.op < 4 ? event.op : 3],
+                     (unsigned)event.caller, (unsigned)event.size, (unsigned)event.ccount);
+    }
+
+    out.println(F("Allocations by caller:"));
+    out.println(F("  caller      count       total       largest"));
+    UMM_TRACE_SITE site;
+    for (size_t i = 0; umm_trace_site_at(i, &site); i++) {
+        if (site.caller == 0xFFFFFFFFu) {
+            out.printf_P(PSTR("  (others)    %-10u  %-10u  %u\r\n"),
+                         (unsigned)site.count, (unsigned)site.total, (unsigned)site.largest);
+        } else {
+            out.printf_P(PSTR("  0x%08x  %-10u  %-10u  %u\r\n"),
+                         (unsigned)site.caller, (unsigned)site.count,
+                         (unsigned)site.total, (unsigned)site.largest);
+        }
+    }
+
+    umm_trace_pause(false);
+#else
+    out.println(F("Heap trace disabled. Rebuild with -DUMM_HEAP_TRACE=<events> to enable."));
+#endif
+}
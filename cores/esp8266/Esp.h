@@ -22,8 +22,10 @@
 #define ESP_H
 
 #include <Arduino.h>
+#include <functional>
 #include "core_esp8266_features.h"
 #include "spi_vendors.h"
+#include "crash_blackbox.h"
 
 /**
  * AVR macros for WDT management
@@ -76,6 +78,50 @@ enum ADCMode {
 
 #define ADC_MODE(mode) int __get_adc_mode(void) { return (int) (mode); }
 
+#if defined(UMM_INFO)
+/**
+ * Snapshot of memory health counters delivered to an onHeapMetrics()
+ * callback. All values are gathered without a heap walk when the core is
+ * built with -DUMM_INLINE_METRICS; otherwise maxFreeBlock/fragmentation
+ * fall back to the umm_info() walk.
+ */
+struct EspHeapMetrics {
+    uint32_t freeHeap;       // bytes currently free, as getFreeHeap()
+    uint32_t maxFreeBlock;   // largest single allocation possible, in bytes
+    uint8_t fragmentation;   // in %, as getHeapFragmentation()
+    uint32_t freeContStack;  // continuous stack watermark, as getFreeContStack()
+};
+#endif
+
+/**
+ * Cycle-count checkpoints recorded along the boot path, from the first C
+ * code in app_entry() up to setup() returning; see
+ * EspClass::getBootTimeline(). All values are CPU cycle counts (the
+ * counter starts near reset); fields not reached yet read 0.
+ */
+struct EspBootTimeline {
+    uint32_t appEntry;     // first C code after ROM/bootloader
+    uint32_t userInit;     // SDK handed control to the core
+    uint32_t flashInit;    // flash config and chip quirk setup applied
+    uint32_t preinitDone;  // preinit() done, loop task registered
+    uint32_t sdkInitDone;  // SDK init (incl. phy init / RF cal) finished
+    uint32_t ctorsDone;    // C++ global constructors finished
+    uint32_t setupEntry;   // setup() entered
+    uint32_t setupDone;    // setup() returned, loop() starts
+};
+
+/**
+ * Loop-latency statistics gathered in loop_wrapper() when the core is built
+ * with -DESP_LOOP_STATS; see EspClass::getLoopStats().
+ */
+struct EspLoopStats {
+    uint32_t iterations;             // loop() passes recorded
+    uint32_t maxCycles;              // longest single pass, CPU cycles
+    uint32_t histogram[32];          // [i] counts passes with floor(log2(cycles)) == i
+    uint32_t slowestRecurrentPC;     // registration PC of the slowest scheduled recurrent function
+    uint32_t slowestRecurrentCycles; // its longest single run, CPU cycles
+};
+
 typedef enum {
      FM_QIO = 0x00,
      FM_QOUT = 0x01,
@@ -119,8 +165,81 @@ class EspClass {
         static uint8_t getHeapFragmentation(); // in %
         static void getHeapStats(uint32_t* free = nullptr, uint16_t* max = nullptr, uint8_t* frag = nullptr) __attribute__((deprecated("Use 'uint32_t*' on max, 2nd argument")));
         static void getHeapStats(uint32_t* free = nullptr, uint32_t* max = nullptr, uint8_t* frag = nullptr);
+        /**
+         * One coherent snapshot of the heap counters: all fields are
+         * sampled back-to-back with interrupts disabled, so they cannot
+         * shear against an allocation from an ISR. With
+         * -DUMM_INLINE_METRICS (the default) no heap walk happens at all;
+         * otherwise one umm_info() walk runs before the locked sampling.
+         */
+        static void getHeapStats(EspHeapMetrics& stats);
+        /**
+         * Register a callback to receive heap/stack metrics every
+         * @a intervalMs milliseconds from the scheduled-functions run in the
+         * main loop (never from an ISR). Pass a nullptr callback to stop
+         * publishing; registering again replaces the previous callback.
+         * Build with -DUMM_INLINE_METRICS to keep each sample O(1) and free
+         * of heap walks.
+         */
+        static void onHeapMetrics(const std::function<void(const EspHeapMetrics&)>& callback, uint32_t intervalMs = 1000);
 #endif
+        /**
+         * Dump the heap-usage flight recorder: the most recent heap
+         * operations (caller PC, size, op, cycle count) followed by the
+         * per-caller allocation aggregation table. Requires building with
+         * -DUMM_HEAP_TRACE; otherwise prints a note saying how to enable it.
+         */
+        static void dumpHeapTrace(Print& out);
+
+        /**
+         * Copy out the loop-iteration duration histogram (log2 cycle
+         * buckets) and the identity of the slowest scheduled recurrent
+         * function. Returns false (and zeroes @a stats) unless the core was
+         * built with -DESP_LOOP_STATS. Decode slowestRecurrentPC with the
+         * exception decoder to name the offender.
+         */
+        static bool getLoopStats(EspLoopStats* stats);
+        static void resetLoopStats();
+
+        /**
+         * Copy out the boot timeline (cycle counts at each boot-path
+         * checkpoint, always compiled in). The gap between userInit and
+         * sdkInitDone is dominated by phy init / RF calibration: on
+         * deep-sleep wake cycles it can be cut with
+         * ESP.deepSleep(us, WAKE_NO_RFCAL) or fleet-wide with
+         * RF_MODE(RF_NO_CAL); WiFi is already left off at boot unless
+         * enableWiFiAtBootTime() was called. Returns false only when
+         * @a timeline is null.
+         */
+        static bool getBootTimeline(EspBootTimeline* timeline);
+
+        /**
+         * Sleep governor: when enabled, idle time between loop() passes is
+         * handed to the SDK with light sleep allowed instead of being
+         * busy-spun. Each pass the governor computes the next
+         * recurrent-function deadline (Ticker/os_timer deadlines run in the
+         * SYS context and wake the nap by themselves) and blocks for the
+         * gap when it exceeds @a thresholdMs, capped at 50 ms per slice to
+         * keep serialEvent latency bounded. Enabling applies
+         * wifi_set_sleep_type(LIGHT_SLEEP_T); disabling restores
+         * MODEM_SLEEP_T.
+         */
+        static void autoLightSleep(bool enable, uint32_t thresholdMs = 5);
+
+        /**
+         * Percentage of wall time spent in governor-induced sleep since
+         * autoLightSleep() was enabled; 0 while disabled.
+         */
+        static uint8_t getSleepResidency();
+
         static uint32_t getFreeContStack();
+        /**
+         * Code address sampled from the continuation stack when its high
+         * water mark was last pushed deeper, or 0 if it has not moved since
+         * boot/resetFreeContStack(). Run it through the exception decoder to
+         * name the call path that got closest to a stack overflow.
+         */
+        static uint32_t getContStackDeepestPC();
         static void resetFreeContStack();
 
         static const char * getSdkVersion();
@@ -210,10 +329,43 @@ class EspClass {
         static String getResetInfo();
         static struct rst_info * getResetInfoPtr();
 
+        /**
+         * @brief Arm the crash black box with an application-reserved,
+         * sector-aligned flash byte address. On the next panic/exception the
+         * postmortem report is also persisted there in the compact binary
+         * format of crash_blackbox.h; a hardware-WDT dump staged by
+         * hwdt_app_entry (when built with -DDEBUG_ESP_HWDT) is committed here
+         * as well. Must also be called before reading the dump back.
+         */
+        static bool enableCrashDump(uint32_t flashAddress);
+        /**
+         * @brief Validate and read back the persisted crash frame header.
+         * @return true when a valid dump is present
+         */
+        static bool getCrashDump(crash_blackbox_frame_t& header);
+        /**
+         * @brief As above, additionally copying up to @a maxWords words of
+         * the persisted stack excerpt into @a stack (4-byte aligned).
+         * @return stack words copied, 0 when no valid dump is present
+         */
+        static size_t getCrashDump(crash_blackbox_frame_t& header, uint32_t* stack, size_t maxWords);
+        static void clearCrashDump();
+
         static bool eraseConfig();
 
         static uint8_t *random(uint8_t *resultArray, const size_t outputSizeBytes);
         static uint32_t random();
+        /**
+         * @brief Bulk random byte extraction backed by the core entropy pool.
+         *
+         * The pool is topped up with hardware RNG words in the idle path of the
+         * loop task, so bytes served from it cost only a copy here — unlike
+         * random(), which may have to pace RANDOM_REG32 reads with busy waits.
+         * When the request exceeds the pooled bytes, the remainder falls back
+         * to direct paced register reads, so the call always fills the buffer.
+         * @return resultArray
+         */
+        static uint8_t *randomBytes(uint8_t *resultArray, const size_t outputSizeBytes);
 
 #if !defined(CORE_MOCK)
         static inline uint32_t getCycleCount() __attribute__((always_inline))
@@ -244,6 +396,18 @@ class EspClass {
          * @return none
          */
         static void setExternalHeap();
+        /**
+         * @brief Automatic placement policy for the External heap: every
+         * allocation of at least @a bytes bytes goes to External SRAM first,
+         * with DRAM as fallback - large, cold objects (response buffers,
+         * caches) stop competing with small hot ones for internal heap.
+         * 0 disables the policy (default). No-op without UMM_HEAP_EXTERNAL.
+         * (Experimental)
+         *
+         * @param bytes minimum allocation size redirected to External
+         * @return none
+         */
+        static void setExternalHeapThreshold(size_t bytes);
         /**
          * @brief Restores Heap selection back to value present when
          * setDramHeap, setIramHeap, or setExternalHeap was called.
@@ -18,8 +18,12 @@
  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>
+
 #include "FS.h"
 #include "FSImpl.h"
+#include "Schedule.h"
+#include "flash_hal.h"
 
 using namespace fs;
 
@@ -157,6 +161,15 @@ bool File::isDirectory() const {
     return _p->isDirectory();
 }
 
+const uint8_t* File::mapped(size_t& size) const {
+    if (!_p) {
+        size = 0;
+        return nullptr;
+    }
+
+    return _p->mapped(size);
+}
+
 void File::rewindDirectory() {
     if (!_fakeDir) {
         _fakeDir = std::make_shared<Dir>(_baseFS->openDir(fullName()));
@@ -321,6 +334,33 @@ bool FS::gc() {
     return _impl->gc();
 }
 
+bool FS::gcStep(uint32_t maxMicros) {
+    if (!_impl) {
+        return false;
+    }
+    return _impl->gcStep(maxMicros);
+}
+
+void FS::autoGc(uint32_t watermarkBytes, uint32_t maxMicros) {
+    _autoGcWatermark = watermarkBytes;
+    _autoGcSliceUs = maxMicros;
+    if (!watermarkBytes || _autoGcScheduled) {
+        return;
+    }
+    _autoGcScheduled = true;
+    schedule_recurrent_function_us([this]() {
+        if (!_autoGcWatermark || !_impl) {
+            _autoGcScheduled = false;
+            return false;
+        }
+        FSInfo info;
+        if (_impl->info(info) && info.totalBytes - info.usedBytes < _autoGcWatermark) {
+            _impl->gcStep(_autoGcSliceUs);
+        }
+        return true;
+    }, 100 * 1000, nullptr, SCHEDULE_PRIO_LOW);
+}
+
 bool FS::check() {
     if (!_impl) {
         return false;
@@ -339,7 +379,18 @@ bool FS::info(FSInfo& info){
     if (!_impl) {
         return false;
     }
-    return _impl->info(info);
+    if (!_impl->info(info)) {
+        return false;
+    }
+    // wear is a property of the chip, not of any one filesystem
+    const flash_hal_stats_t* stats = flash_hal_stats();
+    info.flashEraseTotal = 0;
+    for (uint32_t i = 0; i <= FLASH_HAL_STATS_REGIONS; i++) {
+        info.flashEraseTotal += stats->eraseCount[i];
+    }
+    info.flashEraseMaxRegion = flash_hal_stats_max_erase();
+    info.flashIoErrors = stats->readErrors + stats->writeErrors + stats->eraseErrors;
+    return true;
 }
 
 bool FS::info64(FSInfo64& info){
@@ -453,6 +504,132 @@ void FS::setTimeCallback(time_t (*cb)(void)) {
 }
 
 
+bool CircularFile::begin(FS& fs, const char* path, uint32_t capacity) {
+    close();
+    if (!capacity) {
+        return false;
+    }
+
+    _file = fs.open(path, "r+");
+    if (_file && _file.size() == _headerSize + capacity) {
+        uint32_t hdr[4];
+        if (_file.seek(0)
+                && _file.read((uint8_t*)hdr, sizeof(hdr)) == sizeof(hdr)
+                && hdr[0] == _magic && hdr[1] == capacity
+                && hdr[2] < capacity && hdr[3] <= capacity) {
+            _capacity = capacity;
+            _head = hdr[2];
+            _count = hdr[3];
+            return true;
+        }
+    }
+
+    // (Re)create at full size up front so appends never allocate
+    _file.close();
+    _file = fs.open(path, "w+");
+    if (!_file) {
+        return false;
+    }
+    _capacity = capacity;
+    _head = 0;
+    _count = 0;
+    if (!_writeHeader()) {
+        close();
+        return false;
+    }
+    uint8_t zeros[256] = { 0 };
+    uint32_t left = capacity;
+    while (left) {
+        uint32_t chunk = std::min(left, (uint32_t)sizeof(zeros));
+        if (_file.write(zeros, chunk) != chunk) {
+            close();
+            return false;
+        }
+        left -= chunk;
+    }
+    _file.flush();
+    return true;
+}
+
+size_t CircularFile::write(const uint8_t* data, size_t len) {
+    if (!_file || !_capacity || !data) {
+        return 0;
+    }
+    size_t accepted = len;
+    if (len > _capacity) {
+        // only the trailing capacity bytes can survive anyway
+        data += len - _capacity;
+        len = _capacity;
+    }
+    size_t written = 0;
+    while (written < len) {
+        uint32_t chunk = std::min((uint32_t)(len - written), _capacity - _head);
+        if (!_writeAt(_head, data + written, chunk)) {
+            _count = std::min(_capacity, _count + (uint32_t)written);
+            return written;
+        }
+        _head = (_head + chunk) % _capacity;
+        written += chunk;
+    }
+    _count = std::min(_capacity, _count + (uint32_t)written);
+    return accepted;
+}
+
+size_t CircularFile::read(uint32_t offset, uint8_t* buf, size_t len) {
+    if (!_file || !buf || offset >= _count) {
+        return 0;
+    }
+    len = std::min(len, (size_t)(_count - offset));
+    uint32_t pos = (_head + _capacity - _count + offset) % _capacity;
+    size_t done = 0;
+    while (done < len) {
+        uint32_t chunk = std::min((uint32_t)(len - done), _capacity - pos);
+        if (!_readAt(pos, buf + done, chunk)) {
+            break;
+        }
+        pos = (pos + chunk) % _capacity;
+        done += chunk;
+    }
+    return done;
+}
+
+size_t CircularFile::readLast(uint8_t* buf, size_t len) {
+    len = std::min(len, (size_t)_count);
+    return read(_count - len, buf, len);
+}
+
+bool CircularFile::flush() {
+    if (!_file) {
+        return false;
+    }
+    bool ok = _writeHeader();
+    _file.flush();
+    return ok;
+}
+
+void CircularFile::close() {
+    if (_file) {
+        _writeHeader();
+        _file.close();
+    }
+    _capacity = 0;
+    _head = 0;
+    _count = 0;
+}
+
+bool CircularFile::_writeHeader() {
+    uint32_t hdr[4] = { _magic, _capacity, _head, _count };
+    return _file.seek(0) && _file.write((const uint8_t*)hdr, sizeof(hdr)) == sizeof(hdr);
+}
+
+bool CircularFile::_writeAt(uint32_t ringPos, const uint8_t* data, size_t len) {
+    return _file.seek(_headerSize + ringPos) && _file.write(data, len) == len;
+}
+
+bool CircularFile::_readAt(uint32_t ringPos, uint8_t* buf, size_t len) {
+    return _file.seek(_headerSize + ringPos) && _file.read(buf, len) == (int)len;
+}
+
 static bool sflags(const char* mode, OpenMode& om, AccessMode& am) {
     switch (mode[0]) {
         case 'r':
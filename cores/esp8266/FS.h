@@ -84,6 +84,14 @@ public:
     bool isFile() const;
     bool isDirectory() const;
 
+    // Zero-copy view of read-only file content through the mapped flash
+    // window (0x40200000).  Returns the content pointer and sets size, or
+    // nullptr when the filesystem can't expose this file contiguously
+    // (scattered storage, file opened for writing, or content outside the
+    // 1 MB mapped window).  The view is only valid until the file content
+    // is rewritten or removed.
+    const uint8_t* mapped(size_t& size) const;
+
     // Arduino "class SD" methods for compatibility
     //TODO use stream::send / check read(buf,size) result
     template<typename T> size_t write(T &src){
@@ -170,6 +178,16 @@ struct FSInfo {
     size_t pageSize;
     size_t maxOpenFiles;
     size_t maxPathLength;
+    // Path-lookup cache statistics; stay 0 on filesystems without a cache
+    uint32_t pathCacheHits = 0;
+    uint32_t pathCacheMisses = 0;
+    // Flash wear/health from the flash HAL accounting (flash_hal.h); the
+    // chip is shared, so every flash-backed filesystem reports the same
+    // numbers.  Since boot only, unless flash_hal_stats_begin() enabled
+    // persistence.
+    uint32_t flashEraseTotal = 0;     // erases anywhere on the chip
+    uint32_t flashEraseMaxRegion = 0; // hottest 1/16th of the FS area
+    uint32_t flashIoErrors = 0;       // failed reads + programs + erases
 };
 
 // Support > 4GB filesystems (SD, etc.)
@@ -246,6 +264,14 @@ public:
 
     // Low-level FS routines, not needed by most applications
     bool gc();
+    // Advance garbage collection in bounded slices of roughly maxMicros so
+    // that write latency stays predictable; call from loop() or a scheduled
+    // function. Returns true while work was performed (call again later).
+    bool gcStep(uint32_t maxMicros = 5000);
+    // Automatic background GC: while free space is below watermarkBytes, a
+    // low-priority scheduled function runs gcStep(maxMicros) periodically.
+    // Pass watermarkBytes = 0 to disable.
+    void autoGc(uint32_t watermarkBytes, uint32_t maxMicros = 5000);
     bool check();
 
     time_t getCreationTime();
@@ -256,10 +282,62 @@ public:
 protected:
     FSImplPtr _impl;
     FSImplPtr getImpl() { return _impl; }
+    uint32_t _autoGcWatermark = 0;
+    uint32_t _autoGcSliceUs = 0;
+    bool _autoGcScheduled = false;
     time_t (*_timeCallback)(void) = nullptr;
     static time_t _defaultTimeCB(void) { return time(NULL); }
 };
 
+// Preallocated fixed-size ring file for high-rate logging. The backing file
+// is created once at full size and afterwards only overwritten in place, so
+// steady-state appends never allocate blocks or trigger metadata compaction
+// (unlike rename+delete log rotation). Layout: a 16-byte header (magic,
+// capacity, head, count) followed by the payload ring. The header is only
+// persisted by flush() and close(), so records appended since the last
+// flush() are lost after a crash - call flush() at a cadence matching the
+// acceptable loss window.
+class CircularFile {
+public:
+    CircularFile() { }
+    ~CircularFile() { close(); }
+
+    // Open path as a ring holding capacity payload bytes, creating and
+    // preallocating it when absent. An existing ring with a different
+    // capacity or a corrupt header is recreated empty.
+    bool begin(FS& fs, const char* path, uint32_t capacity);
+
+    // O(1) append, wrapping over the oldest data. Returns bytes accepted.
+    size_t write(const uint8_t* data, size_t len);
+
+    // Read len bytes starting offset bytes past the oldest valid byte.
+    size_t read(uint32_t offset, uint8_t* buf, size_t len);
+
+    // Read the newest len bytes (the tail of the log).
+    size_t readLast(uint8_t* buf, size_t len);
+
+    uint32_t size() const { return _count; }
+    uint32_t capacity() const { return _capacity; }
+
+    // Persist the ring header; call periodically or before power-down.
+    bool flush();
+    void close();
+    operator bool() const { return (bool)_file; }
+
+private:
+    static constexpr uint32_t _magic = 0x43464c31; // "CFL1"
+    static constexpr uint32_t _headerSize = 16;
+
+    bool _writeHeader();
+    bool _writeAt(uint32_t ringPos, const uint8_t* data, size_t len);
+    bool _readAt(uint32_t ringPos, uint8_t* buf, size_t len);
+
+    File _file;
+    uint32_t _capacity = 0;
+    uint32_t _head = 0;  // next write position in the ring
+    uint32_t _count = 0; // valid payload bytes, <= _capacity
+};
+
 } // namespace fs
 
 extern "C"
@@ -280,6 +358,7 @@ using fs::SeekEnd;
 using fs::FSInfo;
 using fs::FSConfig;
 using fs::SPIFFSConfig;
+using fs::CircularFile;
 #endif //FS_NO_GLOBALS
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SPIFFS)
@@ -43,6 +43,12 @@ public:
     virtual bool isFile() const = 0;
     virtual bool isDirectory() const = 0;
 
+    // Filesystems *may* expose read-only file content directly out of the
+    // mapped flash window instead of copying it through RAM.  The default
+    // is to not support mapping; implementations must only return a pointer
+    // when the content is stored contiguously and lies inside the window.
+    virtual const uint8_t* mapped(size_t& size) { size = 0; return nullptr; }
+
     // Filesystems *may* support a timestamp per-file, so allow the user to override with
     // their own callback for *this specific* file (as opposed to the FSImpl call of the
     // same name.  The default implementation simply returns time(null)
@@ -114,6 +120,7 @@ public:
     virtual bool mkdir(const char* path) = 0;
     virtual bool rmdir(const char* path) = 0;
     virtual bool gc() { return true; } // May not be implemented in all file systems.
+    virtual bool gcStep(uint32_t maxMicros) { (void)maxMicros; return false; } // May not be implemented in all file systems.
     virtual bool check() { return true; } // May not be implemented in all file systems.
     virtual time_t getCreationTime() { return 0; } // May not be implemented in all file systems.
 
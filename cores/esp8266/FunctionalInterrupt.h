@@ -4,6 +4,13 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <functional>
+#include <type_traits>
+#include <new>
+#include <utility>
+
+#include <Arduino.h>
+#include <Schedule.h>
+#include <spsc_ringbuf.h>
 
 extern "C" {
 #include "c_types.h"
@@ -31,5 +38,121 @@ struct ArgStructure {
 void attachInterrupt(uint8_t pin, std::function<void(void)> intRoutine, int mode);
 void attachScheduledInterrupt(uint8_t pin, std::function<void(InterruptInfo)> scheduledIntRoutine, int mode);
 
+// ---- Fast, allocation-free variants ----------------------------------------
+//
+// attachInterrupt(pin, lambda, mode) stores the callable on the heap and
+// dispatches through std::function from ISR context.  The Fast variants keep
+// the callable in static storage dedicated to its type and invoke it directly
+// from the ISR trampoline: no heap allocation and no type-erased call on the
+// interrupt path.
+//
+// One static slot exists per *callable type*.  Every lambda has a unique
+// type, so attaching a different lambda to each pin is safe; re-attaching the
+// same callable type (e.g. the same function pointer signature, or one lambda
+// type to a second pin) re-constructs the shared slot and both pins would
+// invoke the newest state - use a distinct lambda per pin.
+
+extern "C" void __attachInterruptFunctionalArg(uint8_t pin, void (*userFunc)(void),
+                                               void* fp, int mode, bool functional);
+
+namespace detail
+{
+
+template<typename T>
+void IRAM_ATTR fastInterruptTrampoline(void* arg)
+{
+    (*static_cast<T*>(arg))();
+}
+
+template<typename T>
+struct FastInterruptStorage
+{
+    static inline typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    static inline bool constructed = false;
+
+    static T* emplace(T&& callable)
+    {
+        if (constructed)
+        {
+            reinterpret_cast<T*>(&storage)->~T();
+        }
+        new (&storage) T(std::move(callable));
+        constructed = true;
+        return reinterpret_cast<T*>(&storage);
+    }
+};
+
+// Scheduled flavour: the ISR only timestamps the event into a ring
+// preallocated at attach time and wakes the drain once per burst; the
+// callable runs in user context with each InterruptInfo.
+template<typename T>
+struct ScheduledFastSlot
+{
+    struct State
+    {
+        T callable;
+        spsc_ringbuf<InterruptInfo> events;
+        uint8_t pin;
+        State(T&& c, uint8_t p, size_t capacity) :
+            callable(std::move(c)), events(capacity), pin(p)
+        {
+        }
+    };
+
+    static inline State* state = nullptr;
+
+    static void drain()
+    {
+        InterruptInfo info;
+        while (state && state->events.pop(info))
+        {
+            state->callable(info);
+        }
+    }
+
+    static void IRAM_ATTR isr(void* arg)
+    {
+        State* s = static_cast<State*>(arg);
+        InterruptInfo info;
+        info.pin = s->pin;
+        info.value = digitalRead(s->pin);
+        info.micro = micros();
+        const bool wasIdle = s->events.available() == 0;
+        if (s->events.push(info) && wasIdle)
+        {
+            // one wakeup per burst, the drain empties the ring
+            schedule_function(drain);
+        }
+        // a full ring drops the newest event, like any saturated ring
+    }
+};
+
+} // namespace detail
+
+// Direct ISR dispatch of the callable; the callable runs in interrupt context
+// and must follow ISR rules (IRAM-resident code it calls, no allocation).
+template<typename Callable>
+void attachInterruptFast(uint8_t pin, Callable callable, int mode)
+{
+    using T = typename std::decay<Callable>::type;
+    T* stored = detail::FastInterruptStorage<T>::emplace(std::move(callable));
+    __attachInterruptFunctionalArg(pin, (void (*)(void))detail::fastInterruptTrampoline<T>,
+                                   stored, mode, false);
+}
+
+// Deferred dispatch: events (pin, level, micros) are captured into a ring of
+// eventQueueSize entries allocated once here, and the callable is invoked
+// from the scheduled-function context - never from the ISR.
+template<typename Callable>
+void attachScheduledInterruptFast(uint8_t pin, Callable callable, int mode,
+                                  size_t eventQueueSize = 8)
+{
+    using T = typename std::decay<Callable>::type;
+    using Slot = detail::ScheduledFastSlot<T>;
+    detachInterrupt(pin); // the old slot state must not be reachable from the ISR
+    delete Slot::state;
+    Slot::state = new typename Slot::State(std::move(callable), pin, eventQueueSize);
+    __attachInterruptFunctionalArg(pin, (void (*)(void))Slot::isr, Slot::state, mode, false);
+}
 
 #endif //INTERRUPTS_H
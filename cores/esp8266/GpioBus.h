@@ -0,0 +1,125 @@
+/*
+ GpioBus.h - direct multi-pin GPIO access for esp8266
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __GPIOBUS_H
+#define __GPIOBUS_H
+
+#include <stdint.h>
+#include "esp8266_peri.h"
+
+/*
+  Batch and compile-time-resolved GPIO access for bit-banged parallel
+  buses and other timing-critical pin work.  Everything here compiles to
+  one or two raw GPOS/GPOC/GPI register accesses, bypassing the per-call
+  pin mapping of digitalWrite()/digitalRead() (~1 us per pin) for
+  deterministic sub-100 ns updates.
+
+  Only GPIO0..GPIO15 are covered: GPIO16 sits in the RTC register bank
+  and cannot be part of a single-register bus transaction.  Pins must
+  already be configured with pinMode().
+*/
+
+namespace esp8266
+{
+namespace gpio
+{
+
+// Drive all pins of `mask` to the corresponding bits of `value` in two
+// register writes.  Pins going high are set just before pins going low
+// are cleared; the skew between the two writes is one register store.
+inline void writeBus(uint16_t mask, uint16_t value)
+{
+    GPOS = value & mask;
+    GPOC = (~value) & mask;
+}
+
+// Sample all pins of `mask` at once from the input register.
+inline uint16_t readBus(uint16_t mask)
+{
+    return GPI & mask;
+}
+
+// Switch all pins of `mask` to output / input in one register write.
+// Unlike pinMode() this does not touch function-select or pull-ups.
+inline void busOutput(uint16_t mask)
+{
+    GPES = mask;
+}
+
+inline void busInput(uint16_t mask)
+{
+    GPEC = mask;
+}
+
+// Compile-time pin: every method is a single register access with an
+// immediate mask, suitable for use inside ISRs and tight loops.
+template<uint8_t Pin>
+class DirectPin
+{
+    static_assert(Pin < 16, "DirectPin covers GPIO0..GPIO15 only (GPIO16 is in the RTC bank)");
+
+public:
+    static constexpr uint32_t mask = 1UL << Pin;
+
+    static void high()
+    {
+        GPOS = mask;
+    }
+
+    static void low()
+    {
+        GPOC = mask;
+    }
+
+    static void write(bool level)
+    {
+        if (level)
+            high();
+        else
+            low();
+    }
+
+    static bool read()
+    {
+        return (GPI & mask) != 0;
+    }
+
+    static void toggle()
+    {
+        write(!(GPO & mask));
+    }
+
+    // direction only; configure the pin with pinMode() first
+    static void output()
+    {
+        GPES = mask;
+    }
+
+    static void input()
+    {
+        GPEC = mask;
+    }
+};
+
+} // namespace gpio
+} // namespace esp8266
+
+#endif // __GPIOBUS_H
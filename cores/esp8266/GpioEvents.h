@@ -0,0 +1,105 @@
+/*
+ GpioEvents.h - batch pin-change event capture for the GPIO interrupt
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef GPIO_EVENTS_H
+#define GPIO_EVENTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Timestamp-first alternative to attachInterrupt(): instead of dispatching a
+// user callback per edge, the GPIO ISR appends one (status, levels, cycles)
+// record per interrupt to a lock-free ring and returns - a few dozen cycles
+// per edge instead of the full handler dispatch.  The sketch drains the ring
+// from loop() and gets exact edge timing, good for frequency measurement up
+// to tens of kHz on several pins at once (rotary encoders, flow meters):
+//
+//      gpioEvents.begin((1 << ENCODER_A) | (1 << FLOW1), CHANGE, 128);
+//      void loop() {
+//          GpioEvent e;
+//          while (gpioEvents.read(e)) {
+//              if (e.status & (1 << FLOW1))
+//                  pulsePeriod = e.cycles - lastCycles[FLOW1];
+//              ...
+//          }
+//      }
+//
+// Capture coexists with attachInterrupt() on other pins; a pin can be in
+// either mode, not both.  Edges arriving while the ring is full are dropped
+// and counted in overflows().
+
+struct GpioEvent
+{
+    uint32_t status;  // captured pins that triggered this interrupt (bitmask)
+    uint32_t levels;  // GPIO input register (GPI) snapshot at interrupt time
+    uint32_t cycles;  // CPU cycle counter (ESP.getCycleCount() units)
+};
+
+extern "C"
+{
+    // Start capturing pins in pinMask (GPIO0..15) on the given edge/level
+    // mode (RISING/FALLING/CHANGE/ONLOW/ONHIGH), with a ring of at least
+    // minEvents records (rounded up to a power of two, 12 bytes each).
+    // False on allocation failure.  Calling again reconfigures the mask and
+    // mode and, when minEvents changes, replaces (and empties) the ring.
+    bool gpio_capture_begin(uint32_t pinMask, int mode, size_t minEvents);
+
+    // Stop capturing and release the ring.
+    void gpio_capture_end(void);
+
+    // Pop the oldest record; false when the ring is empty.
+    bool gpio_capture_read(GpioEvent* event);
+
+    // Records waiting in the ring.
+    size_t gpio_capture_available(void);
+
+    // Interrupts dropped because the ring was full, since begin().
+    uint32_t gpio_capture_overflows(void);
+}
+
+class GpioEventRecorder
+{
+public:
+    bool begin(uint32_t pinMask, int mode, size_t minEvents = 64)
+    {
+        return gpio_capture_begin(pinMask, mode, minEvents);
+    }
+    void end()
+    {
+        gpio_capture_end();
+    }
+    bool read(GpioEvent& event)
+    {
+        return gpio_capture_read(&event);
+    }
+    size_t available() const
+    {
+        return gpio_capture_available();
+    }
+    uint32_t overflows() const
+    {
+        return gpio_capture_overflows();
+    }
+};
+
+extern GpioEventRecorder gpioEvents;
+
+#endif  // GPIO_EVENTS_H
@@ -0,0 +1,597 @@
+/**
+ * GzipInflater.cpp
+ *
+ * Streaming gzip / deflate decoder, see GzipInflater.h.
+ *
+ * The deflate core follows the classic puff/tinf structure: canonical
+ * Huffman tables stored as per-length counts plus a sorted symbol list,
+ * decoded bit by bit.  It is self-contained on purpose - the core's
+ * crc32() is the non-reflected polynomial and cannot verify gzip
+ * trailers, and no inflate implementation ships with the core.
+ *
+ * Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ * This file is part of the esp8266 core for Arduino.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "GzipInflater.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+
+// Reflected CRC-32 (0xEDB88320), nibble-at-a-time.  gzip trailers use this
+// variant; the core's crc32() implements the non-reflected polynomial.
+const uint32_t crcNibble[16] PROGMEM = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+    0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+uint32_t crcUpdate(uint32_t crc, const uint8_t* data, size_t len)
+{
+    while (len--)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ pgm_read_dword(&crcNibble[crc & 0x0f]);
+        crc = (crc >> 4) ^ pgm_read_dword(&crcNibble[crc & 0x0f]);
+    }
+    return crc;
+}
+
+// RFC 1951 3.2.5: length/distance code base values and extra bit counts
+const uint16_t lengthBase[29] PROGMEM = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+const uint8_t lengthExtra[29] PROGMEM = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+const uint16_t distBase[30] PROGMEM = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+const uint8_t distExtra[30] PROGMEM = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// RFC 1951 3.2.7: order in which code length code lengths are stored
+const uint8_t clcOrder[19] PROGMEM = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+} // namespace
+
+GzipInflater::GzipInflater(Source source, uint8_t windowBits):
+    _source(source)
+{
+    if (windowBits < 9)
+    {
+        windowBits = 9;
+    }
+    else if (windowBits > 15)
+    {
+        windowBits = 15;
+    }
+    _wsize = 1u << windowBits;
+    _wmask = _wsize - 1;
+    _window = (uint8_t*)malloc(_wsize);
+}
+
+GzipInflater::~GzipInflater()
+{
+    free(_window);
+}
+
+int GzipInflater::nextByte()
+{
+    if (_inpos >= _inavail)
+    {
+        int got = _source(_inbuf, sizeof(_inbuf));
+        if (got <= 0)
+        {
+            return -1;
+        }
+        _inavail = got;
+        _inpos = 0;
+    }
+    return _inbuf[_inpos++];
+}
+
+int GzipInflater::getBits(int count)
+{
+    while ((int)_bitcnt < count)
+    {
+        int b = nextByte();
+        if (b < 0)
+        {
+            return -1;
+        }
+        _bitbuf |= (uint32_t)b << _bitcnt;
+        _bitcnt += 8;
+    }
+    int value = _bitbuf & ((1u << count) - 1);
+    _bitbuf >>= count;
+    _bitcnt -= count;
+    return value;
+}
+
+bool GzipInflater::flush(Print& out)
+{
+    while (_pending)
+    {
+        uint32_t start = (_wpos - _pending) & _wmask;
+        uint32_t len = _pending;
+        if (len > _wsize - start)
+        {
+            len = _wsize - start;
+        }
+        _crc = crcUpdate(_crc, _window + start, len);
+        if (out.write(_window + start, len) != len)
+        {
+            return false;
+        }
+        _pending -= len;
+    }
+    return true;
+}
+
+bool GzipInflater::emit(uint8_t b, Print& out)
+{
+    _window[_wpos] = b;
+    _wpos = (_wpos + 1) & _wmask;
+    ++_total;
+    if (_wpos == 0)
+    {
+        _wrapped = true;
+    }
+    // flush before the writer laps the unflushed region
+    return ++_pending != _wsize || flush(out);
+}
+
+void GzipInflater::buildTable(HuffTable& t, const uint8_t* lengths, unsigned count)
+{
+    memset(t.counts, 0, sizeof(t.counts));
+    for (unsigned i = 0; i < count; i++)
+    {
+        t.counts[lengths[i]]++;
+    }
+    t.counts[0] = 0;
+
+    uint16_t offsets[16];
+    offsets[0] = 0;
+    for (unsigned len = 1; len < 16; len++)
+    {
+        offsets[len] = offsets[len - 1] + t.counts[len - 1];
+    }
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (lengths[i])
+        {
+            t.symbols[offsets[lengths[i]]++] = i;
+        }
+    }
+}
+
+int GzipInflater::decodeSymbol(const HuffTable& t)
+{
+    int code = 0, first = 0, index = 0;
+    for (int len = 1; len < 16; len++)
+    {
+        int b = getBits(1);
+        if (b < 0)
+        {
+            return ERR_INPUT;
+        }
+        code |= b;
+        int count = t.counts[len];
+        if (code - first < count)
+        {
+            return t.symbols[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return ERR_FORMAT;
+}
+
+void GzipInflater::buildFixedTables()
+{
+    uint8_t lengths[288];
+    unsigned i = 0;
+    for (; i < 144; i++)
+    {
+        lengths[i] = 8;
+    }
+    for (; i < 256; i++)
+    {
+        lengths[i] = 9;
+    }
+    for (; i < 280; i++)
+    {
+        lengths[i] = 7;
+    }
+    for (; i < 288; i++)
+    {
+        lengths[i] = 8;
+    }
+    buildTable(_ltab, lengths, 288);
+
+    for (i = 0; i < 30; i++)
+    {
+        lengths[i] = 5;
+    }
+    buildTable(_dtab, lengths, 30);
+}
+
+int GzipInflater::readDynamicTables()
+{
+    int hlit = getBits(5);
+    int hdist = getBits(5);
+    int hclen = getBits(4);
+    if (hlit < 0 || hdist < 0 || hclen < 0)
+    {
+        return ERR_INPUT;
+    }
+    hlit += 257;
+    hdist += 1;
+    hclen += 4;
+    if (hlit > 286 || hdist > 30)
+    {
+        return ERR_FORMAT;
+    }
+
+    uint8_t lengths[288 + 32];
+    memset(lengths, 0, 19);
+    for (int i = 0; i < hclen; i++)
+    {
+        int len = getBits(3);
+        if (len < 0)
+        {
+            return ERR_INPUT;
+        }
+        lengths[pgm_read_byte(&clcOrder[i])] = len;
+    }
+    buildTable(_ltab, lengths, 19); // borrow _ltab for the code length code
+
+    int count = hlit + hdist;
+    for (int i = 0; i < count;)
+    {
+        int sym = decodeSymbol(_ltab);
+        if (sym < 0)
+        {
+            return sym;
+        }
+        if (sym < 16)
+        {
+            lengths[i++] = sym;
+            continue;
+        }
+        int repeat, value = 0;
+        if (sym == 16)
+        {
+            if (i == 0)
+            {
+                return ERR_FORMAT;
+            }
+            value = lengths[i - 1];
+            repeat = getBits(2);
+            if (repeat < 0)
+            {
+                return ERR_INPUT;
+            }
+            repeat += 3;
+        }
+        else if (sym == 17)
+        {
+            repeat = getBits(3);
+            if (repeat < 0)
+            {
+                return ERR_INPUT;
+            }
+            repeat += 3;
+        }
+        else
+        {
+            repeat = getBits(7);
+            if (repeat < 0)
+            {
+                return ERR_INPUT;
+            }
+            repeat += 11;
+        }
+        if (i + repeat > count)
+        {
+            return ERR_FORMAT;
+        }
+        while (repeat--)
+        {
+            lengths[i++] = value;
+        }
+    }
+    if (lengths[256] == 0)
+    {
+        return ERR_FORMAT; // no end-of-block code
+    }
+
+    buildTable(_ltab, lengths, hlit);
+    buildTable(_dtab, lengths + hlit, hdist);
+    return 0;
+}
+
+int GzipInflater::inflateStored(Print& out)
+{
+    // stored blocks start on a byte boundary
+    _bitbuf = 0;
+    _bitcnt = 0;
+    int l0 = nextByte(), l1 = nextByte(), n0 = nextByte(), n1 = nextByte();
+    if (n1 < 0)
+    {
+        return ERR_INPUT;
+    }
+    unsigned len = l0 | (l1 << 8);
+    unsigned nlen = n0 | (n1 << 8);
+    if (len != (~nlen & 0xffff))
+    {
+        return ERR_FORMAT;
+    }
+    while (len--)
+    {
+        int b = nextByte();
+        if (b < 0)
+        {
+            return ERR_INPUT;
+        }
+        if (!emit(b, out))
+        {
+            return ERR_WRITE;
+        }
+    }
+    return 0;
+}
+
+int GzipInflater::inflateBlockData(Print& out)
+{
+    for (;;)
+    {
+        int sym = decodeSymbol(_ltab);
+        if (sym < 0)
+        {
+            return sym;
+        }
+        if (sym < 256)
+        {
+            if (!emit(sym, out))
+            {
+                return ERR_WRITE;
+            }
+            continue;
+        }
+        if (sym == 256)
+        {
+            return 0; // end of block
+        }
+
+        sym -= 257;
+        if (sym >= 29)
+        {
+            return ERR_FORMAT;
+        }
+        int extra = getBits(pgm_read_byte(&lengthExtra[sym]));
+        if (extra < 0)
+        {
+            return ERR_INPUT;
+        }
+        unsigned length = pgm_read_word(&lengthBase[sym]) + extra;
+
+        int dsym = decodeSymbol(_dtab);
+        if (dsym < 0)
+        {
+            return dsym;
+        }
+        if (dsym >= 30)
+        {
+            return ERR_FORMAT;
+        }
+        extra = getBits(pgm_read_byte(&distExtra[dsym]));
+        if (extra < 0)
+        {
+            return ERR_INPUT;
+        }
+        uint32_t distance = pgm_read_word(&distBase[dsym]) + extra;
+        if (distance > (_wrapped ? _wsize : _wpos))
+        {
+            return ERR_WINDOW;
+        }
+        while (length--)
+        {
+            if (!emit(_window[(_wpos - distance) & _wmask], out))
+            {
+                return ERR_WRITE;
+            }
+        }
+    }
+}
+
+int GzipInflater::inflate(Print& out, Format format)
+{
+    if (!_window)
+    {
+        return ERR_MEM;
+    }
+
+    bool checkTrailer = false;
+    if (format == FORMAT_GZIP)
+    {
+        // RFC 1952 header: magic, CM=deflate, flags, MTIME/XFL/OS (skipped)
+        int id1 = nextByte(), id2 = nextByte(), cm = nextByte(), flg = nextByte();
+        if (flg < 0)
+        {
+            return ERR_INPUT;
+        }
+        if (id1 != 0x1f || id2 != 0x8b || cm != 8 || (flg & 0xe0))
+        {
+            return ERR_FORMAT;
+        }
+        for (int i = 0; i < 6; i++)
+        {
+            if (nextByte() < 0)
+            {
+                return ERR_INPUT;
+            }
+        }
+        if (flg & 0x04) // FEXTRA
+        {
+            int x0 = nextByte(), x1 = nextByte();
+            if (x1 < 0)
+            {
+                return ERR_INPUT;
+            }
+            for (int skip = x0 | (x1 << 8); skip; skip--)
+            {
+                if (nextByte() < 0)
+                {
+                    return ERR_INPUT;
+                }
+            }
+        }
+        for (int field = 0; field < 2; field++) // FNAME, FCOMMENT
+        {
+            if (!(flg & (field ? 0x10 : 0x08)))
+            {
+                continue;
+            }
+            int b;
+            do
+            {
+                b = nextByte();
+                if (b < 0)
+                {
+                    return ERR_INPUT;
+                }
+            } while (b);
+        }
+        if (flg & 0x02) // FHCRC
+        {
+            if (nextByte() < 0 || nextByte() < 0)
+            {
+                return ERR_INPUT;
+            }
+        }
+        checkTrailer = true;
+    }
+    else
+    {
+        // "deflate" in the wild is either zlib-wrapped (RFC 1950) or raw;
+        // sniff the two header bytes and push them back when raw
+        int b0 = nextByte();
+        if (b0 < 0)
+        {
+            return ERR_INPUT;
+        }
+        int b1 = nextByte();
+        if (b1 < 0)
+        {
+            return ERR_INPUT;
+        }
+        if ((b0 & 0x0f) == 8 && ((b0 << 8) | b1) % 31 == 0)
+        {
+            if (b1 & 0x20)
+            {
+                return ERR_FORMAT; // FDICT: preset dictionaries unsupported
+            }
+        }
+        else
+        {
+            _bitbuf = b0 | ((uint32_t)b1 << 8);
+            _bitcnt = 16;
+        }
+    }
+
+    for (;;)
+    {
+        int bfinal = getBits(1);
+        int btype = getBits(2);
+        if (bfinal < 0 || btype < 0)
+        {
+            return ERR_INPUT;
+        }
+        int err;
+        switch (btype)
+        {
+        case 0:
+            err = inflateStored(out);
+            break;
+        case 1:
+            buildFixedTables();
+            err = inflateBlockData(out);
+            break;
+        case 2:
+            err = readDynamicTables();
+            if (!err)
+            {
+                err = inflateBlockData(out);
+            }
+            break;
+        default:
+            return ERR_FORMAT;
+        }
+        if (err)
+        {
+            return err;
+        }
+        if (bfinal)
+        {
+            break;
+        }
+    }
+
+    if (!flush(out))
+    {
+        return ERR_WRITE;
+    }
+
+    if (checkTrailer)
+    {
+        // at most 7 padding bits remain; the trailer is byte-aligned
+        _bitbuf = 0;
+        _bitcnt = 0;
+        uint32_t trailer[2] = { 0, 0 };
+        for (int i = 0; i < 8; i++)
+        {
+            int b = nextByte();
+            if (b < 0)
+            {
+                return ERR_INPUT;
+            }
+            trailer[i >> 2] |= (uint32_t)b << ((i & 3) * 8);
+        }
+        if (trailer[0] != (_crc ^ 0xffffffff) || trailer[1] != _total)
+        {
+            return ERR_CHECKSUM;
+        }
+    }
+
+    return (_total > INT_MAX) ? INT_MAX : (int)_total;
+}
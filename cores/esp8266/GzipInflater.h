@@ -0,0 +1,122 @@
+/**
+ * GzipInflater.h
+ *
+ * Streaming gzip / deflate (RFC 1951/1950/1952) decoder, used by
+ * HTTPClient to decompress response bodies on the fly and by Updater to
+ * verify staged GZIP OTA images.
+ *
+ * The decoder pulls compressed bytes from a caller-supplied source and
+ * writes plain data to a Print, holding only a back-reference window of
+ * 1 << windowBits bytes (default 32 KB, the RFC maximum) plus ~1.2 KB of
+ * Huffman tables.  The window doubles as the output buffer, so data
+ * reaches the sink in window-sized writes.  Note the object is dominated
+ * by its embedded tables - heap-allocate it rather than placing it on the
+ * tight continuation stack.
+ *
+ * Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ * This file is part of the esp8266 core for Arduino.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef GZIPINFLATER_H_
+#define GZIPINFLATER_H_
+
+#include <Arduino.h>
+#include <functional>
+
+class GzipInflater
+{
+public:
+    /// Fills buf with up to len compressed bytes; returns the count read,
+    /// or 0 / negative when the input is exhausted (or timed out).
+    using Source = std::function<int(uint8_t* buf, size_t len)>;
+
+    /// Container format: gzip checks the CRC32/length trailer; deflate
+    /// accepts both zlib-wrapped and raw deflate data (no check).
+    enum Format { FORMAT_GZIP, FORMAT_DEFLATE };
+
+    enum
+    {
+        ERR_INPUT = -1,     ///< compressed input ended early or timed out
+        ERR_FORMAT = -2,    ///< not a valid gzip/zlib/deflate stream
+        ERR_CHECKSUM = -3,  ///< gzip CRC32 or length trailer mismatch
+        ERR_WINDOW = -4,    ///< back-reference beyond the configured window
+        ERR_WRITE = -5,     ///< output did not accept all data
+        ERR_MEM = -6        ///< window allocation failed
+    };
+
+    /// windowBits selects a back-reference window of 1 << windowBits bytes
+    /// (9..15).  RFC 1952 allows distances up to 32768 (windowBits 15);
+    /// a smaller window only decodes streams from a sender configured to
+    /// match (e.g. nginx "gzip_window"), otherwise ERR_WINDOW results.
+    GzipInflater(Source source, uint8_t windowBits = 15);
+    ~GzipInflater();
+
+    GzipInflater(const GzipInflater&) = delete;
+    GzipInflater& operator=(const GzipInflater&) = delete;
+
+    /// false when the window could not be allocated
+    bool valid() const
+    {
+        return _window != nullptr;
+    }
+
+    /// Decodes one complete stream, writing the plain data to out.
+    /// Returns the number of bytes written, or a negative error code.
+    int inflate(Print& out, Format format = FORMAT_GZIP);
+
+private:
+    struct HuffTable
+    {
+        uint16_t counts[16];  // number of codes per bit length
+        uint16_t symbols[288]; // symbols ordered by (length, value)
+    };
+
+    int nextByte();
+    int getBits(int count);
+    bool emit(uint8_t b, Print& out);
+    bool flush(Print& out);
+    int decodeSymbol(const HuffTable& t);
+    static void buildTable(HuffTable& t, const uint8_t* lengths, unsigned count);
+    int inflateStored(Print& out);
+    int inflateBlockData(Print& out);
+    int readDynamicTables();
+    void buildFixedTables();
+
+    Source _source;
+
+    uint8_t _inbuf[64];
+    unsigned _inpos = 0;
+    unsigned _inavail = 0;
+
+    uint32_t _bitbuf = 0;
+    unsigned _bitcnt = 0;
+
+    uint8_t* _window;
+    uint32_t _wsize;
+    uint32_t _wmask;
+    uint32_t _wpos = 0;
+    uint32_t _pending = 0;
+    bool _wrapped = false;
+
+    uint32_t _total = 0;
+    uint32_t _crc = 0xffffffff;
+
+    HuffTable _ltab;
+    HuffTable _dtab;
+};
+
+#endif /* GZIPINFLATER_H_ */
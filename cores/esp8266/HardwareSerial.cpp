@@ -31,6 +31,7 @@
 #include "Arduino.h"
 #include "HardwareSerial.h"
 #include "Esp.h"
+#include "Schedule.h"
 
 
 // SerialEvent functions are weak, so when the user doesn't define them,
@@ -38,13 +39,15 @@
 void serialEvent() __attribute__((weak));
 
 HardwareSerial::HardwareSerial(int uart_nr)
-    : _uart_nr(uart_nr), _rx_size(256)
+    : _uart_nr(uart_nr), _rx_size(256), _tx_size(0)
 {}
 
 void HardwareSerial::begin(unsigned long baud, SerialConfig config, SerialMode mode, uint8_t tx_pin, bool invert)
 {
     end();
     _uart = uart_init(_uart_nr, baud, (int) config, (int) mode, tx_pin, _rx_size, invert);
+    if (_uart && _tx_size)
+        _tx_size = uart_resize_tx_buffer(_uart, _tx_size);
 #if defined(DEBUG_ESP_PORT) && !defined(NDEBUG)
     if (static_cast<void*>(this) == static_cast<void*>(&DEBUG_ESP_PORT))
     {
@@ -83,6 +86,15 @@ size_t HardwareSerial::setRxBufferSize(size_t size){
     return _rx_size;
 }
 
+size_t HardwareSerial::setTxBufferSize(size_t size){
+    if(_uart) {
+        _tx_size = uart_resize_tx_buffer(_uart, size);
+    } else {
+        _tx_size = size;
+    }
+    return _tx_size;
+}
+
 void HardwareSerial::setDebugOutput(bool en)
 {
     if(!_uart) {
@@ -125,6 +137,56 @@ void HardwareSerial::flush()
     delayMicroseconds(bit_length * 1000000 / uart_get_baudrate(_uart) + 1);
 }
 
+bool HardwareSerial::onMessage(std::function<void(const char* data, size_t len)> cb, char terminator)
+{
+    if (!cb)
+    {
+        bool ok = uart_set_rx_framing(_uart, -1, 0, nullptr, nullptr);
+        _onMessage = nullptr;
+        return ok;
+    }
+    _onMessage = std::move(cb);
+    return uart_set_rx_framing(_uart, (uint8_t)terminator, 0, _onMessageNotify, this);
+}
+
+bool HardwareSerial::onMessageLength(std::function<void(const char* data, size_t len)> cb, size_t length)
+{
+    if (!cb || length == 0)
+    {
+        bool ok = uart_set_rx_framing(_uart, -1, 0, nullptr, nullptr);
+        _onMessage = nullptr;
+        return ok;
+    }
+    _onMessage = std::move(cb);
+    return uart_set_rx_framing(_uart, -1, length, _onMessageNotify, this);
+}
+
+void IRAM_ATTR HardwareSerial::_onMessageNotify(void* arg)
+{
+    HardwareSerial* self = static_cast<HardwareSerial*>(arg);
+    if (self->_messageScheduled)
+        // a delivery pass is already queued, it will drain this frame too
+        return;
+    self->_messageScheduled = true;
+    if (!schedule_function([self]() { self->_deliverMessages(); }))
+        // pool exhausted: let the next completed frame retry
+        self->_messageScheduled = false;
+}
+
+void HardwareSerial::_deliverMessages()
+{
+    // clear before draining: a frame completing during delivery schedules
+    // another pass instead of being stranded until the next one
+    _messageScheduled = false;
+    uart_rx_deliver_frames(_uart,
+        [](void* arg, const char* data, size_t len)
+        {
+            HardwareSerial* self = static_cast<HardwareSerial*>(arg);
+            if (self->_onMessage)
+                self->_onMessage(data, len);
+        }, this);
+}
+
 void HardwareSerial::startDetectBaudrate()
 {
     uart_start_detect_baudrate(_uart_nr);
@@ -28,6 +28,7 @@
 #define HardwareSerial_h
 
 #include <inttypes.h>
+#include <functional>
 #include <../include/time.h> // See issue #6714
 #include "Stream.h"
 #include "uart.h"
@@ -101,6 +102,24 @@ public:
         return uart_get_rx_buffer_size(_uart);
     }
 
+    // Automatic RTS flow control on GPIO15 driven by RX buffer occupancy:
+    // the sender is paused at the high watermark and resumed once reads
+    // drained the buffer to the low watermark (Serial/UART0 only).
+    // highWatermark = 0 disables.  Reconfigure after setRxBufferSize().
+    bool setRxFlowControl(size_t highWatermark, size_t lowWatermark)
+    {
+        return uart_set_rx_flow_control(_uart, highWatermark, lowWatermark);
+    }
+
+    // Interrupt-driven TX: writes land in a ring drained by the uart isr
+    // on the fifo-empty-threshold interrupt, so print() no longer blocks
+    // (availableForWrite() reflects the ring).  0 restores blocking TX.
+    size_t setTxBufferSize(size_t size);
+    size_t getTxBufferSize()
+    {
+        return uart_get_tx_buffer_size(_uart);
+    }
+
     bool swap()
     {
         return swap(1);
@@ -221,6 +240,18 @@ public:
         return uart_has_rx_error(_uart);
     }
 
+    // RX line framing: the uart isr marks message boundaries as bytes
+    // arrive and cb runs from the scheduled-function queue (same context as
+    // loop()) with a (data,len) view of each complete message - zero-copy
+    // into the RX buffer, only valid during the call.  A message ends at
+    // 'terminator' (onMessage, terminator included in the view) or every
+    // 'length' bytes (onMessageLength).  While a handler is installed the
+    // regular read()/peek() calls must not be used; anything buffered when
+    // the handler is installed is discarded.  cb = nullptr uninstalls and
+    // restores normal reading.  Call after begin().  Serial/UART0 only.
+    bool onMessage(std::function<void(const char* data, size_t len)> cb, char terminator = '\n');
+    bool onMessageLength(std::function<void(const char* data, size_t len)> cb, size_t length);
+
     void startDetectBaudrate();
 
     unsigned long testBaudrate();
@@ -228,9 +259,16 @@ public:
     unsigned long detectBaudrate(time_t timeoutMillis);
 
 protected:
+    static void _onMessageNotify(void* arg); // isr context
+    void _deliverMessages();
+
     int _uart_nr;
     uart_t* _uart = nullptr;
     size_t _rx_size;
+    size_t _tx_size;
+    std::function<void(const char*, size_t)> _onMessage;
+    // collapses notification bursts into one scheduled delivery pass
+    volatile bool _messageScheduled = false;
 };
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SERIAL)
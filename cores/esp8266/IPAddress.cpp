@@ -19,38 +19,14 @@
 
 #include <Arduino.h>
 #include <IPAddress.h>
+#include <NumberFormat.h>
 #include <Print.h>
 #include <StreamString.h>
 
-IPAddress::IPAddress(const IPAddress& from)
-{
-    ip_addr_copy(_ip, from._ip);
-}
-
-IPAddress::IPAddress(IPAddress&& from)
-{
-    ip_addr_copy(_ip, from._ip);
-}
-
-IPAddress::IPAddress() {
-    _ip = *IP_ANY_TYPE; // lwIP's v4-or-v6 generic address
-}
-
 bool IPAddress::isSet () const {
     return !ip_addr_isany(&_ip) && ((*this) != IPADDR_NONE);
 }
 
-IPAddress::IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet) {
-    uint8_t addr[] {
-        first_octet,
-        second_octet,
-        third_octet,
-        fourth_octet,
-    };
-
-    *this = &addr[0];
-}
-
 bool IPAddress::fromString(const char *address) {
     if (!fromString4(address)) {
 #if LWIP_IPV6
@@ -155,12 +131,17 @@ size_t IPAddress::printTo(Print& p) const {
     }
 #endif
 
-    for(int i = 0; i < 4; i++) {
-        n += p.print((*this)[i], DEC);
-        if (i != 3)
-            n += p.print('.');
+    // format the whole dotted quad backwards with the two-digit LUT and
+    // hand it out in a single write() instead of seven print() calls
+    char buf[16];
+    char* end = &buf[sizeof(buf)];
+    char* cur = end;
+    for (int i = 3; i >= 0; i--) {
+        cur = numfmt_utoa10((*this)[i], cur);
+        if (i != 0)
+            *--cur = '.';
     }
-    return n;
+    return n + p.write(cur, end - cur);
 }
 
 String IPAddress::toString() const
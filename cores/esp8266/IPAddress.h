@@ -62,11 +62,30 @@ class IPAddress: public Printable {
         }
 
     public:
-        IPAddress();
-        IPAddress(const IPAddress&);
-        IPAddress(IPAddress&&);
+        // constexpr: a static address built from octet literals is
+        // constant-initialized - no runtime constructor code runs for it
+#if LWIP_IPV6
+        constexpr IPAddress():
+            _ip { { { { 0ul, 0ul, 0ul, 0ul } IPADDR6_ZONE_INIT } }, IPADDR_TYPE_ANY } // = *IP_ANY_TYPE
+        {
+        }
+        constexpr IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet):
+            _ip { { .ip4 = { PP_HTONL(LWIP_MAKEU32(first_octet, second_octet, third_octet, fourth_octet)) } }, IPADDR_TYPE_V4 }
+        {
+        }
+#else
+        constexpr IPAddress():
+            _ip { IPADDR_ANY }
+        {
+        }
+        constexpr IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet):
+            _ip { PP_HTONL(LWIP_MAKEU32(first_octet, second_octet, third_octet, fourth_octet)) }
+        {
+        }
+#endif
+        constexpr IPAddress(const IPAddress&) = default;
+        constexpr IPAddress(IPAddress&&) = default;
 
-        IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet);
         IPAddress(uint32_t address) { *this = address; }
         IPAddress(unsigned long address) { *this = address; }
         IPAddress(int address) { *this = address; }
@@ -77,7 +96,7 @@ class IPAddress: public Printable {
 
         // Overloaded cast operator to allow IPAddress objects to be used where a pointer
         // to a four-byte uint8_t array is expected
-        operator uint32_t() const { return isV4()? v4(): (uint32_t)0; }
+        constexpr operator uint32_t() const { return isV4()? v4(): (uint32_t)0; }
         operator uint32_t()       { return isV4()? v4(): (uint32_t)0; }
 
         bool isSet () const;
@@ -85,7 +104,7 @@ class IPAddress: public Printable {
         operator bool ()       { return isSet(); } // <- both are needed
 
         // generic IPv4 wrapper to uint32-view like arduino loves to see it
-        const uint32_t& v4() const { return ip_2_ip4(&_ip)->addr; }
+        constexpr const uint32_t& v4() const { return ip_2_ip4(&_ip)->addr; }
               uint32_t& v4()       { return ip_2_ip4(&_ip)->addr; }
 
         bool operator==(const IPAddress& addr) const {
@@ -94,26 +113,26 @@ class IPAddress: public Printable {
         bool operator!=(const IPAddress& addr) const {
             return !ip_addr_cmp(&_ip, &addr._ip);
         }
-        bool operator==(uint32_t addr) const {
+        constexpr bool operator==(uint32_t addr) const {
             return isV4() && v4() == addr;
         }
-        bool operator==(unsigned long addr) const {
+        constexpr bool operator==(unsigned long addr) const {
             return isV4() && v4() == (uint32_t)addr;
         }
-        bool operator!=(uint32_t addr) const {
+        constexpr bool operator!=(uint32_t addr) const {
             return !(isV4() && v4() == addr);
         }
-        bool operator!=(unsigned long addr) const {
+        constexpr bool operator!=(unsigned long addr) const {
             return isV4() && v4() != (uint32_t)addr;
         }
         bool operator==(const uint8_t* addr) const;
 
-        int operator>>(int n) const {
+        constexpr int operator>>(int n) const {
             return isV4()? v4() >> n: 0;
         }
 
         // Overloaded index operator to allow getting and setting individual octets of the address
-        uint8_t operator[](int index) const {
+        constexpr uint8_t operator[](int index) const {
             if (!isV4()) {
                 return 0;
             }
@@ -166,7 +185,7 @@ class IPAddress: public Printable {
         operator const ip_addr_t*() const { return &_ip; }
         operator       ip_addr_t*()       { return &_ip; }
 
-        bool isV4() const { return IP_IS_V4_VAL(_ip); }
+        constexpr bool isV4() const { return IP_IS_V4_VAL(_ip); }
         void setV4() { IP_SET_TYPE_VAL(_ip, IPADDR_TYPE_V4); }
 
         bool isLocal () const { return ip_addr_islinklocal(&_ip); }
@@ -194,7 +213,7 @@ class IPAddress: public Printable {
         // required otherwise
         operator const ip4_addr_t*() const { return isV4()? ip_2_ip4(&_ip): nullptr; }
 
-        bool isV6() const { return IP_IS_V6_VAL(_ip); }
+        constexpr bool isV6() const { return IP_IS_V6_VAL(_ip); }
         void setV6() { IP_SET_TYPE_VAL(_ip, IPADDR_TYPE_V6); }
 
     protected:
@@ -206,7 +225,7 @@ class IPAddress: public Printable {
 
         uint16_t* raw6() { return nullptr; }
         const uint16_t* raw6() const { return nullptr; }
-        bool isV6() const { return false; }
+        constexpr bool isV6() const { return false; }
         void setV6() { }
 
 #endif
@@ -0,0 +1,145 @@
+/*
+    InternedString.cpp - string interning pool, see InternedString.h
+
+    Copyright (c) 2026 esp8266/Arduino community.  All rights reserved.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "InternedString.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+
+// Open-addressing table, power-of-two sized, grown at ~70% load.  Entries
+// may point to RAM (interned copies) or flash (interned PROGMEM literals),
+// so all content access goes through pgm_read_byte, which handles both.
+struct Entry
+{
+    const char* s;
+    uint32_t hash;
+};
+
+Entry* s_table = nullptr;
+size_t s_capacity = 0;
+size_t s_count = 0;
+
+uint32_t fnv1a(const char* s)
+{
+    uint32_t h = 2166136261u;
+    for (;;)
+    {
+        uint8_t c = pgm_read_byte(s++);
+        if (!c)
+            return h;
+        h = (h ^ c) * 16777619u;
+    }
+}
+
+bool contentEqual(const char* a, const char* b)
+{
+    for (;; a++, b++)
+    {
+        uint8_t ca = pgm_read_byte(a);
+        if (ca != pgm_read_byte(b))
+            return false;
+        if (!ca)
+            return true;
+    }
+}
+
+bool grow()
+{
+    size_t capacity = s_capacity ? s_capacity * 2 : 32;
+    Entry* table = (Entry*)calloc(capacity, sizeof(Entry));
+    if (!table)
+        return false;
+    for (size_t i = 0; i < s_capacity; i++)
+    {
+        if (!s_table[i].s)
+            continue;
+        size_t j = s_table[i].hash & (capacity - 1);
+        while (table[j].s)
+            j = (j + 1) & (capacity - 1);
+        table[j] = s_table[i];
+    }
+    free(s_table);
+    s_table = table;
+    s_capacity = capacity;
+    return true;
+}
+
+// Returns the pooled pointer for 's', inserting it first if new.  'copy'
+// selects a RAM copy (plain strings) over keeping the pointer (PROGMEM).
+// On allocation failure the input pointer is returned uninterned.
+const char* intern(const char* s, bool copy)
+{
+    if (!s)
+        return nullptr;
+
+    if ((s_count + 1) * 10 >= s_capacity * 7 && !grow())
+        return s;
+
+    uint32_t h = fnv1a(s);
+    size_t i = h & (s_capacity - 1);
+    while (s_table[i].s)
+    {
+        if (s_table[i].hash == h && contentEqual(s_table[i].s, s))
+            return s_table[i].s;
+        i = (i + 1) & (s_capacity - 1);
+    }
+
+    const char* stored = s;
+    if (copy)
+    {
+        size_t n = strlen_P(s);
+        char* d = (char*)malloc(n + 1);
+        if (!d)
+            return s;
+        memcpy_P(d, s, n + 1);
+        stored = d;
+    }
+    s_table[i].s = stored;
+    s_table[i].hash = h;
+    ++s_count;
+    return stored;
+}
+
+} // namespace
+
+InternedString InternedString::get(const char* s)
+{
+    return InternedString(intern(s, true));
+}
+
+InternedString InternedString::get(const __FlashStringHelper* s)
+{
+    return InternedString(intern(reinterpret_cast<const char*>(s), false));
+}
+
+bool InternedString::equals(const char* s) const
+{
+    if (!s)
+        return !_s;
+    return contentEqual(c_str(), s);
+}
+
+size_t InternedString::count()
+{
+    return s_count;
+}
@@ -0,0 +1,107 @@
+/*
+    InternedString.h - string interning pool for repeated keys and topics
+
+    Copyright (c) 2026 esp8266/Arduino community.  All rights reserved.
+
+    Firmware that shuffles the same few dozen topic/key strings between
+    subsystems tends to hold each of them several times over as independent
+    String copies.  InternedString::get() deduplicates by content: the first
+    request stores one canonical copy, every later request for the same text
+    returns a handle to it.  Handles are immutable, pointer-sized, compare
+    in O(1) and convert implicitly to const char*, so they drop into String
+    construction, concatenation and printf-style calls unchanged - the
+    saving is that only the pool ever owns the characters.
+
+    Strings interned from flash (get(F("..."))) are not copied to RAM at
+    all: the handle keeps the PROGMEM pointer.  On the ESP8266 byte reads
+    from it go through the non32-bit access handler, which is slow - fine
+    for topics used in I/O, wrong for tight parsing loops.
+
+    Interning is permanent: entries are never released, so only intern a
+    bounded vocabulary, not data-driven input.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <WString.h>
+#include <pgmspace.h>
+
+class InternedString
+{
+public:
+    InternedString() :
+        _s(nullptr)
+    {
+    }
+
+    // Intern by content, copying the text into the pool on first sight.
+    // Under OOM the handle falls back to the caller's own pointer (still
+    // printable, but no longer shared or O(1)-comparable).
+    static InternedString get(const char* s);
+
+    static InternedString get(const String& s)
+    {
+        return get(s.c_str());
+    }
+
+    // Intern a flash string: deduplicated against all entries by content,
+    // stored as the PROGMEM pointer itself (no RAM copy).
+    static InternedString get(const __FlashStringHelper* s);
+
+    const char* c_str() const
+    {
+        return _s ? _s : emptyString.c_str();
+    }
+
+    operator const char*() const
+    {
+        return c_str();
+    }
+
+    explicit operator bool() const
+    {
+        return _s != nullptr;
+    }
+
+    // Content equality in O(1): two interned handles share their storage.
+    bool operator==(const InternedString& other) const
+    {
+        return _s == other._s;
+    }
+
+    bool operator!=(const InternedString& other) const
+    {
+        return _s != other._s;
+    }
+
+    // Content comparison against a plain string (O(length)).
+    bool equals(const char* s) const;
+
+    // Number of distinct strings held by the pool.
+    static size_t count();
+
+private:
+    explicit InternedString(const char* s) :
+        _s(s)
+    {
+    }
+
+    const char* _s;
+};
+
+#endif // INTERNED_STRING_H
@@ -0,0 +1,328 @@
+/*
+ JsonWriter.cpp - forward-only streaming JSON emitter over any Print
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "JsonWriter.h"
+
+#include <math.h>
+#include <pgmspace.h>
+
+// comma bookkeeping shared by values and sub-containers: inside an object a
+// value may only follow name(), inside an array (or at top level) a comma is
+// emitted between siblings
+bool JsonWriter::valueSlot()
+{
+    if (!_ok)
+    {
+        return false;
+    }
+    if (_afterName)
+    {
+        _afterName = false;
+        return true;
+    }
+    const uint32_t bit = (uint32_t)1 << _depth;
+    if (_depth && (_isObject & (bit >> 1)))
+    {
+        // bare value inside an object: name() was forgotten
+        _ok = false;
+        return false;
+    }
+    if (_depth && (_hasItems & (bit >> 1)))
+    {
+        _out.write(',');
+    }
+    if (_depth)
+    {
+        _hasItems |= bit >> 1;
+    }
+    return true;
+}
+
+JsonWriter& JsonWriter::beginObject()
+{
+    if (valueSlot())
+    {
+        if (_depth >= 32)
+        {
+            _ok = false;
+            return *this;
+        }
+        _out.write('{');
+        _isObject |= (uint32_t)1 << _depth;
+        _hasItems &= ~((uint32_t)1 << _depth);
+        ++_depth;
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    if (valueSlot())
+    {
+        if (_depth >= 32)
+        {
+            _ok = false;
+            return *this;
+        }
+        _out.write('[');
+        _isObject &= ~((uint32_t)1 << _depth);
+        _hasItems &= ~((uint32_t)1 << _depth);
+        ++_depth;
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    if (!_ok || !_depth || _afterName || !(_isObject & ((uint32_t)1 << (_depth - 1))))
+    {
+        _ok = false;
+        return *this;
+    }
+    --_depth;
+    _out.write('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    if (!_ok || !_depth || (_isObject & ((uint32_t)1 << (_depth - 1))))
+    {
+        _ok = false;
+        return *this;
+    }
+    --_depth;
+    _out.write(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::close()
+{
+    while (_ok && _depth)
+    {
+        if (_isObject & ((uint32_t)1 << (_depth - 1)))
+        {
+            endObject();
+        }
+        else
+        {
+            endArray();
+        }
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::name(const char* key)
+{
+    if (!_ok || _afterName || !_depth || !(_isObject & ((uint32_t)1 << (_depth - 1))))
+    {
+        _ok = false;
+        return *this;
+    }
+    if (_hasItems & ((uint32_t)1 << (_depth - 1)))
+    {
+        _out.write(',');
+    }
+    _hasItems |= (uint32_t)1 << (_depth - 1);
+    _out.write('"');
+    writeEscaped(key);
+    _out.write('"');
+    _out.write(':');
+    _afterName = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::name(const __FlashStringHelper* key)
+{
+    if (!_ok || _afterName || !_depth || !(_isObject & ((uint32_t)1 << (_depth - 1))))
+    {
+        _ok = false;
+        return *this;
+    }
+    if (_hasItems & ((uint32_t)1 << (_depth - 1)))
+    {
+        _out.write(',');
+    }
+    _hasItems |= (uint32_t)1 << (_depth - 1);
+    _out.write('"');
+    writeEscaped(key);
+    _out.write('"');
+    _out.write(':');
+    _afterName = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* s)
+{
+    if (valueSlot())
+    {
+        if (!s)
+        {
+            _out.print(F("null"));
+            return *this;
+        }
+        _out.write('"');
+        writeEscaped(s);
+        _out.write('"');
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const __FlashStringHelper* s)
+{
+    if (valueSlot())
+    {
+        if (!s)
+        {
+            _out.print(F("null"));
+            return *this;
+        }
+        _out.write('"');
+        writeEscaped(s);
+        _out.write('"');
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool b)
+{
+    if (valueSlot())
+    {
+        _out.print(b ? F("true") : F("false"));
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(long v)
+{
+    if (valueSlot())
+    {
+        _out.print(v);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(unsigned long v)
+{
+    if (valueSlot())
+    {
+        _out.print(v);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(long long v)
+{
+    if (valueSlot())
+    {
+        _out.print(v);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(unsigned long long v)
+{
+    if (valueSlot())
+    {
+        _out.print(v);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double v)
+{
+    if (valueSlot())
+    {
+        if (isnan(v) || isinf(v))
+        {
+            _out.print(F("null"));
+        }
+        else
+        {
+            _out.print(v, _decimalPlaces);
+        }
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::nullValue()
+{
+    if (valueSlot())
+    {
+        _out.print(F("null"));
+    }
+    return *this;
+}
+
+void JsonWriter::escapeChar(char c)
+{
+    switch (c)
+    {
+    case '"':
+        _out.print(F("\\\""));
+        break;
+    case '\\':
+        _out.print(F("\\\\"));
+        break;
+    case '\b':
+        _out.print(F("\\b"));
+        break;
+    case '\f':
+        _out.print(F("\\f"));
+        break;
+    case '\n':
+        _out.print(F("\\n"));
+        break;
+    case '\r':
+        _out.print(F("\\r"));
+        break;
+    case '\t':
+        _out.print(F("\\t"));
+        break;
+    default:
+        if ((unsigned char)c < 0x20)
+        {
+            _out.printf_P(PSTR("\\u%04x"), c);
+        }
+        else
+        {
+            _out.write(c);
+        }
+        break;
+    }
+}
+
+void JsonWriter::writeEscaped(const char* s)
+{
+    for (; *s; ++s)
+    {
+        escapeChar(*s);
+    }
+}
+
+void JsonWriter::writeEscaped(const __FlashStringHelper* s)
+{
+    PGM_P p = reinterpret_cast<PGM_P>(s);
+    for (char c; (c = pgm_read_byte(p)); ++p)
+    {
+        escapeChar(c);
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ JsonWriter.h - forward-only streaming JSON emitter over any Print
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Print.h>
+#include <WString.h>
+
+// Emits JSON directly into any Print - Serial, a WiFiClient, a File, or the
+// WebServer's chunked writer - in document order, so an arbitrarily large
+// response needs only this object's few dozen bytes of state instead of an
+// in-RAM document tree.  Commas, quoting and escaping are handled here;
+// numbers go through Print's own formatting, no String temporaries.
+//
+//      auto out = server.beginChunked(200, "application/json");
+//      JsonWriter json(out);
+//      json.beginObject()
+//          .property(F("uptime"), millis() / 1000)
+//          .property(F("heap"), ESP.getFreeHeap())
+//          .name(F("clients")).beginArray();
+//      for (auto& c : clients)
+//          json.value(c.name);
+//      json.endArray().endObject();
+//
+// Nesting is tracked to 32 levels; exceeding that, or mismatched
+// begin/end calls, clears ok() and ignores the offending call, so the
+// output stays well-formed up to the mistake.
+
+class JsonWriter
+{
+public:
+    // decimalPlaces applies to value(double), Print::print() style
+    explicit JsonWriter(Print& out, uint8_t decimalPlaces = 2) :
+        _out(out), _decimalPlaces(decimalPlaces)
+    {
+    }
+
+    JsonWriter& beginObject();
+    JsonWriter& beginArray();
+    JsonWriter& endObject();
+    JsonWriter& endArray();
+
+    // member key inside an object; follow with value()/begin*()
+    JsonWriter& name(const char* key);
+    JsonWriter& name(const String& key) { return name(key.c_str()); }
+    JsonWriter& name(const __FlashStringHelper* key);
+
+    JsonWriter& value(const char* s);  // nullptr emits null
+    JsonWriter& value(const String& s) { return value(s.c_str()); }
+    JsonWriter& value(const __FlashStringHelper* s);
+    JsonWriter& value(bool b);
+    JsonWriter& value(int v) { return value((long)v); }
+    JsonWriter& value(unsigned int v) { return value((unsigned long)v); }
+    JsonWriter& value(long v);
+    JsonWriter& value(unsigned long v);
+    JsonWriter& value(long long v);
+    JsonWriter& value(unsigned long long v);
+    JsonWriter& value(double v);  // NaN/Inf emit null (not valid JSON numbers)
+    JsonWriter& nullValue();
+
+    // name() + value() in one call
+    template<typename K, typename V>
+    JsonWriter& property(const K& key, const V& v)
+    {
+        name(key);
+        return value(v);
+    }
+
+    // close every container still open (handy before ChunkedWriter::end())
+    JsonWriter& close();
+
+    // open containers at this point
+    uint8_t depth() const { return _depth; }
+
+    // false after nesting overflow or mismatched begin/end
+    bool ok() const { return _ok; }
+
+private:
+    bool valueSlot();  // comma bookkeeping; false when a key is required
+    void writeEscaped(const char* s);
+    void writeEscaped(const __FlashStringHelper* s);
+    void escapeChar(char c);
+
+    Print& _out;
+    uint32_t _isObject = 0;  // container kind per depth (bit set: object)
+    uint32_t _hasItems = 0;  // a comma is due at this depth
+    uint8_t _depth = 0;
+    uint8_t _decimalPlaces;
+    bool _afterName = false;
+    bool _ok = true;
+};
+
+#endif  // JSON_WRITER_H
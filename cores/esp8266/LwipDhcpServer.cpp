@@ -198,6 +198,70 @@ DhcpServer::DhcpServer(netif* netif) : _netif(netif) { }
 // wifi_softap_set_station_info is missing in user_interface.h:
 extern "C" void wifi_softap_set_station_info(uint8_t* mac, struct ipv4_addr*);
 
+/******************************************************************************
+    FunctionName : mac_hash
+    Description  : FNV-1a hash of a MAC address, folded to an index bucket
+    Parameters   : mac -- the client hardware address
+    Returns      : bucket number
+*******************************************************************************/
+uint8_t DhcpServer::mac_hash(const uint8* mac)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < 6; i++)
+    {
+        hash ^= mac[i];
+        hash *= 16777619u;
+    }
+    return hash & (MacIndexBuckets - 1);
+}
+
+/******************************************************************************
+    FunctionName : mac_index_find
+    Description  : O(1) lookup of a lease by client MAC
+    Parameters   : mac -- the client hardware address
+    Returns      : the lease list node, or nullptr
+*******************************************************************************/
+DhcpServer::list_node* DhcpServer::mac_index_find(const uint8* mac)
+{
+    for (list_node* pnode = mac_index[mac_hash(mac)]; pnode != nullptr;
+         pnode            = pnode->pnext_hash)
+    {
+        if (memcmp(((struct dhcps_pool*)pnode->pnode)->mac, mac, 6) == 0)
+        {
+            return pnode;
+        }
+    }
+    return nullptr;
+}
+
+void DhcpServer::mac_index_insert(list_node* pinsert)
+{
+    uint8_t bucket      = mac_hash(((struct dhcps_pool*)pinsert->pnode)->mac);
+    pinsert->pnext_hash = mac_index[bucket];
+    mac_index[bucket]   = pinsert;
+}
+
+void DhcpServer::mac_index_remove(list_node* pdelete)
+{
+    uint8_t bucket = mac_hash(((struct dhcps_pool*)pdelete->pnode)->mac);
+    if (mac_index[bucket] == pdelete)
+    {
+        mac_index[bucket] = pdelete->pnext_hash;
+    }
+    else
+    {
+        for (list_node* pnode = mac_index[bucket]; pnode != nullptr; pnode = pnode->pnext_hash)
+        {
+            if (pnode->pnext_hash == pdelete)
+            {
+                pnode->pnext_hash = pdelete->pnext_hash;
+                break;
+            }
+        }
+    }
+    pdelete->pnext_hash = nullptr;
+}
+
 /******************************************************************************
     FunctionName : node_insert_to_list
     Description  : insert the node to the list
@@ -245,6 +309,9 @@ void DhcpServer::node_insert_to_list(list_node** phead, list_node* pinsert)
         }
     }
     //  pinsert->pnext = nullptr;
+
+    mac_index_insert(pinsert);
+    pool_count++;
 }
 
 /******************************************************************************
@@ -268,6 +335,8 @@ void DhcpServer::node_remove_from_list(list_node** phead, list_node* pdelete)
         {
             *phead         = plist->pnext;
             pdelete->pnext = nullptr;
+            mac_index_remove(pdelete);
+            pool_count--;
         }
         else
         {
@@ -277,6 +346,8 @@ void DhcpServer::node_remove_from_list(list_node** phead, list_node* pdelete)
                 {
                     plist->pnext   = pdelete->pnext;
                     pdelete->pnext = nullptr;
+                    mac_index_remove(pdelete);
+                    pool_count--;
                 }
                 plist = plist->pnext;
             }
@@ -298,22 +369,17 @@ bool DhcpServer::add_dhcps_lease(uint8* macaddr)
     uint32 start_ip = lease.start_ip.addr;
     uint32 end_ip   = lease.end_ip.addr;
 
-    for (pback_node = plist; pback_node != nullptr; pback_node = pback_node->pnext)
+    if (mac_index_find(macaddr) != nullptr)
     {
-        pdhcps_pool = (dhcps_pool*)pback_node->pnode;
-        if (memcmp(pdhcps_pool->mac, macaddr, sizeof(pdhcps_pool->mac)) == 0)
-        {
 #if DHCPS_DEBUG
-            os_printf("this mac already exist");
+        os_printf("this mac already exist");
 #endif
-            return false;
-        }
-        else
-        {
-            start_ip = htonl((ntohl(start_ip) + 1));
-        }
+        return false;
     }
 
+    // next available address, one per existing lease
+    start_ip = htonl((ntohl(start_ip) + pool_count));
+
     if (start_ip > end_ip)
     {
 #if DHCPS_DEBUG
@@ -777,6 +843,8 @@ void DhcpServer::handle_dhcp(struct udp_pcb* pcb, struct pbuf* p, const ip_addr_
     os_printf("dhcps: handle_dhcp-> parse_msg(p)\n");
 #endif
 
+    const uint32 op_start = system_get_time();
+
     switch (parse_msg(pmsg_dhcps, tlen - 240))
     {
     case DHCPS_STATE_OFFER:  // 1
@@ -784,6 +852,7 @@ void DhcpServer::handle_dhcp(struct udp_pcb* pcb, struct pbuf* p, const ip_addr_
         os_printf("dhcps: handle_dhcp-> DHCPD_STATE_OFFER\n");
 #endif
         send_offer(pmsg_dhcps);
+        _stats.discover++;
         break;
     case DHCPS_STATE_ACK:  // 3
 #if DHCPS_DEBUG
@@ -794,16 +863,25 @@ void DhcpServer::handle_dhcp(struct udp_pcb* pcb, struct pbuf* p, const ip_addr_
         {
             wifi_softap_set_station_info(pmsg_dhcps->chaddr, &client_address);
         }
+        _stats.ack++;
         break;
     case DHCPS_STATE_NAK:  // 4
 #if DHCPS_DEBUG
         os_printf("dhcps: handle_dhcp-> DHCPD_STATE_NAK\n");
 #endif
         send_nak(pmsg_dhcps);
+        _stats.nak++;
         break;
     default:
         break;
     }
+
+    _stats.last_op_us = system_get_time() - op_start;
+    if (_stats.last_op_us > _stats.max_op_us)
+    {
+        _stats.max_op_us = _stats.last_op_us;
+    }
+
 #if DHCPS_DEBUG
     os_printf("dhcps: handle_dhcp-> pbuf_free(p)\n");
 #endif
@@ -1065,46 +1143,62 @@ bool DhcpServer::get_dhcps_lease(struct dhcps_lease* please)
 
 void DhcpServer::kill_oldest_dhcps_pool(void)
 {
-    list_node *        pre = nullptr, *p = nullptr;
-    list_node *        minpre = nullptr, *minp = nullptr;
-    struct dhcps_pool *pdhcps_pool = nullptr, *pmin_pool = nullptr;
-    pre    = plist;
-    p      = pre->pnext;
-    minpre = pre;
-    minp   = p;
-    while (p != nullptr)
-    {
-        pdhcps_pool = (struct dhcps_pool*)p->pnode;
-        pmin_pool   = (struct dhcps_pool*)minp->pnode;
-        if (pdhcps_pool->lease_timer < pmin_pool->lease_timer)
+    // find the lease closest to expiry and drop it; the original version
+    // started the scan at the second node (the head could never be chosen),
+    // marked the last visited node instead of the minimum and spliced the
+    // list by hand - remove through node_remove_from_list() instead, which
+    // also keeps the MAC index consistent
+    list_node* minp = plist;
+    if (minp == nullptr)
+    {
+        return;
+    }
+    for (list_node* p = plist->pnext; p != nullptr; p = p->pnext)
+    {
+        if (((struct dhcps_pool*)p->pnode)->lease_timer
+            < ((struct dhcps_pool*)minp->pnode)->lease_timer)
         {
-            minp   = p;
-            minpre = pre;
+            minp = p;
         }
-        pre = p;
-        p   = p->pnext;
     }
-    minpre->pnext      = minp->pnext;
-    pdhcps_pool->state = DHCPS_STATE_OFFLINE;
+    node_remove_from_list(&plist, minp);
     free(minp->pnode);
     minp->pnode = nullptr;
     free(minp);
-    minp = nullptr;
+    _stats.evicted++;
 }
 
 void DhcpServer::dhcps_coarse_tmr(void)
 {
-    uint8              num_dhcps_pool = 0;
-    list_node*         pback_node     = nullptr;
-    list_node*         pnode          = nullptr;
-    struct dhcps_pool* pdhcps_pool    = nullptr;
-    pnode                             = plist;
+    list_node*         pback_node  = nullptr;
+    list_node*         pnode       = nullptr;
+    struct dhcps_pool* pdhcps_pool = nullptr;
+
+    // lazy expiry: instead of decrementing every lease each tick, remember
+    // how many ticks until the closest lease can expire and only sweep then
+    tmr_pending++;
+    if (pool_count == 0)
+    {
+        tmr_pending = 0;
+        return;
+    }
+    if (expiry_countdown > tmr_pending && pool_count < MAX_STATION_NUM)
+    {
+        return;
+    }
+
+    const uint32 elapsed = tmr_pending;
+    uint32       min_left = 0xffffffff;
+    tmr_pending           = 0;
+
+    pnode = plist;
     while (pnode != nullptr)
     {
         pdhcps_pool = (struct dhcps_pool*)pnode->pnode;
         if (pdhcps_pool->type == DHCPS_TYPE_DYNAMIC)
         {
-            pdhcps_pool->lease_timer--;
+            pdhcps_pool->lease_timer
+                = (pdhcps_pool->lease_timer > elapsed) ? pdhcps_pool->lease_timer - elapsed : 0;
         }
         if (pdhcps_pool->lease_timer == 0)
         {
@@ -1115,15 +1209,20 @@ void DhcpServer::dhcps_coarse_tmr(void)
             pback_node->pnode = nullptr;
             free(pback_node);
             pback_node = nullptr;
+            _stats.expired++;
         }
         else
         {
+            if (pdhcps_pool->type == DHCPS_TYPE_DYNAMIC && pdhcps_pool->lease_timer < min_left)
+            {
+                min_left = pdhcps_pool->lease_timer;
+            }
             pnode = pnode->pnext;
-            num_dhcps_pool++;
         }
     }
+    expiry_countdown = min_left;
 
-    if (num_dhcps_pool >= MAX_STATION_NUM)
+    if (pool_count >= MAX_STATION_NUM)
     {
         kill_oldest_dhcps_pool();
     }
@@ -1139,40 +1238,31 @@ void DhcpServer::dhcps_client_leave(u8* bssid, struct ipv4_addr* ip, bool force)
         return;
     }
 
-    for (pback_node = plist; pback_node != nullptr; pback_node = pback_node->pnext)
+    pback_node = mac_index_find(bssid);
+    if (pback_node != nullptr)
     {
         pdhcps_pool = (struct dhcps_pool*)pback_node->pnode;
-        if (memcmp(pdhcps_pool->mac, bssid, sizeof(pdhcps_pool->mac)) == 0)
+        if (memcmp(&pdhcps_pool->ip.addr, &ip->addr, sizeof(pdhcps_pool->ip.addr)) == 0)
         {
-            if (memcmp(&pdhcps_pool->ip.addr, &ip->addr, sizeof(pdhcps_pool->ip.addr)) == 0)
+            if ((pdhcps_pool->type == DHCPS_TYPE_STATIC) || (force))
             {
-                if ((pdhcps_pool->type == DHCPS_TYPE_STATIC) || (force))
-                {
-                    if (pback_node != nullptr)
-                    {
-                        node_remove_from_list(&plist, pback_node);
-                        free(pback_node);
-                        pback_node = nullptr;
-                    }
-
-                    if (pdhcps_pool != nullptr)
-                    {
-                        free(pdhcps_pool);
-                        pdhcps_pool = nullptr;
-                    }
-                }
-                else
-                {
-                    pdhcps_pool->state = DHCPS_STATE_OFFLINE;
-                }
+                node_remove_from_list(&plist, pback_node);
+                free(pback_node);
+                pback_node = nullptr;
 
-                struct ipv4_addr ip_zero;
-                memset(&ip_zero, 0x0, sizeof(ip_zero));
-                if (_netif->num == SOFTAP_IF)
-                {
-                    wifi_softap_set_station_info(bssid, &ip_zero);
-                }
-                break;
+                free(pdhcps_pool);
+                pdhcps_pool = nullptr;
+            }
+            else
+            {
+                pdhcps_pool->state = DHCPS_STATE_OFFLINE;
+            }
+
+            struct ipv4_addr ip_zero;
+            memset(&ip_zero, 0x0, sizeof(ip_zero));
+            if (_netif->num == SOFTAP_IF)
+            {
+                wifi_softap_set_station_info(bssid, &ip_zero);
             }
         }
     }
@@ -1210,6 +1300,31 @@ uint32 DhcpServer::dhcps_client_update(u8* bssid, struct ipv4_addr* ip)
     }
 
     renew = false;
+
+    // fast path: a known client asking for the address it already holds (the
+    // common RENEW/rebind REQUEST) resolves through the MAC index without
+    // walking the list; behaves exactly like the pip_node == pmac_node case
+    // of the full scan below
+    if (ip != nullptr)
+    {
+        pmac_node = mac_index_find(bssid);
+        if (pmac_node != nullptr)
+        {
+            pdhcps_pool = (struct dhcps_pool*)pmac_node->pnode;
+            if (memcmp(&pdhcps_pool->ip.addr, &ip->addr, sizeof(pdhcps_pool->ip.addr)) == 0)
+            {
+                renew                    = true;
+                pdhcps_pool->lease_timer = this->lease_time;
+                pdhcps_pool->type        = DHCPS_TYPE_DYNAMIC;
+                pdhcps_pool->state       = DHCPS_STATE_ONLINE;
+                _stats.renewed++;
+                return pdhcps_pool->ip.addr;
+            }
+        }
+        pmac_node   = nullptr;
+        pdhcps_pool = nullptr;
+    }
+
     for (pback_node = plist; pback_node != nullptr; pback_node = pback_node->pnext)
     {
         pdhcps_pool = (struct dhcps_pool*)pback_node->pnode;
@@ -1286,7 +1401,9 @@ uint32 DhcpServer::dhcps_client_update(u8* bssid, struct ipv4_addr* ip)
                 pmac_node->pnode = nullptr;
                 free(pmac_node);
                 pmac_node = pip_node;
+                mac_index_remove(pip_node);
                 memcpy(pdhcps_pool->mac, bssid, sizeof(pdhcps_pool->mac));
+                mac_index_insert(pip_node);
             }
             else
             {
@@ -1330,7 +1447,9 @@ uint32 DhcpServer::dhcps_client_update(u8* bssid, struct ipv4_addr* ip)
             {
                 return IPADDR_ANY;
             }
+            mac_index_remove(pip_node);
             memcpy(pdhcps_pool->mac, bssid, sizeof(pdhcps_pool->mac));
+            mac_index_insert(pip_node);
             pdhcps_pool->lease_timer = this->lease_time;
             pdhcps_pool->type        = type;
             pdhcps_pool->state       = DHCPS_STATE_ONLINE;
@@ -115,6 +115,19 @@ public:
 
     using OptionsBufferHandler = void (*)(const DhcpServer&, OptionsBuffer&);
 
+    // per-operation counters of the lease table, see getStats()
+    struct Stats
+    {
+        uint32_t discover   = 0;  // DHCPDISCOVER handled (offer sent)
+        uint32_t ack        = 0;  // DHCPACK sent
+        uint32_t nak        = 0;  // DHCPNAK sent
+        uint32_t renewed    = 0;  // renewals served from the MAC index fast path
+        uint32_t expired    = 0;  // leases dropped by the expiry sweep
+        uint32_t evicted    = 0;  // oldest lease dropped on a full table
+        uint32_t last_op_us = 0;  // duration of the last handled message
+        uint32_t max_op_us  = 0;  // worst-case message handling duration
+    };
+
     DhcpServer(netif* netif);
     ~DhcpServer();
 
@@ -170,6 +183,16 @@ public:
     void end();
     bool isRunning() const;
 
+    const Stats& getStats() const
+    {
+        return _stats;
+    }
+
+    void clearStats()
+    {
+        _stats = Stats {};
+    }
+
     // this is the C interface encapsulated in a class
     // (originally dhcpserver.c in lwIP-v1.4 in NonOS-SDK)
     // (not changing everything at once)
@@ -193,11 +216,22 @@ protected:
     {
         void*              pnode;
         struct _list_node* pnext;
+        struct _list_node* pnext_hash;  // chain of the MAC index bucket
     } list_node;
 
     void node_insert_to_list(list_node** phead, list_node* pinsert);
     void node_remove_from_list(list_node** phead, list_node* pdelete);
 
+    // MAC-hashed index over the lease list, for O(1) client lookup
+    // (the list itself stays ordered by IP for address allocation);
+    // maintained by node_insert_to_list()/node_remove_from_list()
+    static constexpr size_t MacIndexBuckets = 16;
+
+    static uint8_t mac_hash(const uint8* mac);
+    list_node*     mac_index_find(const uint8* mac);
+    void           mac_index_insert(list_node* pinsert);
+    void           mac_index_remove(list_node* pdelete);
+
     OptionsBuffer create_msg(struct dhcps_msg* m);
 
     void        send_offer(struct dhcps_msg* m);
@@ -230,6 +264,13 @@ protected:
     list_node* plist = nullptr;
     bool       renew = false;
 
+    list_node* mac_index[MacIndexBuckets] = {};
+    size_t     pool_count       = 0;
+    uint32     tmr_pending      = 0;  // coarse ticks since the last expiry sweep
+    uint32     expiry_countdown = 0;  // ticks until the next lease can expire
+
+    Stats _stats {};
+
     OptionsBufferHandler custom_offer_options = nullptr;
 
     static const uint32 magic_cookie;
@@ -22,8 +22,10 @@
 */
 
 #include <LwipIntf.h>
+#include <AddrList.h>
 #include <Schedule.h>
 #include <debug.h>
+#include <core_esp8266_profile.h>
 
 static constexpr size_t LwipIntfCallbacks = 3;
 
@@ -33,6 +35,10 @@ static size_t           size = 0;
 // override empty weak function from glue-lwip
 extern "C" void netif_status_changed(struct netif* netif)
 {
+    PROFILE_SCOPE("netif_status_changed");
+    // keep the address snapshot current (see AddrList.h) before user
+    // callbacks so they observe the new state
+    addrList.refresh();
     for (size_t index = 0; index < size; ++index)
     {
         callbacks[index](netif);
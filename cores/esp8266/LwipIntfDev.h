@@ -39,6 +39,7 @@
 
 #include "SPI.h"
 #include "Schedule.h"
+#include "FunctionalInterrupt.h"
 #include "LwipIntf.h"
 #include "wl_definitions.h"
 
@@ -58,7 +59,8 @@ class LwipIntfDev: public LwipIntf, public RawDev
 {
 public:
     LwipIntfDev(int8_t cs = SS, SPIClass& spi = SPI, int8_t intr = -1) :
-        RawDev(cs, spi, intr), _mtu(DEFAULT_MTU), _intrPin(intr), _started(false), _default(false)
+        RawDev(cs, spi, intr), _mtu(DEFAULT_MTU), _intrPin(intr), _started(false), _default(false),
+        _rxScheduled(false)
     {
         memset(&_netif, 0, sizeof(_netif));
     }
@@ -139,6 +141,10 @@ protected:
     uint8_t  _macAddress[6];
     bool     _started;
     bool     _default;
+
+    // set from ISR when a receive run is already scheduled,
+    // prevents flooding the scheduled-function queue
+    volatile bool _rxScheduled;
 };
 
 template<class RawDev>
@@ -260,9 +266,32 @@ boolean LwipIntfDev<RawDev>::begin(const uint8_t* macAddress, const uint16_t mtu
 
     if (_intrPin >= 0)
     {
-        if (RawDev::interruptIsPossible())
+        if constexpr (RawDev::interruptIsPossible())
         {
-            // attachInterrupt(_intrPin, [&]() { this->handlePackets(); }, FALLING);
+            // The ISR only schedules the drain: SPI transactions must not
+            // run in interrupt context, and handlePackets() needs a plain
+            // stack anyway (schedule_function is ISR-safe).
+            pinMode(_intrPin, INPUT_PULLUP);
+            attachInterrupt(
+                _intrPin,
+                [this]()
+                {
+                    if (!_rxScheduled)
+                    {
+                        _rxScheduled = true;
+                        schedule_function(
+                            [this]()
+                            {
+                                // ack first so frames landing while we drain
+                                // re-assert INTn and trigger another run
+                                _rxScheduled = false;
+                                RawDev::ackInterrupt();
+                                this->handlePackets();
+                            });
+                    }
+                },
+                FALLING);
+            RawDev::enableInterrupt();
         }
         else
         {
@@ -272,15 +301,23 @@ boolean LwipIntfDev<RawDev>::begin(const uint8_t* macAddress, const uint16_t mtu
         }
     }
 
-    if (_intrPin < 0
-        && !schedule_recurrent_function_us(
+    // Always keep a recurrent poll:
+    // - sole receive path when no interrupt pin is available,
+    // - slow safety net otherwise: INTn is level-triggered and an edge is
+    //   missed when frames are pending at attach time or left over by the
+    //   starvation guard in handlePackets().
+    if (!schedule_recurrent_function_us(
             [&]()
             {
                 this->handlePackets();
                 return true;
             },
-            100))
+            _intrPin >= 0 ? 10000 : 100))
     {
+        if (_intrPin >= 0)
+        {
+            detachInterrupt(_intrPin);
+        }
         netif_remove(&_netif);
         return false;
     }
@@ -0,0 +1,146 @@
+/*
+  LwipIntfFailover.cpp
+
+  Fast default-route failover between network interfaces
+
+  Original Copyright (c) 2020 esp8266 Arduino All rights reserved.
+  This file is part of the esp8266 Arduino core environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <LwipIntfFailover.h>
+#include <Schedule.h>
+#include <lwip/ip_addr.h>
+#include <debug.h>
+
+namespace
+{
+    struct Entry
+    {
+        netif*                     intf;
+        LwipIntfFailover::LinkProbe probe;
+        uint8_t                    priority;
+        bool                       up;
+    };
+
+    constexpr size_t maxEntries = 4;
+
+    Entry    entries[maxEntries];
+    size_t   entryCount = 0;
+    bool     running    = false;
+    uint32_t intervalUs = 50000;
+}
+
+bool LwipIntfFailover::add(const netif* intf, LinkProbe probe, uint8_t priority)
+{
+    if (!intf || !probe || entryCount >= maxEntries)
+    {
+        return false;
+    }
+    // lwIP route manipulation needs a mutable netif; registration from the
+    // const accessors (e.g. LwipIntfDev::getNetIf()) is fine
+    entries[entryCount].intf     = const_cast<netif*>(intf);
+    entries[entryCount].probe    = std::move(probe);
+    entries[entryCount].priority = priority;
+    entries[entryCount].up       = false;
+    entryCount++;
+
+    if (!running)
+    {
+        running = schedule_recurrent_function_us(_tick, intervalUs);
+    }
+    return running;
+}
+
+void LwipIntfFailover::remove(const netif* intf)
+{
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        if (entries[i].intf == intf)
+        {
+            for (size_t j = i + 1; j < entryCount; j++)
+            {
+                entries[j - 1] = entries[j];
+            }
+            entries[--entryCount].probe = nullptr;
+            return;
+        }
+    }
+}
+
+void LwipIntfFailover::setInterval(uint32_t us)
+{
+    intervalUs = us;
+}
+
+bool LwipIntfFailover::_tick()
+{
+    bool changed = false;
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        bool up = entries[i].probe();
+        if (up != entries[i].up)
+        {
+            entries[i].up = up;
+            changed       = true;
+        }
+    }
+    if (changed)
+    {
+        _elect();
+    }
+    return true;
+}
+
+void LwipIntfFailover::_elect()
+{
+    Entry* best = nullptr;
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        Entry& entry = entries[i];
+        if (!entry.up || !netif_is_up(entry.intf) || ip_addr_isany(&entry.intf->gw))
+        {
+            continue;
+        }
+        if (!best || entry.priority < best->priority)
+        {
+            best = &entry;
+        }
+    }
+
+    if (best)
+    {
+        if (netif_default != best->intf)
+        {
+            DEBUGV("LwipIntfFailover: default route -> %c%c%d\n", best->intf->name[0],
+                   best->intf->name[1], best->intf->num);
+            netif_set_default(best->intf);
+        }
+        return;
+    }
+
+    // no registered link is usable: drop the default route if it still
+    // points at one of ours, so lwIP stops queueing into a dead uplink
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        if (netif_default == entries[i].intf)
+        {
+            DEBUGV("LwipIntfFailover: default route cleared\n");
+            netif_set_default(nullptr);
+            return;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+  LwipIntfFailover.h
+
+  Fast default-route failover between network interfaces
+
+  Original Copyright (c) 2020 esp8266 Arduino All rights reserved.
+  This file is part of the esp8266 Arduino core environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _LWIPINTFFAILOVER_H
+#define _LWIPINTFFAILOVER_H
+
+#include <lwip/netif.h>
+
+#include <functional>
+
+/*
+  Keeps lwIP's default route on the best registered interface that is
+  actually usable.  Without this, a dead uplink is only noticed when its own
+  machinery gives up (DHCP lease loss, WiFi disconnect event, ...) which can
+  take many seconds; here the registered link probes are polled on a short
+  period and the default route migrates within one period of a link loss.
+
+  Per-destination routing beyond lwIP's built-in on-link netmask match is
+  not possible with the precompiled lwIP in this core (no routing hook was
+  compiled in): the policy expressed here is which interface owns the
+  default route, and with which priority.
+
+  Example, ethernet preferred over WiFi STA:
+
+      LwipIntfFailover::add(eth.getNetIf(), [&eth]() { return eth.connected(); }, 0);
+      LwipIntfFailover::add(WiFi.getNetIf(), []() { return WiFi.isConnected(); }, 1);
+*/
+class LwipIntfFailover
+{
+public:
+    // returns true while the interface's uplink is usable
+    using LinkProbe = std::function<bool()>;
+
+    // Register an interface with its link probe; the lowest priority among
+    // the probes reporting up owns the default route.  Starts the monitor
+    // on first use.  Returns false when the table is full.
+    static bool add(const netif* intf, LinkProbe probe, uint8_t priority = 0);
+    static void remove(const netif* intf);
+
+    // Monitor period in microseconds, default 50000 (migration takes at
+    // most two periods); only effective when called before the first add()
+    static void setInterval(uint32_t us);
+
+private:
+    static bool _tick();
+    static void _elect();
+};
+
+#endif  // _LWIPINTFFAILOVER_H
@@ -34,35 +34,64 @@ void MD5Builder::addHexString(const char * data){
 }
 
 bool MD5Builder::addStream(Stream &stream, const size_t maxLen) {
-    const int buf_size = 512;
-    int maxLengthLeft = maxLen;
-
-    auto buf = std::unique_ptr<uint8_t[]>{new(std::nothrow) uint8_t[buf_size]};
+    // Hash at most this much per MD5Update, so long memory or flash-mapped
+    // sources still yield regularly in between.
+    const size_t chunk_size = 4096;
+    size_t maxLengthLeft = maxLen;
+
+    if (stream.hasPeekBufferAPI()) {
+        // Zero-copy fast path: hash straight out of the stream's own buffer
+        // (e.g. StreamString or a flash-mapped StreamConstPtr region) instead
+        // of going byte-wise through readBytes with its timeout handling.
+        size_t peekAvailable = stream.peekAvailable();
+        while ((peekAvailable > 0) && (maxLengthLeft > 0)) {
+            const char* peek = stream.peekBuffer();
+            if (!peek) {
+                return false;
+            }
+
+            size_t chunk = peekAvailable;
+            if (chunk > maxLengthLeft) {
+                chunk = maxLengthLeft;
+            }
+            if (chunk > chunk_size) {
+                chunk = chunk_size;
+            }
+
+            MD5Update(&_ctx, (const uint8_t*)peek, chunk);
+            stream.peekConsume(chunk);
+
+            yield();      // time for network streams
+
+            maxLengthLeft -= chunk;
+            peekAvailable = stream.peekAvailable();
+        }
 
-    if (!buf) {
-        return false;
+        return true;
     }
 
-    int bytesAvailable = stream.available();
+    uint8_t buf[512];
+
+    size_t bytesAvailable = stream.available();
     while((bytesAvailable > 0) && (maxLengthLeft > 0)) {
 
         // determine number of bytes to read
-        int readBytes = bytesAvailable;
+        size_t readBytes = bytesAvailable;
         if (readBytes > maxLengthLeft){
             readBytes = maxLengthLeft;    // read only until max_len
         }
-        if (readBytes > buf_size){
-            readBytes = buf_size;    // not read more the buffer can handle
+        if (readBytes > sizeof(buf)){
+            readBytes = sizeof(buf);    // not read more the buffer can handle
         }
 
         // read data and check if we got something
-        int numBytesRead = stream.readBytes(buf.get(), readBytes);
+        size_t numBytesRead = stream.readBytes(buf, readBytes);
         if (numBytesRead < 1) {
             return false;
         }
 
         // Update MD5 with buffer payload
-        MD5Update(&_ctx, buf.get(), numBytesRead);
+        MD5Update(&_ctx, buf, numBytesRead);
 
         yield();      // time for network streams
 
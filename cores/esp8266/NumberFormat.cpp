@@ -0,0 +1,306 @@
+/*
+ NumberFormat.cpp - shared decimal integer formatting helpers
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "NumberFormat.h"
+
+const char numfmt_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+char* numfmt_utoa10(uint32_t value, char* end)
+{
+    while (value >= 100)
+    {
+        const uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--end = numfmt_digit_pairs[pair + 1];
+        *--end = numfmt_digit_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        const uint32_t pair = value * 2;
+        *--end = numfmt_digit_pairs[pair + 1];
+        *--end = numfmt_digit_pairs[pair];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+char* numfmt_ulltoa10(uint64_t value, char* end)
+{
+    // peel with 32-bit divisions as soon as the value allows: a 64-bit
+    // divmod is a libgcc call on this target
+    while (value > 0xffffffffull)
+    {
+        const uint32_t pair = (uint32_t)(value % 100) * 2;
+        value /= 100;
+        *--end = numfmt_digit_pairs[pair + 1];
+        *--end = numfmt_digit_pairs[pair];
+    }
+    return numfmt_utoa10((uint32_t)value, end);
+}
+
+// ---------------------------------------------------------------------
+// parsing
+
+static inline unsigned digit_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    // fold case: 'a'..'z' and 'A'..'Z' differ only in bit 5
+    const char lower = c | 0x20;
+    if (lower >= 'a' && lower <= 'z')
+    {
+        return lower - 'a' + 10;
+    }
+    return ~0u;
+}
+
+template<typename T>
+static numfmt_parse_result parse_unsigned(const char* first, const char* last, T& out,
+                                          unsigned base)
+{
+    numfmt_parse_result res = { first, false };
+    if (base < 2 || base > 36)
+    {
+        return res;
+    }
+    // strtol's trick: one division up front instead of one per digit
+    const T cutoff = (T)(~(T)0) / (T)base;
+    const unsigned cutlim = (unsigned)((T)(~(T)0) % (T)base);
+    T value = 0;
+    bool range = false;
+    const char* p = first;
+    while (p < last)
+    {
+        const unsigned d = digit_value(*p);
+        if (d >= base)
+        {
+            break;
+        }
+        if (value > cutoff || (value == cutoff && d > cutlim))
+        {
+            range = true;
+        }
+        else
+        {
+            value = value * (T)base + (T)d;
+        }
+        ++p;
+    }
+    if (p == first)
+    {
+        return res; // no digits
+    }
+    res.ptr = p;
+    if (range)
+    {
+        return res;
+    }
+    out = value;
+    res.ok = true;
+    return res;
+}
+
+template<typename T, typename U>
+static numfmt_parse_result parse_signed(const char* first, const char* last, T& out,
+                                        unsigned base)
+{
+    const char* p = first;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        ++p;
+    }
+    U magnitude = 0;
+    numfmt_parse_result res = parse_unsigned<U>(p, last, magnitude, base);
+    if (res.ptr == p)
+    {
+        res.ptr = first; // no digits: a lone sign is not consumed
+        return res;
+    }
+    if (!res.ok)
+    {
+        return res;
+    }
+    const U limit = negative ? (U)((U)1 << (sizeof(T) * 8 - 1)) // |min| = max + 1
+                             : (U)(((U)1 << (sizeof(T) * 8 - 1)) - 1);
+    if (magnitude > limit)
+    {
+        res.ok = false;
+        return res;
+    }
+    out = negative ? (T)((U)0 - magnitude) : (T)magnitude;
+    return res;
+}
+
+numfmt_parse_result numfmt_parse_u32(const char* first, const char* last, uint32_t& out,
+                                     unsigned base)
+{
+    return parse_unsigned<uint32_t>(first, last, out, base);
+}
+
+numfmt_parse_result numfmt_parse_i32(const char* first, const char* last, int32_t& out,
+                                     unsigned base)
+{
+    return parse_signed<int32_t, uint32_t>(first, last, out, base);
+}
+
+numfmt_parse_result numfmt_parse_u64(const char* first, const char* last, uint64_t& out,
+                                     unsigned base)
+{
+    return parse_unsigned<uint64_t>(first, last, out, base);
+}
+
+numfmt_parse_result numfmt_parse_i64(const char* first, const char* last, int64_t& out,
+                                     unsigned base)
+{
+    return parse_signed<int64_t, uint64_t>(first, last, out, base);
+}
+
+numfmt_parse_result numfmt_parse_double(const char* first, const char* last, double& out)
+{
+    numfmt_parse_result res = { first, false };
+    const char* p = first;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        ++p;
+    }
+
+    // accumulate the mantissa in an integer; digits beyond its 19-digit
+    // capacity only shift the decimal exponent (or vanish after the dot)
+    uint64_t mantissa = 0;
+    int exp10 = 0;
+    bool anyDigit = false;
+    while (p < last && *p >= '0' && *p <= '9')
+    {
+        anyDigit = true;
+        if (mantissa <= (~0ull - 9) / 10)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+        else
+        {
+            exp10++;
+        }
+        ++p;
+    }
+    if (p < last && *p == '.')
+    {
+        const char* dot = p++;
+        while (p < last && *p >= '0' && *p <= '9')
+        {
+            anyDigit = true;
+            if (mantissa <= (~0ull - 9) / 10)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                exp10--;
+            }
+            ++p;
+        }
+        if (p == dot + 1 && !anyDigit)
+        {
+            return res; // just "."
+        }
+    }
+    if (!anyDigit)
+    {
+        res.ptr = first;
+        return res;
+    }
+    if (p < last && (*p == 'e' || *p == 'E'))
+    {
+        int32_t exponent = 0;
+        numfmt_parse_result er = numfmt_parse_i32(p + 1, last, exponent);
+        if (er.ptr != p + 1)
+        {
+            if (!er.ok)
+            {
+                // digits present but absurd: the value cannot fit
+                res.ptr = er.ptr;
+                return res;
+            }
+            exp10 += exponent;
+            p = er.ptr;
+        }
+        // no digits after 'e': the 'e' belongs to whatever follows
+    }
+
+    // scale by 10^exp10 with squared powers; |exp10| > 511 is already
+    // far outside double range
+    static const double pows[] = { 1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256 };
+    double value = (double)mantissa;
+    const bool shrink = exp10 < 0;
+    unsigned e = shrink ? (unsigned)-exp10 : (unsigned)exp10;
+    if (e > 511)
+    {
+        e = 511; // drives the result to 0 or infinity below either way
+    }
+    for (unsigned i = 0; e; ++i, e >>= 1)
+    {
+        if (e & 1)
+        {
+            value = shrink ? value / pows[i] : value * pows[i];
+        }
+    }
+
+    res.ptr = p;
+    if (value > __DBL_MAX__)
+    {
+        return res; // overflow; underflow quietly becomes 0.0
+    }
+    out = negative ? -value : value;
+    res.ok = true;
+    return res;
+}
+
+numfmt_parse_result numfmt_parse_float(const char* first, const char* last, float& out)
+{
+    double value = 0.0;
+    numfmt_parse_result res = numfmt_parse_double(first, last, value);
+    if (!res.ok)
+    {
+        return res;
+    }
+    if (value > __FLT_MAX__ || value < -__FLT_MAX__)
+    {
+        res.ok = false;
+        return res;
+    }
+    out = (float)value;
+    return res;
+}
@@ -0,0 +1,107 @@
+/*
+ NumberFormat.h - shared decimal integer formatting helpers
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef NUMBER_FORMAT_H
+#define NUMBER_FORMAT_H
+
+#include <stdint.h>
+
+// Decimal conversion with the classic two-digits-per-division lookup:
+// each loop iteration peels off two digits with one division, halving
+// the divide count of the digit-at-a-time loops these helpers replace.
+// Used by Print::printNumber(), the String integer constructors and
+// IPAddress::printTo().
+//
+// All helpers fill the buffer backwards from 'end' (no terminator is
+// written) and return a pointer to the first digit, so the caller can
+// put a terminator at 'end' beforehand and use the returned pointer as
+// a C string.  'end' must be preceded by enough valid cells: 10 for
+// 32-bit values, 20 for 64-bit, plus 1 for a sign.
+
+// "00".."99" digit pairs
+extern const char numfmt_digit_pairs[201];
+
+char* numfmt_utoa10(uint32_t value, char* end);
+char* numfmt_ulltoa10(uint64_t value, char* end);
+
+inline char* numfmt_itoa10(int32_t value, char* end)
+{
+    // unsigned negation is defined for INT32_MIN
+    const uint32_t u = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    char* p = numfmt_utoa10(u, end);
+    if (value < 0)
+    {
+        *--p = '-';
+    }
+    return p;
+}
+
+inline char* numfmt_lltoa10(int64_t value, char* end)
+{
+    const uint64_t u = value < 0 ? 0ull - (uint64_t)value : (uint64_t)value;
+    char* p = numfmt_ulltoa10(u, end);
+    if (value < 0)
+    {
+        *--p = '-';
+    }
+    return p;
+}
+
+// ---------------------------------------------------------------------
+// std::from_chars-style parsers: operate on a [first, last) character
+// range without copying, never touch the locale, and report both how
+// far they got and whether the value was usable.  Used by the String
+// conversions and the WebServer header/range parsing in place of the
+// atol/atof/strtoul detours.
+//
+// Grammar: an optional sign ('-'/'+', signed and floating only), then
+// digits in the given base; floating point is [sign] digits ['.'
+// digits] [('e'|'E') [sign] digits] with at least one mantissa digit -
+// no hex floats, no "inf"/"nan", '.' only.  Parsing stops at the first
+// character that does not fit.
+//
+// On success 'out' is written and ok is true.  With no usable digits,
+// 'out' is untouched and ptr == first (a lone sign is not consumed).
+// When the digits are valid but the value does not fit, 'out' is
+// untouched, ok is false and ptr still points past the digits, so the
+// caller can tell "garbage" from "out of range".
+//
+// The floating-point result is within a few ULP of correctly rounded -
+// fine for configs and query args, not for round-tripping.
+
+struct numfmt_parse_result
+{
+    const char* ptr; // first character not consumed
+    bool ok;
+};
+
+numfmt_parse_result numfmt_parse_u32(const char* first, const char* last, uint32_t& out,
+                                     unsigned base = 10);
+numfmt_parse_result numfmt_parse_i32(const char* first, const char* last, int32_t& out,
+                                     unsigned base = 10);
+numfmt_parse_result numfmt_parse_u64(const char* first, const char* last, uint64_t& out,
+                                     unsigned base = 10);
+numfmt_parse_result numfmt_parse_i64(const char* first, const char* last, int64_t& out,
+                                     unsigned base = 10);
+numfmt_parse_result numfmt_parse_double(const char* first, const char* last, double& out);
+numfmt_parse_result numfmt_parse_float(const char* first, const char* last, float& out);
+
+#endif // NUMBER_FORMAT_H
@@ -136,6 +136,9 @@ using TimeMillis     = TimeUnit< TimeSourceMillis,       1000 >;
 using TimeFastMillis = TimeUnit< TimeSourceCycles,       1000 >;
 using TimeFastMicros = TimeUnit< TimeSourceCycles,    1000000 >;
 using TimeFastNanos  = TimeUnit< TimeSourceCycles, 1000000000 >;
+// user unit is the CPU cycle itself: user2UnitMultiplier and -Divider are
+// both 1 and the whole conversion folds away at compile time
+using TimeCycles     = TimeUnit< TimeSourceCycles, TimeSourceCycles::ticksPerSecond >;
 
 } //TimePolicy
 
@@ -224,6 +227,18 @@ public:
     return TimePolicyT::toUserUnit(_timeout);
   }
 
+  // time left before expiry in user units: 0 when already expired,
+  // timeMax() when never expiring
+  timeType remainingTime() const
+  {
+    if (_neverExpires)
+      return timeMax();
+    timeType elapsed = TimePolicyT::time() - _start;
+    if (elapsed >= _timeout)
+      return 0;
+    return TimePolicyT::toUserUnit(_timeout - elapsed);
+  }
+
   static constexpr timeType timeMax()
   {
     return TimePolicyT::timeMax;
@@ -250,8 +265,16 @@ protected:
     timeType current = TimePolicyT::time();
     if(checkExpired(current))
     {
-      unsigned long n = (current - _start) / _timeout; //how many _timeouts periods have elapsed, will usually be 1 (current - _start >= _timeout)
-      _start += n  * _timeout;
+      const timeType elapsed = current - _start;
+      if (elapsed - _timeout < _timeout)
+        // exactly one period has elapsed - the usual case when polled
+        // faster than the period - skip the 32-bit division
+        _start += _timeout;
+      else
+      {
+        unsigned long n = elapsed / _timeout; //how many _timeouts periods have elapsed
+        _start += n  * _timeout;
+      }
       return true;
     }
     return false;
@@ -296,6 +319,16 @@ using periodicFastUs = polledTimeout::timeoutTemplate<true, YieldPolicy::DoNothi
 using oneShotFastNs = polledTimeout::timeoutTemplate<false, YieldPolicy::DoNothing, TimePolicy::TimeFastNanos>;
 using periodicFastNs = polledTimeout::timeoutTemplate<true, YieldPolicy::DoNothing, TimePolicy::TimeFastNanos>;
 
+// "HighRes" versions count in CPU cycles directly - construct them with
+// microsecondsToClockCycles(...).  The user-unit conversion multiplies and
+// divides by 1 and folds away entirely, so reset() compiles to a cycle
+// counter read and expired() to a subtract-compare: for bit-banged timing
+// and other loops polled thousands of times per second.
+// timeMax() is 2147483646 cycles (26.8s at 80MHz)
+
+using oneShotHighRes = polledTimeout::timeoutTemplate<false, YieldPolicy::DoNothing, TimePolicy::TimeCycles>;
+using periodicHighRes = polledTimeout::timeoutTemplate<true, YieldPolicy::DoNothing, TimePolicy::TimeCycles>;
+
 } //polledTimeout
 
 
@@ -26,6 +26,7 @@
 #include <string.h>
 #include <math.h>
 #include <Arduino.h>
+#include <NumberFormat.h>
 
 #include "Print.h"
 
@@ -47,8 +48,340 @@ size_t Print::write(const uint8_t *buffer, size_t size) {
     return n;
 }
 
+/* default implementation: may be overridden */
+size_t Print::fill(char c, size_t count) {
+    char buff[64] __attribute__ ((aligned(4)));
+    memset(buff, c, std::min(count, sizeof(buff)));
+    size_t n = 0;
+    while (n < count) {
+        size_t to_write = std::min(sizeof(buff), count - n);
+        size_t written = write(buff, to_write);
+        n += written;
+        if (written < to_write) {
+            // Write didn't complete, abort additional processing
+            break;
+        }
+    }
+    return n;
+}
+
+// Streaming printf support ///////////////////////////////////////////////////
+//
+// The common logging conversions are formatted straight into the sink through
+// a small stack buffer, so output length no longer dictates a heap allocation
+// plus copy. Format strings using conversions the streaming formatter does not
+// handle (floating point mainly) take the original vsnprintf path instead.
+
+namespace
+{
+
+// Stack-resident accumulator flushing into Print::write() in bounded chunks
+class PrintfSink
+{
+public:
+    PrintfSink(Print& out): _out(out) { }
+
+    void emit(char c)
+    {
+        _buffer[_length++] = c;
+        if (_length == sizeof(_buffer)) {
+            flush();
+        }
+    }
+
+    void emitPad(char c, int count)
+    {
+        while (count-- > 0) {
+            emit(c);
+        }
+    }
+
+    // valid with dram, iram and flash sources
+    void emit_P(PGM_P source, size_t count)
+    {
+        while (count--) {
+            emit((char)pgm_read_byte(source++));
+        }
+    }
+
+    void flush()
+    {
+        if (_length && !_failed) {
+            size_t written = _out.write(_buffer, _length);
+            _written += written;
+            if (written < _length) {
+                // Write didn't complete, abort additional processing
+                _failed = true;
+            }
+        }
+        _length = 0;
+    }
+
+    size_t written() const
+    {
+        return _written;
+    }
+
+private:
+    Print& _out;
+    size_t _written = 0;
+    uint8_t _length = 0;
+    bool _failed = false;
+    char _buffer[64];
+};
+
+// Check whether every conversion in format is one the streaming formatter
+// handles; valid with dram, iram and flash format strings.
+bool printfFormatIsStreamable(PGM_P format) {
+    for (PGM_P p = format;;) {
+        char c = pgm_read_byte(p++);
+        if (!c) {
+            return true;
+        }
+        if (c != '%') {
+            continue;
+        }
+        do {    // flags
+            c = pgm_read_byte(p++);
+        } while (c == '-' || c == '0' || c == '+' || c == ' ');
+        if (c == '*') {    // width
+            c = pgm_read_byte(p++);
+        } else {
+            while (c >= '0' && c <= '9') {
+                c = pgm_read_byte(p++);
+            }
+        }
+        if (c == '.') {    // precision
+            c = pgm_read_byte(p++);
+            if (c == '*') {
+                c = pgm_read_byte(p++);
+            } else {
+                while (c >= '0' && c <= '9') {
+                    c = pgm_read_byte(p++);
+                }
+            }
+        }
+        while (c == 'h' || c == 'l' || c == 'z' || c == 't') {    // length
+            c = pgm_read_byte(p++);
+        }
+        switch (c) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+        case 'c': case 's': case 'p': case '%':
+            break;
+        default:    // includes e/f/g, '#' and a truncated specifier
+            return false;
+        }
+    }
+}
+
+void emitFormattedNumber(PrintfSink& sink, unsigned long long value, const uint8_t base, const bool upperCase,
+                         const char signChar, const char* prefix, const int width, const int precision,
+                         const bool leftAlign, bool zeroPad)
+{
+    char digits[22];    // 64-bit octal worst case
+    char* end = &digits[sizeof(digits)];
+    char* pos = end;
+    if (!(precision == 0 && value == 0)) {    // C: zero value with explicit zero precision prints nothing
+        do {
+            unsigned long long quotient = value / base;
+            uint8_t digit = value - quotient * base;
+            *--pos = digit < 10 ? digit + '0' : digit - 10 + (upperCase ? 'A' : 'a');
+            value = quotient;
+        } while (value);
+    }
+
+    int numDigits = end - pos;
+    int zeros = (precision > numDigits) ? precision - numDigits : 0;
+    int prefixLength = (signChar ? 1 : 0) + (prefix ? strlen(prefix) : 0);
+    int total = numDigits + zeros + prefixLength;
+
+    if (precision >= 0) {
+        zeroPad = false;    // C: '0' flag is ignored when a precision is given
+    }
+    if (!leftAlign && !zeroPad) {
+        sink.emitPad(' ', width - total);
+    }
+    if (signChar) {
+        sink.emit(signChar);
+    }
+    if (prefix) {
+        while (*prefix) {
+            sink.emit(*prefix++);
+        }
+    }
+    if (!leftAlign && zeroPad) {
+        sink.emitPad('0', width - total);
+    }
+    sink.emitPad('0', zeros);
+    sink.emit_P(pos, numDigits);
+    if (leftAlign) {
+        sink.emitPad(' ', width - total);
+    }
+}
+
+// Emit the formatted output directly into out; the format string must have
+// passed printfFormatIsStreamable() first. Valid with dram, iram and flash
+// format strings. Returns the number of characters written.
+size_t streamPrintf(Print& out, PGM_P format, va_list arg)
+{
+    PrintfSink sink(out);
+
+    for (PGM_P p = format;;) {
+        char c = pgm_read_byte(p++);
+        if (!c) {
+            break;
+        }
+        if (c != '%') {
+            sink.emit(c);
+            continue;
+        }
+
+        bool leftAlign = false;
+        bool zeroPad = false;
+        char sign = 0;
+        for (;;) {    // flags
+            c = pgm_read_byte(p++);
+            if (c == '-') {
+                leftAlign = true;
+            } else if (c == '0') {
+                zeroPad = true;
+            } else if (c == '+') {
+                sign = '+';
+            } else if (c == ' ') {
+                if (!sign) {
+                    sign = ' ';
+                }
+            } else {
+                break;
+            }
+        }
+
+        int width = 0;
+        if (c == '*') {
+            width = va_arg(arg, int);
+            if (width < 0) {    // C: negative width means left-aligned
+                leftAlign = true;
+                width = -width;
+            }
+            c = pgm_read_byte(p++);
+        } else {
+            while (c >= '0' && c <= '9') {
+                width = width * 10 + (c - '0');
+                c = pgm_read_byte(p++);
+            }
+        }
+
+        int precision = -1;
+        if (c == '.') {
+            c = pgm_read_byte(p++);
+            if (c == '*') {
+                precision = va_arg(arg, int);    // C: negative precision means none
+                c = pgm_read_byte(p++);
+            } else {
+                precision = 0;
+                while (c >= '0' && c <= '9') {
+                    precision = precision * 10 + (c - '0');
+                    c = pgm_read_byte(p++);
+                }
+            }
+        }
+
+        int longCount = 0;    // 0: int, 1: long, 2: long long
+        char shortMod = 0;    // 'h' or 'H' (hh)
+        while (c == 'h' || c == 'l' || c == 'z' || c == 't') {
+            if (c == 'l') {
+                ++longCount;
+            } else if (c == 'h') {
+                shortMod = shortMod ? 'H' : 'h';
+            } else {
+                longCount = (sizeof(size_t) > sizeof(long)) ? 2 : 1;
+            }
+            c = pgm_read_byte(p++);
+        }
+
+        switch (c) {
+        case 'd': case 'i': {
+            long long value = longCount >= 2 ? va_arg(arg, long long)
+                            : longCount == 1 ? va_arg(arg, long)
+                            : va_arg(arg, int);
+            if (shortMod == 'h') {
+                value = (short)value;
+            } else if (shortMod == 'H') {
+                value = (signed char)value;
+            }
+            unsigned long long magnitude = value < 0 ? -(unsigned long long)value : value;
+            emitFormattedNumber(sink, magnitude, 10, false, value < 0 ? '-' : sign, nullptr,
+                                width, precision, leftAlign, zeroPad);
+            break;
+        }
+        case 'u': case 'x': case 'X': case 'o': {
+            unsigned long long value = longCount >= 2 ? va_arg(arg, unsigned long long)
+                                     : longCount == 1 ? va_arg(arg, unsigned long)
+                                     : va_arg(arg, unsigned int);
+            if (shortMod == 'h') {
+                value = (unsigned short)value;
+            } else if (shortMod == 'H') {
+                value = (unsigned char)value;
+            }
+            emitFormattedNumber(sink, value, c == 'o' ? 8 : c == 'u' ? 10 : 16, c == 'X', 0, nullptr,
+                                width, precision, leftAlign, zeroPad);
+            break;
+        }
+        case 'c': {
+            char value = (char)va_arg(arg, int);
+            if (!leftAlign) {
+                sink.emitPad(' ', width - 1);
+            }
+            sink.emit(value);
+            if (leftAlign) {
+                sink.emitPad(' ', width - 1);
+            }
+            break;
+        }
+        case 's': {
+            const char* value = va_arg(arg, const char*);
+            if (!value) {
+                value = "(null)";
+            }
+            size_t length = strlen_P_fast(value);    // arguments may live in flash with printf_P
+            if (precision >= 0 && (size_t)precision < length) {
+                length = precision;
+            }
+            if (!leftAlign) {
+                sink.emitPad(' ', width - (int)length);
+            }
+            sink.emit_P(value, length);
+            if (leftAlign) {
+                sink.emitPad(' ', width - (int)length);
+            }
+            break;
+        }
+        case 'p':
+            emitFormattedNumber(sink, (uintptr_t)va_arg(arg, void*), 16, false, 0, "0x",
+                                width, precision, leftAlign, zeroPad);
+            break;
+        case '%':
+            sink.emit('%');
+            break;
+        }
+    }
+
+    sink.flush();
+    return sink.written();
+}
+
+} // namespace
+
 size_t Print::printf(const char *format, ...) {
     va_list arg;
+
+    if (printfFormatIsStreamable(format)) {
+        va_start(arg, format);
+        size_t len = streamPrintf(*this, format, arg);
+        va_end(arg);
+        return len;
+    }
+
     va_start(arg, format);
     char temp[64];
     char* buffer = temp;
@@ -72,6 +405,14 @@ size_t Print::printf(const char *format, ...) {
 
 size_t Print::printf_P(PGM_P format, ...) {
     va_list arg;
+
+    if (printfFormatIsStreamable(format)) {
+        va_start(arg, format);
+        size_t len = streamPrintf(*this, format, arg);
+        va_end(arg);
+        return len;
+    }
+
     va_start(arg, format);
     char temp[64];
     char* buffer = temp;
@@ -97,11 +438,11 @@ size_t Print::print(const __FlashStringHelper *ifsh) {
     PGM_P p = reinterpret_cast<PGM_P>(ifsh);
 
     char buff[128] __attribute__ ((aligned(4)));
-    auto len = strlen_P(p);
+    auto len = strlen_P_fast(p);
     size_t n = 0;
     while (n < len) {
         int to_write = std::min(sizeof(buff), len - n);
-        memcpy_P(buff, p, to_write);
+        memcpy_P_fast(buff, p, to_write);
         auto written = write(buff, to_write);
         n += written;
         p += written;
@@ -253,6 +594,13 @@ template<typename T> size_t Print::printNumber(T n, uint8_t base) {
         base = 10;
     }
 
+    if (base == 10) {
+        // two digits per division (NumberFormat.h)
+        str = (sizeof(T) > sizeof(uint32_t)) ? numfmt_ulltoa10(n, str)
+                                             : numfmt_utoa10(n, str);
+        return write(str);
+    }
+
     do {
         auto m = n;
         n /= base;
@@ -75,6 +75,12 @@ class Print {
         inline size_t write(char c) { return write((uint8_t) c); }
         inline size_t write(int8_t c) { return write((uint8_t) c); }
 
+        // Emit count copies of c through block writes staged in a small
+        // stack buffer - padding and line art without a caller-side buffer
+        // or one virtual dispatch per character.  Returns the number of
+        // characters written.
+        virtual size_t fill(char c, size_t count);
+
         // default to zero, meaning "a single write may block"
         // should be overridden by subclasses with buffering
         virtual int availableForWrite() { return 0; }
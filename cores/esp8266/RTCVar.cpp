@@ -0,0 +1,160 @@
+/*
+ RTCVar.cpp - typed variables persisted across deep sleep in RTC user memory
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RTCVar.h"
+#include "Esp.h"
+#include "coredecls.h"
+
+namespace esp8266 {
+namespace rtc {
+
+// snapshot image grows up from RTC user word 0; words 125..127 belong to
+// the WiFi fast-reconnect hint (ESP8266WiFiSTA.cpp) and the EEPROM
+// TIER_RTC image packs downward from word 124 (EEPROM.h)
+static constexpr uint32_t RTC_SNAPSHOT_WORDS = 125;
+static constexpr uint32_t RTC_SNAPSHOT_MAGIC = 0x52544356; // 'RTCV'
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint16_t version;  // application tag passed to save()
+    uint16_t layout;   // checksum of the registered sizes, in order
+    uint16_t length;   // payload bytes
+    uint16_t reserved;
+    uint32_t crc;      // crc32 of the payload
+};
+
+static constexpr size_t RTC_SNAPSHOT_CAPACITY =
+    RTC_SNAPSHOT_WORDS * 4 - sizeof(SnapshotHeader);
+
+static VarBase* s_first = nullptr;
+static VarBase* s_last = nullptr;
+static bool s_restored = false;
+static uint16_t s_version = 0;
+
+VarBase::VarBase(void* data, uint16_t size):
+    _data(data), _size(size)
+{
+    // append, so packing order equals construction order
+    if (s_last)
+        s_last->_next = this;
+    else
+        s_first = this;
+    s_last = this;
+}
+
+VarBase* VarBase::first()
+{
+    return s_first;
+}
+
+// checksum over the registered sizes in order: a changed set of RTCVar
+// declarations invalidates an older image instead of shearing it
+static uint16_t layout_checksum(size_t& total)
+{
+    uint32_t crc = 0xffffffff;
+    total = 0;
+    for (const VarBase* var = s_first; var; var = var->next()) {
+        uint16_t size = var->size();
+        crc = crc32(&size, sizeof(size), crc);
+        total += size;
+    }
+    return (uint16_t)(crc ^ (crc >> 16));
+}
+
+bool save(uint16_t version)
+{
+    size_t length;
+    uint16_t layout = layout_checksum(length);
+    if (!length || length > RTC_SNAPSHOT_CAPACITY)
+        return false;
+
+    uint32_t image[RTC_SNAPSHOT_WORDS];
+    uint8_t* payload = reinterpret_cast<uint8_t*>(image) + sizeof(SnapshotHeader);
+    size_t offset = 0;
+    for (const VarBase* var = s_first; var; var = var->next()) {
+        memcpy(payload + offset, var->data(), var->size());
+        offset += var->size();
+    }
+
+    SnapshotHeader header;
+    header.magic = RTC_SNAPSHOT_MAGIC;
+    header.version = version;
+    header.layout = layout;
+    header.length = (uint16_t)length;
+    header.reserved = 0;
+    header.crc = crc32(payload, length);
+    memcpy(image, &header, sizeof(header));
+
+    // whole words, header included
+    size_t bytes = (sizeof(header) + length + 3) & ~(size_t)3;
+    return ESP.rtcUserMemoryWrite(0, image, bytes);
+}
+
+static void restore()
+{
+    size_t length;
+    uint16_t layout = layout_checksum(length);
+    if (!length || length > RTC_SNAPSHOT_CAPACITY)
+        return;
+
+    uint32_t image[RTC_SNAPSHOT_WORDS];
+    size_t bytes = (sizeof(SnapshotHeader) + length + 3) & ~(size_t)3;
+    if (!ESP.rtcUserMemoryRead(0, image, bytes))
+        return;
+
+    SnapshotHeader header;
+    memcpy(&header, image, sizeof(header));
+    if (header.magic != RTC_SNAPSHOT_MAGIC
+            || header.layout != layout
+            || header.length != length)
+        return;
+
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(image) + sizeof(header);
+    if (header.crc != crc32(payload, length))
+        return;
+
+    size_t offset = 0;
+    for (VarBase* var = s_first; var; var = var->next()) {
+        memcpy(var->data(), payload + offset, var->size());
+        offset += var->size();
+    }
+    s_restored = true;
+    s_version = header.version;
+}
+
+bool restored()
+{
+    return s_restored;
+}
+
+uint16_t version()
+{
+    return s_version;
+}
+
+} // namespace rtc
+} // namespace esp8266
+
+// Strong definition overriding the weak no-op in core_esp8266_main.cpp;
+// linked in - and the automatic pre-setup() restore with it - only when
+// the sketch references the RTCVar framework.
+extern "C" void __rtcVarRestore(void)
+{
+    esp8266::rtc::restore();
+}
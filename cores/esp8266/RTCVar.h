@@ -0,0 +1,113 @@
+/*
+ RTCVar.h - typed variables persisted across deep sleep in RTC user memory
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef RTCVAR_H
+#define RTCVAR_H
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+/*
+  Typed snapshot framework over ESP.rtcUserMemoryRead/Write:
+
+    esp8266::rtc::RTCVar<uint32_t> bootCount;
+    esp8266::rtc::RTCVar<Calibration> cal;
+
+    void goToSleep() {
+        esp8266::rtc::save();
+        ESP.deepSleep(SLEEP_US, WAKE_NO_RFCAL);
+    }
+
+  All RTCVar objects are packed - in construction order - into one image
+  with a single CRC and a layout checksum, growing up from RTC user word
+  0 (the WiFi fast-reconnect hint keeps words 125..127, so a wake
+  cycle gets both its state and a directed reconnect, and the EEPROM
+  library's TIER_RTC image packs downward from word 124, see EEPROM.h -
+  the snapshot and that image share the words in between).  The snapshot is
+  restored automatically before setup() when the stored layout and
+  version match; declare RTCVar objects at global scope so they are
+  registered before that happens.
+*/
+
+namespace esp8266 {
+namespace rtc {
+
+// Registration list base; construction order defines the packing order
+// inside the snapshot image.
+class VarBase
+{
+protected:
+    VarBase(void* data, uint16_t size);
+
+public:
+    VarBase(const VarBase&) = delete;
+    VarBase& operator=(const VarBase&) = delete;
+
+    VarBase* next() const { return _next; }
+    void* data() const { return _data; }
+    uint16_t size() const { return _size; }
+
+    static VarBase* first();
+
+private:
+    VarBase* _next = nullptr;
+    void* _data;
+    uint16_t _size;
+};
+
+template<typename T>
+class RTCVar: public VarBase
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "RTCVar<T> requires a trivially copyable T");
+
+public:
+    RTCVar(): VarBase(&_value, sizeof(T)), _value() { }
+    explicit RTCVar(const T& initial): VarBase(&_value, sizeof(T)), _value(initial) { }
+
+    operator const T&() const { return _value; }
+    RTCVar& operator=(const T& value) { _value = value; return *this; }
+
+    // direct access, e.g. for struct members or operator chains
+    T& ref() { return _value; }
+    const T& ref() const { return _value; }
+
+private:
+    T _value;
+};
+
+// Pack every registered variable into RTC user memory under one CRC;
+// call right before ESP.deepSleep().  @a version is an application
+// chosen tag carried in the snapshot header; check it with version()
+// after a restore and bump it when the meaning of a variable changes
+// without its size changing.  Returns false when the variables exceed
+// the snapshot area.
+bool save(uint16_t version = 0);
+
+// True when this wake restored the registered variables from a valid
+// snapshot (matching layout checksum, CRC ok).
+bool restored();
+
+// Version tag carried by the snapshot restored this wake (0 when none).
+uint16_t version();
+
+} // namespace rtc
+} // namespace esp8266
+
+#endif // RTCVAR_H
@@ -0,0 +1,115 @@
+/*
+  RawNicSpi.h
+
+  Shared burst-SPI helpers for the raw wired NIC drivers
+
+  Original Copyright (c) 2020 esp8266 Arduino All rights reserved.
+  This file is part of the esp8266 Arduino core environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _RAWNICSPI_H
+#define _RAWNICSPI_H
+
+#include <SPI.h>
+
+/*
+  Common payload-moving layer for the wired MACRAW drivers (W5100, W5500,
+  ENC28J60, used through LwipIntfDev).  The per-chip register protocol stays
+  in each driver; what they share is streaming frame payloads through the
+  SPI hardware FIFO in bursts instead of one transfer() per byte, and one
+  scratch buffer for framing and discarded data.  The drivers are all polled
+  from the same loop and never run concurrently, so a single shared scratch
+  is safe and cheaper than one per driver.
+*/
+namespace rawnic
+{
+// scratch sized to a full Ethernet frame, 32-bit aligned for FIFO loads
+constexpr uint16_t scratchSize = 1536;
+
+inline uint8_t* scratch()
+{
+    static uint8_t buf[scratchSize] __attribute__((aligned(4)));
+    return buf;
+}
+
+// burst in 'len' bytes, shifting out idle bytes (chip select stays with
+// the caller, as does any command/opcode phase)
+inline void burstRead(SPIClass& spi, uint8_t* dst, uint16_t len)
+{
+    spi.transferBytes(nullptr, dst, len);
+}
+
+// burst out 'len' bytes, ignoring the returned data
+inline void burstWrite(SPIClass& spi, const uint8_t* src, uint16_t len)
+{
+    spi.writeBytes(src, len);
+}
+
+/*
+  W5100-class chips frame every payload byte in its own 4-byte command unit
+  {opcode, addrH, addrL, data} and accept the units streamed back-to-back
+  with chip select held.  Building a chunk of units in the shared scratch
+  and moving it through the FIFO in one call replaces four transfer() FIFO
+  round-trips per payload byte.
+*/
+inline void readUnitBurst(SPIClass& spi, uint8_t opcode, uint16_t address, uint8_t* dst,
+                          uint16_t len)
+{
+    uint8_t* units = scratch();
+    while (len)
+    {
+        uint16_t chunk = (len < scratchSize / 4) ? len : scratchSize / 4;
+        uint8_t* p     = units;
+        for (uint16_t i = 0; i < chunk; i++, address++)
+        {
+            *p++ = opcode;
+            *p++ = address >> 8;
+            *p++ = address & 0xff;
+            *p++ = 0;
+        }
+        // full duplex: the data byte of each unit comes back in its slot
+        spi.transferBytes(units, units, 4 * chunk);
+        for (uint16_t i = 0; i < chunk; i++)
+        {
+            *dst++ = units[4 * i + 3];
+        }
+        len -= chunk;
+    }
+}
+
+inline void writeUnitBurst(SPIClass& spi, uint8_t opcode, uint16_t address, const uint8_t* src,
+                           uint16_t len)
+{
+    uint8_t* units = scratch();
+    while (len)
+    {
+        uint16_t chunk = (len < scratchSize / 4) ? len : scratchSize / 4;
+        uint8_t* p     = units;
+        for (uint16_t i = 0; i < chunk; i++, address++)
+        {
+            *p++ = opcode;
+            *p++ = address >> 8;
+            *p++ = address & 0xff;
+            *p++ = *src++;
+        }
+        spi.writeBytes(units, 4 * chunk);
+        len -= chunk;
+    }
+}
+}  // namespace rawnic
+
+#endif  // _RAWNICSPI_H
@@ -28,13 +28,25 @@ typedef std::function<void(void)> mSchedFuncT;
 struct scheduled_fn_t
 {
     scheduled_fn_t* mNext = nullptr;
-    mSchedFuncT mFunc;
+    // type-erased callable constructed in place in mStorage:
+    // no per-node heap allocation, ever
+    void (*mInvoke)(void*) = nullptr;
+    void (*mDestroy)(void*) = nullptr; // nullptr for trivially destructible captures
+    uint32_t mCallerPC = 0; // who registered this function, for the crash black box
+    alignas(double) unsigned char mStorage[SCHEDULED_FN_CAPTURE_BUDGET];
 };
 
+// see coredecls.h / crash_blackbox.h
+uint32_t scheduled_fn_last_pc = 0;
+
+// fixed pool (~SCHEDULED_FN_MAX_COUNT * sizeof(scheduled_fn_t) of bss):
+// ISR-side scheduling must be allocation-free and bounded-time
+static scheduled_fn_t sPool[SCHEDULED_FN_MAX_COUNT];
+static int sPoolUsed = 0;
+
 static scheduled_fn_t* sFirst = nullptr;
 static scheduled_fn_t* sLast = nullptr;
 static scheduled_fn_t* sUnused = nullptr;
-static int sCount = 0;
 static uint32_t recurrent_max_grain_mS = 0;
 
 typedef std::function<bool(void)> mRecFuncT;
@@ -44,15 +56,26 @@ struct recurrent_fn_t
     mRecFuncT mFunc;
     esp8266::polledTimeout::periodicFastUs callNow;
     std::function<bool(void)> alarm = nullptr;
+    uint32_t mId = 0;
+#ifdef ESP_LOOP_STATS
+    uint32_t mCallerPC = 0; // who registered this function, for getLoopStats()
+#endif
     recurrent_fn_t(esp8266::polledTimeout::periodicFastUs interval) : callNow(interval) { }
 };
 
-static recurrent_fn_t* rFirst = nullptr;
-static recurrent_fn_t* rLast = nullptr;
+// one FIFO per priority class, drained in class order on every pass
+static recurrent_fn_t* rFirst[SCHEDULE_PRIO_COUNT] = { nullptr, nullptr, nullptr };
+static recurrent_fn_t* rLast[SCHEDULE_PRIO_COUNT] = { nullptr, nullptr, nullptr };
+static uint32_t rNextId = 0;
+static schedule_profile_hook_t rProfileHook = nullptr;
+#ifdef ESP_LOOP_STATS
+static uint32_t rSlowestPC = 0;
+static uint32_t rSlowestCycles = 0;
+#endif
 
 // Returns a pointer to an unused sched_fn_t,
-// or if none are available allocates a new one,
-// or nullptr if limit is reached
+// either recycled or taken from the fixed pool,
+// or nullptr if the pool is exhausted
 IRAM_ATTR // called from ISR
 static scheduled_fn_t* get_fn_unsafe()
 {
@@ -63,54 +86,88 @@ static scheduled_fn_t* get_fn_unsafe()
         result = sUnused;
         sUnused = sUnused->mNext;
     }
-    // if no unused items, and count not too high, allocate a new one
-    else if (sCount < SCHEDULED_FN_MAX_COUNT)
+    // if no unused items, hand out the next untouched pool slot
+    else if (sPoolUsed < SCHEDULED_FN_MAX_COUNT)
     {
-        result = new (std::nothrow) scheduled_fn_t;
-        if (result)
-            ++sCount;
+        result = &sPool[sPoolUsed++];
     }
     return result;
 }
 
 static void recycle_fn_unsafe(scheduled_fn_t* fn)
 {
-    fn->mFunc = nullptr; // special overload in c++ std lib
+    // the callable has already been destroyed (outside the lock)
+    fn->mInvoke = nullptr;
+    fn->mDestroy = nullptr;
     fn->mNext = sUnused;
     sUnused = fn;
 }
 
-IRAM_ATTR // (not only) called from ISR
-bool schedule_function(const std::function<void(void)>& fn)
+IRAM_ATTR // called from ISR
+scheduled_fn_t* schedule_function_prepare(void (*invoke)(void*), void (*destroy)(void*),
+    uint32_t caller_pc, void** storage)
 {
-    if (!fn)
-        return false;
-
     esp8266::InterruptLock lockAllInterruptsInThisScope;
 
     scheduled_fn_t* item = get_fn_unsafe();
     if (!item)
-        return false;
+        return nullptr;
 
-    item->mFunc = fn;
+    // the node is now owned by the caller: the callable is constructed
+    // into its storage before commit links it into the FIFO, so the
+    // drain loop can never observe a half-built node
     item->mNext = nullptr;
+    item->mInvoke = invoke;
+    item->mDestroy = destroy;
+    item->mCallerPC = caller_pc;
+    *storage = item->mStorage;
+    return item;
+}
+
+IRAM_ATTR // called from ISR
+void schedule_function_commit(scheduled_fn_t* item)
+{
+    esp8266::InterruptLock lockAllInterruptsInThisScope;
 
     if (sFirst)
         sLast->mNext = item;
     else
         sFirst = item;
     sLast = item;
+}
+
+IRAM_ATTR // (not only) called from ISR
+bool schedule_function(const std::function<void(void)>& fn)
+{
+    if (!fn)
+        return false;
+
+    static_assert(sizeof(mSchedFuncT) <= SCHEDULED_FN_CAPTURE_BUDGET,
+        "the capture budget must at least hold a std::function");
 
+    void* storage;
+    scheduled_fn_t* item = schedule_function_prepare(
+        [](void* p) { (*static_cast<mSchedFuncT*>(p))(); },
+        [](void* p) { static_cast<mSchedFuncT*>(p)->~mSchedFuncT(); },
+        (uint32_t)(uintptr_t)__builtin_return_address(0), &storage);
+    if (!item)
+        return false;
+
+    // copying the wrapper may still clone heap-held captures; pass the
+    // lambda itself (template overload) for the allocation-free path
+    ::new (storage) mSchedFuncT(fn);
+    schedule_function_commit(item);
     return true;
 }
 
 IRAM_ATTR // (not only) called from ISR
 bool schedule_recurrent_function_us(const std::function<bool(void)>& fn,
-    uint32_t repeat_us, const std::function<bool(void)>& alarm)
+    uint32_t repeat_us, const std::function<bool(void)>& alarm,
+    schedule_priority_t priority)
 {
     assert(repeat_us < decltype(recurrent_fn_t::callNow)::neverExpires); //~26800000us (26.8s)
 
-    if (!fn)
+    if (!fn || priority >= SCHEDULE_PRIO_COUNT)
         return false;
 
     recurrent_fn_t* item = new (std::nothrow) recurrent_fn_t(repeat_us);
@@ -119,18 +176,23 @@ bool schedule_recurrent_function_us(const std::function<bool(void)>& fn,
 
     item->mFunc = fn;
     item->alarm = alarm;
+#ifdef ESP_LOOP_STATS
+    item->mCallerPC = (uint32_t)__builtin_return_address(0);
+#endif
 
     esp8266::InterruptLock lockAllInterruptsInThisScope;
 
-    if (rLast)
+    item->mId = ++rNextId;
+
+    if (rLast[priority])
     {
-        rLast->mNext = item;
+        rLast[priority]->mNext = item;
     }
     else
     {
-        rFirst = item;
+        rFirst[priority] = item;
     }
-    rLast = item;
+    rLast[priority] = item;
 
     // grain needs to be recomputed
     recurrent_max_grain_mS = 0;
@@ -138,15 +200,48 @@ bool schedule_recurrent_function_us(const std::function<bool(void)>& fn,
     return true;
 }
 
+void schedule_set_profile_hook(schedule_profile_hook_t hook)
+{
+    rProfileHook = hook;
+}
+
+void get_scheduled_recurrent_slowest(uint32_t* pc, uint32_t* cycles)
+{
+#ifdef ESP_LOOP_STATS
+    if (pc)
+        *pc = rSlowestPC;
+    if (cycles)
+        *cycles = rSlowestCycles;
+#else
+    if (pc)
+        *pc = 0;
+    if (cycles)
+        *cycles = 0;
+#endif
+}
+
+void reset_scheduled_recurrent_slowest()
+{
+#ifdef ESP_LOOP_STATS
+    rSlowestPC = 0;
+    rSlowestCycles = 0;
+#endif
+}
+
+uint32_t get_scheduled_recurrent_last_id()
+{
+    return rNextId;
+}
+
 uint32_t compute_scheduled_recurrent_grain ()
 {
     if (recurrent_max_grain_mS == 0)
     {
-        if (rFirst)
         {
-            uint32_t recurrent_max_grain_uS = rFirst->callNow.getTimeout();
-            for (auto it = rFirst->mNext; it; it = it->mNext)
-                recurrent_max_grain_uS = std::gcd(recurrent_max_grain_uS, it->callNow.getTimeout());
+            uint32_t recurrent_max_grain_uS = 0;
+            for (int prio = 0; prio < SCHEDULE_PRIO_COUNT; ++prio)
+                for (auto it = rFirst[prio]; it; it = it->mNext)
+                    recurrent_max_grain_uS = std::gcd(recurrent_max_grain_uS, it->callNow.getTimeout());
             if (recurrent_max_grain_uS)
                 // round to the upper millis
                 recurrent_max_grain_mS = recurrent_max_grain_uS <= 1000? 1: (recurrent_max_grain_uS + 999) / 1000;
@@ -165,6 +260,28 @@ uint32_t compute_scheduled_recurrent_grain ()
     return recurrent_max_grain_mS;
 }
 
+uint32_t compute_scheduled_recurrent_delay_us ()
+{
+    uint32_t delay_us = ~(uint32_t)0;
+    for (int prio = 0; prio < SCHEDULE_PRIO_COUNT; ++prio)
+        for (auto it = rFirst[prio]; it; it = it->mNext)
+        {
+            if (it->alarm)
+                // alarm conditions are polled on every pass; no deadline
+                // can be derived, so report "work due now"
+                return 0;
+            uint32_t remaining = it->callNow.remainingTime();
+            if (remaining < delay_us)
+                delay_us = remaining;
+        }
+    return delay_us;
+}
+
+bool scheduled_functions_pending()
+{
+    return sFirst != nullptr;
+}
+
 void run_scheduled_functions()
 {
     // prevent scheduling of new functions during this run
@@ -174,7 +291,11 @@ void run_scheduled_functions()
     {
         done = sFirst == stop;
 
-        sFirst->mFunc();
+        scheduled_fn_last_pc = sFirst->mCallerPC;
+        sFirst->mInvoke(sFirst->mStorage);
+        if (sFirst->mDestroy)
+            // outside the lock: destroying captures may release heap
+            sFirst->mDestroy(sFirst->mStorage);
 
         {
             // remove function from stack
@@ -208,10 +329,6 @@ void run_scheduled_recurrent_functions()
     // its purpose is that it is never called from an interrupt
     // (always on cont stack).
 
-    auto current = rFirst;
-    if (!current)
-        return;
-
     static bool fence = false;
     {
         // fence is like a mutex but as we are never called from ISR,
@@ -225,58 +342,93 @@ void run_scheduled_recurrent_functions()
         fence = true;
     }
 
-    recurrent_fn_t* prev = nullptr;
-    // prevent scheduling of new functions during this run
-    auto stop = rLast;
-
-    bool done;
-    do
+    for (int prio = 0; prio < SCHEDULE_PRIO_COUNT; ++prio)
     {
-        done = current == stop;
-        const bool wakeup = current->alarm && current->alarm();
-        bool callNow = current->callNow;
+        auto current = rFirst[prio];
+        if (!current)
+            continue;
 
-        if ((wakeup || callNow) && !current->mFunc())
-        {
-            // remove function from stack
-            esp8266::InterruptLock lockAllInterruptsInThisScope;
+        recurrent_fn_t* prev = nullptr;
+        // prevent scheduling of new functions during this run
+        auto stop = rLast[prio];
 
-            auto to_ditch = current;
+        bool done;
+        do
+        {
+            done = current == stop;
+            const bool wakeup = current->alarm && current->alarm();
+            bool callNow = current->callNow;
+            bool remove = false;
 
-            // removing rLast
-            if (rLast == current)
-                rLast = prev;
+            if (wakeup || callNow)
+            {
+#ifdef ESP_LOOP_STATS
+                const uint32_t started = esp_get_cycle_count();
+                remove = !current->mFunc();
+                const uint32_t cycles = esp_get_cycle_count() - started;
+                if (rProfileHook)
+                    rProfileHook(current->mId, cycles);
+                if (cycles > rSlowestCycles)
+                {
+                    rSlowestCycles = cycles;
+                    rSlowestPC = current->mCallerPC;
+                }
+#else
+                if (rProfileHook)
+                {
+                    const uint32_t started = esp_get_cycle_count();
+                    remove = !current->mFunc();
+                    rProfileHook(current->mId, esp_get_cycle_count() - started);
+                }
+                else
+                {
+                    remove = !current->mFunc();
+                }
+#endif
+            }
 
-            current = current->mNext;
-            if (prev)
+            if (remove)
             {
-                prev->mNext = current;
+                // remove function from stack
+                esp8266::InterruptLock lockAllInterruptsInThisScope;
+
+                auto to_ditch = current;
+
+                // removing rLast
+                if (rLast[prio] == current)
+                    rLast[prio] = prev;
+
+                current = current->mNext;
+                if (prev)
+                {
+                    prev->mNext = current;
+                }
+                else
+                {
+                    rFirst[prio] = current;
+                }
+
+                delete(to_ditch);
+
+                // grain needs to be recomputed
+                recurrent_max_grain_mS = 0;
             }
             else
             {
-                rFirst = current;
+                prev = current;
+                current = current->mNext;
             }
 
-            delete(to_ditch);
-
-            // grain needs to be recomputed
-            recurrent_max_grain_mS = 0;
-        }
-        else
-        {
-            prev = current;
-            current = current->mNext;
-        }
-
-        if (yieldNow)
-        {
-            // because scheduled functions might last too long for watchdog etc,
-            // this is yield() in cont stack, but need to call cont_suspend directly
-            // to prevent recursion into run_scheduled_recurrent_functions()
-            esp_schedule();
-            cont_suspend(g_pcont);
-        }
-    } while (current && !done);
+            if (yieldNow)
+            {
+                // because scheduled functions might last too long for watchdog etc,
+                // this is yield() in cont stack, but need to call cont_suspend directly
+                // to prevent recursion into run_scheduled_recurrent_functions()
+                esp_schedule();
+                cont_suspend(g_pcont);
+            }
+        } while (current && !done);
+    }
 
     fence = false;
 }
@@ -20,10 +20,23 @@
 #define ESP_SCHEDULE_H
 
 #include <functional>
+#include <type_traits>
+#include <new>
 #include <stdint.h>
 
 #define SCHEDULED_FN_MAX_COUNT 32
 
+// Capture budget of the in-node callable storage: one-shot scheduled
+// functions live in a fixed pool and the callable (lambda captures, or a
+// whole std::function for the legacy overload) is constructed in place
+// inside the pooled node, so scheduling never touches the heap.  The
+// default leaves room for a std::function plus two pointers worth of
+// direct lambda captures; raise it with a build flag if the static_assert
+// in the template overload below trips.
+#ifndef SCHEDULED_FN_CAPTURE_BUDGET
+#define SCHEDULED_FN_CAPTURE_BUDGET (sizeof(std::function<void(void)>) + 2 * sizeof(void*))
+#endif
+
 // The purpose of scheduled functions is to trigger, from SYS stack (like in
 // an interrupt or a system event), registration of user code to be executed
 // in user stack (called CONT stack) without the common restrictions from
@@ -44,6 +57,12 @@
 
 uint32_t compute_scheduled_recurrent_grain ();
 
+// compute_scheduled_recurrent_delay_us() returns the time until the next
+// recurrent-function deadline, ~0 when the list is empty, and 0 when any
+// registered function carries an alarm (those must be polled promptly).
+// Used by the light-sleep governor (EspClass::autoLightSleep()).
+uint32_t compute_scheduled_recurrent_delay_us ();
+
 // scheduled functions called once:
 //
 // * internal queue is FIFO.
@@ -62,12 +81,69 @@ uint32_t compute_scheduled_recurrent_grain ();
 
 bool schedule_function (const std::function<void(void)>& fn);
 
+// Internal plumbing for the schedule_function() overloads: reserve a node
+// from the fixed pool and record the callable's trampolines (nullptr when
+// the pool is exhausted), construct the callable into *storage, then
+// commit the node to the FIFO.  Both helpers are ISR-safe and bounded-time.
+
+struct scheduled_fn_t;
+scheduled_fn_t* schedule_function_prepare(void (*invoke)(void*), void (*destroy)(void*),
+    uint32_t caller_pc, void** storage);
+void schedule_function_commit(scheduled_fn_t* node);
+
+namespace scheduled_fn_detail
+{
+    // reject scheduling a null function pointer (lambdas cannot be null)
+    template<typename T>
+    inline bool nonnull(const T&) { return true; }
+    inline bool nonnull(void (*fn)(void)) { return fn != nullptr; }
+}
+
+// Allocation-free overload: the callable is constructed directly inside a
+// pooled node, which makes scheduling from ISR context bounded-time even
+// with non-trivial captures.  Selected at compile time only when the
+// captures fit SCHEDULED_FN_CAPTURE_BUDGET; larger callables silently fall
+// back to the std::function overload above, which can clone heap-held
+// captures - when scheduling from an interrupt, keep captures small (a few
+// pointers) so this overload is taken, or raise the budget.
+
+template<typename F,
+    typename callable_t = typename std::decay<F>::type,
+    typename = decltype(std::declval<callable_t&>()()),
+    typename std::enable_if<sizeof(callable_t) <= SCHEDULED_FN_CAPTURE_BUDGET
+        && alignof(callable_t) <= alignof(double), int>::type = 0>
+bool schedule_function(F&& fn)
+{
+    if (!scheduled_fn_detail::nonnull(fn))
+        return false;
+
+    void* storage;
+    scheduled_fn_t* node = schedule_function_prepare(
+        [](void* p) { (*static_cast<callable_t*>(p))(); },
+        std::is_trivially_destructible<callable_t>::value
+            ? static_cast<void (*)(void*)>(nullptr)
+            : static_cast<void (*)(void*)>([](void* p) { static_cast<callable_t*>(p)->~callable_t(); }),
+        (uint32_t)(uintptr_t)__builtin_return_address(0), &storage);
+    if (!node)
+        return false;
+
+    ::new (storage) callable_t(std::forward<F>(fn));
+    schedule_function_commit(node);
+    return true;
+}
+
 // Run all scheduled functions.
 // Use this function if your are not using `loop`,
 // or `loop` does not return on a regular basis.
 
 void run_scheduled_functions();
 
+// True when one-shot scheduled functions are queued and waiting for the
+// next pass through the loop task; used by the yield coalescing fast path
+// to decide whether the full stack switch can be skipped.
+
+bool scheduled_functions_pending();
+
 // recurrent scheduled function:
 //
 // * Internal queue is a FIFO.
@@ -84,9 +160,44 @@ void run_scheduled_functions();
 //   recurrent function.
 // * If alarm is used, anytime during scheduling when it returns true,
 //   any remaining delay from repeat_us is disregarded, and fn is executed.
+// * Within one scheduler pass, all HIGH priority functions run before
+//   NORMAL ones, which run before LOW ones.  Registration order is kept
+//   within a class.  Use HIGH sparingly (watchdog feeds, sensor deadlines),
+//   LOW for housekeeping that can tolerate extra latency.
+
+enum schedule_priority_t
+{
+    SCHEDULE_PRIO_HIGH = 0,
+    SCHEDULE_PRIO_NORMAL,
+    SCHEDULE_PRIO_LOW,
+    SCHEDULE_PRIO_COUNT
+};
 
 bool schedule_recurrent_function_us(const std::function<bool(void)>& fn,
-    uint32_t repeat_us, const std::function<bool(void)>& alarm = nullptr);
+    uint32_t repeat_us, const std::function<bool(void)>& alarm = nullptr,
+    schedule_priority_t priority = SCHEDULE_PRIO_NORMAL);
+
+// Optional instrumentation: when set, the hook is called after every
+// recurrent function invocation with the task id (assigned in registration
+// order, see get_scheduled_recurrent_last_id() below) and the execution
+// time in CPU cycles (ESP.getCycleCount() units).  The hook runs on the
+// cont stack inside the scheduler pass - keep it short.
+
+typedef void (*schedule_profile_hook_t)(uint32_t task_id, uint32_t cycles);
+void schedule_set_profile_hook(schedule_profile_hook_t hook);
+
+// When built with -DESP_LOOP_STATS, every recurrent function invocation is
+// timed and the registration PC (caller of schedule_recurrent_function_us)
+// of the slowest single run seen so far is kept; it identifies the code that
+// blew the loop deadline. Returns zeros when the flag is not defined.
+// Surfaced through EspClass::getLoopStats().
+void get_scheduled_recurrent_slowest(uint32_t* pc, uint32_t* cycles);
+void reset_scheduled_recurrent_slowest();
+
+// Id of the most recently registered recurrent function (for correlating
+// profile hook reports with registrations).
+
+uint32_t get_scheduled_recurrent_last_id();
 
 // Test recurrence and run recurrent scheduled functions.
 // (internally called at every `yield()` and `loop()`)
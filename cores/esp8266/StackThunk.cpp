@@ -30,6 +30,7 @@
 #include "pgmspace.h"
 #include "debug.h"
 #include "StackThunk.h"
+#include <coredecls.h>
 #include <ets_sys.h>
 #include <umm_malloc/umm_malloc.h>
 #include <umm_malloc/umm_heap_select.h>
@@ -92,6 +93,20 @@ void stack_thunk_repaint()
   }
 }
 
+/* Yield from inside a thunked call (i.e. while running on the BearSSL
+   stack), so the CONT loop and scheduled functions get serviced between
+   long computation steps.  The canary is checked up front since a yield
+   with a smashed stack would corrupt whatever runs during it. */
+void stack_thunk_yield()
+{
+  if (stack_thunk_ptr && (*stack_thunk_ptr != _stackPaint)) {
+    stack_thunk_fatal_smashing();
+  }
+  if (can_yield()) {
+    esp_yield();
+  }
+}
+
 /* Simple accessor functions used by postmortem */
 uint32_t stack_thunk_get_refcnt() {
   return stack_thunk_refcnt;
@@ -35,6 +35,13 @@ extern void stack_thunk_add_ref();
 extern void stack_thunk_del_ref();
 extern void stack_thunk_repaint();
 
+// Yield to the loop from within a thunked call, verifying the stack canary
+// first.  Lets long-running BearSSL operations hand control back between
+// their heavy computation steps (see setEcProgressYield()).  Anything that
+// runs during the yield executes with only the remaining thunk stack
+// headroom, so callbacks must be small.
+extern void stack_thunk_yield();
+
 extern uint32_t stack_thunk_get_refcnt();
 extern uint32_t stack_thunk_get_stack_top();
 extern uint32_t stack_thunk_get_stack_bot();
@@ -159,6 +159,11 @@ class Stream: public Print {
 
         using oneShotMs = esp8266::polledTimeout::oneShotFastMs;
         static constexpr int temporaryStackBufferSize = 64;
+        // Upper bound for the heap staging block negotiated by
+        // SendGenericRegular() for bulk transfers: one TCP segment, so a
+        // File->WiFiClient transfer hands whole segments to the sink
+        // instead of temporaryStackBufferSize pieces.
+        static constexpr int maxTransferBlockSize = 1460;
 
         // ::send*() methods:
         // - always stop before timeout when "no-more-input-possible-data"
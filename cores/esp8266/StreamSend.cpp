@@ -19,6 +19,8 @@
     parsing functions based on TextFinder library by Michael Margolis
 */
 
+#include <memory>
+
 #include <Arduino.h>
 #include <StreamDev.h>
 
@@ -278,6 +280,29 @@ size_t Stream::SendGenericRegular(Print* to, const ssize_t len,
     const size_t maxLen  = std::max((ssize_t)0, len);
     size_t       written = 0;
 
+    // Negotiate the staging block once: the destination's current free
+    // window (the tcp send buffer for WiFiClient), bounded by the request
+    // and one TCP segment.  Bulk transfers stage through a heap block so
+    // the sink receives window-sized writes; when the window is small or
+    // the allocation fails, the stack buffer serves as before.
+    size_t blockSize = to->availableForWrite();
+    if (maxLen)
+    {
+        blockSize = std::min(blockSize, maxLen);
+    }
+    blockSize = std::min(blockSize, (size_t)maxTransferBlockSize);
+    std::unique_ptr<char[]> heapBuffer;
+    if (blockSize > (size_t)temporaryStackBufferSize)
+    {
+        heapBuffer.reset(new (std::nothrow) char[blockSize]);
+    }
+    char  stackBuffer[temporaryStackBufferSize];
+    char* buffer = heapBuffer ? heapBuffer.get() : stackBuffer;
+    if (!heapBuffer)
+    {
+        blockSize = temporaryStackBufferSize;
+    }
+
     while (!maxLen || written < maxLen)
     {
         size_t avr = available();
@@ -299,17 +324,16 @@ size_t Stream::SendGenericRegular(Print* to, const ssize_t len,
         {
             w = std::min(w, maxLen - written);
         }
-        w = std::min(w, (decltype(w))temporaryStackBufferSize);
+        w = std::min(w, blockSize);
         if (w)
         {
-            char    temp[w];
-            ssize_t r = read(temp, w);
+            ssize_t r = read((uint8_t*)buffer, w);
             if (r < 0)
             {
                 setReport(Report::ReadError);
                 break;
             }
-            w = to->write(temp, r);
+            w = to->write(buffer, r);
             written += w;
             if ((size_t)r != w)
             {
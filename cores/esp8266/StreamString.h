@@ -287,4 +287,208 @@ public:
     }
 };
 
+///////////////////////////////////////////////////////////////
+// FixedStreamString offers the same Stream contract as StreamString over
+// caller-owned storage (stack, static or preallocated): it never touches
+// the heap, and writes into a full buffer return a short count like any
+// saturated sink.  One byte of the capacity is reserved so that c_str()
+// is always NUL-terminated.
+
+class FixedStreamString: public Stream
+{
+public:
+    // buf/cap remain owned by the caller and must outlive this object;
+    // cap must be at least 1 (for the NUL)
+    FixedStreamString(char* buf, size_t cap, int peekPointer = -1) :
+        buffer(buf), capacity(cap), len(0), peekPointer(peekPointer)
+    {
+        if (capacity)
+        {
+            buffer[0] = 0;
+        }
+    }
+
+    virtual int available() override
+    {
+        return peekPointer < 0 ? len : len - peekPointer;
+    }
+
+    virtual int availableForWrite() override
+    {
+        return capacity ? capacity - 1 - len : 0;
+    }
+
+    virtual size_t write(uint8_t data) override
+    {
+        return write(&data, 1);
+    }
+
+    virtual size_t write(const uint8_t* source, size_t size) override
+    {
+        size_t l = std::min(size, (size_t)availableForWrite());
+        if (!l)
+        {
+            return 0;
+        }
+        memcpy(buffer + len, source, l);
+        len += l;
+        buffer[len] = 0;
+        return l;
+    }
+
+    virtual int read() override
+    {
+        uint8_t c;
+        return read(&c, 1) ? c : -1;
+    }
+
+    virtual int read(uint8_t* dest, size_t size) override
+    {
+        if (peekPointer < 0)
+        {
+            // consume chars
+            size_t l = std::min(size, (size_t)len);
+            memcpy(dest, buffer, l);
+            memmove(buffer, buffer + l, len - l);
+            len -= l;
+            buffer[len] = 0;
+            return l;
+        }
+
+        if (peekPointer >= (int)len)
+        {
+            return 0;
+        }
+
+        // only the pointer is moved
+        size_t l = std::min(size, (size_t)(len - peekPointer));
+        memcpy(dest, buffer + peekPointer, l);
+        peekPointer += l;
+        return l;
+    }
+
+    virtual int peek() override
+    {
+        if (peekPointer < 0)
+        {
+            if (len)
+            {
+                return buffer[0];
+            }
+        }
+        else if (peekPointer < (int)len)
+        {
+            return buffer[peekPointer];
+        }
+        return -1;
+    }
+
+    virtual void flush() override
+    {
+        // nothing to do
+    }
+
+    virtual bool inputCanTimeout() override
+    {
+        return false;
+    }
+
+    virtual bool outputCanTimeout() override
+    {
+        return false;
+    }
+
+    //// Stream's peekBufferAPI
+
+    virtual bool hasPeekBufferAPI() const override
+    {
+        return true;
+    }
+
+    virtual size_t peekAvailable() override
+    {
+        return peekPointer < 0 ? len : len - peekPointer;
+    }
+
+    virtual const char* peekBuffer() override
+    {
+        if (peekPointer < 0)
+        {
+            return buffer;
+        }
+        if (peekPointer < (int)len)
+        {
+            return buffer + peekPointer;
+        }
+        return nullptr;
+    }
+
+    virtual void peekConsume(size_t consume) override
+    {
+        if (peekPointer < 0)
+        {
+            size_t l = std::min(consume, (size_t)len);
+            memmove(buffer, buffer + l, len - l);
+            len -= l;
+            buffer[len] = 0;
+        }
+        else
+        {
+            peekPointer = std::min((size_t)len, peekPointer + consume);
+        }
+    }
+
+    virtual ssize_t streamRemaining() override
+    {
+        return peekPointer < 0 ? len : len - peekPointer;
+    }
+
+    // see S2Stream::setConsume() / resetPointer()
+    void setConsume()
+    {
+        peekPointer = -1;
+    }
+
+    void resetPointer(int pointer = 0)
+    {
+        peekPointer = pointer;
+    }
+
+    //// String-flavoured accessors
+
+    const char* c_str() const
+    {
+        return buffer;
+    }
+
+    size_t length() const
+    {
+        return len;
+    }
+
+    size_t size() const
+    {
+        return capacity;
+    }
+
+    void clear()
+    {
+        len = 0;
+        if (capacity)
+        {
+            buffer[0] = 0;
+        }
+        if (peekPointer > 0)
+        {
+            peekPointer = 0;
+        }
+    }
+
+protected:
+    char*  buffer;
+    size_t capacity;
+    size_t len;
+    int    peekPointer;  // -1:content is consumed / >=0:resettable pointer
+};
+
 #endif  // __STREAMSTRING_H
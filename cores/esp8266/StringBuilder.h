@@ -0,0 +1,145 @@
+/**
+    StringBuilder.h - rope-style accumulator for building large Strings
+
+    Collects written fragments into a chain of fixed-size heap blocks and
+    flattens them into a String (or any Print sink) only once, avoiding the
+    realloc-and-copy per fragment that chained String::operator+ costs.
+
+    This file is part of the esp8266 core for Arduino environment.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __STRINGBUILDER_H
+#define __STRINGBUILDER_H
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Print.h"
+#include "WString.h"
+
+class StringBuilder: public Print
+{
+public:
+    // blockSize is the payload size of each chained block; the default suits
+    // typical JSON/HTML fragments while keeping per-block overhead small.
+    StringBuilder(size_t blockSize = 256) :
+        _blockSize(blockSize < 16 ? 16 : blockSize) { }
+
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+    virtual ~StringBuilder()
+    {
+        clear();
+    }
+
+    virtual size_t write(uint8_t c) override
+    {
+        return write(&c, 1);
+    }
+
+    virtual size_t write(const uint8_t* data, size_t size) override
+    {
+        size_t written = 0;
+        while (written < size)
+        {
+            if (!_tail || _tail->used == _blockSize)
+            {
+                if (!addBlock())
+                    break;
+            }
+            size_t chunk = _blockSize - _tail->used;
+            if (chunk > size - written)
+                chunk = size - written;
+            memcpy(_tail->data + _tail->used, data + written, chunk);
+            _tail->used += chunk;
+            _length += chunk;
+            written += chunk;
+        }
+        return written;
+    }
+
+    size_t length() const
+    {
+        return _length;
+    }
+
+    void clear()
+    {
+        Block* b = _head;
+        while (b)
+        {
+            Block* next = b->next;
+            free(b);
+            b = next;
+        }
+        _head = _tail = nullptr;
+        _length = 0;
+    }
+
+    // Flatten the accumulated fragments into a String with a single exact
+    // allocation.  Returns an empty (invalidated) String on OOM.
+    String toString() const
+    {
+        String out;
+        if (!out.reserveExact(_length))
+            return out;
+        for (Block* b = _head; b; b = b->next)
+            out.concat(b->data, b->used);
+        return out;
+    }
+
+    // Stream the fragments straight into a sink (e.g. WiFiClient or a
+    // chunked WebServer response) without materializing a flat copy.
+    size_t printTo(Print& out) const
+    {
+        size_t written = 0;
+        for (Block* b = _head; b; b = b->next)
+            written += out.write((const uint8_t*)b->data, b->used);
+        return written;
+    }
+
+protected:
+    struct Block
+    {
+        Block* next;
+        size_t used;
+        char   data[];
+    };
+
+    bool addBlock()
+    {
+        Block* b = (Block*)malloc(sizeof(Block) + _blockSize);
+        if (!b)
+            return false;
+        b->next = nullptr;
+        b->used = 0;
+        if (_tail)
+            _tail->next = b;
+        else
+            _head = b;
+        _tail = b;
+        return true;
+    }
+
+    const size_t _blockSize;
+    Block* _head = nullptr;
+    Block* _tail = nullptr;
+    size_t _length = 0;
+};
+
+#endif // __STRINGBUILDER_H
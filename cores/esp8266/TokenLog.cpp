@@ -0,0 +1,124 @@
+/*
+ TokenLog.cpp - deferred tokenized logging
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TokenLog.h"
+#include "interrupts.h"
+#include <new>
+
+namespace tokenlog
+{
+
+// Power-of-two ring of records.  Producers are any context including ISRs,
+// so the enqueue runs under an interrupt lock (a handful of cycles); the
+// single consumer (drain/pop) runs lock-free in user context.
+static Record* s_ring = nullptr;
+static uint32_t s_mask = 0;
+static volatile uint32_t s_wpos = 0;
+static volatile uint32_t s_rpos = 0;
+static volatile uint32_t s_dropped = 0;
+
+bool begin(size_t records)
+{
+    end();
+    size_t size = 4;
+    while (size < records)
+        size <<= 1;
+    auto ring = new (std::nothrow) Record[size];
+    if (!ring)
+        return false;
+    s_mask = size - 1;
+    s_wpos = s_rpos = 0;
+    s_dropped = 0;
+    s_ring = ring;
+    return true;
+}
+
+void end()
+{
+    auto ring = s_ring;
+    s_ring = nullptr;
+    delete[] ring;
+}
+
+size_t pending()
+{
+    return s_wpos - s_rpos;
+}
+
+uint32_t dropped()
+{
+    return s_dropped;
+}
+
+bool IRAM_ATTR logRecord(PGM_P fmt, uint8_t nargs, uint32_t a0, uint32_t a1, uint32_t a2,
+                         uint32_t a3)
+{
+    if (!s_ring)
+        return false;
+
+    esp8266::InterruptLock lock;
+    if (s_wpos - s_rpos > s_mask)
+    {
+        // ring full: the newest record is discarded, like the uart rx ring
+        ++s_dropped;
+        return false;
+    }
+    Record& r = s_ring[s_wpos & s_mask];
+    r.fmt = fmt;
+    r.ccount = esp_get_cycle_count();
+    r.nargs = nargs;
+    r.args[0] = a0;
+    r.args[1] = a1;
+    r.args[2] = a2;
+    r.args[3] = a3;
+    ++s_wpos;
+    return true;
+}
+
+bool pop(Record& rec)
+{
+    if (!s_ring || s_wpos == s_rpos)
+        return false;
+
+    rec = s_ring[s_rpos & s_mask];
+    ++s_rpos;
+    return true;
+}
+
+size_t drain(Print& out, size_t max)
+{
+    size_t done = 0;
+    Record rec;
+    while (done < max && pop(rec))
+    {
+        // the token is a flash address: fetch the format string into RAM,
+        // then format with the captured words.  Unused trailing words are
+        // harmless to pass.
+        char fmt[128];
+        strncpy_P(fmt, rec.fmt, sizeof(fmt) - 1);
+        fmt[sizeof(fmt) - 1] = 0;
+        out.printf(fmt, rec.args[0], rec.args[1], rec.args[2], rec.args[3]);
+        ++done;
+    }
+    return done;
+}
+
+}  // namespace tokenlog
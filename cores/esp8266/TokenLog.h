@@ -0,0 +1,103 @@
+/*
+ TokenLog.h - deferred tokenized logging
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Deferred logging for hot paths and ISRs: TLOG() places the format literal
+// in flash and enqueues only its address (the token) plus the argument words
+// into a ring - no formatting and no UART time at the call site.  Formatting
+// happens later, from loop() context, via drain(); or records are popped raw
+// with pop() and shipped for offline decoding against the firmware image.
+//
+// Restrictions, all consequences of capturing arguments as 32-bit words:
+// at most 4 arguments per record, integer/pointer conversions only (no
+// floating point), and anything printed through %s must still be alive when
+// the record is drained (string literals and PROGMEM strings are).
+
+#ifndef TOKENLOG_H
+#define TOKENLOG_H
+
+#include <Arduino.h>
+#include <type_traits>
+
+namespace tokenlog
+{
+
+// One queued record: the PROGMEM format string address is the token,
+// arguments are captured uninterpreted as 32-bit words.
+struct Record
+{
+    static constexpr size_t maxArgs = 4;
+    PGM_P fmt;
+    uint32_t ccount;  // esp_get_cycle_count() at enqueue time
+    uint32_t args[maxArgs];
+    uint8_t nargs;
+};
+
+// Allocate the record ring (rounded up to a power of two).  false on OOM.
+bool begin(size_t records);
+void end();
+
+// records waiting to be drained
+size_t pending();
+// records discarded because the ring was full (reset by begin())
+uint32_t dropped();
+
+// Format and print up to max pending records to out.  Returns the number
+// of records printed.  Call from user context when the output is idle.
+size_t drain(Print& out, size_t max = (size_t)-1);
+
+// Pop the oldest record undecoded (raw shipping path).  false when empty.
+bool pop(Record& rec);
+
+// hot-path enqueue behind the log() template, safe from ISR context
+bool logRecord(PGM_P fmt, uint8_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+namespace impl
+{
+    template<typename T>
+    inline uint32_t word(T* v)
+    {
+        return (uint32_t)(uintptr_t)v;
+    }
+    template<typename T>
+    inline uint32_t word(T v)
+    {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                      "tokenlog captures 32-bit integers and pointers only");
+        return (uint32_t)v;
+    }
+}
+
+template<typename... Args>
+inline bool log(PGM_P fmt, Args... args)
+{
+    static_assert(sizeof...(Args) <= Record::maxArgs,
+                  "tokenlog records hold at most 4 arguments");
+    uint32_t w[Record::maxArgs] = { impl::word(args)... };
+    return logRecord(fmt, sizeof...(Args), w[0], w[1], w[2], w[3]);
+}
+
+}  // namespace tokenlog
+
+// Hot-path logging macro: ~a record copy plus two index updates per call.
+// The format literal lives in flash and never travels through the ring.
+#define TLOG(fmt, ...) (::tokenlog::log(PSTR(fmt), ##__VA_ARGS__))
+
+#endif  // TOKENLOG_H
@@ -37,6 +37,30 @@ const uint8_t base36CharValues[75] PROGMEM {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0,
 };
 
 
+namespace
+{
+// Both HEX characters of a byte value packed into one 16-bit word, so encoding
+// costs a single PROGMEM lookup per byte: the high nibble character in the low
+// half, the low nibble character in the high half.
+struct HexPairTable
+{
+    uint16_t pair[256];
+};
+
+constexpr HexPairTable makeHexPairTable()
+{
+    constexpr char hexChars[17] = "0123456789ABCDEF"; // Matches base36Chars.
+    HexPairTable table {};
+    for (uint32_t value = 0; value < 256; ++value)
+    {
+        table.pair[value] = (uint16_t)hexChars[value >> 4] | ((uint16_t)hexChars[value % 16] << 8);
+    }
+    return table;
+}
+
+const HexPairTable hexPairTable PROGMEM = makeHexPairTable();
+}
+
 String uint8ArrayToHexString(const uint8_t *uint8Array, const uint32_t arrayLength)
 {
     String hexString;
@@ -45,10 +69,15 @@ String uint8ArrayToHexString(const uint8_t *uint8Array, const uint32_t arrayLeng
         return emptyString;
     }
 
-    for (uint32_t i = 0; i < arrayLength; ++i)
+    // Encode block-wise into a stack buffer and append whole blocks, rather than paying the String concat overhead per character.
+    char hexBlock[65];
+    constexpr uint32_t blockCapacity = (sizeof hexBlock - 1) / 2;
+
+    for (uint32_t i = 0; i < arrayLength; i += blockCapacity)
     {
-        hexString += (char)pgm_read_byte(base36Chars + (uint8Array[i] >> 4));
-        hexString += (char)pgm_read_byte(base36Chars + uint8Array[i] % 16);
+        const uint32_t blockLength = (arrayLength - i < blockCapacity ? arrayLength - i : blockCapacity);
+        uint8ArrayToHexCString(uint8Array + i, blockLength, hexBlock);
+        hexString.concat(hexBlock, 2 * blockLength);
     }
 
     return hexString;
@@ -58,9 +87,27 @@ uint8_t *hexStringToUint8Array(const String &hexString, uint8_t *uint8Array, con
 {
     assert(hexString.length() >= arrayLength * 2); // Each array element can hold two hexString characters
 
+    return hexCStringToUint8Array(hexString.c_str(), uint8Array, arrayLength);
+}
+
+char *uint8ArrayToHexCString(const uint8_t *uint8Array, const uint32_t arrayLength, char *resultBuffer)
+{
+    for (uint32_t i = 0; i < arrayLength; ++i)
+    {
+        const uint16_t hexPair = pgm_read_word(hexPairTable.pair + uint8Array[i]);
+        resultBuffer[i * 2] = (char)hexPair;
+        resultBuffer[i * 2 + 1] = (char)(hexPair >> 8);
+    }
+
+    resultBuffer[arrayLength * 2] = '\0';
+    return resultBuffer;
+}
+
+uint8_t *hexCStringToUint8Array(const char *hexString, uint8_t *uint8Array, const uint32_t arrayLength)
+{
     for (uint32_t i = 0; i < arrayLength; ++i)
     {
-        uint8Array[i] = (pgm_read_byte(base36CharValues + hexString.charAt(i * 2) - '0') << 4) + pgm_read_byte(base36CharValues + hexString.charAt(i * 2 + 1) - '0');
+        uint8Array[i] = (pgm_read_byte(base36CharValues + hexString[i * 2] - '0') << 4) + pgm_read_byte(base36CharValues + hexString[i * 2 + 1] - '0');
     }
 
     return uint8Array;
@@ -58,6 +58,29 @@ String uint8ArrayToHexString(const uint8_t *uint8Array, const uint32_t arrayLeng
 */
 uint8_t *hexStringToUint8Array(const String &hexString, uint8_t *uint8Array, const uint32_t arrayLength);
 
+/**
+    Convert the contents of a uint8_t array to HEX characters in a caller-provided buffer, without heap allocation.
+    All array elements will be padded with zeroes to ensure they are converted to 2 characters each. The output is null-terminated.
+    Table-driven variant of uint8ArrayToHexString: both characters of a byte are produced by a single PROGMEM word lookup.
+
+    @param uint8Array The array to make into a HEX C string.
+    @param arrayLength The size of uint8Array, in bytes.
+    @param resultBuffer The buffer to fill with the HEX representation. Must be able to contain at least 2 * arrayLength + 1 characters.
+    @return A pointer to resultBuffer.
+*/
+char *uint8ArrayToHexCString(const uint8_t *uint8Array, const uint32_t arrayLength, char *resultBuffer);
+
+/**
+    Convert HEX characters to a uint8_t array, without heap allocation. Index 0 of the array will represent the start of the characters.
+    There must be 2 characters for each array element. Use padding with zeroes where required.
+
+    @param hexString The HEX characters to convert to a uint8_t array. At least 2 * arrayLength characters are read; no null terminator is required at that point.
+    @param uint8Array The array to fill with the contents of the hexString.
+    @param arrayLength The number of bytes to fill in uint8Array.
+    @return A pointer to the uint8Array.
+*/
+uint8_t *hexCStringToUint8Array(const char *hexString, uint8_t *uint8Array, const uint32_t arrayLength);
+
 /**
     Takes a uint64_t value and stores the bits in a uint8_t array. Assumes index 0 of the array should contain MSB (big endian).
 
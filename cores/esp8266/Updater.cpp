@@ -2,8 +2,10 @@
 #include "Updater.h"
 #include "eboot_command.h"
 #include <esp8266_peri.h>
+#include <GzipInflater.h>
 #include <PolledTimeout.h>
 #include "StackThunk.h"
+#include "Schedule.h"
 
 #include <memory>
 
@@ -53,9 +55,18 @@ void UpdaterClass::_reset(bool callback) {
   _bufferLen = 0;
   _startAddress = 0;
   _currentAddress = 0;
+  _erasedUntil = 0;
   _size = 0;
   _command = U_FLASH;
 
+  if (_sigTail) {
+    delete[] _sigTail;
+  }
+  _sigTail = nullptr;
+  _sigTailSize = 0;
+  _sigTailLen = 0;
+  _hashStreamed = false;
+
   if (callback && _end_callback) {
     _end_callback();
   }
@@ -114,11 +125,116 @@ bool UpdaterClass::begin(size_t size, int command, int ledPin, uint8_t ledOn) {
 
   //address where we will start writing the update
   uintptr_t updateStartAddress = 0;
-  //size of current sketch rounded to a sector
-  size_t currentSketchSize = (ESP.getSketchSize() + FLASH_SECTOR_SIZE - 1) & (~(FLASH_SECTOR_SIZE - 1));
   //size of the update rounded to a sector
   size_t roundedSize = (size + FLASH_SECTOR_SIZE - 1) & (~(FLASH_SECTOR_SIZE - 1));
 
+  int regionError = _computeUpdateRegion(roundedSize, command, updateStartAddress);
+  if (regionError == UPDATE_ERROR_SPACE) {
+    _setError(UPDATE_ERROR_SPACE);
+    return false;
+  }
+  else if (regionError != UPDATE_ERROR_OK) {
+    // unknown command
+#ifdef DEBUG_UPDATER
+    DEBUG_UPDATER.println(F("[begin] Unknown update command."));
+#endif
+    return false;
+  }
+
+  //initialize
+  _startAddress = updateStartAddress;
+  _currentAddress = _startAddress;
+  _size = size;
+  _decompressedSize = 0; // kept past end() so callers can query it
+  if (ESP.getFreeHeap() > 2 * FLASH_SECTOR_SIZE) {
+    _bufferSize = FLASH_SECTOR_SIZE;
+  } else {
+    _bufferSize = 256;
+  }
+  _buffer = new (std::nothrow) uint8_t[_bufferSize];
+  if (!_buffer) {
+    _setError(UPDATE_ERROR_OOM);
+    _reset(false);
+    return false;
+  }
+
+  _command = command;
+
+  _detail = UpdaterProgressDetail{};
+  _detail.size = size;
+  _lastChunkDoneUs = 0;
+
+#ifndef UPDATER_DISABLE_PRE_ERASE
+  // Erase the whole target region up front instead of stalling the
+  // receive path ~25 ms per sector mid-transfer: with the erases out of
+  // the way, the per-sector cost while streaming is just the program
+  // operation, so OTA throughput is bounded by the link rather than by
+  // flash erase latency.  Already-blank sectors are skipped.
+  // If prepare() already erased part (or all) of this region in the
+  // background, pick up where it left off.
+  uint32_t eraseFrom = _startAddress;
+  if (_prepareActive || _preparedEnd) {
+    _prepareActive = false; // cancel the scheduled background chunks
+    if (_preparedStart == _startAddress && _preparedProgress > eraseFrom) {
+      eraseFrom = (_preparedProgress < _startAddress + roundedSize) ?
+                  _preparedProgress : (_startAddress + roundedSize);
+    }
+    _preparedStart = _preparedEnd = _preparedProgress = 0;
+  }
+  for (uint32_t addr = eraseFrom; addr < _startAddress + roundedSize; addr += FLASH_SECTOR_SIZE) {
+    const uint32_t eraseStartUs = micros();
+    if (!_eraseSectorIfNeeded(addr)) {
+      _setError(UPDATE_ERROR_ERASE);
+      _reset(false);
+      return false;
+    }
+    _detail.totalEraseUs += micros() - eraseStartUs;
+    _slice.checkpoint();
+  }
+  _erasedUntil = _startAddress + roundedSize;
+#endif
+
+#ifdef DEBUG_UPDATER
+  DEBUG_UPDATER.printf_P(PSTR("[begin] _startAddress:     0x%08X (%d)\n"), _startAddress, _startAddress);
+  DEBUG_UPDATER.printf_P(PSTR("[begin] _currentAddress:   0x%08X (%d)\n"), _currentAddress, _currentAddress);
+  DEBUG_UPDATER.printf_P(PSTR("[begin] _size:             0x%08zX (%zd)\n"), _size, _size);
+#endif
+
+  if (_verify && _hash) {
+    // Feed the signing hash incrementally as sectors are written instead
+    // of re-reading the whole image out of flash in end(); the trailing
+    // signature block is held back in _sigTail so it never gets hashed.
+    const uint32_t expectedSigLen = _verify->length();
+    _sigTailSize = expectedSigLen ? expectedSigLen + sizeof(uint32_t) : 0;
+    if (_sigTailSize) {
+      _sigTail = new (std::nothrow) uint8_t[_sigTailSize];
+      if (!_sigTail) {
+        _setError(UPDATE_ERROR_OOM);
+        _reset(false);
+        return false;
+      }
+    }
+    _sigTailLen = 0;
+    _hash->begin();
+    _hashStreamed = true;
+  } else {
+    _md5.begin();
+  }
+
+  if (_start_callback) {
+    _start_callback();
+  }
+
+  // waiting for the first chunk already counts as source starvation
+  _lastChunkDoneUs = micros();
+
+  return true;
+}
+
+int UpdaterClass::_computeUpdateRegion(size_t roundedSize, int command, uintptr_t& updateStartAddress) {
+  //size of current sketch rounded to a sector
+  size_t currentSketchSize = (ESP.getSketchSize() + FLASH_SECTOR_SIZE - 1) & (~(FLASH_SECTOR_SIZE - 1));
+
   if (command == U_FLASH) {
     //address of the end of the space available for sketch and update
     uintptr_t updateEndAddress = FS_start - 0x40200000;
@@ -133,14 +249,12 @@ bool UpdaterClass::begin(size_t size, int command, int ledPin, uint8_t ledOn) {
 
     //make sure that the size of both sketches is less than the total space (updateEndAddress)
     if(updateStartAddress < currentSketchSize) {
-      _setError(UPDATE_ERROR_SPACE);    
-      return false;
+      return UPDATE_ERROR_SPACE;
     }
   }
   else if (command == U_FS) {
     if(FS_start + roundedSize > FS_end) {
-      _setError(UPDATE_ERROR_SPACE);
-      return false;
+      return UPDATE_ERROR_SPACE;
     }
 
 #ifdef ATOMIC_FS_UPDATE
@@ -150,8 +264,7 @@ bool UpdaterClass::begin(size_t size, int command, int ledPin, uint8_t ledOn) {
     updateStartAddress = (updateEndAddress > roundedSize)? (updateEndAddress - roundedSize) : 0;
 
     if(updateStartAddress < currentSketchSize) {
-      _setError(UPDATE_ERROR_SPACE);
-      return false;
+      return UPDATE_ERROR_SPACE;
     }
 #else
     updateStartAddress = FS_start - 0x40200000;
@@ -159,44 +272,64 @@ bool UpdaterClass::begin(size_t size, int command, int ledPin, uint8_t ledOn) {
   }
   else {
     // unknown command
-#ifdef DEBUG_UPDATER
-    DEBUG_UPDATER.println(F("[begin] Unknown update command."));
-#endif
-    return false;
+    return -1;
   }
 
-  //initialize
-  _startAddress = updateStartAddress;
-  _currentAddress = _startAddress;
-  _size = size;
-  if (ESP.getFreeHeap() > 2 * FLASH_SECTOR_SIZE) {
-    _bufferSize = FLASH_SECTOR_SIZE;
-  } else {
-    _bufferSize = 256;
+  return UPDATE_ERROR_OK;
+}
+
+bool UpdaterClass::prepare(size_t size, int command) {
+#ifdef UPDATER_DISABLE_PRE_ERASE
+  (void) size;
+  (void) command;
+  return false;
+#else
+  if(_size > 0 || size == 0) {
+    return false;
   }
-  _buffer = new (std::nothrow) uint8_t[_bufferSize];
-  if (!_buffer) {
-    _setError(UPDATE_ERROR_OOM);
-    _reset(false);
+
+  //size of the update rounded to a sector
+  size_t roundedSize = (size + FLASH_SECTOR_SIZE - 1) & (~(FLASH_SECTOR_SIZE - 1));
+  uintptr_t updateStartAddress = 0;
+  if (_computeUpdateRegion(roundedSize, command, updateStartAddress) != UPDATE_ERROR_OK) {
     return false;
   }
 
-  _command = command;
+  if (_prepareActive && _preparedStart == updateStartAddress &&
+      _preparedEnd == updateStartAddress + roundedSize) {
+    return true; // already erasing this region
+  }
 
-#ifdef DEBUG_UPDATER
-  DEBUG_UPDATER.printf_P(PSTR("[begin] _startAddress:     0x%08X (%d)\n"), _startAddress, _startAddress);
-  DEBUG_UPDATER.printf_P(PSTR("[begin] _currentAddress:   0x%08X (%d)\n"), _currentAddress, _currentAddress);
-  DEBUG_UPDATER.printf_P(PSTR("[begin] _size:             0x%08zX (%zd)\n"), _size, _size);
-#endif
+  _preparedStart = updateStartAddress;
+  _preparedProgress = updateStartAddress;
+  _preparedEnd = updateStartAddress + roundedSize;
 
-  if (!_verify) {
-    _md5.begin();
+  if (!_prepareActive) {
+    _prepareActive = true;
+    if (!schedule_recurrent_function_us([this]() { return _prepareChunk(); }, 0)) {
+      _prepareActive = false;
+      _preparedStart = _preparedEnd = _preparedProgress = 0;
+      return false;
+    }
   }
+  return true;
+#endif
+}
 
-  if (_start_callback) {
-    _start_callback();
+bool UpdaterClass::_prepareChunk() {
+  if (!_prepareActive) {
+    return false; // begin() took over, or prepare() was superseded
   }
-
+  if (_preparedProgress >= _preparedEnd) {
+    _prepareActive = false;
+    return false;
+  }
+  if (!_eraseSectorIfNeeded(_preparedProgress)) {
+    // leave the sector for begin() to retry and report the error
+    _prepareActive = false;
+    return false;
+  }
+  _preparedProgress += FLASH_SECTOR_SIZE;
   return true;
 }
 
@@ -239,21 +372,29 @@ bool UpdaterClass::end(bool evenIfRemaining){
   }
 
   if (_verify) {
-    // If expectedSigLen is non-zero, we expect the last four bytes of the buffer to
+    // If expectedSigLen is non-zero, we expect the last four bytes of the image to
     // contain a matching length field, preceded by the bytes of the signature itself.
     // But if expectedSigLen is zero, we expect neither a signature nor a length field;
     static constexpr uint32_t SigSize = sizeof(uint32_t);
     const uint32_t expectedSigLen = _verify->length();
-    const uint32_t sigLenAddr = _startAddress + _size - SigSize;
     uint32_t sigLen = 0;
 
 #ifdef DEBUG_UPDATER
     DEBUG_UPDATER.printf_P(PSTR("[Updater] expected sigLen: %u\n"), expectedSigLen);
 #endif
     if (expectedSigLen > 0) {
-      ESP.flashRead(sigLenAddr, &sigLen, SigSize);
+      if (_hashStreamed) {
+        // the signature block was held back from the streamed hash in
+        // _sigTail; a partially filled tail means the image was too
+        // short to contain a signature at all (sigLen stays 0)
+        if (_sigTailLen == _sigTailSize) {
+          memcpy(&sigLen, _sigTail + expectedSigLen, SigSize);
+        }
+      } else {
+        ESP.flashRead(_startAddress + _size - SigSize, &sigLen, SigSize);
+      }
 #ifdef DEBUG_UPDATER
-      DEBUG_UPDATER.printf_P(PSTR("[Updater] sigLen from flash: %u\n"), sigLen);
+      DEBUG_UPDATER.printf_P(PSTR("[Updater] sigLen: %u\n"), sigLen);
 #endif
     }
 
@@ -276,15 +417,20 @@ bool UpdaterClass::end(bool evenIfRemaining){
 #endif
     }
 
-    // Calculate hash of the payload, 128 bytes at a time
-    alignas(alignof(uint32_t)) uint8_t buff[128];
+    if (!_hashStreamed) {
+      // _verify was installed after begin(), so _writeBuffer() never fed
+      // the hash: fall back to reading the payload back out of flash
+      alignas(alignof(uint32_t)) uint8_t buff[128];
 
-    _hash->begin();
-    for (uint32_t offset = 0; offset < binSize; offset += sizeof(buff)) {
-      auto len = std::min(sizeof(buff), binSize - offset);
-      ESP.flashRead(_startAddress + offset, reinterpret_cast<uint32_t *>(&buff[0]), len);
-      _hash->add(buff, len);
+      _hash->begin();
+      for (uint32_t offset = 0; offset < binSize; offset += sizeof(buff)) {
+        auto len = std::min(sizeof(buff), binSize - offset);
+        ESP.flashRead(_startAddress + offset, reinterpret_cast<uint32_t *>(&buff[0]), len);
+        _hash->add(buff, len);
+      }
     }
+    // when streamed, every payload byte was hashed as it was written, so
+    // the hash is complete the moment the download finishes
     _hash->end();
 
 #ifdef DEBUG_UPDATER
@@ -301,20 +447,25 @@ bool UpdaterClass::end(bool evenIfRemaining){
 #endif
 
     std::unique_ptr<uint8_t[]> sig;
+    const uint8_t *sigBytes = nullptr;
     if (expectedSigLen > 0) {
-      const uint32_t sigAddr = _startAddress + binSize;
-      sig.reset(new (std::nothrow) uint8_t[sigLen]);
-      if (!sig) {
-        _setError(UPDATE_ERROR_OOM);
-        _reset();
-        return false;
+      if (_hashStreamed) {
+        sigBytes = _sigTail;
+      } else {
+        sig.reset(new (std::nothrow) uint8_t[sigLen]);
+        if (!sig) {
+          _setError(UPDATE_ERROR_OOM);
+          _reset();
+          return false;
+        }
+        ESP.flashRead(_startAddress + binSize, sig.get(), sigLen);
+        sigBytes = sig.get();
       }
-      ESP.flashRead(sigAddr, sig.get(), sigLen);
 #ifdef DEBUG_UPDATER
-      debugByteArray(PSTR("Received Signature"), sig.get(), sigLen);
+      debugByteArray(PSTR("Received Signature"), sigBytes, sigLen);
 #endif
     }
-    if (!_verify->verify(_hash, sig.get(), sigLen)) {
+    if (!_verify->verify(_hash, sigBytes, sigLen)) {
       _setError(UPDATE_ERROR_SIGN);
       _reset();
       return false;
@@ -372,14 +523,42 @@ bool UpdaterClass::end(bool evenIfRemaining){
   return true;
 }
 
+bool UpdaterClass::_eraseSectorIfNeeded(uint32_t address) {
+  // a blank check costs ~1 ms against ~25 ms for a redundant erase
+  alignas(alignof(uint32_t)) uint8_t buf[256];
+  for (uint32_t offset = 0; offset < FLASH_SECTOR_SIZE; offset += sizeof(buf)) {
+    if (!ESP.flashRead(address + offset, reinterpret_cast<uint32_t*>(buf), sizeof(buf))) {
+      return false;
+    }
+    for (size_t i = 0; i < sizeof(buf); i += 4) {
+      if (*reinterpret_cast<uint32_t*>(buf + i) != 0xffffffffu) {
+        return ESP.flashEraseSector(address / FLASH_SECTOR_SIZE);
+      }
+    }
+  }
+  return true;
+}
+
 bool UpdaterClass::_writeBuffer(){
   #define FLASH_MODE_PAGE  0
   #define FLASH_MODE_OFFSET  2
 
   bool eraseResult = true, writeResult = true;
-  if (_currentAddress % FLASH_SECTOR_SIZE == 0) {
-    if(!_async) yield();
+  const bool instrument = (bool)_detail_callback;
+  uint32_t eraseUs = 0, writeUs = 0;
+  if (instrument && _lastChunkDoneUs) {
+    // everything since the previous chunk landed was spent gathering data
+    _detail.totalStarvedUs += micros() - _lastChunkDoneUs;
+  }
+  // normally the whole region was erased ahead of the write cursor in
+  // begin(); this only runs when pre-erase is disabled or fell short
+  if (_currentAddress % FLASH_SECTOR_SIZE == 0 && _currentAddress >= _erasedUntil) {
+    _slice.checkpoint();
+    const uint32_t eraseStartUs = instrument ? micros() : 0;
     eraseResult = ESP.flashEraseSector(_currentAddress/FLASH_SECTOR_SIZE);
+    if (instrument) {
+      eraseUs = micros() - eraseStartUs;
+    }
   }
 
   // If the flash settings don't match what we already have, modify them.
@@ -406,8 +585,18 @@ bool UpdaterClass::_writeBuffer(){
   }
   
   if (eraseResult) {
-    if(!_async) yield();
+    _slice.checkpoint();
+    const uint32_t writeStartUs = instrument ? micros() : 0;
     writeResult = ESP.flashWrite(_currentAddress, _buffer, _bufferLen);
+    if (instrument) {
+      writeUs = micros() - writeStartUs;
+    }
+    if (writeResult && _hashStreamed) {
+      // hash the bytes exactly as they land in flash (including a
+      // possibly rewritten flash-mode byte), matching what the old
+      // post-pass in end() read back out of flash
+      _hashAdd(_buffer, _bufferLen);
+    }
   } else { // if erase was unsuccessful
     _currentAddress = (_startAddress + _size);
     _setError(UPDATE_ERROR_ERASE);
@@ -430,9 +619,47 @@ bool UpdaterClass::_writeBuffer(){
   }
   _currentAddress += _bufferLen;
   _bufferLen = 0;
+  if (instrument) {
+    _detail.lastEraseUs = eraseUs;
+    _detail.lastWriteUs = writeUs;
+    _detail.totalEraseUs += eraseUs;
+    _detail.totalWriteUs += writeUs;
+    _detail.sliceOverruns = _slice.overruns();
+    _detail.progress = _currentAddress - _startAddress;
+    _detail_callback(_detail);
+    // taken after the callback so its own runtime is not billed as starvation
+    _lastChunkDoneUs = micros();
+  }
   return true;
 }
 
+void UpdaterClass::_hashAdd(const uint8_t *data, size_t len) {
+  if (_sigTailSize == 0) {
+    _hash->add(data, len);
+    return;
+  }
+  // Keep the most recent _sigTailSize bytes out of the hash: the
+  // signature block at the very end of the image must never be hashed,
+  // and until the stream ends any byte might turn out to be part of it.
+  // Bytes that age out of the window are fed through.
+  if (_sigTailLen + len <= _sigTailSize) {
+    memcpy(_sigTail + _sigTailLen, data, len);
+    _sigTailLen += len;
+    return;
+  }
+  size_t excess = _sigTailLen + len - _sigTailSize;
+  if (excess >= _sigTailLen) {
+    _hash->add(_sigTail, _sigTailLen);
+    _hash->add(data, excess - _sigTailLen);
+    memcpy(_sigTail, data + len - _sigTailSize, _sigTailSize);
+  } else {
+    _hash->add(_sigTail, excess);
+    memmove(_sigTail, _sigTail + excess, _sigTailLen - excess);
+    memcpy(_sigTail + (_sigTailLen - excess), data, len);
+  }
+  _sigTailLen = _sigTailSize;
+}
+
 size_t UpdaterClass::write(uint8_t *data, size_t len) {
   if(hasError() || !isRunning())
     return 0;
@@ -452,7 +679,7 @@ size_t UpdaterClass::write(uint8_t *data, size_t len) {
       return len - left;
     }
     left -= toBuff;
-    if(!_async) yield();
+    _slice.checkpoint();
   }
   //lets see what's left
   memcpy(_buffer + _bufferLen, data + (len - left), left);
@@ -494,10 +721,10 @@ bool UpdaterClass::_verifyEnd() {
 
         // check for valid first magic byte
 	//
-	// TODO: GZIP compresses the chipsize flags, so can't do check here
+	// GZIP compresses the header, so the chipsize flags can only be
+	// checked after inflating the staged image again
 	if ((buf[0] == 0x1f) && (buf[1] == 0x8b)) {
-            // GZIP, just assume OK
-            return true;
+            return _verifyGzip();
         } else if (buf[0] != 0xE9) {
             _currentAddress = (_startAddress);
             _setError(UPDATE_ERROR_MAGIC_BYTE);            
@@ -525,6 +752,95 @@ bool UpdaterClass::_verifyEnd() {
     return false;
 }
 
+bool UpdaterClass::_verifyGzip() {
+    // GZIP image: eboot inflates it over the application area at boot, so
+    // everything eboot will trust has to be proven now - stream the staged
+    // bytes back through the inflater, which validates the CRC32/length
+    // trailer, then apply the usual header checks to the decompressed image.
+    // The first decompressed bytes are all we need to keep; the sink only
+    // remembers the header and counts the rest.
+    struct HeaderSink : public Print {
+        uint8_t head[4] = { 0, 0, 0, 0 };
+        size_t count = 0;
+        size_t write(uint8_t b) override {
+            return write(&b, 1);
+        }
+        size_t write(const uint8_t *data, size_t len) override {
+            for (size_t i = 0; count + i < sizeof(head) && i < len; i++) {
+                head[count + i] = data[i];
+            }
+            count += len;
+            return len;
+        }
+    };
+
+    // _size excludes a trailing signature block by the time we run
+    size_t offset = 0;
+    bool readFailed = false;
+    GzipInflater::Source source = [&](uint8_t *dst, size_t len) -> int {
+        if (offset >= _size) {
+            return 0;
+        }
+        len = std::min(len, _size - offset);
+        if (!ESP.flashRead(_startAddress + offset, dst, len)) {
+            readFailed = true;
+            return -1;
+        }
+        offset += len;
+        return (int)len;
+    };
+
+    // gzip needs the full 32 KB back-reference window
+    auto inflater = std::unique_ptr<GzipInflater>(new (std::nothrow) GzipInflater(source));
+    if (!inflater || !inflater->valid()) {
+        // no heap for the window: accept the image unverified, as this
+        // path always did before the check existed
+#ifdef DEBUG_UPDATER
+        DEBUG_UPDATER.printf_P(PSTR("[Updater] no RAM to verify GZIP image, skipping check\n"));
+#endif
+        return true;
+    }
+
+    HeaderSink sink;
+    int ret = inflater->inflate(sink);
+    if (ret < 0 || sink.count < sizeof(sink.head)) {
+        _currentAddress = (_startAddress);
+        _setError(readFailed ? UPDATE_ERROR_READ : UPDATE_ERROR_GZIP);
+        return false;
+    }
+    _decompressedSize = sink.count;
+#ifdef DEBUG_UPDATER
+    DEBUG_UPDATER.printf_P(PSTR("[Updater] GZIP image OK, decompressed size: %zu\n"), _decompressedSize);
+#endif
+
+    if (sink.head[0] != 0xE9) {
+        _currentAddress = (_startAddress);
+        _setError(UPDATE_ERROR_MAGIC_BYTE);
+        return false;
+    }
+
+    // eboot copies the decompressed image to address 0; it must end before
+    // the staging area it is being read from
+    if (_decompressedSize > _startAddress) {
+        _currentAddress = (_startAddress);
+        _setError(UPDATE_ERROR_SPACE);
+        return false;
+    }
+
+#if !FLASH_MAP_SUPPORT
+    uint32_t bin_flash_size = ESP.magicFlashChipSize((sink.head[3] & 0xf0) >> 4);
+
+    // check if new bin fits to SPI flash
+    if (bin_flash_size > ESP.getFlashChipRealSize()) {
+        _currentAddress = (_startAddress);
+        _setError(UPDATE_ERROR_NEW_FLASH_CONFIG);
+        return false;
+    }
+#endif
+
+    return true;
+}
+
 size_t UpdaterClass::writeStream(Stream &data, uint16_t streamTimeout) {
     size_t written = 0;
     size_t toRead = 0;
@@ -576,7 +892,7 @@ size_t UpdaterClass::writeStream(Stream &data, uint16_t streamTimeout) {
         if(_progress_callback) {
             _progress_callback(progress(), _size);
         }
-        yield();
+        _slice.checkpoint();
     }
     if(_progress_callback) {
         _progress_callback(progress(), _size);
@@ -649,6 +965,9 @@ String UpdaterClass::getErrorString() const {
   case UPDATE_ERROR_OOM:
     out = F("Out of memory");
     break;
+  case UPDATE_ERROR_GZIP:
+    out = F("GZIP image is corrupt");
+    break;
   default:
     out = F("UNKNOWN");
     break;
@@ -2,6 +2,7 @@
 #define ESP8266UPDATER_H
 
 #include <Arduino.h>
+#include <coredecls.h>
 #include <flash_utils.h>
 #include <MD5Builder.h>
 #include <functional>
@@ -21,6 +22,7 @@
 #define UPDATE_ERROR_SIGN               (12)
 #define UPDATE_ERROR_NO_DATA            (13)
 #define UPDATE_ERROR_OOM                (14)
+#define UPDATE_ERROR_GZIP               (15)
 
 #define U_FLASH   0
 #define U_FS      100
@@ -50,9 +52,28 @@ class UpdaterVerifyClass {
     virtual bool verify(UpdaterHashClass *hash, const void *signature, uint32_t signatureLen) = 0; // Verify, return "true" on success
 };
 
+/*
+  Transfer instrumentation passed to the onProgressDetail() callback after
+  every chunk reaches flash. The totals split the elapsed time into flash
+  operations and waiting for source data, so a "slow OTA" report can be
+  classified in one line: high erase/write totals point at the flash chip,
+  a high starved total points at the link feeding the update.
+*/
+struct UpdaterProgressDetail {
+  size_t progress = 0;         // bytes written to flash so far
+  size_t size = 0;             // total expected update size
+  uint32_t lastEraseUs = 0;    // erase time of the last chunk (0 when pre-erased)
+  uint32_t lastWriteUs = 0;    // program time of the last chunk
+  uint32_t totalEraseUs = 0;   // cumulative sector erase time, incl. pre-erase
+  uint32_t totalWriteUs = 0;   // cumulative flash program time
+  uint32_t totalStarvedUs = 0; // cumulative wait for source data between chunks
+  uint32_t sliceOverruns = 0;  // cooperative-slicing budget overruns (see CooperativeSection)
+};
+
 class UpdaterClass {
   public:
     using THandlerFunction_Progress = std::function<void(size_t, size_t)>;
+    using THandlerFunction_ProgressDetail = std::function<void(const UpdaterProgressDetail&)>;
     using THandlerFunction_Error = std::function<void(uint8_t)>;
     using THandlerFunction = std::function<void()>;
   
@@ -68,6 +89,16 @@ class UpdaterClass {
     */
     bool begin(size_t size, int command = U_FLASH, int ledPin = -1, uint8_t ledOn = LOW);
 
+    /*
+      Optionally call before begin(), as soon as the size of an incoming update
+      is known, to start erasing the target region in the background, one
+      sector per scheduled chunk. The erase then overlaps e.g. an OTA
+      authentication handshake, and begin() only has to finish whatever is
+      left, so the write phase streams into pre-erased flash.
+      Returns false when an update is already running or the region is invalid.
+    */
+    bool prepare(size_t size, int command = U_FLASH);
+
     /*
       Run Updater from asynchronous callbacs
     */
@@ -133,6 +164,15 @@ class UpdaterClass {
       return *this;
     }
 
+    /*
+      This callback will be called after each chunk has been written to
+      flash, with the timing breakdown from UpdaterProgressDetail
+    */
+    UpdaterClass& onProgressDetail(THandlerFunction_ProgressDetail fn) {
+      _detail_callback = std::move(fn);
+      return *this;
+    }
+
     /*
       This callback will be called when Updater ends
     */
@@ -167,6 +207,13 @@ class UpdaterClass {
     size_t progress(){ return _currentAddress - _startAddress; }
     size_t remaining(){ return _size - (_currentAddress - _startAddress); }
 
+    /*
+      For GZIP-compressed U_FLASH images (eboot inflates them at boot):
+      the decompressed image size, known once end() has verified the
+      staged stream.  0 for plain images or before end().
+    */
+    size_t decompressedSize(){ return _decompressedSize; }
+
     /*
       Template to write from objects that expose
       available() and read(uint8_t*, size_t) methods
@@ -212,9 +259,14 @@ class UpdaterClass {
   private:
     void _reset(bool callback = true);
     bool _writeBuffer();
+    bool _eraseSectorIfNeeded(uint32_t address);
+    int _computeUpdateRegion(size_t roundedSize, int command, uintptr_t& updateStartAddress);
+    bool _prepareChunk();
+    void _hashAdd(const uint8_t *data, size_t len);
 
     bool _verifyHeader(uint8_t data);
     bool _verifyEnd();
+    bool _verifyGzip();
 
     void _setError(int error);    
 
@@ -224,10 +276,26 @@ class UpdaterClass {
     size_t _bufferLen = 0; // amount of data written into _buffer
     size_t _bufferSize = 0; // total size of _buffer
     size_t _size = 0;
+    size_t _decompressedSize = 0;
     uint32_t _startAddress = 0;
     uint32_t _currentAddress = 0;
+    uint32_t _erasedUntil = 0; // flash below this address is already erased
     uint32_t _command = U_FLASH;
 
+    // Transfer instrumentation, only collected while a detail callback is set
+    UpdaterProgressDetail _detail;
+    uint32_t _lastChunkDoneUs = 0; // when the previous chunk finished, for starvation accounting
+
+    // Watchdog-aware slicing across the erase/write loops; replaces the
+    // unconditional per-sector yield()s
+    CooperativeSection _slice;
+
+    // Background erase started by prepare(), finished (if needed) by begin()
+    uint32_t _preparedStart = 0;
+    uint32_t _preparedEnd = 0;
+    uint32_t _preparedProgress = 0; // next address the background erase will handle
+    bool _prepareActive = false;
+
     String _target_md5;
     MD5Builder _md5;
 
@@ -237,9 +305,14 @@ class UpdaterClass {
     // Optional signed binary verification
     UpdaterHashClass *_hash = nullptr;
     UpdaterVerifyClass *_verify = nullptr;
+    bool _hashStreamed = false;  // hash fed from _writeBuffer() since begin()
+    uint8_t *_sigTail = nullptr; // trailing signature block, kept out of the hash
+    size_t _sigTailSize = 0;
+    size_t _sigTailLen = 0;
 
     // Optional lifetime callback functions
     THandlerFunction_Progress _progress_callback = nullptr;
+    THandlerFunction_ProgressDetail _detail_callback = nullptr;
     THandlerFunction_Error _error_callback = nullptr;
     THandlerFunction _start_callback = nullptr;
     THandlerFunction _end_callback = nullptr;
@@ -24,6 +24,7 @@
 #include "Arduino.h"
 #include "WString.h"
 #include "stdlib_noniso.h"
+#include "NumberFormat.h"
 
 #include <limits>
 
@@ -41,7 +42,12 @@ static String toString(unsigned char value, unsigned char base) {
     String out;
 
     char buf[1 + std::numeric_limits<unsigned char>::digits];
-    out = utoa(value, buf, base);
+    if (base == 10) {
+        char* end = &buf[sizeof(buf) - 1];
+        *end = 0;
+        out = numfmt_utoa10(value, end);
+    } else
+        out = utoa(value, buf, base);
 
     return out;
 }
@@ -50,7 +56,12 @@ static String toString(int value, unsigned char base) {
     String out;
 
     char buf[2 + std::numeric_limits<int>::digits];
-    out = itoa(value, buf, base);
+    if (base == 10) {
+        char* end = &buf[sizeof(buf) - 1];
+        *end = 0;
+        out = numfmt_itoa10(value, end);
+    } else
+        out = itoa(value, buf, base);
 
     return out;
 }
@@ -59,7 +70,12 @@ static String toString(unsigned int value, unsigned char base) {
     String out;
 
     char buf[1 + std::numeric_limits<unsigned int>::digits];
-    out = utoa(value, buf, base);
+    if (base == 10) {
+        char* end = &buf[sizeof(buf) - 1];
+        *end = 0;
+        out = numfmt_utoa10(value, end);
+    } else
+        out = utoa(value, buf, base);
 
     return out;
 }
@@ -68,7 +84,12 @@ static String toString(long value, unsigned char base) {
     String out;
 
     char buf[2 + std::numeric_limits<long>::digits];
-    out = ltoa(value, buf, base);
+    if (base == 10) {
+        char* end = &buf[sizeof(buf) - 1];
+        *end = 0;
+        out = numfmt_lltoa10(value, end);
+    } else
+        out = ltoa(value, buf, base);
 
     return out;
 }
@@ -77,7 +98,12 @@ static String toString(unsigned long value, unsigned char base) {
     String out;
 
     char buf[1 + std::numeric_limits<unsigned long>::digits];
-    out = ultoa(value, buf, base);
+    if (base == 10) {
+        char* end = &buf[sizeof(buf) - 1];
+        *end = 0;
+        out = numfmt_ulltoa10(value, end);
+    } else
+        out = ultoa(value, buf, base);
 
     return out;
 }
@@ -122,7 +148,7 @@ static String toString(float value, unsigned char decimalPlaces) {
 String::String(const char *cstr) {
     init();
     if (cstr)
-        copy(cstr, strlen_P(cstr));
+        copy(cstr, strlen_P_fast(cstr));
 }
 
 String::String(const String &value) {
@@ -197,6 +223,17 @@ bool String::reserve(unsigned int size) {
     return false;
 }
 
+bool String::reserveExact(unsigned int size) {
+    if (buffer() && capacity() >= size)
+        return true;
+    if (changeBuffer(size, true)) {
+        if (len() == 0)
+            wbuffer()[0] = 0;
+        return true;
+    }
+    return false;
+}
+
 #ifdef DEBUG_ESP_PORT
 static void identifyString (const String& badOne)
 {
@@ -206,7 +243,7 @@ static void identifyString (const String& badOne)
 }
 #endif
 
-bool String::changeBuffer(unsigned int maxStrLen) {
+bool String::changeBuffer(unsigned int maxStrLen, bool exact) {
     // Can we use SSO here to avoid allocation?
     if (maxStrLen < sizeof(sso.buff) - 1) {
         if (isSSO() || !buffer()) {
@@ -226,7 +263,9 @@ bool String::changeBuffer(unsigned int maxStrLen) {
         return true;
     }
     // Fallthrough to normal allocator
-    size_t newSize = (maxStrLen + 16) & (~0xf);
+    // (an exact request skips the usual rounding-up so a known-size payload
+    //  does not carry up to 15 bytes of slack)
+    size_t newSize = exact ? maxStrLen + 1 : (maxStrLen + 16) & (~0xf);
 #ifdef DEBUG_ESP_PORT
     if (!isSSO() && capacity() >= OOM_STRING_THRESHOLD_REALLOC_WARN && maxStrLen > capacity()) {
         // warn when badly re-allocating
@@ -287,7 +326,7 @@ String &String::copy(const __FlashStringHelper *pstr, unsigned int length) {
         return *this;
     }
     setLen(length);
-    memcpy_P(wbuffer(), (PGM_P)pstr, length); // We know wbuffer() cannot ever be in PROGMEM, so memcpy safe here
+    memcpy_P_fast(wbuffer(), (PGM_P)pstr, length); // We know wbuffer() cannot ever be in PROGMEM, so memcpy safe here
     wbuffer()[length] = 0;
     return *this;
 }
@@ -324,7 +363,7 @@ String &String::operator =(const char *cstr) {
 
 String &String::operator =(const __FlashStringHelper *pstr) {
     if (pstr)
-        copy(pstr, strlen_P((PGM_P)pstr));
+        copy(pstr, strlen_P_fast((PGM_P)pstr));
     else
         invalidate();
     return *this;
@@ -423,13 +462,13 @@ bool String::concat(double num) {
 bool String::concat(const __FlashStringHelper *str) {
     if (!str)
         return false;
-    int length = strlen_P((PGM_P)str);
+    int length = strlen_P_fast((PGM_P)str);
     if (length == 0)
         return true;
     unsigned int newlen = len() + length;
     if (!reserve(newlen))
         return false;
-    memcpy_P(wbuffer() + len(), (PGM_P)str, length);
+    memcpy_P_fast(wbuffer() + len(), (PGM_P)str, length);
     setLen(newlen);
     wbuffer()[newlen] = 0;
     return true;
@@ -461,7 +500,7 @@ String &String::insert(size_t position, const char *other, size_t other_length)
 
 String &String::insert(size_t position, const __FlashStringHelper *other) {
     auto *p = reinterpret_cast<const char*>(other);
-    return insert(position, p, strlen_P(p));
+    return insert(position, p, strlen_P_fast(p));
 }
 
 String &String::insert(size_t position, char other) {
@@ -518,7 +557,7 @@ String operator +(char lhs, const String &rhs) {
 
 String operator +(const char *lhs, const String &rhs) {
     String res;
-    res.reserve(strlen_P(lhs) + rhs.length());
+    res.reserve(strlen_P_fast(lhs) + rhs.length());
     res += lhs;
     res += rhs;
     return res;
@@ -905,22 +944,50 @@ void String::trim(void) {
 /*  Parsing / Conversion                     */
 /*********************************************/
 
+// The numfmt parsers replace the old atol/atof calls: no locale, no
+// heavyweight conversion path, and the atoi-compatible "leading
+// whitespace then whatever parses" behavior is recreated here.  Out of
+// range input saturates instead of being undefined.
+
 long String::toInt(void) const {
-    if (buffer())
-        return atol(buffer());
-    return 0;
+    const char* p = buffer();
+    if (!p)
+        return 0;
+    while (isspace((unsigned char)*p))
+        p++;
+    int64_t value = 0;
+    numfmt_parse_result res = numfmt_parse_i64(p, buffer() + len(), value);
+    if (!res.ok)
+        return res.ptr == p ? 0
+               : *p == '-' ? std::numeric_limits<long>::min()
+                           : std::numeric_limits<long>::max();
+    if (value > (int64_t)std::numeric_limits<long>::max())
+        return std::numeric_limits<long>::max();
+    if (value < (int64_t)std::numeric_limits<long>::min())
+        return std::numeric_limits<long>::min();
+    return (long)value;
 }
 
 float String::toFloat(void) const {
-    if (buffer())
-        return atof(buffer());
-    return 0.0F;
+    const char* p = buffer();
+    if (!p)
+        return 0.0F;
+    while (isspace((unsigned char)*p))
+        p++;
+    float value = 0.0F;
+    numfmt_parse_float(p, buffer() + len(), value);
+    return value;
 }
 
 double String::toDouble(void) const {
-    if (buffer())
-        return atof(buffer());
-    return 0.0;
+    const char* p = buffer();
+    if (!p)
+        return 0.0;
+    while (isspace((unsigned char)*p))
+        p++;
+    double value = 0.0;
+    numfmt_parse_double(p, buffer() + len(), value);
+    return value;
 }
 
 // global empty string to allow returning const String& with nothing
@@ -120,6 +120,10 @@ class String {
         // is left unchanged).  reserve(0), if successful, will validate an
         // invalid string (i.e., "if (s)" will be true afterwards)
         bool reserve(unsigned int size);
+        // like reserve(), but allocates exactly `size` characters instead of
+        // rounding the capacity up.  Useful for payloads of known final size,
+        // where the rounded-up slack would only fragment the heap.
+        bool reserveExact(unsigned int size);
         unsigned int length(void) const {
             return buffer() ? len() : 0;
         }
@@ -313,7 +317,16 @@ class String {
             uint16_t len;
         };
         // This allows strings up up to 11 (10 + \0 termination) without any extra space.
-        enum { SSOSIZE = sizeof(struct _ptr) + 4 - 1 }; // Characters to allocate space for SSO, must be 12 or more
+        // The inline capacity can be raised per-build (e.g. -DSTRING_SSO_SIZE=24) for
+        // workloads dominated by strings slightly longer than the default, at the cost
+        // of a bigger String object everywhere.  Values below the default are ignored,
+        // and the 7-bit sso.len field caps the usable size at 128.
+#ifndef STRING_SSO_SIZE
+#define STRING_SSO_SIZE 0
+#endif
+        enum { SSOSIZE = (STRING_SSO_SIZE) < (int)(sizeof(struct _ptr) + 4 - 1) ? (int)(sizeof(struct _ptr) + 4 - 1)
+                       : (STRING_SSO_SIZE) > 128 ? 128
+                       : (STRING_SSO_SIZE) }; // Characters to allocate space for SSO, must be 12 or more
         struct _sso {
             char     buff[SSOSIZE];
             unsigned char len    : 7; // Ensure only one byte is allocated by GCC for the bitfields
@@ -373,7 +386,7 @@ class String {
 
         // resets the string storage to the initial state
         void invalidate(void);
-        bool changeBuffer(unsigned int maxStrLen);
+        bool changeBuffer(unsigned int maxStrLen, bool exact = false);
 
         // copy or insert at a specific position
         String &copy(const char *cstr, unsigned int length);
@@ -25,8 +25,11 @@
 #include "Arduino.h"
 extern "C" {
 #include "libb64/cencode.h"
+#include "libb64/cdecode.h"
 }
 #include "base64.h"
+#include "StreamDev.h"
+#include "StreamString.h"
 
 /**
  * convert input data to base64
@@ -74,3 +77,178 @@ String base64::encode(const uint8_t * data, size_t length, bool doNewLines)
 
     return base64;
 }
+
+static const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * convert input stream to base64 without intermediate allocation
+ * @param in Stream&
+ * @param out Print&
+ * @param doNewLines bool
+ * @return number of characters written to out
+ */
+size_t base64::encode(Stream& in, Print& out, bool doNewLines)
+{
+    // Multiple of 3 so that complete groups can be word-packed; one line of
+    // output (+newlines) fits the output buffer with room to spare.
+    uint8_t inBuf[3 * 64];
+    char outBuf[4 * 64 + (4 * 64) / BASE64_CHARS_PER_LINE + 1];
+    size_t written = 0;
+    size_t buffered = 0;
+    size_t lineLength = 0;
+
+    for (;;)
+    {
+        size_t got = in.readBytes(inBuf + buffered, sizeof(inBuf) - buffered);
+        buffered += got;
+
+        size_t groups = buffered / 3;
+        if (!groups && !got)
+        {
+            break;
+        }
+
+        const uint8_t* inPos = inBuf;
+        char* outPos = outBuf;
+        for (size_t i = 0; i < groups; i++)
+        {
+            // Pack each 3-byte group into one word and slice it into four
+            // 6-bit indices, instead of stepping libb64's per-byte state machine.
+            uint32_t word = ((uint32_t)inPos[0] << 16) | ((uint32_t)inPos[1] << 8) | inPos[2];
+            inPos += 3;
+            *outPos++ = base64Alphabet[(word >> 18) & 0x3F];
+            *outPos++ = base64Alphabet[(word >> 12) & 0x3F];
+            *outPos++ = base64Alphabet[(word >> 6) & 0x3F];
+            *outPos++ = base64Alphabet[word & 0x3F];
+            if (doNewLines && (lineLength += 4) >= BASE64_CHARS_PER_LINE)
+            {
+                *outPos++ = '\n';
+                lineLength = 0;
+            }
+        }
+        written += out.write(outBuf, outPos - outBuf);
+
+        // Keep a trailing partial group buffered until the stream ends
+        buffered -= groups * 3;
+        memmove(inBuf, inPos, buffered);
+
+        if (!got)
+        {
+            break;
+        }
+        yield();      // time for network streams
+    }
+
+    if (buffered)
+    {
+        uint32_t word = (uint32_t)inBuf[0] << 16;
+        if (buffered == 2)
+        {
+            word |= (uint32_t)inBuf[1] << 8;
+        }
+        char tail[4];
+        tail[0] = base64Alphabet[(word >> 18) & 0x3F];
+        tail[1] = base64Alphabet[(word >> 12) & 0x3F];
+        tail[2] = (buffered == 2) ? base64Alphabet[(word >> 6) & 0x3F] : '=';
+        tail[3] = '=';
+        written += out.write(tail, sizeof(tail));
+    }
+
+    return written;
+}
+
+/**
+ * convert base64 input stream back to plain data, stopping at '=' padding.
+ * Characters outside the base64 alphabet (newlines etc.) are skipped.
+ * @param in Stream&
+ * @param out Print&
+ * @return number of bytes written to out
+ */
+size_t base64::decode(Stream& in, Print& out)
+{
+    char inBuf[128];
+    uint8_t outBuf[sizeof(inBuf) / 4 * 3];
+    size_t written = 0;
+    uint32_t word = 0;
+    uint8_t count = 0;
+    bool padded = false;
+
+    for (;;)
+    {
+        size_t got = in.readBytes(inBuf, sizeof(inBuf));
+        if (!got)
+        {
+            break;
+        }
+
+        size_t outLen = 0;
+        for (size_t i = 0; i < got; i++)
+        {
+            // the lookup goes through pgm_read_byte, so the negative markers
+            // for invalid characters come back as 254/255 without this cast
+            int8_t value = (int8_t)base64_decode_value(inBuf[i]);
+            if (value < 0)
+            {
+                if (inBuf[i] != '=')
+                {
+                    continue;
+                }
+                padded = true;
+                break;
+            }
+
+            word = (word << 6) | value;
+            if (++count == 4)
+            {
+                outBuf[outLen++] = (word >> 16) & 0xFF;
+                outBuf[outLen++] = (word >> 8) & 0xFF;
+                outBuf[outLen++] = word & 0xFF;
+                word = 0;
+                count = 0;
+            }
+        }
+        written += out.write(outBuf, outLen);
+
+        if (padded)
+        {
+            break;
+        }
+        yield();      // time for network streams
+    }
+
+    // Flush the final partial group (2 chars carry 1 byte, 3 chars carry 2),
+    // whether it was terminated by padding or by the end of the stream.
+    if (count >= 2)
+    {
+        uint8_t tail[2];
+        size_t tailLen = 0;
+        if (count == 2)
+        {
+            tail[tailLen++] = (word >> 4) & 0xFF;
+        }
+        else
+        {
+            tail[tailLen++] = (word >> 10) & 0xFF;
+            tail[tailLen++] = (word >> 2) & 0xFF;
+        }
+        written += out.write(tail, tailLen);
+    }
+
+    return written;
+}
+
+/**
+ * convert base64 text back to plain data
+ * @param text const String&
+ * @return String
+ */
+String base64::decode(const String& text)
+{
+    StreamString decoded;
+    if (decoded.reserve(base64_decode_expected_len(text.length()) + 1))
+    {
+        StreamConstPtr in(text);
+        decode(in, decoded);
+    }
+    return decoded;
+}
@@ -26,6 +26,7 @@
 #define CORE_BASE64_H_
 
 #include <WString.h>
+#include <Stream.h>
 
 class base64
 {
@@ -50,6 +51,20 @@ public:
     {
         return encode(text, false);
     }
+
+    // Streaming variants: data is moved from in to out through small stack
+    // buffers, so no intermediate heap allocation is needed no matter how
+    // large the payload is. Both return the number of bytes written to out.
+    static size_t encode(Stream& in, Print& out, bool doNewLines = false);
+    static size_t decode(Stream& in, Print& out);
+
+    // Characters outside the base64 alphabet (newlines etc.) are skipped,
+    // decoding stops at the first '=' padding character.
+    static String decode(const String& text);
+    static inline String decode(const char* text)
+    {
+        return decode(String(text));
+    }
 private:
 };
 
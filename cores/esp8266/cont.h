@@ -39,8 +39,8 @@ typedef struct cont_ {
         unsigned* sp_suspend;
 
         unsigned* stack_end;
-        unsigned unused1;
-        unsigned unused2;
+        unsigned stack_freewords;  // cached high-water mark, in words; see cont_update_free_stack
+        unsigned stack_deepest_pc; // code address sampled near the deepest point seen, 0 if none
         unsigned stack_guard1;
 
         unsigned stack[CONT_STACKSIZE / 4];
@@ -69,6 +69,18 @@ void cont_check(cont_t*);
 // and thus weren't used by the user code. i.e. that stack space is free. (high water mark)
 int cont_get_free_stack(cont_t* cont);
 
+// Incrementally refresh the cached high water mark and return it in bytes.
+// Only the region between the previously cached mark and the new deepest
+// point is scanned, so calling this at every yield boundary is cheap. When
+// the mark deepens, a leftover return address near the new low point is
+// sampled into stack_deepest_pc to identify the deepest call path.
+int cont_update_free_stack(cont_t* cont);
+
+// Return the code address sampled when the stack high water mark was last
+// pushed deeper, or 0 if the mark has not moved since init/repaint. Feed it
+// to the exception decoder to name the deepest call path seen so far.
+unsigned cont_get_deepest_pc(cont_t* cont);
+
 // Check if cont_suspend() may be called. Returns true if we are running inside
 // continuation stack
 bool cont_can_suspend(cont_t* cont);
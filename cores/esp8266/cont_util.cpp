@@ -38,6 +38,8 @@ void cont_init(cont_t* cont) {
     cont->stack_guard2 = CONT_STACKGUARD;
     cont->stack_end = cont->stack + (sizeof(cont->stack) / 4);
     cont->struct_start = (unsigned*) cont;
+    cont->stack_freewords = sizeof(cont->stack) / 4;
+    cont->stack_deepest_pc = 0;
     
     // fill stack with magic values to check high water mark
     for(int pos = 0; pos < (int)(sizeof(cont->stack) / 4); pos++)
@@ -71,6 +73,70 @@ int cont_get_free_stack(cont_t* cont) {
     return freeWords * 4;
 }
 
+// Heuristic for leftover return addresses in dead stack frames: IRAM code
+// lives at 0x4010xxxx and flash code at 0x402xxxxx.
+static inline bool looks_like_pc(uint32_t word)
+{
+    return (word >= 0x40100000u && word < 0x40108000u)
+        || (word >= 0x40200000u && word < 0x40300000u);
+}
+
+// No need for this to be in IRAM, not expected to be IRQ called
+int cont_update_free_stack(cont_t* cont) {
+    const uint32_t stackWords = sizeof(cont->stack) / 4;
+    uint32_t boundary = cont->stack_freewords;
+    if (boundary > stackWords)
+    {
+        boundary = stackWords;
+    }
+    const uint32_t prev = boundary;
+
+    // Walk down from the cached mark. A run of consecutive painted words is
+    // required before trusting a boundary so a stray value matching the paint
+    // pattern inside a dead frame can't stop the scan early and overstate
+    // the remaining free stack.
+    uint32_t run = 0;
+    for (uint32_t pos = boundary; pos > 0 && run < 8; pos--)
+    {
+        if (cont->stack[pos - 1] == CONT_STACKGUARD)
+        {
+            run++;
+        }
+        else
+        {
+            run = 0;
+            boundary = pos - 1;
+        }
+    }
+
+    if (boundary < prev)
+    {
+        cont->stack_freewords = boundary;
+
+        // The mark moved: sample a leftover return address just above the new
+        // low point, identifying the call path that went deepest.
+        uint32_t limit = boundary + 32;
+        if (limit > stackWords)
+        {
+            limit = stackWords;
+        }
+        for (uint32_t pos = boundary; pos < limit; pos++)
+        {
+            if (looks_like_pc(cont->stack[pos]))
+            {
+                cont->stack_deepest_pc = cont->stack[pos];
+                break;
+            }
+        }
+    }
+
+    return boundary * 4;
+}
+
+unsigned cont_get_deepest_pc(cont_t* cont) {
+    return cont->stack_deepest_pc;
+}
+
 bool IRAM_ATTR cont_can_suspend(cont_t* cont) {
     return !ETS_INTR_WITHINISR() &&
            cont->pc_ret != 0 && cont->pc_suspend == 0;
@@ -87,6 +153,9 @@ void cont_repaint_stack(cont_t *cont)
     {
        *pos = CONT_STACKGUARD;
     }
+    // Freshly painted: reset the cached high water mark and the sampled PC
+    cont->stack_freewords = (sp - 16) - &cont->stack[0];
+    cont->stack_deepest_pc = 0;
 }
 
 };
@@ -39,6 +39,9 @@ extern "C" void app_entry_redefinable(void)
 {
     g_pcont = &g_cont;
 
+    /* boot timeline: first C code, see core_esp8266_main.cpp */
+    esp_boot_timeline_record(BOOT_CP_APP_ENTRY);
+
     #ifdef UMM_INIT_USE_IRAM
     /*
      * Legacy option: the umm_init() call path must reside in IRAM.
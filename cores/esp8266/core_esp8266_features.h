@@ -101,6 +101,14 @@ void precache(void *f, uint32_t bytes);
 unsigned long millis(void);
 unsigned long micros(void);
 uint64_t micros64(void);
+// 64-bit CPU cycle counter, the recommended hot-path clock: the read is two
+// loads, a compare and a shift (no SDK call, well under 20 cycles), safe from
+// ISRs.  Maintained by the same periodic tick that services micros().
+// Convert spans with clockCyclesToMicroseconds(); prefer 32-bit deltas of
+// esp_get_cycle_count() for spans known to be short.  Unlike micros64() the
+// cycle counter halts in light sleep and changes rate when the CPU frequency
+// is switched, so use it for measuring, not for wall time.
+uint64_t esp_get_cycle_count64(void);
 void delay(unsigned long);
 void delayMicroseconds(unsigned int us);
 
@@ -28,8 +28,16 @@
 
 extern "C" {
 
-#define SLC_BUF_CNT (8)  // Number of buffers in the I2S circular buffer
-#define SLC_BUF_LEN (64) // Length of one buffer, in 32-bit words.
+#define SLC_BUF_CNT (8)  // Default number of buffers in the I2S circular buffer
+#define SLC_BUF_LEN (64) // Default length of one buffer, in 32-bit words.
+
+// Runtime-configurable DMA geometry (i2s_set_buffers(), call before begin).
+// The SLC descriptor datalen/blocksize fields are 12 bits wide, capping a
+// single buffer at 1023 words.
+#define SLC_BUF_CNT_MAX (32)
+#define SLC_BUF_LEN_MAX (1023)
+static uint8_t  _i2s_slc_buf_cnt = SLC_BUF_CNT;
+static uint16_t _i2s_slc_buf_len = SLC_BUF_LEN;
 
 // We use a queue to keep track of the DMA buffers that are empty. The ISR
 // will push buffers to the back of the queue, the I2S transmitter will pull
@@ -54,10 +62,10 @@ typedef struct slc_queue_item {
 } slc_queue_item_t;
 
 typedef struct i2s_state {
-  uint32_t *       slc_queue[SLC_BUF_CNT];
+  uint32_t **      slc_queue; // [_i2s_slc_buf_cnt]
   volatile uint8_t slc_queue_len;
-  uint32_t *       slc_buf_pntr[SLC_BUF_CNT]; // Pointer to the I2S DMA buffer data
-  slc_queue_item_t slc_items[SLC_BUF_CNT]; // I2S DMA buffer descriptors
+  uint32_t **      slc_buf_pntr; // Pointers to the I2S DMA buffer data, [_i2s_slc_buf_cnt]
+  slc_queue_item_t *slc_items; // I2S DMA buffer descriptors, [_i2s_slc_buf_cnt]
   uint32_t *       curr_slc_buf; // Current buffer for writing
   uint32_t         curr_slc_buf_pos; // Position in the current buffer
   void             (*callback) (void);
@@ -65,6 +73,10 @@ typedef struct i2s_state {
   // and be placed in IRAM for faster execution. Avoid long computational tasks in this
   // function, use it to set flags and process later.
   bool             driveClocks;
+  // instrumentation, see i2s_underruns() & friends
+  uint32_t         underruns; // TX: DMA ran dry; RX: buffer overwritten before being read
+  uint32_t         eof_gap_max; // worst observed cycles between buffer-done interrupts
+  uint32_t         eof_last; // cycle count of the previous buffer-done interrupt
 } i2s_state_t;
 
 // RX = I2S receive (i.e. microphone), TX = I2S transmit (i.e. DAC)
@@ -93,11 +105,20 @@ bool i2s_set_bits(int bits) {
   return true;
 }
 
+bool i2s_set_buffers(uint8_t count, uint16_t len) {
+  if (tx || rx || count < 2 || count > SLC_BUF_CNT_MAX || len < 4 || len > SLC_BUF_LEN_MAX) {
+    return false;
+  }
+  _i2s_slc_buf_cnt = count;
+  _i2s_slc_buf_len = len;
+  return true;
+}
+
 static bool _i2s_is_full(const i2s_state_t *ch) {
   if (!ch) {
     return false;
   }
-  return (ch->curr_slc_buf_pos==SLC_BUF_LEN || ch->curr_slc_buf==NULL) && (ch->slc_queue_len == 0);
+  return (ch->curr_slc_buf_pos==_i2s_slc_buf_len || ch->curr_slc_buf==NULL) && (ch->slc_queue_len == 0);
 }
 
 bool i2s_is_full() {
@@ -112,7 +133,7 @@ static bool _i2s_is_empty(const i2s_state_t *ch) {
   if (!ch) {
     return false;
   }
-  return (ch->slc_queue_len >= SLC_BUF_CNT-1);
+  return (ch->slc_queue_len >= _i2s_slc_buf_cnt-1);
 }
 
 bool i2s_is_empty() {
@@ -127,7 +148,7 @@ static uint16_t _i2s_available(const i2s_state_t *ch) {
   if (!ch) {
     return 0;
   }
-  return (SLC_BUF_CNT - ch->slc_queue_len) * SLC_BUF_LEN;
+  return (_i2s_slc_buf_cnt - ch->slc_queue_len) * _i2s_slc_buf_len;
 }
 
 uint16_t i2s_available(){
@@ -157,7 +178,7 @@ static void IRAM_ATTR i2s_slc_queue_append_item(i2s_state_t *ch, uint32_t *item)
       ch->slc_queue[dest++] = ch->slc_queue[i];
     }
   }
-  if (ch->slc_queue_len < SLC_BUF_CNT - 1) {
+  if (ch->slc_queue_len < _i2s_slc_buf_cnt - 1) {
     ch->slc_queue[ch->slc_queue_len++] = item;
   } else {
     ch->slc_queue[ch->slc_queue_len] = item;
@@ -170,10 +191,21 @@ static void IRAM_ATTR i2s_slc_isr(void) {
   SLCIC = 0xFFFFFFFF;
   if (slc_intr_status & SLCIRXEOF) {
     slc_queue_item_t *finished_item = (slc_queue_item_t *)SLCRXEDA;
+    // Track the worst gap between buffer-done interrupts; compared against
+    // the nominal buffer duration this exposes scheduling jitter.
+    uint32_t now = esp_get_cycle_count();
+    if (tx->eof_last) {
+      uint32_t gap = now - tx->eof_last;
+      if (gap > tx->eof_gap_max) {
+        tx->eof_gap_max = gap;
+      }
+    }
+    tx->eof_last = now;
     // Zero the buffer so it is mute in case of underflow
-    ets_memset((void *)finished_item->buf_ptr, 0x00, SLC_BUF_LEN * 4);
-    if (tx->slc_queue_len >= SLC_BUF_CNT-1) {
+    ets_memset((void *)finished_item->buf_ptr, 0x00, _i2s_slc_buf_len * 4);
+    if (tx->slc_queue_len >= _i2s_slc_buf_cnt-1) {
       // All buffers are empty. This means we have an underflow
+      tx->underruns++;
       i2s_slc_queue_next_item(tx); // Free space for finished_item
     }
     tx->slc_queue[tx->slc_queue_len++] = finished_item->buf_ptr;
@@ -185,6 +217,10 @@ static void IRAM_ATTR i2s_slc_isr(void) {
     slc_queue_item_t *finished_item = (slc_queue_item_t *)SLCTXEDA;
     // Set owner back to 1 (SW) or else RX stops.  TX has no such restriction.
     finished_item->owner = 1;
+    if (rx->slc_queue_len >= _i2s_slc_buf_cnt - 1) {
+      // Reader is not keeping up, a filled buffer is being recycled
+      rx->underruns++;
+    }
     i2s_slc_queue_append_item(rx, finished_item->buf_ptr);
     if (rx->callback) {
       rx->callback();
@@ -201,28 +237,72 @@ void i2s_rx_set_callback(void (*callback) (void)) {
   if (rx) rx->callback = callback;
 }
 
+uint32_t i2s_underruns() {
+  return tx ? tx->underruns : 0;
+}
+
+uint32_t i2s_rx_overruns() {
+  return rx ? rx->underruns : 0;
+}
+
+uint32_t i2s_callback_interval_max_cycles() {
+  return tx ? tx->eof_gap_max : 0;
+}
+
+void i2s_stats_reset() {
+  if (tx) {
+    tx->underruns = 0;
+    tx->eof_gap_max = 0;
+    tx->eof_last = 0;
+  }
+  if (rx) {
+    rx->underruns = 0;
+  }
+}
+
 static bool _alloc_channel(i2s_state_t *ch) {
   ch->slc_queue_len = 0;
-  for (int x=0; x<SLC_BUF_CNT; x++) {
-    ch->slc_buf_pntr[x] = (uint32_t *)malloc(SLC_BUF_LEN * sizeof(ch->slc_buf_pntr[0][0]));
+  ch->slc_queue = (uint32_t **)malloc(_i2s_slc_buf_cnt * sizeof(ch->slc_queue[0]));
+  ch->slc_buf_pntr = (uint32_t **)calloc(_i2s_slc_buf_cnt, sizeof(ch->slc_buf_pntr[0]));
+  ch->slc_items = (slc_queue_item_t *)malloc(_i2s_slc_buf_cnt * sizeof(ch->slc_items[0]));
+  if (!ch->slc_queue || !ch->slc_buf_pntr || !ch->slc_items) {
+    // OOM, the upper layer will free up any partially allocated channels.
+    return false;
+  }
+  for (int x=0; x<_i2s_slc_buf_cnt; x++) {
+    ch->slc_buf_pntr[x] = (uint32_t *)malloc(_i2s_slc_buf_len * sizeof(ch->slc_buf_pntr[0][0]));
     if (!ch->slc_buf_pntr[x]) {
       // OOM, the upper layer will free up any partially allocated channels.
       return false;
     }
-    memset(ch->slc_buf_pntr[x], 0, SLC_BUF_LEN * sizeof(ch->slc_buf_pntr[x][0]));
+    memset(ch->slc_buf_pntr[x], 0, _i2s_slc_buf_len * sizeof(ch->slc_buf_pntr[x][0]));
 
     ch->slc_items[x].unused = 0;
     ch->slc_items[x].owner = 1;
     ch->slc_items[x].eof = 1;
     ch->slc_items[x].sub_sof = 0;
-    ch->slc_items[x].datalen = SLC_BUF_LEN * 4;
-    ch->slc_items[x].blocksize = SLC_BUF_LEN * 4;
+    ch->slc_items[x].datalen = _i2s_slc_buf_len * 4;
+    ch->slc_items[x].blocksize = _i2s_slc_buf_len * 4;
     ch->slc_items[x].buf_ptr = (uint32_t*)&ch->slc_buf_pntr[x][0];
-    ch->slc_items[x].next_link_ptr = (x<(SLC_BUF_CNT-1))?(&ch->slc_items[x+1]):(&ch->slc_items[0]);
+    ch->slc_items[x].next_link_ptr = (x<(_i2s_slc_buf_cnt-1))?(&ch->slc_items[x+1]):(&ch->slc_items[0]);
   }
   return true;
 }
 
+static void _free_channel(i2s_state_t *ch) {
+  if (ch->slc_buf_pntr) {
+    for (int x = 0; x<_i2s_slc_buf_cnt; x++) {
+      free(ch->slc_buf_pntr[x]);
+    }
+    free(ch->slc_buf_pntr);
+    ch->slc_buf_pntr = NULL;
+  }
+  free(ch->slc_queue);
+  ch->slc_queue = NULL;
+  free(ch->slc_items);
+  ch->slc_items = NULL;
+}
+
 static bool i2s_slc_begin() {
   if (tx) {
     if (!_alloc_channel(tx)) {
@@ -284,15 +364,11 @@ static void i2s_slc_end(){
   SLCTXL &= ~(SLCTXLAM << SLCTXLA); // clear TX descriptor address
   SLCRXL &= ~(SLCRXLAM << SLCRXLA); // clear RX descriptor address
 
-  for (int x = 0; x<SLC_BUF_CNT; x++) {
-    if (tx) {
-      free(tx->slc_buf_pntr[x]);
-      tx->slc_buf_pntr[x] = NULL;
-    }
-    if (rx) {
-      free(rx->slc_buf_pntr[x]);
-      rx->slc_buf_pntr[x] = NULL;
-    }
+  if (tx) {
+    _free_channel(tx);
+  }
+  if (rx) {
+    _free_channel(rx);
   }
 }
 
@@ -303,7 +379,7 @@ static bool _i2s_write_sample(uint32_t sample, bool nb) {
     return false;
   }
 
-  if (tx->curr_slc_buf_pos==SLC_BUF_LEN || tx->curr_slc_buf==NULL) {
+  if (tx->curr_slc_buf_pos==_i2s_slc_buf_len || tx->curr_slc_buf==NULL) {
     if (tx->slc_queue_len == 0) {
       if (nb) {
         // Don't wait if nonblocking, just notify upper levels
@@ -349,7 +425,7 @@ static uint16_t _i2s_write_buffer(const int16_t *frames, uint16_t frame_count, b
     while(frame_count>0) {
    
         // make sure we have room in the current buffer
-        if (tx->curr_slc_buf_pos==SLC_BUF_LEN || tx->curr_slc_buf==NULL) {
+        if (tx->curr_slc_buf_pos==_i2s_slc_buf_len || tx->curr_slc_buf==NULL) {
             // no room in the current buffer? if there are no buffers available then exit
             if (tx->slc_queue_len == 0)
             {
@@ -376,7 +452,7 @@ static uint16_t _i2s_write_buffer(const int16_t *frames, uint16_t frame_count, b
         }       
 
         //space available in the current buffer
-        uint16_t	available = SLC_BUF_LEN - tx->curr_slc_buf_pos;
+        uint16_t	available = _i2s_slc_buf_len - tx->curr_slc_buf_pos;
 
         uint16_t fc = (available < frame_count) ? available : frame_count;
 
@@ -413,7 +489,7 @@ bool i2s_read_sample(int16_t *left, int16_t *right, bool blocking) {
   if (!rx) {
     return false;
   }
-  if (rx->curr_slc_buf_pos==SLC_BUF_LEN || rx->curr_slc_buf==NULL) {
+  if (rx->curr_slc_buf_pos==_i2s_slc_buf_len || rx->curr_slc_buf==NULL) {
     if (rx->slc_queue_len == 0) {
       if (!blocking) {
         return false;
@@ -579,7 +655,7 @@ bool i2s_rxtxdrive_begin(bool enableRx, bool enableTx, bool driveRxClocks, bool
 
   if (rx) {
     // Need to prime the # of samples to receive in the engine
-    I2SRXEN = SLC_BUF_LEN;
+    I2SRXEN = _i2s_slc_buf_len;
   }
 
   I2SC |= (rx?I2SRXS:0) | (tx?I2STXS:0); // Start transmission/reception
@@ -47,6 +47,11 @@ bool i2s_set_bits(int bits); // Set bits per sample, only 16 or 24 supported.  C
 // Note that in 24 bit mode each sample must be left-aligned (i.e. 0x00000000 .. 0xffffff00) as the
 // hardware shifts starting at bit 31, not bit 23.
 
+bool i2s_set_buffers(uint8_t count, uint16_t len); // Set DMA buffer count (2..32) and length in
+// 32-bit words (4..1023, default 8x64).  Call before begin.  More/larger buffers ride out WiFi
+// bursts, fewer/smaller ones lower latency.  Total DMA memory used is count*len*4 bytes per
+// enabled direction.
+
 void i2s_begin(); // Enable TX only, for compatibility
 bool i2s_rxtx_begin(bool enableRx, bool enableTx); // Allow TX and/or RX, returns false on OOM error
 bool i2s_rxtxdrive_begin(bool enableRx, bool enableTx, bool driveRxClocks, bool driveTxClocks);
@@ -67,6 +72,13 @@ uint16_t i2s_rx_available();// returns the number of samples than can be written
 void i2s_set_callback(void (*callback) (void));
 void i2s_rx_set_callback(void (*callback) (void));
 
+// Instrumentation, maintained by the DMA ISR, cleared by i2s_stats_reset():
+uint32_t i2s_underruns(); // times TX DMA ran dry (a buffer was replayed as silence)
+uint32_t i2s_rx_overruns(); // times a filled RX buffer was recycled before being read
+uint32_t i2s_callback_interval_max_cycles(); // worst CPU-cycle gap between TX buffer-done
+// interrupts; compare to the nominal buffer duration to gauge scheduling jitter
+void i2s_stats_reset();
+
 // writes a buffer of frames into the DMA memory, returns the amount of frames written
 // A frame is just a int16_t for mono, for stereo a frame is two int16_t, one for each channel.
 uint16_t i2s_write_buffer_mono(const int16_t *frames, uint16_t frame_count);
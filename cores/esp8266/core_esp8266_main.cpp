@@ -67,6 +67,10 @@ static os_event_t s_loop_queue[LOOP_QUEUE_SIZE];
 /* Used to implement optimistic_yield */
 static uint32_t s_cycles_at_resume;
 
+/* Coalescing window for the yield()/esp_yield()/delay(0) fast path, in
+ * cycles; 0 (default) keeps the unconditional stack switch. */
+static uint32_t s_yield_coalesce_cycles = 0;
+
 /* For ets_intr_lock_nest / ets_intr_unlock_nest
  * Max nesting seen by SDK so far is 2.
  */
@@ -118,6 +122,7 @@ extern "C" bool can_yield() {
 
 static inline void esp_suspend_within_cont() __attribute__((always_inline));
 static void esp_suspend_within_cont() {
+        cont_update_free_stack(g_pcont);
         cont_suspend(g_pcont);
         s_cycles_at_resume = ESP.getCycleCount();
         run_scheduled_recurrent_functions();
@@ -131,6 +136,28 @@ extern "C" void __esp_suspend() {
 
 extern "C" void esp_suspend() __attribute__ ((weak, alias("__esp_suspend")));
 
+extern "C" void esp_set_yield_coalescing(uint32_t interval_us) {
+    s_yield_coalesce_cycles = interval_us *
+#if defined(F_CPU)
+        clockCyclesPerMicrosecond();
+#else
+        ESP.getCpuFreqMHz();
+#endif
+}
+
+/* The idle fast path: the CONT<->SYS stack switch can be skipped when SYS ran
+ * within the coalescing window (it had its chance at any pending SDK work),
+ * nothing is queued for the loop task, and we are on the CONT stack at all.
+ * s_cycles_at_resume is only refreshed by a real suspension, so at most one
+ * full switch per window still happens and the soft WDT keeps getting fed. */
+static inline bool esp_yield_can_coalesce() __attribute__((always_inline));
+static bool esp_yield_can_coalesce() {
+    return s_yield_coalesce_cycles != 0
+        && (ESP.getCycleCount() - s_cycles_at_resume) < s_yield_coalesce_cycles
+        && !scheduled_functions_pending()
+        && cont_can_suspend(g_pcont);
+}
+
 extern "C" IRAM_ATTR void esp_schedule() {
     ets_post(LOOP_TASK_PRIORITY, 0, 0);
 }
@@ -140,6 +167,10 @@ extern "C" IRAM_ATTR void esp_schedule() {
 // whereever only called from CONT, use esp_yield() if code is called from SYS
 // or both CONT and SYS.
 extern "C" void esp_yield() {
+    if (esp_yield_can_coalesce()) {
+        run_scheduled_recurrent_functions();
+        return;
+    }
     esp_schedule();
     esp_suspend();
 }
@@ -150,6 +181,10 @@ void delay_end(void* arg) {
 }
 
 extern "C" void __esp_delay(unsigned long ms) {
+    if (!ms && esp_yield_can_coalesce()) {
+        run_scheduled_recurrent_functions();
+        return;
+    }
     if (ms) {
         os_timer_setfn(&delay_timer, (os_timer_func_t*)&delay_end, 0);
         os_timer_arm(&delay_timer, ms, ONCE);
@@ -184,6 +219,10 @@ bool esp_try_delay(const uint32_t start_ms, const uint32_t timeout_ms, const uin
 
 extern "C" void __yield() {
     if (cont_can_suspend(g_pcont)) {
+        if (esp_yield_can_coalesce()) {
+            run_scheduled_recurrent_functions();
+            return;
+        }
         esp_schedule();
         esp_suspend_within_cont();
     }
@@ -211,6 +250,23 @@ extern "C" void optimistic_yield(uint32_t interval_us) {
     }
 }
 
+extern "C" uint32_t esp_cycles_at_resume() {
+    return s_cycles_at_resume;
+}
+
+// see CooperativeSection (coredecls.h)
+extern "C" uint32_t esp_cooperative_overruns = 0;
+
+extern "C" void esp_cooperative_slice() {
+    if (can_yield()) {
+        yield();
+    } else {
+        // SYS cannot suspend; keeping the soft watchdog fed is the next
+        // best thing
+        system_soft_wdt_feed();
+    }
+}
+
 // Replace ets_intr_(un)lock with nestable versions
 extern "C" void IRAM_ATTR ets_intr_lock() {
   if (ets_intr_lock_stack_ptr < ETS_INTR_LOCK_NEST_MAX)
@@ -239,6 +295,47 @@ extern "C" bool IRAM_ATTR ets_post(uint8 prio, ETSSignal sig, ETSParam par) {
   return rc;
 }
 
+#ifdef ESP_LOOP_STATS
+static uint32_t s_loop_iterations = 0;
+static uint32_t s_loop_max_cycles = 0;
+static uint32_t s_loop_histogram[32] = { 0 };
+
+extern "C" void esp_loop_stats_get(uint32_t* iterations, uint32_t* max_cycles, uint32_t* histogram32)
+{
+    if (iterations)
+        *iterations = s_loop_iterations;
+    if (max_cycles)
+        *max_cycles = s_loop_max_cycles;
+    if (histogram32)
+        memcpy(histogram32, s_loop_histogram, sizeof(s_loop_histogram));
+}
+
+extern "C" void esp_loop_stats_reset(void)
+{
+    s_loop_iterations = 0;
+    s_loop_max_cycles = 0;
+    memset(s_loop_histogram, 0, sizeof(s_loop_histogram));
+}
+#endif
+
+/* Boot timeline storage. Deliberately initialized so it lands in .data:
+   the first checkpoint is recorded in app_entry(), before the SDK zeroes
+   .bss, and .data is already loaded at that point.  The placeholder in
+   slot 0 is reported as 0 if a replacement entry point never records. */
+static uint32_t s_boot_timeline[BOOT_CP_COUNT] = { 1 };
+
+extern "C" void IRAM_ATTR esp_boot_timeline_record(int checkpoint)
+{
+    s_boot_timeline[checkpoint] = esp_get_cycle_count();
+}
+
+extern "C" void esp_boot_timeline_get(uint32_t cycles[])
+{
+    memcpy(cycles, s_boot_timeline, sizeof(s_boot_timeline));
+    if (cycles[BOOT_CP_APP_ENTRY] == 1)
+        cycles[BOOT_CP_APP_ENTRY] = 0;
+}
+
 extern "C" void __loop_end (void)
 {
     run_scheduled_functions();
@@ -251,15 +348,34 @@ static void loop_wrapper() {
     static bool setup_done = false;
     preloop_update_frequency();
     if(!setup_done) {
+        __rtcVarRestore(); // restores the RTCVar deep-sleep snapshot when linked (RTCVar.h)
+        esp_boot_timeline_record(BOOT_CP_SETUP);
         setup();
+        esp_boot_timeline_record(BOOT_CP_SETUP_DONE);
         setup_done = true;
     }
+#ifdef ESP_LOOP_STATS
+    const uint32_t loop_start_cycles = ESP.getCycleCount();
+#endif
     loop();
     loop_end();
+#ifdef ESP_LOOP_STATS
+    {
+        const uint32_t cycles = ESP.getCycleCount() - loop_start_cycles;
+        s_loop_iterations++;
+        if (cycles > s_loop_max_cycles)
+            s_loop_max_cycles = cycles;
+        // log2 buckets: bucket i counts iterations with floor(log2(cycles)) == i
+        s_loop_histogram[31 - __builtin_clz(cycles | 1)]++;
+    }
+#endif
     cont_check(g_pcont);
+    cont_update_free_stack(g_pcont);
     if (serialEventRun) {
         serialEventRun();
     }
+    esp_auto_light_sleep_idle();
+    esp_entropy_pool_stir();
     esp_schedule();
 }
 
@@ -313,10 +429,12 @@ static void  __unhandled_exception_cpp()
 }
 
 void init_done() {
+    esp_boot_timeline_record(BOOT_CP_SDK_DONE);
     system_set_os_print(1);
     gdb_init();
     std::set_terminate(__unhandled_exception_cpp);
     do_global_ctors();
+    esp_boot_timeline_record(BOOT_CP_CTORS_DONE);
     esp_schedule();
     ESP.setDramHeap();
 }
@@ -374,6 +492,10 @@ extern "C" void app_entry_redefinable(void)
     cont_t s_cont __attribute__((aligned(16)));
     g_pcont = &s_cont;
 
+    /* cache is not enabled yet: esp_boot_timeline_record() is IRAM,
+       its storage deliberately in .data (already loaded here) */
+    esp_boot_timeline_record(BOOT_CP_APP_ENTRY);
+
     /* Doing umm_init just once before starting the SDK, allowed us to remove
        test and init calls at each malloc API entry point, saving IRAM. */
 #ifdef UMM_INIT_USE_IRAM
@@ -398,6 +520,12 @@ extern "C" void preinit (void)
     /* does nothing, kept for backward compatibility */
 }
 
+extern "C" void __rtcVarRestore (void) __attribute__((weak));
+extern "C" void __rtcVarRestore (void)
+{
+    /* no-op; overridden by RTCVar.cpp when the sketch uses RTCVar<T> */
+}
+
 extern "C" void __disableWiFiAtBootTime (void) __attribute__((weak));
 extern "C" void __disableWiFiAtBootTime (void)
 {
@@ -645,6 +773,8 @@ extern "C" void ICACHE_FLASH_ATTR user_pre_init(void)
 
 extern "C" void user_init(void) {
 
+    esp_boot_timeline_record(BOOT_CP_USER_INIT);
+
     struct rst_info *rtc_info_ptr = system_get_rst_info();
     memcpy((void *) &resetInfo, (void *) rtc_info_ptr, sizeof(resetInfo));
 
@@ -661,6 +791,8 @@ extern "C" void user_init(void) {
 
     experimental::initFlashQuirks(); // Chip specific flash init.
 
+    esp_boot_timeline_record(BOOT_CP_FLASH_INIT);
+
     cont_init(g_pcont);
 
 #if defined(DEBUG_ESP_HWDT) || defined(DEBUG_ESP_HWDT_NOEXTRA4K)
@@ -681,6 +813,8 @@ extern "C" void user_init(void) {
     preinit(); // Prior to C++ Dynamic Init (not related to above init() ). Meant to be user redefinable.
     __disableWiFiAtBootTime(); // default weak function disables WiFi
 
+    esp_boot_timeline_record(BOOT_CP_PREINIT);
+
     ets_task(loop_task,
         LOOP_TASK_PRIORITY, s_loop_queue,
         LOOP_QUEUE_SIZE);
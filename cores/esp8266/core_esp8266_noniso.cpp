@@ -66,6 +66,70 @@ char * dtostrf(double number, signed char width, unsigned char prec, char *s) {
         number = -number;
     }
 
+    if (number < 1.8e19) {
+        // Fast path: the value fits a uint64_t, so all digits come from
+        // integer arithmetic - one float-to-int conversion for the integer
+        // part and a single multiply for the scaled fraction, instead of a
+        // soft-float multiply/subtract pair per emitted digit.
+        //
+        // Beyond 18 fractional digits a double carries no information
+        // anyway (and 10^19 would overflow the scaling), emit zeros there.
+        const unsigned char fprec = prec > 18 ? 18 : prec;
+        uint64_t scale = 1;
+        for (unsigned char i = 0; i < fprec; ++i) {
+            scale *= 10;
+        }
+
+        uint64_t ipart = (uint64_t)number;
+        // round-half-up at the last requested place, like print(1.999, 2)
+        uint64_t frac = (uint64_t)((number - (double)ipart) * (double)scale + 0.5);
+        if (frac >= scale) {
+            // rounding carried into the integer part (e.g. 1.999 @ prec 2)
+            frac -= scale;
+            ipart++;
+        }
+
+        char digits[20]; // 2^64 has 20 decimal digits
+        int idigits = 0;
+        do {
+            digits[idigits++] = (char)('0' + (char)(ipart % 10));
+            ipart /= 10;
+        } while (ipart);
+
+        // Pad unused cells with spaces
+        fillme -= idigits;
+        while (fillme-- > 0) {
+            *out++ = ' ';
+        }
+
+        // Handle negative sign
+        if (negative) *out++ = '-';
+
+        while (idigits) {
+            *out++ = digits[--idigits];
+        }
+
+        if (prec > 0) {
+            *out++ = '.';
+            // fraction, left-padded with zeros to fprec digits
+            for (unsigned char i = 0; i < fprec; ++i) {
+                digits[i] = (char)('0' + (char)(frac % 10));
+                frac /= 10;
+            }
+            for (unsigned char i = fprec; i > 0; --i) {
+                *out++ = digits[i - 1];
+            }
+            for (unsigned char i = fprec; i < prec; ++i) {
+                *out++ = '0';
+            }
+        }
+
+        *out = 0;
+        return s;
+    }
+
+    // Huge values: keep the historical power-walk algorithm
+
     // Round correctly so that print(1.999, 2) prints as "2.00"
     // I optimized out most of the divisions
     double rounding = 2.0;
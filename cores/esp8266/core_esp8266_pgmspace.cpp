@@ -0,0 +1,150 @@
+/*
+ core_esp8266_pgmspace.cpp - word-at-a-time PROGMEM memory/string routines
+
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+ Flash-mapped memory only supports aligned 32-bit reads; anything else is
+ patched up by the exception handler in core_esp8266_non32xfer.cpp at a cost
+ of well over a hundred cycles per access. The routines below keep every
+ flash access an aligned word load instead, which makes streaming large
+ PROGMEM assets (fonts, certificates, web pages) several times faster than
+ going byte-by-byte. Little-endian byte order is assumed, as on the ESP8266.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pgmspace.h>
+
+extern "C" {
+
+void* memcpy_P_fast(void* dest, PGM_VOID_P src, size_t count) {
+    char* write = (char*)dest;
+    const char* read = (const char*)src;
+
+    // byte loads until the flash source is 32-bit aligned
+    while (count && ((uintptr_t)read & 3)) {
+        *write++ = pgm_read_byte(read++);
+        --count;
+    }
+
+    const uint32_t* readWord = (const uint32_t*)(const void*)read;
+    if (((uintptr_t)write & 3) == 0) {
+        uint32_t* writeWord = (uint32_t*)(void*)write;
+        while (count >= 4) {
+            *writeWord++ = *readWord++;
+            count -= 4;
+        }
+        write = (char*)writeWord;
+    } else {
+        // unaligned RAM stores trap just like flash reads do, so scatter
+        // each word with byte stores instead
+        while (count >= 4) {
+            uint32_t word = *readWord++;
+            write[0] = (char)word;
+            write[1] = (char)(word >> 8);
+            write[2] = (char)(word >> 16);
+            write[3] = (char)(word >> 24);
+            write += 4;
+            count -= 4;
+        }
+    }
+
+    read = (const char*)readWord;
+    while (count--) {
+        *write++ = pgm_read_byte(read++);
+    }
+
+    return dest;
+}
+
+int memcmp_P_fast(const void* buf1, PGM_VOID_P buf2P, size_t size) {
+    const uint8_t* ram = (const uint8_t*)buf1;
+    const char* flash = (const char*)buf2P;
+
+    // byte compares until the flash side is 32-bit aligned
+    while (size && ((uintptr_t)flash & 3)) {
+        uint8_t flashByte = pgm_read_byte(flash);
+        if (*ram != flashByte) {
+            return (int)*ram - (int)flashByte;
+        }
+        ++ram, ++flash, --size;
+    }
+
+    const uint32_t* flashWord = (const uint32_t*)(const void*)flash;
+    if (((uintptr_t)ram & 3) == 0) {
+        const uint32_t* ramWord = (const uint32_t*)(const void*)ram;
+        while (size >= 4 && *ramWord == *flashWord) {
+            ++ramWord, ++flashWord, size -= 4;
+        }
+        ram = (const uint8_t*)ramWord;
+    } else {
+        while (size >= 4) {
+            uint32_t word = *flashWord;
+            if (ram[0] != (uint8_t)word || ram[1] != (uint8_t)(word >> 8)
+                    || ram[2] != (uint8_t)(word >> 16) || ram[3] != (uint8_t)(word >> 24)) {
+                break;
+            }
+            ram += 4, ++flashWord, size -= 4;
+        }
+    }
+    flash = (const char*)flashWord;
+
+    // tail, or locating the byte behind a word mismatch
+    while (size--) {
+        uint8_t flashByte = pgm_read_byte(flash++);
+        if (*ram != flashByte) {
+            return (int)*ram - (int)flashByte;
+        }
+        ++ram;
+    }
+
+    return 0;
+}
+
+size_t strlen_P_fast(PGM_P str) {
+    const char* pos = str;
+
+    while ((uintptr_t)pos & 3) {
+        if (!pgm_read_byte(pos)) {
+            return pos - str;
+        }
+        ++pos;
+    }
+
+    // scan whole words for an embedded zero byte; may read (but never use)
+    // up to three bytes past the terminator, which aligned loads make safe
+    const uint32_t* word = (const uint32_t*)(const void*)pos;
+    for (;;) {
+        uint32_t value = *word;
+        if ((value - 0x01010101ul) & ~value & 0x80808080ul) {
+            pos = (const char*)word;
+            if (!(value & 0x000000FFul)) {
+                return pos - str;
+            }
+            if (!(value & 0x0000FF00ul)) {
+                return pos + 1 - str;
+            }
+            if (!(value & 0x00FF0000ul)) {
+                return pos + 2 - str;
+            }
+            return pos + 3 - str;
+        }
+        ++word;
+    }
+}
+
+};
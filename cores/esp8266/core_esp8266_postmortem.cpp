@@ -33,6 +33,8 @@
 #include "gdb_hooks.h"
 #include "StackThunk.h"
 #include "coredecls.h"
+#include "crash_blackbox.h"
+#include "postmortem_symtab.h"
 
 extern "C" {
 
@@ -55,6 +57,7 @@ static void uart_write_char_d(char c);
 static void uart0_write_char_d(char c);
 static void uart1_write_char_d(char c);
 static void print_stack(uint32_t start, uint32_t end);
+static void print_symbolized_frames(uint32_t epc1, uint32_t start, uint32_t end);
 
 // using numbers different from "REASON_" in user_interface.h (=0..6)
 enum rst_reason_sw
@@ -260,6 +263,10 @@ static void postmortem_report(uint32_t sp_dump) {
 
     ets_printf_P(PSTR("<<<stack<<<\n"));
 
+    // with a registered on-device symbol table (postmortem_symtab.h),
+    // resolve the code addresses on the stack to function-relative frames
+    print_symbolized_frames(rst_info.epc1, sp_dump + offset, stack_end);
+
     // Use cap-X formatting to ensure the standard EspExceptionDecoder doesn't match the address
     if (umm_last_fail_alloc_addr) {
 #if defined(DEBUG_ESP_OOM)
@@ -279,6 +286,9 @@ static void postmortem_report(uint32_t sp_dump) {
         ets_printf_P(PSTR("\nlast failed alloc caller: 0x%08x\n"), (uint32_t)umm_last_fail_alloc_addr);
     }
 
+    // persist the same information into the black box sector, if armed
+    crash_blackbox_record( &rst_info, sp_dump + offset, stack_end );
+
     custom_crash_callback( &rst_info, sp_dump + offset, stack_end );
 
     ets_delay_us(10000);
@@ -298,6 +308,37 @@ static void print_stack(uint32_t start, uint32_t end) {
     }
 }
 
+// A code address on the stack is a potential return address; resolve each
+// against the flash-resident symbol table and print "address: fn#hash+offset"
+// lines the <table>.txt dictionary translates on the host. The build id ties
+// the log to the right dictionary without matching ELFs by hand.
+static void print_symbolized_frames(uint32_t epc1, uint32_t start, uint32_t end) {
+    if (!postmortem_symtab_build_id()) {
+        return;
+    }
+
+    ets_printf_P(PSTR("\n>>>frames>>> build-id %08x\n"), postmortem_symtab_build_id());
+
+    uint32_t name_hash, fn_offset;
+    if (epc1 && postmortem_symtab_lookup(epc1, &name_hash, &fn_offset)) {
+        ets_printf_P(PSTR("epc1=0x%08x: fn#%08x+0x%x\n"), epc1, name_hash, fn_offset);
+    }
+
+    int frames = 0;
+    for (uint32_t pos = start; pos < end && frames < 32; pos += 4) {
+        const uint32_t value = *(uint32_t*)pos;
+        // executable ranges only: IRAM and mapped flash
+        const bool code = (value >= 0x40100000 && value < 0x40110000) ||
+                          (value >= 0x40200000 && value < 0x40300000);
+        if (code && postmortem_symtab_lookup(value, &name_hash, &fn_offset)) {
+            ets_printf_P(PSTR("0x%08x: fn#%08x+0x%x\n"), value, name_hash, fn_offset);
+            frames++;
+        }
+    }
+
+    ets_printf_P(PSTR("<<<frames<<<\n"));
+}
+
 static void IRAM_ATTR uart_write_char_d(char c) {
     uart0_write_char_d(c);
     uart1_write_char_d(c);
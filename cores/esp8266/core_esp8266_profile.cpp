@@ -0,0 +1,69 @@
+/*
+ core_esp8266_profile.cpp - cycle-accurate scoped profiler, reporting side
+
+ Copyright (c) 2025 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifdef ESP_PROFILE
+
+#include "core_esp8266_profile.h"
+#include <Print.h>
+
+profile_site_t* profile_sites_head = nullptr;
+
+void profile_print(Print& out)
+{
+    const uint32_t cpuMHz = esp_get_cpu_freq_mhz();
+
+    out.printf_P(PSTR("%-28s %10s %12s %12s %12s %10s\n"),
+        "site", "hits", "min cy", "max cy", "avg cy", "avg us");
+    for (profile_site_t* site = profile_sites_head; site; site = site->next)
+    {
+        // Snapshot with interrupts off so an ISR site can't tear mid-read
+        uint32_t savedPS = xt_rsil(15);
+        uint32_t hits = site->hits;
+        uint32_t cyMin = site->cycles_min;
+        uint32_t cyMax = site->cycles_max;
+        uint64_t cyTotal = site->cycles_total;
+        xt_wsr_ps(savedPS);
+
+        if (!hits)
+        {
+            out.printf_P(PSTR("%-28s %10u\n"), site->name, 0);
+            continue;
+        }
+        uint32_t cyAvg = (uint32_t)(cyTotal / hits);
+        out.printf_P(PSTR("%-28s %10u %12u %12u %12u %10u\n"),
+            site->name, hits, cyMin, cyMax, cyAvg, cyAvg / cpuMHz);
+    }
+}
+
+void profile_reset()
+{
+    for (profile_site_t* site = profile_sites_head; site; site = site->next)
+    {
+        uint32_t savedPS = xt_rsil(15);
+        site->hits = 0;
+        site->cycles_min = 0;
+        site->cycles_max = 0;
+        site->cycles_total = 0;
+        xt_wsr_ps(savedPS);
+    }
+}
+
+#endif // ESP_PROFILE
@@ -0,0 +1,118 @@
+/*
+ core_esp8266_profile.h - cycle-accurate scoped profiler
+
+ Copyright (c) 2025 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+ Drop PROFILE_SCOPE("name") at the top of a scope to accumulate
+ hits/min/max/total cycle counts for it in a static per-site slot. Sites
+ self-register in a linked list on first execution, so there is no central
+ table to maintain; profile_print(Print&) dumps every site seen so far and
+ profile_reset() zeroes the counters.
+
+ The whole facility compiles away unless the build defines -DESP_PROFILE.
+ The measurement path is inline pointer/counter arithmetic with no calls,
+ so PROFILE_SCOPE is safe in IRAM ISRs.
+*/
+
+#ifndef CORE_ESP8266_PROFILE_H
+#define CORE_ESP8266_PROFILE_H
+
+#include <stdint.h>
+#include "core_esp8266_features.h"
+
+class Print;
+
+#ifdef ESP_PROFILE
+
+struct profile_site_t
+{
+    const char*     name;
+    uint32_t        hits;
+    uint32_t        cycles_min;
+    uint32_t        cycles_max;
+    uint64_t        cycles_total;
+    profile_site_t* next;
+    bool            linked;
+};
+
+extern profile_site_t* profile_sites_head;
+
+// Dump all sites seen so far: hits, min/max/avg cycles and microseconds.
+void profile_print(Print& out);
+// Zero the counters of every registered site (sites stay registered).
+void profile_reset();
+
+class ProfileScope
+{
+public:
+    ProfileScope(profile_site_t* site)
+    {
+        _site = site;
+        if (!site->linked)
+        {
+            uint32_t savedPS = xt_rsil(15);
+            if (!site->linked)
+            {
+                site->next = profile_sites_head;
+                profile_sites_head = site;
+                site->linked = true;
+            }
+            xt_wsr_ps(savedPS);
+        }
+        _start = esp_get_cycle_count();
+    }
+
+    ~ProfileScope()
+    {
+        uint32_t delta = esp_get_cycle_count() - _start;
+        uint32_t savedPS = xt_rsil(15);
+        _site->hits++;
+        _site->cycles_total += delta;
+        if (_site->hits == 1 || delta < _site->cycles_min)
+        {
+            _site->cycles_min = delta;
+        }
+        if (delta > _site->cycles_max)
+        {
+            _site->cycles_max = delta;
+        }
+        xt_wsr_ps(savedPS);
+    }
+
+private:
+    profile_site_t* _site;
+    uint32_t        _start;
+};
+
+#define _PROFILE_CONCAT2(a, b) a##b
+#define _PROFILE_CONCAT(a, b) _PROFILE_CONCAT2(a, b)
+#define PROFILE_SCOPE(name_literal) \
+    static profile_site_t _PROFILE_CONCAT(_profile_site_, __LINE__) = \
+        { name_literal, 0, 0, 0, 0, nullptr, false }; \
+    ProfileScope _PROFILE_CONCAT(_profile_scope_, __LINE__)(&_PROFILE_CONCAT(_profile_site_, __LINE__))
+
+#else // !ESP_PROFILE
+
+#define PROFILE_SCOPE(name_literal)
+
+static inline void profile_print(Print&) {}
+static inline void profile_reset() {}
+
+#endif // ESP_PROFILE
+
+#endif // CORE_ESP8266_PROFILE_H
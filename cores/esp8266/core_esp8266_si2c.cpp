@@ -23,6 +23,7 @@
 #include "pins_arduino.h"
 #include "wiring_private.h"
 #include "PolledTimeout.h"
+#include "Schedule.h"
 
 extern "C"
 {
@@ -172,6 +173,29 @@ private:
     // Generate a clock "valley" (at the end of a segment, just before a repeated start)
     void twi_scl_valley(void);
 
+    // Asynchronous master transfer, advanced one byte per slice from the
+    // scheduled-function queue (see startAsync()).  The bus pauses between
+    // slices with SCL high and SDA static, which no device can mistake for
+    // a START or STOP condition.
+    enum AsyncState : uint8_t
+    {
+        ASYNC_IDLE = 0,
+        ASYNC_ADDR,
+        ASYNC_DATA,
+        ASYNC_STOP
+    };
+    volatile uint8_t async_state    = ASYNC_IDLE;
+    unsigned char    async_addr     = 0;
+    unsigned char*   async_buf      = nullptr;
+    unsigned int     async_len      = 0;
+    unsigned int     async_pos      = 0;
+    bool             async_read     = false;
+    bool             async_sendStop = true;
+    void (*async_done)(uint8_t)     = nullptr;
+
+    bool asyncStep();
+    void asyncFinish(uint8_t status);
+
 public:
     void           setClock(unsigned int freq);
     void           setClockStretchLimit(uint32_t limit);
@@ -181,6 +205,12 @@ public:
                            unsigned char sendStop);
     unsigned char  readFrom(unsigned char address, unsigned char* buf, unsigned int len,
                             unsigned char sendStop);
+    unsigned char  startAsync(unsigned char address, unsigned char* buf, unsigned int len,
+                              unsigned char sendStop, bool read, void (*done)(uint8_t));
+    bool           asyncBusy()
+    {
+        return async_state != ASYNC_IDLE;
+    }
     uint8_t        status();
     uint8_t        transmit(const uint8_t* data, uint8_t length);
     void           attachSlaveRxEvent(void (*function)(uint8_t*, size_t));
@@ -365,6 +395,10 @@ unsigned char Twi::writeTo(unsigned char address, unsigned char* buf, unsigned i
                            unsigned char sendStop)
 {
     unsigned int i;
+    if (asyncBusy())
+    {
+        return 4;  // line busy (async transfer in progress)
+    }
     if (!write_start())
     {
         return 4;  // line busy
@@ -411,6 +445,10 @@ unsigned char Twi::readFrom(unsigned char address, unsigned char* buf, unsigned
                             unsigned char sendStop)
 {
     unsigned int i;
+    if (asyncBusy())
+    {
+        return 4;  // line busy (async transfer in progress)
+    }
     if (!write_start())
     {
         return 4;  // line busy
@@ -447,6 +485,115 @@ unsigned char Twi::readFrom(unsigned char address, unsigned char* buf, unsigned
     return 0;
 }
 
+// Queue an asynchronous master transfer.  Returns 0 when accepted; the
+// final status (same codes as writeTo/readFrom) is delivered through
+// `done` once the transfer completes.  Each scheduled slice costs one
+// byte time on the wire (~90 us at 100 kHz) instead of busy-waiting the
+// whole transfer, and the slices run from the scheduled-function queue
+// during yield()/loop turnaround.
+unsigned char Twi::startAsync(unsigned char address, unsigned char* buf, unsigned int len,
+                              unsigned char sendStop, bool read, void (*done)(uint8_t))
+{
+    if (asyncBusy() || twi_state != TWI_READY || len == 0 || buf == nullptr)
+    {
+        return 4;  // line busy
+    }
+
+    async_addr     = address;
+    async_buf      = buf;
+    async_len      = len;
+    async_pos      = 0;
+    async_read     = read;
+    async_sendStop = sendStop != 0;
+    async_done     = done;
+    async_state    = ASYNC_ADDR;
+
+    if (!schedule_recurrent_function_us([this]() { return asyncStep(); }, 0))
+    {
+        async_state = ASYNC_IDLE;
+        return 4;
+    }
+    return 0;
+}
+
+void Twi::asyncFinish(uint8_t status)
+{
+    async_state = ASYNC_IDLE;
+    if (async_done)
+    {
+        async_done(status);
+    }
+}
+
+// One slice of the async state machine; returns true to stay scheduled.
+bool Twi::asyncStep()
+{
+    switch (async_state)
+    {
+    case ASYNC_ADDR:
+        if (!write_start())
+        {
+            asyncFinish(4);  // line busy
+            return false;
+        }
+        if (!write_byte(((async_addr << 1) | (async_read ? 1 : 0)) & 0xFF))
+        {
+            if (async_sendStop)
+            {
+                write_stop();
+            }
+            asyncFinish(2);  // received NACK on transmit of address
+            return false;
+        }
+        async_state = ASYNC_DATA;
+        return true;
+
+    case ASYNC_DATA:
+        if (async_read)
+        {
+            async_buf[async_pos] = read_byte(async_pos + 1 == async_len);
+        }
+        else if (!write_byte(async_buf[async_pos]))
+        {
+            if (async_sendStop)
+            {
+                write_stop();
+            }
+            asyncFinish(3);  // received NACK on transmit of data
+            return false;
+        }
+        if (++async_pos < async_len)
+        {
+            return true;
+        }
+        async_state = ASYNC_STOP;
+        return true;
+
+    case ASYNC_STOP:
+    {
+        if (async_sendStop)
+        {
+            write_stop();
+        }
+        else
+        {
+            twi_scl_valley();
+        }
+        unsigned int i = 0;
+        while (!SDA_READ(twi_sda) && (i++) < 10)
+        {
+            twi_scl_valley();
+            busywait(twi_dcount);
+        }
+        asyncFinish(0);
+        return false;
+    }
+
+    default:
+        return false;
+    }
+}
+
 void Twi::twi_scl_valley(void)
 {
     SCL_LOW(twi_scl);
@@ -1039,6 +1186,23 @@ extern "C"
         return twi.readFrom(address, buf, len, sendStop);
     }
 
+    uint8_t twi_writeToAsync(unsigned char address, unsigned char* buf, unsigned int len,
+                             unsigned char sendStop, void (*done)(uint8_t))
+    {
+        return twi.startAsync(address, buf, len, sendStop, false, done);
+    }
+
+    uint8_t twi_readFromAsync(unsigned char address, unsigned char* buf, unsigned int len,
+                              unsigned char sendStop, void (*done)(uint8_t))
+    {
+        return twi.startAsync(address, buf, len, sendStop, true, done);
+    }
+
+    bool twi_asyncBusy(void)
+    {
+        return twi.asyncBusy();
+    }
+
     uint8_t twi_status()
     {
         return twi.status();
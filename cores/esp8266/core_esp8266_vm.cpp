@@ -144,7 +144,12 @@ typedef enum { sio = 0, dio = 1 } iotype;
 
 constexpr int read_delay = (hspi_mode == dio) ? 4-1 : 0;
 
-constexpr int cache_ways = 4;   // N-way, fully associative cache
+// Raise with -DMMU_EXTERNAL_CACHE_WAYS=<n> to trade DRAM (68 bytes/way) for
+// a better hit rate when the VM heap holds frequently-walked structures.
+#ifndef MMU_EXTERNAL_CACHE_WAYS
+#define MMU_EXTERNAL_CACHE_WAYS 4
+#endif
+constexpr int cache_ways = MMU_EXTERNAL_CACHE_WAYS; // N-way, fully associative cache
 constexpr int cache_words = 16; // Must be 16 words or smaller to fit in SPI buffer
 
 static struct cache_line {
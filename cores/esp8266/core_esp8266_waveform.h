@@ -110,6 +110,32 @@ int stopWaveform(uint8_t pin);
 // Make sure the CB function has the IRAM_ATTR decorator.
 void setTimer1Callback(uint32_t (*fn)());
 
+// One-shot deadline slots sharing timer1 with the waveform generator,
+// giving sketches microsecond-resolution callbacks that coexist with PWM
+// and tone() instead of fighting for the peripheral.  The callback runs in
+// NMI context: it must have the IRAM_ATTR decorator, touch nothing in
+// flash, finish in a few microseconds, and must not call back into this
+// API (re-arm from main code instead).  A small fixed number of slots is
+// available; timer1_schedule_us() returns false when all are armed or cb
+// is NULL.  Actual dispatch resolution is subject to NMI service latency,
+// and to how long other edges scheduled in the same interrupt take.
+// Default (PWM locked) generator only: with the phase-locked generator
+// these calls fail and return false.
+typedef void (*timer1_user_cb_t)(void);
+bool timer1_schedule_us(timer1_user_cb_t cb, uint32_t us);
+
+// Disarm all pending slots holding the given callback.  Best effort: a
+// deadline reached meanwhile may still fire.  Returns true if at least one
+// slot was disarmed.
+bool timer1_unschedule(timer1_user_cb_t cb);
+
+
+// Jitter self-measurement, default (PWM locked) generator only.
+// When enabled, the NMI records per pin the worst-case delay, in CPU clock
+// cycles, between an edge's scheduled time and its actual service time.
+// Enabling (or re-enabling) clears all recorded maxima.
+void waveformEnableLatencyStats(bool enable);
+uint32_t waveformGetMaxLatencyCycles(uint8_t pin);
 
 // Internal-only calls, not for applications
 extern void _setPWMFreq(uint32_t freq);
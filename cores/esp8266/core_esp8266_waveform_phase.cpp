@@ -145,6 +145,20 @@ void setTimer1Callback_weak(uint32_t (*fn)()) {
   }
 }
 
+// The phase-locked generator has no deadline-slot dispatcher (see the
+// default generator in core_esp8266_waveform_pwm.cpp); report failure so
+// callers can fall back to setTimer1Callback() or polling.
+bool timer1_schedule_us_weak(timer1_user_cb_t cb, uint32_t us) {
+  (void) cb;
+  (void) us;
+  return false;
+}
+
+bool timer1_unschedule_weak(timer1_user_cb_t cb) {
+  (void) cb;
+  return false;
+}
+
 // Start up a waveform on a pin, or change the current one.  Will change to the new
 // waveform smoothly on next low->high transition.  For immediate change, stopWaveform()
 // first, then it will immediately begin.
@@ -44,6 +44,7 @@
 #include "ets_sys.h"
 #include "core_esp8266_waveform.h"
 #include "user_interface.h"
+#include "interrupts.h"
 
 
 extern "C" {
@@ -60,6 +61,15 @@ typedef struct {
   uint32_t desiredHighCycles;  // Ideal waveform period to drive the error signal
   uint32_t desiredLowCycles;   //
   uint32_t lastEdge;           // Cycle when this generator last changed
+
+  // Per-pin change mailbox.  Set by main code, consumed and cleared in the
+  // NMI at this pin's own period boundary, so a duty update on one pin
+  // never touches the generation state of any other.
+  uint32_t nextHighCycles;
+  uint32_t nextLowCycles;
+  volatile uint32_t hasPending;     // 1 = nextHigh/LowCycles waiting to be applied
+
+  uint32_t serviceLatencyMax;  // Worst observed service delay, see waveformGetMaxLatencyCycles()
 } Waveform;
 
 class WVFState {
@@ -72,9 +82,7 @@ public:
   uint32_t waveformToEnable = 0;  // Message to the NMI handler to start a waveform on a inactive pin
   uint32_t waveformToDisable = 0; // Message to the NMI handler to disable a pin from waveform generation
 
-  uint32_t waveformToChange = 0; // Mask of pin to change. One bit set in main app, cleared when effected in the NMI
-  uint32_t waveformNewHigh = 0;
-  uint32_t waveformNewLow = 0;
+  bool latencyMeasure = false;    // Track per-pin worst-case service latency in the NMI
 
   uint32_t (*timer1CB)() = NULL;
 
@@ -142,11 +150,31 @@ static PWMState pwmState;
 static uint32_t _pwmFreq = 1000;
 static uint32_t _pwmPeriod = microsecondsToClockCycles(1000000UL) / _pwmFreq;
 
+// One-shot user deadline slots, serviced by the same NMI that drives the
+// waveform edges so a high-resolution user callback coexists with PWM
+// instead of competing for the timer1 peripheral.  A slot is armed by main
+// code (callback pointer written last) and freed by the NMI when it fires.
+typedef struct {
+  uint32_t targetCycle;           // ESP cycle counter deadline
+  volatile timer1_user_cb_t cb;   // non-null = armed
+} Timer1Slot;
+
+constexpr int maxTimer1Slots = 4;
+static Timer1Slot timer1Slots[maxTimer1Slots];
+
+static IRAM_ATTR bool timer1SlotsArmed() {
+  for (auto i = 0; i < maxTimer1Slots; i++) {
+    if (timer1Slots[i].cb) {
+      return true;
+    }
+  }
+  return false;
+}
 
 // If there are no more scheduled activities, shut down Timer 1.
 // Otherwise, do nothing.
 static IRAM_ATTR void disableIdleTimer() {
- if (timerRunning && !wvfState.waveformEnabled && !pwmState.cnt && !wvfState.timer1CB) {
+ if (timerRunning && !wvfState.waveformEnabled && !pwmState.cnt && !wvfState.timer1CB && !timer1SlotsArmed()) {
     ETS_FRC_TIMER1_NMI_INTR_ATTACH(NULL);
     timer1_disable();
     timer1_isr_init();
@@ -371,15 +399,17 @@ int startWaveformClockCycles_weak(uint8_t pin, uint32_t timeHighCycles, uint32_t
   uint32_t mask = 1<<pin;
   MEMBARRIER();
   if (wvfState.waveformEnabled & mask) {
-    // Make sure no waveform changes are waiting to be applied
-    while (wvfState.waveformToChange) {
+    // Make sure no change is still waiting to be applied on this pin.
+    // Changes pending on other pins are none of our business, their
+    // mailboxes are independent.
+    while (wave->hasPending) {
       esp_yield(); // Wait for waveform to update
       MEMBARRIER();
     }
-    wvfState.waveformNewHigh = timeHighCycles;
-    wvfState.waveformNewLow = timeLowCycles;
+    wave->nextHighCycles = timeHighCycles;
+    wave->nextLowCycles = timeLowCycles;
     MEMBARRIER();
-    wvfState.waveformToChange = mask;
+    wave->hasPending = 1;
     // The waveform will be updated some time in the future on the next period for the signal
   } else { //  if (!(wvfState.waveformEnabled & mask)) {
     wave->timeHighCycles = timeHighCycles;
@@ -387,6 +417,8 @@ int startWaveformClockCycles_weak(uint8_t pin, uint32_t timeHighCycles, uint32_t
     wave->timeLowCycles = timeLowCycles;
     wave->desiredLowCycles = timeLowCycles;
     wave->lastEdge = 0;
+    wave->hasPending = 0;
+    wave->serviceLatencyMax = 0;
     wave->nextServiceCycle = ESP.getCycleCount() + microsecondsToClockCycles(1);
     wvfState.waveformToEnable |= mask;
     MEMBARRIER();
@@ -414,6 +446,23 @@ int startWaveform(uint8_t pin, uint32_t timeHighUS, uint32_t timeLowUS, uint32_t
     microsecondsToClockCycles(runTimeUS), alignPhase, microsecondsToClockCycles(phaseOffsetUS), autoPwm);
 }
 
+// Jitter self-measurement.  When enabled, the NMI records per pin the worst
+// delay between a scheduled edge and its actual service time.
+void waveformEnableLatencyStats(bool enable) {
+  for (auto i = 0; i < 17; i++) {
+    wvfState.waveform[i].serviceLatencyMax = 0;
+  }
+  MEMBARRIER();
+  wvfState.latencyMeasure = enable;
+}
+
+uint32_t waveformGetMaxLatencyCycles(uint8_t pin) {
+  if (pin > 16) {
+    return 0;
+  }
+  return wvfState.waveform[pin].serviceLatencyMax;
+}
+
 // Set a callback.  Pass in NULL to stop it
 extern void setTimer1Callback_weak(uint32_t (*fn)()) __attribute__((weak));
 void setTimer1Callback_weak(uint32_t (*fn)()) {
@@ -429,6 +478,61 @@ void setTimer1Callback(uint32_t (*fn)()) {
   setTimer1Callback_bound(fn);
 }
 
+// Claim a free deadline slot and arm it.  The interrupt lock only guards
+// against a concurrent claimer; the NMI itself never allocates slots, it
+// only clears fired ones, which can at worst re-open a slot we skipped.
+extern bool timer1_schedule_us_weak(timer1_user_cb_t cb, uint32_t us) __attribute__((weak));
+bool timer1_schedule_us_weak(timer1_user_cb_t cb, uint32_t us) {
+  if (!cb) {
+    return false;
+  }
+  uint32_t target = ESP.getCycleCount() + microsecondsToClockCycles(us);
+  {
+    esp8266::InterruptLock lockAllInterruptsInThisScope;
+    int i;
+    for (i = 0; i < maxTimer1Slots; i++) {
+      if (!timer1Slots[i].cb) {
+        break;
+      }
+    }
+    if (i == maxTimer1Slots) {
+      return false; // All slots armed
+    }
+    timer1Slots[i].targetCycle = target;
+    MEMBARRIER();
+    timer1Slots[i].cb = cb; // Arming last: from here the NMI may fire it
+  }
+  initTimer();
+  forceTimerInterrupt(); // Have the NMI pick up the (possibly earlier) deadline
+  return true;
+}
+static bool timer1_schedule_us_bound(timer1_user_cb_t cb, uint32_t us) __attribute__((weakref("timer1_schedule_us_weak")));
+bool timer1_schedule_us(timer1_user_cb_t cb, uint32_t us) {
+  return timer1_schedule_us_bound(cb, us);
+}
+
+// Disarm every slot holding the given callback.  Best effort: a deadline
+// reached while this runs may still fire before the slot is cleared.
+extern bool timer1_unschedule_weak(timer1_user_cb_t cb) __attribute__((weak));
+bool timer1_unschedule_weak(timer1_user_cb_t cb) {
+  bool found = false;
+  {
+    esp8266::InterruptLock lockAllInterruptsInThisScope;
+    for (auto i = 0; i < maxTimer1Slots; i++) {
+      if (timer1Slots[i].cb == cb) {
+        timer1Slots[i].cb = nullptr;
+        found = true;
+      }
+    }
+  }
+  disableIdleTimer();
+  return found;
+}
+static bool timer1_unschedule_bound(timer1_user_cb_t cb) __attribute__((weakref("timer1_unschedule_weak")));
+bool timer1_unschedule(timer1_user_cb_t cb) {
+  return timer1_unschedule_bound(cb);
+}
+
 // Stops a waveform on a pin
 extern int stopWaveform_weak(uint8_t pin) __attribute__((weak));
 IRAM_ATTR int stopWaveform_weak(uint8_t pin) {
@@ -441,10 +545,9 @@ IRAM_ATTR int stopWaveform_weak(uint8_t pin) {
   uint32_t mask = 1<<pin;
   if (wvfState.waveformEnabled & mask) {
     wvfState.waveformToDisable = mask;
-    // Cancel any pending updates for this waveform, too.
-    if (wvfState.waveformToChange & mask) {
-        wvfState.waveformToChange = 0;
-    }
+    // Cancel any pending update for this waveform, too.  Other pins'
+    // mailboxes are left alone.
+    wvfState.waveform[pin].hasPending = 0;
     forceTimerInterrupt();
     while (wvfState.waveformToDisable) {
       MEMBARRIER(); // If it wasn't written yet, it has to be by now
@@ -596,6 +699,13 @@ static IRAM_ATTR void timer1Interrupt() {
           uint32_t nextEdgeCycles;
           uint32_t desired = 0;
           uint32_t *timeToUpdate;
+          if (wvfState.latencyMeasure) {
+            // How late this edge was serviced, worst case per pin
+            uint32_t late = (uint32_t)-cyclesToGo;
+            if (late > wave->serviceLatencyMax) {
+              wave->serviceLatencyMax = late;
+            }
+          }
           wvfState.waveformState ^= mask;
           if (wvfState.waveformState & mask) {
             if (i == 16) {
@@ -603,14 +713,14 @@ static IRAM_ATTR void timer1Interrupt() {
             }
             GPOS = mask;
 
-            if (wvfState.waveformToChange & mask) {
-              // Copy over next full-cycle timings
-              wave->timeHighCycles = wvfState.waveformNewHigh;
-              wave->desiredHighCycles = wvfState.waveformNewHigh;
-              wave->timeLowCycles = wvfState.waveformNewLow;
-              wave->desiredLowCycles = wvfState.waveformNewLow;
+            if (wave->hasPending) {
+              // Copy over next full-cycle timings from this pin's mailbox
+              wave->timeHighCycles = wave->nextHighCycles;
+              wave->desiredHighCycles = wave->nextHighCycles;
+              wave->timeLowCycles = wave->nextLowCycles;
+              wave->desiredLowCycles = wave->nextLowCycles;
               wave->lastEdge = 0;
-              wvfState.waveformToChange = 0;
+              wave->hasPending = 0;
             }
             if (wave->lastEdge) {
               desired = wave->desiredLowCycles;
@@ -649,6 +759,24 @@ static IRAM_ATTR void timer1Interrupt() {
     } while (!done);
   } // if (wvfState.waveformEnabled)
 
+  // User deadline slots: fire the due ones, fold the earliest pending one
+  // into the next-event computation.  With only a handful of slots a scan
+  // with earliest() is cheaper in the NMI than keeping them sorted.
+  for (auto i = 0; i < maxTimer1Slots; i++) {
+    timer1_user_cb_t cb = timer1Slots[i].cb;
+    if (!cb) {
+      continue;
+    }
+    int32_t slotToGo = timer1Slots[i].targetCycle - GetCycleCountIRQ();
+    if (slotToGo <= 0) {
+      // One-shot: free the slot before the call
+      timer1Slots[i].cb = nullptr;
+      cb();
+    } else {
+      nextEventCycle = earliest(nextEventCycle, timer1Slots[i].targetCycle);
+    }
+  }
+
   if (wvfState.timer1CB) {
     nextEventCycle = earliest(nextEventCycle, GetCycleCountIRQ() + wvfState.timer1CB());
   }
@@ -30,6 +30,8 @@ extern "C" {
 static os_timer_t micros_overflow_timer;
 static uint32_t micros_at_last_overflow_tick = 0;
 static uint32_t micros_overflow_count = 0;
+static uint32_t cycles_at_last_overflow_tick = 0;
+static uint32_t cycles_overflow_count = 0;
 #define ONCE 0
 #define REPEAT 1
 
@@ -47,6 +49,12 @@ void micros_overflow_tick(void* arg) {
     if(m < micros_at_last_overflow_tick)
         ++micros_overflow_count;
     micros_at_last_overflow_tick = m;
+    // ccount wraps every ~53.7s at 80MHz (~26.8s at 160MHz), hence the
+    // tick cadence in init() is well below that, not the usec one (~71min)
+    uint32_t c = esp_get_cycle_count();
+    if(c < cycles_at_last_overflow_tick)
+        ++cycles_overflow_count;
+    cycles_at_last_overflow_tick = c;
 }
 
 //---------------------------------------------------------------------------
@@ -181,6 +189,14 @@ unsigned long IRAM_ATTR micros() {
     return system_get_time();
 }
 
+uint64_t IRAM_ATTR esp_get_cycle_count64() {
+    uint32_t high32 = cycles_overflow_count;
+    uint32_t low32 = esp_get_cycle_count();
+    if (low32 < cycles_at_last_overflow_tick)
+        ++high32;
+    return (uint64_t)high32 << 32 | low32;
+}
+
 uint64_t IRAM_ATTR micros64() {
     uint32_t low32_us = system_get_time();
     uint32_t high32_us = micros_overflow_count + ((low32_us < micros_at_last_overflow_tick) ? 1 : 0);
@@ -196,7 +212,8 @@ void init() {
     initPins();
     timer1_isr_init();
     os_timer_setfn(&micros_overflow_timer, (os_timer_func_t*) &micros_overflow_tick, 0);
-    os_timer_arm(&micros_overflow_timer, 60000, REPEAT);
+    // must beat the fastest ccount wrap (~26.8s at 160MHz), see the tick
+    os_timer_arm(&micros_overflow_timer, 13000, REPEAT);
 }
 
 };
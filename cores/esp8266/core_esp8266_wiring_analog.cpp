@@ -25,6 +25,7 @@
 #include "wiring_private.h"
 #include "pins_arduino.h"
 #include "user_interface.h"
+#include "Schedule.h"
 
 extern "C" {
 
@@ -51,4 +52,104 @@ void __analogReference(uint8_t mode)
 
 extern void analogReference(uint8_t mode) __attribute__ ((weak, alias("__analogReference")));
 
+
+/*
+  Continuous acquisition: timer1 paces the conversions, the ISR fills one of
+  two ping-pong buffers, and every completed buffer is handed to the user
+  callback from the scheduled-function queue so processing happens in batches
+  outside interrupt context.
+
+  Claims timer1 for itself, like Tone/Servo/analogWrite do — don't mix them.
+  WiFi activity can add jitter to individual conversions; for clean traces
+  sample with the modem idle or off.
+*/
+
+static struct
+{
+    uint16_t* buf[2];
+    size_t    len;
+    size_t    pos;
+    uint8_t   filling;             // buffer the isr writes to
+    volatile uint8_t  ready;       // buffer waiting for the callback
+    volatile bool     buffer_ready;
+    volatile bool     overrun;     // callback too slow, a buffer was reused
+    bool      running;
+    void (*cb)(uint16_t*, size_t);
+} _adc_cont = { {NULL, NULL}, 0, 0, 0, 0, false, false, false, NULL };
+
+static void IRAM_ATTR _adc_sample_isr()
+{
+    _adc_cont.buf[_adc_cont.filling][_adc_cont.pos++] = system_adc_read();
+    if (_adc_cont.pos >= _adc_cont.len) {
+        if (_adc_cont.buffer_ready) {
+            // consumer has not taken the previous buffer yet; overwrite it
+            _adc_cont.overrun = true;
+        }
+        _adc_cont.ready = _adc_cont.filling;
+        _adc_cont.buffer_ready = true;
+        _adc_cont.filling ^= 1;
+        _adc_cont.pos = 0;
+    }
+}
+
+bool analogSamplingStart(uint32_t rate_hz, size_t buffer_len, void (*cb)(uint16_t* samples, size_t count))
+{
+    if (_adc_cont.running || !rate_hz || !buffer_len || !cb) {
+        return false;
+    }
+
+    // timer1 runs from the /16 prescaler (5 MHz); the 23-bit counter caps
+    // the slowest usable rate at ~0.6 Hz, the ADC itself the fastest
+    uint32_t ticks = (F_CPU / 16) / rate_hz;
+    if (ticks == 0 || ticks > 0x7FFFFF) {
+        return false;
+    }
+
+    uint16_t* storage = (uint16_t*)malloc(2 * buffer_len * sizeof(uint16_t));
+    if (!storage) {
+        return false;
+    }
+
+    _adc_cont.buf[0] = storage;
+    _adc_cont.buf[1] = storage + buffer_len;
+    _adc_cont.len = buffer_len;
+    _adc_cont.pos = 0;
+    _adc_cont.filling = 0;
+    _adc_cont.buffer_ready = false;
+    _adc_cont.overrun = false;
+    _adc_cont.cb = cb;
+    _adc_cont.running = true;
+
+    // drain completed buffers outside interrupt context
+    schedule_recurrent_function_us([]() {
+        if (!_adc_cont.running) {
+            return false;  // unschedule
+        }
+        if (_adc_cont.buffer_ready) {
+            uint16_t* done = _adc_cont.buf[_adc_cont.ready];
+            _adc_cont.buffer_ready = false;
+            _adc_cont.cb(done, _adc_cont.len);
+        }
+        return true;
+    }, 0);
+
+    timer1_isr_init();
+    timer1_attachInterrupt(_adc_sample_isr);
+    timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
+    timer1_write(ticks);
+    return true;
+}
+
+void analogSamplingStop(void)
+{
+    if (!_adc_cont.running) {
+        return;
+    }
+    timer1_disable();
+    timer1_detachInterrupt();
+    _adc_cont.running = false;  // the drain function unschedules itself
+    free(_adc_cont.buf[0]);
+    _adc_cont.buf[0] = _adc_cont.buf[1] = NULL;
+}
+
 };
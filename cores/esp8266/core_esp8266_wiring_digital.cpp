@@ -27,6 +27,9 @@
 #include "user_interface.h"
 #include "core_esp8266_waveform.h"
 #include "interrupts.h"
+#include "GpioEvents.h"
+#include "spsc_ringbuf.h"
+#include <new>
 
 extern "C" {
 
@@ -131,6 +134,12 @@ typedef struct {
 static interrupt_handler_t interrupt_handlers[16] = { {0, 0, 0, 0}, };
 static uint32_t interrupt_reg = 0;
 
+// capture mode (GpioEvents.h): pins whose edges are recorded instead of
+// dispatched, and the ring the ISR appends to (allocated by begin())
+static uint32_t capture_reg = 0;
+static spsc_ringbuf<GpioEvent>* capture_ring = nullptr;
+static uint32_t capture_overflows = 0;
+
 void IRAM_ATTR interrupt_handler(void *arg, void *frame)
 {
   (void) arg;
@@ -138,6 +147,11 @@ void IRAM_ATTR interrupt_handler(void *arg, void *frame)
   uint32_t status = GPIE;
   GPIEC = status;//clear them interrupts
   uint32_t levels = GPI;
+  if (status & capture_reg) {
+    // record and move on - no per-pin dispatch for captured pins
+    if (!capture_ring->push({status & capture_reg, levels, esp_get_cycle_count()}))
+      ++capture_overflows;
+  }
   if(status == 0 || interrupt_reg == 0) return;
   ETS_GPIO_INTR_DISABLE();
   int i = 0;
@@ -205,6 +219,7 @@ extern void __attachInterruptFunctionalArg(uint8_t pin, voidFuncPtrArg userFunc,
     ETS_GPIO_INTR_DISABLE();
     set_interrupt_handlers(pin, (voidFuncPtr)userFunc, arg, mode, functional);
     interrupt_reg |= (1 << pin);
+    capture_reg &= ~(1 << pin); // a callback attach takes the pin back from capture mode
     GPC(pin) &= ~(0xF << GPCI);//INT mode disabled
     GPIEC = (1 << pin); //Clear Interrupt for this pin
     GPC(pin) |= ((mode & 0xF) << GPCI);//INT mode "mode"
@@ -226,13 +241,105 @@ extern void IRAM_ATTR __detachInterrupt(uint8_t pin) {
         GPIEC = (1 << pin); //Clear Interrupt for this pin
         interrupt_reg &= ~(1 << pin);
 		set_interrupt_handlers(pin, nullptr, nullptr, 0, false);
-        if (interrupt_reg)
+        if (interrupt_reg || capture_reg)
         {
             ETS_GPIO_INTR_ENABLE();
         }
     }
 }
 
+extern bool gpio_capture_begin(uint32_t pinMask, int mode, size_t minEvents)
+{
+  pinMask &= 0xFFFF;
+  if (!pinMask)
+    return false;
+
+  ETS_GPIO_INTR_DISABLE();
+
+  // replace the ring when the requested capacity changed
+  if (capture_ring && capture_ring->size() != spsc_ringbuf<GpioEvent>::roundup(minEvents))
+  {
+    delete capture_ring;
+    capture_ring = nullptr;
+  }
+  if (!capture_ring)
+  {
+    capture_ring = new (std::nothrow) spsc_ringbuf<GpioEvent>(minEvents);
+    if (!capture_ring || !capture_ring->valid())
+    {
+      delete capture_ring;
+      capture_ring = nullptr;
+      if (interrupt_reg)
+        ETS_GPIO_INTR_ENABLE();
+      return false;
+    }
+  }
+
+  for (uint8_t pin = 0; pin < 16; ++pin)
+  {
+    const uint32_t bit = 1 << pin;
+    if ((capture_reg & bit) && !(pinMask & bit))
+    {
+      GPC(pin) &= ~(0xF << GPCI); //INT mode disabled
+    }
+    if (pinMask & bit)
+    {
+      if (interrupt_reg & bit)
+      {
+        // capture replaces a previously attached callback, like re-attaching does
+        interrupt_reg &= ~bit;
+        set_interrupt_handlers(pin, nullptr, nullptr, 0, false);
+      }
+      GPC(pin) &= ~(0xF << GPCI); //INT mode disabled
+      GPIEC = bit; //Clear Interrupt for this pin
+      GPC(pin) |= ((mode & 0xF) << GPCI); //INT mode "mode"
+    }
+  }
+
+  capture_overflows = 0;
+  capture_reg = pinMask;
+  ETS_GPIO_INTR_ATTACH(interrupt_handler, &interrupt_reg);
+  ETS_GPIO_INTR_ENABLE();
+  return true;
+}
+
+extern void gpio_capture_end(void)
+{
+  ETS_GPIO_INTR_DISABLE();
+  for (uint8_t pin = 0; pin < 16; ++pin)
+  {
+    const uint32_t bit = 1 << pin;
+    if (capture_reg & bit)
+    {
+      GPC(pin) &= ~(0xF << GPCI); //INT mode disabled
+      GPIEC = bit; //Clear Interrupt for this pin
+    }
+  }
+  capture_reg = 0;
+  delete capture_ring;
+  capture_ring = nullptr;
+  if (interrupt_reg)
+  {
+    ETS_GPIO_INTR_ENABLE();
+  }
+}
+
+extern bool gpio_capture_read(GpioEvent* event)
+{
+  return capture_ring && event && capture_ring->pop(*event);
+}
+
+extern size_t gpio_capture_available(void)
+{
+  return capture_ring ? capture_ring->available() : 0;
+}
+
+extern uint32_t gpio_capture_overflows(void)
+{
+  return capture_overflows;
+}
+
+
 extern void __attachInterrupt(uint8_t pin, voidFuncPtr userFunc, int mode)
 {
     __attachInterruptFunctionalArg(pin, (voidFuncPtrArg)userFunc, 0, mode, false);
@@ -263,3 +370,5 @@ extern void attachInterruptArg(uint8_t pin, voidFuncPtrArg handler, void* arg, i
 extern void detachInterrupt(uint8_t pin) __attribute__ ((weak, alias("__detachInterrupt")));
 
 };
+
+GpioEventRecorder gpioEvents;
@@ -21,6 +21,7 @@
 #include <limits.h>
 #include "wiring_private.h"
 #include "pins_arduino.h"
+#include "Schedule.h"
 
 extern "C" {
 
@@ -55,4 +56,144 @@ unsigned long pulseInLong(uint8_t pin, uint8_t state, unsigned long timeout)
     return pulseIn(pin, state, timeout);
 }
 
+/*
+    Asynchronous pulse measurement: instead of busy-waiting like pulseIn(),
+    each armed pin gets a CHANGE interrupt whose handler timestamps the
+    leading and trailing edge with the cycle counter.  Several pins measure
+    concurrently (e.g. an ultrasonic sensor array in one echo window) while
+    the sketch keeps running; results are polled with pulseInAsyncDone()/
+    pulseInAsyncResult() or delivered through a scheduled callback.
+*/
+
+enum {
+    PULSE_IDLE = 0,    // not armed
+    PULSE_WAIT_START,  // armed, waiting for the leading edge
+    PULSE_IN_PULSE,    // leading edge seen, waiting for the trailing edge
+    PULSE_DONE,        // width captured
+};
+
+typedef struct {
+    uint32_t armCycles;
+    uint32_t startCycles;
+    uint32_t timeoutCycles;
+    volatile uint32_t widthCycles;
+    pulse_complete_cb_t callback;
+    uint8_t pin;
+    uint8_t state;
+    volatile uint8_t phase;
+} pulse_capture_t;
+
+static pulse_capture_t pulse_captures[16];
+
+// runs on the cont stack via schedule_function: hand out completed widths
+static void pulse_deliver_callbacks()
+{
+    for (int pin = 0; pin < 16; ++pin) {
+        pulse_capture_t* pc = &pulse_captures[pin];
+        if (pc->phase == PULSE_DONE && pc->callback) {
+            pulse_complete_cb_t cb = pc->callback;
+            pc->callback = NULL;  // deliver once
+            cb(pin, clockCyclesToMicroseconds(pc->widthCycles));
+        }
+    }
+}
+
+static void IRAM_ATTR pulse_capture_isr(void* arg)
+{
+    pulse_capture_t* pc = (pulse_capture_t*)arg;
+    const uint32_t now = xthal_get_ccount();
+    const uint8_t level = (GPI >> pc->pin) & 1;
+    if (pc->phase == PULSE_WAIT_START) {
+        if (level == pc->state) {
+            pc->startCycles = now;
+            pc->phase = PULSE_IN_PULSE;
+        }
+    } else if (pc->phase == PULSE_IN_PULSE) {
+        if (level != pc->state) {
+            pc->widthCycles = now - pc->startCycles;
+            pc->phase = PULSE_DONE;
+            if (pc->callback) {
+                // stateless function pointer: no allocation, ISR-safe
+                schedule_function(pulse_deliver_callbacks);
+            }
+        }
+    }
+}
+
+// lazily retire a measurement whose timeout has passed without a pulse
+static bool pulse_check_timeout(pulse_capture_t* pc)
+{
+    if (xthal_get_ccount() - pc->armCycles <= pc->timeoutCycles) {
+        return false;
+    }
+    detachInterrupt(pc->pin);
+    pc->widthCycles = 0;
+    pc->phase = PULSE_IDLE;
+    return true;
+}
+
+bool pulseInAsyncStart(uint8_t pin, uint8_t state, unsigned long timeout, pulse_complete_cb_t callback)
+{
+    if (pin >= 16) {
+        return false;
+    }
+    const uint32_t max_timeout_us = clockCyclesToMicroseconds(UINT_MAX);
+    if (timeout > max_timeout_us) {
+        timeout = max_timeout_us;
+    }
+    pulse_capture_t* pc = &pulse_captures[pin];
+    pc->pin = pin;
+    pc->state = state ? 1 : 0;
+    pc->timeoutCycles = microsecondsToClockCycles(timeout);
+    pc->widthCycles = 0;
+    pc->callback = callback;
+    pc->phase = PULSE_WAIT_START;
+    pc->armCycles = xthal_get_ccount();
+    attachInterruptArg(pin, pulse_capture_isr, pc, CHANGE);
+    return true;
+}
+
+bool pulseInAsyncDone(uint8_t pin)
+{
+    if (pin >= 16) {
+        return true;
+    }
+    pulse_capture_t* pc = &pulse_captures[pin];
+    switch (pc->phase) {
+    case PULSE_WAIT_START:
+    case PULSE_IN_PULSE:
+        return pulse_check_timeout(pc);
+    default:
+        return true;
+    }
+}
+
+unsigned long pulseInAsyncResult(uint8_t pin)
+{
+    if (pin >= 16 || !pulseInAsyncDone(pin)) {
+        return 0;
+    }
+    pulse_capture_t* pc = &pulse_captures[pin];
+    if (pc->phase != PULSE_DONE) {
+        return 0;  // timed out or never armed
+    }
+    detachInterrupt(pin);
+    pc->phase = PULSE_IDLE;
+    pc->callback = NULL;
+    return clockCyclesToMicroseconds(pc->widthCycles);
+}
+
+void pulseInAsyncStop(uint8_t pin)
+{
+    if (pin >= 16) {
+        return;
+    }
+    pulse_capture_t* pc = &pulse_captures[pin];
+    if (pc->phase != PULSE_IDLE) {
+        detachInterrupt(pin);
+        pc->phase = PULSE_IDLE;
+        pc->callback = NULL;
+    }
+}
+
 };
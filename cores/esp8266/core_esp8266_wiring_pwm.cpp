@@ -32,6 +32,31 @@ static int32_t analogScale = 255;  // Match upstream default, breaking change fr
 static uint32_t analogMap = 0;
 static uint16_t analogFreq = 1000;
 
+// Per-pin frequency domains: a pin given its own domain via analogWriteFreqPin()
+// leaves the shared PWM machine (whose single period follows analogWriteFreq()
+// for every pin) and is generated by the general waveform engine at its own
+// period and duty range. The duty -> clock-cycle conversion is folded into a
+// fixed-point scale at configuration time, so each analogWrite() on a domain
+// pin is one multiply and shift with no division and no interaction with the
+// other pins' settings.
+//
+// Worst-case NMI load: each domain pin costs two timer1 wakeups per period
+// (one per edge, roughly a microsecond of service time each), against one
+// shared wakeup per edge set for all pins on the shared machine. Budget about
+// 2 * freq per domain pin - e.g. a 25 kHz fan pin adds ~50k wakeups/s - and
+// keep the aggregate across domain pins well below ~100k wakeups/s, or WiFi
+// and sketch code will noticeably starve.
+
+#define PWM_DOMAIN_DUTY_SHIFT 10
+
+struct pwm_domain_t {
+  uint32_t periodCcys;
+  uint32_t dutyScaleFp;  // (periodCcys << PWM_DOMAIN_DUTY_SHIFT) / range
+  uint32_t range;
+};
+static pwm_domain_t pwmDomain[17];
+static uint32_t pwmDomainMap = 0;
+
 extern void __analogWriteFreq(uint32_t freq) {
   if (freq < 100) {
     analogFreq = 100;
@@ -43,6 +68,46 @@ extern void __analogWriteFreq(uint32_t freq) {
   _setPWMFreq(freq);
 }
 
+extern void __analogWriteFreqPin(uint8_t pin, uint32_t freq, uint32_t range) {
+  if (pin > 16) {
+    return;
+  }
+  if (freq == 0) {
+    // return the pin to the shared machine; the next analogWrite() restarts
+    // it there with the analogWriteFreq()/analogWriteRange() settings
+    if (pwmDomainMap & (1UL << pin)) {
+      pwmDomainMap &= ~(1UL << pin);
+      if (analogMap & (1UL << pin)) {
+        stopWaveform(pin);
+        analogMap &= ~(1UL << pin);
+      }
+    }
+    return;
+  }
+  if (freq < 100) {
+    freq = 100;
+  } else if (freq > 60000) {
+    freq = 60000;
+  }
+  if (range < 15) {
+    range = 15;
+  } else if (range > 65535) {
+    range = 65535;
+  }
+  uint32_t periodCcys = microsecondsToClockCycles(1000000UL) / freq;
+  pwmDomain[pin].periodCcys = periodCcys;
+  pwmDomain[pin].dutyScaleFp = (periodCcys << PWM_DOMAIN_DUTY_SHIFT) / range;
+  pwmDomain[pin].range = range;
+  if (!(pwmDomainMap & (1UL << pin)) && (analogMap & (1UL << pin))) {
+    // migrate off the shared machine so the next write restarts the pin in
+    // its own domain instead of latching into the shared period
+    _stopPWM(pin);
+    stopWaveform(pin);
+    analogMap &= ~(1UL << pin);
+  }
+  pwmDomainMap |= (1UL << pin);
+}
+
 extern void __analogWrite(uint8_t pin, int val) {
   analogWriteMode(pin, val, false);
 }
@@ -52,10 +117,15 @@ extern void __analogWriteMode(uint8_t pin, int val, bool openDrain) {
     return;
   }
   uint32_t analogPeriod = microsecondsToClockCycles(1000000UL) / analogFreq;
+  int32_t scale = analogScale;
+  if (pwmDomainMap & (1UL << pin)) {
+    analogPeriod = pwmDomain[pin].periodCcys;
+    scale = pwmDomain[pin].range;
+  }
   if (val < 0) {
     val = 0;
-  } else if (val > analogScale) {
-    val = analogScale;
+  } else if (val > scale) {
+    val = scale;
   }
 
   if (analogMap & 1UL << pin) {
@@ -72,10 +142,22 @@ extern void __analogWriteMode(uint8_t pin, int val, bool openDrain) {
       pinMode(pin, OUTPUT);
     }
   }
+  if (pwmDomainMap & (1UL << pin)) {
+    // domain pin: precomputed fixed-point duty scale, no division per write,
+    // never phase locked (a different period cannot align to the shared set)
+    uint32_t high = (val == (int)pwmDomain[pin].range)
+                        ? analogPeriod
+                        : (((uint32_t)val * pwmDomain[pin].dutyScaleFp) >> PWM_DOMAIN_DUTY_SHIFT);
+    if (startWaveformClockCycles(pin, high, analogPeriod - high, 0, -1, 0, true)) {
+      analogMap |= (1 << pin);
+    }
+    return;
+  }
   uint32_t high = (analogPeriod * val) / analogScale;
   uint32_t low = analogPeriod - high;
   // Find the first GPIO being generated by checking GCC's find-first-set (returns 1 + the bit of the first 1 in an int32_t)
-  int phaseReference = __builtin_ffs(analogMap) - 1;
+  // (domain pins run their own periods and must not serve as phase reference)
+  int phaseReference = __builtin_ffs(analogMap & ~pwmDomainMap) - 1;
   if (_setPWM(pin, val, analogScale)) {
     analogMap |= (1 << pin);
   } else if (startWaveformClockCycles(pin, high, low, 0, phaseReference, 0, true)) {
@@ -98,6 +180,7 @@ extern void __analogWriteResolution(int res) {
 extern void analogWrite(uint8_t pin, int val) __attribute__((weak, alias("__analogWrite")));
 extern void analogWriteMode(uint8_t pin, int val, bool openDrain) __attribute__((weak, alias("__analogWriteMode")));
 extern void analogWriteFreq(uint32_t freq) __attribute__((weak, alias("__analogWriteFreq")));
+extern void analogWriteFreqPin(uint8_t pin, uint32_t freq, uint32_t range) __attribute__((weak, alias("__analogWriteFreqPin")));
 extern void analogWriteRange(uint32_t range) __attribute__((weak, alias("__analogWriteRange")));
 extern void analogWriteResolution(int res) __attribute__((weak, alias("__analogWriteResolution")));
 
@@ -18,16 +18,82 @@ void esp_suspend();
 void esp_delay(unsigned long ms);
 void esp_schedule();
 void esp_yield();
+// Opt-in fast path for yield()/esp_yield()/delay(0): skip the CONT<->SYS
+// stack switch when SYS ran within the last interval_us and no one-shot
+// scheduled functions are pending. Trades up to interval_us of added
+// latency for pending SDK work against ~10us per coalesced call; 0
+// (default) restores the unconditional switch.
+void esp_set_yield_coalescing(uint32_t interval_us);
 void tune_timeshift64 (uint64_t now_us);
 bool sntp_set_timezone_in_seconds(int32_t timezone);
 
+// SNTP poll cadence: polling (re)starts at initial_ms and doubles after
+// every successful synchronisation up to max_ms.  initial_ms is clamped to
+// the RFC minimum of 15s; equal values give a fixed cadence; 0/0 restores
+// the 1h default.  The core now owns the lwIP
+// sntp_update_delay_MS_rfc_not_less_than_15000() hook - sketches that used
+// to redefine that function should call this setter instead.
+void sntp_set_poll_interval(uint32_t initial_ms, uint32_t max_ms);
+
+// SNTP slew: once synchronised, offsets of up to max_step_us are corrected
+// gradually at slew_rate_ppm (0: default 500ppm) by tuning the micros64()
+// offset instead of stepping the clock, keeping wall time monotonic for
+// interval measurements and log correlation.  Larger offsets, the initial
+// synchronisation and manual settimeofday() still step.  max_step_us 0
+// (default) disables slewing.
+void sntp_set_slew(uint32_t max_step_us, uint32_t slew_rate_ppm);
+
 void disable_extra4k_at_link_time (void) __attribute__((noinline));
 void enable_wifi_enterprise_patch(void) __attribute__((noinline));
 void __disableWiFiAtBootTime (void) __attribute__((noinline));
+void __rtcVarRestore (void); // weak no-op, strong in RTCVar.cpp
 void __real_system_restart_local() __attribute__((noreturn));
 
 uint32_t sqrt32(uint32_t n);
 
+// Loop-latency statistics, only implemented when built with -DESP_LOOP_STATS;
+// use through EspClass::getLoopStats() / resetLoopStats()
+void esp_loop_stats_get(uint32_t* iterations, uint32_t* max_cycles, uint32_t* histogram32);
+void esp_loop_stats_reset(void);
+
+// Boot timeline: cycle-count checkpoints recorded along the boot path in
+// core_esp8266_main.cpp; use through EspClass::getBootTimeline()
+enum esp_boot_checkpoint {
+    BOOT_CP_APP_ENTRY = 0,  // first C code after ROM/bootloader
+    BOOT_CP_USER_INIT,      // SDK handed control to the core
+    BOOT_CP_FLASH_INIT,     // flash config and chip quirk setup applied
+    BOOT_CP_PREINIT,        // preinit() done, loop task registered
+    BOOT_CP_SDK_DONE,       // SDK init (incl. phy init / RF cal) finished
+    BOOT_CP_CTORS_DONE,     // C++ global constructors finished
+    BOOT_CP_SETUP,          // setup() entered
+    BOOT_CP_SETUP_DONE,     // setup() returned, loop() starts
+    BOOT_CP_COUNT
+};
+void esp_boot_timeline_record(int checkpoint);
+void esp_boot_timeline_get(uint32_t cycles[/*BOOT_CP_COUNT*/]);
+
+// Light-sleep governor idle hook, called once per loop_wrapper() pass;
+// use through EspClass::autoLightSleep()
+void esp_auto_light_sleep_idle(void);
+
+// Entropy pool idle hook, called once per loop_wrapper() pass to harvest a
+// hardware RNG word; use through EspClass::randomBytes()
+void esp_entropy_pool_stir(void);
+
+// Registration PC of the most recently started scheduled function, kept by
+// Schedule.cpp for the crash black box (crash_blackbox.h)
+extern uint32_t scheduled_fn_last_pc;
+
+// Cooperative-slicing support for CooperativeSection (below): the cycle
+// count at the last CONT resume, and the give-way primitive - yield()
+// where suspending is legal, a soft watchdog feed where it is not
+uint32_t esp_cycles_at_resume(void);
+void esp_cooperative_slice(void);
+
+// Checkpoints that arrived at two budgets or later, all sections
+// combined; per-section counts via CooperativeSection::overruns()
+extern uint32_t esp_cooperative_overruns;
+
 #ifdef __cplusplus
 }
 
@@ -42,6 +108,21 @@ void settimeofday_cb (BoolCB&& cb);
 void settimeofday_cb (const BoolCB& cb);
 void settimeofday_cb (const TrivialCB& cb);
 
+// Measured state of the latest SNTP synchronisation, see sntp_sync_cb()
+struct sntp_sync_info_t
+{
+    int64_t offset_us;  // server time minus local clock at synchronisation
+    int32_t drift_ppm;  // offset over the interval since the previous sync (0 on the first)
+    bool stepped;       // true: clock was stepped, false: offset is being slewed
+};
+
+using SntpSyncCB = std::function<void(const sntp_sync_info_t&)>;
+
+// Called (scheduled, loop context) after every SNTP synchronisation with the
+// measured offset and drift - unlike settimeofday_cb(), which also fires on
+// manual settimeofday() and carries no measurements.
+void sntp_sync_cb (const SntpSyncCB& cb);
+
 // This overload of esp_suspend() performs the blocked callback whenever it is resumed,
 // and if that returns true, it immediately suspends again.
 template <typename T>
@@ -78,4 +159,59 @@ inline void esp_delay(const uint32_t timeout_ms, T&& blocked) {
     esp_delay(timeout_ms, std::forward<T>(blocked), timeout_ms);
 }
 
+// Cycle-budgeted slicing guard for long operations (filesystem GC, OTA
+// erase/write loops, TLS handshakes) - the work that used to hand-roll
+// optimistic_yield()/delay(0) calls or, worse, forget them and trip the
+// soft watchdog.  Construct one per operation and call checkpoint() at
+// every safe point.  The fast path is a cycle-counter read and a
+// compare; only once the budget since the last yield (by anyone, see
+// esp_cycles_at_resume()) is spent does it give way: yield() in CONT, a
+// soft watchdog feed in SYS where suspending is impossible, so the
+// watchdog stays quiet either way.  A checkpoint arriving at two
+// budgets or later means the gap between the caller's safe points is
+// itself too long; that is counted per section and in the global
+// esp_cooperative_overruns tally, so the offending subsystem shows up
+// in telemetry instead of in a WDT reset.
+class CooperativeSection
+{
+public:
+    explicit CooperativeSection(uint32_t budget_us = 10000)
+        : _budgetCycles(budget_us * esp_get_cpu_freq_mhz()), _lastSlice(esp_get_cycle_count())
+    {
+    }
+
+    void checkpoint()
+    {
+        // measure from the later of the last CONT resume and our own
+        // last slice (the latter matters when slicing cannot suspend)
+        uint32_t base = esp_cycles_at_resume();
+        if ((int32_t)(_lastSlice - base) > 0)
+        {
+            base = _lastSlice;
+        }
+        const uint32_t elapsed = esp_get_cycle_count() - base;
+        if (elapsed < _budgetCycles)
+        {
+            return;
+        }
+        if (elapsed >= 2 * _budgetCycles)
+        {
+            _overruns++;
+            esp_cooperative_overruns++;
+        }
+        esp_cooperative_slice();
+        _lastSlice = esp_get_cycle_count();
+    }
+
+    uint32_t overruns() const
+    {
+        return _overruns;
+    }
+
+private:
+    const uint32_t _budgetCycles;
+    uint32_t _lastSlice;
+    uint32_t _overruns = 0;
+};
+
 #endif // __cplusplus
@@ -0,0 +1,235 @@
+/*
+ crash_blackbox.cpp - flash-persisted crash dump ("black box")
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <string.h>
+
+#include "crash_blackbox.h"
+#include "coredecls.h"
+#include "user_interface.h"
+#include <spi_flash.h>
+
+extern "C" {
+
+// From UMM, the last caller of a malloc/realloc/calloc which failed
+// (the same externs the postmortem report prints):
+extern void *umm_last_fail_alloc_addr;
+extern int umm_last_fail_alloc_size;
+extern size_t umm_free_heap_size_lw(void);
+
+static uint32_t s_blackbox_addr = 0;
+
+// stack words fitting in the reserved sector after the header
+#define BLACKBOX_STACK_CAPACITY ((SPI_FLASH_SEC_SIZE - sizeof(crash_blackbox_frame_t)) / 4)
+
+static uint32_t frame_crc(const crash_blackbox_frame_t* h, const uint32_t* stack)
+{
+    uint32_t crc = crc32(&h->reason,
+                         sizeof(*h) - offsetof(crash_blackbox_frame_t, reason));
+    return crc32(stack, h->stack_words * 4, crc);
+}
+
+#if defined(DEBUG_ESP_HWDT) || defined(DEBUG_ESP_HWDT_NOEXTRA4K)
+
+// A hardware-WDT reset is handled before the SDK starts, where the flash
+// API is off limits; the frame is staged into .noinit RAM (which, like the
+// stack being dumped, survives the reset) and committed by
+// crash_blackbox_enable() once the sketch is running again.
+
+#ifndef CRASH_BLACKBOX_HWDT_WORDS
+#define CRASH_BLACKBOX_HWDT_WORDS 256
+#endif
+
+static struct
+{
+    crash_blackbox_frame_t header;
+    uint32_t stack[CRASH_BLACKBOX_HWDT_WORDS];
+} s_hwdt_stage __attribute__((section(".noinit")));
+
+void crash_blackbox_stage_hwdt(const void* sp, const void* stack_end)
+{
+    crash_blackbox_frame_t* h = &s_hwdt_stage.header;
+    memset(h, 0, sizeof(*h));
+    h->magic = CRASH_BLACKBOX_MAGIC;
+    h->reason = CRASH_BLACKBOX_REASON_HWDT;
+    h->sp = (uint32_t)sp;
+    h->stack_end = (uint32_t)stack_end;
+    // DRAM still holds the pre-reset globals at this point
+    h->oom_addr = (uint32_t)umm_last_fail_alloc_addr;
+    h->oom_size = umm_last_fail_alloc_size;
+    h->sched_pc = scheduled_fn_last_pc;
+    uint32_t words = 0;
+    if ((uint32_t)stack_end > (uint32_t)sp)
+    {
+        words = ((uint32_t)stack_end - (uint32_t)sp) / 4;
+    }
+    if (words > CRASH_BLACKBOX_HWDT_WORDS)
+    {
+        words = CRASH_BLACKBOX_HWDT_WORDS;
+    }
+    h->stack_words = words;
+    memcpy(s_hwdt_stage.stack, sp, words * 4);
+    h->crc = frame_crc(h, s_hwdt_stage.stack);
+}
+
+static void commit_staged_hwdt(void)
+{
+    crash_blackbox_frame_t* h = &s_hwdt_stage.header;
+    if (h->magic != CRASH_BLACKBOX_MAGIC
+        || h->stack_words > CRASH_BLACKBOX_HWDT_WORDS
+        || h->crc != frame_crc(h, s_hwdt_stage.stack))
+    {
+        return;
+    }
+    spi_flash_erase_sector(s_blackbox_addr / SPI_FLASH_SEC_SIZE);
+    spi_flash_write(s_blackbox_addr, (uint32_t*)h, sizeof(*h));
+    if (h->stack_words)
+    {
+        spi_flash_write(s_blackbox_addr + sizeof(*h), s_hwdt_stage.stack,
+                        h->stack_words * 4);
+    }
+    h->magic = 0; // committed once
+}
+
+#endif // DEBUG_ESP_HWDT || DEBUG_ESP_HWDT_NOEXTRA4K
+
+bool crash_blackbox_enable(uint32_t flashAddress)
+{
+    if (!flashAddress || (flashAddress & (SPI_FLASH_SEC_SIZE - 1)))
+    {
+        return false;
+    }
+    s_blackbox_addr = flashAddress;
+#if defined(DEBUG_ESP_HWDT) || defined(DEBUG_ESP_HWDT_NOEXTRA4K)
+    commit_staged_hwdt();
+#endif
+    return true;
+}
+
+void crash_blackbox_disable(void)
+{
+    s_blackbox_addr = 0;
+}
+
+void crash_blackbox_clear(void)
+{
+    if (s_blackbox_addr)
+    {
+        spi_flash_erase_sector(s_blackbox_addr / SPI_FLASH_SEC_SIZE);
+    }
+}
+
+// Crash context. The SDK flash API remains usable here - the postmortem
+// report itself calls into the SDK - and the stack excerpt is written
+// straight from RAM, so no sector-sized staging buffer is needed.
+void crash_blackbox_record(struct rst_info* rst, uint32_t sp, uint32_t stack_end)
+{
+    if (!s_blackbox_addr)
+    {
+        return;
+    }
+    crash_blackbox_frame_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = CRASH_BLACKBOX_MAGIC;
+    h.reason = rst->reason;
+    h.exccause = rst->exccause;
+    h.epc1 = rst->epc1;
+    h.epc2 = rst->epc2;
+    h.epc3 = rst->epc3;
+    h.excvaddr = rst->excvaddr;
+    h.depc = rst->depc;
+    h.sp = sp;
+    h.stack_end = stack_end;
+    h.free_heap = umm_free_heap_size_lw();
+    h.oom_addr = (uint32_t)umm_last_fail_alloc_addr;
+    h.oom_size = umm_last_fail_alloc_size;
+    h.sched_pc = scheduled_fn_last_pc;
+    uint32_t words = stack_end > sp ? (stack_end - sp) / 4 : 0;
+    if (words > BLACKBOX_STACK_CAPACITY)
+    {
+        words = BLACKBOX_STACK_CAPACITY;
+    }
+    h.stack_words = words;
+    h.crc = frame_crc(&h, (const uint32_t*)sp);
+
+    spi_flash_erase_sector(s_blackbox_addr / SPI_FLASH_SEC_SIZE);
+    spi_flash_write(s_blackbox_addr, (uint32_t*)&h, sizeof(h));
+    if (words)
+    {
+        spi_flash_write(s_blackbox_addr + sizeof(h), (uint32_t*)sp, words * 4);
+    }
+}
+
+bool crash_blackbox_check(crash_blackbox_frame_t* header)
+{
+    if (!s_blackbox_addr || !header)
+    {
+        return false;
+    }
+    if (spi_flash_read(s_blackbox_addr, (uint32_t*)header, sizeof(*header))
+        != SPI_FLASH_RESULT_OK)
+    {
+        return false;
+    }
+    if (header->magic != CRASH_BLACKBOX_MAGIC
+        || header->stack_words > BLACKBOX_STACK_CAPACITY)
+    {
+        return false;
+    }
+    // stream the stack excerpt through a small buffer to verify the crc
+    uint32_t crc = crc32(&header->reason,
+                         sizeof(*header) - offsetof(crash_blackbox_frame_t, reason));
+    uint32_t buf[64];
+    uint32_t addr = s_blackbox_addr + sizeof(*header);
+    uint32_t left = header->stack_words;
+    while (left)
+    {
+        uint32_t n = left > 64 ? 64 : left;
+        if (spi_flash_read(addr, buf, n * 4) != SPI_FLASH_RESULT_OK)
+        {
+            return false;
+        }
+        crc = crc32(buf, n * 4, crc);
+        addr += n * 4;
+        left -= n;
+    }
+    return crc == header->crc;
+}
+
+size_t crash_blackbox_read(crash_blackbox_frame_t* header, uint32_t* stack, size_t maxWords)
+{
+    if (!crash_blackbox_check(header))
+    {
+        return 0;
+    }
+    if (!stack || !maxWords)
+    {
+        return 0;
+    }
+    size_t words = maxWords < header->stack_words ? maxWords : header->stack_words;
+    if (spi_flash_read(s_blackbox_addr + sizeof(*header), stack, words * 4)
+        != SPI_FLASH_RESULT_OK)
+    {
+        return 0;
+    }
+    return words;
+}
+
+} // extern "C"
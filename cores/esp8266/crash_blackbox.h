@@ -0,0 +1,100 @@
+/*
+ crash_blackbox.h - flash-persisted crash dump ("black box")
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+ The postmortem report is printed to the UART and lost when no terminal is
+ attached.  When armed with a reserved flash sector, the black box persists
+ a compact binary frame of the same information at crash time: exception
+ frame, a stack excerpt, heap state and the last scheduled-function PC.
+ The frame survives the reboot and can be read back by the sketch, e.g.
+ via ESP.getCrashDump(), and shipped over the network.
+*/
+
+#ifndef CRASH_BLACKBOX_H
+#define CRASH_BLACKBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRASH_BLACKBOX_MAGIC 0x58304242u  // "BB0X"
+
+// reason code beyond the SDK rst_info values (0..6) and the postmortem
+// REASON_USER_* range: frame captured by the hwdt_app_entry stack dump
+#define CRASH_BLACKBOX_REASON_HWDT 250
+
+typedef struct crash_blackbox_frame
+{
+    uint32_t magic;        // CRASH_BLACKBOX_MAGIC
+    uint32_t crc;          // crc32 from 'reason' through the last stack word
+    uint32_t reason;       // rst_info reason or CRASH_BLACKBOX_REASON_*
+    uint32_t exccause;
+    uint32_t epc1;
+    uint32_t epc2;
+    uint32_t epc3;
+    uint32_t excvaddr;
+    uint32_t depc;
+    uint32_t sp;           // RAM address the stack excerpt was taken from
+    uint32_t stack_end;
+    uint32_t free_heap;    // free heap at crash time
+    uint32_t oom_addr;     // last failed allocation caller, 0 if none
+    int32_t  oom_size;
+    uint32_t sched_pc;     // registration PC of the last started scheduled function
+    uint32_t stack_words;  // uint32 count of the stack excerpt following this header
+} crash_blackbox_frame_t;
+
+// Arm the black box with a sector-aligned flash byte address the application
+// has reserved (one SPI_FLASH_SEC_SIZE sector, outside the sketch, the
+// filesystem and the EEPROM/RFCAL sectors).  Must be called before reading
+// the dump back as well.  Returns false on a misaligned or null address.
+bool crash_blackbox_enable(uint32_t flashAddress);
+void crash_blackbox_disable(void);
+
+// Erase the persisted frame.
+void crash_blackbox_clear(void);
+
+// Validate and read back the persisted header; returns false when no valid
+// frame is present.
+bool crash_blackbox_check(crash_blackbox_frame_t* header);
+
+// Fill the header and copy up to maxWords words of the persisted stack
+// excerpt; returns the word count copied.
+size_t crash_blackbox_read(crash_blackbox_frame_t* header, uint32_t* stack, size_t maxWords);
+
+// Crash-context writer, called from the postmortem report - not an API for
+// sketches.
+struct rst_info;
+void crash_blackbox_record(struct rst_info* rst, uint32_t sp, uint32_t stack_end);
+
+#if defined(DEBUG_ESP_HWDT) || defined(DEBUG_ESP_HWDT_NOEXTRA4K)
+// Pre-SDK hardware-WDT capture: stages the frame into a .noinit RAM buffer
+// (flash writes are not safe that early); crash_blackbox_enable() commits it
+// to the sector on the following boot.
+void crash_blackbox_stage_hwdt(const void* sp, const void* stack_end);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRASH_BLACKBOX_H
@@ -29,24 +29,62 @@ extern "C" {
 #include "spi_flash.h"
 }
 
+#include <coredecls.h> // crc32()
+
+static flash_hal_stats_t s_stats = {};
+static uint32_t s_statsSector = 0;   // 0 = persistence disabled
+static uint32_t s_statsSeq = 0;
+
+// One slicing guard for all flash traffic: every HAL call is a safe
+// point, so long filesystem operations (SPIFFS_gc above all) yield on
+// budget instead of per call
+static CooperativeSection s_slice(10000);
+
+// bucket n holds [2^n, 2^(n+1)) us; the last bucket is open-ended
+static void stats_latency(uint32_t *hist, uint32_t us) {
+    uint32_t bucket = 0;
+    while (us > 1 && bucket < FLASH_HAL_STATS_LAT_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    hist[bucket]++;
+}
+
+static void stats_count_erase(uint32_t addr) {
+    const uint32_t fsStart = FS_PHYS_ADDR;
+    const uint32_t fsSize = FS_PHYS_SIZE;
+    uint32_t region = FLASH_HAL_STATS_REGIONS; // the "outside FS" slot
+    if (fsSize && addr - fsStart < fsSize) {
+        // fsSize < 16MB, so the product fits 32 bits
+        region = (addr - fsStart) * FLASH_HAL_STATS_REGIONS / fsSize;
+    }
+    s_stats.eraseCount[region]++;
+}
+
 int32_t flash_hal_read(uint32_t addr, uint32_t size, uint8_t *dst) {
-    optimistic_yield(10000);
+    s_slice.checkpoint();
 
     // We use flashRead overload that handles proper alignment
+    const uint32_t start = micros();
     if (ESP.flashRead(addr, dst, size)) {
+        stats_latency(s_stats.readLatency, micros() - start);
         return FLASH_HAL_OK;
     } else {
+        s_stats.readErrors++;
         return FLASH_HAL_READ_ERROR;
     }
 }
 
 int32_t flash_hal_write(uint32_t addr, uint32_t size, const uint8_t *src) {
-    optimistic_yield(10000);
+    s_slice.checkpoint();
 
     // We use flashWrite overload that handles proper alignment
+    const uint32_t start = micros();
     if (ESP.flashWrite(addr, src, size)) {
+        stats_latency(s_stats.writeLatency, micros() - start);
         return FLASH_HAL_OK;
     } else {
+        s_stats.writeErrors++;
         return FLASH_HAL_WRITE_ERROR;
     }
 }
@@ -60,15 +98,110 @@ int32_t flash_hal_erase(uint32_t addr, uint32_t size) {
     const uint32_t sector = addr / SPI_FLASH_SEC_SIZE;
     const uint32_t sectorCount = size / SPI_FLASH_SEC_SIZE;
     for (uint32_t i = 0; i < sectorCount; ++i) {
-        optimistic_yield(10000);
+        s_slice.checkpoint();
         if (!ESP.flashEraseSector(sector + i)) {
             DEBUGV("_spif_erase addr=%x size=%d i=%d\r\n", addr, size, i);
+            s_stats.eraseErrors++;
             return FLASH_HAL_ERASE_ERROR;
         }
+        stats_count_erase((sector + i) * SPI_FLASH_SEC_SIZE);
+    }
+    return FLASH_HAL_OK;
+}
+
+/*
+  Persistence: the reserved sector is used as a journal of fixed
+  256-byte (one flash page) records, appended in sequence.  Only after
+  all 16 slots are used is the sector erased, so the stats sector wears
+  16x slower than a rewrite-in-place scheme would.  The commit path
+  talks to ESP.flash* directly: accounting its own traffic would
+  slowly inflate the numbers it reports.
+*/
+
+struct stats_record_s {
+    uint32_t magic;
+    uint32_t seq;
+    flash_hal_stats_t stats;
+    uint32_t crc; // over magic..stats
+};
+
+static constexpr uint32_t kStatsMagic = 0x52414557; // 'WEAR'
+static constexpr uint32_t kStatsSlotSize = 256;
+static constexpr uint32_t kStatsSlots = SPI_FLASH_SEC_SIZE / kStatsSlotSize;
+
+const flash_hal_stats_t *flash_hal_stats(void) {
+    return &s_stats;
+}
+
+uint32_t flash_hal_stats_max_erase(void) {
+    uint32_t maxErase = 0;
+    for (uint32_t i = 0; i < FLASH_HAL_STATS_REGIONS; ++i) {
+        maxErase = std::max(maxErase, s_stats.eraseCount[i]);
+    }
+    return maxErase;
+}
+
+void flash_hal_stats_begin(uint32_t sector) {
+    s_statsSector = sector;
+    s_statsSeq = 0;
+
+    // adopt the newest intact record: its counters become the baseline
+    // the since-boot counters accumulate on top of
+    stats_record_s record;
+    bool found = false;
+    stats_record_s best = {};
+    for (uint32_t slot = 0; slot < kStatsSlots; ++slot) {
+        if (!ESP.flashRead(sector * SPI_FLASH_SEC_SIZE + slot * kStatsSlotSize,
+                           reinterpret_cast<uint32_t*>(&record), sizeof(record))) {
+            continue;
+        }
+        if (record.magic != kStatsMagic
+            || record.crc != crc32(&record, offsetof(stats_record_s, crc))) {
+            continue;
+        }
+        if (!found || record.seq > best.seq) {
+            best = record;
+            found = true;
+        }
+    }
+    if (!found) {
+        return;
+    }
+    s_statsSeq = best.seq;
+    const uint32_t *persisted = reinterpret_cast<const uint32_t*>(&best.stats);
+    uint32_t *live = reinterpret_cast<uint32_t*>(&s_stats);
+    for (size_t i = 0; i < sizeof(s_stats) / sizeof(uint32_t); ++i) {
+        live[i] += persisted[i];
+    }
+}
+
+int32_t flash_hal_stats_commit(void) {
+    if (!s_statsSector) {
+        return FLASH_HAL_WRITE_ERROR;
+    }
+
+    const uint32_t slot = (s_statsSeq + 1) % kStatsSlots;
+    if (slot == 0 && !ESP.flashEraseSector(s_statsSector)) {
+        return FLASH_HAL_WRITE_ERROR;
     }
+
+    stats_record_s record;
+    record.magic = kStatsMagic;
+    record.seq = s_statsSeq + 1;
+    record.stats = s_stats;
+    record.crc = crc32(&record, offsetof(stats_record_s, crc));
+    if (!ESP.flashWrite(s_statsSector * SPI_FLASH_SEC_SIZE + slot * kStatsSlotSize,
+                        reinterpret_cast<const uint32_t*>(&record), sizeof(record))) {
+        return FLASH_HAL_WRITE_ERROR;
+    }
+    s_statsSeq++;
     return FLASH_HAL_OK;
 }
 
+void flash_hal_stats_reset(void) {
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
 #if FLASH_MAP_SUPPORT
 
 // default weak configuration:
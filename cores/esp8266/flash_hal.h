@@ -91,6 +91,58 @@ extern int32_t flash_hal_write(uint32_t addr, uint32_t size, const uint8_t *src)
 extern int32_t flash_hal_erase(uint32_t addr, uint32_t size);
 extern int32_t flash_hal_read(uint32_t addr, uint32_t size, uint8_t *dst);
 
+/*
+  Wear and latency accounting.
+
+  Every flash_hal_* call updates a set of in-RAM counters: erase counts
+  per slice of the FS area (wear is what kills NOR flash, and it is
+  rarely uniform - the allocator hammers metadata sectors), log2
+  latency histograms for reads and programs (a program that used to
+  take 500us and now takes 5ms is a chip announcing its retirement),
+  and error tallies.  Collection is always on; the cost per operation
+  is two micros() calls and an increment.
+
+  The counters only become history if the sketch reserves a sector for
+  them (shrink the FS by one block in the flash map or linker script
+  and pass that sector to flash_hal_stats_begin(), which also reloads
+  whatever was persisted there).  flash_hal_stats_commit() then
+  journals the counters into the sector - 16 records per erase cycle,
+  so committing hourly costs the stats sector ~55 erases a year.
+*/
+
+#define FLASH_HAL_STATS_REGIONS      16
+#define FLASH_HAL_STATS_LAT_BUCKETS  8
+
+typedef struct {
+    /* erases per 1/16th slice of the FS area; the extra slot counts
+       erases outside it (EEPROM, WiFi config, ...) */
+    uint32_t eraseCount[FLASH_HAL_STATS_REGIONS + 1];
+    /* bucket n counts operations that took [2^n, 2^(n+1)) us; the last
+       bucket absorbs everything slower */
+    uint32_t readLatency[FLASH_HAL_STATS_LAT_BUCKETS];
+    uint32_t writeLatency[FLASH_HAL_STATS_LAT_BUCKETS];
+    uint32_t readErrors;
+    uint32_t writeErrors;
+    uint32_t eraseErrors;
+} flash_hal_stats_t;
+
+// Live counters (never NULL)
+extern const flash_hal_stats_t *flash_hal_stats(void);
+
+// Erase count of the hottest region - the number to alarm on
+extern uint32_t flash_hal_stats_max_erase(void);
+
+// Enable persistence in the given physical sector (must not overlap
+// the FS) and fold in the counters last committed there
+extern void flash_hal_stats_begin(uint32_t sector);
+
+// Journal the counters into the reserved sector; FLASH_HAL_OK or
+// FLASH_HAL_WRITE_ERROR (also when flash_hal_stats_begin was not called)
+extern int32_t flash_hal_stats_commit(void);
+
+// Zero the counters (e.g. after replacing the flash chip)
+extern void flash_hal_stats_reset(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
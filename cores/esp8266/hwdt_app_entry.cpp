@@ -279,6 +279,7 @@
 #include <pgmspace.h>
 #include "umm_malloc/umm_malloc.h"
 #include "mmu_iram.h"
+#include "crash_blackbox.h"
 
 extern "C" {
 #include <user_interface.h>
@@ -952,6 +953,11 @@ STATIC void IRAM_MAYBE handle_hwdt(void) {
 #endif
             /* Print context SYS */
             print_stack((uintptr_t)ctx_sys_ptr, (uintptr_t)ROM_STACK, PRINT_STACK::SYS);
+#ifndef USE_IRAM
+            /* Stage the same excerpt for the crash black box; it is committed
+               to flash by crash_blackbox_enable() once the sketch runs. */
+            crash_blackbox_stage_hwdt(ctx_sys_ptr, ROM_STACK);
+#endif
             if (get_noextra4k_g_pcont()) {
                 /* Print separate ctx: cont stack */
 
@@ -0,0 +1,128 @@
+/*
+    McastGroups.h - counted multicast group membership
+
+    SSDP, mDNS, LLMNR and sketches calling WiFiUDP::beginMulticast() each
+    used to issue their own igmp_joingroup()/igmp_leavegroup() calls, so one
+    component leaving a group another still needed - or a responder
+    rejoining on every reconnect without ever leaving - went straight to
+    lwIP.  This class keeps one membership per (interface, group) pair with
+    a reference count: only the first join and the last leave reach lwIP,
+    everything in between is a counter update.
+
+    lwIP already demuxes incoming UDP by destination port into each bound
+    context and hands the same refcounted pbuf to every matching receiver,
+    so the receive path needs no sharing; the group membership is the only
+    resource the discovery protocols actually contend on.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef MCASTGROUPS_H
+#define MCASTGROUPS_H
+
+#include <IPAddress.h>
+#include <lwip/igmp.h>
+
+namespace esp8266
+{
+namespace mcast
+{
+
+// lwip-v2's igmp_joingroup only supports IPv4; so does this registry.
+// mDNS manages its own per-netif memberships (including MLDv6) and stays
+// outside of it.
+class Groups
+{
+public:
+    // Join 'group' on the interface bound to 'intfAddr' (INADDR_ANY joins
+    // on every igmp-enabled interface).  Counted: only the first join per
+    // (interface, group) pair reaches lwIP.  Returns false if lwIP refused
+    // the join.
+    static bool join(const IPAddress& intfAddr, const IPAddress& group)
+    {
+        Entry* e = find(intfAddr.v4(), group.v4());
+        if (e)
+        {
+            ++e->refs;
+            return true;
+        }
+        if (igmp_joingroup(intfAddr, group) != ERR_OK)
+            return false;
+        e = new (std::nothrow) Entry;
+        if (e)
+        {
+            e->intf = intfAddr.v4();
+            e->group = group.v4();
+            e->refs = 1;
+            e->next = s_head;
+            s_head = e;
+        }
+        // with no entry (OOM) the membership is still active; the next
+        // join for this pair simply reaches lwIP again, which keeps its
+        // own per-netif use count
+        return true;
+    }
+
+    // Counterpart of join(): the membership is released only when the last
+    // holder leaves.  Pairs not tracked here (joined before this registry
+    // existed, or entry lost to OOM) are passed through to lwIP directly.
+    static bool leave(const IPAddress& intfAddr, const IPAddress& group)
+    {
+        Entry** pprev = &s_head;
+        for (Entry* e = s_head; e; pprev = &e->next, e = e->next)
+        {
+            if (e->intf == intfAddr.v4() && e->group == group.v4())
+            {
+                if (--e->refs)
+                    return true;
+                *pprev = e->next;
+                delete e;
+                break;
+            }
+        }
+        return igmp_leavegroup(intfAddr, group) == ERR_OK;
+    }
+
+    // Current number of holders of the given membership, 0 if untracked.
+    static uint16_t count(const IPAddress& intfAddr, const IPAddress& group)
+    {
+        const Entry* e = find(intfAddr.v4(), group.v4());
+        return e ? e->refs : 0;
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t intf;
+        uint32_t group;
+        uint16_t refs;
+        Entry* next;
+    };
+
+    static Entry* find(uint32_t intf, uint32_t group)
+    {
+        for (Entry* e = s_head; e; e = e->next)
+            if (e->intf == intf && e->group == group)
+                return e;
+        return nullptr;
+    }
+
+    static inline Entry* s_head = nullptr;
+};
+
+} // namespace mcast
+} // namespace esp8266
+
+#endif // MCASTGROUPS_H
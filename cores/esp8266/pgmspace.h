@@ -6,6 +6,7 @@
 // current source: https://github.com/earlephilhower/newlib-xtensa/blob/xtensa-4_0_0-lock-arduino/newlib/libc/sys/xtensa/sys/pgmspace.h
 
 #include <sys/pgmspace.h>
+#include <stddef.h>
 
 #ifdef __ets__
 
@@ -13,3 +14,36 @@
 #include "osapi.h"
 
 #endif
+
+// Like PSTR(), but emits the literal into one shared mergeable string
+// section (SHF_MERGE|SHF_STRINGS) instead of the per-TU
+// .irom0.pstr.<file>.<line> section, guaranteeing the linker folds
+// identical copies across translation units.  Duplicate waste surviving
+// a link can be listed with tools/sizes.py --pstr-report.
+#ifdef __ets__
+#ifndef PSTR_DEDUP
+#define PSTR_DEDUP(s) (__extension__({ \
+    static const char __pstr__[] __attribute__((__aligned__(PSTR_ALIGN))) \
+        __attribute__((section("\".irom0.pstr.dedup\", \"aSM\", @progbits, 1"))) = (s); \
+    &__pstr__[0]; }))
+#endif
+#else
+#define PSTR_DEDUP(s) PSTR(s)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Word-at-a-time PROGMEM routines (core_esp8266_pgmspace.cpp). Every flash
+// access is an aligned 32-bit load, avoiding the per-byte exception-handler
+// fixups the byte-wise libc versions rely on, which makes bulk copies and
+// scans of PROGMEM data several times faster. Semantics match the classic
+// memcpy_P/memcmp_P/strlen_P.
+void* memcpy_P_fast(void* dest, PGM_VOID_P src, size_t count);
+int memcmp_P_fast(const void* buf1, PGM_VOID_P buf2P, size_t size);
+size_t strlen_P_fast(PGM_P str);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,127 @@
+/*
+ postmortem_symtab.cpp - on-device symbolization aid for the postmortem report
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "postmortem_symtab.h"
+#include <c_types.h>
+#include <spi_flash.h>
+
+extern "C" {
+
+static uint32_t s_symtab_addr = 0;
+static postmortem_symtab_header_t s_symtab_header;
+
+// a function larger than this means the pc fell between table entries
+#define SYMTAB_MAX_FN_SIZE 0x10000u
+// keeps a corrupt header from turning the lookup into a flash scan
+#define SYMTAB_MAX_COUNT 0x10000u
+
+typedef struct
+{
+    uint32_t addr;
+    uint32_t name_hash;
+} symtab_entry_t;
+
+static bool read_entry(uint32_t index, symtab_entry_t* entry)
+{
+    const uint32_t addr = s_symtab_addr + sizeof(postmortem_symtab_header_t)
+                          + index * sizeof(symtab_entry_t);
+    return spi_flash_read(addr, (uint32_t*)entry, sizeof(*entry)) == SPI_FLASH_RESULT_OK;
+}
+
+bool postmortem_symtab_set(uint32_t flashAddress)
+{
+    s_symtab_addr = 0;
+    if (!flashAddress || (flashAddress & 3))
+    {
+        return false;
+    }
+    postmortem_symtab_header_t h;
+    if (spi_flash_read(flashAddress, (uint32_t*)&h, sizeof(h)) != SPI_FLASH_RESULT_OK)
+    {
+        return false;
+    }
+    if (h.magic != POSTMORTEM_SYMTAB_MAGIC || h.version != POSTMORTEM_SYMTAB_VERSION
+        || !h.count || h.count > SYMTAB_MAX_COUNT)
+    {
+        return false;
+    }
+    s_symtab_header = h;
+    s_symtab_addr = flashAddress;
+    return true;
+}
+
+void postmortem_symtab_unset(void)
+{
+    s_symtab_addr = 0;
+}
+
+uint32_t postmortem_symtab_build_id(void)
+{
+    return s_symtab_addr ? s_symtab_header.build_id : 0;
+}
+
+bool postmortem_symtab_lookup(uint32_t pc, uint32_t* name_hash, uint32_t* offset)
+{
+    if (!s_symtab_addr)
+    {
+        return false;
+    }
+    // binary search for the last entry with addr <= pc
+    uint32_t lo = 0;
+    uint32_t hi = s_symtab_header.count;
+    symtab_entry_t entry;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (!read_entry(mid, &entry))
+        {
+            return false;
+        }
+        if (entry.addr <= pc)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (!lo || !read_entry(lo - 1, &entry))
+    {
+        return false;
+    }
+    const uint32_t off = pc - entry.addr;
+    if (off >= SYMTAB_MAX_FN_SIZE)
+    {
+        return false;
+    }
+    if (name_hash)
+    {
+        *name_hash = entry.name_hash;
+    }
+    if (offset)
+    {
+        *offset = off;
+    }
+    return true;
+}
+
+} // extern "C"
@@ -0,0 +1,68 @@
+/*
+ postmortem_symtab.h - on-device symbolization aid for the postmortem report
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+ tools/mksymtab.py generates a compact {address, name-hash} table from the
+ linked ELF (wired into platform.txt after the bin step). Flash the table
+ to a spare region - e.g. the unused tail between the sketch and the
+ filesystem - and register it with postmortem_symtab_set(); the postmortem
+ report then prints function-relative frames plus the build id, and the
+ <table>.txt dictionary emitted next to it maps the name hashes back to
+ full symbol names without hunting for the matching ELF.
+*/
+
+#ifndef POSTMORTEM_SYMTAB_H
+#define POSTMORTEM_SYMTAB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POSTMORTEM_SYMTAB_MAGIC 0x544D5953u  // "SYMT"
+#define POSTMORTEM_SYMTAB_VERSION 1
+
+typedef struct postmortem_symtab_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;     // {addr, name_hash} entries following, sorted by addr
+    uint32_t build_id;  // matches the generated dictionary file
+} postmortem_symtab_header_t;
+
+// Register the flash byte address the table was written to; validates the
+// header and returns false when none is found there.
+bool postmortem_symtab_set(uint32_t flashAddress);
+void postmortem_symtab_unset(void);
+
+// 0 when no table is registered
+uint32_t postmortem_symtab_build_id(void);
+
+// Crash-context lookup: resolves a code address to the name hash of the
+// containing function and the offset into it. Safe to call from the
+// postmortem report; reads the table from flash entry by entry.
+bool postmortem_symtab_lookup(uint32_t pc, uint32_t* name_hash, uint32_t* offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POSTMORTEM_SYMTAB_H
@@ -674,6 +674,19 @@ s32_t SPIFFS_gc_quick(spiffs *fs, u16_t max_free_pages);
  */
 s32_t SPIFFS_gc(spiffs *fs, u32_t size);
 
+/**
+ * Performs one bounded slice of garbage collection, reclaiming at most one
+ * block: a fully deleted block is erased if one exists, otherwise the best
+ * candidate block is cleansed and erased. Intended to be called repeatedly
+ * from idle time so that write latency stays bounded instead of paying for
+ * a full GC pass inside a write.
+ *
+ * @param fs            the file system struct
+ * @returns 1 if a block was reclaimed (more work may remain), 0 if there is
+ *          nothing worth collecting, or a negative error code
+ */
+s32_t SPIFFS_gc_step(spiffs *fs);
+
 /**
  * Check if EOF reached.
  * @param fs            the file system struct
@@ -605,6 +605,52 @@ s32_t spiffs_gc_clean(spiffs *fs, spiffs_block_ix bix) {
   return res;
 }
 
+// esp8266/Arduino extension: perform one bounded slice of garbage collection.
+// Reclaims at most one block per call - first a fully deleted block if one
+// exists (erase only), otherwise the best candidate block is cleansed and
+// erased. Returns 1 when a block was reclaimed (more work may remain), 0 when
+// there is nothing worth collecting, or a negative error code.
+s32_t spiffs_gc_step(
+    spiffs *fs) {
+  s32_t res = spiffs_gc_quick(fs, 0);
+  if (res == SPIFFS_OK) {
+    return 1;
+  }
+  if (res != SPIFFS_ERR_NO_DELETED_BLOCKS) {
+    return res;
+  }
+
+  // no fully deleted blocks - move live pages out of the dirtiest block
+  if (fs->stats_p_deleted == 0) {
+    return 0;
+  }
+
+  spiffs_block_ix *cands;
+  int count;
+  res = spiffs_gc_find_candidate(fs, &cands, &count, 0);
+  SPIFFS_CHECK_RES(res);
+  if (count == 0) {
+    return 0;
+  }
+
+#if SPIFFS_GC_STATS
+  fs->stats_gc_runs++;
+#endif
+  spiffs_block_ix cand = cands[0];
+  fs->cleaning = 1;
+  res = spiffs_gc_clean(fs, cand);
+  fs->cleaning = 0;
+  SPIFFS_CHECK_RES(res);
+
+  res = spiffs_gc_erase_page_stats(fs, cand);
+  SPIFFS_CHECK_RES(res);
+
+  res = spiffs_gc_erase_block(fs, cand);
+  SPIFFS_CHECK_RES(res);
+
+  return 1;
+}
+
 };
 
 #endif // !SPIFFS_READ_ONLY
@@ -1168,6 +1168,25 @@ s32_t SPIFFS_gc_quick(spiffs *fs, u16_t max_free_pages) {
 }
 
 
+s32_t SPIFFS_gc_step(spiffs *fs) {
+  SPIFFS_API_DBG("%s\n", __func__);
+#if SPIFFS_READ_ONLY
+  (void)fs;
+  return SPIFFS_ERR_RO_NOT_IMPL;
+#else
+  s32_t res;
+  SPIFFS_API_CHECK_CFG(fs);
+  SPIFFS_API_CHECK_MOUNT(fs);
+  SPIFFS_LOCK(fs);
+
+  res = spiffs_gc_step(fs);
+
+  SPIFFS_API_CHECK_RES_UNLOCK(fs, res);
+  SPIFFS_UNLOCK(fs);
+  return res;
+#endif // SPIFFS_READ_ONLY
+}
+
 s32_t SPIFFS_gc(spiffs *fs, u32_t size) {
   SPIFFS_API_DBG("%s " _SPIPRIi "\n", __func__, size);
 #if SPIFFS_READ_ONLY
@@ -237,6 +237,28 @@ public:
         return SPIFFS_gc_quick( &_fs, 0 ) == SPIFFS_OK;
     }
 
+    bool gcStep(uint32_t maxMicros) override
+    {
+        // Each SPIFFS_gc_step() reclaims at most one block, so a single
+        // slice can overshoot maxMicros by roughly one block clean+erase.
+        const uint32_t start = micros();
+        bool didWork = false;
+        for (;;) {
+            auto rc = SPIFFS_gc_step(&_fs);
+            if (rc < 0) {
+                DEBUGV("SPIFFS_gc_step: rc=%d, err=%d\r\n", rc, _fs.err_code);
+                return didWork;
+            }
+            if (rc == 0) {
+                return didWork; // nothing left worth collecting
+            }
+            didWork = true;
+            if (micros() - start >= maxMicros) {
+                return true;
+            }
+        }
+    }
+
     bool check() override
     {
         return SPIFFS_check(&_fs) == SPIFFS_OK;
@@ -0,0 +1,193 @@
+/*
+ spsc_ringbuf.h - lock-free single-producer/single-consumer ring buffer
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __spsc_ringbuf_h
+#define __spsc_ringbuf_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <new>
+
+/*
+  Fixed-capacity ring buffer safe for one producer and one consumer running
+  concurrently without disabling interrupts, e.g. an ISR filling it while
+  the main loop drains it (or the other way around).
+
+  The capacity is rounded up to a power of two and the read/write indices
+  are free-running 32-bit counters (masked on access), so full/empty never
+  needs a wasted slot and index publication is a single aligned store.
+  Producer-side methods (push, room) and consumer-side methods (pop, peek,
+  consume, available, flush) must each be called from their single
+  respective context only.
+
+  All methods are small and inline so that calls from IRAM_ATTR functions
+  stay in IRAM.
+*/
+template <typename T>
+class spsc_ringbuf
+{
+public:
+    // capacity granted for a requested minimum size
+    static size_t roundup(size_t min_size)
+    {
+        size_t size = 4;
+        while (size < min_size)
+            size <<= 1;
+        return size;
+    }
+
+    spsc_ringbuf(size_t min_size)
+    {
+        size_t size = roundup(min_size);
+        _buf = new (std::nothrow) T[size];
+        _mask = size - 1;
+        _wpos.store(0, std::memory_order_relaxed);
+        _rpos.store(0, std::memory_order_relaxed);
+    }
+
+    ~spsc_ringbuf()
+    {
+        delete[] _buf;
+    }
+
+    spsc_ringbuf(const spsc_ringbuf&) = delete;
+    spsc_ringbuf& operator=(const spsc_ringbuf&) = delete;
+
+    // false when the constructor could not allocate storage
+    bool valid() const
+    {
+        return _buf != nullptr;
+    }
+
+    size_t size() const
+    {
+        return _mask + 1;
+    }
+
+    // consumer side
+    inline size_t __attribute__((always_inline)) available() const
+    {
+        return _wpos.load(std::memory_order_acquire) - _rpos.load(std::memory_order_relaxed);
+    }
+
+    // producer side
+    inline size_t __attribute__((always_inline)) room() const
+    {
+        return size() - (_wpos.load(std::memory_order_relaxed) - _rpos.load(std::memory_order_acquire));
+    }
+
+    bool empty() const
+    {
+        return available() == 0;
+    }
+
+    bool full() const
+    {
+        return room() == 0;
+    }
+
+    // producer: store one element, false (element dropped) when full
+    inline bool __attribute__((always_inline)) push(T v)
+    {
+        uint32_t w = _wpos.load(std::memory_order_relaxed);
+        if (w - _rpos.load(std::memory_order_acquire) > _mask)
+            return false;
+        _buf[w & _mask] = v;
+        _wpos.store(w + 1, std::memory_order_release);
+        return true;
+    }
+
+    // producer: store up to n elements, returns how many fit
+    size_t push(const T* src, size_t n)
+    {
+        size_t can = room();
+        if (n > can)
+            n = can;
+        uint32_t w = _wpos.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < n; i++)
+            _buf[(w + i) & _mask] = src[i];
+        _wpos.store(w + n, std::memory_order_release);
+        return n;
+    }
+
+    // consumer: false when empty
+    bool pop(T& v)
+    {
+        if (!available())
+            return false;
+        uint32_t r = _rpos.load(std::memory_order_relaxed);
+        v = _buf[r & _mask];
+        _rpos.store(r + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer: retrieve up to n elements, returns how many were copied
+    size_t pop(T* dst, size_t n)
+    {
+        size_t done = 0;
+        while (done < n)
+        {
+            size_t contig;
+            const T* src = peek(contig);
+            if (!contig)
+                break;
+            if (contig > n - done)
+                contig = n - done;
+            for (size_t i = 0; i < contig; i++)
+                dst[done + i] = src[i];
+            consume(contig);
+            done += contig;
+        }
+        return done;
+    }
+
+    // consumer: pointer to the oldest element and the count of elements
+    // readable contiguously from it (<= available(), 0 when empty);
+    // call consume() afterwards
+    const T* peek(size_t& contiguous) const
+    {
+        size_t avail = available();
+        uint32_t r = _rpos.load(std::memory_order_relaxed) & _mask;
+        size_t to_end = size() - r;
+        contiguous = avail < to_end ? avail : to_end;
+        return &_buf[r];
+    }
+
+    // consumer: discard n elements previously obtained through peek()
+    void consume(size_t n)
+    {
+        _rpos.store(_rpos.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // consumer: discard everything
+    void flush()
+    {
+        _rpos.store(_wpos.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    T* _buf;
+    uint32_t _mask;
+    std::atomic<uint32_t> _wpos;
+    std::atomic<uint32_t> _rpos;
+};
+
+#endif //__spsc_ringbuf_h
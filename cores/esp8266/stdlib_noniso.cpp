@@ -20,6 +20,7 @@
 */
 
 #include "stdlib_noniso.h"
+#include "NumberFormat.h"
 
 // ulltoa() is slower than std::to_char() (1.6 times)
 // but is smaller by ~800B/flash and ~250B/rodata
@@ -29,6 +30,13 @@ char* ulltoa(unsigned long long val, char* str, int slen, unsigned int radix)
 {
     str += --slen;
     *str = 0;
+    if (radix == 10 && slen >= 20)
+    {
+        // two digits per division (NumberFormat.h); 20 cells always fit
+        // a 64-bit value so the length guard of the loop below isn't
+        // needed
+        return numfmt_ulltoa10(val, str);
+    }
     do
     {
         auto mod = val % radix;
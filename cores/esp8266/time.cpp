@@ -78,6 +78,48 @@ void tune_timeshift64 (uint64_t now_us)
      timeshift64 = now_us - micros64();
 }
 
+// SNTP poll cadence, see sntp_set_poll_interval() (0: legacy 1h default)
+static uint32_t sntp_poll_initial_ms = 0;
+static uint32_t sntp_poll_max_ms = 0;
+static uint32_t sntp_poll_current_ms = 0;
+
+void sntp_set_poll_interval (uint32_t initial_ms, uint32_t max_ms)
+{
+    if (!initial_ms && !max_ms)
+    {
+        sntp_poll_initial_ms = sntp_poll_max_ms = sntp_poll_current_ms = 0;
+        return;
+    }
+    if (initial_ms < 15000)
+        // cf. the hook name below
+        initial_ms = 15000;
+    if (max_ms < initial_ms)
+        max_ms = initial_ms;
+    sntp_poll_initial_ms = initial_ms;
+    sntp_poll_max_ms = max_ms;
+    sntp_poll_current_ms = initial_ms;
+}
+
+// Strong definition overriding the weak 1h default in the lwIP glue;
+// called by the SNTP app each time it re-arms its poll timer.
+uint32_t sntp_update_delay_MS_rfc_not_less_than_15000 ()
+{
+    return sntp_poll_current_ms ? sntp_poll_current_ms : 3600000 /* SNTP_UPDATE_DELAY_DEFAULT */;
+}
+
+// SNTP slew, see sntp_set_slew() (max_step_us 0: legacy step-only)
+static uint32_t slew_max_step_us = 0;
+static uint32_t slew_rate_ppm = 500;
+static int64_t slew_remaining_us = 0;
+
+void sntp_set_slew (uint32_t max_step_us, uint32_t rate_ppm)
+{
+    slew_max_step_us = max_step_us;
+    slew_rate_ppm = rate_ppm ? rate_ppm : 500;
+    if (!max_step_us)
+        slew_remaining_us = 0;
+}
+
 static void setServer(int id, const char* name_or_ip)
 {
     if (name_or_ip)
@@ -153,6 +195,9 @@ void configTime(int timezone_sec, int daylightOffset_sec, const char* server1, c
 {
     sntp_stop();
 
+    // restart the poll backoff from its initial cadence
+    sntp_poll_current_ms = sntp_poll_initial_ms;
+
     // There is no way to tell when DST starts or stop with this API
     // So DST is always integrated in TZ
     // The other API should be preferred
@@ -233,6 +278,9 @@ void configTime(const char* tz, const char* server1, const char* server2, const
 {
     sntp_stop();
 
+    // restart the poll backoff from its initial cadence
+    sntp_poll_current_ms = sntp_poll_initial_ms;
+
     setServer(0, server1);
     setServer(1, server2);
     setServer(2, server3);
@@ -255,6 +303,51 @@ void configTime(const char* tz, String server1, String server2, String server3)
 }
 
 static BoolCB _settimeofday_cb;
+static SntpSyncCB _sntp_sync_cb;
+
+void sntp_sync_cb (const SntpSyncCB& cb)
+{
+    _sntp_sync_cb = cb;
+}
+
+// Applies a pending slew: moves timeshift64 towards the sync target by at
+// most slew_rate_ppm worth of the tick period, so wall time never jumps and
+// - the step being a small fraction of the tick - never goes backwards.
+static bool slew_ticking = false;
+static constexpr uint32_t SLEW_TICK_US = 100000;
+
+static void start_slew ()
+{
+    if (slew_ticking)
+        return;
+    slew_ticking = true;
+    schedule_recurrent_function_us([]()
+    {
+        int64_t step = (int64_t)SLEW_TICK_US * slew_rate_ppm / 1000000;
+        if (!step)
+            step = 1;
+        if (slew_remaining_us >= 0)
+        {
+            if (step > slew_remaining_us)
+                step = slew_remaining_us;
+            timeshift64 += (uint64_t)step;
+            slew_remaining_us -= step;
+        }
+        else
+        {
+            if (step > -slew_remaining_us)
+                step = -slew_remaining_us;
+            timeshift64 -= (uint64_t)step;
+            slew_remaining_us += step;
+        }
+        if (!slew_remaining_us)
+        {
+            slew_ticking = false;
+            return false;
+        }
+        return true;
+    }, SLEW_TICK_US);
+}
 
 void settimeofday_cb (const TrivialCB& cb)
 {
@@ -295,8 +388,50 @@ int settimeofday(const struct timeval* tv, const struct timezone* tz)
         // tz is obsolete (cf. man settimeofday)
         return EINVAL;
 
-    // reset time subsystem
-    tune_timeshift64(tv->tv_sec * 1000000ULL + tv->tv_usec);
+    static bool synced = false;
+    static uint64_t last_sync_us = 0;
+
+    const uint64_t local_us = micros64();
+    const uint64_t now_us = tv->tv_sec * 1000000ULL + tv->tv_usec;
+
+    sntp_sync_info_t info;
+    // offset against the clock as currently reported, i.e. including
+    // whatever part of a previous offset has not been slewed in yet
+    info.offset_us = (int64_t)(now_us - (local_us + timeshift64));
+    info.drift_ppm = 0;
+    info.stepped = true;
+
+    if (from_sntp && synced && local_us - last_sync_us >= 1000000ULL)
+        info.drift_ppm = (int32_t)(info.offset_us * 1000000LL / (int64_t)(local_us - last_sync_us));
+
+    const uint64_t abs_offset_us = info.offset_us < 0 ? -info.offset_us : info.offset_us;
+    if (from_sntp && synced && slew_max_step_us && abs_offset_us <= slew_max_step_us)
+    {
+        // small correction on an already synchronised clock: slew
+        info.stepped = false;
+        slew_remaining_us = info.offset_us;
+        start_slew();
+    }
+    else
+    {
+        // reset time subsystem
+        tune_timeshift64(now_us);
+        slew_remaining_us = 0;
+    }
+
+    if (from_sntp)
+    {
+        synced = true;
+        last_sync_us = local_us;
+        // poll backoff: double the cadence up to the configured maximum
+        if (sntp_poll_current_ms && sntp_poll_current_ms < sntp_poll_max_ms)
+        {
+            uint64_t next_ms = (uint64_t)sntp_poll_current_ms * 2;
+            sntp_poll_current_ms = next_ms > sntp_poll_max_ms ? sntp_poll_max_ms : (uint32_t)next_ms;
+        }
+        if (_sntp_sync_cb)
+            schedule_recurrent_function_us([info](){ _sntp_sync_cb(info); return false; }, 0);
+    }
 
     if (_settimeofday_cb)
         schedule_recurrent_function_us([from_sntp](){ _settimeofday_cb(from_sntp); return false; }, 0);
@@ -44,6 +44,14 @@ void twi_setClock(unsigned int freq);
 void twi_setClockStretchLimit(uint32_t limit);
 uint8_t twi_writeTo(unsigned char address, unsigned char * buf, unsigned int len, unsigned char sendStop);
 uint8_t twi_readFrom(unsigned char address, unsigned char * buf, unsigned int len, unsigned char sendStop);
+// Asynchronous master transfers: sliced one byte at a time from the scheduled
+// function queue instead of busy-waiting the whole transfer.  Return 0 when
+// accepted (final status delivered through the callback, same codes as the
+// synchronous calls) or 4 when a transfer is already in flight.  The buffer
+// must stay valid until the callback runs.
+uint8_t twi_writeToAsync(unsigned char address, unsigned char * buf, unsigned int len, unsigned char sendStop, void (*done)(uint8_t status));
+uint8_t twi_readFromAsync(unsigned char address, unsigned char * buf, unsigned int len, unsigned char sendStop, void (*done)(uint8_t status));
+bool twi_asyncBusy(void);
 uint8_t twi_status();
 
 uint8_t twi_transmit(const uint8_t*, uint8_t);
@@ -42,12 +42,14 @@
  */
 #include "Arduino.h"
 #include "coredecls.h"
+#include "core_esp8266_profile.h"
 #include <pgmspace.h>
 #include "gdb_hooks.h"
 #include "uart.h"
 #include "esp8266_peri.h"
 #include "user_interface.h"
 #include "uart_register.h"
+#include "spsc_ringbuf.h"
 
 #define MODE2WIDTH(mode) (((mode%16)>>2)+5)
 #define MODE2STOP(mode) (((mode)>>5)+1)
@@ -80,14 +82,6 @@ extern "C" {
 
 static int s_uart_debug_nr = UART0;
 
-struct uart_rx_buffer_
-{
-    size_t size;
-    size_t rpos;
-    size_t wpos;
-    uint8_t * buffer;
-};
-
 struct uart_
 {
     int uart_nr;
@@ -98,16 +92,40 @@ struct uart_
     bool rx_error;
     uint8_t rx_pin;
     uint8_t tx_pin;
-    struct uart_rx_buffer_ * rx_buffer;
+    spsc_ringbuf<uint8_t> * rx_buffer;
+    // optional tx ring (UART0 only): user context produces, isr consumes
+    // and refills the hw fifo on the fifo-empty-threshold interrupt
+    spsc_ringbuf<uint8_t> * tx_buffer;
+    // automatic RTS (UART0 only): the isr stops the sender when the rx ring
+    // reaches rx_flow_high, the consumer releases it at rx_flow_low
+    size_t rx_flow_high; // 0 = flow control disabled
+    size_t rx_flow_low;
+    volatile bool rx_flow_asserted;
+    // RX line framing (uart_set_rx_framing): the producer counts bytes into
+    // the current frame as they enter the rx ring and records each completed
+    // frame's length in rx_frames (producer side); uart_rx_deliver_frames
+    // consumes.  rx_frames == NULL means framing is disabled.
+    uint8_t rx_frame_terminator;
+    bool rx_frame_by_length;
+    size_t rx_frame_length;
+    size_t rx_frame_fill;
+    spsc_ringbuf<uint16_t>* rx_frames;
+    uart_frame_notify_t rx_frame_notify;
+    void* rx_frame_notify_arg;
 };
 
 
 /*
+   The rx buffer is a lock-free single-producer/single-consumer ring
+   (spsc_ringbuf.h): the isr produces, user context consumes.  Consuming
+   (read/peek/consume/available) therefore no longer needs the uart
+   interrupt disabled.
+
    In the context of the naming conventions in this file, "_unsafe" means two things:
    1. the input arguments are not checked. It is up to the caller to check argument sanity.
-   2. The function body is not interrupt-safe, i.e.: the isr could fire anywhen during the
-      body execution, leading to corruption of the data shared between the body and the isr
-      (parts of the rx_buffer).
+   2. The function body drains the hw fifo, i.e. acts as a producer.  The isr is the
+      other producer, so calling it from user context without disabling the uart
+      interrupt would corrupt the ring.
 
    The unsafe versions of the functions are private to this TU. There are "safe" versions that
    wrap the unsafe ones with disabling/enabling of the uart interrupt for safe public use.
@@ -122,38 +140,121 @@ uart_rx_fifo_available(const int uart_nr)
     return (USS(uart_nr) >> USRXC) & 0xFF;
 }
 
+/*
+  Reference for uart_tx_fifo_available() and uart_tx_fifo_full():
+  -Espressif Techinical Reference doc, chapter 11.3.7
+  -tools/sdk/uart_register.h
+  -cores/esp8266/esp8266_peri.h
+  */
+inline __attribute__((always_inline)) size_t
+uart_tx_fifo_available(const int uart_nr)
+{
+    return (USS(uart_nr) >> USTXC) & 0xff;
+}
+
+inline __attribute__((always_inline)) bool
+uart_tx_fifo_full(const int uart_nr)
+{
+    return uart_tx_fifo_available(uart_nr) >= 0x7f;
+}
+
+// Pour the tx ring into the hw fifo, and mask the fifo-empty interrupt
+// once nothing is left to send.  Producer side (uart_write) re-enables it.
+// called by ISR, and by user context with the uart interrupt disabled
+inline void IRAM_ATTR
+uart_tx_refill_fifo_unsafe(uart_t* uart)
+{
+    uint8_t data;
+    while(!uart_tx_fifo_full(uart->uart_nr) && uart->tx_buffer->pop(data))
+        USF(uart->uart_nr) = data;
+    if(!uart->tx_buffer->available())
+        USIE(uart->uart_nr) &= ~(1 << UIFE);
+}
+
 
 /**********************************************************/
 /************ UNSAFE FUNCTIONS ****************************/
 /**********************************************************/
 inline size_t
-uart_rx_buffer_available_unsafe(const struct uart_rx_buffer_ * rx_buffer)
+uart_rx_available_unsafe(uart_t* uart)
 {
-    if(rx_buffer->wpos < rx_buffer->rpos)
-      return (rx_buffer->wpos + rx_buffer->size) - rx_buffer->rpos;
+    return uart->rx_buffer->available() + uart_rx_fifo_available(uart->uart_nr);
+}
 
-    return rx_buffer->wpos - rx_buffer->rpos;
+// Producer-side watermark check: stop the sender via RTS once the ring
+// holds rx_flow_high bytes or more.  The hardware flow logic (UCRXHFE)
+// only watches the 128-byte hw fifo, so the line is driven manually
+// through UCSWRTS against the software ring instead.
+// called by ISR
+inline void IRAM_ATTR
+uart_rx_flow_update_unsafe(uart_t* uart)
+{
+    if(uart->rx_flow_high && !uart->rx_flow_asserted
+       && uart->rx_buffer->available() >= uart->rx_flow_high)
+    {
+        USC0(uart->uart_nr) |= (1 << UCSWRTS);
+        uart->rx_flow_asserted = true;
+    }
 }
 
-inline size_t
-uart_rx_available_unsafe(uart_t* uart)
+// Consumer-side watermark check: release the sender once the ring drained
+// to rx_flow_low.  The register read-modify-write must not be torn by the
+// isr's assertion path, hence the critical section.
+static void
+uart_rx_flow_release(uart_t* uart)
 {
-    return uart_rx_buffer_available_unsafe(uart->rx_buffer) + uart_rx_fifo_available(uart->uart_nr);
+    if(uart->rx_flow_asserted
+       && uart->rx_buffer->available() <= uart->rx_flow_low)
+    {
+        ETS_UART_INTR_DISABLE();
+        USC0(uart->uart_nr) &= ~(1 << UCSWRTS);
+        uart->rx_flow_asserted = false;
+        ETS_UART_INTR_ENABLE();
+    }
 }
 
-//#define UART_DISCARD_NEWEST
+// Frame accounting for a byte that just entered the rx ring: count it into
+// the current frame and record the frame length at each boundary.  The
+// notification hook runs right here in isr context so delivery can be
+// scheduled with isr-level latency.
+// called by ISR
+inline void IRAM_ATTR
+uart_rx_frame_mark_unsafe(uart_t* uart, uint8_t data)
+{
+    ++uart->rx_frame_fill;
+    if(uart->rx_frame_by_length
+       ? uart->rx_frame_fill < uart->rx_frame_length
+       : data != uart->rx_frame_terminator)
+        return;
+
+    if(uart->rx_frames->push((uint16_t)uart->rx_frame_fill))
+    {
+        if(uart->rx_frame_notify)
+            uart->rx_frame_notify(uart->rx_frame_notify_arg);
+    }
+    else
+        // frame queue full: the bytes stay in the rx ring but this
+        // boundary is lost, flag it like any other data loss
+        uart->rx_overrun = true;
+    uart->rx_frame_fill = 0;
+}
 
 // Copy all the rx fifo bytes that fit into the rx buffer
 // called by ISR
 inline void IRAM_ATTR
 uart_rx_copy_fifo_to_buffer_unsafe(uart_t* uart)
 {
-    struct uart_rx_buffer_ *rx_buffer = uart->rx_buffer;
+    spsc_ringbuf<uint8_t> *rx_buffer = uart->rx_buffer;
 
     while(uart_rx_fifo_available(uart->uart_nr))
     {
-        size_t nextPos = (rx_buffer->wpos + 1) % rx_buffer->size;
-        if(nextPos == rx_buffer->rpos)
+        uint8_t data = USF(uart->uart_nr);
+        if(rx_buffer->push(data))
+        {
+            if(uart->rx_frames)
+                uart_rx_frame_mark_unsafe(uart, data);
+        }
+        else
         {
             if (!uart->rx_overrun)
             {
@@ -161,23 +262,12 @@ uart_rx_copy_fifo_to_buffer_unsafe(uart_t* uart)
                 //os_printf_plus(overrun_str);
             }
 
-            // a choice has to be made here,
-            // do we discard newest or oldest data?
-#ifdef UART_DISCARD_NEWEST
-            // discard newest data
-            // Stop copying if rx buffer is full
-            USF(uart->uart_nr);
+            // the consumer owns the read index, so when the ring is full
+            // the producer can only discard the newest data
             break;
-#else
-            // discard oldest data
-            if (++rx_buffer->rpos == rx_buffer->size)
-                rx_buffer->rpos = 0;
-#endif
         }
-        uint8_t data = USF(uart->uart_nr);
-        rx_buffer->buffer[rx_buffer->wpos] = data;
-        rx_buffer->wpos = nextPos;
     }
+    uart_rx_flow_update_unsafe(uart);
 }
 
 inline int
@@ -187,26 +277,13 @@ uart_peek_char_unsafe(uart_t* uart)
         return -1;
 
     //without the following if statement and body, there is a good chance of a fifo overrun
-    if (uart_rx_buffer_available_unsafe(uart->rx_buffer) == 0)
+    if (uart->rx_buffer->available() == 0)
         // hw fifo can't be peeked, data need to be copied to sw
         uart_rx_copy_fifo_to_buffer_unsafe(uart);
 
-    return uart->rx_buffer->buffer[uart->rx_buffer->rpos];
-}
-
-// taking data straight from hw fifo: loopback-test BW jumps by 19%
-inline int
-uart_read_char_unsafe(uart_t* uart)
-{
-    if (uart_rx_buffer_available_unsafe(uart->rx_buffer))
-    {
-        // take oldest sw data
-        int ret = uart->rx_buffer->buffer[uart->rx_buffer->rpos];
-        uart->rx_buffer->rpos = (uart->rx_buffer->rpos + 1) % uart->rx_buffer->size;
-        return ret;
-    }
-    // unavailable
-    return -1;
+    size_t contiguous;
+    const uint8_t* p = uart->rx_buffer->peek(contiguous);
+    return contiguous? *p: -1;
 }
 
 uint8_t
@@ -222,11 +299,8 @@ uart_rx_available(uart_t* uart)
     if(uart == NULL || !uart->rx_enabled)
         return 0;
 
-    ETS_UART_INTR_DISABLE();
-    int uartrxbufferavailable = uart_rx_buffer_available_unsafe(uart->rx_buffer);
-    ETS_UART_INTR_ENABLE();
-
-    return uartrxbufferavailable + uart_rx_fifo_available(uart->uart_nr);
+    // lock-free: we are the single consumer of the rx ring
+    return uart->rx_buffer->available() + uart_rx_fifo_available(uart->uart_nr);
 }
 
 int
@@ -235,7 +309,7 @@ uart_peek_char(uart_t* uart)
     if(uart == NULL || !uart->rx_enabled)
         return -1;
 
-    ETS_UART_INTR_DISABLE(); //access to rx_buffer can be interrupted by the isr (similar to a critical section), so disable interrupts here
+    ETS_UART_INTR_DISABLE(); //may drain the hw fifo (producer side, shared with the isr), so disable interrupts here
     int ret = uart_peek_char_unsafe(uart);
     ETS_UART_INTR_ENABLE();
     return ret;
@@ -251,29 +325,25 @@ size_t uart_peek_available (uart_t* uart)
 
     ETS_UART_INTR_DISABLE();
     uart_rx_copy_fifo_to_buffer_unsafe(uart);
-    auto rpos = uart->rx_buffer->rpos;
-    auto wpos = uart->rx_buffer->wpos;
     ETS_UART_INTR_ENABLE();
-    if(wpos < rpos)
-        return uart->rx_buffer->size - rpos;
-    return wpos - rpos;
+    size_t contiguous;
+    uart->rx_buffer->peek(contiguous);
+    return contiguous;
 }
 
 // return a pointer to available data buffer (size = available())
 // semantic forbids any kind of read() between peekBuffer() and peekConsume()
 const char* uart_peek_buffer (uart_t* uart)
 {
-    return (const char*)&uart->rx_buffer->buffer[uart->rx_buffer->rpos];
+    size_t contiguous;
+    return (const char*)uart->rx_buffer->peek(contiguous);
 }
 
 // consume bytes after use (see uart_peek_buffer)
 void uart_peek_consume (uart_t* uart, size_t consume)
 {
-    ETS_UART_INTR_DISABLE();
-    uart->rx_buffer->rpos += consume;
-    if (uart->rx_buffer->rpos >= uart->rx_buffer->size)
-        uart->rx_buffer->rpos -= uart->rx_buffer->size;
-    ETS_UART_INTR_ENABLE();
+    uart->rx_buffer->consume(consume);
+    uart_rx_flow_release(uart);
 }
 
 int
@@ -290,34 +360,20 @@ uart_read(uart_t* uart, char* userbuffer, size_t usersize)
     if(uart == NULL || !uart->rx_enabled)
         return 0;
 
-    size_t ret = 0;
-    ETS_UART_INTR_DISABLE();
+    // pour sw buffer to user's buffer, lock-free (we are the single consumer)
+    size_t ret = uart->rx_buffer->pop((uint8_t*)userbuffer, usersize);
 
-    while (ret < usersize && uart_rx_available_unsafe(uart))
+    if (ret < usersize)
     {
-        if (!uart_rx_buffer_available_unsafe(uart->rx_buffer))
-        {
-            // no more data in sw buffer, take them from hw fifo
-            while (ret < usersize && uart_rx_fifo_available(uart->uart_nr))
-                userbuffer[ret++] = USF(uart->uart_nr);
-
-	    // no more sw/hw data available
-            break;
-        }
-
-        // pour sw buffer to user's buffer
-        // get largest linear length from sw buffer
-        size_t chunk = uart->rx_buffer->rpos < uart->rx_buffer->wpos?
-                           uart->rx_buffer->wpos - uart->rx_buffer->rpos:
-                           uart->rx_buffer->size - uart->rx_buffer->rpos;
-        if (ret + chunk > usersize)
-            chunk = usersize - ret;
-        memcpy(userbuffer + ret, uart->rx_buffer->buffer + uart->rx_buffer->rpos, chunk);
-        uart->rx_buffer->rpos = (uart->rx_buffer->rpos + chunk) % uart->rx_buffer->size;
-        ret += chunk;
+        // no more data in sw buffer, take them from hw fifo
+        // (the isr also drains the fifo, hence the critical section)
+        ETS_UART_INTR_DISABLE();
+        while (ret < usersize && uart_rx_fifo_available(uart->uart_nr))
+            userbuffer[ret++] = USF(uart->uart_nr);
+        ETS_UART_INTR_ENABLE();
     }
 
-    ETS_UART_INTR_ENABLE();
+    uart_rx_flow_release(uart);
     return ret;
 }
 
@@ -332,30 +388,19 @@ static void IRAM_ATTR uart_isr_handle_data(void* arg, uint8_t data)
         return;
     }
 
-// Copy all the rx fifo bytes that fit into the rx buffer
-// called by ISR
-    struct uart_rx_buffer_ *rx_buffer = uart->rx_buffer;
-
-    size_t nextPos = (rx_buffer->wpos + 1) % rx_buffer->size;
-    if(nextPos == rx_buffer->rpos)
+    if(uart->rx_buffer->push(data))
     {
+        if(uart->rx_frames)
+            uart_rx_frame_mark_unsafe(uart, data);
+    }
+    else
+    {
+        // ring full: the newest data is discarded (see
+        // uart_rx_copy_fifo_to_buffer_unsafe)
         uart->rx_overrun = true;
         //os_printf_plus(overrun_str);
-
-        // a choice has to be made here,
-        // do we discard newest or oldest data?
-#ifdef UART_DISCARD_NEWEST
-        // discard newest data
-        // Stop copying if rx buffer is full
-        return;
-#else
-        // discard oldest data
-        if (++rx_buffer->rpos == rx_buffer->size)
-            rx_buffer->rpos = 0;
-#endif
     }
-    rx_buffer->buffer[rx_buffer->wpos] = data;
-    rx_buffer->wpos = nextPos;
+    uart_rx_flow_update_unsafe(uart);
 
     // Check the UART flags and note hardware overflow/etc.
     uint32_t usis = USIS(uart->uart_nr);
@@ -375,62 +420,264 @@ uart_resize_rx_buffer(uart_t* uart, size_t new_size)
     if(uart == NULL || !uart->rx_enabled)
         return 0;
 
-    if(uart->rx_buffer->size == new_size)
-        return uart->rx_buffer->size;
+    if(uart->rx_buffer->size() == spsc_ringbuf<uint8_t>::roundup(new_size))
+        return uart->rx_buffer->size();
 
-    uint8_t * new_buf = (uint8_t*)malloc(new_size);
-    if(!new_buf)
-        return uart->rx_buffer->size;
+    auto new_ring = new (std::nothrow) spsc_ringbuf<uint8_t>(new_size);
+    if(!new_ring || !new_ring->valid())
+    {
+        delete new_ring;
+        return uart->rx_buffer->size();
+    }
 
-    size_t new_wpos = 0;
     ETS_UART_INTR_DISABLE();
-    while(uart_rx_available_unsafe(uart) && new_wpos < new_size)
-        new_buf[new_wpos++] = uart_read_char_unsafe(uart); //if uart_rx_available_unsafe() returns non-0, uart_read_char_unsafe() can't return -1
-    if (new_wpos == new_size)
-        new_wpos = 0;
-
-    uint8_t * old_buf = uart->rx_buffer->buffer;
-    uart->rx_buffer->rpos = 0;
-    uart->rx_buffer->wpos = new_wpos;
-    uart->rx_buffer->size = new_size;
-    uart->rx_buffer->buffer = new_buf;
+    // move pending bytes over; anything still in the hw fifo will be
+    // drained into the new ring by the isr
+    uint8_t data;
+    while(new_ring->room() && uart->rx_buffer->pop(data))
+        new_ring->push(data);
+    auto old_ring = uart->rx_buffer;
+    uart->rx_buffer = new_ring;
     ETS_UART_INTR_ENABLE();
-    free(old_buf);
-    return uart->rx_buffer->size;
+    delete old_ring;
+    return uart->rx_buffer->size();
 }
 
 size_t
 uart_get_rx_buffer_size(uart_t* uart)
 {
-    return uart && uart->rx_enabled? uart->rx_buffer->size: 0;
+    return uart && uart->rx_enabled? uart->rx_buffer->size(): 0;
+}
+
+bool
+uart_set_rx_flow_control(uart_t* uart, size_t high_watermark, size_t low_watermark)
+{
+    if(uart == NULL || uart->uart_nr != UART0 || !uart->rx_enabled)
+        return false;
+
+    if(high_watermark == 0)
+    {
+        // disable and release the line
+        ETS_UART_INTR_DISABLE();
+        uart->rx_flow_high = 0;
+        uart->rx_flow_low = 0;
+        USC0(uart->uart_nr) &= ~(1 << UCSWRTS);
+        uart->rx_flow_asserted = false;
+        ETS_UART_INTR_ENABLE();
+        return true;
+    }
+
+    if(low_watermark >= high_watermark || high_watermark > uart->rx_buffer->size())
+        return false;
+
+    // GPIO15 becomes U0RTS; with the swapped pin set it is already TXD
+    if(uart->tx_pin == 15)
+        return false;
+    pinMode(15, FUNCTION_4); // U0RTS
+
+    ETS_UART_INTR_DISABLE();
+    uart->rx_flow_high = high_watermark;
+    uart->rx_flow_low = low_watermark;
+    USC0(uart->uart_nr) &= ~(1 << UCSWRTS);
+    uart->rx_flow_asserted = false;
+    ETS_UART_INTR_ENABLE();
+    return true;
+}
+
+bool
+uart_set_rx_framing(uart_t* uart, int terminator, size_t fixed_length,
+                    uart_frame_notify_t notify, void* notify_arg)
+{
+    if(uart == NULL || uart->uart_nr != UART0 || !uart->rx_enabled)
+        return false;
+
+    if(terminator < 0 && fixed_length == 0)
+    {
+        // disable: detach the producer first, then free the frame queue
+        ETS_UART_INTR_DISABLE();
+        auto old_frames = uart->rx_frames;
+        uart->rx_frames = NULL;
+        uart->rx_frame_notify = NULL;
+        ETS_UART_INTR_ENABLE();
+        delete old_frames;
+        return true;
+    }
+
+    // frame lengths are recorded as uint16_t and a frame must fit the ring
+    if(fixed_length > 65535 || fixed_length > uart->rx_buffer->size())
+        return false;
+
+    auto frames = uart->rx_frames;
+    if(!frames)
+    {
+        frames = new (std::nothrow) spsc_ringbuf<uint16_t>(16);
+        if(!frames || !frames->valid())
+        {
+            delete frames;
+            return false;
+        }
+    }
+
+    ETS_UART_INTR_DISABLE();
+    uart->rx_frame_by_length = terminator < 0;
+    uart->rx_frame_terminator = terminator < 0? 0: (uint8_t)terminator;
+    uart->rx_frame_length = fixed_length;
+    uart->rx_frame_fill = 0;
+    uart->rx_frame_notify = notify;
+    uart->rx_frame_notify_arg = notify_arg;
+    uart->rx_frames = frames;
+    ETS_UART_INTR_ENABLE();
+
+    // byte counting starts now: discard anything already buffered so the
+    // first frame does not begin mid-stream (consumer side, lock-free)
+    uart->rx_frames->flush();
+    uart->rx_buffer->flush();
+    uart_rx_flow_release(uart);
+    return true;
+}
+
+size_t
+uart_rx_deliver_frames(uart_t* uart,
+                       void (*cb)(void* arg, const char* data, size_t len), void* arg)
+{
+    if(uart == NULL || !uart->rx_enabled || !uart->rx_frames || !cb)
+        return 0;
+
+    size_t delivered = 0;
+    uint16_t len;
+    while(uart->rx_frames->pop(len))
+    {
+        // the boundary was recorded after the frame's last byte entered the
+        // ring, so all len bytes are available to us (the single consumer)
+        size_t contiguous;
+        const char* p = (const char*)uart->rx_buffer->peek(contiguous);
+        if(contiguous >= len)
+        {
+            cb(arg, p, len);
+            uart->rx_buffer->consume(len);
+            ++delivered;
+        }
+        else
+        {
+            // frame wraps the ring end: linearize through a bounce buffer
+            char* bounce = (char*)malloc(len);
+            if(bounce)
+            {
+                uart->rx_buffer->pop((uint8_t*)bounce, len);
+                cb(arg, bounce, len);
+                free(bounce);
+                ++delivered;
+            }
+            else
+            {
+                // cannot linearize: drop the frame, flagged like any
+                // other data loss
+                uart->rx_buffer->consume(len);
+                uart->rx_overrun = true;
+            }
+        }
+        uart_rx_flow_release(uart);
+    }
+    return delivered;
+}
+
+static void uart_start_isr(uart_t* uart);
+
+// Install (new_size > 0) or remove (new_size == 0) the interrupt-driven
+// tx ring.  UART0 only: the shared uart isr does not serve UART1, and gdb
+// owns the isr and tx path when attached.  Returns the granted size.
+size_t
+uart_resize_tx_buffer(uart_t* uart, size_t new_size)
+{
+    if(uart == NULL || !uart->tx_enabled || uart->uart_nr != UART0
+       || gdbstub_has_uart_isr_control())
+        return 0;
+
+    if(new_size == 0)
+    {
+        if(uart->tx_buffer)
+        {
+            uart_wait_tx_empty(uart);
+            ETS_UART_INTR_DISABLE();
+            USIE(uart->uart_nr) &= ~(1 << UIFE);
+            auto old_ring = uart->tx_buffer;
+            uart->tx_buffer = NULL;
+            ETS_UART_INTR_ENABLE();
+            delete old_ring;
+        }
+        return 0;
+    }
+
+    if(uart->tx_buffer && uart->tx_buffer->size() == spsc_ringbuf<uint8_t>::roundup(new_size))
+        return uart->tx_buffer->size();
+
+    auto new_ring = new (std::nothrow) spsc_ringbuf<uint8_t>(new_size);
+    if(!new_ring || !new_ring->valid())
+    {
+        delete new_ring;
+        return uart->tx_buffer? uart->tx_buffer->size(): 0;
+    }
+
+    if(uart->tx_buffer)
+    {
+        // drain what is pending, then swap
+        uart_wait_tx_empty(uart);
+        ETS_UART_INTR_DISABLE();
+        USIE(uart->uart_nr) &= ~(1 << UIFE);
+        auto old_ring = uart->tx_buffer;
+        uart->tx_buffer = new_ring;
+        ETS_UART_INTR_ENABLE();
+        delete old_ring;
+    }
+    else
+    {
+        uart->tx_buffer = new_ring;
+        if(!uart->rx_enabled)
+            // rx did not attach the isr, the tx ring needs it
+            uart_start_isr(uart);
+    }
+    return uart->tx_buffer->size();
+}
+
+size_t
+uart_get_tx_buffer_size(uart_t* uart)
+{
+    return uart && uart->tx_buffer? uart->tx_buffer->size(): 0;
 }
 
 // The default ISR handler called when GDB is not enabled
 void IRAM_ATTR
 uart_isr(void * arg, void * frame)
 {
+    PROFILE_SCOPE("uart_isr");
     (void) frame;
     uart_t* uart = (uart_t*)arg;
     uint32_t usis = USIS(uart->uart_nr);
 
-    if(uart == NULL || !uart->rx_enabled)
+    if(uart == NULL || (!uart->rx_enabled && !uart->tx_buffer))
     {
         USIC(uart->uart_nr) = usis;
         ETS_UART_INTR_DISABLE();
         return;
     }
 
-    if(usis & (1 << UIFF))
-        uart_rx_copy_fifo_to_buffer_unsafe(uart);
-
-    if(usis & (1 << UIOF))
+    if(uart->rx_enabled)
     {
-        uart->rx_overrun = true;
-        //os_printf_plus(overrun_str);
+        if(usis & (1 << UIFF))
+            uart_rx_copy_fifo_to_buffer_unsafe(uart);
+
+        if(usis & (1 << UIOF))
+        {
+            uart->rx_overrun = true;
+            //os_printf_plus(overrun_str);
+        }
+
+        if (usis & ((1 << UIFR) | (1 << UIPE) | (1 << UITO)))
+            uart->rx_error = true;
     }
 
-    if (usis & ((1 << UIFR) | (1 << UIPE) | (1 << UITO)))
-        uart->rx_error = true;
+    if(uart->tx_buffer && (usis & (1 << UIFE)))
+        uart_tx_refill_fifo_unsafe(uart);
 
     USIC(uart->uart_nr) = usis;
 }
@@ -438,7 +685,7 @@ uart_isr(void * arg, void * frame)
 static void
 uart_start_isr(uart_t* uart)
 {
-    if(uart == NULL || !uart->rx_enabled)
+    if(uart == NULL || (!uart->rx_enabled && !uart->tx_buffer))
         return;
 
     if(gdbstub_has_uart_isr_control()) {
@@ -456,8 +703,12 @@ uart_start_isr(uart_t* uart)
     // was 100, use 16 to stay away from overrun
     #define INTRIGG 16
 
+    // TX fifo-empty threshold: fire the refill interrupt while 16 bytes
+    // are still queued so the line never idles between refills
+    #define TXTRIGG 16
+
     //was:USC1(uart->uart_nr) = (INTRIGG << UCFFT) | (0x02 << UCTOT) | (1 <<UCTOE);
-    USC1(uart->uart_nr) = (INTRIGG << UCFFT);
+    USC1(uart->uart_nr) = (INTRIGG << UCFFT) | (TXTRIGG << UCFET);
     USIC(uart->uart_nr) = 0xffff;
     //was: USIE(uart->uart_nr) = (1 << UIFF) | (1 << UIFR) | (1 << UITO);
     // UIFF: rx fifo full
@@ -465,7 +716,9 @@ uart_start_isr(uart_t* uart)
     // UIFR: frame error
     // UIPE: parity error
     // UITO: rx fifo timeout
-    USIE(uart->uart_nr) = (1 << UIFF) | (1 << UIOF) | (1 << UIFR) | (1 << UIPE) | (1 << UITO);
+    // UIFE (tx fifo empty) is enabled on demand while the tx ring drains
+    USIE(uart->uart_nr) = uart->rx_enabled?
+        (1 << UIFF) | (1 << UIOF) | (1 << UIFR) | (1 << UIPE) | (1 << UITO): 0;
     ETS_UART_INTR_ATTACH(uart_isr,  (void *)uart);
     ETS_UART_INTR_ENABLE();
 }
@@ -473,7 +726,7 @@ uart_start_isr(uart_t* uart)
 static void
 uart_stop_isr(uart_t* uart)
 {
-    if(uart == NULL || !uart->rx_enabled)
+    if(uart == NULL || (!uart->rx_enabled && !uart->tx_buffer))
         return;
 
     if(gdbstub_has_uart_isr_control()) {
@@ -488,25 +741,6 @@ uart_stop_isr(uart_t* uart)
     ETS_UART_INTR_ATTACH(NULL, NULL);
 }
 
-/*
-  Reference for uart_tx_fifo_available() and uart_tx_fifo_full():
-  -Espressif Techinical Reference doc, chapter 11.3.7
-  -tools/sdk/uart_register.h
-  -cores/esp8266/esp8266_peri.h
-  */
-inline __attribute__((always_inline)) size_t
-uart_tx_fifo_available(const int uart_nr)
-{
-    return (USS(uart_nr) >> USTXC) & 0xff;
-}
-
-inline __attribute__((always_inline)) bool
-uart_tx_fifo_full(const int uart_nr)
-{
-    return uart_tx_fifo_available(uart_nr) >= 0x7f;
-}
-
-
 static void
 uart_do_write_char(const int uart_nr, char c)
 {
@@ -515,6 +749,22 @@ uart_do_write_char(const int uart_nr, char c)
     USF(uart_nr) = c;
 }
 
+// Make sure the isr is draining the tx ring: prime the hw fifo directly
+// when the fifo-empty interrupt is masked (i.e. the ring was empty), then
+// unmask it while data remains queued.
+static void
+uart_tx_kick(uart_t* uart)
+{
+    ETS_UART_INTR_DISABLE();
+    if (!(USIE(uart->uart_nr) & (1 << UIFE)))
+    {
+        uart_tx_refill_fifo_unsafe(uart);
+        if (uart->tx_buffer->available())
+            USIE(uart->uart_nr) |= (1 << UIFE);
+    }
+    ETS_UART_INTR_ENABLE();
+}
+
 size_t
 uart_write_char(uart_t* uart, char c)
 {
@@ -525,6 +775,18 @@ uart_write_char(uart_t* uart, char c)
         gdbstub_write_char(c);
         return 1;
     }
+
+    if(uart->tx_buffer)
+    {
+        while (!uart->tx_buffer->push(c))
+        {
+            uart_tx_kick(uart);
+            optimistic_yield(10000UL);
+        }
+        uart_tx_kick(uart);
+        return 1;
+    }
+
     uart_do_write_char(uart->uart_nr, c);
     return 1;
 }
@@ -542,6 +804,25 @@ uart_write(uart_t* uart, const char* buf, size_t size)
 
     size_t ret = size;
     const int uart_nr = uart->uart_nr;
+
+    if(uart->tx_buffer)
+    {
+        // bytewise because buf may live in flash (see pgm_read_byte below)
+        while (size)
+        {
+            if (uart->tx_buffer->push(pgm_read_byte(buf)))
+            {
+                ++buf;
+                --size;
+                continue;
+            }
+            uart_tx_kick(uart);
+            optimistic_yield(10000UL);
+        }
+        uart_tx_kick(uart);
+        return ret;
+    }
+
     while (size--) {
         uart_do_write_char(uart_nr, pgm_read_byte(buf++));
         optimistic_yield(10000UL);
@@ -557,7 +838,8 @@ uart_tx_free(uart_t* uart)
     if(uart == NULL || !uart->tx_enabled)
         return 0;
 
-    return UART_TX_FIFO_SIZE - uart_tx_fifo_available(uart->uart_nr);
+    return UART_TX_FIFO_SIZE - uart_tx_fifo_available(uart->uart_nr)
+        + (uart->tx_buffer? uart->tx_buffer->room(): 0);
 }
 
 void
@@ -566,7 +848,8 @@ uart_wait_tx_empty(uart_t* uart)
     if(uart == NULL || !uart->tx_enabled)
         return;
 
-    while(uart_tx_fifo_available(uart->uart_nr) > 0)
+    while((uart->tx_buffer && uart->tx_buffer->available())
+          || uart_tx_fifo_available(uart->uart_nr) > 0)
         esp_yield();
 
 }
@@ -581,14 +864,31 @@ uart_flush(uart_t* uart)
     if(uart->rx_enabled)
     {
         tmp |= (1 << UCRXRST);
-        ETS_UART_INTR_DISABLE();
-        uart->rx_buffer->rpos = 0;
-        uart->rx_buffer->wpos = 0;
-        ETS_UART_INTR_ENABLE();
+        // consumer-side discard, safe without disabling the isr
+        uart->rx_buffer->flush();
+        if(uart->rx_frames)
+        {
+            uart->rx_frames->flush();
+            // the fill counter belongs to the producer
+            ETS_UART_INTR_DISABLE();
+            uart->rx_frame_fill = 0;
+            ETS_UART_INTR_ENABLE();
+        }
+        uart_rx_flow_release(uart);
     }
 
     if(uart->tx_enabled)
+    {
+        if(uart->tx_buffer)
+        {
+            // drop whatever the isr has not sent yet
+            ETS_UART_INTR_DISABLE();
+            USIE(uart->uart_nr) &= ~(1 << UIFE);
+            uart->tx_buffer->flush();
+            ETS_UART_INTR_ENABLE();
+        }
         tmp |= (1 << UCTXRST);
+    }
 
     if(!gdbstub_has_uart_isr_control() || uart->uart_nr != UART0) {
         USC0(uart->uart_nr) |= (tmp);
@@ -625,6 +925,14 @@ uart_init(int uart_nr, int baudrate, int config, int mode, int tx_pin, size_t rx
     uart->uart_nr = uart_nr;
     uart->rx_overrun = false;
     uart->rx_error = false;
+    uart->tx_buffer = NULL;
+    uart->rx_flow_high = 0;
+    uart->rx_flow_low = 0;
+    uart->rx_flow_asserted = false;
+    uart->rx_frame_fill = 0;
+    uart->rx_frames = NULL;
+    uart->rx_frame_notify = NULL;
+    uart->rx_frame_notify_arg = NULL;
 
     switch(uart->uart_nr)
     {
@@ -638,19 +946,10 @@ uart_init(int uart_nr, int baudrate, int config, int mode, int tx_pin, size_t rx
         uart->rx_pin = (uart->rx_enabled)?3:255;
         if(uart->rx_enabled)
         {
-            struct uart_rx_buffer_ * rx_buffer = (struct uart_rx_buffer_ *)malloc(sizeof(struct uart_rx_buffer_));
-            if(rx_buffer == NULL)
+            auto rx_buffer = new (std::nothrow) spsc_ringbuf<uint8_t>(rx_size);
+            if(rx_buffer == NULL || !rx_buffer->valid())
             {
-              free(uart);
-              return NULL;
-            }
-            rx_buffer->size = rx_size;//var this
-            rx_buffer->rpos = 0;
-            rx_buffer->wpos = 0;
-            rx_buffer->buffer = (uint8_t *)malloc(rx_buffer->size);
-            if(rx_buffer->buffer == NULL)
-            {
-              free(rx_buffer);
+              delete rx_buffer;
               free(uart);
               return NULL;
             }
@@ -726,8 +1025,15 @@ uart_uninit(uart_t* uart)
     if(uart == NULL)
         return;
 
+    if(uart->tx_buffer)
+        // let the isr push out what is still queued before detaching it
+        uart_wait_tx_empty(uart);
+
     uart_stop_isr(uart);
 
+    delete uart->tx_buffer;
+    uart->tx_buffer = NULL;
+
     if(uart->tx_enabled && (!gdbstub_has_uart_isr_control() || uart->uart_nr != UART0)) {
         switch(uart->tx_pin)
         {
@@ -744,8 +1050,8 @@ uart_uninit(uart_t* uart)
     }
 
     if(uart->rx_enabled) {
-        free(uart->rx_buffer->buffer);
-        free(uart->rx_buffer);
+        delete uart->rx_frames;
+        delete uart->rx_buffer;
         if(!gdbstub_has_uart_isr_control()) {
             switch(uart->rx_pin)
             {
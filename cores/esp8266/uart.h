@@ -128,6 +128,19 @@ int uart_get_baudrate(uart_t* uart);
 size_t uart_resize_rx_buffer(uart_t* uart, size_t new_size);
 size_t uart_get_rx_buffer_size(uart_t* uart);
 
+// Automatic RTS flow control against the rx ring (UART0 only): GPIO15 is
+// muxed to U0RTS and the sender is stopped once the ring holds at least
+// high_watermark bytes, released again when the consumer drained it to
+// low_watermark.  high_watermark = 0 disables and releases the line.
+// Watermarks refer to the rx ring (see uart_resize_rx_buffer) and must be
+// reconfigured after resizing it.  Returns false on invalid arguments or
+// when GPIO15 already serves as TXD (swapped pins).
+bool uart_set_rx_flow_control(uart_t* uart, size_t high_watermark, size_t low_watermark);
+
+// interrupt-driven tx ring (UART0 only), 0 = blocking writes (default)
+size_t uart_resize_tx_buffer(uart_t* uart, size_t new_size);
+size_t uart_get_tx_buffer_size(uart_t* uart);
+
 size_t uart_write_char(uart_t* uart, char c);
 size_t uart_write(uart_t* uart, const char* buf, size_t size);
 int uart_read_char(uart_t* uart);
@@ -147,6 +160,27 @@ int uart_get_debug();
 void uart_start_detect_baudrate(int uart_nr);
 int uart_detect_baudrate(int uart_nr);
 
+// RX line framing: the producer (isr) marks message boundaries in the rx ring
+// as bytes arrive - at each occurrence of the terminator byte (terminator >= 0)
+// or every fixed_length bytes (terminator < 0, fixed_length > 0).  notify is
+// invoked from isr context each time a frame completes (keep it short and in
+// IRAM; typically it schedules delivery).  Collect completed frames with
+// uart_rx_deliver_frames().  While framing is enabled the regular read()/peek()
+// calls must not be used (same restriction as peekBuffer).  Anything already
+// buffered when framing is enabled is discarded so the first frame does not
+// start mid-stream.  terminator < 0 and fixed_length == 0 disables.  UART0 only.
+typedef void (*uart_frame_notify_t)(void* arg);
+bool uart_set_rx_framing(uart_t* uart, int terminator, size_t fixed_length,
+                         uart_frame_notify_t notify, void* notify_arg);
+
+// Deliver every completed frame to cb as a (data,len) view into the rx ring:
+// zero-copy when the frame lies contiguously in the ring, bounced through a
+// temporary when it wraps the ring end (dropped and flagged as overrun if that
+// allocation fails).  The view is only valid during the call.  Returns the
+// number of frames delivered.  Call from user context only.
+size_t uart_rx_deliver_frames(uart_t* uart,
+                              void (*cb)(void* arg, const char* data, size_t len), void* arg);
+
 // return number of byte accessible by peekBuffer()
 size_t uart_peek_available (uart_t* uart);
 
@@ -162,6 +162,10 @@ void *umm_info(void *ptr, bool force) {
     umm_print_stats(force);
     #endif
 
+    #ifdef UMM_SIZE_CLASS_POOLS
+    umm_pool_info_core(force);
+    #endif
+
     /* Release the critical section... */
     UMM_CRITICAL_EXIT(id_info);
 
@@ -203,6 +207,52 @@ size_t umm_max_block_size(void) {
     return umm_max_block_size_core(umm_get_current_heap());
 }
 
+/*
+  Lightweight largest-free-block query. With UMM_INLINE_METRICS,
+  maxFreeContiguousBlocks is maintained incrementally as blocks enter and
+  leave the free list, making this O(1) in the common case. When the block
+  that held the maximum has been carved up or consumed, the tracked value may
+  overstate reality and the stale flag is set; only then do we rescan, and we
+  follow the free list instead of walking every block like umm_info() does.
+  Without UMM_INLINE_METRICS this degrades to the umm_info() based
+  umm_max_block_size().
+*/
+size_t umm_max_block_size_lw(void) {
+    #ifdef UMM_INLINE_METRICS
+    UMM_CRITICAL_DECL(id_info);
+    size_t size;
+
+    UMM_CHECK_INITIALIZED();
+
+    UMM_CRITICAL_ENTRY(id_info);
+
+    umm_heap_context_t *_context = umm_get_current_heap();
+
+    if (_context->info.maxFreeContiguousStale) {
+        uint16_t cf;
+        unsigned int maxBlocks = 0;
+
+        for (cf = UMM_NFREE(0); cf; cf = UMM_NFREE(cf)) {
+            uint16_t blocks = (UMM_NBLOCK(cf) & UMM_BLOCKNO_MASK) - cf;
+            if (blocks > maxBlocks) {
+                maxBlocks = blocks;
+            }
+        }
+
+        _context->info.maxFreeContiguousBlocks = maxBlocks;
+        _context->info.maxFreeContiguousStale = 0;
+    }
+
+    size = umm_max_block_size_core(_context);
+
+    UMM_CRITICAL_EXIT(id_info);
+
+    return size;
+    #else
+    return umm_max_block_size();
+    #endif
+}
+
 /*
   Without build option UMM_INLINE_METRICS, calls to umm_usage_metric() or
   umm_fragmentation_metric() must to be preceded by a call to umm_info(NULL, false)
@@ -251,6 +301,8 @@ int umm_fragmentation_metric(void) {
 static void umm_fragmentation_metric_init(umm_heap_context_t *_context) {
     _context->info.freeBlocks = UMM_NUMBLOCKS - 2;
     _context->info.freeBlocksSquared = _context->info.freeBlocks * _context->info.freeBlocks;
+    _context->info.maxFreeContiguousBlocks = _context->info.freeBlocks;
+    _context->info.maxFreeContiguousStale = 0;
 }
 
 static void umm_fragmentation_metric_add(umm_heap_context_t *_context, uint16_t c) {
@@ -258,6 +310,10 @@ static void umm_fragmentation_metric_add(umm_heap_context_t *_context, uint16_t
     DBGLOG_DEBUG("Add block %d size %d to free metric\n", c, blocks);
     _context->info.freeBlocks += blocks;
     _context->info.freeBlocksSquared += (blocks * blocks);
+    /* A bigger free block can only raise the maximum. */
+    if (blocks > _context->info.maxFreeContiguousBlocks) {
+        _context->info.maxFreeContiguousBlocks = blocks;
+    }
 }
 
 static void umm_fragmentation_metric_remove(umm_heap_context_t *_context, uint16_t c) {
@@ -265,6 +321,13 @@ static void umm_fragmentation_metric_remove(umm_heap_context_t *_context, uint16
     DBGLOG_DEBUG("Remove block %d size %d from free metric\n", c, blocks);
     _context->info.freeBlocks -= blocks;
     _context->info.freeBlocksSquared -= (blocks * blocks);
+    /*
+     * Removing the (or a same-sized) maximum block may lower the maximum;
+     * defer the free-list rescan to umm_max_block_size_lw().
+     */
+    if (blocks >= _context->info.maxFreeContiguousBlocks) {
+        _context->info.maxFreeContiguousStale = 1;
+    }
 }
 #endif // UMM_INLINE_METRICS
 
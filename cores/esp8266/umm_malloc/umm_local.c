@@ -92,7 +92,7 @@ static void *get_unpoisoned_check_neighbors(void *vptr, const char *file, int li
 
     if (ptr != 0) {
 
-        ptr -= (sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_SIZE_BEFORE);
+        ptr -= (sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE + UMM_POISON_SIZE_BEFORE);
 
         #if defined(UMM_POISON_CHECK_LITE)
         UMM_CRITICAL_DECL(id_poison);
@@ -391,5 +391,101 @@ size_t umm_umul_sat(const size_t a, const size_t b) {
     return r;
 }
 
+#ifdef UMM_HEAP_TRACE
+/*
+ * Heap-usage flight recorder.
+ *
+ * umm_trace_record() is called from within the umm_malloc/umm_realloc/umm_free
+ * critical sections, so the recorder state needs no locking of its own there.
+ * The read accessors run from the foreground and take the usual critical
+ * section while copying an entry out.
+ */
+
+static UMM_TRACE_EVENT umm_trace_ring[UMM_HEAP_TRACE];
+static UMM_TRACE_SITE umm_trace_sites[UMM_HEAP_TRACE_SITES];
+static uint32_t umm_trace_total = 0;      /* events ever recorded */
+static bool umm_trace_paused = false;
+
+void umm_trace_record(const void *caller, size_t size, uint32_t op) {
+    if (umm_trace_paused) {
+        return;
+    }
+
+    UMM_TRACE_EVENT *event = &umm_trace_ring[umm_trace_total % UMM_HEAP_TRACE];
+    umm_trace_total++;
+    event->caller = (uint32_t)caller;
+    event->size = (uint32_t)size;
+    event->ccount = esp_get_cycle_count();
+    event->op = op;
+
+    if (op != UMM_TRACE_OP_MALLOC && op != UMM_TRACE_OP_REALLOC) {
+        return;
+    }
+
+    /* Aggregate allocations per caller; the last slot absorbs the overflow
+     * once all the others are taken. */
+    size_t i;
+    for (i = 0; i < UMM_HEAP_TRACE_SITES - 1; i++) {
+        if (umm_trace_sites[i].caller == (uint32_t)caller || 0 == umm_trace_sites[i].caller) {
+            break;
+        }
+    }
+    UMM_TRACE_SITE *site = &umm_trace_sites[i];
+    site->caller = (i < UMM_HEAP_TRACE_SITES - 1) ? (uint32_t)caller : 0xFFFFFFFFu;
+    site->count++;
+    site->total += size;
+    if (size > site->largest) {
+        site->largest = size;
+    }
+}
+
+uint32_t ICACHE_FLASH_ATTR umm_trace_event_count(void) {
+    return (umm_trace_total < UMM_HEAP_TRACE) ? umm_trace_total : UMM_HEAP_TRACE;
+}
+
+bool ICACHE_FLASH_ATTR umm_trace_event_at(uint32_t index, UMM_TRACE_EVENT *event) {
+    UMM_CRITICAL_DECL(id_no_tag);
+    bool found = false;
+
+    if (event) {
+        UMM_CRITICAL_ENTRY(id_no_tag);
+        uint32_t count = umm_trace_event_count();
+        if (index < count) {
+            *event = umm_trace_ring[(umm_trace_total - count + index) % UMM_HEAP_TRACE];
+            found = true;
+        }
+        UMM_CRITICAL_EXIT(id_no_tag);
+    }
+    return found;
+}
+
+bool ICACHE_FLASH_ATTR umm_trace_site_at(size_t index, UMM_TRACE_SITE *site) {
+    UMM_CRITICAL_DECL(id_no_tag);
+    bool found = false;
+
+    if (site && index < UMM_HEAP_TRACE_SITES) {
+        UMM_CRITICAL_ENTRY(id_no_tag);
+        if (umm_trace_sites[index].caller) {
+            *site = umm_trace_sites[index];
+            found = true;
+        }
+        UMM_CRITICAL_EXIT(id_no_tag);
+    }
+    return found;
+}
+
+void ICACHE_FLASH_ATTR umm_trace_pause(bool pause) {
+    umm_trace_paused = pause;
+}
+
+void ICACHE_FLASH_ATTR umm_trace_reset(void) {
+    UMM_CRITICAL_DECL(id_no_tag);
+
+    UMM_CRITICAL_ENTRY(id_no_tag);
+    umm_trace_total = 0;
+    memset(umm_trace_sites, 0, sizeof(umm_trace_sites));
+    UMM_CRITICAL_EXIT(id_no_tag);
+}
+#endif // UMM_HEAP_TRACE
 
 #endif // BUILD_UMM_MALLOC_C
@@ -131,6 +131,24 @@ static size_t umm_heap_cur = UMM_HEAP_DRAM;
 static int umm_heap_stack_ptr = 0;
 static unsigned char umm_heap_stack[UMM_HEAP_STACK_DEPTH];
 #endif
+
+#ifdef UMM_HEAP_EXTERNAL
+/*
+ * Size-threshold placement policy for the external (VM) heap: requests of
+ * at least this many bytes are served from the external heap first, with
+ * the normal heap as fallback. 0 (default) disables the redirection. See
+ * umm_malloc() and EspClass::setExternalHeapThreshold().
+ */
+static size_t umm_vm_threshold = 0;
+
+void umm_set_vm_threshold(size_t size) {
+    umm_vm_threshold = size;
+}
+
+size_t umm_get_vm_threshold(void) {
+    return umm_vm_threshold;
+}
+#endif
 /* ------------------------------------------------------------------------ */
 /*
  * Methods to get heap id or context
@@ -257,7 +275,7 @@ static umm_heap_context_t *umm_get_ptr_context(const void *const ptr) {
 
     [[maybe_unused]] uintptr_t sketch_ptr = (uintptr_t)ptr;
     #if defined(UMM_POISON_CHECK) || defined(UMM_POISON_CHECK_LITE)
-    sketch_ptr += sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_SIZE_BEFORE;
+    sketch_ptr += sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE + UMM_POISON_SIZE_BEFORE;
     #endif
     DBGLOG_ERROR("\nPointer %p is not a Heap address.\n", (void *)sketch_ptr);
     abort();
@@ -295,6 +313,7 @@ static umm_heap_context_t *umm_get_ptr_context(const void *const ptr) {
 
 #include "umm_integrity.c"
 #include "umm_poison.c"
+#include "umm_pools.c"
 #include "umm_info.c"
 #include "umm_local.c"      // target-dependent supplemental features
 
@@ -682,6 +701,15 @@ void umm_free(void *ptr) {
 
     UMM_CRITICAL_ENTRY(id_free);
 
+    UMM_TRACE_RECORD(UMM_TRACE_OP_FREE, 0);
+
+    #ifdef UMM_SIZE_CLASS_POOLS
+    if (umm_pool_free(ptr)) {
+        UMM_CRITICAL_EXIT(id_free);
+        return;
+    }
+    #endif
+
     /* Need to be in the heap in which this block lives */
     umm_free_core(umm_get_ptr_context(ptr), ptr);
 
@@ -906,11 +934,39 @@ void *umm_malloc(size_t size) {
     if (UMM_CRITICAL_WITHINISR(id_malloc)) {
         _context = umm_get_heap_by_id(UMM_HEAP_DRAM);
     }
+    #ifdef UMM_HEAP_EXTERNAL
+    /*
+     * Placement policy: requests at or above the configured threshold are
+     * presumed cold and bulky (response buffers, caches, ...) and land in
+     * the external VM heap, keeping the scarce DRAM for small hot objects.
+     * DRAM remains the fallback when the VM heap is absent or full. An
+     * explicit umm_push_heap() selection or an ISR is never redirected.
+     */
+    else if (umm_vm_threshold && size >= umm_vm_threshold
+        && umm_heap_cur == UMM_HEAP_DRAM) {
+        umm_heap_context_t *_vm_context = umm_get_heap_by_id(UMM_HEAP_EXTERNAL);
+        if (_vm_context && _vm_context->heap) {
+            void *vm_ptr = umm_malloc_core(_vm_context, size);
+            if (vm_ptr) {
+                vm_ptr = POISON_CHECK_SET_POISON(vm_ptr, size);
+                UMM_TRACE_RECORD(UMM_TRACE_OP_MALLOC, size);
+                UMM_CRITICAL_EXIT(id_malloc);
+                return vm_ptr;
+            }
+        }
+    }
+    #endif
 
+    #ifdef UMM_SIZE_CLASS_POOLS
+    ptr = umm_pool_malloc(_context, size);
+    if (NULL == ptr)
+    #endif
     ptr = umm_malloc_core(_context, size);
 
     ptr = POISON_CHECK_SET_POISON(ptr, size);
 
+    UMM_TRACE_RECORD(ptr ? UMM_TRACE_OP_MALLOC : UMM_TRACE_OP_FAIL, size);
+
     UMM_CRITICAL_EXIT(id_malloc);
 
     return ptr;
@@ -967,6 +1023,16 @@ void *umm_realloc(void *ptr, size_t size) {
 
     STATS__ALLOC_REQUEST(id_realloc, size);
 
+    #ifdef UMM_SIZE_CLASS_POOLS
+    /*
+     * Pool chunks are not umm blocks; the block arithmetic below does not
+     * apply to them. Grow out of the pool with malloc-copy-free instead.
+     */
+    if (umm_pool_contains(ptr)) {
+        return umm_pool_realloc(ptr, size);
+    }
+    #endif
+
     /*
      * Otherwise we need to actually do a reallocation. A naiive approach
      * would be to malloc() a new block of the correct size, copy the old data
@@ -993,6 +1059,8 @@ void *umm_realloc(void *ptr, size_t size) {
     /* Protect the critical section... */
     UMM_CRITICAL_ENTRY(id_realloc);
 
+    UMM_TRACE_RECORD(UMM_TRACE_OP_REALLOC, size);
+
     /* Now figure out if the previous and/or next blocks are free as well as
      * their sizes - this will help us to minimize special code later when we
      * decide if it's possible to use the adjacent blocks.
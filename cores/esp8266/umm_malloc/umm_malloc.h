@@ -22,6 +22,10 @@ extern "C" {
 
 #ifdef UMM_HEAP_EXTERNAL
 extern void  umm_init_vm(void *vmaddr, unsigned int vmsize);
+/* Allocations of at least this size are placed in the external heap first,
+   DRAM as fallback; 0 (default) disables the redirection. */
+extern void   umm_set_vm_threshold(size_t size);
+extern size_t umm_get_vm_threshold(void);
 #endif
 #ifdef UMM_HEAP_IRAM
 extern void umm_init_iram(void);
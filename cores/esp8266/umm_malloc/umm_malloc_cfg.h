@@ -86,6 +86,23 @@ extern "C" {
  * Note this uses an extra 8 bytes per allocation, but you get the benefit of
  * being able to detect if your program is writing past an allocated buffer.
  *
+ * UMM_SIZE_CLASS_POOLS
+ *
+ * Set if you want small allocations (up to 16/32/64 bytes) served from
+ * O(1) segregated-fit free lists carved out of the DRAM heap instead of
+ * the first-fit search, reducing long-uptime fragmentation from mixed
+ * allocation patterns. Pool arenas are allocated lazily; exhausted or
+ * disabled classes fall back to first-fit. Chunk counts are tunable with
+ * UMM_POOL_COUNT_16/_32/_64 (see umm_pools.c), and per-class statistics
+ * are appended to the umm_info() report.
+ *
+ * UMM_HEAP_TRACE
+ *
+ * Set if you want a small flight recorder of recent heap operations
+ * (caller PC, size, operation, cycle count) plus a per-caller allocation
+ * aggregation table, for investigating fragmentation and heap churn over
+ * time. Dump with ESP.dumpHeapTrace(Serial). See below for details.
+ *
  * UMM_DBG_LOG_LEVEL=n
  *
  * Set n to a value from 0 to 6 depending on how verbose you want the debug
@@ -188,6 +205,9 @@ typedef struct UMM_HEAP_INFO_t {
     size_t oom_count;
     #define UMM_OOM_COUNT info.oom_count
     #define UMM_FREE_BLOCKS info.freeBlocks
+    /* set when the tracked maxFreeContiguousBlocks may overstate reality,
+     * cleared by the free-list rescan in umm_max_block_size_lw() */
+    unsigned char maxFreeContiguousStale;
     #endif
     unsigned int maxFreeContiguousBlocks;
 }
@@ -195,6 +215,15 @@ UMM_HEAP_INFO;
 
 // extern UMM_HEAP_INFO ummHeapInfo;
 extern ICACHE_FLASH_ATTR void *umm_info(void *ptr, bool force);
+
+/*
+  Lightweight variant of umm_max_block_size(). With UMM_INLINE_METRICS the
+  largest free block is tracked incrementally on alloc/free and this is O(1);
+  only when the tracked maximum has been consumed is the free list rescanned
+  (O(free blocks), still much cheaper than the full umm_info() heap walk).
+  Without UMM_INLINE_METRICS it falls back to umm_info().
+*/
+extern size_t umm_max_block_size_lw(void);
 #if defined(UMM_STATS) || defined(UMM_STATS_FULL)
 extern ICACHE_FLASH_ATTR size_t umm_free_heap_size(void);
 extern ICACHE_FLASH_ATTR size_t umm_free_heap_size_core(umm_heap_context_t *_context);
@@ -545,6 +574,73 @@ extern void umm_corruption(void);
 
 /////////////////////////////////////////////////
 
+/*
+ * -D UMM_HEAP_TRACE :
+ * -D UMM_HEAP_TRACE=n
+ *
+ * Enables an opt-in heap-usage flight recorder: the most recent n (default
+ * 64) heap operations are kept in a ring of (caller PC, size, operation,
+ * CPU cycle count) events, recorded inside the umm_malloc/umm_realloc/
+ * umm_free critical sections. Alongside the ring, a small table aggregates
+ * allocations per caller PC (call count, total and largest request), so the
+ * sites responsible for churn and fragmentation can be read off directly.
+ * Decode caller PCs with addr2line against the matching .elf.
+ *
+ * Costs 16 bytes of DRAM per ring entry plus 16 bytes per aggregation slot
+ * (UMM_HEAP_TRACE_SITES, default 24) and a few cycles per heap call. Dump
+ * with ESP.dumpHeapTrace(Serial); no output formatting happens inside the
+ * allocator itself.
+ */
+/*
+#define UMM_HEAP_TRACE 64
+ */
+
+#ifdef UMM_HEAP_TRACE
+#if (UMM_HEAP_TRACE + 0) < 2      /* bare -DUMM_HEAP_TRACE selects the default depth */
+#undef UMM_HEAP_TRACE
+#define UMM_HEAP_TRACE 64
+#endif
+
+#ifndef UMM_HEAP_TRACE_SITES
+#define UMM_HEAP_TRACE_SITES 24
+#endif
+
+enum umm_trace_op {
+    UMM_TRACE_OP_MALLOC = 0,
+    UMM_TRACE_OP_FREE,
+    UMM_TRACE_OP_REALLOC,
+    UMM_TRACE_OP_FAIL       /* allocation request that returned NULL */
+};
+
+typedef struct UMM_TRACE_EVENT_t {
+    uint32_t caller;        /* PC of the umm_* entry point's caller */
+    uint32_t size;          /* requested size (0 for free) */
+    uint32_t ccount;        /* CPU cycle count when recorded */
+    uint32_t op;            /* enum umm_trace_op */
+} UMM_TRACE_EVENT;
+
+typedef struct UMM_TRACE_SITE_t {
+    uint32_t caller;        /* 0xFFFFFFFF identifies the table-full overflow slot */
+    uint32_t count;         /* allocation requests from this caller */
+    uint32_t total;         /* bytes requested in total */
+    uint32_t largest;       /* largest single request */
+} UMM_TRACE_SITE;
+
+extern void umm_trace_record(const void *caller, size_t size, uint32_t op);
+extern uint32_t umm_trace_event_count(void);
+extern bool umm_trace_event_at(uint32_t index, UMM_TRACE_EVENT *event); /* index 0 = oldest retained */
+extern bool umm_trace_site_at(size_t index, UMM_TRACE_SITE *site);
+extern void umm_trace_pause(bool pause);
+extern void umm_trace_reset(void);
+
+/* Must be expanded directly in the umm_* entry points, within their critical sections */
+#define UMM_TRACE_RECORD(op, size) umm_trace_record(__builtin_return_address(0), (size), (op))
+#else
+#define UMM_TRACE_RECORD(op, size) do {} while (false)
+#endif
+
+/////////////////////////////////////////////////
+
 /*
  * -D UMM_POISON_CHECK :
  * -D UMM_POISON_CHECK_LITE
@@ -609,6 +705,23 @@ extern void umm_corruption(void);
 #define UMM_POISON_SIZE_AFTER (4)
 #define UMM_POISONED_BLOCK_LEN_TYPE uint32_t
 
+/*
+ * UMM_POISON_CALLER_TAG - with UMM_POISON_CHECK_LITE, additionally store the
+ * caller PC of the owning allocation in the poison prefix (4 bytes per
+ * allocation) and print it in corruption reports, so an overrun caught at
+ * free() points back at the code that allocated the trampled buffer. Decode
+ * with addr2line, like the UMM_HEAP_TRACE flight recorder PCs. Implied by
+ * enabling UMM_HEAP_TRACE together with UMM_POISON_CHECK_LITE.
+ */
+#if defined(UMM_POISON_CHECK_LITE) && defined(UMM_HEAP_TRACE) && !defined(UMM_POISON_CALLER_TAG)
+#define UMM_POISON_CALLER_TAG
+#endif
+#if defined(UMM_POISON_CALLER_TAG)
+#define UMM_POISON_TAG_SIZE (4)
+#else
+#define UMM_POISON_TAG_SIZE (0)
+#endif
+
 #if defined(UMM_POISON_CHECK) || defined(UMM_POISON_CHECK_LITE)
 extern void *umm_poison_malloc(size_t size);
 extern void *umm_poison_calloc(size_t num, size_t size);
@@ -618,9 +731,9 @@ extern bool  umm_poison_check(void);
 // Local Additions to better report location in code of the caller.
 void *umm_poison_realloc_fl(void *ptr, size_t size, const char *file, int line);
 void  umm_poison_free_fl(void *ptr, const char *file, int line);
-#define POISON_CHECK_SET_POISON(p, s) get_poisoned(p, s)
-#define UMM_POISON_SKETCH_PTR(p) ((void*)((uintptr_t)p + sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_SIZE_BEFORE))
-#define UMM_POISON_SKETCH_PTRSZ(s) (s - sizeof(UMM_POISONED_BLOCK_LEN_TYPE) - UMM_POISON_SIZE_BEFORE  - UMM_POISON_SIZE_AFTER)
+#define POISON_CHECK_SET_POISON(p, s) get_poisoned(p, s, __builtin_return_address(0))
+#define UMM_POISON_SKETCH_PTR(p) ((void*)((uintptr_t)p + sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE + UMM_POISON_SIZE_BEFORE))
+#define UMM_POISON_SKETCH_PTRSZ(s) (s - sizeof(UMM_POISONED_BLOCK_LEN_TYPE) - UMM_POISON_TAG_SIZE - UMM_POISON_SIZE_BEFORE  - UMM_POISON_SIZE_AFTER)
 #if defined(UMM_POISON_CHECK_LITE)
 /*
     * We can safely do individual poison checks at free and realloc and stay
@@ -657,6 +770,7 @@ void  umm_poison_free_fl(void *ptr, const char *file, int line);
     umm_block_size() / 2 + \
     UMM_POISON_SIZE_BEFORE + \
     UMM_POISON_SIZE_AFTER + \
+    UMM_POISON_TAG_SIZE + \
     sizeof(UMM_POISONED_BLOCK_LEN_TYPE))
 
 #else
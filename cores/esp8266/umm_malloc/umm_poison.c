@@ -8,7 +8,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 
-#define UMM_POISON_BLOCK_SIZE (UMM_POISON_SIZE_BEFORE + sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_SIZE_AFTER)
+#define UMM_POISON_BLOCK_SIZE (UMM_POISON_SIZE_BEFORE + sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE + UMM_POISON_SIZE_AFTER)
 
 /*
  * Yields the total size of a poison block of size `s`.
@@ -82,7 +82,7 @@ static bool check_poison_block(umm_block *pblock) {
         unsigned char *pc = (unsigned char *)pblock->body.data;
         unsigned char *pc_cur;
 
-        pc_cur = pc + sizeof(UMM_POISONED_BLOCK_LEN_TYPE);
+        pc_cur = pc + sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE;
         if (!check_poison(pc_cur, UMM_POISON_SIZE_BEFORE, "before")) {
             ok = false;
             goto clean;
@@ -96,6 +96,14 @@ static bool check_poison_block(umm_block *pblock) {
     }
 
 clean:
+    #if defined(UMM_POISON_CALLER_TAG)
+    if (!ok) {
+        /* attribute the trampled buffer to the code that allocated it */
+        unsigned char *pc = (unsigned char *)pblock->body.data;
+        DBGLOG_ERROR("Block was allocated from PC 0x%08lx\n",
+            (unsigned long)*(uint32_t *)(pc + sizeof(UMM_POISONED_BLOCK_LEN_TYPE)));
+    }
+    #endif
     return ok;
 }
 
@@ -106,13 +114,15 @@ clean:
  *
  * `size_w_poison` is a size of the whole block, including a poison.
  */
-static void *get_poisoned(void *vptr, size_t size_w_poison) {
+static void *get_poisoned(void *vptr, size_t size_w_poison, const void *caller) {
     unsigned char *ptr = (unsigned char *)vptr;
 
+    (void)caller;
+
     if (size_w_poison != 0 && ptr != NULL) {
 
         /* Poison beginning and the end of the allocated chunk */
-        put_poison(ptr + sizeof(UMM_POISONED_BLOCK_LEN_TYPE),
+        put_poison(ptr + sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE,
             UMM_POISON_SIZE_BEFORE);
         put_poison(ptr + size_w_poison - UMM_POISON_SIZE_AFTER,
             UMM_POISON_SIZE_AFTER);
@@ -120,8 +130,13 @@ static void *get_poisoned(void *vptr, size_t size_w_poison) {
         /* Put exact length of the user's chunk of memory */
         *(UMM_POISONED_BLOCK_LEN_TYPE *)ptr = (UMM_POISONED_BLOCK_LEN_TYPE)size_w_poison;
 
+        #if defined(UMM_POISON_CALLER_TAG)
+        /* Tag the allocation with its caller for corruption reports */
+        *(uint32_t *)(ptr + sizeof(UMM_POISONED_BLOCK_LEN_TYPE)) = (uint32_t)caller;
+        #endif
+
         /* Return pointer at the first non-poisoned byte */
-        ptr += sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_SIZE_BEFORE;
+        ptr += sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE + UMM_POISON_SIZE_BEFORE;
     }
 
     return (void *)ptr;
@@ -139,7 +154,7 @@ static void *get_unpoisoned(void *vptr) {
     if (ptr != 0) {
         uint16_t c;
 
-        ptr -= (sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_SIZE_BEFORE);
+        ptr -= (sizeof(UMM_POISONED_BLOCK_LEN_TYPE) + UMM_POISON_TAG_SIZE + UMM_POISON_SIZE_BEFORE);
 
         umm_heap_context_t *_context = umm_get_ptr_context(vptr);
         NON_NULL_CONTEXT_ASSERT();
@@ -147,7 +162,13 @@ static void *get_unpoisoned(void *vptr) {
         /* Figure out which block we're in. Note the use of truncated division... */
         c = (ptr - (uintptr_t)(&(_context->heap[0]))) / sizeof(umm_block);
 
-        check_poison_block(&UMM_BLOCK(c));
+        if (check_poison_block(&UMM_BLOCK(c))) {
+            #if defined(UMM_POISON_CHECK_LITE)
+            /* O(1): at most one used block borders the freed one on each
+             * side, adjacent free space being always consolidated */
+            check_poison_neighbors(_context, c);
+            #endif
+        }
     }
 
     return (void *)ptr;
@@ -0,0 +1,188 @@
+/*
+ * umm_pools.c - opt-in segregated-fit size-class pools
+ *
+ * Build with -DUMM_SIZE_CLASS_POOLS to route small allocations (up to
+ * 16/32/64 bytes) to O(1) per-size-class free lists carved out of the DRAM
+ * heap, instead of the first-fit search. Mixed allocation patterns (lwIP
+ * pbufs, String, BearSSL) otherwise interleave short- and long-lived small
+ * blocks throughout the heap and fragment it over long uptimes.
+ *
+ * Each pool arena is allocated lazily from the main heap on first use, so
+ * an unused class costs nothing. When a class runs out of chunks, requests
+ * fall back to the regular first-fit allocator. Per-class statistics are
+ * reported through the umm_info() surface.
+ *
+ * The pool chunk counts can be tuned per build:
+ *   -DUMM_POOL_COUNT_16=<n>  (default 32)
+ *   -DUMM_POOL_COUNT_32=<n>  (default 32)
+ *   -DUMM_POOL_COUNT_64=<n>  (default 16)
+ * A count of 0 disables that class.
+ */
+
+#if defined(BUILD_UMM_MALLOC_C)
+
+#ifdef UMM_SIZE_CLASS_POOLS
+
+#ifndef UMM_POOL_COUNT_16
+#define UMM_POOL_COUNT_16 32
+#endif
+#ifndef UMM_POOL_COUNT_32
+#define UMM_POOL_COUNT_32 32
+#endif
+#ifndef UMM_POOL_COUNT_64
+#define UMM_POOL_COUNT_64 16
+#endif
+
+/* defined later in umm_malloc.cpp */
+static void *umm_malloc_core(umm_heap_context_t *_context, size_t size);
+
+typedef struct umm_pool_chunk {
+    struct umm_pool_chunk *next;
+} umm_pool_chunk_t;
+
+typedef struct {
+    char *arena;                    /* chunk_count * chunk_size bytes, lazily allocated */
+    umm_pool_chunk_t *free_list;
+    uint16_t chunk_size;
+    uint16_t chunk_count;
+    uint16_t used;
+    uint16_t high_water;
+    uint32_t served;                /* requests satisfied from this pool */
+    uint32_t exhausted;             /* class-sized requests that fell back to first-fit */
+    bool init_failed;               /* arena carve-out failed, class disabled */
+} umm_size_class_pool_t;
+
+static umm_size_class_pool_t umm_pools[] = {
+    { NULL, NULL, 16, UMM_POOL_COUNT_16, 0, 0, 0, 0, false },
+    { NULL, NULL, 32, UMM_POOL_COUNT_32, 0, 0, 0, 0, false },
+    { NULL, NULL, 64, UMM_POOL_COUNT_64, 0, 0, 0, 0, false },
+};
+
+#define UMM_NUM_POOLS (sizeof(umm_pools) / sizeof(umm_pools[0]))
+
+/*
+ * Must be called from within a critical section. Carves the arena for a
+ * pool out of the given heap context and threads the chunks onto the free
+ * list. Returns false when the carve-out failed (class stays disabled).
+ */
+static bool umm_pool_init(umm_heap_context_t *_context, umm_size_class_pool_t *pool) {
+    if (pool->init_failed || 0 == pool->chunk_count) {
+        return false;
+    }
+    pool->arena = (char *)umm_malloc_core(_context, (size_t)pool->chunk_size * pool->chunk_count);
+    if (NULL == pool->arena) {
+        DBGLOG_DEBUG("Pool %d arena carve-out failed\n", pool->chunk_size);
+        pool->init_failed = true;
+        return false;
+    }
+    for (uint16_t i = pool->chunk_count; i > 0; i--) {
+        umm_pool_chunk_t *chunk = (umm_pool_chunk_t *)(pool->arena + (size_t)(i - 1) * pool->chunk_size);
+        chunk->next = pool->free_list;
+        pool->free_list = chunk;
+    }
+    return true;
+}
+
+/*
+ * Must be called from within a critical section. Returns a chunk for
+ * class-sized requests, or NULL to have the caller fall back to the
+ * first-fit allocator. Only the DRAM heap is pooled.
+ */
+static void *umm_pool_malloc(umm_heap_context_t *_context, size_t size) {
+    if (_context != umm_get_heap_by_id(UMM_HEAP_DRAM)) {
+        return NULL;
+    }
+    for (size_t i = 0; i < UMM_NUM_POOLS; i++) {
+        umm_size_class_pool_t *pool = &umm_pools[i];
+        if (size > pool->chunk_size || 0 == pool->chunk_count) {
+            continue;
+        }
+        if (NULL == pool->arena && !umm_pool_init(_context, pool)) {
+            return NULL;
+        }
+        umm_pool_chunk_t *chunk = pool->free_list;
+        if (NULL == chunk) {
+            pool->exhausted++;
+            return NULL;
+        }
+        pool->free_list = chunk->next;
+        pool->used++;
+        if (pool->used > pool->high_water) {
+            pool->high_water = pool->used;
+        }
+        pool->served++;
+        return chunk;
+    }
+    return NULL;
+}
+
+static umm_size_class_pool_t *umm_pool_of(const void *ptr) {
+    for (size_t i = 0; i < UMM_NUM_POOLS; i++) {
+        umm_size_class_pool_t *pool = &umm_pools[i];
+        if (pool->arena &&
+            (const char *)ptr >= pool->arena &&
+            (const char *)ptr < pool->arena + (size_t)pool->chunk_size * pool->chunk_count) {
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+static bool umm_pool_contains(const void *ptr) {
+    return NULL != umm_pool_of(ptr);
+}
+
+/*
+ * Must be called from within a critical section. Returns true when the
+ * pointer belonged to a pool and has been returned to its free list.
+ */
+static bool umm_pool_free(void *ptr) {
+    umm_size_class_pool_t *pool = umm_pool_of(ptr);
+    if (NULL == pool) {
+        return false;
+    }
+    umm_pool_chunk_t *chunk = (umm_pool_chunk_t *)ptr;
+    chunk->next = pool->free_list;
+    pool->free_list = chunk;
+    pool->used--;
+    return true;
+}
+
+/*
+ * realloc() support for pooled pointers. Called outside the critical
+ * section; umm_malloc()/umm_free() below take their own.
+ */
+static void *umm_pool_realloc(void *ptr, size_t size) {
+    umm_size_class_pool_t *pool = umm_pool_of(ptr);
+    if (size <= pool->chunk_size) {
+        /* still fits its chunk, keep in place */
+        return ptr;
+    }
+    void *nptr = umm_malloc(size);
+    if (nptr) {
+        memcpy(nptr, ptr, pool->chunk_size);
+        umm_free(ptr);
+    }
+    return nptr;
+}
+
+/* Pool statistics appended to the umm_info() report. */
+static void umm_pool_info_core(bool force) {
+    DBGLOG_FORCE(force, "Size-class pools:\n");
+    for (size_t i = 0; i < UMM_NUM_POOLS; i++) {
+        umm_size_class_pool_t *pool = &umm_pools[i];
+        DBGLOG_FORCE(force, "  %3u B: %5u/%5u used, hiwater %5u, served %8u, exhausted %8u%s\n",
+            pool->chunk_size,
+            pool->used,
+            pool->chunk_count,
+            pool->high_water,
+            (unsigned)pool->served,
+            (unsigned)pool->exhausted,
+            pool->init_failed ? " (arena carve-out failed)" : "");
+    }
+    DBGLOG_FORCE(force, "+--------------------------------------------------------------+\n");
+}
+
+#endif // UMM_SIZE_CLASS_POOLS
+
+#endif // defined(BUILD_UMM_MALLOC_C)
@@ -133,11 +133,26 @@ void ArduinoOTAClass::begin(bool useMDNS) {
 #endif
   _initialized = true;
   _state = OTA_IDLE;
+  if (_password.length()) {
+    _prepareNonce();
+  }
 #ifdef OTA_DEBUG
   OTA_DEBUG.printf("OTA server at: %s.local:%u\n", _hostname.c_str(), _port);
 #endif
 }
 
+// Precompute the next auth nonce from pooled entropy while idle, so the
+// invitation handler can answer without an MD5 computation on the hot path.
+void ArduinoOTAClass::_prepareNonce() {
+  uint8_t seed[16];
+  ESP.randomBytes(seed, sizeof(seed));
+  MD5Builder nonce_md5;
+  nonce_md5.begin();
+  nonce_md5.add(seed, sizeof(seed));
+  nonce_md5.calculate();
+  _nextNonce = nonce_md5.toString();
+}
+
 int ArduinoOTAClass::parseInt(){
   char data[16];
   uint8_t index;
@@ -188,12 +203,17 @@ void ArduinoOTAClass::_onRx(){
 
     ota_ip = _ota_ip;
 
+    // Start erasing the target region in the background right away; the
+    // erase overlaps the auth handshake and the TCP connection setup, so
+    // Update.begin() in _runUpdate() has little or nothing left to erase.
+    Update.prepare(_size, _cmd);
+
     if (_password.length()){
-      MD5Builder nonce_md5;
-      nonce_md5.begin();
-      nonce_md5.add(String(micros()));
-      nonce_md5.calculate();
-      _nonce = nonce_md5.toString();
+      if (!_nextNonce.length()) {
+        _prepareNonce();
+      }
+      _nonce = _nextNonce;
+      _nextNonce = emptyString;
 
       char auth_req[38];
       sprintf(auth_req, "AUTH %s", _nonce.c_str());
@@ -368,6 +388,11 @@ void ArduinoOTAClass::handle() {
     _state = OTA_IDLE;
   }
 
+  // Refill the precomputed nonce between sessions, off the hot path
+  if (_state == OTA_IDLE && _password.length() && !_nextNonce.length()) {
+    _prepareNonce();
+  }
+
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_MDNS)
   if(_useMDNS)
     MDNS.update(); //handle MDNS update as well, given that ArduinoOTA relies on it anyways
@@ -73,6 +73,7 @@ class ArduinoOTAClass
   private:
     void _runUpdate(void);
     void _onRx(void);
+    void _prepareNonce(void);
     int parseInt(void);
     String readStringUntil(char end);
 
@@ -80,6 +81,7 @@ class ArduinoOTAClass
     String _password;
     String _hostname;
     String _nonce;
+    String _nextNonce;
     UdpContext *_udp_ota = nullptr;
     bool _initialized = false;
     bool _rebootOnSuccess = true;
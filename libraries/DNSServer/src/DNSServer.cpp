@@ -129,6 +129,7 @@ bool DNSServer::start(const uint16_t &port, const String &domainName,
   _resolvedIP[1] = resolvedIP[1];
   _resolvedIP[2] = resolvedIP[2];
   _resolvedIP[3] = resolvedIP[3];
+  buildAnswerTail();
 
   if (!enableForwarder(domainName, dns) && (dns.isSet() || _dns.isSet())) {
     return false;
@@ -145,6 +146,43 @@ void DNSServer::setErrorReplyCode(const DNSReplyCode &replyCode)
 void DNSServer::setTTL(const uint32_t &ttl)
 {
   _ttl = lwip_htonl(ttl);
+  buildAnswerTail();
+}
+
+// Precompile the fixed answer section once; replyWithIP() then only appends
+// these bytes behind the echoed query (the name is a compression pointer into
+// the query section)
+void DNSServer::buildAnswerTail()
+{
+  unsigned char *tail = _answerTail;
+  uint16_t value;
+
+  // Rather than restate the name, we use a pointer to the name contained
+  // in the query section. Pointers have the top two bits set.
+  value = lwip_htons(0xC000 | DNS_HEADER_SIZE);
+  memcpy(tail, &value, 2);
+  tail += 2;
+
+  // Answer is type A (an IPv4 address)
+  value = lwip_htons(DNS_QTYPE_A);
+  memcpy(tail, &value, 2);
+  tail += 2;
+
+  // Answer is in the Internet Class
+  value = lwip_htons(DNS_QCLASS_IN);
+  memcpy(tail, &value, 2);
+  tail += 2;
+
+  // TTL (already NBO)
+  memcpy(tail, &_ttl, 4);
+  tail += 4;
+
+  // Length of RData is 4 bytes (because, in this case, RData is IPv4)
+  value = lwip_htons(sizeof(_resolvedIP));
+  memcpy(tail, &value, 2);
+  tail += 2;
+
+  memcpy(tail, _resolvedIP, sizeof(_resolvedIP));
 }
 
 uint32_t DNSServer::getTTL()
@@ -369,59 +407,40 @@ void DNSServer::processNextRequest()
   if (currentPacketSize < DNS_HEADER_SIZE)
     return;
 
-  std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[currentPacketSize]);
-  if (buffer == nullptr)
-    return;
+  // Read into a stack buffer over-allocated by kDNSAnswerTailSize, so
+  // replyWithIP() can append the precompiled answer in place and send the
+  // whole response with a single write - no per-request heap allocation
+  uint8_t buffer[MAX_DNS_PACKETSIZE + kDNSAnswerTailSize];
 
-  _udp.read(buffer.get(), currentPacketSize);
+  _udp.read(buffer, currentPacketSize);
   if (_dns.isSet() && _udp.remoteIP() == _dns) {
     // _forwarder may have been set to false; however, for now allow inflight
     // replys  to finish. //??
-    forwardReply(buffer.get(), currentPacketSize);
+    forwardReply(buffer, currentPacketSize);
   } else
-  if (respondToRequest(buffer.get(), currentPacketSize)) {
-    forwardRequest(buffer.get(), currentPacketSize);
+  if (respondToRequest(buffer, currentPacketSize)) {
+    forwardRequest(buffer, currentPacketSize);
   }
 }
 
-void DNSServer::writeNBOShort(uint16_t value)
-{
-   _udp.write((unsigned char *)&value, 2);
-}
-
 void DNSServer::replyWithIP(DNSHeader *dnsHeader,
 			    unsigned char * query,
 			    size_t queryLength)
 {
-  uint16_t value;
-
   dnsHeader->QR = DNS_QR_RESPONSE;
   dnsHeader->QDCount = lwip_htons(1);
   dnsHeader->ANCount = lwip_htons(1);
   dnsHeader->NSCount = 0;
   dnsHeader->ARCount = 0;
 
-  _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
-  _udp.write((unsigned char *) dnsHeader, sizeof(DNSHeader));
-  _udp.write(query, queryLength);
-
-  // Rather than restate the name here, we use a pointer to the name contained
-  // in the query section. Pointers have the top two bits set.
-  value = 0xC000 | DNS_HEADER_SIZE;
-  writeNBOShort(lwip_htons(value));
+  // The header was patched in place and the query stays where it was read;
+  // appending the precompiled answer right behind the query completes the
+  // response (processNextRequest() over-allocates the buffer for this)
+  memcpy(query + queryLength, _answerTail, kDNSAnswerTailSize);
 
-  // Answer is type A (an IPv4 address)
-  writeNBOShort(lwip_htons(DNS_QTYPE_A));
-
-  // Answer is in the Internet Class
-  writeNBOShort(lwip_htons(DNS_QCLASS_IN));
-
-  // Output TTL (already NBO)
-  _udp.write((unsigned char*)&_ttl, 4);
-
-  // Length of RData is 4 bytes (because, in this case, RData is IPv4)
-  writeNBOShort(lwip_htons(sizeof(_resolvedIP)));
-  _udp.write(_resolvedIP, sizeof(_resolvedIP));
+  _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
+  _udp.write((unsigned char *) dnsHeader,
+             DNS_HEADER_SIZE + queryLength + kDNSAnswerTailSize);
   _udp.endPacket();
 }
 
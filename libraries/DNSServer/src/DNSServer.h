@@ -25,6 +25,10 @@ constexpr inline uint16_t kIanaDnsPort = IANA_DNS_PORT;
 #define MAX_DNSNAME_LENGTH 253
 #define MAX_DNS_PACKETSIZE 512
 
+// Fixed answer section appended behind the echoed query: name pointer, type,
+// class, TTL, RDLength and the IPv4 address (see DNSServer::buildAnswerTail)
+constexpr inline size_t kDNSAnswerTailSize = 2 + 2 + 2 + 4 + 2 + 4;
+
 enum class DNSReplyCode
 {
   NoError = 0,
@@ -124,9 +128,11 @@ class DNSServer
     DNSReplyCode _errorReplyCode;
     bool _forwarder;
     unsigned char _resolvedIP[4];
+    unsigned char _answerTail[kDNSAnswerTailSize];  // precompiled answer section
     uint16_t _port;
 
     void downcaseAndRemoveWwwPrefix(String &domainName);
+    void buildAnswerTail();
     void replyWithIP(DNSHeader *dnsHeader,
 		     unsigned char * query,
 		     size_t queryLength);
@@ -139,6 +145,5 @@ class DNSServer
     bool respondToRequest(uint8_t *buffer, size_t length);
     void forwardRequest(uint8_t *buffer, size_t length);
     void forwardReply(uint8_t *buffer, size_t length);
-    void writeNBOShort(uint16_t value);
 };
 #endif
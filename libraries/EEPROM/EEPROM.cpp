@@ -29,8 +29,10 @@ extern "C" {
 #include "os_type.h"
 #include "osapi.h"
 #include "spi_flash.h"
+#include "user_interface.h"
 }
 
+#include <coredecls.h> // crc32()
 #include <flash_hal.h>
 
 EEPROMClass::EEPROMClass(uint32_t sector)
@@ -58,10 +60,15 @@ void EEPROMClass::begin(size_t size) {
   //In case begin() is called a 2nd+ time, don't reallocate if size is the same
   if(_data && size != _size) {
     delete[] _data;
+    delete[] _dirtyMap;
     _data = new uint8_t[size];
+    _dirtyMap = nullptr;
   } else if(!_data) {
     _data = new uint8_t[size];
   }
+  if(!_dirtyMap) {
+    _dirtyMap = new uint8_t[((size + kDirtyBlockSize - 1) / kDirtyBlockSize + 7) / 8];
+  }
 
   _size = size;
 
@@ -70,6 +77,99 @@ void EEPROMClass::begin(size_t size) {
   }
 
   _dirty = false; //make sure dirty is cleared in case begin() is called 2nd+ time
+  memset(_dirtyMap, 0, (_blockCount() + 7) / 8);
+  _tier = TIER_FLASH;
+  _spillPending = false;
+}
+
+bool EEPROMClass::tier(Tier t, uint16_t firstWord) {
+  if (!_data) {
+    DEBUGV("EEPROMClass::tier without ::begin\n");
+    return false;
+  }
+  if (t == _tier)
+    return true;
+
+  if (t == TIER_RTC) {
+    // CRC word plus the image, rounded up to whole RTC words
+    const uint16_t words = 1 + (_size + 3) / 4;
+    if (firstWord == RTC_WORD_AUTO) {
+      // default placement: pack against the WiFi fast-reconnect hint
+      // (words 125..127), leaving the low words to the RTCVar snapshot
+      if (words > 125) {
+        DEBUGV("EEPROMClass::tier error, %d > 496\n", _size);
+        return false;
+      }
+      firstWord = 125 - words;
+    } else if (firstWord + words > 128) {
+      DEBUGV("EEPROMClass::tier error, words %d..%d past the user area\n",
+             firstWord, firstWord + words - 1);
+      return false;
+    }
+    _rtcWord = firstWord;
+
+    // RTC user memory survives deep sleep and every reset except power
+    // loss; only trust it when the chip did not power cycle and the
+    // stored CRC matches the image.  RTC transfers move whole words:
+    // begin() already word-aligns _size and sizes _data to match, but
+    // keep the padding explicit rather than relying on the SDK
+    // tolerating odd lengths.
+    const size_t imageBytes = 4 * (words - 1);
+    uint32_t crc = 0;
+    bool retained = ESP.getResetInfoPtr()->reason != REASON_DEFAULT_RST
+        && ESP.rtcUserMemoryRead(_rtcWord, &crc, sizeof(crc))
+        && ESP.rtcUserMemoryRead(_rtcWord + 1, reinterpret_cast<uint32_t*>(_data), imageBytes)
+        && crc == crc32(_data, _size);
+    if (!retained) {
+      // cold boot or corrupt image: fall back to the flash copy and
+      // reseed RTC from it so the next wake can trust it
+      if (!ESP.flashRead(_sector * SPI_FLASH_SEC_SIZE, reinterpret_cast<uint32_t*>(_data), _size)) {
+        DEBUGV("EEPROMClass::tier flash read failed\n");
+      }
+      _tier = TIER_RTC;
+      _dirty = true;
+      return _commitRTC();
+    }
+    _tier = TIER_RTC;
+    // the adopted image was committed in an earlier wake cycle and
+    // differs from the flash sector: arm the spill so end() /
+    // tier(TIER_FLASH) still persist it even if nothing is written
+    // this wake.  Mark every block - commit()'s memcmp pass drops the
+    // ones that still match flash, so the spill stays cheap.
+    _markAllDirty();
+    _dirty = false;
+    _spillPending = true;
+    return true;
+  }
+
+  // back to flash: spill what was committed to RTC only
+  _tier = TIER_FLASH;
+  if (_spillPending) {
+    _spillPending = false;
+    _dirty = true;
+    return commit();
+  }
+  return true;
+}
+
+bool EEPROMClass::_commitRTC() {
+  if (!_dirty)
+    return true;
+
+  // whole RTC words, matching the padded read in tier(); _data is
+  // sized to the word-aligned length by begin()
+  uint32_t crc = crc32(_data, _size);
+  if (!ESP.rtcUserMemoryWrite(_rtcWord + 1, reinterpret_cast<uint32_t*>(_data), (_size + 3) & ~(size_t)3)
+      || !ESP.rtcUserMemoryWrite(_rtcWord, &crc, sizeof(crc))) {
+    DEBUGV("EEPROMClass::commit RTC write failed\n");
+    return false;
+  }
+
+  // _dirtyMap is left as-is: it accumulates what a later flash spill
+  // (tier(TIER_FLASH) or end()) still has to program
+  _dirty = false;
+  _spillPending = true;
+  return true;
 }
 
 bool EEPROMClass::end() {
@@ -79,17 +179,43 @@ bool EEPROMClass::end() {
     return false;
   }
 
+  if (_tier == TIER_RTC) {
+    // spill RTC-tier state to flash so it survives power removal
+    tier(TIER_FLASH);
+  }
   retval = commit();
   if(_data) {
     delete[] _data;
   }
+  if(_dirtyMap) {
+    delete[] _dirtyMap;
+  }
   _data = 0;
+  _dirtyMap = 0;
   _size = 0;
   _dirty = false;
 
   return retval;
 }
 
+void EEPROMClass::_markDirty(int address, size_t length) {
+  _dirty = true;
+  if (!_dirtyMap || !length)
+    return;
+  size_t first = address / kDirtyBlockSize;
+  size_t last = (address + length - 1) / kDirtyBlockSize;
+  for (size_t block = first; block <= last; block++) {
+    _dirtyMap[block >> 3] |= 1 << (block & 7);
+  }
+}
+
+void EEPROMClass::_markAllDirty() {
+  _dirty = true;
+  if (_dirtyMap) {
+    memset(_dirtyMap, 0xff, (_blockCount() + 7) / 8);
+  }
+}
+
 
 uint8_t EEPROMClass::read(int const address) {
   if (address < 0 || (size_t)address >= _size) {
@@ -119,7 +245,7 @@ void EEPROMClass::write(int const address, uint8_t const value) {
   if (*pData != value)
   {
     *pData = value;
-    _dirty = true;
+    _markDirty(address, 1);
   }
 }
 
@@ -130,10 +256,61 @@ bool EEPROMClass::commit() {
     return true;
   if(!_data)
     return false;
+  if (_tier == TIER_RTC)
+    return _commitRTC();
+
+  // NOR flash can clear bits without an erase.  Check whether every
+  // dirty block only clears bits relative to the flash content; if so
+  // the ~30 ms sector erase is skipped and just those blocks are
+  // programmed.
+  size_t blocks = _blockCount();
+  bool needErase = !_dirtyMap;
+  uint32_t flashBlock[kDirtyBlockSize / 4];
+  for (size_t block = 0; !needErase && block < blocks; block++) {
+    if (!(_dirtyMap[block >> 3] & (1 << (block & 7))))
+      continue;
+    size_t offset = block * kDirtyBlockSize;
+    size_t len = _size - offset < kDirtyBlockSize ? _size - offset : kDirtyBlockSize;
+    if (!ESP.flashRead(_sector * SPI_FLASH_SEC_SIZE + offset, flashBlock, len)) {
+      needErase = true;
+      break;
+    }
+    const uint8_t* inFlash = reinterpret_cast<const uint8_t*>(flashBlock);
+    const uint8_t* wanted = _data + offset;
+    for (size_t i = 0; i < len; i++) {
+      if (wanted[i] & ~inFlash[i]) {
+        needErase = true;
+        break;
+      }
+    }
+    if (!needErase && memcmp(wanted, inFlash, len) == 0) {
+      // flash already holds this content, nothing to program
+      _dirtyMap[block >> 3] &= ~(1 << (block & 7));
+    }
+  }
+
+  if (!needErase) {
+    for (size_t block = 0; block < blocks; block++) {
+      if (!(_dirtyMap[block >> 3] & (1 << (block & 7))))
+        continue;
+      size_t offset = block * kDirtyBlockSize;
+      size_t len = _size - offset < kDirtyBlockSize ? _size - offset : kDirtyBlockSize;
+      if (!ESP.flashWrite(_sector * SPI_FLASH_SEC_SIZE + offset,
+                          reinterpret_cast<uint32_t*>(_data + offset), len)) {
+        DEBUGV("EEPROMClass::commit failed\n");
+        return false;
+      }
+      _dirtyMap[block >> 3] &= ~(1 << (block & 7));
+    }
+    _dirty = false;
+    return true;
+  }
 
   if (ESP.flashEraseSector(_sector)) {
     if (ESP.flashWrite(_sector * SPI_FLASH_SEC_SIZE, reinterpret_cast<uint32_t*>(_data), _size)) {
       _dirty = false;
+      if (_dirtyMap)
+        memset(_dirtyMap, 0, (blocks + 7) / 8);
       return true;
     }
   }
@@ -143,7 +320,8 @@ bool EEPROMClass::commit() {
 }
 
 uint8_t * EEPROMClass::getDataPtr() {
-  _dirty = true;
+  // direct buffer access can touch anything, assume it all changed
+  _markAllDirty();
   return &_data[0];
 }
 
@@ -37,6 +37,27 @@ public:
   bool commit();
   bool end();
 
+  // Storage tiers for commit().  TIER_RTC keeps the image in RTC user
+  // memory: microsecond writes, no flash wear, survives deep sleep and
+  // every reset except power loss.  A CRC32 word precedes the image.
+  // The RTC user area is shared: the RTCVar snapshot grows up from
+  // word 0 (RTCVar.h) and the WiFi fast-reconnect hint holds words
+  // 125..127 (ESP8266WiFiSTA.cpp), so by default the EEPROM image is
+  // packed at the top of the remaining space, ending at word 124 -
+  // begin() size is limited to 496 bytes and small images coexist
+  // with both features.  Pass an explicit firstWord to place the
+  // image yourself; the caller then owns keeping it clear of the
+  // other claims.  tier(TIER_RTC) adopts the RTC image when the
+  // reset reason says RTC memory was retained and the CRC checks out;
+  // otherwise it transparently falls back to the flash copy loaded by
+  // begin() and reseeds RTC from it.  State committed while in
+  // TIER_RTC spills to flash when switching back to TIER_FLASH or in
+  // end(), so a clean shutdown still survives power removal.
+  enum Tier : uint8_t { TIER_FLASH, TIER_RTC };
+  static constexpr uint16_t RTC_WORD_AUTO = 0xffff;
+  bool tier(Tier t, uint16_t firstWord = RTC_WORD_AUTO);
+  Tier tier() const { return _tier; }
+
   uint8_t * getDataPtr();
   uint8_t const * getConstDataPtr() const;
 
@@ -49,12 +70,12 @@ public:
     return t;
   }
 
-  template<typename T> 
+  template<typename T>
   const T &put(int const address, const T &t) {
     if (address < 0 || address + sizeof(T) > _size)
       return t;
     if (memcmp(_data + address, (const uint8_t*)&t, sizeof(T)) != 0) {
-      _dirty = true;
+      _markDirty(address, sizeof(T));
       memcpy(_data + address, (const uint8_t*)&t, sizeof(T));
     }
 
@@ -67,10 +88,25 @@ public:
   uint8_t const & operator[](int const address) const {return getConstDataPtr()[address];}
 
 protected:
+  // Dirty state is tracked per 32-byte block so commit() can tell what
+  // actually changed: when every dirty block only clears bits relative
+  // to the flash content (a legal NOR program), the sector erase is
+  // skipped and just those blocks are written.
+  static constexpr size_t kDirtyBlockSize = 32;
+
+  void _markDirty(int address, size_t length);
+  void _markAllDirty();
+  size_t _blockCount() const { return (_size + kDirtyBlockSize - 1) / kDirtyBlockSize; }
+  bool _commitRTC();
+
   uint32_t _sector;
   uint8_t* _data = nullptr;
+  uint8_t* _dirtyMap = nullptr;
   size_t _size = 0;
   bool _dirty = false;
+  Tier _tier = TIER_FLASH;
+  uint16_t _rtcWord = 0; // first RTC user word of the CRC + image
+  bool _spillPending = false; // committed to RTC but not yet to flash
 };
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_EEPROM)
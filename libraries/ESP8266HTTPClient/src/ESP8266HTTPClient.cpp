@@ -25,6 +25,7 @@
 #include <coredecls.h>
 
 #include "ESP8266HTTPClient.h"
+#include <GzipInflater.h>
 #include <ESP8266WiFi.h>
 #include <StreamDev.h>
 #include <base64.h>
@@ -39,6 +40,68 @@ static_assert(std::is_move_assignable_v<HTTPClient>, "");
 static const char defaultUserAgentPstr[] PROGMEM = "ESP8266HTTPClient";
 const String HTTPClient::defaultUserAgent = defaultUserAgentPstr;
 
+void HTTPClientConnectionPool::dropExpired()
+{
+    for (auto& entry : _entries) {
+        if (entry.client
+            && ((millis() - entry.parkedAt) > _idleTimeoutMs || !entry.client->connected())) {
+            DEBUG_HTTPCLIENT("[HTTP-Client][pool] dropping stale connection to %s:%u\n",
+                             entry.host.c_str(), entry.port);
+            entry.client.reset();
+        }
+    }
+}
+
+std::unique_ptr<WiFiClient> HTTPClientConnectionPool::take(const String& host, uint16_t port, const String& identity)
+{
+    dropExpired();
+    for (auto& entry : _entries) {
+        if (entry.client && entry.port == port && entry.host == host && entry.identity == identity) {
+            DEBUG_HTTPCLIENT("[HTTP-Client][pool] reusing warm connection to %s:%u\n",
+                             host.c_str(), port);
+            return std::move(entry.client);
+        }
+    }
+    return nullptr;
+}
+
+void HTTPClientConnectionPool::give(std::unique_ptr<WiFiClient> client, const String& host, uint16_t port, const String& identity)
+{
+    if (!client || !client->connected()) {
+        return;
+    }
+    dropExpired();
+    PoolEntry* slot = nullptr;
+    for (auto& entry : _entries) {
+        if (!entry.client) {
+            slot = &entry;
+            break;
+        }
+        // no free slot: evict the entry parked the longest ago
+        if (!slot || (int32_t)(slot->parkedAt - entry.parkedAt) > 0) {
+            slot = &entry;
+        }
+    }
+    if (slot->client) {
+        slot->client->stop();
+    }
+    slot->client = std::move(client);
+    slot->host = host;
+    slot->port = port;
+    slot->identity = identity;
+    slot->parkedAt = millis();
+}
+
+void HTTPClientConnectionPool::clear()
+{
+    for (auto& entry : _entries) {
+        if (entry.client) {
+            entry.client->stop();
+            entry.client.reset();
+        }
+    }
+}
+
 int HTTPClient::StreamReportToHttpClientReport (Stream::Report streamSendError)
 {
     switch (streamSendError)
@@ -216,7 +279,12 @@ void HTTPClient::disconnect(bool preserveClient)
         }
 
         if(_reuse && _canReuse) {
-            DEBUG_HTTPCLIENT("[HTTP-Client][end] tcp keep open for reuse\n");
+            if(_pool && _client) {
+                DEBUG_HTTPCLIENT("[HTTP-Client][end] parking tcp in connection pool\n");
+                _pool->give(std::move(_client), _host, _port, _poolIdentity);
+            } else {
+                DEBUG_HTTPCLIENT("[HTTP-Client][end] tcp keep open for reuse\n");
+            }
         } else {
             DEBUG_HTTPCLIENT("[HTTP-Client][end] tcp stop\n");
             if(_client) {
@@ -257,6 +325,17 @@ void HTTPClient::setReuse(bool reuse)
     _reuse = reuse;
 }
 
+/**
+ * attach a pool of warm keep-alive connections shared across instances
+ * @param pool HTTPClientConnectionPool* (nullptr detaches)
+ * @param identity String TLS trust identity of the client given to begin()
+ */
+void HTTPClient::setConnectionPool(HTTPClientConnectionPool* pool, const String& identity)
+{
+    _pool = pool;
+    _poolIdentity = identity;
+}
+
 /**
  * set User Agent
  * @param userAgent const char *
@@ -361,6 +440,18 @@ void HTTPClient::useHTTP10(bool useHTTP10)
     _reuse = !useHTTP10;
 }
 
+/**
+ * enable transparent gzip/deflate response decompression, see the header
+ * for the windowBits trade-off
+ * @param enable bool
+ * @param windowBits uint8_t back-reference window of 1 << windowBits bytes (9..15)
+ */
+void HTTPClient::setDecompress(bool enable, uint8_t windowBits)
+{
+    _decompress = enable;
+    _decompressWindowBits = windowBits;
+}
+
 /**
  * send a GET request
  * @return http code
@@ -581,6 +672,97 @@ int HTTPClient::sendRequest(const char * type, Stream * stream, size_t size)
     return returnError(handleHeaderResponse());
 }
 
+size_t HTTPClient::RequestBodyWriter::write(const uint8_t* data, size_t size)
+{
+    if(!_http || !size) {
+        return 0;
+    }
+    WiFiClient* client = _http->_client.get();
+    if(client->printf("%zx\r\n", size) == 0) {
+        return 0;
+    }
+    if(StreamConstPtr(data, size).sendAll(client) != size) {
+        return 0;
+    }
+    if(client->write("\r\n", 2) != 2) {
+        return 0;
+    }
+    return size;
+}
+
+void HTTPClient::RequestBodyWriter::abort()
+{
+    if(!_http) {
+        return;
+    }
+    HTTPClient* http = _http;
+    _http = nullptr;
+    // an unterminated chunked body leaves the connection unusable
+    http->_canReuse = false;
+    http->disconnect(true);
+}
+
+int HTTPClient::RequestBodyWriter::end()
+{
+    if(!_http) {
+        return HTTPC_ERROR_NOT_CONNECTED;
+    }
+    HTTPClient* http = _http;
+    _http = nullptr;
+    if(http->_client->write("0\r\n\r\n", 5) != 5) {
+        return http->returnError(HTTPC_ERROR_SEND_PAYLOAD_FAILED);
+    }
+    return http->returnError(http->handleHeaderResponse());
+}
+
+/**
+ * beginRequestStream
+ * connect and send the request header announcing a chunked body; body data
+ * is then printed to the returned writer (one chunk per write)
+ * @param type const char *     "POST", "PUT", ....
+ * @return writer, false-y when connecting or sending the header failed
+ */
+HTTPClient::RequestBodyWriter HTTPClient::beginRequestStream(const char * type)
+{
+    if(!connect()) {
+        returnError(HTTPC_ERROR_CONNECTION_FAILED);
+        return RequestBodyWriter(nullptr);
+    }
+
+    addHeader(F("Transfer-Encoding"), F("chunked"));
+
+    if(!sendHeader(type)) {
+        returnError(HTTPC_ERROR_SEND_HEADER_FAILED);
+        return RequestBodyWriter(nullptr);
+    }
+
+    return RequestBodyWriter(this);
+}
+
+/**
+ * sendRequestStream
+ * chunk-pipe the whole source as request body without buffering it in RAM
+ * @param type const char *     "POST", "PUT", ....
+ * @param source Stream&        data stream for the message body, sent until EOF
+ * @return -1 if no info or > 0 when Content-Length is set by server
+ */
+int HTTPClient::sendRequestStream(const char * type, Stream& source)
+{
+    auto writer = beginRequestStream(type);
+    if(!writer) {
+        return _returnCode;
+    }
+
+    // transfer all of it, one chunk per block, with send-timeout
+    source.sendAll(&writer);
+    if(source.getLastSendReport() != Stream::Report::Success) {
+        writer.abort();
+        return returnError(StreamReportToHttpClientReport(source.getLastSendReport()));
+    }
+
+    return writer.end();
+}
+
 /**
  * size of message body / payload
  * @return -1 if no info or > 0 when Content-Length is set by server
@@ -681,6 +863,8 @@ String HTTPClient::errorToString(int error)
         return F("Stream write error");
     case HTTPC_ERROR_READ_TIMEOUT:
         return F("read Timeout");
+    case HTTPC_ERROR_DECOMPRESSION:
+        return F("response decompression failed");
     default:
         return String();
     }
@@ -789,6 +973,17 @@ bool HTTPClient::connect(void)
         return true;
     }
 
+    if(_pool) {
+        auto pooled = _pool->take(_host, _port, _poolIdentity);
+        if(pooled) {
+            DEBUG_HTTPCLIENT("[HTTP-Client] connect: got warm connection to %s:%u from pool\n", _host.c_str(), _port);
+            _client = std::move(pooled);
+            _client->setTimeout(_tcpTimeout);
+            _canReuse = true;
+            return true;
+        }
+    }
+
     if(!_client) {
         DEBUG_HTTPCLIENT("[HTTP-Client] connect: HTTPClient::begin was not called or returned error\n");
         return false;
@@ -851,7 +1046,9 @@ bool HTTPClient::sendHeader(const char * type)
         header += _userAgent;
     }
 
-    if (!_useHTTP10) {
+    if (_decompress) {
+        header += F("\r\nAccept-Encoding: gzip;q=1,deflate;q=0.8,identity;q=0.5,*;q=0");
+    } else if (!_useHTTP10) {
         header += F("\r\nAccept-Encoding: identity;q=1,chunked;q=0.1,*;q=0");
     }
 
@@ -888,106 +1085,271 @@ int HTTPClient::handleHeaderResponse()
 
     _canReuse = _reuse;
 
-    String transferEncoding;
+    bool teSeen = false;
+    bool teChunked = false;
 
     _transferEncoding = HTTPC_TE_IDENTITY;
+    _contentEncoding = HTTPC_CE_IDENTITY;
     unsigned long lastDataTime = millis();
 
-    while(connected()) {
-        size_t len = _client->available();
-        if(len > 0) {
-            int headerSeparator = -1;
-            String headerLine = _client->readStringUntil('\n');
+    // Header lines are assembled into this fixed buffer by scanning the
+    // client's peek buffer in place, so headers nobody asked for never cost
+    // a heap allocation.  Oversized lines are truncated and flagged so a
+    // mangled name or value is never matched or collected.
+    char line[HTTPCLIENT_MAX_HEADER_LINE_LENGTH];
+    size_t lineLen = 0;
+    bool lineTruncated = false;
 
-            lastDataTime = millis();
+    const bool peekApi = _client->hasPeekBufferAPI();
 
-            DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] RX: '%s'\n", headerLine.c_str());
+    while(connected()) {
+        size_t avail = peekApi ? _client->peekAvailable() : (size_t)_client->available();
+        if(avail == 0) {
+            if((millis() - lastDataTime) > _tcpTimeout) {
+                return HTTPC_ERROR_READ_TIMEOUT;
+            }
+            esp_yield();
+            continue;
+        }
 
-            if (headerLine.startsWith(F("HTTP/1."))) {
+        lastDataTime = millis();
+
+        // gather bytes up to the next LF, consuming only what we looked at
+        bool complete = false;
+        if(peekApi) {
+            const char* p = _client->peekBuffer();
+            size_t consumed = 0;
+            while(consumed < avail && !complete) {
+                char c = p[consumed++];
+                if(c == '\n') {
+                    complete = true;
+                } else if(lineLen < sizeof(line) - 1) {
+                    line[lineLen++] = c;
+                } else {
+                    lineTruncated = true;
+                }
+            }
+            _client->peekConsume(consumed);
+        } else {
+            while(avail-- && !complete) {
+                int c = _client->read();
+                if(c < 0) {
+                    break;
+                }
+                if(c == '\n') {
+                    complete = true;
+                } else if(lineLen < sizeof(line) - 1) {
+                    line[lineLen++] = (char)c;
+                } else {
+                    lineTruncated = true;
+                }
+            }
+        }
+        if(!complete) {
+            // rest of the line is still in flight
+            continue;
+        }
 
-                constexpr auto httpVersionIdx = sizeof "HTTP/1." - 1;
-                _canReuse = _canReuse && (headerLine[httpVersionIdx] != '0');
-                _returnCode = headerLine.substring(httpVersionIdx + 2, headerLine.indexOf(' ', httpVersionIdx + 2)).toInt();
-                _canReuse = _canReuse && (_returnCode > 0) && (_returnCode < 500);
+        // strip trailing CR and whitespace, terminate
+        while(lineLen && (line[lineLen - 1] == '\r' || line[lineLen - 1] == ' ' || line[lineLen - 1] == '\t')) {
+            lineLen--;
+        }
+        line[lineLen] = '\0';
 
-            } else if ((headerSeparator = headerLine.indexOf(':')) > 0) {
-                String headerName = headerLine.substring(0, headerSeparator);
-                String headerValue = headerLine.substring(headerSeparator + 1);
-                headerValue.trim();
+        DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] RX: '%s'\n", line);
 
-                if(headerName.equalsIgnoreCase(F("Content-Length"))) {
-                    _size = headerValue.toInt();
-                }
+        char* headerSeparator;
+        if(strncmp_P(line, PSTR("HTTP/1."), 7) == 0) {
 
-                if(_canReuse && headerName.equalsIgnoreCase(F("Connection"))) {
-                    if (headerValue.indexOf(F("close")) >= 0 &&
-                            headerValue.indexOf(F("keep-alive")) < 0) {
-                        _canReuse = false;
-                    }
-                }
+            constexpr auto httpVersionIdx = sizeof "HTTP/1." - 1;
+            _canReuse = _canReuse && (line[httpVersionIdx] != '0');
+            _returnCode = atoi(&line[httpVersionIdx + 2]);
+            _canReuse = _canReuse && (_returnCode > 0) && (_returnCode < 500);
 
-                if(headerName.equalsIgnoreCase(F("Transfer-Encoding"))) {
-                    transferEncoding = headerValue;
-                }
+        } else if(!lineTruncated && (headerSeparator = strchr(line, ':')) != nullptr && headerSeparator != line) {
+            *headerSeparator = '\0';
+            const char* headerName = line;
+            const char* headerValue = headerSeparator + 1;
+            while(*headerValue == ' ' || *headerValue == '\t') {
+                headerValue++;
+            }
 
-                if(headerName.equalsIgnoreCase(F("Location"))) {
-                    _location = headerValue;
-                }
+            if(strcasecmp_P(headerName, PSTR("Content-Length")) == 0) {
+                _size = atoi(headerValue);
+            }
 
-                for (size_t i = 0; i < _headerKeysCount; i++) {
-                    if (_currentHeaders[i].key.equalsIgnoreCase(headerName)) {
-                        if (!_currentHeaders[i].value.isEmpty()) {
-                            // Existing value, append this one with a comma
-                            _currentHeaders[i].value += ',';
-                            _currentHeaders[i].value += headerValue;
-                        } else {
-                            _currentHeaders[i].value = headerValue;
-                        }
-                        break; // We found a match, stop looking
-                    }
+            if(_canReuse && strcasecmp_P(headerName, PSTR("Connection")) == 0) {
+                if(strstr_P(headerValue, PSTR("close")) != nullptr &&
+                        strstr_P(headerValue, PSTR("keep-alive")) == nullptr) {
+                    _canReuse = false;
                 }
-                continue;
             }
 
-            headerLine.trim(); // remove \r
-
-            if (headerLine.isEmpty()) {
-                DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] code: %d\n", _returnCode);
+            if(strcasecmp_P(headerName, PSTR("Transfer-Encoding")) == 0) {
+                DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] Transfer-Encoding: %s\n", headerValue);
+                teSeen = true;
+                teChunked = (strcasecmp_P(headerValue, PSTR("chunked")) == 0);
+            }
 
-                if(_size > 0) {
-                    DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] size: %d\n", _size);
+            if(strcasecmp_P(headerName, PSTR("Content-Encoding")) == 0) {
+                DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] Content-Encoding: %s\n", headerValue);
+                if(strcasecmp_P(headerValue, PSTR("gzip")) == 0) {
+                    _contentEncoding = HTTPC_CE_GZIP;
+                } else if(strcasecmp_P(headerValue, PSTR("deflate")) == 0) {
+                    _contentEncoding = HTTPC_CE_DEFLATE;
                 }
+            }
 
-                if(transferEncoding.length() > 0) {
-                    DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] Transfer-Encoding: %s\n", transferEncoding.c_str());
-                    if(transferEncoding.equalsIgnoreCase(F("chunked"))) {
-                        _transferEncoding = HTTPC_TE_CHUNKED;
+            if(strcasecmp_P(headerName, PSTR("Location")) == 0) {
+                _location = headerValue;
+            }
+
+            for (size_t i = 0; i < _headerKeysCount; i++) {
+                if (_currentHeaders[i].key.equalsIgnoreCase(headerName)) {
+                    if (!_currentHeaders[i].value.isEmpty()) {
+                        // Existing value, append this one with a comma
+                        _currentHeaders[i].value += ',';
+                        _currentHeaders[i].value += headerValue;
                     } else {
-                        _returnCode = HTTPC_ERROR_ENCODING;
-                        return _returnCode;
+                        _currentHeaders[i].value = headerValue;
                     }
-                } else {
-                    _transferEncoding = HTTPC_TE_IDENTITY;
+                    break; // We found a match, stop looking
                 }
+            }
+
+        } else if (lineLen == 0) {
+            DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] code: %d\n", _returnCode);
 
-                if(_returnCode <= 0) {
-                    DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] Remote host is not an HTTP Server!");
-                    _returnCode = HTTPC_ERROR_NO_HTTP_SERVER;
+            if(_size > 0) {
+                DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] size: %d\n", _size);
+            }
+
+            if(teSeen) {
+                if(teChunked) {
+                    _transferEncoding = HTTPC_TE_CHUNKED;
+                } else {
+                    _returnCode = HTTPC_ERROR_ENCODING;
+                    return _returnCode;
                 }
-                return _returnCode;
+            } else {
+                _transferEncoding = HTTPC_TE_IDENTITY;
             }
 
-        } else {
-            if((millis() - lastDataTime) > _tcpTimeout) {
-                return HTTPC_ERROR_READ_TIMEOUT;
+            if(_returnCode <= 0) {
+                DEBUG_HTTPCLIENT("[HTTP-Client][handleHeaderResponse] Remote host is not an HTTP Server!");
+                _returnCode = HTTPC_ERROR_NO_HTTP_SERVER;
             }
-            esp_yield();
+            return _returnCode;
         }
+
+        lineLen = 0;
+        lineTruncated = false;
     }
 
     return HTTPC_ERROR_CONNECTION_LOST;
 }
 
+/**
+ * decode a gzip/deflate response body into output.  The inflater pulls
+ * compressed bytes through a source callback which also undoes the
+ * transfer framing: identity bodies are bounded by Content-Length (or the
+ * connection close), chunked bodies are dechunked inline.
+ * @param output Print*
+ * @return plain (decompressed) bytes written ( negative values are error codes )
+ */
+int HTTPClient::writeToStreamDecompressed(Print * output)
+{
+    const bool chunked = (_transferEncoding == HTTPC_TE_CHUNKED);
+    int remaining = chunked ? 0 : _size; // identity: -1 means read until close
+    bool finished = false;
+    bool timedOut = false;
+
+    GzipInflater::Source source = [&](uint8_t* buf, size_t len) -> int {
+        if(finished) {
+            return 0;
+        }
+        if(chunked) {
+            if(remaining == 0) {
+                String chunkHeader = _client->readStringUntil('\n');
+                if(chunkHeader.length() <= 0) {
+                    timedOut = true;
+                    return -1;
+                }
+                chunkHeader.trim(); // remove \r
+                remaining = (int) strtol(chunkHeader.c_str(), NULL, 16);
+                DEBUG_HTTPCLIENT("[HTTP-Client] read chunk len: %d\n", remaining);
+                if(remaining == 0) {
+                    // terminal chunk; trailers (if any) are left unread,
+                    // matching the uncompressed chunked path
+                    finished = true;
+                    return 0;
+                }
+            }
+            size_t want = std::min((size_t) remaining, len);
+            int r = _client->readBytes(buf, want);
+            if(r <= 0) {
+                timedOut = true;
+                return -1;
+            }
+            remaining -= r;
+            if(remaining == 0) {
+                // consume the trailing \r\n at the end of the chunk
+                char crlf[2];
+                if(_client->readBytes((uint8_t*) crlf, 2) != 2 || crlf[0] != '\r' || crlf[1] != '\n') {
+                    timedOut = true;
+                    return -1;
+                }
+            }
+            return r;
+        }
+        // identity framing
+        if(remaining == 0) {
+            finished = true;
+            return 0;
+        }
+        size_t want = (remaining > 0) ? std::min((size_t) remaining, len) : len;
+        int r = _client->readBytes(buf, want);
+        if(r <= 0) {
+            // a body bounded by Content-Length must deliver it in full;
+            // without one the close is the end-of-body marker
+            timedOut = (remaining > 0);
+            finished = true;
+            return timedOut ? -1 : 0;
+        }
+        if(remaining > 0) {
+            remaining -= r;
+        }
+        return r;
+    };
+
+    // the inflater carries a 1 << windowBits window plus its Huffman
+    // tables, too big for the stack
+    std::unique_ptr<GzipInflater> inflater(new (std::nothrow) GzipInflater(source, _decompressWindowBits));
+    if(!inflater || !inflater->valid()) {
+        return returnError(HTTPC_ERROR_TOO_LESS_RAM);
+    }
+
+    int ret = inflater->inflate(*output,
+                                (_contentEncoding == HTTPC_CE_GZIP) ? GzipInflater::FORMAT_GZIP : GzipInflater::FORMAT_DEFLATE);
+    if(ret < 0) {
+        DEBUG_HTTPCLIENT("[HTTP-Client][writeToStreamDecompressed] inflate error: %d\n", ret);
+        if(timedOut) {
+            return returnError(HTTPC_ERROR_READ_TIMEOUT);
+        }
+        switch(ret) {
+        case GzipInflater::ERR_WRITE:
+            return returnError(HTTPC_ERROR_STREAM_WRITE);
+        case GzipInflater::ERR_MEM:
+            return returnError(HTTPC_ERROR_TOO_LESS_RAM);
+        default:
+            return returnError(HTTPC_ERROR_DECOMPRESSION);
+        }
+    }
+
+    disconnect(true);
+    return ret;
+}
+
 /**
  * called to handle error return, may disconnect the connection if still exists
  * @param error
@@ -44,6 +44,12 @@
 
 #define HTTPCLIENT_DEFAULT_TCP_TIMEOUT (5000)
 
+// Longest response header line (including the name) that can be parsed;
+// longer lines are truncated and the affected header is ignored.
+#ifndef HTTPCLIENT_MAX_HEADER_LINE_LENGTH
+#define HTTPCLIENT_MAX_HEADER_LINE_LENGTH (512)
+#endif
+
 /// HTTP client errors
 #define HTTPC_ERROR_CONNECTION_FAILED   (-1)
 #define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
@@ -56,6 +62,7 @@
 #define HTTPC_ERROR_ENCODING            (-9)
 #define HTTPC_ERROR_STREAM_WRITE        (-10)
 #define HTTPC_ERROR_READ_TIMEOUT        (-11)
+#define HTTPC_ERROR_DECOMPRESSION       (-12)
 
 constexpr int HTTPC_ERROR_CONNECTION_REFUSED __attribute__((deprecated)) = HTTPC_ERROR_CONNECTION_FAILED;
 
@@ -129,6 +136,12 @@ typedef enum {
     HTTPC_TE_CHUNKED
 } transferEncoding_t;
 
+typedef enum {
+    HTTPC_CE_IDENTITY,
+    HTTPC_CE_GZIP,
+    HTTPC_CE_DEFLATE
+} contentEncoding_t;
+
 /**
  * redirection follow mode.
  * + `HTTPC_DISABLE_FOLLOW_REDIRECTS` - no redirection will be followed.
@@ -149,6 +162,48 @@ typedef enum {
 class TransportTraits;
 typedef std::unique_ptr<TransportTraits> TransportTraitsPtr;
 
+/**
+ * A small pool of warm keep-alive connections, shareable between HTTPClient
+ * instances.  Entries are keyed by (host, port, identity); identity should
+ * capture whatever distinguishes the TLS trust configuration of the client
+ * (fingerprint, CA, insecure...), so a WiFiClientSecure is never handed out
+ * for a request with different trust anchors.  Parked sockets are dropped
+ * after the idle timeout, since servers close quiet keep-alive connections
+ * anyway.
+ */
+class HTTPClientConnectionPool
+{
+public:
+    HTTPClientConnectionPool(uint32_t idleTimeoutMs = 5000) : _idleTimeoutMs(idleTimeoutMs) { }
+
+    void setIdleTimeout(uint32_t ms) { _idleTimeoutMs = ms; }
+
+    /// hand out a warm connected client, or nullptr when none matches
+    std::unique_ptr<WiFiClient> take(const String& host, uint16_t port, const String& identity);
+
+    /// park a connected client for a later take(); replaces the oldest entry when full
+    void give(std::unique_ptr<WiFiClient> client, const String& host, uint16_t port, const String& identity);
+
+    /// drop every pooled connection
+    void clear();
+
+protected:
+    struct PoolEntry
+    {
+        std::unique_ptr<WiFiClient> client;
+        String host;
+        String identity;
+        uint16_t port = 0;
+        uint32_t parkedAt = 0;
+    };
+
+    void dropExpired();
+
+    static constexpr size_t PoolSize = 4;
+    PoolEntry _entries[PoolSize];
+    uint32_t _idleTimeoutMs;
+};
+
 class HTTPClient
 {
 public:
@@ -173,6 +228,13 @@ public:
     bool connected(void);
 
     void setReuse(bool reuse); /// keep-alive
+
+    // Attach a connection pool: end()/disconnect() park reusable keep-alive
+    // sockets there instead of keeping them captive in this instance, and
+    // connect() checks the pool before opening a new socket.  identity must
+    // reflect the TLS configuration of the client handed to begin() (leave
+    // empty for plain HTTP).
+    void setConnectionPool(HTTPClientConnectionPool* pool, const String& identity = emptyString);
     void setUserAgent(const String& userAgent);
     void setAuthorization(const char * user, const char * password);
     void setAuthorization(const char * auth);
@@ -186,6 +248,16 @@ public:
     bool setURL(const String& url); // handy for handling redirects
     void useHTTP10(bool usehttp10 = true);
 
+    // Transparent response decompression.  When enabled, requests offer
+    // "Accept-Encoding: gzip" and a gzip/deflate response body is inflated
+    // on the fly inside writeToStream()/getString(), using a heap buffer of
+    // 1 << windowBits bytes (9..15) for back-references.  Servers honour
+    // windows below the 32 KB default only when configured to (nginx
+    // "gzip_window"); an undersized window fails the transfer with
+    // HTTPC_ERROR_DECOMPRESSION instead of corrupting data.  Raw access
+    // through getStream() stays compressed either way.
+    void setDecompress(bool enable, uint8_t windowBits = 15);
+
     /// request handling
     int GET();
     int DELETE();
@@ -199,6 +271,50 @@ public:
     int sendRequest(const char* type, const uint8_t* payload = NULL, size_t size = 0);
     int sendRequest(const char* type, Stream * stream, size_t size = 0);
 
+    // Streaming request bodies (Transfer-Encoding: chunked), for payloads
+    // that never fit in RAM at once.
+    //
+    // Push variant: beginRequestStream() connects and sends the request
+    // header; everything printed to the returned writer goes out framed as
+    // one chunk per write.  RequestBodyWriter::end() terminates the body
+    // and returns the HTTP response code.
+    class RequestBodyWriter : public Print
+    {
+    public:
+        RequestBodyWriter(RequestBodyWriter&& other) noexcept : _http(other._http) {
+            other._http = nullptr;
+        }
+        ~RequestBodyWriter() {
+            end(); // response code discarded when not collected explicitly
+        }
+
+        size_t write(uint8_t b) override {
+            return write(&b, 1);
+        }
+        size_t write(const uint8_t* data, size_t size) override;
+
+        /// terminate the body, parse the response, return the HTTP code
+        int end();
+
+        /// give up mid-body; the connection is closed, no response is read
+        void abort();
+
+        operator bool() const {
+            return _http != nullptr;
+        }
+
+    private:
+        friend class HTTPClient;
+        RequestBodyWriter(HTTPClient* http) : _http(http) { }
+        HTTPClient* _http;
+    };
+
+    RequestBodyWriter beginRequestStream(const char* type);
+
+    // Pull variant: chunk-pipes the whole source through the socket via
+    // Stream::sendAll/sendGeneric, no intermediate allocation.
+    int sendRequestStream(const char* type, Stream& source);
+
     void addHeader(const String& name, const String& value, bool first = false, bool replace = true);
 
     /// Response handling
@@ -240,6 +356,7 @@ protected:
     bool sendHeader(const char * type);
     int handleHeaderResponse();
     int writeToStreamDataBlock(Stream * stream, int len);
+    int writeToStreamDecompressed(Print * output);
     static int StreamReportToHttpClientReport (Stream::Report streamSendError);
 
     // The common pattern to use the class is to
@@ -267,6 +384,9 @@ protected:
     static const String defaultUserAgent;
     String _userAgent = defaultUserAgent;
 
+    HTTPClientConnectionPool* _pool = nullptr;
+    String _poolIdentity;
+
     /// Response handling
     std::unique_ptr<RequestArgument[]> _currentHeaders;
     size_t _headerKeysCount = 0;
@@ -278,6 +398,9 @@ protected:
     uint16_t _redirectLimit = 10;
     String _location;
     transferEncoding_t _transferEncoding = HTTPC_TE_IDENTITY;
+    contentEncoding_t _contentEncoding = HTTPC_CE_IDENTITY;
+    bool _decompress = false;
+    uint8_t _decompressWindowBits = 15;
     std::unique_ptr<StreamString> _payload;
 };
 
@@ -299,6 +422,12 @@ int HTTPClient::writeToStream(S * output)
         return returnError(HTTPC_ERROR_NOT_CONNECTED);
     }
 
+    // compressed response body (setDecompress()): route everything through
+    // the inflater, which handles identity and chunked framing itself
+    if(_decompress && _contentEncoding != HTTPC_CE_IDENTITY) {
+        return writeToStreamDecompressed(output);
+    }
+
     // get length of document (is -1 when Server sends no Content-Length header)
     int len = _size;
     int ret = 0;
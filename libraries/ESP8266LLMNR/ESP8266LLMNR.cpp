@@ -71,23 +71,17 @@ extern "C" {
 static const int LLMNR_MULTICAST_TTL = 1;
 static const int LLMNR_PORT = 5355;
 
-LLMNRResponder::LLMNRResponder() :
-    _conn(0) {
+LLMNRResponder::LLMNRResponder() {
 }
 
 LLMNRResponder::~LLMNRResponder() {
-    if (_conn)
-        _conn->unref();
 }
 
 bool LLMNRResponder::begin(const char* hostname) {
-    // Max length for a single label in DNS
-    if (strlen(hostname) > 63)
+    // Registry enforces the max length for a single label in DNS
+    if (!esp8266::netname::Registry::set(hostname))
         return false;
 
-    _hostname = hostname;
-    _hostname.toLowerCase();
-
     _sta_got_ip_handler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP& event){
         (void) event;
         _restart();
@@ -106,29 +100,14 @@ void LLMNRResponder::notify_ap_change() {
 }
 
 bool LLMNRResponder::_restart() {
-    if (_conn) {
-        _conn->unref();
-        _conn = 0;
-    }
-
     IPAddress llmnr(LLMNR_MULTICAST_ADDR);
 
-    if (igmp_joingroup(IP4_ADDR_ANY4, llmnr) != ERR_OK)
-        return false;
-
-    _conn = new UdpContext;
-    _conn->ref();
-
-    if (!_conn->listen(IP_ADDR_ANY, LLMNR_PORT))
-        return false;
-
-    _conn->setMulticastTTL(LLMNR_MULTICAST_TTL);
-    _conn->onRx(std::bind(&LLMNRResponder::_process_packet, this));
-    _conn->connect(llmnr, LLMNR_PORT);
-    return true;
+    return _listener.beginMulticast(LLMNR_PORT, llmnr, LLMNR_MULTICAST_TTL,
+                                    std::bind(&LLMNRResponder::_process_packet, this));
 }
 
 void LLMNRResponder::_process_packet() {
+    UdpContext* _conn = _listener.context();
     if (!_conn || !_conn->next())
         return;
 
@@ -185,7 +164,7 @@ void LLMNRResponder::_process_packet() {
     Serial.print("QNAME len ");
     Serial.println(namelen);
 #endif
-    if (namelen != _hostname.length()) {
+    if (namelen != esp8266::netname::Registry::length()) {
 #ifdef LLMNR_DEBUG
         Serial.println("QNAME len mismatch");
 #endif
@@ -201,7 +180,8 @@ void LLMNRResponder::_process_packet() {
     Serial.println(qname);
 #endif
 
-    if (strcmp(_hostname.c_str(), qname)) {
+    // LLMNR names are case-insensitive (RFC 4795 section 3)
+    if (!esp8266::netname::Registry::matches(qname)) {
 #ifdef LLMNR_DEBUG
         Serial.println("QNAME mismatch");
 #endif
@@ -35,23 +35,23 @@
 #define ESP8266LLMNR_H
 
 #include <ESP8266WiFi.h>
-
-class UdpContext;
+#include <include/NetNameResponder.h>
 
 class LLMNRResponder {
 public:
     LLMNRResponder();
     ~LLMNRResponder();
 
-    /* Initialize and start responding to LLMNR requests on all interfaces */
+    /* Initialize and start responding to LLMNR requests on all interfaces.
+       The hostname is registered in the shared discovery-responder registry
+       (esp8266::netname::Registry), so it is shared with e.g. NetBIOS. */
     bool begin(const char* hostname);
 
     /* Application should call this whenever AP is configured/disabled */
     void notify_ap_change();
 
 private:
-    String _hostname;
-    UdpContext *_conn;
+    esp8266::netname::UdpListener _listener;
     WiFiEventHandler _sta_got_ip_handler;
     WiFiEventHandler _sta_disconnected_handler;
 
@@ -127,9 +127,9 @@ void ESP8266NetBIOS::_makenbname(char *name, char *nbname, uint8_t outlen)
     *nbname = 0; // ulozime ukoncovaci 0 retezce
 }
 
-ESP8266NetBIOS::ESP8266NetBIOS():_pcb(NULL)
+ESP8266NetBIOS::ESP8266NetBIOS()
 {
-
+    _encodedName[0] = '\0';
 }
 ESP8266NetBIOS::~ESP8266NetBIOS()
 {
@@ -140,132 +140,118 @@ ESP8266NetBIOS::~ESP8266NetBIOS()
 bool ESP8266NetBIOS::begin(const char *name)
 {
     size_t n = strlen(name);
-    if (n > sizeof(_name)) {
+    if (n > NBNS_MAX_HOSTNAME_LEN) {
         // prilis dlouhe jmeno
         return false;
     }
 
-    // presuneme jmeno zarizeni se soucasnou upravou na UPPER case
-    for (size_t  i = 0; i < n; ++i) {
-        _name[i] = toupper(name[i]);
+    // Register the name once in the shared discovery-responder registry
+    // (shared with e.g. LLMNR); lookups compare case-insensitively.
+    if (!esp8266::netname::Registry::set(name)) {
+        return false;
     }
-    _name[n] = '\0';
 
-    if(_pcb != NULL) {
-        return true;
+    // Precompute the NetBIOS coding of the name, appended to every positive answer.
+    char upperName[NBNS_MAX_HOSTNAME_LEN + 1];
+    for (size_t i = 0; i < n; ++i) {
+        upperName[i] = toupper(name[i]);
     }
-    _pcb = udp_new();
-    udp_recv(_pcb, &_s_recv, (void *) this);
-    err_t err = udp_bind(_pcb, (ip_addr_t*)INADDR_ANY, NBNS_PORT);
-    if(err != ERR_OK) {
-        end();
-        return false;
+    upperName[n] = '\0';
+    _makenbname(upperName, _encodedName, sizeof(_encodedName) - 1);
+
+    if (_listener.context() != NULL) {
+        return true;
     }
-    return true;
+    return _listener.begin(NBNS_PORT, std::bind(&ESP8266NetBIOS::_process_packet, this));
 }
 
 void ESP8266NetBIOS::end()
 {
-    if(_pcb != NULL) {
-        udp_remove(_pcb);
-        _pcb = NULL;
-    }
+    _listener.end();
 }
 
-void ESP8266NetBIOS::_recv(udp_pcb *upcb, pbuf *pb, const ip_addr_t *addr, uint16_t port)
+void ESP8266NetBIOS::_process_packet()
 {
-    (void)upcb;
-    (void)addr;
-    (void)port;
-    while(pb != NULL) {
-        uint8_t * data = (uint8_t*)((pb)->payload);
-        size_t len = pb->len;
-        // check UdpContext.h
-        const ip_addr_t* saddr = &ip_data.current_iphdr_src;
+    UdpContext* conn = _listener.context();
+    if (conn == NULL || !conn->next()) {
+        return;
+    }
 
-        if (len >= sizeof(struct NBNSQUESTION)) {
-            struct NBNSQUESTION * question = (struct NBNSQUESTION *)data;
-            if (0 == (question->NBNSQ_FLAGS1 & 0x80)) {
-                char name[ NBNS_MAX_HOSTNAME_LEN + 1 ]; // dekodovane dotazovane jmeno
-                char *str; // pomocna promenna, pouze pro praci s retezcem
+    struct NBNSQUESTION question;
+    if (conn->getSize() < sizeof(question)) {
+        conn->flush();
+        return;
+    }
+    conn->read((char *)&question, sizeof(question));
+    conn->flush();
 
-                _getnbname(&question->NBNSQ_NAME[0], (char *)&name, question->NBNSQ_NAMESIZE); // prevedeme dotazovane jmeno
-                if ((str = strchr(name, ' ')) != NULL) { // jmeno hledaneho zarizeni v tomto pripade ukoncuje i mezera
-                    *str = '\0';    // ukoncime retezec na vyskytu prvni mezery
-                }
+    if (question.NBNSQ_FLAGS1 & 0x80) {
+        return;
+    }
+
+    char name[ NBNS_MAX_HOSTNAME_LEN + 1 ]; // dekodovane dotazovane jmeno
+    char *str; // pomocna promenna, pouze pro praci s retezcem
+
+    _getnbname(&question.NBNSQ_NAME[0], (char *)&name, question.NBNSQ_NAMESIZE); // prevedeme dotazovane jmeno
+    if ((str = strchr(name, ' ')) != NULL) { // jmeno hledaneho zarizeni v tomto pripade ukoncuje i mezera
+        *str = '\0';    // ukoncime retezec na vyskytu prvni mezery
+    }
 
-                if (0 == strcmp(name, _name)) {
-                    // dotaz primo na nas
-                    struct NBNSANSWER nbnsa; // buffer, do ktereho je sestavena odpoved na dotaz
+    const IPAddress remoteAddr = conn->getRemoteAddress();
 
-                    nbnsa.NBNSA_ID = question->NBNSQ_ID;// ID dotazu kopirujeme do ID odpovedi
-                    nbnsa.NBNSA_FLAGS1 = 0x85;	// priznak odpovedi
-                    nbnsa.NBNSA_FLAGS2 = 0; // vlajky 2 a response code
-                    nbnsa.NBNSA_QUESTIONCOUNT = LWIP_PLATFORM_HTONS(0);
-                    nbnsa.NBNSA_ANSWERCOUNT = LWIP_PLATFORM_HTONS(1);// poradove cislo odpovedi
-                    nbnsa.NBNSA_AUTHORITYCOUNT = LWIP_PLATFORM_HTONS(0);
-                    nbnsa.NBNSA_ADDITIONALRECORDCOUNT = LWIP_PLATFORM_HTONS(0);
-                    nbnsa.NBNSA_NAMESIZE = sizeof(nbnsa.NBNSA_NAME) - 1; // prekopirujeme delku jmena stanice
-                    _makenbname(_name, &nbnsa.NBNSA_NAME[0], sizeof(nbnsa.NBNSA_NAME) - 1); // prevedeme jmeno
-                    nbnsa.NBNSA_TYPE = LWIP_PLATFORM_HTONS(0x20); // NetBIOS name
-                    nbnsa.NBNSA_CLASS = LWIP_PLATFORM_HTONS(1); // Internet name
-                    nbnsa.NBNSA_TIMETOLIVE = LWIP_PLATFORM_HTONL(300000UL);// Time to live (30000 sekund)
-                    nbnsa.NBNSA_LENGTH = LWIP_PLATFORM_HTONS(6);
-                    nbnsa.NBNSA_NODEFLAGS = LWIP_PLATFORM_HTONS(0);
-                    nbnsa.NBNSA_NODEADDRESS = ip_addr_get_ip4_u32(&ip_current_netif()->ip_addr);
-                    pbuf* pbt = pbuf_alloc(PBUF_TRANSPORT, sizeof(nbnsa), PBUF_RAM);
-                    if(pbt != NULL) {
-                        uint8_t* dst = reinterpret_cast<uint8_t*>(pbt->payload);
-                        memcpy(dst, (uint8_t *)&nbnsa, sizeof(nbnsa));
-                        udp_sendto(_pcb, pbt, saddr, NBNS_PORT);
-                        pbuf_free(pbt);
-                    }
-                } else if (0 == strcmp(name, "*")) {
-                    // obecny dotaz - mireny nejspis na nasi IP adresu
-                    struct NBNSANSWERN nbnsan; // buffer, do ktereho je sestavena odpoved na dotaz
+    if (esp8266::netname::Registry::matches(name)) {
+        // dotaz primo na nas
+        struct NBNSANSWER nbnsa; // buffer, do ktereho je sestavena odpoved na dotaz
 
-                    nbnsan.NBNSAN_ID = question->NBNSQ_ID;// ID dotazu kopirujeme do ID odpovedi
-                    nbnsan.NBNSAN_FLAGS1 = 0x84;	// priznak odpovedi
-                    nbnsan.NBNSAN_FLAGS2 = 0; // vlajky 2 a response code
-                    nbnsan.NBNSAN_QUESTIONCOUNT = LWIP_PLATFORM_HTONS(0);
-                    nbnsan.NBNSAN_ANSWERCOUNT = LWIP_PLATFORM_HTONS(1);// poradove cislo odpovedi
-                    nbnsan.NBNSAN_AUTHORITYCOUNT = LWIP_PLATFORM_HTONS(0);
-                    nbnsan.NBNSAN_ADDITIONALRECORDCOUNT = LWIP_PLATFORM_HTONS(0);
-                    nbnsan.NBNSAN_NAMESIZE = question->NBNSQ_NAMESIZE; // prekopirujeme delku jmena stanice
-                    memcpy(nbnsan.NBNSAN_NAME, question->NBNSQ_NAME, sizeof(nbnsan.NBNSAN_NAME)); // prekopirujeme dotazovane jmeno
-                    nbnsan.NBNSAN_TYPE = LWIP_PLATFORM_HTONS(0x21); // NBSTAT
-                    nbnsan.NBNSAN_CLASS = LWIP_PLATFORM_HTONS(1); // Internet name
-                    nbnsan.NBNSAN_TIMETOLIVE = LWIP_PLATFORM_HTONL(0);
-                    nbnsan.NBNSAN_LENGTH = LWIP_PLATFORM_HTONS(4 + sizeof(nbnsan.NBNSAN_NNAME));
-                    nbnsan.NBNSAN_NUMBER = 1; // Number of names
-                    memset(nbnsan.NBNSAN_NNAME, 0x20, sizeof(nbnsan.NBNSAN_NNAME));
-                    memcpy(nbnsan.NBNSAN_NNAME, _name, strlen(_name));
-                    nbnsan.NBNSAN_NTYPE = 0; // Workstation/Redirector
-                    nbnsan.NBNSAN_NFLAGS = LWIP_PLATFORM_HTONS(0x400); // b-node, unique, active
+        nbnsa.NBNSA_ID = question.NBNSQ_ID;// ID dotazu kopirujeme do ID odpovedi
+        nbnsa.NBNSA_FLAGS1 = 0x85;	// priznak odpovedi
+        nbnsa.NBNSA_FLAGS2 = 0; // vlajky 2 a response code
+        nbnsa.NBNSA_QUESTIONCOUNT = LWIP_PLATFORM_HTONS(0);
+        nbnsa.NBNSA_ANSWERCOUNT = LWIP_PLATFORM_HTONS(1);// poradove cislo odpovedi
+        nbnsa.NBNSA_AUTHORITYCOUNT = LWIP_PLATFORM_HTONS(0);
+        nbnsa.NBNSA_ADDITIONALRECORDCOUNT = LWIP_PLATFORM_HTONS(0);
+        nbnsa.NBNSA_NAMESIZE = sizeof(nbnsa.NBNSA_NAME) - 1; // prekopirujeme delku jmena stanice
+        memcpy(nbnsa.NBNSA_NAME, _encodedName, sizeof(nbnsa.NBNSA_NAME)); // predpocitane jmeno v NETBIOS kodovani
+        nbnsa.NBNSA_TYPE = LWIP_PLATFORM_HTONS(0x20); // NetBIOS name
+        nbnsa.NBNSA_CLASS = LWIP_PLATFORM_HTONS(1); // Internet name
+        nbnsa.NBNSA_TIMETOLIVE = LWIP_PLATFORM_HTONL(300000UL);// Time to live (30000 sekund)
+        nbnsa.NBNSA_LENGTH = LWIP_PLATFORM_HTONS(6);
+        nbnsa.NBNSA_NODEFLAGS = LWIP_PLATFORM_HTONS(0);
+        nbnsa.NBNSA_NODEADDRESS = ip_addr_get_ip4_u32(&ip_current_netif()->ip_addr);
 
-                    pbuf* pbt = pbuf_alloc(PBUF_TRANSPORT, sizeof(nbnsan), PBUF_RAM);
-                    if(pbt != NULL) {
-                        uint8_t* dst = reinterpret_cast<uint8_t*>(pbt->payload);
-                        memcpy(dst, (uint8_t *)&nbnsan, sizeof(nbnsan));
-                        udp_sendto(_pcb, pbt, saddr, NBNS_PORT);
-                        pbuf_free(pbt);
-                    }
-                }
-            }
+        conn->append((const char *)&nbnsa, sizeof(nbnsa));
+        conn->send(remoteAddr, NBNS_PORT);
+    } else if (0 == strcmp(name, "*")) {
+        // obecny dotaz - mireny nejspis na nasi IP adresu
+        struct NBNSANSWERN nbnsan; // buffer, do ktereho je sestavena odpoved na dotaz
+
+        nbnsan.NBNSAN_ID = question.NBNSQ_ID;// ID dotazu kopirujeme do ID odpovedi
+        nbnsan.NBNSAN_FLAGS1 = 0x84;	// priznak odpovedi
+        nbnsan.NBNSAN_FLAGS2 = 0; // vlajky 2 a response code
+        nbnsan.NBNSAN_QUESTIONCOUNT = LWIP_PLATFORM_HTONS(0);
+        nbnsan.NBNSAN_ANSWERCOUNT = LWIP_PLATFORM_HTONS(1);// poradove cislo odpovedi
+        nbnsan.NBNSAN_AUTHORITYCOUNT = LWIP_PLATFORM_HTONS(0);
+        nbnsan.NBNSAN_ADDITIONALRECORDCOUNT = LWIP_PLATFORM_HTONS(0);
+        nbnsan.NBNSAN_NAMESIZE = question.NBNSQ_NAMESIZE; // prekopirujeme delku jmena stanice
+        memcpy(nbnsan.NBNSAN_NAME, question.NBNSQ_NAME, sizeof(nbnsan.NBNSAN_NAME)); // prekopirujeme dotazovane jmeno
+        nbnsan.NBNSAN_TYPE = LWIP_PLATFORM_HTONS(0x21); // NBSTAT
+        nbnsan.NBNSAN_CLASS = LWIP_PLATFORM_HTONS(1); // Internet name
+        nbnsan.NBNSAN_TIMETOLIVE = LWIP_PLATFORM_HTONL(0);
+        nbnsan.NBNSAN_LENGTH = LWIP_PLATFORM_HTONS(4 + sizeof(nbnsan.NBNSAN_NNAME));
+        nbnsan.NBNSAN_NUMBER = 1; // Number of names
+        memset(nbnsan.NBNSAN_NNAME, 0x20, sizeof(nbnsan.NBNSAN_NNAME));
+        const char* hostname = esp8266::netname::Registry::hostname();
+        for (size_t i = 0; hostname[i] != '\0' && i < sizeof(nbnsan.NBNSAN_NNAME); ++i) {
+            nbnsan.NBNSAN_NNAME[i] = toupper(hostname[i]);
         }
+        nbnsan.NBNSAN_NTYPE = 0; // Workstation/Redirector
+        nbnsan.NBNSAN_NFLAGS = LWIP_PLATFORM_HTONS(0x400); // b-node, unique, active
 
-        pbuf * this_pb = pb;
-        pb = pb->next;
-        this_pb->next = NULL;
-        pbuf_free(this_pb);
+        conn->append((const char *)&nbnsan, sizeof(nbnsan));
+        conn->send(remoteAddr, NBNS_PORT);
     }
 }
 
-void ESP8266NetBIOS::_s_recv(void *arg, udp_pcb *upcb, pbuf *p, const ip_addr_t *addr, uint16_t port)
-{
-    reinterpret_cast<ESP8266NetBIOS*>(arg)->_recv(upcb, p, addr, port);
-}
-
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_NETBIOS)
 ESP8266NetBIOS NBNS;
 #endif
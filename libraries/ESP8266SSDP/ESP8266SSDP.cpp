@@ -45,6 +45,7 @@ extern "C" {
 #include "lwip/igmp.h"
 #include "lwip/mem.h"
 #include "include/UdpContext.h"
+#include "include/McastGroups.h"
 //#define DEBUG_SSDP  Serial
 
 #define SSDP_PORT         1900
@@ -56,6 +57,11 @@ extern "C" {
 // lwip-v2's igmp_joingroup only supports IPv4
 #define SSDP_MULTICAST_ADDR 239, 255, 255, 250
 
+// longest one-shot wait of the deadline timer; waits up to the next notify
+// are chunked into pieces of this size (the os timer cannot span a whole
+// notify interval anyway)
+#define SSDP_MAX_TIMER_WAIT_MS 60000
+
 static const char _ssdp_response_template[] PROGMEM =
   "HTTP/1.1 200 OK\r\n"
   "EXT:\r\n";
@@ -168,7 +174,7 @@ bool SSDPClass::begin() {
   IPAddress local = WiFi.localIP();
   IPAddress mcast(SSDP_MULTICAST_ADDR);
 
-  if (igmp_joingroup(local, mcast) != ERR_OK ) {
+  if (!esp8266::mcast::Groups::join(local, mcast)) {
 #ifdef DEBUG_SSDP
     DEBUG_SSDP.printf_P(PSTR("SSDP failed to join igmp group\n"));
 #endif
@@ -186,6 +192,8 @@ bool SSDPClass::begin() {
     return false;
   }
 
+  _buildPacketCache();
+
   _startTimer();
 
   return true;
@@ -206,7 +214,7 @@ void SSDPClass::end() {
   IPAddress local = WiFi.localIP();
   IPAddress mcast(SSDP_MULTICAST_ADDR);
 
-  if (igmp_leavegroup(local, mcast) != ERR_OK ) {
+  if (!esp8266::mcast::Groups::leave(local, mcast)) {
 #ifdef DEBUG_SSDP
     DEBUG_SSDP.printf_P(PSTR("SSDP failed to leave igmp group\n"));
 #endif
@@ -215,30 +223,68 @@ void SSDPClass::end() {
   _server->unref();
   _server = 0;
 
+  _invalidatePacketCache();
+
 #ifdef DEBUG_SSDP
     DEBUG_SSDP.printf_P(PSTR("ok\n"));
 #endif
 }
-void SSDPClass::_send(ssdp_method_t method) {
-  char buffer[1460];
-  IPAddress ip = WiFi.localIP();
 
+bool SSDPClass::_buildPacketCache() {
+  _invalidatePacketCache();
+
+  IPAddress ip = WiFi.localIP();
+  char buffer[1460];
   char valueBuffer[strlen_P(_ssdp_notify_template) + 1];
-  strcpy_P(valueBuffer, (method == NONE) ? _ssdp_response_template : _ssdp_notify_template);
-
-  int len = snprintf_P(buffer, sizeof(buffer),
-                       _ssdp_packet_template,
-                       valueBuffer,
-                       _interval,
-                       _modelName,
-                       _modelNumber,
-                       _uuid,
-                       (method == NONE) ? "ST" : "NT",
-                       (_st_is_uuid) ? _uuid : _deviceType,
-                       ip.toString().c_str(), _port, _schemaURL
-                      );
-
-  _server->append(buffer, len);
+
+  for (uint8_t kind = 0; kind < PACKET_COUNT; kind++) {
+    bool notify = (kind == PACKET_NOTIFY);
+    strcpy_P(valueBuffer, notify ? _ssdp_notify_template : _ssdp_response_template);
+
+    int len = snprintf_P(buffer, sizeof(buffer),
+                         _ssdp_packet_template,
+                         valueBuffer,
+                         _interval,
+                         _modelName,
+                         _modelNumber,
+                         _uuid,
+                         notify ? "NT" : "ST",
+                         (kind == PACKET_RESPONSE_UUID) ? _uuid : _deviceType,
+                         ip.toString().c_str(), _port, _schemaURL
+                        );
+    if (len <= 0 || (_packetCache[kind] = (char*)malloc(len + 1)) == nullptr) {
+      _invalidatePacketCache();
+      return false;
+    }
+    memcpy(_packetCache[kind], buffer, len + 1);
+    _packetLen[kind] = len;
+  }
+  _packetCacheIP = (uint32_t)ip;
+  return true;
+}
+
+void SSDPClass::_invalidatePacketCache() {
+  for (uint8_t kind = 0; kind < PACKET_COUNT; kind++) {
+    free(_packetCache[kind]);
+    _packetCache[kind] = nullptr;
+    _packetLen[kind] = 0;
+  }
+  _packetCacheIP = 0;
+}
+
+void SSDPClass::_send(ssdp_method_t method) {
+  // rebuild the precomputed packets when a setter or the local IP changed
+  if (!_packetCache[PACKET_NOTIFY] || _packetCacheIP != (uint32_t)WiFi.localIP()) {
+    if (!_buildPacketCache()) {
+      return;
+    }
+  }
+
+  uint8_t kind = (method == NONE)
+    ? ((_st_is_uuid) ? PACKET_RESPONSE_UUID : PACKET_RESPONSE_TYPE)
+    : PACKET_NOTIFY;
+
+  _server->append(_packetCache[kind], _packetLen[kind]);
 
   IPAddress remoteAddr;
   uint16_t remotePort;
@@ -427,22 +473,38 @@ void SSDPClass::_update() {
       _server->flush();
   }
 
+  // re-arm the deadline timer for the next due event: the pending response,
+  // or the next periodic notify
+  uint32_t wait_ms;
+  if (_pending) {
+    uint32_t waited = millis() - _process_time;
+    wait_ms = (waited < _delay) ? (_delay - waited) : 1;
+  } else {
+    uint32_t interval_ms = _interval * 1000L;
+    uint32_t since_notify = millis() - _notify_time;
+    wait_ms = (since_notify < interval_ms) ? (interval_ms - since_notify) : 1;
+  }
+  _armTimer(wait_ms);
 }
 
 void SSDPClass::setSchemaURL(const char *url) {
   strlcpy(_schemaURL, url, sizeof(_schemaURL));
+  _invalidatePacketCache();
 }
 
 void SSDPClass::setHTTPPort(uint16_t port) {
   _port = port;
+  _invalidatePacketCache();
 }
 
 void SSDPClass::setDeviceType(const char *deviceType) {
   strlcpy(_deviceType, deviceType, sizeof(_deviceType));
+  _invalidatePacketCache();
 }
 
 void SSDPClass::setUUID(const char *uuid) {
-  snprintf_P(_uuid, sizeof(_uuid), PSTR("uuid:%s"), uuid);  
+  snprintf_P(_uuid, sizeof(_uuid), PSTR("uuid:%s"), uuid);
+  _invalidatePacketCache();
 }
 
 void SSDPClass::setName(const char *name) {
@@ -463,10 +525,12 @@ void SSDPClass::setSerialNumber(const uint32_t serialNumber) {
 
 void SSDPClass::setModelName(const char *name) {
   strlcpy(_modelName, name, sizeof(_modelName));
+  _invalidatePacketCache();
 }
 
 void SSDPClass::setModelNumber(const char *num) {
   strlcpy(_modelNumber, num, sizeof(_modelNumber));
+  _invalidatePacketCache();
 }
 
 void SSDPClass::setModelURL(const char *url) {
@@ -487,6 +551,7 @@ void SSDPClass::setTTL(const uint8_t ttl) {
 
 void SSDPClass::setInterval(uint32_t interval) {
   _interval = interval;
+  _invalidatePacketCache();
 }
 
 void SSDPClass::_onTimerStatic(SSDPClass* self) {
@@ -497,10 +562,25 @@ void SSDPClass::_startTimer() {
   _stopTimer();
   _timer = new SSDPTimer();
   ETSTimer* tm = &(_timer->timer);
-  const int interval = 1000;
   os_timer_disarm(tm);
   os_timer_setfn(tm, reinterpret_cast<ETSTimerFunc*>(&SSDPClass::_onTimerStatic), reinterpret_cast<void*>(this));
-  os_timer_arm(tm, interval, 1 /* repeat */);
+  _armTimer(1000);
+}
+
+// one-shot deadline timer: armed for the next pending response or notify
+// instead of a repeating polling tick
+void SSDPClass::_armTimer(uint32_t ms) {
+  if (!_timer)
+    return;
+
+  if (ms < 1)
+    ms = 1;
+  else if (ms > SSDP_MAX_TIMER_WAIT_MS)
+    ms = SSDP_MAX_TIMER_WAIT_MS;
+
+  ETSTimer* tm = &(_timer->timer);
+  os_timer_disarm(tm);
+  os_timer_arm(tm, ms, 0 /* one-shot */);
 }
 
 void SSDPClass::_stopTimer() {
@@ -100,8 +100,11 @@ class SSDPClass{
   protected:
     void _send(ssdp_method_t method);
     void _update();
+    bool _buildPacketCache();
+    void _invalidatePacketCache();
     void _startTimer();
     void _stopTimer();
+    void _armTimer(uint32_t ms);
     static void _onTimerStatic(SSDPClass* self);
 
     UdpContext* _server = nullptr;
@@ -119,6 +122,19 @@ class SSDPClass{
     unsigned long _process_time = 0;
     unsigned long _notify_time = 0;
 
+    // Response/notify packets are precomputed (and only rebuilt when a setter
+    // or the local IP changes), so an M-SEARCH storm costs one append+send per
+    // response instead of a full snprintf format pass (see _buildPacketCache)
+    enum {
+      PACKET_RESPONSE_TYPE = 0,  // response, ST: deviceType
+      PACKET_RESPONSE_UUID,      // response, ST: uuid
+      PACKET_NOTIFY,             // notify, NT: deviceType
+      PACKET_COUNT
+    };
+    char* _packetCache[PACKET_COUNT] = {};
+    uint16_t _packetLen[PACKET_COUNT] = {};
+    uint32_t _packetCacheIP = 0;  // local IP the cache was built for
+
     char _schemaURL[SSDP_SCHEMA_URL_SIZE];
     char _uuid[SSDP_UUID_SIZE];
     char _deviceType[SSDP_DEVICE_TYPE_SIZE];
@@ -0,0 +1,70 @@
+/*
+  Built-in server-sent events channel.
+
+  The ServerSentEvents example shows the protocol done by hand; this one
+  uses the server's own SSE engine, which manages the subscribers, the
+  per-subscriber bounded queues and the reconnect interval for you.
+
+  Try it:
+    curl -sN "http://<esp-ip>/events"
+  or from a browser:
+    new EventSource("/events").addEventListener("sensor", e => console.log(e.data));
+
+  Open several at once: each event is formatted once and queued to every
+  subscriber. Stop one mid-stream - the others keep flowing, and the
+  dead peer is reaped on its next missed write.
+*/
+
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+
+#ifndef STASSID
+#define STASSID "your-ssid"
+#define STAPSK "your-password"
+#endif
+
+ESP8266WebServer server(80);
+ESP8266WebServer::SSEChannel* events;
+
+void setup() {
+  Serial.begin(115200);
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(STASSID, STAPSK);
+  while (WiFi.status() != WL_CONNECTED) {
+    delay(500);
+    Serial.print('.');
+  }
+  Serial.printf_P(PSTR("\nConnected, IP %s\n"), WiFi.localIP().toString().c_str());
+
+  // up to 4 subscribers; browsers reconnect after 3s if dropped
+  events = &server.sseHandler(F("/events"), 4, 3000);
+
+  server.on(F("/"), []() {
+    server.send(200, F("text/html"),
+                F("<script>new EventSource('/events').addEventListener('sensor',"
+                  "e=>document.body.innerHTML=e.data)</script>waiting..."));
+  });
+
+  server.begin();
+}
+
+void loop() {
+  server.handleClient();
+
+  // push a reading every second instead of being polled at 2 Hz
+  static unsigned long last = 0;
+  if (millis() - last >= 1000) {
+    last = millis();
+    String reading;
+    reading.reserve(48);
+    reading += F("{\"millis\":");
+    reading += millis();
+    reading += F(",\"heap\":");
+    reading += ESP.getFreeHeap();
+    reading += '}';
+    events->send("sensor", reading);
+    if (events->dropped()) {
+      Serial.printf_P(PSTR("slow subscriber: %u events dropped\n"), events->dropped());
+    }
+  }
+}
@@ -29,6 +29,11 @@
 #include "base64.h"
 #include "detail/RequestHandlersImpl.h"
 #include <StreamDev.h>
+#include <core_esp8266_profile.h>
+#include <NumberFormat.h>
+#ifdef HTTP_HANDLER_METRICS
+#include <JsonWriter.h>
+#endif
 
 static const char AUTHORIZATION_HEADER[] PROGMEM = "Authorization";
 static const char qop_auth[] PROGMEM = "qop=auth";
@@ -36,6 +41,10 @@ static const char qop_auth_quoted[] PROGMEM = "qop=\"auth\"";
 static const char WWW_Authenticate[] PROGMEM = "WWW-Authenticate";
 static const char Content_Length[] PROGMEM = "Content-Length";
 static const char ETAG_HEADER[] PROGMEM = "If-None-Match";
+static const char ACCEPT_ENCODING_HEADER[] PROGMEM = "Accept-Encoding";
+static const char RANGE_HEADER[] PROGMEM = "Range";
+static const char COOKIE_HEADER[] PROGMEM = "Cookie";
+static const char SESSION_COOKIE[] PROGMEM = "ESPSESSIONID";
 
 namespace esp8266webserver {
 
@@ -56,12 +65,20 @@ ESP8266WebServerTemplate<ServerType>::~ESP8266WebServerTemplate() {
   _server.close();
   if (_currentHeaders)
     delete[]_currentHeaders;
+  delete[] _currentArgs;
+  delete[] _postArgs;
   RequestHandlerType* handler = _firstHandler;
   while (handler) {
     RequestHandlerType* next = handler->next();
     delete handler;
     handler = next;
   }
+  SSEChannel* channel = _firstSSE;
+  while (channel) {
+    SSEChannel* next = channel->_next;
+    delete channel;
+    channel = next;
+  }
 }
 
 template <typename ServerType>
@@ -115,17 +132,27 @@ bool ESP8266WebServerTemplate<ServerType>::authenticate(const char * username, c
         return false;
       }
 
-      String encoded = base64::encode(raw, false);
-      if(!encoded.length()){
+      if(raw != _basicRaw) {
+        // cache miss: encode once, keep for subsequent requests
+        _basicRaw = raw;
+        _basicToken = base64::encode(raw, false);
+      }
+      if(!_basicToken.length()){
         return false;
       }
-      if(authReq.equalsConstantTime(encoded)) {
+      if(authReq.equalsConstantTime(_basicToken)) {
         return true;
       }
     } else if(authReq.startsWith(F("Digest"))) {
       String _realm    = _extractParam(authReq, F("realm=\""));
-      String _H1 = credentialHash(username,_realm,password);
-      return authenticateDigest(username,_H1);
+      if(!_authH1.length() || _authUser != username || _authRealm != _realm || _authPass != password) {
+        // cache miss: derive HA1 once, keep for subsequent requests
+        _authUser  = username;
+        _authRealm = _realm;
+        _authPass  = password;
+        _authH1    = credentialHash(_authUser, _authRealm, _authPass);
+      }
+      return authenticateDigest(username, _authH1);
     }
   }
   return false;
@@ -155,7 +182,16 @@ bool ESP8266WebServerTemplate<ServerType>::authenticateDigest(const String& user
         authReq = "";
         return false;
       }
-      if((_opaque != _sopaque) || (_nonce != _snonce) || (_realm != _srealm)) {
+      // the challenge must be one we issued; several may be outstanding
+      // when multiple clients authenticate concurrently
+      bool knownChallenge = false;
+      for (const auto& challenge: _challenges) {
+        if ((_nonce == challenge.nonce) && (_opaque == challenge.opaque) && (_realm == challenge.realm)) {
+          knownChallenge = true;
+          break;
+        }
+      }
+      if (!knownChallenge) {
         authReq = "";
         return false;
       }
@@ -223,6 +259,11 @@ void ESP8266WebServerTemplate<ServerType>::requestAuthentication(HTTPAuthMethod
   } else {
     _snonce=_getRandomHexString();
     _sopaque=_getRandomHexString();
+    DigestChallenge& challenge = _challenges[_nextChallenge];
+    _nextChallenge = (_nextChallenge + 1) % MAX_DIGEST_CHALLENGES;
+    challenge.nonce = _snonce;
+    challenge.opaque = _sopaque;
+    challenge.realm = _srealm;
     sendHeader(String(FPSTR(WWW_Authenticate)), String(F("Digest realm=\"")) +_srealm + String(F("\", qop=\"auth\", nonce=\"")) + _snonce + String(F("\", opaque=\"")) + _sopaque + String('\"'));
   }
   using namespace mime;
@@ -259,6 +300,32 @@ void ESP8266WebServerTemplate<ServerType>::_addRequestHandler(RequestHandlerType
       _lastHandler->next(handler);
       _lastHandler = handler;
     }
+    _routerDirty = true;
+}
+
+// Sort every registered handler into the radix router (literal routes) or
+// the in-order fallback list (patterns, user subclasses).  Runs once per
+// registration burst: _addRequestHandler just marks the router dirty and
+// the next dispatch rebuilds.
+template <typename ServerType>
+void ESP8266WebServerTemplate<ServerType>::_rebuildRouter() {
+  _router.clear();
+  _dynamicHandlers.clear();
+  uint16_t order = 0;
+  for (RequestHandlerType* handler = _firstHandler; handler; handler = handler->next(), order++) {
+    switch (handler->routeKind()) {
+    case RequestHandlerType::RouteKind::EXACT:
+      _router.addExact(handler->routeKey(), handler, order);
+      break;
+    case RequestHandlerType::RouteKind::PREFIX:
+      _router.addPrefix(handler->routeKey(), handler, order);
+      break;
+    default:
+      _dynamicHandlers.push_back({ handler, order });
+      break;
+    }
+  }
+  _routerDirty = false;
 }
 
 template <typename ServerType>
@@ -280,18 +347,56 @@ void ESP8266WebServerTemplate<ServerType>::serveStatic(const char* uri, FS& fs,
 
 template <typename ServerType>
 void ESP8266WebServerTemplate<ServerType>::handleClient() {
-  if (_currentStatus == HC_NONE) {
-    ClientType client = _server.accept();
-    if (!client) {
-      return;
+  PROFILE_SCOPE("WebServer::handleClient");
+
+  // accept pending clients into free connection slots
+  while (_server.hasClient()) {
+    Connection* slot = nullptr;
+    for (auto& conn: _connections) {
+      if (conn.status == HC_NONE) {
+        slot = &conn;
+        break;
+      }
     }
+    if (!slot)
+      break;
+    ClientType client = _server.accept();
+    if (!client)
+      break;
 
     DBGWS("New client\n");
 
-    _currentClient = client;
-    _currentStatus = HC_WAIT_READ;
-    _statusChange = millis();
+    slot->client = client;
+    slot->status = HC_WAIT_READ;
+    slot->statusChange = millis();
+  }
+
+  // service every live connection once per call, rotating the start
+  // offset so one busy client cannot starve the others
+  bool callYield = false;
+  for (uint8_t n = 0; n < WEBSERVER_MAX_CLIENTS; n++) {
+    Connection& conn = _connections[(_nextConnection + n) % WEBSERVER_MAX_CLIENTS];
+    if (conn.status == HC_NONE)
+      continue;
+    callYield = _serviceConnection(conn) || callYield;
   }
+  _nextConnection = (_nextConnection + 1) % WEBSERVER_MAX_CLIENTS;
+
+  // push queued SSE events and reap disconnected subscribers
+  for (SSEChannel* channel = _firstSSE; channel; channel = channel->_next) {
+    channel->_handleClients();
+  }
+
+  if (callYield) {
+    yield();
+  }
+}
+
+template <typename ServerType>
+bool ESP8266WebServerTemplate<ServerType>::_serviceConnection(Connection& conn) {
+  _currentClient = conn.client;
+  _currentStatus = conn.status;
+  _statusChange = conn.statusChange;
 
   bool keepCurrentClient = false;
   bool callYield = false;
@@ -338,18 +443,35 @@ void ESP8266WebServerTemplate<ServerType>::handleClient() {
     case HC_WAIT_READ:
       // Wait for data from client to become available
       if (_currentClient.available()) {
+        bool parseNext = true;
+        while (parseNext) {
+        parseNext = false;
         switch (_parseRequest(_currentClient))
         {
         case CLIENT_REQUEST_CAN_CONTINUE:
           _currentClient.setTimeout(HTTP_MAX_SEND_WAIT);
           _contentLength = CONTENT_LENGTH_NOT_SET;
           _handleRequest();
+          if (_clientUpgraded) {
+            // handler took ownership of the socket via upgrade(); drop our
+            // reference below without closing the connection
+            _clientUpgraded = false;
+            DBGWS("Upgrade client\n");
+            break;
+          }
           /* fallthrough */
         case CLIENT_REQUEST_IS_HANDLED:
           if (_currentClient.connected() || _currentClient.available()) {
             _currentStatus = HC_WAIT_CLOSE;
             _statusChange = millis();
             keepCurrentClient = true;
+            if (_currentClient.available()) {
+              // Pipelining: the next request is already buffered, so parse
+              // it now while lwIP drains the previous response in the
+              // background instead of waiting for the next pass
+              _currentStatus = HC_WAIT_READ;
+              parseNext = true;
+            }
           }
           else
             DBGWS("webserver: peer has closed after served\n");
@@ -364,6 +486,7 @@ void ESP8266WebServerTemplate<ServerType>::handleClient() {
           DBGWS("Give client\n");
           break;
         } // switch _parseRequest()
+        } // while parseNext
       } else {
         // !_currentClient.available(): waiting for more data
         unsigned long timeSinceChange = millis() - _statusChange;
@@ -381,9 +504,17 @@ void ESP8266WebServerTemplate<ServerType>::handleClient() {
         callYield = true;
       }
       break;
-    case HC_WAIT_CLOSE:
-      // Wait for client to close the connection
-      if (!_server.hasClient() && (millis() - _statusChange <= HTTP_MAX_CLOSE_WAIT)) {
+    case HC_WAIT_CLOSE: {
+      // Wait for client to close the connection, unless a pending client
+      // cannot get a slot without evicting this one
+      bool haveFreeSlot = false;
+      for (const auto& other: _connections) {
+        if (other.status == HC_NONE) {
+          haveFreeSlot = true;
+          break;
+        }
+      }
+      if ((haveFreeSlot || !_server.hasClient()) && (millis() - _statusChange <= HTTP_MAX_CLOSE_WAIT)) {
         keepCurrentClient = true;
         callYield = true;
         if (_currentClient.available())
@@ -391,25 +522,74 @@ void ESP8266WebServerTemplate<ServerType>::handleClient() {
             _currentStatus = HC_WAIT_READ;
       }
       break;
+    }
     } // switch _currentStatus
   }
 
   if (!keepCurrentClient) {
     DBGWS("Drop client\n");
     _currentClient = ClientType();
-    _currentStatus = HC_NONE;
+    conn.client = ClientType();
+    conn.status = HC_NONE;
     _currentUpload.reset();
+  } else {
+    conn.status = _currentStatus;
+    conn.statusChange = _statusChange;
+    _currentClient = ClientType();
   }
+  _currentStatus = HC_NONE;
 
-  if (callYield) {
-    yield();
-  }
+  return callYield;
+}
+
+template <typename ServerType>
+typename ESP8266WebServerTemplate<ServerType>::UpgradedChannel ESP8266WebServerTemplate<ServerType>::upgrade() {
+  // The channel copies the client, sharing the underlying connection;
+  // handleClient() then releases the server's reference without closing
+  // the socket, exactly like CLIENT_IS_GIVEN.
+  _clientUpgraded = true;
+  return UpgradedChannel(_currentClient);
+}
+
+template <typename ServerType>
+typename ESP8266WebServerTemplate<ServerType>::SSEChannel& ESP8266WebServerTemplate<ServerType>::sseHandler(const Uri& uri, uint8_t maxSubscribers, uint16_t retryMs) {
+  SSEChannel* channel = new SSEChannel(maxSubscribers, retryMs);
+  channel->_next = _firstSSE;
+  _firstSSE = channel;
+  on(uri, HTTP_GET, [this, channel]() {
+    if (channel->_full()) {
+      // tell the browser when to try again instead of letting it hammer
+      sendHeader(String(F("Retry-After")), String(channel->_retryMs / 1000 + 1));
+      send(503, String(FPSTR(mime::mimeTable[mime::txt].mimeType)), F("too many subscribers"));
+      return;
+    }
+    // the response never ends, so bypass send(): raw status line and
+    // headers, then the SSE reconnect interval as the first body bytes
+    String head;
+    head.reserve(160);
+    head += F("HTTP/1.1 200 OK\r\n"
+              "Content-Type: text/event-stream\r\n"
+              "Cache-Control: no-cache\r\n"
+              "Connection: keep-alive\r\n"
+              "\r\n"
+              "retry: ");
+    head += channel->_retryMs;
+    head += F("\n\n");
+    UpgradedChannel raw = upgrade();
+    raw.client().write(head.c_str(), head.length());
+    channel->_subscribe(raw.client());
+  });
+  return *channel;
 }
 
 template <typename ServerType>
 void ESP8266WebServerTemplate<ServerType>::close() {
   _server.close();
   _currentStatus = HC_NONE;
+  for (auto& conn: _connections) {
+    conn.client = ClientType();
+    conn.status = HC_NONE;
+  }
   if(!_headerKeysCount)
     collectHeaders();
 }
@@ -559,6 +739,139 @@ void ESP8266WebServerTemplate<ServerType>::sendContent_P(PGM_P content, size_t s
   return sendContent(&ptr, size);
 }
 
+template <typename ServerType>
+template <typename T>
+void ESP8266WebServerTemplate<ServerType>::sendTemplate(T &file, TemplateResolverFunction resolver, const String& contentType) {
+  constexpr size_t maxTokenLength = 32;
+  auto writer = beginChunked(200, contentType.c_str());
+  String token;
+  bool inToken = false;
+  uint8_t buf[128];
+  int n;
+  while ((n = file.read(buf, sizeof(buf))) > 0) {
+    for (int i = 0; i < n; i++) {
+      char c = (char)buf[i];
+      if (!inToken) {
+        if (c == '%') {
+          inToken = true;
+          token = emptyString;
+        } else {
+          writer.write((uint8_t)c);
+        }
+      } else if (c == '%') {
+        if (!token.length()) {
+          // "%%" escapes a literal percent sign
+          writer.write((uint8_t)'%');
+        } else if (resolver) {
+          String value = resolver(token);
+          writer.write((const uint8_t*)value.c_str(), value.length());
+        }
+        inToken = false;
+      } else if ((token.length() >= maxTokenLength)
+                 || !(isalnum((unsigned char)c) || (c == '_'))) {
+        // not a token after all: emit the swallowed text verbatim
+        writer.write((uint8_t)'%');
+        writer.write((const uint8_t*)token.c_str(), token.length());
+        writer.write((uint8_t)c);
+        inToken = false;
+      } else {
+        token += c;
+      }
+    }
+  }
+  if (inToken) {
+    // unterminated marker at end of template
+    writer.write((uint8_t)'%');
+    writer.write((const uint8_t*)token.c_str(), token.length());
+  }
+  writer.end();
+}
+
+template <typename ServerType>
+void ESP8266WebServerTemplate<ServerType>::setCredentials(const char* username, const char* password, const char* realm)
+{
+  _authUser  = username;
+  _authRealm = realm ? String(realm) : String(F("Login Required"));
+  _authPass  = password;
+  _authH1    = credentialHash(_authUser, _authRealm, _authPass);
+  _basicRaw  = _authUser + ':' + _authPass;
+  _basicToken = base64::encode(_basicRaw, false);
+}
+
+template <typename ServerType>
+String ESP8266WebServerTemplate<ServerType>::createSession(uint32_t ttlSeconds) {
+  // prefer a free or expired slot; otherwise evict the next in the ring
+  Session* slot = nullptr;
+  for (auto& session: _sessions) {
+    if (!session.token[0] || (int32_t)(session.expires - millis()) <= 0) {
+      slot = &session;
+      break;
+    }
+  }
+  if (!slot) {
+    slot = &_sessions[_nextSession];
+    _nextSession = (_nextSession + 1) % WEBSERVER_MAX_SESSIONS;
+  }
+  String token = _getRandomHexString();  // 128 bits from the hardware RNG
+  strncpy(slot->token, token.c_str(), sizeof(slot->token));
+  slot->expires = millis() + ttlSeconds * 1000;
+  sendHeader(String(F("Set-Cookie")), String(FPSTR(SESSION_COOKIE)) + '=' + token + F("; Path=/; HttpOnly; SameSite=Strict"));
+  return token;
+}
+
+template <typename ServerType>
+bool ESP8266WebServerTemplate<ServerType>::authenticateSession() {
+  const String token = _sessionToken();
+  if (token.length() != sizeof(_sessions[0].token) - 1)
+    return false;
+  const uint32_t now = millis();
+  uint8_t match = 0;
+  // probe every slot without early exit so timing does not reveal which
+  // slot, if any, held the token
+  for (auto& session: _sessions) {
+    uint8_t diff = session.token[0] ? 0 : 1;
+    for (size_t n = 0; n < sizeof(session.token) - 1; n++)
+      diff |= (uint8_t)(session.token[n] ^ token[n]);
+    if ((int32_t)(session.expires - now) <= 0)
+      diff = 1;
+    match |= (uint8_t)(diff == 0);
+  }
+  return match;
+}
+
+template <typename ServerType>
+void ESP8266WebServerTemplate<ServerType>::revokeSession() {
+  const String token = _sessionToken();
+  if (token.length()) {
+    for (auto& session: _sessions) {
+      if (token == session.token)
+        session.token[0] = '\0';
+    }
+  }
+  sendHeader(String(F("Set-Cookie")), String(FPSTR(SESSION_COOKIE)) + F("=; Path=/; Max-Age=0"));
+}
+
+// value of the session cookie in the current request, or empty
+template <typename ServerType>
+String ESP8266WebServerTemplate<ServerType>::_sessionToken() const {
+  if (!hasHeader(FPSTR(COOKIE_HEADER)))
+    return emptyString;
+  const String& cookies = header(FPSTR(COOKIE_HEADER));
+  const String name = String(FPSTR(SESSION_COOKIE)) + '=';
+  int begin = cookies.indexOf(name);
+  // the match must start the header or follow a separator, not be the
+  // tail of a longer cookie name
+  while (begin > 0 && cookies[begin - 1] != ' ' && cookies[begin - 1] != ';')
+    begin = cookies.indexOf(name, begin + 1);
+  if (begin < 0)
+    return emptyString;
+  const int start = begin + name.length();
+  int end = cookies.indexOf(';', start);
+  if (end < 0)
+    end = cookies.length();
+  return cookies.substring(start, end);
+}
+
 template <typename ServerType>
 String ESP8266WebServerTemplate<ServerType>::credentialHash(const String& username, const String& realm, const String& password)
 {
@@ -569,19 +882,82 @@ String ESP8266WebServerTemplate<ServerType>::credentialHash(const String& userna
   return md5.toString();
 }
 
+// true when streaming this file will carry "Content-Encoding: gzip",
+// i.e. a precompressed sibling is being served under the original name's
+// content type
 template <typename ServerType>
-void ESP8266WebServerTemplate<ServerType>::_streamFileCore(const size_t fileSize, const String &fileName, const String &contentType)
+bool ESP8266WebServerTemplate<ServerType>::_isGzipEncoded(const String& fileName, const String& contentType)
 {
   using namespace mime;
-  setContentLength(fileSize);
-  if (fileName.endsWith(String(FPSTR(mimeTable[gz].endsWith))) &&
+  return fileName.endsWith(String(FPSTR(mimeTable[gz].endsWith))) &&
       contentType != String(FPSTR(mimeTable[gz].mimeType)) &&
-      contentType != String(FPSTR(mimeTable[none].mimeType))) {
+      contentType != String(FPSTR(mimeTable[none].mimeType));
+}
+
+template <typename ServerType>
+void ESP8266WebServerTemplate<ServerType>::_streamFileCore(const size_t fileSize, const String &fileName, const String &contentType)
+{
+  setContentLength(fileSize);
+  if (_isGzipEncoded(fileName, contentType)) {
     sendHeader(F("Content-Encoding"), F("gzip"));
   }
   send(200, contentType, emptyString);
 }
 
+// Evaluate a single-range "Range: bytes=..." request header against a body
+// of fileSize bytes.  Returns 200 when there is no range (or one we may
+// legitimately ignore per RFC 7233: other units, multi-range, malformed),
+// 206 with rangeStart/rangeLength filled in, or 416 when the range is
+// syntactically fine but unsatisfiable.
+template <typename ServerType>
+int ESP8266WebServerTemplate<ServerType>::_parseRangeHeader(const size_t fileSize, size_t& rangeStart, size_t& rangeLength)
+{
+  const String& range = header(FPSTR(RANGE_HEADER));
+  if (!range.length())
+    return 200;
+  if (!range.startsWith(F("bytes=")) || range.indexOf(',') >= 0)
+    return 200;
+
+  const char* firstp = range.c_str() + 6;
+  const char* rangeEnd = range.c_str() + range.length();
+  if (*firstp == '-') {
+    // suffix form "bytes=-N": the last N bytes
+    uint32_t suffix = 0;
+    const numfmt_parse_result sres = numfmt_parse_u32(firstp + 1, rangeEnd, suffix);
+    if (!sres.ok || sres.ptr != rangeEnd)
+      return 200; // malformed: ignore
+    if (!suffix || !fileSize)
+      return 416;
+    rangeStart = suffix < fileSize ? fileSize - suffix : 0;
+    rangeLength = fileSize - rangeStart;
+    return 206;
+  }
+
+  uint32_t first = 0;
+  const numfmt_parse_result fres = numfmt_parse_u32(firstp, rangeEnd, first);
+  if (!fres.ok || fres.ptr == rangeEnd || *fres.ptr != '-')
+    return 200; // malformed: ignore
+  size_t last;
+  const char* lastp = fres.ptr + 1;
+  if (lastp == rangeEnd) {
+    // open-ended "bytes=N-": from N to the end
+    last = fileSize ? fileSize - 1 : 0;
+  } else {
+    uint32_t v = 0;
+    const numfmt_parse_result lres = numfmt_parse_u32(lastp, rangeEnd, v);
+    if (!lres.ok || lres.ptr != rangeEnd || v < first)
+      return 200; // malformed: ignore
+    last = v;
+  }
+  if (first >= fileSize)
+    return 416; // past the end: answer "bytes */size"
+  if (last >= fileSize)
+    last = fileSize - 1;
+  rangeStart = first;
+  rangeLength = last - first + 1;
+  return 206;
+}
+
 template <typename ServerType>
 const String& ESP8266WebServerTemplate<ServerType>::pathArg(unsigned int i) const {
   if (_currentHandler != nullptr)
@@ -647,11 +1023,14 @@ template<typename ServerType>
 void ESP8266WebServerTemplate<ServerType>::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
   if (_currentHeaders)
     delete[] _currentHeaders;
-  _currentHeaders = new RequestArgument[_headerKeysCount = headerKeysCount + 2];
+  _currentHeaders = new RequestArgument[_headerKeysCount = headerKeysCount + 5];
   _currentHeaders[0].key = FPSTR(AUTHORIZATION_HEADER);
   _currentHeaders[1].key = FPSTR(ETAG_HEADER);
-  for (int i = 2; i < _headerKeysCount; i++){
-      _currentHeaders[i].key = headerKeys[i - 2];
+  _currentHeaders[2].key = FPSTR(ACCEPT_ENCODING_HEADER);
+  _currentHeaders[3].key = FPSTR(RANGE_HEADER);
+  _currentHeaders[4].key = FPSTR(COOKIE_HEADER);
+  for (int i = 5; i < _headerKeysCount; i++){
+      _currentHeaders[i].key = headerKeys[i - 5];
   }
 }
 
@@ -660,9 +1039,12 @@ template <typename... Args>
 void ESP8266WebServerTemplate<ServerType>::collectHeaders(const Args&... args) {
   if (_currentHeaders)
     delete[] _currentHeaders;
-  _currentHeaders = new RequestArgument[_headerKeysCount = sizeof...(args) + 2] {
+  _currentHeaders = new RequestArgument[_headerKeysCount = sizeof...(args) + 5] {
     { .key = FPSTR(AUTHORIZATION_HEADER), .value = emptyString },
     { .key = FPSTR(ETAG_HEADER), .value = emptyString },
+    { .key = FPSTR(ACCEPT_ENCODING_HEADER), .value = emptyString },
+    { .key = FPSTR(RANGE_HEADER), .value = emptyString },
+    { .key = FPSTR(COOKIE_HEADER), .value = emptyString },
     { .key = args, .value = emptyString } ...
   };
 }
@@ -710,6 +1092,40 @@ void ESP8266WebServerTemplate<ServerType>::onNotFound(THandlerFunction fn) {
   _notFoundHandler = fn;
 }
 
+#ifdef HTTP_HANDLER_METRICS
+template <typename ServerType>
+void ESP8266WebServerTemplate<ServerType>::enableMetrics(const Uri& uri) {
+  on(uri, HTTP_GET, [this]() {
+    auto out = beginChunked(200, "application/json");
+    JsonWriter json(out);
+    json.beginArray();
+    for (RequestHandlerType* h = _firstHandler; h; h = h->next()) {
+      const auto& m = h->metrics();
+      json.beginObject();
+      if (h->routeKind() == RequestHandlerType::RouteKind::NONE)
+        json.property(F("route"), F("(dynamic)"));
+      else
+        json.property(F("route"), h->routeKey());
+      json.property(F("calls"), m.calls);
+      if (m.calls) {
+        json.name(F("cycles")).beginObject()
+            .property(F("min"), m.cyclesMin)
+            .property(F("max"), m.cyclesMax)
+            .property(F("avg"), (uint32_t)(m.cyclesTotal / m.calls))
+            .endObject();
+        json.name(F("heap")).beginObject()
+            .property(F("min"), m.heapMin)
+            .property(F("max"), m.heapMax)
+            .property(F("avg"), (int32_t)(m.heapTotal / (int64_t)m.calls))
+            .endObject();
+      }
+      json.endObject();
+    }
+    json.endArray();
+  });
+}
+#endif
+
 template <typename ServerType>
 void ESP8266WebServerTemplate<ServerType>::_handleRequest() {
   bool handled = false;
@@ -717,7 +1133,15 @@ void ESP8266WebServerTemplate<ServerType>::_handleRequest() {
     DBGWS("request handler not found\n");
   }
   else {
+#ifdef HTTP_HANDLER_METRICS
+    const uint32_t heapBefore = ESP.getFreeHeap();
+    const uint32_t cyclesBefore = ESP.getCycleCount();
+#endif
     handled = _currentHandler->handle(*this, _currentMethod, _currentUri);
+#ifdef HTTP_HANDLER_METRICS
+    _currentHandler->metrics().record(ESP.getCycleCount() - cyclesBefore,
+                                      (int32_t)(ESP.getFreeHeap() - heapBefore));
+#endif
     if (!handled) {
       DBGWS("request handler failed to handle request\n");
     }
@@ -18,6 +18,21 @@
   License along with this library; if not, write to the Free Software
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
   Modified 8 May 2015 by Hristo Gochkov (proper post and file upload handling)
+
+  Build-time feature gates (flash budget knobs):
+  - -DWEBSERVER_NO_MULTIPART_UPLOAD
+    Removes multipart/form-data parsing (file uploads) from the request path;
+    multipart bodies are then treated like any other opaque POST body.  Since
+    the parser is template code it is simply never instantiated, saving a few
+    KB of flash for servers that only handle GET/urlencoded POST.  Compare the
+    linker size report (or 'tools/sizes.py --elf ...') with and without the
+    define to measure the gain for your sketch.
+  - -DHTTP_HANDLER_METRICS
+    Compiles per-handler accounting into the request pipeline: each
+    dispatch through _handleRequest() records CPU cycles and free-heap
+    delta, kept as min/max/avg per registered handler.  enableMetrics()
+    registers a built-in endpoint (default "/metrics") dumping the
+    counters as JSON.  Without the define nothing is sampled or stored.
 */
 
 
@@ -58,6 +73,20 @@ enum HTTPAuthMethod { BASIC_AUTH, DIGEST_AUTH };
 #define HTTP_UPLOAD_BUFLEN 2048
 #endif
 
+#ifndef WEBSERVER_MAX_CLIENTS
+#define WEBSERVER_MAX_CLIENTS 4 // concurrent keep-alive connections serviced by handleClient()
+#endif
+
+#ifndef WEBSERVER_SSE_QUEUE
+#define WEBSERVER_SSE_QUEUE 8 // events buffered per SSE subscriber before the oldest is dropped
+#endif
+
+#ifndef WEBSERVER_MAX_SESSIONS
+#define WEBSERVER_MAX_SESSIONS 8 // size of the createSession() token table
+#endif
+
+#define HTTP_SESSION_TTL 3600 // seconds a session token stays valid
+
 #define HTTP_MAX_DATA_WAIT 5000 //ms to wait for the client to send the request
 #define HTTP_MAX_DATA_AVAILABLE_WAIT 30 //ms to wait for the client to send the request when there is another client with data available
 #define HTTP_MAX_POST_WAIT 5000 //ms to wait for POST data to arrive
@@ -86,6 +115,7 @@ class ESP8266WebServerTemplate;
 }
 
 #include "detail/RequestHandler.h"
+#include "detail/UriRouter.h"
 
 namespace esp8266webserver {
 
@@ -102,7 +132,7 @@ public:
   using WebServerType = ESP8266WebServerTemplate<ServerType>;
   enum ClientFuture { CLIENT_REQUEST_CAN_CONTINUE, CLIENT_REQUEST_IS_HANDLED, CLIENT_MUST_STOP, CLIENT_IS_GIVEN };
   typedef String (*ContentTypeFunction) (const String&);
-  using HookFunction = std::function<ClientFuture(const String& method, const String& url, WiFiClient* client, ContentTypeFunction contentType)>;
+  using HookFunction = std::function<ClientFuture(const String& method, const String& url, ClientType* client, ContentTypeFunction contentType)>;
 
   void begin();
   void begin(uint16_t port);
@@ -114,6 +144,22 @@ public:
   bool authenticateDigest(const String& username, const String& H1);
   void requestAuthentication(HTTPAuthMethod mode = BASIC_AUTH, const char* realm = NULL, const String& authFailMsg = String("") );
 
+  // Precompute the credential digests used by authenticate(): the Basic
+  // token and the digest-auth HA1 for (username, realm) are derived once
+  // here instead of per request.  authenticate() refreshes the cache on
+  // a miss, so calling this is optional; realm defaults to the one
+  // requestAuthentication() uses.
+  void setCredentials(const char* username, const char* password, const char* realm = NULL);
+
+  // Session layer on top of authenticate(): once a client has proven its
+  // credentials, createSession() stores a random token in a fixed table
+  // and sends it as a cookie; authenticateSession() then validates the
+  // Cookie header with a constant-time table probe, so later requests
+  // skip the Basic/Digest machinery entirely.
+  String createSession(uint32_t ttlSeconds = HTTP_SESSION_TTL);
+  bool authenticateSession();
+  void revokeSession(); // forget the requesting client's session, expire its cookie
+
   typedef std::function<void(void)> THandlerFunction;
   typedef std::function<String(FS &fs, const String &fName)> ETagFunction;
 
@@ -126,6 +172,12 @@ public:
   void onFileUpload(THandlerFunction fn); //handle file uploads
   void enableCORS(bool enable);
   void enableETag(bool enable, ETagFunction fn = nullptr);
+#ifdef HTTP_HANDLER_METRICS
+  // Register a GET endpoint dumping the per-handler cycle/heap counters
+  // (see the HTTP_HANDLER_METRICS feature gate above) as a JSON array,
+  // one object per registered handler in registration order.
+  void enableMetrics(const Uri& uri = Uri(F("/metrics")));
+#endif
 
   const String& uri() const { return _currentUri; }
   HTTPMethod method() const { return _currentMethod; }
@@ -207,6 +259,352 @@ public:
     sendContent(emptyString);
   }
 
+  // First-class chunked response writer.  Payload printed to it is
+  // accumulated in a single buffer with room reserved for the chunk
+  // framing, so every flush costs exactly one client write instead of a
+  // heap String plus separate chunk-header/payload/CRLF writes per
+  // sendContent() call.  end() (or destruction) flushes pending data and
+  // sends the terminating chunk.
+  class ChunkedWriter : public Print {
+    public:
+      ChunkedWriter(ChunkedWriter&& other) noexcept :
+        _server(other._server), _buf(std::move(other._buf)),
+        _cap(other._cap), _len(other._len), _chunked(other._chunked) {
+        other._server = nullptr;
+      }
+      ~ChunkedWriter() {
+        end();
+      }
+
+      size_t write(uint8_t b) override {
+        return write(&b, 1);
+      }
+
+      size_t write(const uint8_t* data, size_t size) override {
+        if (!_server)
+          return 0;
+        if (!_buf) {
+          // buffer allocation failed, degrade to one frame per write
+          emitChunk((const char*)data, size);
+          return size;
+        }
+        size_t written = 0;
+        while (written < size) {
+          if (_len == _cap)
+            flush();
+          size_t chunk = std::min(_cap - _len, size - written);
+          memcpy(_buf.get() + FRAMING_PREFIX + _len, data + written, chunk);
+          _len += chunk;
+          written += chunk;
+        }
+        return written;
+      }
+
+      void flush() override {
+        if (!_server || !_len)
+          return;
+        if (_chunked) {
+          // place the framing right before the payload, CRLF right after,
+          // and hand everything to the client in one write
+          char framing[FRAMING_PREFIX + 1];
+          int framingLen = snprintf(framing, sizeof(framing), "%zx\r\n", _len);
+          char* start = _buf.get() + FRAMING_PREFIX - framingLen;
+          memcpy(start, framing, framingLen);
+          memcpy(_buf.get() + FRAMING_PREFIX + _len, "\r\n", 2);
+          _server->_currentClient.write(start, framingLen + _len + 2);
+        } else {
+          // HTTP/1.0 client: plain streaming, no framing
+          _server->_currentClient.write(_buf.get() + FRAMING_PREFIX, _len);
+        }
+        _len = 0;
+      }
+
+      // flush pending payload and terminate the chunked response
+      void end() {
+        if (!_server)
+          return;
+        flush();
+        if (_chunked) {
+          _server->_currentClient.write("0\r\n\r\n", 5);
+          _server->_chunked = false;
+        }
+        _server = nullptr;
+      }
+
+    private:
+      friend class ESP8266WebServerTemplate;
+      static constexpr size_t FRAMING_PREFIX = 10; // up to 8 hex digits + CRLF
+
+      ChunkedWriter(ESP8266WebServerTemplate& server, size_t bufferSize, bool chunked) :
+        _server(&server), _cap(bufferSize), _chunked(chunked) {
+        _buf.reset(new (std::nothrow) char[FRAMING_PREFIX + _cap + 2]);
+      }
+
+      void emitChunk(const char* data, size_t size) {
+        if (_chunked && size)
+          _server->_currentClient.printf("%zx\r\n", size);
+        _server->_currentClient.write(data, size);
+        if (_chunked && size)
+          _server->_currentClient.write("\r\n", 2);
+      }
+
+      ESP8266WebServerTemplate* _server;
+      std::unique_ptr<char[]> _buf;
+      size_t _cap = 0;
+      size_t _len = 0;
+      bool _chunked = false;
+  };
+
+  // Send the response headers and return a writer streaming the body in
+  // chunked transfer encoding (plain streaming for HTTP/1.0 clients).
+  ChunkedWriter beginChunked(int code, const char* content_type, size_t bufferSize = TCP_MSS) {
+    bool chunked = chunkedResponseModeStart(code, content_type);
+    if (!chunked) {
+      // HTTP/1.0 client: stream the body raw, delimited by connection close
+      keepAlive(false);
+      setContentLength(CONTENT_LENGTH_UNKNOWN);
+      send(code, content_type, emptyString);
+    }
+    return ChunkedWriter(*this, bufferSize, chunked);
+  }
+
+  // Persistent push channel over an upgraded connection.  A handler calls
+  // upgrade() to detach the current client from the request/parse loop;
+  // the socket stays open and user-owned, so updates can be pushed as
+  // small frames instead of full HTTP responses.  Framing is a 2-byte
+  // big-endian payload length followed by the payload, in both
+  // directions.
+  class UpgradedChannel {
+    public:
+      UpgradedChannel() { }
+
+      // true while the peer is still connected
+      operator bool() { return _client.connected(); }
+
+      // push one frame; false when the peer is gone or the write came up
+      // short
+      bool sendFrame(const uint8_t* payload, uint16_t length) {
+        if (!_client.connected())
+          return false;
+        uint8_t prefix[2] = { (uint8_t)(length >> 8), (uint8_t)length };
+        return _client.write(prefix, 2) == 2
+            && _client.write(payload, length) == length;
+      }
+      bool sendFrame(const String& payload) {
+        return sendFrame((const uint8_t*)payload.c_str(), payload.length());
+      }
+
+      // Poll for a complete inbound frame.  Returns its payload length
+      // once one has fully arrived, 0 otherwise (an empty frame is thus
+      // indistinguishable from "nothing yet").  Payload beyond bufferSize
+      // is discarded.
+      size_t recvFrame(uint8_t* buffer, size_t bufferSize) {
+        if (!_rxHaveLen) {
+          if (_client.available() < 2)
+            return 0;
+          uint8_t prefix[2];
+          _client.read(prefix, 2);
+          _rxLen = (prefix[0] << 8) | prefix[1];
+          _rxHaveLen = true;
+        }
+        if (_client.available() < (int)_rxLen)
+          return 0;
+        size_t take = std::min((size_t)_rxLen, bufferSize);
+        _client.read(buffer, take);
+        for (size_t i = take; i < _rxLen; i++)
+          _client.read();
+        _rxHaveLen = false;
+        return take;
+      }
+
+      // direct socket access, e.g. for setNoDelay() or stop()
+      ClientType& client() { return _client; }
+      void close() { _client.stop(); }
+
+    private:
+      friend class ESP8266WebServerTemplate;
+      explicit UpgradedChannel(const ClientType& client) : _client(client) { }
+
+      ClientType _client;
+      uint16_t _rxLen = 0;
+      bool _rxHaveLen = false;
+  };
+
+  // Detach the current client from the request loop and hand it to the
+  // caller as a persistent channel.  Only meaningful inside a request
+  // handler; the server sends no response for this request and never
+  // touches the socket again, so the handler must not call send().
+  UpgradedChannel upgrade();
+
+  // Server-sent events: a one-way push channel browsers speak natively
+  // (EventSource).  sseHandler() registers a GET endpoint; subscribers
+  // stay connected and handleClient() keeps pumping their queues.
+  // send() formats an event once into a shared buffer, every subscriber
+  // then queues a reference to it - N sends of one rendered event, not
+  // N copies.  Queues are bounded (WEBSERVER_SSE_QUEUE events each):
+  // when a slow peer falls behind its oldest unsent event is dropped,
+  // so subscribers always converge on the freshest data.  Events carry
+  // sequential ids and the stream opens with a "retry:" field, so a
+  // dropped browser reconnects by itself after retryMs; a full
+  // subscriber table answers 503 with Retry-After.
+  class SSEChannel {
+    public:
+      ~SSEChannel() {
+        for (uint8_t s = 0; s < _maxSubs; s++)
+          if (_subs[s].inUse)
+            _subs[s].client.stop();
+        delete[] _subs;
+      }
+
+      // broadcast one event; false when nobody is subscribed
+      bool send(const String& data) { return send(nullptr, data); }
+      bool send(const char* event, const String& data) {
+        if (!subscribers())
+          return false;
+        auto buffer = std::make_shared<String>();
+        String& out = *buffer;
+        out.reserve(data.length() + 32);
+        if (event) {
+          out += F("event: ");
+          out += event;
+          out += '\n';
+        }
+        out += F("id: ");
+        out += ++_lastEventId;
+        out += '\n';
+        // one "data:" line per line of payload, per the SSE grammar
+        unsigned int start = 0;
+        for (;;) {
+          int nl = data.indexOf('\n', start);
+          out += F("data: ");
+          if (nl < 0) {
+            out += data.substring(start);
+            out += '\n';
+            break;
+          }
+          out += data.substring(start, nl);
+          out += '\n';
+          start = nl + 1;
+        }
+        out += '\n';
+        for (uint8_t s = 0; s < _maxSubs; s++)
+          if (_subs[s].inUse)
+            _enqueue(_subs[s], buffer);
+        return true;
+      }
+
+      size_t subscribers() const {
+        size_t n = 0;
+        for (uint8_t s = 0; s < _maxSubs; s++)
+          if (_subs[s].inUse)
+            n++;
+        return n;
+      }
+
+      // events discarded because a subscriber's queue was full
+      uint32_t dropped() const { return _dropped; }
+      uint32_t lastEventId() const { return _lastEventId; }
+
+    private:
+      friend class ESP8266WebServerTemplate;
+
+      struct Subscriber {
+        ClientType client;
+        std::shared_ptr<const String> queue[WEBSERVER_SSE_QUEUE];
+        uint8_t head = 0;
+        uint8_t count = 0;
+        size_t offset = 0;  // bytes of queue[head] already on the wire
+        bool inUse = false;
+      };
+
+      SSEChannel(uint8_t maxSubscribers, uint16_t retryMs)
+        : _maxSubs(maxSubscribers ? maxSubscribers : 1), _retryMs(retryMs),
+          _subs(new Subscriber[_maxSubs]) { }
+      SSEChannel(const SSEChannel&) = delete;
+
+      bool _full() const { return subscribers() == _maxSubs; }
+
+      void _subscribe(const ClientType& client) {
+        for (uint8_t s = 0; s < _maxSubs; s++) {
+          Subscriber& sub = _subs[s];
+          if (!sub.inUse) {
+            sub.client = client;
+            sub.inUse = true;
+            return;
+          }
+        }
+      }
+
+      void _enqueue(Subscriber& sub, const std::shared_ptr<const String>& buffer) {
+        if (sub.count == WEBSERVER_SSE_QUEUE) {
+          _dropped++;
+          // drop the oldest whole event; never the head mid-write, that
+          // would corrupt the stream
+          const uint8_t victim = sub.offset ? 1 : 0;
+          if (victim >= sub.count)
+            return; // single-slot queue, head mid-write: drop the new event
+          for (uint8_t i = victim; i + 1 < sub.count; i++)
+            sub.queue[(sub.head + i) % WEBSERVER_SSE_QUEUE]
+              = sub.queue[(sub.head + i + 1) % WEBSERVER_SSE_QUEUE];
+          sub.count--;
+        }
+        sub.queue[(sub.head + sub.count) % WEBSERVER_SSE_QUEUE] = buffer;
+        sub.count++;
+      }
+
+      void _release(Subscriber& sub) {
+        sub.client.stop();
+        sub.client = ClientType();
+        for (uint8_t i = 0; i < WEBSERVER_SSE_QUEUE; i++)
+          sub.queue[i].reset();
+        sub.head = sub.count = 0;
+        sub.offset = 0;
+        sub.inUse = false;
+      }
+
+      // drain as much queued data as the TCP windows accept, never block
+      void _handleClients() {
+        for (uint8_t s = 0; s < _maxSubs; s++) {
+          Subscriber& sub = _subs[s];
+          if (!sub.inUse)
+            continue;
+          if (!sub.client.connected()) {
+            _release(sub);
+            continue;
+          }
+          while (sub.count) {
+            const String& out = *sub.queue[sub.head];
+            const size_t space = sub.client.availableForWrite();
+            if (!space)
+              break;
+            const size_t want = std::min(space, out.length() - sub.offset);
+            const size_t sent
+              = sub.client.write(reinterpret_cast<const uint8_t*>(out.c_str()) + sub.offset, want);
+            sub.offset += sent;
+            if (sub.offset == out.length()) {
+              sub.queue[sub.head].reset();
+              sub.head = (sub.head + 1) % WEBSERVER_SSE_QUEUE;
+              sub.count--;
+              sub.offset = 0;
+            }
+            if (sent < want)
+              break;
+          }
+        }
+      }
+
+      const uint8_t _maxSubs;
+      const uint16_t _retryMs;
+      Subscriber* _subs;
+      SSEChannel* _next = nullptr;
+      uint32_t _lastEventId = 0;
+      uint32_t _dropped = 0;
+  };
+
+  // Register an SSE endpoint at 'uri'.  The returned channel is owned
+  // by the server and stays valid for its lifetime.
+  SSEChannel& sseHandler(const Uri& uri, uint8_t maxSubscribers = 4, uint16_t retryMs = 3000);
+
   // Whether other requests should be accepted from the client on the
   // same socket after a response is sent.
   // This will automatically configure the "Connection" header of the response.
@@ -219,6 +617,23 @@ public:
 
   static String urlDecode(const String& text);
 
+  // Token resolver for sendTemplate(): receives the name found between two
+  // '%' markers and returns the replacement text.
+  typedef std::function<String(const String& token)> TemplateResolverFunction;
+
+  // Stream a template (file or any object with read(uint8_t*, size_t))
+  // through the chunked path, replacing %TOKEN% markers with
+  // resolver(TOKEN); "%%" emits a literal '%'.  Tokens are made of
+  // [A-Za-z0-9_], at most 32 chars - anything else is passed through
+  // verbatim.  Peak heap use stays bounded by the writer buffer no matter
+  // how large the template is.
+  template<typename T>
+  void sendTemplate(T &file, TemplateResolverFunction resolver, const String& contentType);
+  template<typename T>
+  void sendTemplate(T &file, TemplateResolverFunction resolver) {
+    sendTemplate(file, resolver, String(F("text/html")));
+  }
+
   // Handle a GET request by sending a response header and stream file content to response body
   template<typename T>
   size_t streamFile(T &file, const String& contentType) {
@@ -227,10 +642,41 @@ public:
 
   // Implement GET and HEAD requests for files.
   // Stream body on HTTP_GET but not on HTTP_HEAD requests.
+  // A valid single-range "Range: bytes=..." request is answered with 206:
+  // the file is seek()ed to the start offset and only the requested slice
+  // is streamed, so a resumed download restarts mid-file with no buffering.
+  // Ranges are only honored when no Content-Encoding applies - byte
+  // offsets would otherwise refer to the compressed representation.
   template<typename T>
   size_t streamFile(T &file, const String& contentType, HTTPMethod requestMethod) {
     size_t contentLength = 0;
-    _streamFileCore(file.size(), file.name(), contentType);
+    const size_t fileSize = file.size();
+    size_t rangeStart = 0;
+    size_t rangeLength = 0;
+    int code = 200;
+    if (!_isGzipEncoded(file.name(), contentType)) {
+      sendHeader(F("Accept-Ranges"), F("bytes"));
+      code = _parseRangeHeader(fileSize, rangeStart, rangeLength);
+    }
+    if (code == 416) {
+      sendHeader(F("Content-Range"), String(F("bytes */")) + String((unsigned long)fileSize));
+      send(416, contentType, emptyString);
+      return 0;
+    }
+    if (code == 206 && !file.seek(rangeStart)) {
+      code = 200; // cannot position this stream: fall back to the whole body
+    }
+    if (code == 206) {
+      sendHeader(F("Content-Range"), String(F("bytes ")) + String((unsigned long)rangeStart) + '-'
+          + String((unsigned long)(rangeStart + rangeLength - 1)) + '/' + String((unsigned long)fileSize));
+      setContentLength(rangeLength);
+      send(206, contentType, emptyString);
+      if (requestMethod == HTTP_GET) {
+        contentLength = file.sendSize(_currentClient, rangeLength);
+      }
+      return contentLength;
+    }
+    _streamFileCore(fileSize, file.name(), contentType);
     if (requestMethod == HTTP_GET) {
       contentLength = file.sendAll(_currentClient);
     }
@@ -266,7 +712,7 @@ public:
   void addHook (HookFunction hook) {
     if (_hook) {
       auto previousHook = _hook;
-      _hook = [previousHook, hook](const String& method, const String& url, WiFiClient* client, ContentTypeFunction contentType) {
+      _hook = [previousHook, hook](const String& method, const String& url, ClientType* client, ContentTypeFunction contentType) {
           auto whatNow = previousHook(method, url, client, contentType);
           if (whatNow == CLIENT_REQUEST_CAN_CONTINUE)
             return hook(method, url, client, contentType);
@@ -282,7 +728,10 @@ public:
 
 protected:
   void _addRequestHandler(RequestHandlerType* handler);
+  void _rebuildRouter();
   void _handleRequest();
+  struct Connection;
+  bool _serviceConnection(Connection& conn);
   void _finalizeResponse();
   ClientFuture _parseRequest(ClientType& client);
   void _parseArguments(const String& data);
@@ -290,11 +739,15 @@ protected:
   bool _parseForm(ClientType& client, const String& boundary, uint32_t len);
   bool _parseFormUploadAborted();
   void _uploadWriteByte(uint8_t b);
+  size_t _uploadWrite(const uint8_t* data, size_t len);
   int _uploadReadByte(ClientType& client);
   void _prepareHeader(String& response, int code, const char* content_type, size_t contentLength);
   bool _collectHeader(const char* headerName, const char* headerValue);
+  void _ensureCurrentArgs(int count);
 
   void _streamFileCore(const size_t fileSize, const String & fileName, const String & contentType);
+  static bool _isGzipEncoded(const String& fileName, const String& contentType);
+  int _parseRangeHeader(const size_t fileSize, size_t& rangeStart, size_t& rangeLength);
 
   static String _getRandomHexString();
   // for extracting Auth parameters
@@ -313,14 +766,34 @@ protected:
   HTTPClientStatus _currentStatus = HC_NONE;
   unsigned long _statusChange = 0;
 
+  // Keep-alive connection table.  Each slot tracks one client between
+  // handleClient() calls; while a slot is serviced it is swapped into
+  // _currentClient / _currentStatus / _statusChange so the parse and
+  // response paths keep operating on the single "current" context.
+  struct Connection {
+    ClientType client;
+    HTTPClientStatus status = HC_NONE;
+    unsigned long statusChange = 0;
+  };
+  Connection _connections[WEBSERVER_MAX_CLIENTS];
+  uint8_t _nextConnection = 0; // round-robin service start offset
+
   RequestHandlerType*  _currentHandler = nullptr;
   RequestHandlerType*  _firstHandler = nullptr;
   RequestHandlerType*  _lastHandler = nullptr;
+
+  // radix router over literal routes, rebuilt lazily before dispatch;
+  // pattern routes (braces/glob/regex, user handler subclasses) stay on
+  // the _dynamicHandlers fallback list in registration order
+  UriRouter<RequestHandlerType> _router;
+  std::vector<typename UriRouter<RequestHandlerType>::Candidate> _dynamicHandlers;
+  bool _routerDirty = true;
   THandlerFunction _notFoundHandler;
   THandlerFunction _fileUploadHandler;
 
   int              _currentArgCount = 0;
   RequestArgument* _currentArgs = nullptr;
+  int              _currentArgsCapacity = 0;
   int              _currentArgsHavePlain = 0;
   std::unique_ptr<HTTPUpload> _currentUpload;
   int              _postArgsLen = 0;
@@ -336,11 +809,42 @@ protected:
   bool             _chunked = false;
   bool             _corsEnabled = false;
   bool             _keepAlive = false;
+  bool             _clientUpgraded = false;
+  SSEChannel*      _firstSSE = nullptr;
 
   String           _snonce;  // Store noance and opaque for future comparison
   String           _sopaque;
   String           _srealm;  // Store the Auth realm between Calls
 
+  // credential digest cache (see setCredentials())
+  String           _authUser;
+  String           _authRealm;
+  String           _authPass;
+  String           _authH1;      // MD5(user:realm:pass)
+  String           _basicRaw;    // "user:pass"
+  String           _basicToken;  // base64 of _basicRaw
+
+  // ring of recently issued digest challenges, so concurrent clients can
+  // each hold an outstanding nonce without evicting one another's
+  struct DigestChallenge {
+    String nonce;
+    String opaque;
+    String realm;
+  };
+  static constexpr uint8_t MAX_DIGEST_CHALLENGES = 4;
+  DigestChallenge  _challenges[MAX_DIGEST_CHALLENGES];
+  uint8_t          _nextChallenge = 0;
+
+  // session token table (see createSession()); token[0] == 0 marks a
+  // free slot
+  struct Session {
+    char token[33] = { 0 }; // 32 hex digits + NUL
+    uint32_t expires = 0;   // millis() deadline
+  };
+  Session          _sessions[WEBSERVER_MAX_SESSIONS];
+  uint8_t          _nextSession = 0;
+  String           _sessionToken() const;
+
   HookFunction     _hook;
 };
 
@@ -20,6 +20,7 @@
 */
 
 #include <Arduino.h>
+#include <NumberFormat.h>
 #include "WiFiServer.h"
 #include "WiFiClient.h"
 #include "ESP8266WebServer.h"
@@ -64,7 +65,9 @@ typename ESP8266WebServerTemplate<ServerType>::ClientFuture ESP8266WebServerTemp
   String methodStr = req.substring(0, addr_start);
   String url = req.substring(addr_start + 1, addr_end);
   String versionEnd = req.substring(addr_end + 8);
-  _currentVersion = atoi(versionEnd.c_str());
+  int32_t version = 0;
+  numfmt_parse_i32(versionEnd.c_str(), versionEnd.c_str() + versionEnd.length(), version);
+  _currentVersion = version;
   String searchStr;
   int hasSearch = url.indexOf('?');
   if (hasSearch != -1){
@@ -104,10 +107,32 @@ typename ESP8266WebServerTemplate<ServerType>::ClientFuture ESP8266WebServerTemp
       methodStr.c_str(), url.c_str(), searchStr.c_str(), _keepAlive);
 
   //attach handler
-  RequestHandlerType* handler;
-  for (handler = _firstHandler; handler; handler = handler->next()) {
-    if (handler->canHandle(_currentMethod, _currentUri))
+  if (_routerDirty)
+    _rebuildRouter();
+  RequestHandlerType* handler = nullptr;
+  uint16_t handlerOrder = 0;
+  {
+    // literal routes: one walk down the radix tree yields the candidates
+    // for this path, already sorted by registration index
+    std::vector<typename UriRouter<RequestHandlerType>::Candidate> candidates;
+    _router.lookup(_currentUri, candidates);
+    for (const auto& c : candidates) {
+      if (c.handler->canHandle(_currentMethod, _currentUri)) {
+        handler = c.handler;
+        handlerOrder = c.order;
+        break;
+      }
+    }
+  }
+  // pattern routes are probed in registration order; one registered before
+  // the radix match still wins, preserving the linear-list semantics
+  for (const auto& d : _dynamicHandlers) {
+    if (handler && d.order > handlerOrder)
+      break;
+    if (d.handler->canHandle(_currentMethod, _currentUri)) {
+      handler = d.handler;
       break;
+    }
   }
   _currentHandler = handler;
 
@@ -143,13 +168,18 @@ typename ESP8266WebServerTemplate<ServerType>::ClientFuture ESP8266WebServerTemp
         } else if (headerValue.startsWith(F("application/x-www-form-urlencoded"))){
           isForm = false;
           isEncoded = true;
-        } else if (headerValue.startsWith(F("multipart/"))){
+        }
+#ifndef WEBSERVER_NO_MULTIPART_UPLOAD
+        else if (headerValue.startsWith(F("multipart/"))){
           boundaryStr = headerValue.substring(headerValue.indexOf('=') + 1);
           boundaryStr.replace("\"","");
           isForm = true;
         }
+#endif
       } else if (headerName.equalsIgnoreCase(F("Content-Length"))){
-        contentLength = headerValue.toInt();
+        uint32_t length = 0;
+        numfmt_parse_u32(headerValue.c_str(), headerValue.c_str() + headerValue.length(), length);
+        contentLength = length;
       } else if (headerName.equalsIgnoreCase(F("Host"))){
         _hostHeader = headerValue;
       } else if (headerName.equalsIgnoreCase(F("Connection"))){
@@ -187,12 +217,17 @@ typename ESP8266WebServerTemplate<ServerType>::ClientFuture ESP8266WebServerTemp
         arg.value = plainBuf;
         _currentArgsHavePlain = 1;
       }
-    } else { // isForm is true
+    }
+#ifndef WEBSERVER_NO_MULTIPART_UPLOAD
+    // with WEBSERVER_NO_MULTIPART_UPLOAD, isForm is never true and _parseForm()
+    // and the upload helpers are never instantiated
+    else { // isForm is true
       // here: content is not yet read (plainBuf is still empty)
       if (!_parseForm(client, boundaryStr, contentLength)) {
         return CLIENT_MUST_STOP;
       }
     }
+#endif
   } else {
     String headerName;
     String headerValue;
@@ -263,15 +298,30 @@ struct nullArgHandler
   }
 };
 
+// Make sure _currentArgs can hold at least `count` arguments.  The array
+// only ever grows and is kept across requests, so at steady state parsing
+// a request costs no array reallocation; leftover entries from the
+// previous request are cleared so their Strings are released.
 template <typename ServerType>
-void ESP8266WebServerTemplate<ServerType>::_parseArguments(const String& data) {
-  if (_currentArgs)
+void ESP8266WebServerTemplate<ServerType>::_ensureCurrentArgs(int count) {
+  if (count > _currentArgsCapacity) {
     delete[] _currentArgs;
+    _currentArgs = new RequestArgument[count];
+    _currentArgsCapacity = count;
+    return;
+  }
+  for (int i = 0; i < _currentArgsCapacity; i++) {
+    _currentArgs[i].key = String();
+    _currentArgs[i].value = String();
+  }
+}
 
+template <typename ServerType>
+void ESP8266WebServerTemplate<ServerType>::_parseArguments(const String& data) {
   _currentArgCount = _parseArgumentsPrivate(data, nullArgHandler());
 
-  // allocate one more, this is needed because {"plain": plainBuf} is always added
-  _currentArgs = new RequestArgument[_currentArgCount + 1];
+  // reserve one more, this is needed because {"plain": plainBuf} is always added
+  _ensureCurrentArgs(_currentArgCount + 1);
 
   (void)_parseArgumentsPrivate(data, storeArgHandler<ServerType>());
 }
@@ -332,6 +382,26 @@ void ESP8266WebServerTemplate<ServerType>::_uploadWriteByte(uint8_t b){
   _currentUpload->buf[_currentUpload->currentSize++] = b;
 }
 
+// block delivery into HTTPUpload::buf: a single memcpy per chunk, flushing
+// to the handler whenever the buffer fills
+template <typename ServerType>
+size_t ESP8266WebServerTemplate<ServerType>::_uploadWrite(const uint8_t* data, size_t len){
+  size_t written = 0;
+  while (written < len) {
+    if (_currentUpload->currentSize == HTTP_UPLOAD_BUFLEN){
+      if(_currentHandler && _currentHandler->canUpload(_currentUri))
+        _currentHandler->upload(*this, _currentUri, *_currentUpload);
+      _currentUpload->totalSize += _currentUpload->currentSize;
+      _currentUpload->currentSize = 0;
+    }
+    size_t chunk = std::min(len - written, (size_t)HTTP_UPLOAD_BUFLEN - _currentUpload->currentSize);
+    memcpy(_currentUpload->buf + _currentUpload->currentSize, data + written, chunk);
+    _currentUpload->currentSize += chunk;
+    written += chunk;
+  }
+  return written;
+}
+
 template <typename ServerType>
 int ESP8266WebServerTemplate<ServerType>::_uploadReadByte(ClientType& client){
   int res = client.read();
@@ -358,8 +428,10 @@ bool ESP8266WebServerTemplate<ServerType>::_parseForm(ClientType& client, const
   client.readStringUntil('\n');
   //start reading the form
   if (line == ("--"+boundary)){
-    if(_postArgs) delete[] _postArgs;
-    _postArgs = new RequestArgument[WEBSERVER_MAX_POST_ARGS];
+    // the array is kept across requests; entries are always cleared or
+    // overwritten before use, so only the first request pays for it
+    if(!_postArgs)
+      _postArgs = new RequestArgument[WEBSERVER_MAX_POST_ARGS];
     _postArgsLen = 0;
     while(1){
       String argName;
@@ -430,30 +502,82 @@ bool ESP8266WebServerTemplate<ServerType>::_parseForm(ClientType& client, const
               _currentHandler->upload(*this, _currentUri, *_currentUpload);
             _currentUpload->status = UPLOAD_FILE_WRITE;
 
-            int fastBoundaryLen = 4 /* \r\n-- */ + boundary.length() + 1 /* \0 */;
-            char fastBoundary[ fastBoundaryLen ];
-            snprintf(fastBoundary, fastBoundaryLen, "\r\n--%s", boundary.c_str());
-            int boundaryPtr = 0;
+            const int patLen = 4 /* \r\n-- */ + boundary.length();
+            char pattern[ patLen + 1 ];
+            snprintf(pattern, patLen + 1, "\r\n--%s", boundary.c_str());
+            int boundaryPtr = 0; // marker bytes matched so far on the byte-wise path
             while ( true ) {
+                if (client.hasPeekBufferAPI() && boundaryPtr == 0) {
+                    // Fast path: scan the received TCP payload in place and
+                    // consume only up to the marker, so whatever follows it
+                    // stays in the client for the next-part header reads.
+                    // The hunt is anchored on '\r' with memchr then memcmp:
+                    // at marker lengths of ~40 bytes this touches each byte
+                    // about once, like the fancier skip searches, without
+                    // their table setup.
+                    size_t avail = client.peekAvailable();
+                    if (!avail) {
+                        if (!client.connected())
+                            return _parseFormUploadAborted();
+                        yield();
+                        continue;
+                    }
+                    const char* buf = client.peekBuffer();
+                    size_t start = 0;
+                    size_t hold = avail;   // deliverable payload when no marker found
+                    int seamPtr = 0;       // marker prefix cut off at the buffer seam
+                    size_t matchPos = avail;
+                    while (start < avail) {
+                        const char* cr = (const char*) memchr(buf + start, '\r', avail - start);
+                        if (!cr)
+                            break;
+                        const size_t p = cr - buf;
+                        const size_t have = avail - p;
+                        if (have >= (size_t) patLen) {
+                            if (!memcmp(cr, pattern, patLen)) {
+                                matchPos = p;
+                                break;
+                            }
+                        } else if (!memcmp(cr, pattern, have)) {
+                            // possible marker cut off at the seam: deliver
+                            // what precedes it, resolve byte-wise below
+                            hold = p;
+                            seamPtr = have;
+                            break;
+                        }
+                        start = p + 1;
+                    }
+                    if (matchPos < avail) {
+                        _uploadWrite((const uint8_t*) buf, matchPos);
+                        client.peekConsume(matchPos + patLen);
+                        break; // We read the whole boundary line, we're done here!
+                    }
+                    _uploadWrite((const uint8_t*) buf, hold);
+                    client.peekConsume(hold + seamPtr);
+                    boundaryPtr = seamPtr;
+                    continue;
+                }
+                // Byte-wise path: clients without the peek-buffer API, and
+                // resolving a candidate marker cut at a buffer seam.
                 int ret = _uploadReadByte(client);
                 if (ret < 0) {
                     // Unexpected, we should have had data available per above
                     return _parseFormUploadAborted();
                 }
                 char in = (char) ret;
-                if (in == fastBoundary[ boundaryPtr ]) {
+                if (in == pattern[ boundaryPtr ]) {
                     // The input matched the current expected character, advance and possibly exit this file
                     boundaryPtr++;
-                    if (boundaryPtr == fastBoundaryLen - 1) {
+                    if (boundaryPtr == patLen) {
                         // We read the whole boundary line, we're done here!
                         break;
                     }
                 } else {
                     // The char doesn't match what we want, so dump whatever matches we had, the read in char, and reset ptr to start
                     for (int i = 0; i < boundaryPtr; i++) {
-                        _uploadWriteByte( fastBoundary[ i ] );
+                        _uploadWriteByte( pattern[ i ] );
                     }
-                    if (in == fastBoundary[ 0 ]) {
+                    if (in == pattern[ 0 ]) {
                        // This could be the start of the real end, mark it so and don't emit/skip it
                        boundaryPtr = 1;
                     } else {
@@ -491,22 +615,17 @@ bool ESP8266WebServerTemplate<ServerType>::_parseForm(ClientType& client, const
     int totalArgs = ((WEBSERVER_MAX_POST_ARGS - _postArgsLen) < _currentArgCount)?(WEBSERVER_MAX_POST_ARGS - _postArgsLen):_currentArgCount;
     for (iarg = 0; iarg < totalArgs; iarg++){
       RequestArgument& arg = _postArgs[_postArgsLen++];
-      arg.key = _currentArgs[iarg].key;
-      arg.value = _currentArgs[iarg].value;
+      arg.key = std::move(_currentArgs[iarg].key);
+      arg.value = std::move(_currentArgs[iarg].value);
     }
-    if (_currentArgs) delete[] _currentArgs;
-    _currentArgs = new RequestArgument[_postArgsLen];
+    _ensureCurrentArgs(_postArgsLen + 1);
     for (iarg = 0; iarg < _postArgsLen; iarg++){
       RequestArgument& arg = _currentArgs[iarg];
-      arg.key = _postArgs[iarg].key;
-      arg.value = _postArgs[iarg].value;
+      arg.key = std::move(_postArgs[iarg].key);
+      arg.value = std::move(_postArgs[iarg].value);
     }
     _currentArgCount = iarg;
-    if (_postArgs) {
-      delete[] _postArgs;
-      _postArgs = nullptr;
-      _postArgsLen = 0;
-    }
+    _postArgsLen = 0;
     return true;
   }
   DBGWS("Error: line: %s\n", line.c_str());
@@ -529,7 +648,9 @@ String ESP8266WebServerTemplate<ServerType>::urlDecode(const String& text)
       temp[2] = text.charAt(i++);
       temp[3] = text.charAt(i++);
 
-      decodedChar = strtol(temp, NULL, 16);
+      uint32_t code = 0;
+      numfmt_parse_u32(temp + 2, temp + 4, code, 16);
+      decodedChar = (char)code;
     }
     else {
       if (encodedChar == '+')
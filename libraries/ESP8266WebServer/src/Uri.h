@@ -19,6 +19,17 @@ class Uri {
             return new Uri(_uri);
         };
 
+        // true when the uri matches requests literally (no pattern
+        // syntax); literal routes can be indexed in the server's radix
+        // router instead of being probed one by one
+        virtual bool isLiteral() const {
+            return true;
+        }
+
+        const String& text() const {
+            return _uri;
+        }
+
         virtual bool canHandle(const String &requestUri, __attribute__((unused)) std::vector<String> &pathArgs) {
             return _uri == requestUri;
         }
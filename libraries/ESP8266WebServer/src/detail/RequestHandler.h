@@ -13,6 +13,15 @@ class RequestHandler {
 public:
     virtual ~RequestHandler() { }
     virtual bool canHandle(HTTPMethod method, const String& uri) { (void) method; (void) uri; return false; }
+
+    // Routing support: handlers whose URI match is a plain string compare
+    // expose it here so the server can index them in the radix router it
+    // rebuilds before dispatch.  EXACT matches only the key itself, PREFIX
+    // matches every path below it.  Handlers returning NONE (patterns,
+    // user subclasses) stay on the linear fallback list.
+    enum class RouteKind : uint8_t { NONE, EXACT, PREFIX };
+    virtual RouteKind routeKind() const { return RouteKind::NONE; }
+    virtual const String& routeKey() const { return emptyString; }
     virtual bool canUpload(const String& uri) { (void) uri; return false; }
     virtual bool handle(WebServerType& server, HTTPMethod requestMethod, const String& requestUri) { (void) server; (void) requestMethod; (void) requestUri; return false; }
     virtual void upload(WebServerType& server, const String& requestUri, HTTPUpload& upload) { (void) server; (void) requestUri; (void) upload; }
@@ -20,8 +29,43 @@ public:
     RequestHandler<ServerType>* next() { return _next; }
     void next(RequestHandler<ServerType>* r) { _next = r; }
 
+#ifdef HTTP_HANDLER_METRICS
+    // Per-handler accounting, filled in around handle() by
+    // _handleRequest() and dumped by enableMetrics().  heap* is the
+    // free-heap delta across the call (negative: the request consumed
+    // heap that was not released before returning).
+    struct Metrics {
+        uint32_t calls = 0;
+        uint32_t cyclesMin = 0;
+        uint32_t cyclesMax = 0;
+        uint64_t cyclesTotal = 0;
+        int32_t heapMin = 0;
+        int32_t heapMax = 0;
+        int64_t heapTotal = 0;
+
+        void record(uint32_t cycles, int32_t heapDelta) {
+            if (!calls || cycles < cyclesMin)
+                cyclesMin = cycles;
+            if (!calls || cycles > cyclesMax)
+                cyclesMax = cycles;
+            cyclesTotal += cycles;
+            if (!calls || heapDelta < heapMin)
+                heapMin = heapDelta;
+            if (!calls || heapDelta > heapMax)
+                heapMax = heapDelta;
+            heapTotal += heapDelta;
+            ++calls;
+        }
+    };
+
+    Metrics& metrics() { return _metrics; }
+#endif
+
 private:
     RequestHandler<ServerType>* _next = nullptr;
+#ifdef HTTP_HANDLER_METRICS
+    Metrics _metrics;
+#endif
 	
 protected:
     std::vector<String> pathArgs;
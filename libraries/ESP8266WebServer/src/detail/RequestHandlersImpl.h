@@ -11,7 +11,9 @@ namespace esp8266webserver {
 
 // calculate an ETag for a file in filesystem based on md5 checksum
 // that can be used in the http headers - include quotes.
-static String calcETag(FS &fs, const String &path) {
+// inline: only referenced from templates, so a TU that never instantiates
+// the static handlers would otherwise warn about an unused static function
+inline String calcETag(FS &fs, const String &path) {
     String result;
 
     // calculate eTag using md5 checksum
@@ -59,6 +61,17 @@ public:
         return true;
     }
 
+    // a plain Uri route is an exact string match and can be indexed;
+    // braces/glob/regex routes keep the per-request probe
+    typename RequestHandler<ServerType>::RouteKind routeKind() const override {
+        return _uri->isLiteral() ? RequestHandler<ServerType>::RouteKind::EXACT
+                                 : RequestHandler<ServerType>::RouteKind::NONE;
+    }
+
+    const String& routeKey() const override {
+        return _uri->text();
+    }
+
     bool handle(WebServerType& server, HTTPMethod requestMethod, const String& requestUri) override {
         (void) server;
         if (!canHandle(requestMethod, requestUri))
@@ -104,6 +117,15 @@ public:
         return mime::getContentType(path);
     }
 
+    // true when the client advertised gzip support in Accept-Encoding
+    static bool clientAcceptsGzip(WebServerType& server) {
+        return server.header(F("Accept-Encoding")).indexOf(F("gzip")) >= 0;
+    }
+
+    const String& routeKey() const override {
+        return _uri;
+    }
+
 protected:
     FS _fs;
     String _uri;
@@ -112,6 +134,67 @@ protected:
 };
 
 
+// Per-handler MRU cache of served static assets: resolved path, content
+// type, ETag and an open File handle kept warm for hot assets.  Lets
+// repeat requests be answered (304 or re-stream) without path resolution,
+// re-open or ETag recalculation.  Assets are assumed immutable while the
+// server runs (they are per-firmware-build); restart the server after
+// changing the filesystem.
+#ifndef STATIC_ASSET_CACHE_SIZE
+#define STATIC_ASSET_CACHE_SIZE 4
+#endif
+
+class StaticAssetCache {
+public:
+    struct Entry {
+        String uri;
+        String contentType;
+        String eTag;
+        File file;
+        bool gzipped = false;
+    };
+
+    // returns the entry for this uri, promoted to most-recently-used.
+    // A gzipped entry is only handed to clients that accept gzip; a plain
+    // entry is valid for everyone.
+    Entry* lookup(const String& uri, bool acceptsGzip) {
+        for (size_t i = 0; i < STATIC_ASSET_CACHE_SIZE; i++) {
+            if (_entries[i].uri == uri && _entries[i].uri.length()
+                    && (!_entries[i].gzipped || acceptsGzip)) {
+                promote(i);
+                return &_entries[0];
+            }
+        }
+        return nullptr;
+    }
+
+    // insert as most-recently-used, evicting the oldest entry
+    Entry* insert(const String& uri, const String& contentType, const String& eTag, File file, bool gzipped) {
+        promote(STATIC_ASSET_CACHE_SIZE - 1);
+        _entries[0].uri = uri;
+        _entries[0].contentType = contentType;
+        _entries[0].eTag = eTag;
+        _entries[0].file = file;
+        _entries[0].gzipped = gzipped;
+        return &_entries[0];
+    }
+
+    void remove(Entry* entry) {
+        entry->uri = String();
+        entry->file = File();
+    }
+
+private:
+    void promote(size_t index) {
+        while (index > 0) {
+            std::swap(_entries[index], _entries[index - 1]);
+            index--;
+        }
+    }
+
+    Entry _entries[STATIC_ASSET_CACHE_SIZE];
+};
+
 // serve all files within a given directory
 template<typename ServerType>
 class StaticDirectoryRequestHandler : public StaticRequestHandler<ServerType> {
@@ -130,6 +213,10 @@ public:
         return SRH::validMethod(requestMethod) && requestUri.startsWith(SRH::_uri);
     }
 
+    typename RequestHandler<ServerType>::RouteKind routeKind() const override {
+        return RequestHandler<ServerType>::RouteKind::PREFIX;
+    }
+
     bool handle(WebServerType& server, HTTPMethod requestMethod, const String& requestUri) override {
 
         if (!canHandle(requestMethod, requestUri))
@@ -137,6 +224,31 @@ public:
 
         DEBUGV("DirectoryRequestHandler::handle: request=%s _uri=%s\r\n", requestUri.c_str(), SRH::_uri.c_str());
 
+        const bool wantGz = SRH::clientAcceptsGzip(server);
+
+        // Asset served before? Answer from the cache without touching the
+        // filesystem: 304 straight from the cached ETag, or a re-stream
+        // from the still-open handle.
+        StaticAssetCache::Entry* cached = _assets.lookup(requestUri, wantGz);
+        if (cached) {
+            if (server._eTagEnabled && cached->eTag.length()
+                    && server.header(F("If-None-Match")) == cached->eTag) {
+                server.send(304);
+                return true;
+            }
+            File f = cached->file;
+            if (f && f.seek(0)) {
+                if (SRH::_cache_header.length() != 0)
+                    server.sendHeader("Cache-Control", SRH::_cache_header);
+                if (server._eTagEnabled && cached->eTag.length())
+                    server.sendHeader("ETag", cached->eTag);
+                server.streamFile(f, cached->contentType, requestMethod);
+                return true;
+            }
+            // stale handle, drop the entry and resolve from scratch
+            _assets.remove(cached);
+        }
+
         String path;
         String eTagCode;
         path.reserve(SRH::_path.length() + requestUri.length() + 32);
@@ -163,7 +275,9 @@ public:
         using namespace mime;
         // look for gz file, only if the original specified path is not a gz.  So part only works to send gzip via content encoding when a non compressed is asked for
         // if you point the the path to gzip you will serve the gzip as content type "application/x-gzip", not text or javascript etc...
-        if (!path.endsWith(FPSTR(mimeTable[gz].endsWith)) && !SRH::_fs.exists(path))  {
+        // Prefer the precompressed sibling whenever the client accepts gzip,
+        // and still fall back to it when only the .gz variant is on flash.
+        if (!path.endsWith(FPSTR(mimeTable[gz].endsWith)) && (wantGz || !SRH::_fs.exists(path)))  {
             String pathWithGz = path + FPSTR(mimeTable[gz].endsWith);
             if(SRH::_fs.exists(pathWithGz))
                 path += FPSTR(mimeTable[gz].endsWith);
@@ -198,6 +312,9 @@ public:
             server.sendHeader("ETag", eTagCode);
         }
 
+        // keep the resolved path, ETag and open handle warm for repeats
+        _assets.insert(requestUri, contentType, eTagCode, f, path.endsWith(FPSTR(mimeTable[gz].endsWith)));
+
         server.streamFile(f, contentType, requestMethod);
 
         return true;
@@ -205,6 +322,7 @@ public:
 
 protected:
     size_t _baseUriLength;
+    StaticAssetCache _assets;
 };
 
 
@@ -222,30 +340,46 @@ public:
         :
     StaticRequestHandler<ServerType>{fs, path, uri, cache_header}
     {
+        // Probe for a precompressed sibling once at registration instead of
+        // per request; static assets don't change while the server runs.
+        if (!SRH::_path.endsWith(FPSTR(mime::mimeTable[mime::gz].endsWith))) {
+            String pathWithGz = SRH::_path + FPSTR(mime::mimeTable[mime::gz].endsWith);
+            if (fs.exists(pathWithGz)) {
+                _gzPath = pathWithGz;
+            }
+        }
     }
 
     bool canHandle(HTTPMethod requestMethod, const String& requestUri) override  {
         return SRH::validMethod(requestMethod) && requestUri == SRH::_uri;
     }
 
+    typename RequestHandler<ServerType>::RouteKind routeKind() const override {
+        return RequestHandler<ServerType>::RouteKind::EXACT;
+    }
+
     bool handle(WebServerType& server, HTTPMethod requestMethod, const String & requestUri) override {
         if (!canHandle(requestMethod, requestUri))
             return false;
 
+        const bool useGz = _gzPath.length() && SRH::clientAcceptsGzip(server);
+        const String& path = useGz ? _gzPath : SRH::_path;
+        String& eTagCode = useGz ? _gzETagCode : _eTagCode;
+
         if (server._eTagEnabled) {
             if (server._eTagFunction) {
-                _eTagCode = (server._eTagFunction)(SRH::_fs, SRH::_path);
-            } else  if (_eTagCode.isEmpty()) {
-                _eTagCode = esp8266webserver::calcETag(SRH::_fs, SRH::_path);
+                eTagCode = (server._eTagFunction)(SRH::_fs, path);
+            } else  if (eTagCode.isEmpty()) {
+                eTagCode = esp8266webserver::calcETag(SRH::_fs, path);
             }
 
-            if (server.header("If-None-Match") == _eTagCode) {
+            if (server.header("If-None-Match") == eTagCode) {
                 server.send(304);
                 return true;
             }
         }
 
-        File f = SRH::_fs.open(SRH::_path, "r");
+        File f = SRH::_fs.open(path, "r");
 
         if (!f)
             return false;
@@ -258,16 +392,24 @@ public:
         if (SRH::_cache_header.length() != 0)
             server.sendHeader("Cache-Control", SRH::_cache_header);
 
-        if ((server._eTagEnabled) && (_eTagCode.length() > 0)) {
-            server.sendHeader("ETag", _eTagCode);
+        if ((server._eTagEnabled) && (eTagCode.length() > 0)) {
+            server.sendHeader("ETag", eTagCode);
         }
 
+        // the response depends on Accept-Encoding once a sibling exists
+        if (_gzPath.length())
+            server.sendHeader(F("Vary"), F("Accept-Encoding"));
+
+        // content type is derived from the uncompressed name; streamFile
+        // adds Content-Encoding: gzip when serving the .gz variant
         server.streamFile(f, mime::getContentType(SRH::_path), requestMethod);
         return true;
     }
 
 protected:
     String _eTagCode; // ETag code calculated for this file as used in http header include quotes.
+    String _gzPath;     // path of the precompressed sibling, empty when absent
+    String _gzETagCode; // ETag of the precompressed sibling
 };
 
 } // namespace
@@ -0,0 +1,137 @@
+#ifndef URIROUTER_H
+#define URIROUTER_H
+
+#include <WString.h>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace esp8266webserver {
+
+// Compressed radix tree over the literal route strings of registered
+// request handlers.  Dispatch walks the request path once, so looking up
+// the candidate handlers for a URI costs O(path length) regardless of how
+// many routes are registered, instead of one String compare per handler.
+//
+// Two terminal flavours are kept per node: handlers that match the key
+// exactly (on(), serveStatic() of a single file) and handlers that match
+// every path below it (serveStatic() of a directory).  Each candidate
+// carries its registration index so the server can preserve the
+// first-registered-wins semantics of the linear handler list.
+
+template<typename HandlerT>
+class UriRouter {
+public:
+    struct Candidate {
+        HandlerT* handler;
+        uint16_t order; // registration index of this handler
+    };
+
+    void clear() {
+        _root.reset();
+    }
+
+    void addExact(const String& key, HandlerT* handler, uint16_t order) {
+        _insert(key, handler, order, false);
+    }
+
+    void addPrefix(const String& key, HandlerT* handler, uint16_t order) {
+        _insert(key, handler, order, true);
+    }
+
+    // Append every handler whose route covers this path - exact matches
+    // and all prefix routes passed on the way down - sorted by
+    // registration index.  The caller still confirms with canHandle(),
+    // which also applies the method check and fills path arguments.
+    void lookup(const String& path, std::vector<Candidate>& out) const {
+        const Node* node = _root.get();
+        size_t pos = 0;
+        while (node) {
+            for (const Candidate& c : node->prefix)
+                out.push_back(c);
+            if (pos == path.length()) {
+                for (const Candidate& c : node->exact)
+                    out.push_back(c);
+                break;
+            }
+            // radix invariant: children differ in their first edge byte,
+            // so at most one child can continue the walk
+            const Node* next = nullptr;
+            for (const auto& child : node->children) {
+                const String& edge = child->edge;
+                if (path[pos] == edge[0]) {
+                    if (path.length() - pos >= edge.length()
+                            && !memcmp(path.c_str() + pos, edge.c_str(), edge.length())) {
+                        pos += edge.length();
+                        next = child.get();
+                    }
+                    break;
+                }
+            }
+            node = next;
+        }
+        std::sort(out.begin(), out.end(), [](const Candidate& a, const Candidate& b) {
+            return a.order < b.order;
+        });
+    }
+
+private:
+    struct Node {
+        String edge; // compressed label leading from the parent to here
+        std::vector<std::unique_ptr<Node>> children;
+        std::vector<Candidate> exact;  // handlers matching exactly this key
+        std::vector<Candidate> prefix; // handlers matching everything below
+    };
+
+    void _insert(const String& key, HandlerT* handler, uint16_t order, bool isPrefix) {
+        if (!_root)
+            _root.reset(new Node());
+        Node* node = _root.get();
+        size_t pos = 0;
+        while (pos < key.length()) {
+            Node* child = nullptr;
+            for (const auto& c : node->children) {
+                if (c->edge[0] == key[pos]) {
+                    child = c.get();
+                    break;
+                }
+            }
+            if (!child) {
+                // no child shares the first byte: hang the remainder here
+                node->children.emplace_back(new Node());
+                node = node->children.back().get();
+                node->edge = key.substring(pos);
+                break;
+            }
+            const String edge = child->edge;
+            size_t i = 0;
+            while (i < edge.length() && pos + i < key.length() && edge[i] == key[pos + i])
+                i++;
+            if (i == edge.length()) {
+                // the whole edge matches, continue below it
+                pos += i;
+                node = child;
+                continue;
+            }
+            // diverges inside the edge: split it, pushing the old node
+            // contents down into a tail child
+            std::unique_ptr<Node> tail(new Node());
+            tail->edge = edge.substring(i);
+            tail->children.swap(child->children);
+            tail->exact.swap(child->exact);
+            tail->prefix.swap(child->prefix);
+            child->edge = edge.substring(0, i);
+            child->children.emplace_back(std::move(tail));
+            pos += i;
+            node = child;
+        }
+        auto& terminal = isPrefix ? node->prefix : node->exact;
+        terminal.push_back({ handler, order });
+    }
+
+    std::unique_ptr<Node> _root;
+};
+
+} // namespace
+
+#endif // URIROUTER_H
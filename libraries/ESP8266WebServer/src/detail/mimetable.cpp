@@ -89,9 +89,17 @@ const Entry mimeTable[maxType] PROGMEM =
 };
 
     String getContentType(const String& path) {
-        for (size_t i = 0; i < maxType; i++) {
-            if (path.endsWith(FPSTR(mimeTable[i].endsWith))) {
-                return String(FPSTR(mimeTable[i].mimeType));
+        // Extract the extension (last dot onwards) once and compare it with
+        // strcmp_P, instead of running String::endsWith against the whole
+        // path for every entry - endsWith had to copy each PROGMEM suffix
+        // into a temporary String first.
+        int lastDot = path.lastIndexOf('.');
+        if (lastDot >= 0) {
+            const char* ext = path.c_str() + lastDot;
+            for (size_t i = 0; i < none; i++) {
+                if (strcmp_P(ext, mimeTable[i].endsWith) == 0) {
+                    return String(FPSTR(mimeTable[i].mimeType));
+                }
             }
         }
         // Fall-through and just return default type
@@ -9,6 +9,10 @@ class UriBraces : public Uri {
         explicit UriBraces(const char *uri) : Uri(uri) {};
         explicit UriBraces(const String &uri) : Uri(uri) {};
 
+        bool isLiteral() const override final {
+            return false;
+        }
+
         Uri* clone() const override final {
             return new UriBraces(_uri);
         };
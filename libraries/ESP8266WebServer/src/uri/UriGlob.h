@@ -10,6 +10,10 @@ class UriGlob : public Uri {
         explicit UriGlob(const char *uri) : Uri(uri) {};
         explicit UriGlob(const String &uri) : Uri(uri) {};
 
+        bool isLiteral() const override final {
+            return false;
+        }
+
         Uri* clone() const override final {
             return new UriGlob(_uri);
         };
@@ -24,6 +24,10 @@ class UriRegex : public Uri {
             regfree(&_regexCompiled);
         }
 
+        bool isLiteral() const override final {
+            return false;
+        }
+
         Uri* clone() const override final {
             return new UriRegex(_uri);
         };
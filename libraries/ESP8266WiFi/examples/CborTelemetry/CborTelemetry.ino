@@ -0,0 +1,81 @@
+/*
+  CborTelemetry.ino
+
+  Batches sensor samples into a single CBOR datagram and sends it over UDP.
+  CBOR (RFC 8949) is the binary sibling of JSON: the CborWriter streams the
+  encoding straight into the UDP packet buffer, so no String assembly, no
+  quoting/escaping, and payloads are typically half the size of JSON.
+
+  A matching collector can decode with any CBOR library, e.g. in Python:
+      import cbor2, socket
+      s = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+      s.bind(("", 4739))
+      while True:
+          print(cbor2.loads(s.recv(1500)))
+
+  This example code is in the public domain.
+*/
+
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include <Cbor.h>
+
+#ifndef STASSID
+#define STASSID "your-ssid"
+#define STAPSK "your-password"
+#endif
+
+const char* ssid = STASSID;
+const char* pass = STAPSK;
+
+IPAddress collector(192, 168, 1, 2);
+const uint16_t collectorPort = 4739;
+
+WiFiUDP udp;
+
+// samples gathered between sends
+constexpr size_t batchSize = 10;
+float samples[batchSize];
+size_t sampleCount = 0;
+unsigned long lastSampleMs = 0;
+
+void setup() {
+  Serial.begin(115200);
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(ssid, pass);
+  while (WiFi.status() != WL_CONNECTED) {
+    delay(500);
+    Serial.print('.');
+  }
+  Serial.printf("\nConnected, IP %s\n", WiFi.localIP().toString().c_str());
+}
+
+void sendBatch() {
+  udp.beginPacket(collector, collectorPort);
+
+  // one map per datagram; the writer encodes straight into the packet
+  CborWriter cbor(udp);
+  cbor.beginMap(4)
+    .property(F("dev"), WiFi.hostname())
+    .property(F("up"), millis() / 1000)
+    .property(F("heap"), ESP.getFreeHeap())
+    .key(F("adc"))
+    .beginArray(sampleCount);
+  for (size_t i = 0; i < sampleCount; i++) {
+    cbor.value(samples[i]);
+  }
+
+  udp.endPacket();
+  Serial.printf("sent %u samples\n", (unsigned)sampleCount);
+  sampleCount = 0;
+}
+
+void loop() {
+  if (millis() - lastSampleMs >= 1000) {
+    lastSampleMs = millis();
+    samples[sampleCount++] = analogRead(A0) / 1024.0f;
+    if (sampleCount == batchSize) {
+      sendBatch();
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/*
+    Connection stage benchmark
+
+    Times every stage of a plain and a TLS request - DNS lookup,
+    TCP connect, TLS handshake, time to first byte - using the
+    cycle-count instrumentation points compiled into WiFiClient and
+    WiFiClientSecure, exposed through WiFi.connStats().
+
+    This example is in public domain.
+*/
+
+#include <ESP8266WiFi.h>
+#include <WiFiClientSecure.h>
+
+#ifndef STASSID
+#define STASSID "your-ssid"
+#define STAPSK "your-password"
+#endif
+
+const char* ssid = STASSID;
+const char* password = STAPSK;
+
+const char* host = "www.example.com";
+
+static void printStats(const char* what) {
+  const WiFiConnStats& stats = WiFi.connStats();
+  const uint32_t mhz = ESP.getCpuFreqMHz();
+  Serial.printf("%s:\n", what);
+  Serial.printf("  DNS:           %7u us\n", stats.dnsCycles / mhz);
+  Serial.printf("  TCP connect:   %7u us\n", stats.connectCycles / mhz);
+  Serial.printf("  TLS handshake: %7u us\n", stats.tlsHandshakeCycles / mhz);
+  Serial.printf("  first byte:    %7u us\n", stats.firstByteCycles / mhz);
+}
+
+static void request(WiFiClient& client, uint16_t port) {
+  if (!client.connect(host, port)) {
+    Serial.println("connection failed");
+    return;
+  }
+
+  client.print(String("GET / HTTP/1.1\r\nHost: ") + host + "\r\nConnection: close\r\n\r\n");
+
+  // wait for (and consume) the reply so the first-byte stage is stamped
+  uint32_t start = millis();
+  while (client.connected() && millis() - start < 10000) {
+    while (client.available()) {
+      client.read();
+    }
+    delay(10);
+  }
+  client.stop();
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println();
+  Serial.print("Connecting to ");
+  Serial.println(ssid);
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(ssid, password);
+  while (WiFi.status() != WL_CONNECTED) {
+    delay(500);
+    Serial.print(".");
+  }
+  Serial.println();
+  Serial.println("WiFi connected");
+
+  {
+    WiFiClient client;
+    request(client, 80);
+    printStats("HTTP");
+  }
+
+  {
+    WiFiClientSecure client;
+    client.setInsecure();  // benchmark only - validate in production
+    request(client, 443);
+    printStats("HTTPS");
+  }
+}
+
+void loop() {
+}
@@ -22,6 +22,7 @@
 #define arduinowifiserver_h
 
 #include <ESP8266WiFi.h>
+#include <type_traits>
 
 #ifndef MAX_MONITORED_CLIENTS
 #define MAX_MONITORED_CLIENTS 5
@@ -77,11 +78,24 @@ public:
       }
       if (a == 0)
         break;
+      // Build the chunk once and let every subscriber queue the same bytes
+      // through the reference-counted no-copy path; clients that can't take
+      // it (and TLS clients, which must encrypt per connection) fall back
+      // to the copying write.  Only worth the bookkeeping for real payloads.
+      SharedSendBuffer* shared = nullptr;
+      if (std::is_same<TClient, WiFiClient>::value && a >= 64) {
+        shared = SharedSendBuffer::create(buf, a);
+      }
       for (uint8_t i = 0; i < MAX_MONITORED_CLIENTS; i++) {
         if (connectedClients[i].status() == ESTABLISHED) {
-          connectedClients[i].write(buf, a);
+          if (!shared || !connectedClients[i].writeShared(shared)) {
+            connectedClients[i].write(buf, a);
+          }
         }
       }
+      if (shared) {
+        shared->release();
+      }
       ret += a;
       if (ret == size)
         break;
@@ -971,6 +971,40 @@ bool SigningVerifier::verify(UpdaterHashClass *hash, const void *signature, uint
 #endif
 }
 
+// TLS session persistence over deep sleep.  The session parameters (about
+// 90 bytes) are stored in RTC user memory with a magic word and CRC32, so a
+// reboot from deepSleep() can resume the previous TLS session (~200 ms)
+// instead of running a full handshake (1-3 s).
+
+struct SessionRTCBlob {
+  uint32_t magic;
+  uint32_t crc;
+  br_ssl_session_parameters params;
+};
+
+static constexpr uint32_t SESSION_RTC_MAGIC = 0x53534c53; // "SSLS"
+
+bool Session::saveToRTC(uint32_t rtcOffset) const {
+  SessionRTCBlob blob;
+  blob.magic = SESSION_RTC_MAGIC;
+  memcpy(&blob.params, &_session, sizeof(blob.params));
+  blob.crc = crc32(&blob.params, sizeof(blob.params));
+  return ESP.rtcUserMemoryWrite(rtcOffset, (uint32_t *)&blob, sizeof(blob));
+}
+
+bool Session::restoreFromRTC(uint32_t rtcOffset) {
+  SessionRTCBlob blob;
+  if (!ESP.rtcUserMemoryRead(rtcOffset, (uint32_t *)&blob, sizeof(blob))) {
+    return false;
+  }
+  if (blob.magic != SESSION_RTC_MAGIC
+      || blob.crc != crc32(&blob.params, sizeof(blob.params))) {
+    return false;
+  }
+  memcpy(&_session, &blob.params, sizeof(_session));
+  return true;
+}
+
 #if !CORE_MOCK
 
 // Second stack thunked helpers
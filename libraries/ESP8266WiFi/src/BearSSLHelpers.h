@@ -144,6 +144,16 @@ class Session {
 
   public:
     Session() { memset(&_session, 0, sizeof(_session)); }
+
+    // Persist/restore the session parameters across deep sleep via RTC user
+    // memory, guarded by a magic word and CRC32.  A session restored after
+    // wake lets the next handshake resume instead of doing a full
+    // key exchange.  `rtcOffset` is in 4-byte words within the 512-byte RTC
+    // user area; the session occupies rtcSize() bytes from there.
+    bool saveToRTC(uint32_t rtcOffset = 0) const;
+    bool restoreFromRTC(uint32_t rtcOffset = 0);
+    static constexpr size_t rtcSize() { return 8 + sizeof(br_ssl_session_parameters); }
+
   private:
     br_ssl_session_parameters *getSession() { return &_session; }
     // The actual BearSSL session information
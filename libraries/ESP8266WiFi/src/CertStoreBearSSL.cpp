@@ -78,7 +78,12 @@ CertStore::CertInfo CertStore::_preprocessCert(uint32_t length, uint32_t offset,
   return ci;
 }
 
-// The certs.ar file is a UNIX ar format file, concatenating all the 
+// qsort comparator ordering index entries by subject hash
+static int certInfoCompare(const void *a, const void *b) {
+  return memcmp(a, b, 32); // sha256 is the first member of CertInfo
+}
+
+// The certs.ar file is a UNIX ar format file, concatenating all the
 // individual certificates into a single blob in a space-efficient way.
 int CertStore::initCertStore(fs::FS &fs, const char *indexFileName, const char *dataFileName) {
   int count = 0;
@@ -121,6 +126,15 @@ int CertStore::initCertStore(fs::FS &fs, const char *indexFileName, const char *
   }
   offset += sizeof(magic);
 
+  // Accumulate the index in RAM so it can be sorted by subject hash before
+  // being written out; a sorted index turns the per-handshake issuer lookup
+  // into a binary search instead of a linear scan.  When RAM runs out the
+  // remaining entries are streamed out unsorted and lookup falls back to
+  // the linear scan.
+  CertInfo *infos = nullptr;
+  uint32_t inRam = 0;
+  bool sorted = true;
+
   while (true) {
     uint8_t fileHeader[60];
     // 0..15 = filename in ASCII
@@ -147,7 +161,28 @@ int CertStore::initCertStore(fs::FS &fs, const char *indexFileName, const char *
     // If the filename starts with "//" then this is a rename file, skip it
     if (fileHeader[0] != '/' || fileHeader[1] != '/') {
       CertStore::CertInfo ci = _preprocessCert(length, offset, raw);
-      if (index.write((uint8_t *)&ci, sizeof(ci)) != (ssize_t)sizeof(ci)) {
+      if (sorted && (inRam % 16 == 0)) {
+        CertInfo *grown = (CertInfo *)realloc(infos, (inRam + 16) * sizeof(CertInfo));
+        if (grown) {
+          infos = grown;
+        } else {
+          // Not enough RAM to sort the index; flush what we have so far
+          // and stream the rest out unsorted
+          DEBUG_BSSL("CertStore::initCertStore: OOM sorting index, using linear lookup\n");
+          sorted = false;
+          if (infos && index.write((uint8_t *)infos, inRam * sizeof(CertInfo)) != (ssize_t)(inRam * sizeof(CertInfo))) {
+            free(infos);
+            free(raw);
+            infos = nullptr;
+            break;
+          }
+          free(infos);
+          infos = nullptr;
+        }
+      }
+      if (sorted) {
+        infos[inRam++] = ci;
+      } else if (index.write((uint8_t *)&ci, sizeof(ci)) != (ssize_t)sizeof(ci)) {
         free(raw);
         break;
       }
@@ -163,7 +198,16 @@ int CertStore::initCertStore(fs::FS &fs, const char *indexFileName, const char *
     }
   }
   data.close();
+  if (infos) {
+    qsort(infos, inRam, sizeof(CertInfo), certInfoCompare);
+    if (index.write((uint8_t *)infos, inRam * sizeof(CertInfo)) != (ssize_t)(inRam * sizeof(CertInfo))) {
+      count = 0;
+    }
+    free(infos);
+  }
   index.close();
+  _count = count;
+  _sorted = sorted && (count > 0);
   return count;
 }
 
@@ -184,44 +228,72 @@ const br_x509_trust_anchor *CertStore::findHashedTA(void *ctx, void *hashed_dn,
     return nullptr;
   }
 
-  while (index.read((uint8_t *)&ci, sizeof(ci)) == sizeof(ci)) {
-    if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256))) {
-      index.close();
-      uint8_t *der = (uint8_t*)malloc(ci.length);
-      if (!der) {
-        return nullptr;
-      }
-      fs::File data = cs->_fs->open(cs->_dataName, "r");
-      if (!data) {
-        free(der);
-        return nullptr;
-      }
-      if (!data.seek(ci.offset, fs::SeekSet)) {
-        data.close();
-        free(der);
-        return nullptr;
+  bool found = false;
+  if (cs->_sorted) {
+    // Binary search over the fixed-size records sorted by subject hash
+    uint32_t lo = 0;
+    uint32_t hi = cs->_count;
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      if (!index.seek(mid * sizeof(ci), fs::SeekSet) ||
+          index.read((uint8_t *)&ci, sizeof(ci)) != sizeof(ci)) {
+        break;
       }
-      if (data.read(der, ci.length) != (int)ci.length) {
-        free(der);
-        return nullptr;
+      const int cmp = memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256));
+      if (cmp == 0) {
+        found = true;
+        break;
+      } else if (cmp < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
       }
-      data.close();
-      cs->_x509 = new (std::nothrow) X509List(der, ci.length);
-      free(der);
-      if (!cs->_x509) {
-        DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
-        return nullptr;
+    }
+  } else {
+    // Index couldn't be sorted at init time, scan it linearly
+    while (index.read((uint8_t *)&ci, sizeof(ci)) == sizeof(ci)) {
+      if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256))) {
+        found = true;
+        break;
       }
-
-      br_x509_trust_anchor *ta = (br_x509_trust_anchor*)cs->_x509->getTrustAnchors();
-      memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
-      ta->dn.len = sizeof(ci.sha256);
-
-      return ta;
     }
   }
   index.close();
-  return nullptr;
+  if (!found) {
+    return nullptr;
+  }
+
+  uint8_t *der = (uint8_t*)malloc(ci.length);
+  if (!der) {
+    return nullptr;
+  }
+  fs::File data = cs->_fs->open(cs->_dataName, "r");
+  if (!data) {
+    free(der);
+    return nullptr;
+  }
+  if (!data.seek(ci.offset, fs::SeekSet)) {
+    data.close();
+    free(der);
+    return nullptr;
+  }
+  if (data.read(der, ci.length) != (int)ci.length) {
+    free(der);
+    return nullptr;
+  }
+  data.close();
+  cs->_x509 = new (std::nothrow) X509List(der, ci.length);
+  free(der);
+  if (!cs->_x509) {
+    DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
+    return nullptr;
+  }
+
+  br_x509_trust_anchor *ta = (br_x509_trust_anchor*)cs->_x509->getTrustAnchors();
+  memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
+  ta->dn.len = sizeof(ci.sha256);
+
+  return ta;
 }
 
 void CertStore::freeHashedTA(void *ctx, const br_x509_trust_anchor *ta) {
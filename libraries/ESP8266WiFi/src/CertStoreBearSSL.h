@@ -55,6 +55,8 @@ class CertStore: public CertStoreBase {
     char *_indexName = nullptr;
     char *_dataName = nullptr;
     X509List *_x509 = nullptr;
+    uint32_t _count = 0;   // Entries in the index file
+    bool _sorted = false;  // Index sorted by subject hash, enables binary search
 
     // These need to be static as they are callbacks from BearSSL C code
     static const br_x509_trust_anchor *findHashedTA(void *ctx, void *hashed_dn, size_t len);
@@ -26,6 +26,9 @@
 #include <list>
 #include <memory>
 #include <type_traits>
+#include <vector>
+
+#include <Schedule.h>
 
 #include <coredecls.h>
 #include <PolledTimeout.h>
@@ -228,6 +231,13 @@ void ESP8266WiFiGenericClass::_eventCallback(void* arg)
     System_Event_t* event = reinterpret_cast<System_Event_t*>(arg);
     DEBUG_WIFI("wifi evt: %d\n", event->event);
 
+    if (event->event == EVENT_STAMODE_CONNECTED && ESP8266WiFiSTAClass::getFastReconnect()) {
+        // remember the AP for a directed association on the next boot
+        auto& src = event->event_info.connected;
+        ESP8266WiFiSTAClass::_fastReconnectStore(src.bssid, src.channel);
+        ESP8266WiFiSTAClass::_fastReconnectDirected = false;
+    }
+
     if (event->event == EVENT_STAMODE_DISCONNECTED) {
         DEBUG_WIFI("STA disconnect: %d\n", event->event_info.disconnected.reason);
         // workaround for https://github.com/esp8266/Arduino/issues/7432
@@ -236,6 +246,8 @@ void ESP8266WiFiGenericClass::_eventCallback(void* arg)
             DEBUG_WIFI("forcibly stopping the station connection manager\n");
             wifi_station_disconnect();
         }
+        // directed fast-reconnect attempt failed: fall back to a full scan
+        ESP8266WiFiSTAClass::_fastReconnectFallback();
     }
 
     if (event->event == EVENT_STAMODE_AUTHMODE_CHANGE) {
@@ -604,6 +616,84 @@ struct _dns_found_result {
     bool done;
 };
 
+// Small resolver result cache in front of lwIP's dns table: repeated
+// lookups of the same hostname (periodic telemetry posts etc.) answer
+// immediately instead of blocking on the resolver. The lwIP callback
+// does not surface the record TTL, so entries live for a configurable
+// time; negative answers are cached too, with their own shorter TTL.
+struct _dns_cache_entry {
+    String host;
+    IPAddress addr;
+    uint32_t expires_ms;
+    bool negative;
+};
+
+std::vector<_dns_cache_entry> _dns_cache;
+size_t _dns_cache_max_entries = 4;
+uint32_t _dns_cache_ttl_ms = 60 * 1000;
+uint32_t _dns_cache_negative_ttl_ms = 5 * 1000;
+
+bool _dns_cache_lookup(const char* host, IPAddress& addr, bool& negative)
+{
+    const uint32_t now = millis();
+    for (auto it = _dns_cache.begin(); it != _dns_cache.end();) {
+        if ((int32_t)(it->expires_ms - now) <= 0) {
+            it = _dns_cache.erase(it);
+            continue;
+        }
+        if (it->host.equalsIgnoreCase(host)) {
+            addr = it->addr;
+            negative = it->negative;
+            return true;
+        }
+        ++it;
+    }
+    return false;
+}
+
+void _dns_cache_insert(const char* host, const IPAddress& addr, bool negative)
+{
+    if (!_dns_cache_max_entries) {
+        return;
+    }
+    for (auto it = _dns_cache.begin(); it != _dns_cache.end(); ++it) {
+        if (it->host.equalsIgnoreCase(host)) {
+            _dns_cache.erase(it);
+            break;
+        }
+    }
+    while (_dns_cache.size() >= _dns_cache_max_entries) {
+        _dns_cache.erase(_dns_cache.begin());
+    }
+    const uint32_t ttl = negative ? _dns_cache_negative_ttl_ms : _dns_cache_ttl_ms;
+    _dns_cache.push_back({ host, addr, millis() + ttl, negative });
+}
+
+}
+
+void ESP8266WiFiGenericClass::setDnsCacheSize(size_t entries)
+{
+    _dns_cache_max_entries = entries;
+    while (_dns_cache.size() > _dns_cache_max_entries) {
+        _dns_cache.erase(_dns_cache.begin());
+    }
+}
+
+void ESP8266WiFiGenericClass::setDnsCacheTtl(uint32_t ttlMs, uint32_t negativeTtlMs)
+{
+    _dns_cache_ttl_ms = ttlMs;
+    _dns_cache_negative_ttl_ms = negativeTtlMs;
+}
+
+void ESP8266WiFiGenericClass::clearDnsCache()
+{
+    _dns_cache.clear();
+}
+
+WiFiConnStats& ESP8266WiFiGenericClass::connStats()
+{
+    static WiFiConnStats stats;
+    return stats;
 }
 
 static void _dns_found_callback(const char *, const ip_addr_t *, void *);
@@ -614,6 +704,19 @@ static int hostByNameImpl(const char* aHostname, IPAddress& aResult, uint32_t ti
         return 1;
     }
 
+    {
+        IPAddress cached;
+        bool negative = false;
+        if (_dns_cache_lookup(aHostname, cached, negative)) {
+            DEBUG_WIFI_GENERIC("[hostByName] Host: %s cached %s\n", aHostname, negative ? "(negative)" : "hit");
+            if (negative) {
+                return 0;
+            }
+            aResult = cached;
+            return 1;
+        }
+    }
+
     static_assert(std::is_same_v<uint8_t, std::underlying_type_t<decltype(resolveType)>>, "");
     DEBUG_WIFI_GENERIC("[hostByName] request IP for: %s\n", aHostname);
 
@@ -648,6 +751,9 @@ static int hostByNameImpl(const char* aHostname, IPAddress& aResult, uint32_t ti
             if ((pending->addr).isSet()) {
                 aResult = pending->addr;
                 err = ERR_OK;
+            } else {
+                // definitive negative answer from the resolver
+                _dns_cache_insert(aHostname, IPAddress(), true);
             }
         } else {
             pending->done = true;
@@ -659,6 +765,7 @@ static int hostByNameImpl(const char* aHostname, IPAddress& aResult, uint32_t ti
     }
 
     if (err == ERR_OK) {
+        _dns_cache_insert(aHostname, aResult, false);
         DEBUG_WIFI_GENERIC("[hostByName] Host: %s IP: %s\n", aHostname, aResult.toString().c_str());
         return 1;
     }
@@ -696,16 +803,103 @@ int ESP8266WiFiGenericClass::hostByName(const char* aHostname, IPAddress& aResul
 }
 #endif
 
+namespace {
+
+struct _dns_async_request {
+    String host;
+    ESP8266WiFiGenericClass::HostByNameCallback cb;
+};
+
+}
+
+static void _dns_async_found_callback(const char*, const ip_addr_t* ipaddr, void* arg)
+{
+    std::shared_ptr<_dns_async_request> req(reinterpret_cast<_dns_async_request*>(arg));
+    IPAddress addr;
+    bool found = false;
+    if (ipaddr) {
+        addr = IPAddress(ipaddr);
+        found = true;
+    }
+    _dns_cache_insert(req->host.c_str(), addr, !found);
+    // the resolver callback runs in the lwIP context, hand the
+    // completion over to loop context
+    schedule_function([req, addr, found]() {
+        req->cb(req->host.c_str(), addr, found);
+    });
+}
+
+/**
+ * Resolve the given hostname without blocking the caller.
+ * The callback fires from the scheduled-function queue once the cache
+ * or the resolver answers.
+ * @param aHostname     Name to be resolved
+ * @param cb            Completion callback
+ * @return true if the request was accepted and cb will be invoked
+ */
+bool ESP8266WiFiGenericClass::hostByNameAsync(const char* aHostname, HostByNameCallback cb)
+{
+    if (!cb) {
+        return false;
+    }
+
+    IPAddress addr;
+    if (addr.fromString(aHostname)) {
+        schedule_function([cb, addr, host = String(aHostname)]() { cb(host.c_str(), addr, true); });
+        return true;
+    }
+
+    bool negative = false;
+    if (_dns_cache_lookup(aHostname, addr, negative)) {
+        schedule_function([cb, addr, negative, host = String(aHostname)]() { cb(host.c_str(), addr, !negative); });
+        return true;
+    }
+
+    auto req = new (std::nothrow) _dns_async_request{ aHostname, std::move(cb) };
+    if (!req) {
+        return false;
+    }
+
+    ip_addr_t resolved;
+    err_t err = dns_gethostbyname_addrtype(aHostname,
+        &resolved, &_dns_async_found_callback, req,
+        static_cast<uint8_t>(DNSResolveTypeDefault));
+
+    switch (err) {
+    // Address already known to lwIP
+    case ERR_OK: {
+        std::shared_ptr<_dns_async_request> owned(req);
+        addr = resolved;
+        _dns_cache_insert(aHostname, addr, false);
+        schedule_function([owned, addr]() { owned->cb(owned->host.c_str(), addr, true); });
+        return true;
+    }
+
+    // _dns_async_found_callback takes ownership of req
+    case ERR_INPROGRESS:
+        return true;
+
+    default:
+        delete req;
+        return false;
+    }
+}
+
 /**
  * DNS callback
  * @param name
  * @param ipaddr
  * @param callback_arg
  */
-static void _dns_found_callback(const char*, const ip_addr_t* ipaddr, void* arg)
+static void _dns_found_callback(const char* name, const ip_addr_t* ipaddr, void* arg)
 {
     auto result = reinterpret_cast<_dns_found_result*>(arg);
     if (result->done) {
+        // the requester already timed out and left; still worth caching
+        // a late positive answer for the next call
+        if (ipaddr && name) {
+            _dns_cache_insert(name, IPAddress(ipaddr), false);
+        }
         delete result;
         return;
     }
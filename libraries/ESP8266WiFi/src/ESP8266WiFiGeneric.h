@@ -41,6 +41,21 @@
 #define DEBUG_WIFI_GENERIC(...) do { (void)0; } while (0)
 #endif
 
+// Cycle-count instrumentation of the most recent client connection,
+// split by stage (see WiFi.connStats()). Cleared by a hostname connect;
+// an IP connect clears everything but the DNS stage. Convert to time
+// with ESP.getCpuFreqMHz().
+struct WiFiConnStats
+{
+    uint32_t dnsCycles = 0;          // hostname resolution
+    uint32_t connectCycles = 0;      // TCP connect
+    uint32_t tlsHandshakeCycles = 0; // TLS handshake (secure clients only)
+    uint32_t firstByteCycles = 0;    // connect (or handshake) completion to first byte read
+    // internal bookkeeping for the first-byte measurement
+    uint32_t _connectDoneAt = 0;
+    bool _firstBytePending = false;
+};
+
 struct WiFiEventHandlerOpaque;
 typedef std::shared_ptr<WiFiEventHandlerOpaque> WiFiEventHandler;
 
@@ -166,6 +181,27 @@ class ESP8266WiFiGenericClass {
 #if LWIP_IPV4 && LWIP_IPV6
         int hostByName(const char* aHostname, IPAddress& aResult, uint32_t timeout_ms, DNSResolveType resolveType);
 #endif
+
+        // Completion callback for hostByNameAsync(), invoked from the
+        // scheduled-function queue (i.e. loop context), with found=false
+        // on a negative answer or resolver error
+        using HostByNameCallback = std::function<void(const char* hostname, const IPAddress& addr, bool found)>;
+        // Resolve without blocking: returns true when the request was
+        // accepted (or answered from the cache) and the callback will fire
+        bool hostByNameAsync(const char* aHostname, HostByNameCallback cb);
+
+        // In-core DNS result cache shared by hostByName()/hostByNameAsync().
+        // The lwIP resolver does not surface per-record TTLs, so entries
+        // live for a configurable time instead (negative answers are
+        // cached separately and briefly). entries = 0 disables the cache.
+        static void setDnsCacheSize(size_t entries);
+        static void setDnsCacheTtl(uint32_t ttlMs, uint32_t negativeTtlMs);
+        static void clearDnsCache();
+
+        // Per-stage timings of the most recent WiFiClient /
+        // WiFiClientSecure connection, for benchmarking
+        static WiFiConnStats& connStats();
+
         bool getPersistent();
 
     protected:
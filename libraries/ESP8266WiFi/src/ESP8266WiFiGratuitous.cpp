@@ -24,13 +24,25 @@ extern "C"
 
 #include <Schedule.h>
 
+#include "ESP8266WiFi.h"
 #include "ESP8266WiFiGratuitous.h"
 
 namespace experimental
 {
 
+// quiet periods at the same cadence before trying a longer one
+static constexpr uint8_t quietPeriodsBeforeGrow = 3;
+
 ETSTimer* ESP8266WiFiGratuitous::_timer = nullptr;
 
+bool ESP8266WiFiGratuitous::_adaptive = false;
+uint32_t ESP8266WiFiGratuitous::_minMs = 0;
+uint32_t ESP8266WiFiGratuitous::_maxMs = 0;
+uint32_t ESP8266WiFiGratuitous::_currentMs = 0;
+uint32_t ESP8266WiFiGratuitous::_unsafeMs = 0;
+uint8_t ESP8266WiFiGratuitous::_quietPeriods = 0;
+WiFiEventHandler ESP8266WiFiGratuitous::_disconnectHandler;
+
 void ESP8266WiFiGratuitous::stationKeepAliveNow ()
 {
     for (netif* interface = netif_list; interface != nullptr; interface = interface->next)
@@ -50,12 +62,18 @@ void ESP8266WiFiGratuitous::scheduleItForNextYieldOnce (void*)
     schedule_recurrent_function_us([]()
     {
         ESP8266WiFiGratuitous::stationKeepAliveNow();
+        if (ESP8266WiFiGratuitous::_adaptive)
+            ESP8266WiFiGratuitous::adaptivePeriodElapsed();
         return false;
     }, 0);
 }
 
 bool ESP8266WiFiGratuitous::stationKeepAliveSetIntervalMs (uint32_t ms)
 {
+    // a fixed interval (or stop) ends any running adaptive cadence
+    _adaptive = false;
+    _disconnectHandler = nullptr;
+
     if (_timer)
     {
         os_timer_disarm(_timer);
@@ -79,4 +97,76 @@ bool ESP8266WiFiGratuitous::stationKeepAliveSetIntervalMs (uint32_t ms)
     return true;
 }
 
+bool ESP8266WiFiGratuitous::stationKeepAliveAdaptive (uint32_t minMs, uint32_t maxMs)
+{
+    if (!minMs || maxMs < minMs)
+        return false;
+
+    if (!stationKeepAliveSetIntervalMs(minMs))
+        return false;
+
+    _minMs = minMs;
+    _maxMs = maxMs;
+    _currentMs = minMs;
+    _unsafeMs = 0;
+    _quietPeriods = 0;
+    _adaptive = true;
+
+    // a disassociation while we were idle means the running cadence did not
+    // keep the AP's station entry alive: remember it and fall back
+    _disconnectHandler = WiFi.onStationModeDisconnected([](const WiFiEventStationModeDisconnected&)
+    {
+        ESP8266WiFiGratuitous::adaptiveStationDisconnected();
+    });
+
+    return true;
+}
+
+void ESP8266WiFiGratuitous::adaptivePeriodElapsed ()
+{
+    if (WiFi.status() != WL_CONNECTED)
+        // not a quiet period, do not grow on a dead link
+        return;
+
+    if (++_quietPeriods < quietPeriodsBeforeGrow)
+        return;
+    _quietPeriods = 0;
+
+    uint32_t next = _currentMs * 2;
+    if (next > _maxMs)
+        next = _maxMs;
+    if (next == _currentMs || (_unsafeMs && next >= _unsafeMs))
+        // growing further is pointless or known to get us dropped
+        return;
+
+    _currentMs = next;
+    if (_timer)
+    {
+        os_timer_disarm(_timer);
+        os_timer_arm(_timer, _currentMs, true);
+    }
+}
+
+void ESP8266WiFiGratuitous::adaptiveStationDisconnected ()
+{
+    if (!_adaptive)
+        return;
+
+    _quietPeriods = 0;
+
+    if (_currentMs <= _minMs)
+        // already at the floor, the drop was not cadence related
+        return;
+
+    // the running cadence lost the association: mark it unsafe and back
+    // off to the last interval that held
+    _unsafeMs = _currentMs;
+    _currentMs = _currentMs / 2 < _minMs ? _minMs : _currentMs / 2;
+    if (_timer)
+    {
+        os_timer_disarm(_timer);
+        os_timer_arm(_timer, _currentMs, true);
+    }
+}
+
 }; // experimental::
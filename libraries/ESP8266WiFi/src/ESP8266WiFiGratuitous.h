@@ -23,6 +23,8 @@
 #include <stdint.h>  // uint32_t
 #include <ets_sys.h> // ETSTimer
 
+#include "ESP8266WiFiGeneric.h" // WiFiEventHandler
+
 namespace experimental
 {
 
@@ -36,6 +38,14 @@ public:
     // return value: true when started, false otherwise
     static bool stationKeepAliveSetIntervalMs (uint32_t ms = 1000);
 
+    // enable adaptive sending of Gratuitous ARP packets: starts at minMs and,
+    // after a few quiet periods in a row, doubles the interval up to maxMs.
+    // A disconnection reported by the AP marks the running interval as unsafe
+    // and falls back to the last one that held the association, converging on
+    // the longest cadence this AP tolerates (fewer wakeups and transmissions).
+    // return value: true when started, false otherwise
+    static bool stationKeepAliveAdaptive (uint32_t minMs = 1000, uint32_t maxMs = 60000);
+
     // request for stopping arp gratuitous packets
     static void stationKeepAliveStop () { (void)stationKeepAliveSetIntervalMs(0); }
 
@@ -45,8 +55,19 @@ public:
 protected:
 
     static void scheduleItForNextYieldOnce (void*);
+    static void adaptivePeriodElapsed ();
+    static void adaptiveStationDisconnected ();
 
     static ETSTimer* _timer;
+
+    // adaptive cadence state
+    static bool _adaptive;
+    static uint32_t _minMs;
+    static uint32_t _maxMs;
+    static uint32_t _currentMs;
+    static uint32_t _unsafeMs;
+    static uint8_t _quietPeriods;
+    static WiFiEventHandler _disconnectHandler;
 };
 
 }; // experimental::
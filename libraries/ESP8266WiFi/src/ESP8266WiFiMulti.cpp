@@ -109,10 +109,33 @@ static wl_status_t waitWiFiConnect(uint32_t connectTimeoutMs)
     return WL_CONNECT_FAILED;
 }
 
+/**
+ * @brief FNV-1a hash of an SSID
+ * @details
+ *      Precomputed once per configured AP, so every scan result is matched
+ *      with a single 32-bit compare instead of a string compare per entry
+ * @param ssid
+ *      SSID bytes (not necessarily null terminated)
+ * @param len
+ *      SSID length in bytes
+ * @return
+ *      32-bit hash
+ */
+static uint32_t ssidHash(const uint8_t *ssid, uint8_t len)
+{
+    uint32_t hash = 2166136261u;
+
+    while (len--) {
+        hash = (hash ^ *ssid++) * 16777619u;
+    }
+
+    return hash;
+}
+
 /**
  * @brief Constructor
  */
-ESP8266WiFiMulti::ESP8266WiFiMulti() : _firstRun(true)
+ESP8266WiFiMulti::ESP8266WiFiMulti() : _firstRun(true), _sweepDone(false)
 {
 }
 
@@ -200,19 +223,73 @@ wl_status_t ESP8266WiFiMulti::run(uint32_t connectTimeoutMs)
         return status;
     }
 
-    // Start WiFi scan
+    // Start WiFi scan, scoring candidates per channel as results arrive
     scanResult = startScan();
     if (scanResult < 0) {
         // No WiFi scan results
         return WL_NO_SSID_AVAIL;
     }
 
-    // Try to connect to multiple WiFi's with strongest signal (RSSI)
-    return connectWiFiMulti(connectTimeoutMs);
+    // Connect to the best candidate first: with a good RSSI the sweep was
+    // ended early, well before a full scan would have finished
+    if (_best.apIndex >= 0) {
+        auto &entry = _APlist[_best.apIndex];
+
+        DEBUG_WIFI_MULTI("[WIFIM] Connecting %s (%ddBm)\n", entry.ssid, _best.rssi);
+
+        // Connect to WiFi
+        WiFi.begin(entry.ssid, entry.passphrase, _best.channel, _best.bssid);
+
+        // Wait for status change
+        if (waitWiFiConnect(connectTimeoutMs) == WL_CONNECTED) {
+            return WL_CONNECTED;
+        }
+    }
+
+    // Try to connect to the remaining WiFi's, strongest signal (RSSI) first
+    return connectWiFiMulti(connectTimeoutMs, _best.apIndex, _best.apIndex >= 0 ? _best.bssid : NULL);
+}
+
+/**
+ * @brief Find configured AP matching a scanned SSID
+ * @details
+ *      Compares the precomputed SSID hashes first; almost every scan
+ *      result is a foreign network, so most entries are rejected on the
+ *      hash alone and the string compare only confirms real matches
+ * @param ssid
+ *      SSID bytes from a scan result (not necessarily null terminated)
+ * @param ssidLen
+ *      SSID length in bytes
+ * @retval >=0
+ *      Index in AP list
+ * @retval -1
+ *      Not a configured AP
+ */
+int8_t ESP8266WiFiMulti::findAP(const uint8_t *ssid, uint8_t ssidLen) const
+{
+    uint32_t hash = ssidHash(ssid, ssidLen);
+
+    for (uint8_t i = 0; i < _APlist.size(); i++) {
+        const auto &entry = _APlist[i];
+
+        if ((entry.ssidHash == hash) &&
+                (strlen(entry.ssid) == ssidLen) &&
+                !memcmp(entry.ssid, ssid, ssidLen)) {
+            return i;
+        }
+    }
+
+    return -1;
 }
 
 /**
- * @brief Start WiFi scan
+ * @brief Start incremental WiFi scan
+ * @details
+ *      Scores configured APs as each channel completes (~120ms/channel)
+ *      instead of waiting for the full sweep; when a candidate at or above
+ *      WIFI_GOOD_RSSI_DBM appears, the remaining channels are dropped so
+ *      the caller can connect right away.  The best candidate is left in
+ *      _best.
  * @retval >0
  *      Number of detected WiFi SSID's
  * @retval 0
@@ -222,8 +299,6 @@ wl_status_t ESP8266WiFiMulti::run(uint32_t connectTimeoutMs)
  */
 int8_t ESP8266WiFiMulti::startScan()
 {
-    int8_t scanResult;
-
     DEBUG_WIFI_MULTI("[WIFIM] Start scan\n");
 
     // Clean previous scan
@@ -232,18 +307,44 @@ int8_t ESP8266WiFiMulti::startScan()
     // Remove previous WiFi SSID/password
     WiFi.disconnect();
 
-    // Start wifi scan in async mode
-    WiFi.scanNetworks(true);
+    // Reset candidate scoring
+    _best = Candidate();
+    _sweepDone = false;
+
+    // Start incremental wifi scan, all channels
+    int8_t scanStatus = WiFi.scanNetworksIncremental(0,
+        [this](const bss_info &bss) {
+            // Score the network as soon as its channel reports
+            int8_t apIndex = findAP(bss.ssid, bss.ssid_len);
+            if ((apIndex < 0) || (bss.rssi <= _best.rssi)) {
+                return;
+            }
+            _best.apIndex = apIndex;
+            _best.rssi = bss.rssi;
+            _best.channel = bss.channel;
+            memcpy(_best.bssid, bss.bssid, sizeof(_best.bssid));
+        },
+        [this](int) {
+            _sweepDone = true;
+        });
+    if (scanStatus == WIFI_SCAN_FAILED) {
+        DEBUG_WIFI_MULTI("[WIFIM] Scan failed\n");
+        return WIFI_SCAN_FAILED;
+    }
 
-    // Wait for WiFi scan change or timeout
-    // stop waiting upon status checked every 100ms or when timeout is reached
+    // Wait for a good enough candidate or the end of the sweep
+    // stop waiting upon status checked every 10ms or when timeout is reached
     esp_delay(WIFI_SCAN_TIMEOUT_MS,
-        [&scanResult]() {
-            scanResult = WiFi.scanComplete();
-            return scanResult < 0;
-        }, 100);
+        [this]() {
+            if (!_sweepDone && (_best.apIndex >= 0) && (_best.rssi >= WIFI_GOOD_RSSI_DBM)) {
+                // Good candidate found: drop the remaining channels so the
+                // sweep (and its onComplete) ends after the current one
+                WiFi.scanNetworksIncrementalStop();
+            }
+            return !_sweepDone;
+        }, 10);
     // Check for scan timeout which may occur when scan does not report completion
-    if (scanResult < 0) {
+    if (!_sweepDone) {
         DEBUG_WIFI_MULTI("[WIFIM] Scan timeout\n");
         return WIFI_SCAN_FAILED;
     }
@@ -252,43 +353,46 @@ int8_t ESP8266WiFiMulti::startScan()
     printWiFiScan();
 
     // Return (positive) number of detected WiFi networks
-    return scanResult;
+    return WiFi.scanComplete();
 }
 
 /**
  * @brief Connect to multiple WiFi's
  * @param connectTimeoutMs
  *      WiFi connect timeout in ms
+ * @param triedAP
+ *      AP list index already tried by the caller, or -1
+ * @param triedBssid
+ *      BSSID already tried by the caller, or NULL
  * @return
  *      WiFi connection status
  */
-wl_status_t ESP8266WiFiMulti::connectWiFiMulti(uint32_t connectTimeoutMs)
+wl_status_t ESP8266WiFiMulti::connectWiFiMulti(uint32_t connectTimeoutMs, int8_t triedAP, const uint8_t *triedBssid)
 {
     int8_t scanResult;
-    String ssid;
-    int32_t rssi;
-    uint8_t encType;
-    uint8_t *bssid;
-    int32_t channel;
-    bool hidden;
 
     // Get scan results
     scanResult = WiFi.scanComplete();
 
-    // Find known WiFi networks
-    uint8_t known[_APlist.size()];
+    // Find known WiFi networks; a configured SSID may be visible on
+    // several BSSIDs, so size by scan results
+    uint8_t known[scanResult > 0 ? scanResult : 1];
     uint8_t numNetworks = 0;
     for (int8_t i = 0; i < scanResult; i++) {
-        // Get network information
-        WiFi.getNetworkInfo(i, ssid, encType, rssi, bssid, channel, hidden);
+        const bss_info *bss = WiFi.getScanInfoByIndex(i);
+        if (!bss) {
+            continue;
+        }
+
+        // Skip the candidate the caller already tried
+        if (triedBssid && !memcmp(bss->bssid, triedBssid, sizeof(bss->bssid))) {
+            continue;
+        }
 
         // Check if the WiFi network contains an entry in AP list
-        for (auto entry : _APlist) {
-            // Check SSID
-            if (ssid == entry.ssid) {
-                // Known network
-                known[numNetworks++] = i;
-            }
+        if (findAP(bss->ssid, bss->ssid_len) >= 0) {
+            // Known network
+            known[numNetworks++] = i;
         }
     }
 
@@ -316,31 +420,28 @@ wl_status_t ESP8266WiFiMulti::connectWiFiMulti(uint32_t connectTimeoutMs)
     // Create indices for AP connection failures
     uint8_t connectSkipIndex[_APlist.size()];
     memset(connectSkipIndex, 0, sizeof(connectSkipIndex));
+    if (triedAP >= 0) {
+        connectSkipIndex[triedAP] = true;
+    }
 
     // Connect to known WiFi AP's sorted by RSSI
     for (int8_t i = 0; i < numNetworks; i++) {
-        // Get network information
-        WiFi.getNetworkInfo(known[i], ssid, encType, rssi, bssid, channel, hidden);
-
-        for (uint8_t j = 0; j < _APlist.size(); j++) {
-            auto &entry = _APlist[j];
-
-            // Check SSID
-            if (ssid == entry.ssid) {
-                DEBUG_WIFI_MULTI("[WIFIM] Connecting %s\n", ssid.c_str());
+        const bss_info *bss = WiFi.getScanInfoByIndex(known[i]);
+        int8_t apIndex = findAP(bss->ssid, bss->ssid_len);
+        auto &entry = _APlist[apIndex];
 
-                // Connect to WiFi
-                WiFi.begin(ssid, entry.passphrase, channel, bssid);
+        DEBUG_WIFI_MULTI("[WIFIM] Connecting %s\n", entry.ssid);
 
-                // Wait for status change
-                if (waitWiFiConnect(connectTimeoutMs) == WL_CONNECTED) {
-                    return WL_CONNECTED;
-                }
+        // Connect to WiFi
+        WiFi.begin(entry.ssid, entry.passphrase, bss->channel, bss->bssid);
 
-                // Failed to connect, skip for hidden SSID connects
-                connectSkipIndex[j] = true;
-            }
+        // Wait for status change
+        if (waitWiFiConnect(connectTimeoutMs) == WL_CONNECTED) {
+            return WL_CONNECTED;
         }
+
+        // Failed to connect, skip for hidden SSID connects
+        connectSkipIndex[apIndex] = true;
     }
 
     // Try to connect to hidden AP's which are not reported by WiFi scan
@@ -420,6 +521,9 @@ bool ESP8266WiFiMulti::APlistAdd(const char *ssid, const char *passphrase)
         return false;
     }
 
+    // Precompute the SSID hash used to match scan results
+    newAP.ssidHash = ssidHash((const uint8_t *)newAP.ssid, strlen(newAP.ssid));
+
     _APlist.push_back(newAP);
     DEBUG_WIFI_MULTI("[WIFIM][APlistAdd] Add SSID: %s\n", newAP.ssid);
     return true;
@@ -497,16 +601,9 @@ void ESP8266WiFiMulti::printWiFiScan()
 
     // Print unsorted scan results
     for (int8_t i = 0; i < scanResult; i++) {
-        bool known = false;
-
         WiFi.getNetworkInfo(i, ssid, encryptionType, rssi, bssid, channel, hidden);
 
-        for(auto entry : _APlist) {
-            if(ssid == entry.ssid) {
-                // SSID match
-                known = true;
-            }
-        }
+        bool known = (findAP((const uint8_t *)ssid.c_str(), ssid.length()) >= 0);
 
         if (known) {
             DEBUG_WIFI_MULTI(" --->");
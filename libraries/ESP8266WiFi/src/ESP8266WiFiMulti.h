@@ -50,9 +50,16 @@
 #define WIFI_SCAN_TIMEOUT_MS        5000
 #endif
 
+//! RSSI at which a scanned candidate is connected to immediately,
+//! without waiting for the remaining scan channels
+#ifndef WIFI_GOOD_RSSI_DBM
+#define WIFI_GOOD_RSSI_DBM          (-70)
+#endif
+
 struct WifiAPEntry {
     char *ssid;
     char *passphrase;
+    uint32_t ssidHash;  //!< precomputed FNV-1a of ssid, for fast scan matching
 };
 
 typedef std::vector<WifiAPEntry> WifiAPlist;
@@ -71,14 +78,25 @@ public:
     void cleanAPlist();
 
 private:
+    //! Best in-range configured AP found during the scan sweep
+    struct Candidate {
+        int8_t apIndex = -1;
+        int32_t rssi = -128;
+        uint8_t channel = 0;
+        uint8_t bssid[6] = {};
+    };
+
     WifiAPlist _APlist;
     bool _firstRun;
+    Candidate _best;
+    bool _sweepDone;
 
     bool APlistAdd(const char *ssid, const char *passphrase = NULL);
     bool APlistExists(const char *ssid, const char *passphrase = NULL);
     void APlistClean();
 
-    wl_status_t connectWiFiMulti(uint32_t connectTimeoutMs);
+    wl_status_t connectWiFiMulti(uint32_t connectTimeoutMs, int8_t triedAP, const uint8_t *triedBssid);
+    int8_t findAP(const uint8_t *ssid, uint8_t ssidLen) const;
     int8_t startScan();
     void printWiFiScan();
 };
@@ -119,6 +119,86 @@ static bool sta_config_equal(const station_config& lhs, const station_config& rh
 
 bool ESP8266WiFiSTAClass::_useStaticIp = false;
 bool ESP8266WiFiSTAClass::_useInsecureWEP = false;
+bool ESP8266WiFiSTAClass::_fastReconnect = false;
+bool ESP8266WiFiSTAClass::_fastReconnectDirected = false;
+
+// fast-reconnect hint in the last 12 bytes of RTC user memory
+// (blocks 125..127, see EspClass::rtcUserMemoryRead/Write); the words
+// below are shared by the RTCVar snapshot growing up from word 0
+// (RTCVar.h) and the EEPROM TIER_RTC image packing down from word 124
+// (EEPROM.h)
+static constexpr uint32_t RTC_FAST_RECONNECT_OFFSET = 125;
+
+struct rtc_fast_reconnect_rec {
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;
+    uint32_t crc; // crc32 of the preceding bytes
+};
+
+/**
+ * load the fast-reconnect hint from RTC user memory
+ * @return true when a valid record was found
+ */
+bool ESP8266WiFiSTAClass::_fastReconnectLoad(uint8_t bssid[6], uint8_t& channel) {
+    struct rtc_fast_reconnect_rec rec;
+    if(!ESP.rtcUserMemoryRead(RTC_FAST_RECONNECT_OFFSET, reinterpret_cast<uint32_t*>(&rec), sizeof(rec))) {
+        return false;
+    }
+    if(rec.crc != crc32(&rec, sizeof(rec) - sizeof(rec.crc))
+            || rec.channel < 1 || rec.channel > 14) {
+        return false;
+    }
+    memcpy(bssid, rec.bssid, 6);
+    channel = rec.channel;
+    return true;
+}
+
+/**
+ * persist the associated AP's BSSID and channel into RTC user memory
+ */
+void ESP8266WiFiSTAClass::_fastReconnectStore(const uint8_t bssid[6], uint8_t channel) {
+    struct rtc_fast_reconnect_rec rec;
+    memcpy(rec.bssid, bssid, 6);
+    rec.channel = channel;
+    rec.reserved = 0;
+    rec.crc = crc32(&rec, sizeof(rec) - sizeof(rec.crc));
+    ESP.rtcUserMemoryWrite(RTC_FAST_RECONNECT_OFFSET, reinterpret_cast<uint32_t*>(&rec), sizeof(rec));
+}
+
+/**
+ * invalidate the stored fast-reconnect hint
+ */
+void ESP8266WiFiSTAClass::_fastReconnectClear() {
+    struct rtc_fast_reconnect_rec rec;
+    memset(&rec, 0, sizeof(rec)); // crc of zeros won't validate
+    ESP.rtcUserMemoryWrite(RTC_FAST_RECONNECT_OFFSET, reinterpret_cast<uint32_t*>(&rec), sizeof(rec));
+}
+
+/**
+ * a directed fast-reconnect attempt failed (AP gone or moved channel):
+ * drop the stale hint and retry with a normal full-scan association
+ */
+void ESP8266WiFiSTAClass::_fastReconnectFallback() {
+    if(!_fastReconnectDirected) {
+        return;
+    }
+    _fastReconnectDirected = false;
+    _fastReconnectClear();
+
+    struct station_config conf;
+    wifi_station_get_config(&conf);
+    conf.bssid_set = 0;
+#if (NONOSDK >= (0x30200))
+    conf.channel = 0;
+    conf.all_channel_scan = true;
+#endif
+
+    ETS_UART_INTR_DISABLE();
+    wifi_station_set_config_current(&conf);
+    wifi_station_connect();
+    ETS_UART_INTR_ENABLE();
+}
 
 /**
  * Start Wifi connection
@@ -181,6 +261,23 @@ wl_status_t ESP8266WiFiSTAClass::begin(const char* ssid, const char *passphrase,
         conf.bssid_set = 0;
     }
 
+    // fast reconnect: pin the association to the last AP's BSSID and
+    // channel (stored in RTC memory) unless the caller gave explicit ones
+    _fastReconnectDirected = false;
+    uint8_t rtc_bssid[6];
+    uint8_t rtc_channel = 0;
+    if(_fastReconnect && connect && !bssid && channel == 0
+            && _fastReconnectLoad(rtc_bssid, rtc_channel)) {
+        conf.bssid_set = 1;
+        memcpy(conf.bssid, rtc_bssid, 6);
+        channel = rtc_channel;
+#if (NONOSDK >= (0x30200))
+        conf.channel = rtc_channel;
+        conf.all_channel_scan = false;
+#endif
+        _fastReconnectDirected = true;
+    }
+
     struct station_config conf_compare;
     if(WiFi._persistent){
         wifi_station_get_config_default(&conf_compare);
@@ -195,7 +292,10 @@ wl_status_t ESP8266WiFiSTAClass::begin(const char* ssid, const char *passphrase,
     else {
         ETS_UART_INTR_DISABLE();
 
-        if(WiFi._persistent) {
+        // a directed fast-reconnect config is never written to flash:
+        // the persisted credentials stay un-pinned so a plain boot (or a
+        // fallback) still associates by full scan
+        if(WiFi._persistent && !_fastReconnectDirected) {
             wifi_station_set_config(&conf);
         } else {
             wifi_station_set_config_current(&conf);
@@ -85,11 +85,38 @@ class ESP8266WiFiSTAClass: public LwipIntf {
 
         static void enableInsecureWEP (bool enable = true) { _useInsecureWEP = enable; }
 
+        // Fast reconnect: when enabled, every successful association stores
+        // the AP's BSSID and channel in the last 12 bytes of RTC user memory
+        // (words 125..127 - RTCVar snapshots and the EEPROM TIER_RTC image
+        // keep clear of them, see RTCVar.h and EEPROM.h; surviving deep
+        // sleep and reset), and the next begin() with no
+        // explicit channel/BSSID pins the association to that BSSID and
+        // channel, skipping the full all-channel scan (~2s on a quiet
+        // network).  When the directed attempt fails - AP gone or moved to
+        // another channel - the stored hint is dropped and the connection
+        // automatically falls back to a normal full-scan association.
+        // The hint is always applied through the non-persisted SDK config,
+        // so WiFi.persistent(true) keeps the un-pinned credentials in flash.
+        static void setFastReconnect(bool enable = true) { _fastReconnect = enable; }
+        static bool getFastReconnect() { return _fastReconnect; }
+
     protected:
 
         static bool _useStaticIp;
         static bool _useInsecureWEP;
 
+        static bool _fastReconnect;
+        static bool _fastReconnectDirected; // directed association in flight
+
+        static bool _fastReconnectLoad(uint8_t bssid[6], uint8_t& channel);
+        static void _fastReconnectStore(const uint8_t bssid[6], uint8_t channel);
+        static void _fastReconnectClear();
+        static void _fastReconnectFallback();
+
+        // event hooks feeding the fast-reconnect state live in
+        // ESP8266WiFiGenericClass::_eventCallback()
+        friend class ESP8266WiFiGenericClass;
+
     // ----------------------------------------------------------------------------------------------
     // ------------------------------------ STA remote configure  -----------------------------------
     // ----------------------------------------------------------------------------------------------
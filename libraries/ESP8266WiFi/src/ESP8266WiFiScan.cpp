@@ -58,6 +58,10 @@ void* ESP8266WiFiScanClass::_scanResult = 0;
 
 std::function<void(int)> ESP8266WiFiScanClass::_onComplete;
 
+uint16_t ESP8266WiFiScanClass::_incrementalMask = 0;
+bool ESP8266WiFiScanClass::_incrementalShowHidden = false;
+std::function<void(const bss_info&)> ESP8266WiFiScanClass::_onNetworkFound;
+
 /**
  * Start scan WiFi networks available
  * @param async         run in async mode
@@ -116,6 +120,59 @@ void ESP8266WiFiScanClass::scanNetworksAsync(std::function<void(int)> onComplete
     scanNetworks(true, show_hidden);
 }
 
+/**
+ * Start an incremental scan: one SDK scan per selected channel, with
+ * per-network delivery after each channel instead of after the full sweep
+ * @param channelMask     bit N set = scan channel N+1 (0 for all channels)
+ * @param onNetworkFound  invoked once per discovered network, as soon as its
+ *                        channel completes (~120ms per channel)
+ * @param onComplete      optional, invoked with the total network count when
+ *                        the sweep ends
+ * @param show_hidden     show hidden networks
+ * @return WIFI_SCAN_RUNNING when started, WIFI_SCAN_FAILED otherwise
+ */
+int8_t ESP8266WiFiScanClass::scanNetworksIncremental(uint16_t channelMask, std::function<void(const bss_info&)> onNetworkFound, std::function<void(int)> onComplete, bool show_hidden) {
+    if(ESP8266WiFiScanClass::_scanStarted) {
+        return WIFI_SCAN_RUNNING;
+    }
+
+    WiFi.enableSTA(true);
+
+    int status = wifi_station_get_connect_status();
+    if(status != STATION_GOT_IP && status != STATION_IDLE) {
+        wifi_station_disconnect();
+    }
+
+    scanDelete();
+
+    ESP8266WiFiScanClass::_scanAsync = true;
+    ESP8266WiFiScanClass::_incrementalMask = channelMask ? channelMask : 0x3FFF; // channels 1..14
+    ESP8266WiFiScanClass::_incrementalShowHidden = show_hidden;
+    ESP8266WiFiScanClass::_onNetworkFound = onNetworkFound;
+    ESP8266WiFiScanClass::_onComplete = onComplete;
+    ESP8266WiFiScanClass::_scanComplete = false;
+    ESP8266WiFiScanClass::_scanStarted = true;
+
+    if(!_startNextChannel()) {
+        ESP8266WiFiScanClass::_scanStarted = false;
+        ESP8266WiFiScanClass::_onNetworkFound = nullptr;
+        ESP8266WiFiScanClass::_onComplete = nullptr;
+        return WIFI_SCAN_FAILED;
+    }
+
+    esp_yield(); // time for the OS to trigger the scan
+    return WIFI_SCAN_RUNNING;
+}
+
+/**
+ * End a running incremental sweep after the current channel: drop the
+ * channels left in the mask, so _scanChannelDone finishes the sweep and
+ * runs onComplete as soon as the in-flight channel reports
+ */
+void ESP8266WiFiScanClass::scanNetworksIncrementalStop() {
+    ESP8266WiFiScanClass::_incrementalMask = 0;
+}
+
 /**
  * called to get the scan state in Async mode
  * @return scan result or status
@@ -338,6 +395,100 @@ void ESP8266WiFiScanClass::_scanDone(void* result, int status) {
     }
 }
 
+/**
+ * private
+ * start the SDK scan for the next channel left in the incremental mask
+ * @return true when a channel scan was started
+ */
+bool ESP8266WiFiScanClass::_startNextChannel() {
+    for(uint8 ch = 1; ch <= 14; ch++) {
+        uint16_t bit = 1 << (ch - 1);
+        if(!(ESP8266WiFiScanClass::_incrementalMask & bit)) {
+            continue;
+        }
+        ESP8266WiFiScanClass::_incrementalMask &= ~bit;
+
+        struct scan_config config;
+        memset(&config, 0, sizeof(config));
+        config.channel = ch;
+        config.show_hidden = ESP8266WiFiScanClass::_incrementalShowHidden;
+        if(wifi_station_scan(&config, reinterpret_cast<scan_done_cb_t>(&ESP8266WiFiScanClass::_scanChannelDone))) {
+            return true;
+        }
+        // could not start this channel, try the next one
+    }
+    return false;
+}
+
+/**
+ * private
+ * per-channel scan callback of the incremental sweep: append the channel's
+ * networks to the accumulated result (skipping BSSIDs already reported from
+ * an overlapping channel), deliver them, then kick the next channel
+ * @param result  void *arg
+ * @param status STATUS
+ */
+void ESP8266WiFiScanClass::_scanChannelDone(void* result, int status) {
+    size_t previous = ESP8266WiFiScanClass::_scanCount;
+    bss_info* stored = reinterpret_cast<bss_info*>(ESP8266WiFiScanClass::_scanResult);
+
+    if(status == OK && result) {
+        bss_info* head = reinterpret_cast<bss_info*>(result);
+
+        size_t added = 0;
+        for(bss_info* it = head; it; it = STAILQ_NEXT(it, next)) {
+            bool known = false;
+            for(size_t i = 0; !known && i < previous; i++) {
+                known = (memcmp(stored[i].bssid, it->bssid, sizeof(it->bssid)) == 0);
+            }
+            if(!known) {
+                ++added;
+            }
+        }
+
+        if(added) {
+            bss_info* grown = new bss_info[previous + added];
+            if(previous) {
+                memcpy(grown, stored, previous * sizeof(bss_info));
+            }
+            size_t i = previous;
+            for(bss_info* it = head; it; it = STAILQ_NEXT(it, next)) {
+                bool known = false;
+                for(size_t k = 0; !known && k < previous; k++) {
+                    known = (memcmp(grown[k].bssid, it->bssid, sizeof(it->bssid)) == 0);
+                }
+                if(!known) {
+                    memcpy(grown + i, it, sizeof(bss_info));
+                    ++i;
+                }
+            }
+            delete[] stored;
+            ESP8266WiFiScanClass::_scanResult = grown;
+            ESP8266WiFiScanClass::_scanCount = previous + added;
+            stored = grown;
+        }
+    }
+
+    if(ESP8266WiFiScanClass::_onNetworkFound) {
+        for(size_t i = previous; i < ESP8266WiFiScanClass::_scanCount; i++) {
+            ESP8266WiFiScanClass::_onNetworkFound(stored[i]);
+        }
+    }
+
+    if(ESP8266WiFiScanClass::_incrementalMask && _startNextChannel()) {
+        return; // sweep continues, _scanChannelDone will fire again
+    }
+
+    ESP8266WiFiScanClass::_scanStarted = false;
+    ESP8266WiFiScanClass::_scanComplete = true;
+    ESP8266WiFiScanClass::_onNetworkFound = nullptr;
+
+    if (ESP8266WiFiScanClass::_onComplete) {
+        ESP8266WiFiScanClass::_onComplete(ESP8266WiFiScanClass::_scanCount);
+        ESP8266WiFiScanClass::_onComplete = nullptr;
+    }
+}
+
 /**
  *
  * @param i specify from which network item want to get the information
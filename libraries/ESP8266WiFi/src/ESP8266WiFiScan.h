@@ -37,6 +37,30 @@ class ESP8266WiFiScanClass {
         int8_t scanNetworks(bool async = false, bool show_hidden = false, uint8 channel = 0, uint8* ssid = NULL);
         void scanNetworksAsync(std::function<void(int)> onComplete, bool show_hidden = false);
 
+        // Incremental scan: sweeps the channels selected by channelMask
+        // (bit N set = scan channel N+1, 0 = all channels) one channel at a
+        // time and invokes onNetworkFound for every network as soon as its
+        // channel completes, instead of delivering the whole batch after the
+        // full ~2s sweep.  The bss_info reference points into the accumulated
+        // result storage and stays valid until scanDelete() or the next scan;
+        // networks already reported on an earlier channel are not repeated.
+        // onComplete, when set, runs at the end of the sweep with the total
+        // network count; the results remain accessible through
+        // SSID()/RSSI()/etc. like any other scan.
+        // Returns WIFI_SCAN_RUNNING when the sweep started, WIFI_SCAN_FAILED
+        // otherwise.
+        int8_t scanNetworksIncremental(uint16_t channelMask,
+                                       std::function<void(const bss_info&)> onNetworkFound,
+                                       std::function<void(int)> onComplete = nullptr,
+                                       bool show_hidden = false);
+
+        // Ends a running incremental sweep early: the channel currently
+        // being scanned still completes and delivers its results, but no
+        // further channels are started and onComplete runs right after.
+        // Safe to call from within onNetworkFound.  No effect on a full
+        // (non-incremental) scan.
+        void scanNetworksIncrementalStop();
+
         int8_t scanComplete();
         void scanDelete();
 
@@ -63,7 +87,14 @@ class ESP8266WiFiScanClass {
 
         static std::function<void(int)> _onComplete;
 
+        // incremental sweep state (scanNetworksIncremental)
+        static uint16_t _incrementalMask;
+        static bool _incrementalShowHidden;
+        static std::function<void(const bss_info&)> _onNetworkFound;
+
         static void _scanDone(void* result, int status);
+        static void _scanChannelDone(void* result, int status);
+        static bool _startNextChannel();
         static void * _getScanInfoByIndex(int i);
 
 };
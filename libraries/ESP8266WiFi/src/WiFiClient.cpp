@@ -127,11 +127,26 @@ WiFiClient& WiFiClient::operator=(const WiFiClient& other)
     return *this;
 }
 
+// stamp the arrival of the first byte after a connect, for WiFi.connStats()
+static void _connStatsFirstByte()
+{
+    auto& stats = ESP8266WiFiGenericClass::connStats();
+    if (stats._firstBytePending) {
+        stats._firstBytePending = false;
+        stats.firstByteCycles = ESP.getCycleCount() - stats._connectDoneAt;
+    }
+}
+
 int WiFiClient::connect(const char* host, uint16_t port)
 {
+    auto& stats = ESP8266WiFiGenericClass::connStats();
+    stats = WiFiConnStats{};
+
     IPAddress remote_addr;
+    const uint32_t dnsStart = ESP.getCycleCount();
     if (WiFi.hostByName(host, remote_addr, _timeout))
     {
+        stats.dnsCycles = ESP.getCycleCount() - dnsStart;
         return connect(remote_addr, port);
     }
     return 0;
@@ -158,6 +173,10 @@ int WiFiClient::connect(IPAddress ip, uint16_t port)
         pcb->local_port = _localPort++;
     }
 
+    auto& stats = ESP8266WiFiGenericClass::connStats();
+    stats.connectCycles = stats.tlsHandshakeCycles = stats.firstByteCycles = 0;
+    const uint32_t connectStart = ESP.getCycleCount();
+
     _client = new ClientContext(pcb, nullptr, nullptr);
     _client->ref();
     _client->setTimeout(_timeout);
@@ -168,6 +187,101 @@ int WiFiClient::connect(IPAddress ip, uint16_t port)
         return 0;
     }
 
+    stats.connectCycles = ESP.getCycleCount() - connectStart;
+    stats._connectDoneAt = ESP.getCycleCount();
+    stats._firstBytePending = true;
+
+    setSync(defaultSync);
+    setNoDelay(defaultNoDelay);
+
+    return 1;
+}
+
+int WiFiClient::connect(const IPAddress* addrs, size_t naddrs, uint16_t port, uint32_t staggerMs)
+{
+    if (!addrs || naddrs == 0)
+        return 0;
+    if (naddrs == 1)
+        return connect(addrs[0], port);
+
+    if (_client) {
+        stop();
+        _client->unref();
+        _client = nullptr;
+    }
+
+    // Happy-eyeballs style: start an attempt towards the first address,
+    // add the next one every staggerMs (or immediately when an attempt
+    // reports failure), keep whichever context establishes first.
+    constexpr size_t maxAttempts = 4;
+    ClientContext* attempts[maxAttempts] = { nullptr };
+    if (naddrs > maxAttempts)
+        naddrs = maxAttempts;
+
+    size_t started = 0;
+    size_t nextAddr = 0;
+    ClientContext* winner = nullptr;
+    const uint32_t start = millis();
+    uint32_t nextLaunch = start;
+
+    while (!winner && (millis() - start) < _timeout) {
+        if (nextAddr < naddrs && (int32_t)(millis() - nextLaunch) >= 0) {
+            tcp_pcb* pcb = tcp_new();
+            if (pcb) {
+                if (_localPort > 0) {
+                    pcb->local_port = _localPort++;
+                }
+                ClientContext* c = new ClientContext(pcb, nullptr, nullptr);
+                c->ref();
+                c->setTimeout(_timeout);
+                IPAddress addr = addrs[nextAddr];
+                if (c->connectAsync(addr, port)) {
+                    attempts[started++] = c;
+                } else {
+                    c->unref();
+                }
+            }
+            ++nextAddr;
+            nextLaunch = millis() + staggerMs;
+        }
+
+        bool allFailed = (nextAddr >= naddrs);
+        for (size_t i = 0; i < started; i++) {
+            ClientContext* c = attempts[i];
+            if (!c)
+                continue;
+            if (c->state() == ESTABLISHED) {
+                winner = c;
+                attempts[i] = nullptr;
+                break;
+            }
+            if (!c->connecting()) {
+                // attempt reported failure: drop it and bring the next
+                // address forward
+                attempts[i] = nullptr;
+                c->unref();
+                nextLaunch = millis();
+            } else {
+                allFailed = false;
+            }
+        }
+        if (!winner && allFailed)
+            break;
+
+        delay(1);
+    }
+
+    // lose the losers (unref aborts anything still in flight)
+    for (size_t i = 0; i < started; i++) {
+        if (attempts[i])
+            attempts[i]->unref();
+    }
+
+    if (!winner)
+        return 0;
+
+    _client = winner;
+
     setSync(defaultSync);
     setNoDelay(defaultNoDelay);
 
@@ -186,6 +300,39 @@ bool WiFiClient::getNoDelay() const {
     return _client->getNoDelay();
 }
 
+bool WiFiClient::tune(TcpTuneProfile profile)
+{
+    TcpTuning t = { 0, 0, 1, false }; // TcpTuneProfile::BASELINE
+    switch (profile)
+    {
+    case TcpTuneProfile::BULK:
+        // whole sndbuf, Nagle on, tiny writes (headers, prints) batched
+        t = { 0, 20, 1, false };
+        break;
+    case TcpTuneProfile::LOWLAT:
+        // push every write out at once and keep the un-ACKed queue short
+        // so a control packet never sits behind a full send buffer
+        t = { 2 * TCP_MSS, 0, 1, true };
+        break;
+    case TcpTuneProfile::BASELINE:
+        break;
+    }
+    return tune(t);
+}
+
+bool WiFiClient::tune(const TcpTuning& tuning)
+{
+    return _client? _client->tune(tuning): false;
+}
+
+void WiFiClient::flushCoalesced()
+{
+    if (_client)
+    {
+        _client->flushCoalesced();
+    }
+}
+
 void WiFiClient::setSync(bool sync)
 {
     if (!_client)
@@ -205,6 +352,16 @@ int WiFiClient::availableForWrite ()
     return _client? _client->availableForWrite(): 0;
 }
 
+size_t WiFiClient::txQueueDepth ()
+{
+    return _client? _client->txQueueDepth(): 0;
+}
+
+int WiFiClient::rttEstimateMs ()
+{
+    return _client? _client->rttEstimateMs(): -1;
+}
+
 size_t WiFiClient::write(uint8_t b)
 {
     return write(&b, 1);
@@ -220,6 +377,47 @@ size_t WiFiClient::write(const uint8_t *buf, size_t size)
     return _client->write((const char*)buf, size);
 }
 
+size_t WiFiClient::writev(const client_iovec* iov, int iovcnt)
+{
+    if (!_client || !iov || iovcnt <= 0)
+    {
+        return 0;
+    }
+    _client->setTimeout(_timeout);
+    return _client->writev(iov, iovcnt);
+}
+
+bool WiFiClient::writeShared(SharedSendBuffer* shared)
+{
+    return _client? _client->writeShared(shared): false;
+}
+
+bool WiFiClient::writeAsync(Stream& source, size_t len, const async_write_cb_t& cb, size_t slice)
+{
+    return _client? _client->writeAsync(&source, len, cb, slice): false;
+}
+
+void WiFiClient::resumeAsync()
+{
+    if (_client)
+    {
+        _client->resumeAsync();
+    }
+}
+
+void WiFiClient::stopAsync()
+{
+    if (_client)
+    {
+        _client->stopAsync();
+    }
+}
+
+bool WiFiClient::asyncWriting() const
+{
+    return _client? _client->asyncWriting(): false;
+}
+
 size_t WiFiClient::write(Stream& stream)
 {
     // (this method is deprecated)
@@ -252,6 +450,8 @@ int WiFiClient::available()
 
     if (!result) {
         optimistic_yield(100);
+    } else {
+        _connStatsFirstByte();
     }
     return result;
 }
@@ -266,7 +466,11 @@ int WiFiClient::read()
 
 int WiFiClient::read(uint8_t* buf, size_t size)
 {
-    return (int)_client->read((char*)buf, size);
+    int ret = (int)_client->read((char*)buf, size);
+    if (ret > 0) {
+        _connStatsFirstByte();
+    }
+    return ret;
 }
 
 int WiFiClient::read(char* buf, size_t size)
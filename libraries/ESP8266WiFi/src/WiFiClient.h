@@ -21,12 +21,14 @@
 
 #ifndef wificlient_h
 #define wificlient_h
+#include <functional>
 #include <memory>
 #include "Arduino.h"
 #include "Print.h"
 #include "Client.h"
 #include "IPAddress.h"
 #include "include/slist.h"
+#include "include/SharedSendBuffer.h"
 
 #ifndef TCP_MSS
 #define TCP_MSS 1460 // lwip1.4
@@ -39,6 +41,45 @@
 #define TCP_DEFAULT_KEEPALIVE_INTERVAL_SEC      75   // 75 sec
 #define TCP_DEFAULT_KEEPALIVE_COUNT             9    // fault after 9 failures
 
+#ifndef CLIENT_IOVEC_DEFINED
+#define CLIENT_IOVEC_DEFINED
+// fragment descriptor for scatter-gather writes (WiFiClient::writev()),
+// layout-compatible with POSIX struct iovec
+struct client_iovec {
+    const void* iov_base;
+    size_t      iov_len;
+};
+#endif // CLIENT_IOVEC_DEFINED
+
+#ifndef CLIENT_ASYNC_WRITE_DEFINED
+#define CLIENT_ASYNC_WRITE_DEFINED
+// event reported to the writeAsync() callback (WiFiClient::writeAsync())
+enum class AsyncWriteEvent : uint8_t {
+    PROGRESS,   // more source bytes were handed to lwIP, the peer is reading
+    DONE,       // the requested length has been fully queued
+    CLOSED      // the connection went away before completion
+};
+// invoked from loop() context (scheduled function), never from inside lwIP
+typedef std::function<void(size_t written, AsyncWriteEvent event)> async_write_cb_t;
+#endif // CLIENT_ASYNC_WRITE_DEFINED
+
+#ifndef CLIENT_TCP_TUNING_DEFINED
+#define CLIENT_TCP_TUNING_DEFINED
+// per-socket TCP knobs, see WiFiClient::tune()
+struct TcpTuning {
+    size_t   sndbufLimit;       // cap on un-ACKed queued bytes (0: lwIP default)
+    uint16_t coalesceWindowMs;  // hold small writes up to this long (0: off)
+    uint8_t  pollIntervalTicks; // lwIP poll callback pace, 500ms coarse ticks
+    bool     noDelay;           // disable Nagle
+};
+// canned profiles for the common socket roles
+enum class TcpTuneProfile : uint8_t {
+    BASELINE, // lwIP defaults, Nagle on
+    BULK,     // full sndbuf, Nagle on, small writes batched for 20ms
+    LOWLAT    // Nagle off, un-ACKed queue capped to bound bufferbloat
+};
+#endif // CLIENT_TCP_TUNING_DEFINED
+
 class ClientContext;
 class WiFiServer;
 
@@ -68,6 +109,13 @@ public:
   virtual int connect(IPAddress ip, uint16_t port) override;
   virtual int connect(const char *host, uint16_t port) override;
   virtual int connect(const String& host, uint16_t port);
+  // Happy-eyeballs style connect for hosts with several candidate
+  // addresses: races attempts started staggerMs apart (a failed attempt
+  // brings the next address forward immediately) and keeps the first
+  // connection that establishes, bounding worst-case latency near the
+  // healthy server's RTT. At most 4 addresses are attempted.
+  // Returns 1 when one of the attempts succeeded, 0 otherwise
+  int connect(const IPAddress* addrs, size_t naddrs, uint16_t port, uint32_t staggerMs = 250);
   virtual size_t write(uint8_t) override;
   virtual size_t write(const uint8_t *buf, size_t size) override;
   virtual size_t write_P(PGM_P buf, size_t size);
@@ -100,6 +148,13 @@ public:
 
   int availableForWrite() override;
 
+  // Bytes written but not yet acknowledged by the peer (occupied TCP send
+  // buffer).  A depth pinned near the buffer size marks a slow client.
+  size_t txQueueDepth();
+  // Smoothed RTT estimate in milliseconds (500ms resolution, see
+  // ClientContext::rttEstimateMs()), or -1 when not connected.
+  int rttEstimateMs();
+
   friend class WiFiServer;
 
   using Print::write;
@@ -123,6 +178,16 @@ public:
   bool getNoDelay() const;
   void setNoDelay(bool nodelay);
 
+  // per-socket TCP tuning beyond setNoDelay(): un-ACKed queue cap, poll
+  // callback pace and a small-write batching window (see TcpTuning and
+  // ClientContext::tune()).  A bulk OTA-style socket and a latency-critical
+  // control socket want different settings; pick a canned profile or pass
+  // the knobs directly.
+  bool tune(TcpTuneProfile profile);
+  bool tune(const TcpTuning& tuning);
+  // hand any held (coalesced) small writes to TCP right now
+  void flushCoalesced();
+
   // default Sync=false
   // When sync is true, all writes are automatically flushed.
   // This is slower but also does not allocate
@@ -132,6 +197,34 @@ public:
   bool getSync() const;
   void setSync(bool sync);
 
+  // broadcast fan-out: queue a reference-counted shared payload without
+  // copying it into this connection (see SharedSendBuffer and
+  // ClientContext::writeShared()).  All-or-nothing; returns false when the
+  // send buffer can't take the whole payload, in which case the caller
+  // should fall back to write().  Plain TCP clients only - TLS wrappers
+  // must go through their own write() path.
+  bool writeShared(SharedSendBuffer* shared);
+
+  // scatter-gather write: queue all fragments in one TCP write pass,
+  // avoiding both the caller-side coalescing copy and a segment cut per
+  // fragment (see ClientContext::writev()).
+  // Returns the total number of bytes written.
+  size_t writev(const client_iovec* iov, int iovcnt);
+
+  // budgeted non-blocking bulk transfer: len bytes of source are fed to
+  // TCP from lwIP's ACK/poll callbacks, at most slice bytes per callback
+  // (0: a full send buffer), without ever blocking loop().  cb reports
+  // PROGRESS/DONE/CLOSED from a scheduled function.  Returns false when a
+  // transfer or a blocking write is already in flight; while one is
+  // active, don't interleave write() calls on this connection (see
+  // ClientContext::writeAsync()).
+  bool writeAsync(Stream& source, size_t len, const async_write_cb_t& cb, size_t slice = 0);
+  // kick a transfer whose source had run dry
+  void resumeAsync();
+  // cancel the in-flight transfer; no further callback fires
+  void stopAsync();
+  bool asyncWriting() const;
+
   // peek buffer API is present
   virtual bool hasPeekBufferAPI () const override;
 
@@ -140,9 +233,13 @@ public:
 
   // return a pointer to available data buffer (size = peekAvailable())
   // semantic forbids any kind of read() before calling peekConsume()
+  // The pointer spans one contiguous lwIP pbuf and stays valid until the
+  // bytes are consumed; parsers can decode frames in place from it.
   virtual const char* peekBuffer () override;
 
   // consume bytes after use (see peekBuffer)
+  // Any amount up to available() may be consumed, including across pbuf
+  // boundaries; afterwards peekBuffer() exposes the next pbuf of the chain.
   virtual void peekConsume (size_t consume) override;
 
   virtual bool outputCanTimeout () override { return connected(); }
@@ -30,6 +30,7 @@ extern "C" {
 #include "ets_sys.h"
 }
 #include "debug.h"
+#include "coredecls.h"
 #include "ESP8266WiFi.h"
 #include "PolledTimeout.h"
 #include "WiFiClient.h"
@@ -68,6 +69,53 @@ extern "C" {
 
 namespace BearSSL {
 
+#ifndef BEARSSL_SSL_BASIC
+// Progress-yielding EC wrapper (see setEcProgressYield()).  A single P-256
+// point multiplication runs for hundreds of milliseconds inside one
+// br_ssl_engine call, freezing the loop even though interrupts stay
+// serviced.  Routing the heavy operations through stack_thunk_yield()
+// hands control back to the loop between multiplications, bounding the
+// stall to one EC operation instead of the whole handshake.
+static const br_ec_impl *ec_base_impl = nullptr;
+
+static uint32_t ec_yielding_mul(unsigned char *G, size_t Glen, const unsigned char *x, size_t xlen, int curve) {
+  stack_thunk_yield();
+  uint32_t ret = ec_base_impl->mul(G, Glen, x, xlen, curve);
+  stack_thunk_yield();
+  return ret;
+}
+
+static size_t ec_yielding_mulgen(unsigned char *R, const unsigned char *x, size_t xlen, int curve) {
+  stack_thunk_yield();
+  size_t ret = ec_base_impl->mulgen(R, x, xlen, curve);
+  stack_thunk_yield();
+  return ret;
+}
+
+static uint32_t ec_yielding_muladd(unsigned char *A, const unsigned char *B, size_t len,
+                                   const unsigned char *x, size_t xlen,
+                                   const unsigned char *y, size_t ylen, int curve) {
+  stack_thunk_yield();
+  uint32_t ret = ec_base_impl->muladd(A, B, len, x, xlen, y, ylen, curve);
+  stack_thunk_yield();
+  return ret;
+}
+
+// The default EC implementation with the three long-running operations
+// replaced by yielding versions; everything else is used as-is.
+static const br_ec_impl *ec_yielding_impl() {
+  static br_ec_impl impl;
+  if (!ec_base_impl) {
+    ec_base_impl = br_ec_get_default();
+    impl = *ec_base_impl;
+    impl.mul = ec_yielding_mul;
+    impl.mulgen = ec_yielding_mulgen;
+    impl.muladd = ec_yielding_muladd;
+  }
+  return &impl;
+}
+#endif // !BEARSSL_SSL_BASIC
+
 void WiFiClientSecureCtx::_clear() {
   // TLS handshake may take more than the 5 second default timeout
   _timeout = 15000;
@@ -82,8 +130,12 @@ void WiFiClientSecureCtx::_clear() {
   _iobuf_out = nullptr;
   _now = 0; // You can override or ensure time() is correct w/configTime
   _ta = nullptr;
-  setBufferSizes(16384, 512); // Minimum safe
+  _applyBufferSizes(16384, 512); // Minimum safe
+  _explicit_buf_sizes = false;
+  _use_auto_mfln = false;
+  _ec_yield = false;
   _handshake_done = false;
+  _handshake_pending = false;
   _recvapp_buf = nullptr;
   _recvapp_len = 0;
   _oom_err = false;
@@ -175,7 +227,7 @@ void WiFiClientSecureCtx::setClientECCert(const X509List *chain,
   _cert_issuer_key_type = cert_issuer_key_type;
 }
 
-void WiFiClientSecureCtx::setBufferSizes(int recv, int xmit) {
+void WiFiClientSecureCtx::_applyBufferSizes(int recv, int xmit) {
   // Following constants taken from bearssl/src/ssl/ssl_engine.c (not exported unfortunately)
   const int MAX_OUT_OVERHEAD = 85;
   const int MAX_IN_OVERHEAD = 325;
@@ -191,6 +243,106 @@ void WiFiClientSecureCtx::setBufferSizes(int recv, int xmit) {
   _iobuf_out_size = xmit;
 }
 
+void WiFiClientSecureCtx::setBufferSizes(int recv, int xmit) {
+  _applyBufferSizes(recv, xmit);
+  _explicit_buf_sizes = true; // Application knows best, disable auto-MFLN sizing
+}
+
+// Small shared cache of auto-MFLN results, keyed by a hash of host:port.
+// frag is the receive buffer size that worked for that server: a small MFLN
+// value, or 16384 when the server didn't honor the MFLN request.
+struct MFLNCacheEntry {
+  uint32_t key;
+  uint16_t frag; // 0 == empty slot
+};
+static constexpr int MFLN_CACHE_ENTRIES = 8;
+static MFLNCacheEntry s_mfln_cache[MFLN_CACHE_ENTRIES];
+static uint8_t s_mfln_cache_next = 0;
+
+uint32_t WiFiClientSecureCtx::_mflnCacheKey(const char *hostName, const IPAddress& ip, uint16_t port) {
+  uint32_t hash = 2166136261u; // FNV-1a
+  if (hostName) {
+    for (const char *p = hostName; *p; p++) {
+      hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+  } else {
+    uint32_t v4 = ip.v4();
+    for (int i = 0; i < 4; i++) {
+      hash = (hash ^ ((v4 >> (8 * i)) & 0xff)) * 16777619u;
+    }
+  }
+  hash = (hash ^ (port & 0xff)) * 16777619u;
+  hash = (hash ^ (port >> 8)) * 16777619u;
+  return hash;
+}
+
+uint16_t WiFiClientSecureCtx::_mflnCacheLookup(uint32_t key) {
+  for (const auto& e : s_mfln_cache) {
+    if (e.frag && e.key == key) {
+      return e.frag;
+    }
+  }
+  return 0;
+}
+
+void WiFiClientSecureCtx::_mflnCacheStore(uint32_t key, uint16_t frag) {
+  for (auto& e : s_mfln_cache) {
+    if (e.frag && e.key == key) {
+      e.frag = frag;
+      return;
+    }
+  }
+  s_mfln_cache[s_mfln_cache_next] = { key, frag };
+  s_mfln_cache_next = (s_mfln_cache_next + 1) % MFLN_CACHE_ENTRIES;
+}
+
+// Shared by the connect() variants: run the SSL handshake, right-sizing the
+// buffers automatically when enabled and the application didn't pick sizes.
+int WiFiClientSecureCtx::_connectSSLAuto(const char *hostName, const IPAddress& ip, uint16_t port) {
+  if (!_use_auto_mfln || _explicit_buf_sizes) {
+    return _connectSSL(hostName);
+  }
+
+  const uint32_t key = _mflnCacheKey(hostName, ip, port);
+  uint16_t frag = _mflnCacheLookup(key);
+  const bool probing = (frag == 0);
+  if (probing) {
+    frag = 1024; // First contact: request MFLN 1024 in the real handshake
+  }
+  _applyBufferSizes(frag, 512);
+
+  if (_connectSSL(hostName)) {
+    if (frag < 16384 && !br_ssl_engine_get_mfln_negotiated(_eng)) {
+      // The server ignored the MFLN request.  The handshake fit in our
+      // small buffer, but a later full-size record would kill the
+      // connection, so redo it with safe buffers instead.
+      DEBUG_BSSL("_connectSSLAuto: server ignored MFLN, using full buffers\n");
+      stop();
+    } else {
+      if (probing) {
+        _mflnCacheStore(key, frag);
+      }
+      return 1;
+    }
+  } else if (_oom_err || frag >= 16384) {
+    return 0; // Not an MFLN-related failure, report it as-is
+  } else {
+    DEBUG_BSSL("_connectSSLAuto: MFLN handshake failed, retrying with full buffers\n");
+  }
+
+  // Graceful fallback: full-size receive buffer, and remember the server
+  _applyBufferSizes(16384, 512);
+  if (!WiFiClient::connect(ip, port)) {
+    DEBUG_BSSL("_connectSSLAuto: Unable to reconnect TCP socket\n");
+    return 0;
+  }
+  if (!_connectSSL(hostName)) {
+    return 0;
+  }
+  _mflnCacheStore(key, 16384);
+  return 1;
+}
+
 bool WiFiClientSecureCtx::stop(unsigned int maxWaitMs) {
   bool ret = WiFiClient::stop(maxWaitMs); // calls our virtual flush()
   // Only if we've already connected, store session params and clear the connection options
@@ -212,20 +364,84 @@ int WiFiClientSecureCtx::connect(IPAddress ip, uint16_t port) {
   if (!WiFiClient::connect(ip, port)) {
     return 0;
   }
-  return _connectSSL(nullptr);
+  return _connectSSLAuto(nullptr, ip, port);
 }
 
 int WiFiClientSecureCtx::connect(const char* name, uint16_t port) {
+  auto& stats = ESP8266WiFiGenericClass::connStats();
+  stats = WiFiConnStats{};
+
   IPAddress remote_addr;
+  const uint32_t dnsStart = ESP.getCycleCount();
   if (!WiFi.hostByName(name, remote_addr)) {
     DEBUG_BSSL("connect: Name lookup failure\n");
     return 0;
   }
+  stats.dnsCycles = ESP.getCycleCount() - dnsStart;
   if (!WiFiClient::connect(remote_addr, port)) {
     DEBUG_BSSL("connect: Unable to connect TCP socket\n");
     return 0;
   }
-  return _connectSSL(name);
+  return _connectSSLAuto(name, remote_addr, port);
+}
+
+int WiFiClientSecureCtx::connectAsync(IPAddress ip, uint16_t port) {
+  if (!WiFiClient::connect(ip, port)) {
+    return 0;
+  }
+  _handshake_pending = _startSSL(nullptr);
+  return _handshake_pending;
+}
+
+int WiFiClientSecureCtx::connectAsync(const char* name, uint16_t port) {
+  IPAddress remote_addr;
+  if (!WiFi.hostByName(name, remote_addr)) {
+    DEBUG_BSSL("connectAsync: Name lookup failure\n");
+    return 0;
+  }
+  if (!WiFiClient::connect(remote_addr, port)) {
+    DEBUG_BSSL("connectAsync: Unable to connect TCP socket\n");
+    return 0;
+  }
+  _handshake_pending = _startSSL(name);
+  return _handshake_pending;
+}
+
+int WiFiClientSecureCtx::connectAsync(const String& host, uint16_t port) {
+  return connectAsync(host.c_str(), port);
+}
+
+bool WiFiClientSecureCtx::handshakeDone() {
+  if (_handshake_done) {
+    return true;
+  }
+  if (!_handshake_pending) {
+    return false;
+  }
+
+  // advance the engine as far as it can go without blocking
+  (void) _run_until(BR_SSL_SENDAPP, false);
+
+  if (!ctx_present() || !_clientConnected()
+      || (br_ssl_engine_current_state(_eng) & BR_SSL_CLOSED)) {
+#ifdef DEBUG_ESP_SSL
+    char err[256];
+    getLastSSLError(err, sizeof(err));
+    DEBUG_BSSL("handshakeDone: handshake failed. Error = '%s'\n", err);
+#endif
+    _handshake_pending = false;
+    _finishHandshake(false);
+    stop();
+    return false;
+  }
+
+  if (br_ssl_engine_current_state(_eng) & BR_SSL_SENDAPP) {
+    _handshake_done = true;
+    _handshake_pending = false;
+    _finishHandshake(true);
+  }
+
+  return _handshake_done;
 }
 
 int WiFiClientSecureCtx::connect(const String& host, uint16_t port) {
@@ -246,6 +462,7 @@ void WiFiClientSecureCtx::_freeSSL() {
   _recvapp_len = 0;
   // This connection is toast
   _handshake_done = false;
+  _handshake_pending = false;
   _timeout = 15000;
 }
 
@@ -485,8 +702,12 @@ int WiFiClientSecureCtx::_run_until(unsigned target, bool blocking) {
 
   esp8266::polledTimeout::oneShotMs loopTimeout(_timeout);
 
+  // a handshake can spin here through several record exchanges and the
+  // CPU-heavy engine calls; slice on budget instead of yielding per pass
+  CooperativeSection slice(1000);
+
   for (int no_work = 0; blocking || no_work < 2;) {
-    optimistic_yield(100);
+    slice.checkpoint();
 
     if (loopTimeout) {
       DEBUG_BSSL("_run_until: Timeout\n");
@@ -1119,8 +1340,8 @@ std::shared_ptr<unsigned char> WiFiClientSecureCtx::_alloc_iobuf(size_t sz)
 
 // Called by connect() to do the actual SSL setup and handshake.
 // Returns if the SSL handshake succeeded.
-bool WiFiClientSecureCtx::_connectSSL(const char* hostName) {
-  DEBUG_BSSL("_connectSSL: start connection\n");
+bool WiFiClientSecureCtx::_startSSL(const char* hostName) {
+  DEBUG_BSSL("_startSSL: start connection\n");
   _freeSSL();
   _oom_err = false;
 
@@ -1153,6 +1374,13 @@ bool WiFiClientSecureCtx::_connectSSL(const char* hostName) {
   } else {
     br_ssl_client_base_init(_sc.get(), _cipher_list.get(), _cipher_cnt);
   }
+#ifndef BEARSSL_SSL_BASIC
+  if (_ec_yield) {
+    // Must be installed before the X509 validator copies the engine's
+    // EC vtable, so chain verification yields as well
+    br_ssl_engine_set_ec(_eng, ec_yielding_impl());
+  }
+#endif
   // Only failure possible in the installation is OOM
   if (!_installClientX509Validator()) {
     _freeSSL();
@@ -1171,7 +1399,9 @@ bool WiFiClientSecureCtx::_connectSSL(const char* hostName) {
 #ifndef BEARSSL_SSL_BASIC
     br_ssl_client_set_single_ec(_sc.get(), _chain ? _chain->getX509Certs() : nullptr, _chain ? _chain->getCount() : 0,
                                 _sk->getEC(), _allowed_usages,
-                                _cert_issuer_key_type, br_ec_get_default(), br_ecdsa_sign_asn1_get_default());
+                                _cert_issuer_key_type,
+                                _ec_yield ? ec_yielding_impl() : br_ec_get_default(),
+                                br_ecdsa_sign_asn1_get_default());
 #else
     _freeSSL();
     DEBUG_BSSL("_connectSSL: Attempting to use EC cert in minimal cipher mode (no EC)\n");
@@ -1184,13 +1414,47 @@ bool WiFiClientSecureCtx::_connectSSL(const char* hostName) {
     br_ssl_engine_set_session_parameters(_eng, _session->getSession());
   }
 
+  // Seed the engine from the core entropy pool in one shot, instead of
+  // having BearSSL gather its entropy one register read at a time.
+  uint8_t entropy[32];
+  ESP.randomBytes(entropy, sizeof(entropy));
+  br_ssl_engine_inject_entropy(_eng, entropy, sizeof(entropy));
+
   if (!br_ssl_client_reset(_sc.get(), hostName, _session?1:0)) {
     _freeSSL();
-    DEBUG_BSSL("_connectSSL: Can't reset client\n");
+    DEBUG_BSSL("_startSSL: Can't reset client\n");
+    return false;
+  }
+
+  return true;
+}
+
+void WiFiClientSecureCtx::_finishHandshake(bool success) {
+  // Session is already validated here, there is no need to keep following
+  _x509_minimal = nullptr;
+  _x509_insecure = nullptr;
+  _x509_knownkey = nullptr;
+
+  // reduce timeout after successful handshake to fail fast if server stop accepting our data for whathever reason
+  if (success) _timeout = 5000;
+}
+
+bool WiFiClientSecureCtx::_connectSSL(const char* hostName) {
+  auto& stats = ESP8266WiFiGenericClass::connStats();
+  const uint32_t handshakeStart = ESP.getCycleCount();
+
+  if (!_startSSL(hostName)) {
     return false;
   }
 
   auto ret = _wait_for_handshake();
+  if (ret) {
+    stats.tlsHandshakeCycles = ESP.getCycleCount() - handshakeStart;
+    // first-byte timing counts from the end of the handshake for a
+    // secure connection
+    stats._connectDoneAt = ESP.getCycleCount();
+    stats._firstBytePending = true;
+  }
 #ifdef DEBUG_ESP_SSL
   if (!ret) {
     char err[256];
@@ -1201,13 +1465,7 @@ bool WiFiClientSecureCtx::_connectSSL(const char* hostName) {
   }
 #endif
 
-  // Session is already validated here, there is no need to keep following
-  _x509_minimal = nullptr;
-  _x509_insecure = nullptr;
-  _x509_knownkey = nullptr;
-
-  // reduce timeout after successful handshake to fail fast if server stop accepting our data for whathever reason
-  if (ret) _timeout = 5000;
+  _finishHandshake(ret);
 
   return ret;
 }
@@ -1280,6 +1538,10 @@ bool WiFiClientSecureCtx::_connectSSLServerRSA(const X509List *chain,
     DEBUG_BSSL("_connectSSLServerRSA: Can't install serverX509check\n");
     return false;
   }
+  // Seed the engine from the core entropy pool, see _connectSSL().
+  uint8_t entropy[32];
+  ESP.randomBytes(entropy, sizeof(entropy));
+  br_ssl_engine_inject_entropy(_eng, entropy, sizeof(entropy));
   if (!br_ssl_server_reset(_sc_svr.get())) {
     _freeSSL();
     DEBUG_BSSL("_connectSSLServerRSA: Can't reset server ctx\n");
@@ -1324,6 +1586,10 @@ bool WiFiClientSecureCtx::_connectSSLServerEC(const X509List *chain,
     DEBUG_BSSL("_connectSSLServerEC: Can't install serverX509check\n");
     return false;
   }
+  // Seed the engine from the core entropy pool, see _connectSSL().
+  uint8_t entropy[32];
+  ESP.randomBytes(entropy, sizeof(entropy));
+  br_ssl_engine_inject_entropy(_eng, entropy, sizeof(entropy));
   if (!br_ssl_server_reset(_sc_svr.get())) {
     _freeSSL();
     DEBUG_BSSL("_connectSSLServerEC: Can't reset server ctx\n");
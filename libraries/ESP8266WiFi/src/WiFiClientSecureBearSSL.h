@@ -50,6 +50,16 @@ class WiFiClientSecureCtx : public WiFiClient {
     int connect(const String& host, uint16_t port) override;
     int connect(const char* name, uint16_t port) override;
 
+    // Non-blocking handshake: connectAsync() performs the TCP connect and
+    // starts the TLS handshake, then each handshakeDone() poll advances the
+    // BearSSL engine as far as it can without blocking.  Returns true once
+    // application data can be sent; on failure it stays false and the
+    // connection is torn down (check with connected()).
+    int connectAsync(IPAddress ip, uint16_t port);
+    int connectAsync(const String& host, uint16_t port);
+    int connectAsync(const char* name, uint16_t port);
+    bool handshakeDone();
+
     uint8_t connected() override;
     size_t write(const uint8_t *buf, size_t size) override;
     size_t write_P(PGM_P buf, size_t size) override;
@@ -111,6 +121,25 @@ class WiFiClientSecureCtx : public WiFiClient {
     // Sets the requested buffer size for transmit and receive
     void setBufferSizes(int recv, int xmit);
 
+    // Automatically right-size the TLS buffers: request MFLN in the real
+    // handshake and fall back to full-size buffers (one reconnect) when the
+    // server doesn't honor it.  The result is cached per host:port, so at
+    // most one extra handshake is ever spent per server.  An explicit
+    // setBufferSizes() call always wins over the automatic sizing.
+    void setAutoMFLN(bool enable = true) {
+      _use_auto_mfln = enable;
+    }
+
+    // Yield to the loop between BearSSL's long EC point multiplications so
+    // scheduled/recurrent functions keep their time slots during a
+    // handshake instead of stalling for its whole duration.  Anything that
+    // runs during the yield executes on the BearSSL thunk stack with
+    // limited headroom (the canary aborts on overflow), so keep such
+    // callbacks small.
+    void setEcProgressYield(bool enable = true) {
+      _ec_yield = enable;
+    }
+
     // Returns whether MFLN negotiation for the above buffer sizes succeeded (after connection)
     int getMFLNStatus() {
       return connected() && br_ssl_engine_get_mfln_negotiated(_eng);
@@ -149,6 +178,8 @@ class WiFiClientSecureCtx : public WiFiClient {
 
   protected:
     bool _connectSSL(const char *hostName); // Do initial SSL handshake
+    bool _startSSL(const char *hostName); // Set up the engine and start the handshake without waiting for it
+    void _finishHandshake(bool success); // Post-handshake cleanup shared by the blocking and async paths
 
   private:
     void _clear();
@@ -171,6 +202,7 @@ class WiFiClientSecureCtx : public WiFiClient {
     int _iobuf_in_size;
     int _iobuf_out_size;
     bool _handshake_done;
+    bool _handshake_pending; // connectAsync() started a handshake still being advanced by handshakeDone()
     bool _oom_err;
 
     // Optional storage space pointer for session parameters
@@ -202,6 +234,16 @@ class WiFiClientSecureCtx : public WiFiClient {
     bool _clientConnected(); // Is the underlying socket alive?
     bool _engineConnected(); // Are both socket and the bearssl engine alive?
 
+    // Automatic MFLN buffer right-sizing (see setAutoMFLN())
+    bool _use_auto_mfln;
+    bool _explicit_buf_sizes;
+    bool _ec_yield; // Cooperative EC slicing (see setEcProgressYield())
+    void _applyBufferSizes(int recv, int xmit);
+    int _connectSSLAuto(const char *hostName, const IPAddress& ip, uint16_t port);
+    static uint32_t _mflnCacheKey(const char *hostName, const IPAddress& ip, uint16_t port);
+    static uint16_t _mflnCacheLookup(uint32_t key);
+    static void _mflnCacheStore(uint32_t key, uint16_t frag);
+
     std::shared_ptr<unsigned char> _alloc_iobuf(size_t sz);
     void _freeSSL();
     int _run_until(unsigned target, bool blocking = true);
@@ -267,6 +309,12 @@ class WiFiClientSecure : public WiFiClient {
     int connect(const String& host, uint16_t port) override { return _ctx->connect(host, port); }
     int connect(const char* name, uint16_t port) override { return _ctx->connect(name, port); }
 
+    // non-blocking handshake (see WiFiClientSecureCtx)
+    int connectAsync(IPAddress ip, uint16_t port) { return _ctx->connectAsync(ip, port); }
+    int connectAsync(const String& host, uint16_t port) { return _ctx->connectAsync(host, port); }
+    int connectAsync(const char* name, uint16_t port) { return _ctx->connectAsync(name, port); }
+    bool handshakeDone() { return _ctx->handshakeDone(); }
+
     uint8_t connected() override { return _ctx->connected(); }
     size_t write(const uint8_t *buf, size_t size) override { return _ctx->write(buf, size); }
     size_t write_P(PGM_P buf, size_t size) override { return _ctx->write_P(buf, size); }
@@ -320,6 +368,8 @@ class WiFiClientSecure : public WiFiClient {
 
     // Sets the requested buffer size for transmit and receive
     void setBufferSizes(int recv, int xmit) { _ctx->setBufferSizes(recv, xmit); }
+    void setAutoMFLN(bool enable = true) { _ctx->setAutoMFLN(enable); }
+    void setEcProgressYield(bool enable = true) { _ctx->setEcProgressYield(enable); }
 
     // Returns whether MFLN negotiation for the above buffer sizes succeeded (after connection)
     int getMFLNStatus() { return _ctx->getMFLNStatus(); }
@@ -118,6 +118,37 @@ size_t WiFiServer::hasClientData() {
     return 0;
 }
 
+size_t WiFiServer::pendingClientCount() {
+    size_t count = 0;
+    for (ClientContext* it = _unclaimed; it; it = it->next()) {
+        count++;
+    }
+    return count;
+}
+
+void WiFiServer::applyClientPolicy(const std::function<bool(WiFiClient&, size_t)>& policy) {
+    if (!policy) {
+        return;
+    }
+    for (WiFiClient* it = WiFiClient::_s_first; it;) {
+        WiFiClient* next = it->_next; // the policy may stop (unlink) the client
+        if (it->localPort() == _port && it->connected()) {
+            if (!policy(*it, it->txQueueDepth())) {
+                it->stop();
+            }
+        }
+        it = next;
+    }
+}
+
+void WiFiServer::setAcceptLimits(size_t maxUnclaimed, bool dropOldest, uint8_t maxPerIP,
+                                 size_t minHeap) {
+    _maxUnclaimed = maxUnclaimed;
+    _dropOldest = dropOldest;
+    _maxPerIP = maxPerIP;
+    _minHeap = minHeap;
+}
+
 bool WiFiServer::hasMaxPendingClients() {
 #if TCP_LISTEN_BACKLOG
     return ((struct tcp_pcb_listen *)_listen_pcb)->accepts_pending >= MAX_PENDING_CLIENTS_PER_PORT;
@@ -177,6 +208,53 @@ err_t WiFiServer::_accept(tcp_pcb* apcb, err_t err) {
     (void) err;
     DEBUGV("WS:ac\r\n");
 
+    // Shedding checks (setAcceptLimits()) run before any allocation: a
+    // refused connection must cost nothing but the RST.
+
+    if (_minHeap && ESP.getFreeHeap() < _minHeap) {
+        DEBUGV("WS:ac shed heap\r\n");
+        tcp_abort(apcb);
+        return ERR_ABRT;
+    }
+
+    if (_maxPerIP) {
+        size_t fromSame = 0;
+        for (ClientContext* it = _unclaimed; it; it = it->next()) {
+            const ip_addr_t* ip = it->getRemoteAddress();
+            if (ip && ip_addr_cmp(ip, &apcb->remote_ip))
+                fromSame++;
+        }
+        for (WiFiClient* it = WiFiClient::_s_first; it; it = it->_next) {
+            const ip_addr_t* ip = it->_client ? it->_client->getRemoteAddress() : nullptr;
+            if (ip && it->localPort() == _port && it->connected()
+                    && ip_addr_cmp(ip, &apcb->remote_ip))
+                fromSame++;
+        }
+        if (fromSame >= _maxPerIP) {
+            DEBUGV("WS:ac shed ip\r\n");
+            tcp_abort(apcb);
+            return ERR_ABRT;
+        }
+    }
+
+    if (_maxUnclaimed && pendingClientCount() >= _maxUnclaimed) {
+        if (_dropOldest) {
+            // drop the head of the queue: during a discovery storm the
+            // oldest waiting connection is the most likely abandoned one
+            ClientContext* oldest = _unclaimed;
+            _unclaimed = oldest->next();
+            DEBUGV("WS:ac shed oldest\r\n");
+            // aborts the connection and frees the context (and its pbufs);
+            // lwIP's abandon path releases the backlog slot itself
+            oldest->ref();
+            oldest->unref();
+        } else {
+            DEBUGV("WS:ac shed full\r\n");
+            tcp_abort(apcb);
+            return ERR_ABRT;
+        }
+    }
+
     // always accept new PCB so incoming data can be stored in our buffers even before
     // user calls ::available()
     ClientContext* client = new ClientContext(apcb, &WiFiServer::_s_discard, this);
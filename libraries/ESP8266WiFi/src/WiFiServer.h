@@ -31,6 +31,7 @@ extern "C" {
 #include <Server.h>
 #include <IPAddress.h>
 #include <lwip/err.h>
+#include <functional>
 
 // lwIP-v2 backlog facility allows to keep memory safe by limiting the
 // maximum number of incoming *pending clients*.  Default number of possibly
@@ -77,6 +78,12 @@ protected:
   ClientContext* _discarded = nullptr;
   enum { _ndDefault, _ndFalse, _ndTrue } _noDelay = _ndDefault;
 
+  // accept-queue shedding (see setAcceptLimits())
+  size_t _maxUnclaimed = 0;
+  bool _dropOldest = true;
+  uint8_t _maxPerIP = 0;
+  size_t _minHeap = 0;
+
 public:
   WiFiServer(const IPAddress& addr, uint16_t port);
   WiFiServer(uint16_t port);
@@ -91,6 +98,30 @@ public:
   // hasMaxPendingClients():
   // returns true if the queue of pending clients is full
   bool hasMaxPendingClients();
+  // pendingClientCount():
+  // returns the number of connections waiting to be accept()ed
+  size_t pendingClientCount();
+  // applyClientPolicy():
+  // fairness sweep over every live client accepted from this server
+  // (matched by local port): the policy is called with each client and its
+  // send-queue depth (see WiFiClient::txQueueDepth()); returning false
+  // stops that client.  Call periodically, e.g. once per second from the
+  // loop, to shed clients whose queues stay full.
+  void applyClientPolicy(const std::function<bool(WiFiClient&, size_t txQueueDepth)>& policy);
+  // setAcceptLimits():
+  // bound worst-case memory under connection floods.  The lwIP backlog
+  // only limits connections lwIP has not yet acknowledged; every
+  // acknowledged one holds a ClientContext (and its pbufs) until the
+  // sketch calls accept().  maxUnclaimed caps that queue (0 = unbounded):
+  // on overflow the oldest queued connection is dropped when dropOldest is
+  // set (keeps the queue fresh during discovery storms), otherwise the
+  // newcomer is refused.  maxPerIP caps connections - queued plus already
+  // accepted on this port - from a single remote address (0 = off).
+  // minHeap refuses newcomers while the free heap is below it (0 = off).
+  // Refused and dropped connections are reset (RST) immediately, unlike
+  // the backlog limit which leaves the server mute until accept().
+  void setAcceptLimits(size_t maxUnclaimed, bool dropOldest = true,
+                       uint8_t maxPerIP = 0, size_t minHeap = 0);
   void begin();
   void begin(uint16_t port);
   void begin(uint16_t port, uint8_t backlog);
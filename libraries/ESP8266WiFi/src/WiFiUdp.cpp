@@ -38,6 +38,7 @@ extern "C"
 #include "lwip/igmp.h"
 #include "lwip/mem.h"
 #include <include/UdpContext.h>
+#include <include/McastGroups.h>
 
 template<>
 WiFiUDP* SList<WiFiUDP>::_s_first = 0;
@@ -91,7 +92,7 @@ uint8_t WiFiUDP::beginMulticast(IPAddress interfaceAddr, IPAddress multicast, ui
         _ctx = 0;
     }
 
-    if (igmp_joingroup(interfaceAddr, multicast)!= ERR_OK) {
+    if (!esp8266::mcast::Groups::join(interfaceAddr, multicast)) {
         return 0;
     }
 
@@ -175,6 +176,22 @@ int WiFiUDP::endPacket()
     return (_ctx->send()) ? 1 : 0;
 }
 
+int WiFiUDP::endPacketQueued()
+{
+    if (!_ctx)
+        return 0;
+
+    return (_ctx->queuePacket()) ? 1 : 0;
+}
+
+size_t WiFiUDP::flushQueuedPackets()
+{
+    if (!_ctx)
+        return 0;
+
+    return _ctx->flushQueued();
+}
+
 size_t WiFiUDP::write(uint8_t byte)
 {
     return write(&byte, 1);
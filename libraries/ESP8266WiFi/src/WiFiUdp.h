@@ -70,6 +70,15 @@ public:
   // Finish off this packet and send it
   // Returns 1 if the packet was sent successfully, 0 if there was an error
   int endPacket() override;
+  // Finish off this packet and queue it for a deferred send; nothing is
+  // handed to the network stack until flushQueuedPackets() runs (or the
+  // bounded queue fills up). Cheaper than endPacket() when sending many
+  // small datagrams back-to-back
+  // Returns 1 if the packet was queued successfully, 0 if there was an error
+  int endPacketQueued();
+  // Send every packet queued with endPacketQueued() in one go
+  // Returns the number of packets sent successfully
+  size_t flushQueuedPackets();
   // Write a single byte into the packet
   size_t write(uint8_t) override;
   // Write size bytes from buffer into the packet
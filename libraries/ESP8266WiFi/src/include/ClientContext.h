@@ -29,9 +29,52 @@ typedef void (*discard_cb_t)(void*, ClientContext*);
 #include <assert.h>
 #include <esp_priv.h>
 #include <coredecls.h>
+#include <include/SharedSendBuffer.h>
+#include <Stream.h>
+#include <Schedule.h>
+#include <memory>
 
 bool getDefaultPrivateGlobalSyncValue ();
 
+#ifndef CLIENT_IOVEC_DEFINED
+#define CLIENT_IOVEC_DEFINED
+// fragment descriptor for scatter-gather writes (WiFiClient::writev()),
+// layout-compatible with POSIX struct iovec
+struct client_iovec {
+    const void* iov_base;
+    size_t      iov_len;
+};
+#endif // CLIENT_IOVEC_DEFINED
+
+#ifndef CLIENT_ASYNC_WRITE_DEFINED
+#define CLIENT_ASYNC_WRITE_DEFINED
+// event reported to the writeAsync() callback (WiFiClient::writeAsync())
+enum class AsyncWriteEvent : uint8_t {
+    PROGRESS,   // more source bytes were handed to lwIP, the peer is reading
+    DONE,       // the requested length has been fully queued
+    CLOSED      // the connection went away before completion
+};
+// invoked from loop() context (scheduled function), never from inside lwIP
+typedef std::function<void(size_t written, AsyncWriteEvent event)> async_write_cb_t;
+#endif // CLIENT_ASYNC_WRITE_DEFINED
+
+#ifndef CLIENT_TCP_TUNING_DEFINED
+#define CLIENT_TCP_TUNING_DEFINED
+// per-socket TCP knobs, see WiFiClient::tune()
+struct TcpTuning {
+    size_t   sndbufLimit;       // cap on un-ACKed queued bytes (0: lwIP default)
+    uint16_t coalesceWindowMs;  // hold small writes up to this long (0: off)
+    uint8_t  pollIntervalTicks; // lwIP poll callback pace, 500ms coarse ticks
+    bool     noDelay;           // disable Nagle
+};
+// canned profiles for the common socket roles
+enum class TcpTuneProfile : uint8_t {
+    BASELINE, // lwIP defaults, Nagle on
+    BULK,     // full sndbuf, Nagle on, small writes batched for 20ms
+    LOWLAT    // Nagle off, un-ACKed queue capped to bound bufferbloat
+};
+#endif // CLIENT_TCP_TUNING_DEFINED
+
 class ClientContext
 {
 public:
@@ -67,11 +110,26 @@ public:
             tcp_abort(_pcb);
             _pcb = nullptr;
         }
+        // tcp_abort() freed the send queue, the shared payloads are no
+        // longer referenced by lwIP
+        _release_shared();
+        _async_stop();
         return ERR_ABRT;
     }
 
     err_t close()
     {
+        _coalesce_flush();
+        if (_pcb && _shared_head) {
+            // Shared broadcast payloads are referenced by the TCP send
+            // queue (no-copy writes); let them drain, and fall back to
+            // abort() when they don't - a graceful close would leave lwIP
+            // pointing into freed memory.
+            wait_until_acked();
+            if (_shared_head) {
+                return abort();
+            }
+        }
         err_t err = ERR_OK;
         if(_pcb) {
             DEBUGV(":close\r\n");
@@ -88,11 +146,16 @@ public:
             }
             _pcb = nullptr;
         }
+        _async_stop();
         return err;
     }
 
     ~ClientContext()
     {
+        _release_shared();
+        _async_stop();
+        _coalesce_token.reset(); // cancels a pending window timer
+        free(_coalesce_buf);
     }
 
     ClientContext* next() const
@@ -126,7 +189,10 @@ public:
         }
     }
 
-    int connect(ip_addr_t* addr, uint16_t port)
+    // Begin a connect without blocking the caller: returns 0 when
+    // tcp_connect() refused outright, 1 while the attempt is in flight.
+    // Poll connecting() for completion, then state() for the outcome.
+    int connectAsync(ip_addr_t* addr, uint16_t port)
     {
         // note: not using `const ip_addr_t* addr` because
         // - `ip6_addr_assign_zone()` below modifies `*addr`
@@ -143,6 +209,20 @@ public:
         }
         _connect_pending = true;
         _op_start_time = millis();
+        return 1;
+    }
+
+    // connect started via connectAsync() still in flight
+    bool connecting() const
+    {
+        return _connect_pending;
+    }
+
+    int connect(ip_addr_t* addr, uint16_t port)
+    {
+        if (!connectAsync(addr, port)) {
+            return 0;
+        }
         // will resume on timeout or when _connected or _notify_error fires
         esp_delay(_timeout_ms, [this]() { return this->_connect_pending; });
         _connect_pending = false;
@@ -163,6 +243,64 @@ public:
         return _pcb? tcp_sndbuf(_pcb): 0;
     }
 
+    // Bytes accepted by write() but not yet acknowledged by the peer,
+    // i.e. the occupied part of the TCP send buffer.  A depth that stays
+    // near TCP_SND_BUF marks a client that can't keep up.
+    size_t txQueueDepth() const
+    {
+        return _pcb? TCP_SND_BUF - tcp_sndbuf(_pcb): 0;
+    }
+
+    // Queue a shared broadcast payload without copying it into this
+    // context (lwIP no-copy write, the buffer outlives the send queue via
+    // its refcount).  All-or-nothing: returns false when the send buffer
+    // can't take the whole payload right now, and the caller should fall
+    // back to a regular write() for this client.
+    bool writeShared(SharedSendBuffer* shared)
+    {
+        if (!_pcb || state() != ESTABLISHED || !shared || !shared->len) {
+            return false;
+        }
+        _coalesce_flush();
+        if (tcp_sndbuf(_pcb) < shared->len) {
+            return false;
+        }
+        SharedSendRef* ref = (SharedSendRef*)malloc(sizeof(SharedSendRef));
+        if (!ref) {
+            return false;
+        }
+        if (tcp_write(_pcb, shared->payload, shared->len, 0) != ERR_OK) {
+            free(ref);
+            return false;
+        }
+        _tx_enqueued += shared->len;
+        shared->ref();
+        ref->buf = shared;
+        ref->end = _tx_enqueued;
+        ref->next = nullptr;
+        if (_shared_tail) {
+            _shared_tail->next = ref;
+        } else {
+            _shared_head = ref;
+        }
+        _shared_tail = ref;
+        tcp_output(_pcb);
+        return true;
+    }
+
+    // Smoothed RTT estimate from lwIP, in milliseconds.  lwIP samples the
+    // RTT in 500ms slow-timer ticks, so the resolution is coarse: 0 means
+    // "faster than one tick" rather than a precise measurement.  Returns
+    // -1 when there is no connection.
+    int rttEstimateMs() const
+    {
+        if (!_pcb) {
+            return -1;
+        }
+        // sa holds the scaled smoothed RTT (srtt * 8) in 500ms ticks
+        return (_pcb->sa >= 0? _pcb->sa >> 3: 0) * 500;
+    }
+
     void setNoDelay(bool nodelay)
     {
         if(!_pcb) {
@@ -183,6 +321,61 @@ public:
         return tcp_nagle_disabled(_pcb);
     }
 
+    // apply a set of per-socket knobs in one go, see TcpTuning and
+    // WiFiClient::tune(); false when the coalescing buffer can't be had
+    bool tune(const TcpTuning& t)
+    {
+        if (!_pcb) {
+            return false;
+        }
+        _sndbuf_limit = t.sndbufLimit;
+        setPollInterval(t.pollIntervalTicks);
+        setNoDelay(t.noDelay);
+        return setCoalescingWindow(t.coalesceWindowMs);
+    }
+
+    // pace of the lwIP poll callback (retries of pending writes and async
+    // transfer refills) in 500ms coarse-timer ticks; the constructor's
+    // default is 1
+    void setPollInterval(uint8_t intervalTicks)
+    {
+        if (_pcb) {
+            tcp_poll(_pcb, &_s_poll, intervalTicks ? intervalTicks : 1);
+        }
+    }
+
+    // batch small writes in a TCP_MSS holding buffer for up to window_ms
+    // before handing them to lwIP: many tiny print()s become one segment
+    // instead of one each (Nagle only coalesces once data is un-ACKed).
+    // 0 flushes and turns the batching off.  Ignored for sync clients -
+    // their write() contract is "ACKed on return".
+    bool setCoalescingWindow(uint16_t window_ms)
+    {
+        if (!window_ms) {
+            _coalesce_flush();
+            free(_coalesce_buf);
+            _coalesce_buf = nullptr;
+            _coalesce_window_ms = 0;
+            return true;
+        }
+        if (!_coalesce_buf) {
+            _coalesce_buf = (char*)malloc(TCP_MSS);
+            if (!_coalesce_buf) {
+                return false;
+            }
+            _coalesce_token = std::make_shared<bool>(true);
+        }
+        _coalesce_window_ms = window_ms;
+        return true;
+    }
+
+    // hand any held small writes to lwIP now (also done by the window
+    // timer, on overflow, and ahead of any other write path)
+    void flushCoalesced()
+    {
+        _coalesce_flush();
+    }
+
     void setTimeout(int timeout_ms)
     {
         _timeout_ms = timeout_ms;
@@ -317,7 +510,9 @@ public:
     {
         // https://github.com/esp8266/Arduino/pull/3967#pullrequestreview-83451496
         // option 1 done
-        // option 2 / _write_some() not necessary since _datasource is always nullptr here
+        // option 2 / _write_some() not necessary since _iov is always nullptr here
+
+        _coalesce_flush();
 
         if (!_pcb)
             return true;
@@ -375,9 +570,91 @@ public:
         if (!_pcb) {
             return 0;
         }
+        if (_coalesce_window_ms && !_sync && dl < TCP_MSS) {
+            if (_coalesce_len + dl > TCP_MSS) {
+                _coalesce_flush();
+            }
+            memcpy(_coalesce_buf + _coalesce_len, ds, dl);
+            _coalesce_len += dl;
+            _coalesce_arm();
+            return dl;
+        }
+        _coalesce_flush(); // keep byte order across the two paths
         return _write_from_source(ds, dl);
     }
 
+    // scatter-gather write: all fragments are queued within a single
+    // tcp_write() pass, with TCP_WRITE_FLAG_MORE keeping lwIP from cutting
+    // a segment at each fragment boundary, so a frame built as
+    // header + payload + trailer in separate buffers goes out without the
+    // caller-side coalescing copy and in as few segments as sndbuf allows
+    size_t writev(const client_iovec* iov, int iovcnt)
+    {
+        if (!_pcb || !iov || iovcnt <= 0) {
+            return 0;
+        }
+        _coalesce_flush();
+        size_t total = 0;
+        for (int i = 0; i < iovcnt; i++) {
+            total += iov[i].iov_len;
+        }
+        if (!total) {
+            return 0;
+        }
+        return _write_from_iov(iov, iovcnt, total);
+    }
+
+    // budgeted non-blocking bulk transfer: len bytes of source are fed to
+    // tcp_write() from the lwIP sent/poll callbacks only, at most slice
+    // bytes per callback, so a multi-megabyte response progresses at ACK
+    // pace without ever suspending loop() the way write() does.  cb (may
+    // be empty) reports PROGRESS/DONE/CLOSED from a scheduled function.
+    // Sources with the peek-buffer API (File, StreamString, ...) are
+    // consumed without an intermediate copy on our side; others go through
+    // a small bounce buffer.  The send queue belongs to the transfer until
+    // DONE/CLOSED or stopAsync(): don't interleave blocking write() calls.
+    bool writeAsync(Stream* source, size_t len, const async_write_cb_t& cb, size_t slice = 0)
+    {
+        if (!_pcb || !source || !len || _async_src || _iov) {
+            return false;
+        }
+        _coalesce_flush();
+        _async_src = source;
+        _async_remaining = len;
+        _async_written = 0;
+        _async_slice = slice ? slice : TCP_SND_BUF;
+        _async_cb = cb;
+        _async_token = std::make_shared<bool>(true);
+        // prime the send buffer; refills then happen on ACK/poll
+        _async_feed();
+        return true;
+    }
+
+    // kick a transfer whose source had run dry (otherwise it only retries
+    // at the poll-callback pace, every ~500ms)
+    void resumeAsync()
+    {
+        _async_feed();
+    }
+
+    // cancel an in-flight transfer; already queued bytes still go out,
+    // pending events are dropped and no callback fires
+    void stopAsync()
+    {
+        _async_stop();
+    }
+
+    bool asyncWriting() const
+    {
+        return _async_src != nullptr;
+    }
+
+    // source bytes handed to lwIP so far by the current transfer
+    size_t asyncWritten() const
+    {
+        return _async_written;
+    }
+
     void keepAlive (uint16_t idle_sec = TCP_DEFAULT_KEEPALIVE_IDLE_SEC, uint16_t intv_sec = TCP_DEFAULT_KEEPALIVE_INTERVAL_SEC, uint8_t count = TCP_DEFAULT_KEEPALIVE_COUNT)
     {
         if (idle_sec && intv_sec && count) {
@@ -422,6 +699,13 @@ public:
 
     // return a pointer to available data buffer (size = peekAvailable())
     // semantic forbids any kind of read() before calling peekConsume()
+    //
+    // zero-copy receive contract:
+    // - the pointer is stable and spans one contiguous pbuf of the receive
+    //   chain; it stays valid until the bytes are consumed
+    // - peekConsume(n) accepts any n <= getSize(), including values crossing
+    //   pbuf boundaries; once a pbuf is fully consumed, the next call to
+    //   peekBuffer()/peekAvailable() exposes the following pbuf of the chain
     const char* peekBuffer ()
     {
         if (!_rx_buf)
@@ -462,10 +746,20 @@ protected:
 
     size_t _write_from_source(const char* ds, const size_t dl)
     {
-        assert(_datasource == nullptr);
+        _single_iov.iov_base = ds;
+        _single_iov.iov_len = dl;
+        return _write_from_iov(&_single_iov, 1, dl);
+    }
+
+    size_t _write_from_iov(const client_iovec* iov, int iovcnt, const size_t total)
+    {
+        assert(_iov == nullptr);
         assert(!_send_waiting);
-        _datasource = ds;
-        _datalen = dl;
+        _iov = iov;
+        _iovcnt = iovcnt;
+        _iov_idx = 0;
+        _iov_off = 0;
+        _datalen = total;
         _written = 0;
         _op_start_time = millis();
         do {
@@ -477,7 +771,8 @@ protected:
                 if (_is_timeout()) {
                     DEBUGV(":wtmo\r\n");
                 }
-                _datasource = nullptr;
+                _iov = nullptr;
+                _iovcnt = 0;
                 _datalen = 0;
                 break;
             }
@@ -496,7 +791,7 @@ protected:
 
     bool _write_some()
     {
-        if (!_datasource || !_pcb) {
+        if (!_iov || !_pcb) {
             return false;
         }
 
@@ -507,11 +802,19 @@ protected:
         while (_written < _datalen) {
             if (state() == CLOSED)
                 return false;
+            const client_iovec& frag = _iov[_iov_idx];
+            const size_t frag_remaining = frag.iov_len - _iov_off;
+            if (!frag_remaining) {
+                // skip empty fragments
+                _iov_idx++;
+                _iov_off = 0;
+                continue;
+            }
             const auto remaining = _datalen - _written;
-            size_t next_chunk_size = std::min((size_t)tcp_sndbuf(_pcb), remaining);
+            size_t next_chunk_size = std::min(_send_room(), frag_remaining);
             if (!next_chunk_size)
                 break;
-            const char* buf = _datasource + _written;
+            const char* buf = (const char*)frag.iov_base + _iov_off;
 
             uint8_t flags = 0;
             if (next_chunk_size < remaining)
@@ -532,6 +835,12 @@ protected:
 
             if (err == ERR_OK) {
                 _written += next_chunk_size;
+                _tx_enqueued += next_chunk_size; // keep shared-payload positions in step
+                _iov_off += next_chunk_size;
+                if (_iov_off == frag.iov_len) {
+                    _iov_idx++;
+                    _iov_off = 0;
+                }
                 has_written = true;
             } else {
                 // ERR_MEM(-1) is a valid error meaning
@@ -558,34 +867,222 @@ protected:
             _send_waiting = false;
             esp_schedule();
         }
+        _async_feed();
+    }
+
+    // feed the async source into lwIP's send queue, at most _async_slice
+    // bytes per call, see writeAsync()
+    void _async_feed()
+    {
+        if (!_async_src || !_pcb || _iov) {
+            // no transfer, or a blocking write owns the send buffer
+            return;
+        }
+        if (state() == CLOSED) {
+            _async_notify(AsyncWriteEvent::CLOSED);
+            _async_stop();
+            return;
+        }
+        size_t budget = _async_slice;
+        bool queued = false;
+        while (_async_remaining && budget) {
+            size_t chunk = std::min(budget, _async_remaining);
+            chunk = std::min(chunk, _send_room());
+            if (!chunk || tcp_sndqueuelen(_pcb) >= TCP_SND_QUEUELEN) {
+                // sndbuf full: the sent callback resumes us
+                break;
+            }
+            // the source buffer is recycled right below, lwIP must copy
+            uint8_t flags = TCP_WRITE_FLAG_COPY;
+            if (chunk < _async_remaining) {
+                flags |= TCP_WRITE_FLAG_MORE; // see _write_some()
+            }
+            if (_async_src->hasPeekBufferAPI()) {
+                size_t avail = _async_src->peekAvailable();
+                if (!avail) {
+                    // source starved: poll retries, or resumeAsync()
+                    break;
+                }
+                chunk = std::min(chunk, avail);
+                if (tcp_write(_pcb, _async_src->peekBuffer(), chunk, flags) != ERR_OK) {
+                    break;
+                }
+                _async_src->peekConsume(chunk);
+            } else {
+                // bounce buffer for sources without the zero-copy API
+                char buf[128];
+                int avail = _async_src->available();
+                if (avail <= 0) {
+                    break;
+                }
+                chunk = std::min(chunk, std::min(sizeof(buf), (size_t)avail));
+                chunk = _async_src->readBytes(buf, chunk);
+                if (!chunk) {
+                    break;
+                }
+                if (tcp_write(_pcb, buf, chunk, flags) != ERR_OK) {
+                    // cannot be unread; sndbuf/queuelen were checked above,
+                    // so this only fires on an lwIP out-of-memory condition
+                    DEBUGV(":awdrop %d\r\n", chunk);
+                    break;
+                }
+            }
+            _async_written += chunk;
+            _tx_enqueued += chunk; // keep shared-payload positions in step
+            _async_remaining -= chunk;
+            budget -= chunk;
+            queued = true;
+        }
+        if (queued) {
+            tcp_output(_pcb);
+        }
+        if (!_async_remaining) {
+            _async_notify(AsyncWriteEvent::DONE);
+            _async_stop();
+        } else if (queued) {
+            _async_notify(AsyncWriteEvent::PROGRESS);
+        }
+    }
+
+    // hand an event to the user from loop() context, not from inside the
+    // lwIP callback we are running in
+    void _async_notify(AsyncWriteEvent event)
+    {
+        if (!_async_cb) {
+            return;
+        }
+        const auto cb = _async_cb;
+        if (event == AsyncWriteEvent::PROGRESS) {
+            // coalesced: one pending event at a time, dropped when the
+            // transfer (or the context) dies before it runs
+            if (_async_progress_pending) {
+                return;
+            }
+            _async_progress_pending = true;
+            std::weak_ptr<bool> alive = _async_token;
+            ClientContext* self = this;
+            schedule_function([alive, self, cb, event]() {
+                if (alive.expired()) {
+                    return;
+                }
+                self->_async_progress_pending = false;
+                cb(self->_async_written, event);
+            });
+        } else {
+            // terminal events are always delivered; holding the token
+            // keeps earlier PROGRESS events (scheduled first) valid too
+            const auto keep = _async_token;
+            const size_t written = _async_written;
+            schedule_function([keep, cb, written, event]() {
+                cb(written, event);
+            });
+        }
+    }
+
+    // effective send-buffer room, honoring the per-socket cap on un-ACKed
+    // bytes (see tune()) so one bulk socket can't hog the pbuf pool
+    size_t _send_room() const
+    {
+        size_t room = tcp_sndbuf(_pcb);
+        if (_sndbuf_limit) {
+            const size_t inflight = _tx_enqueued - _tx_acked;
+            room = std::min(room, inflight < _sndbuf_limit ? _sndbuf_limit - inflight : 0);
+        }
+        return room;
+    }
+
+    // hand held small writes to lwIP, see setCoalescingWindow()
+    void _coalesce_flush()
+    {
+        if (!_coalesce_len) {
+            return;
+        }
+        if (!_pcb) {
+            _coalesce_len = 0;
+            return;
+        }
+        if (_iov) {
+            // a blocking write is in flight (the window timer can fire
+            // from inside its esp_delay): hold the bytes, retry shortly
+            _coalesce_arm();
+            return;
+        }
+        const size_t len = _coalesce_len;
+        _coalesce_len = 0; // before the write: close() re-enters on timeout
+        _write_from_source(_coalesce_buf, len);
+    }
+
+    // one-shot window timer, armed when the holding buffer goes non-empty
+    void _coalesce_arm()
+    {
+        if (_coalesce_armed) {
+            return;
+        }
+        _coalesce_armed = true;
+        std::weak_ptr<bool> alive = _coalesce_token;
+        ClientContext* self = this;
+        schedule_recurrent_function_us([alive, self]() {
+            if (!alive.expired()) {
+                self->_coalesce_armed = false;
+                self->_coalesce_flush();
+            }
+            return false; // one-shot
+        }, (uint32_t)_coalesce_window_ms * 1000);
+    }
+
+    void _async_stop()
+    {
+        _async_src = nullptr;
+        _async_remaining = 0;
+        _async_cb = nullptr;
+        _async_progress_pending = false;
+        _async_token.reset(); // expires not-yet-run scheduled events
     }
 
     err_t _acked(tcp_pcb* pcb, uint16_t len)
     {
         (void) pcb;
-        (void) len;
         DEBUGV(":ack %d\r\n", len);
+        // complete shared broadcast payloads the peer has fully ACKed
+        // (TCP acks in queue order, so comparing positions is enough)
+        _tx_acked += len;
+        while (_shared_head && _tx_acked >= _shared_head->end) {
+            SharedSendRef* done = _shared_head;
+            _shared_head = done->next;
+            if (!_shared_head) {
+                _shared_tail = nullptr;
+            }
+            done->buf->unref(true);
+            free(done);
+        }
         _write_some_from_cb();
         return ERR_OK;
     }
 
     void _consume(size_t size)
     {
-        ptrdiff_t left = _rx_buf->len - _rx_buf_offset - size;
-        if(left > 0) {
-            _rx_buf_offset += size;
-        } else if(!_rx_buf->next) {
-            DEBUGV(":c0 %d, %d\r\n", size, _rx_buf->tot_len);
-            pbuf_free(_rx_buf);
-            _rx_buf = 0;
-            _rx_buf_offset = 0;
-        } else {
-            DEBUGV(":c %d, %d, %d\r\n", size, _rx_buf->len, _rx_buf->tot_len);
-            auto head = _rx_buf;
-            _rx_buf = _rx_buf->next;
-            _rx_buf_offset = 0;
-            pbuf_ref(_rx_buf);
-            pbuf_free(head);
+        // may span several pbufs of the receive chain (see peekConsume())
+        size_t left = size;
+        while (_rx_buf && left) {
+            size_t chunk = _rx_buf->len - _rx_buf_offset;
+            if (left < chunk) {
+                _rx_buf_offset += left;
+                left = 0;
+            } else if (!_rx_buf->next) {
+                DEBUGV(":c0 %d, %d\r\n", size, _rx_buf->tot_len);
+                left -= chunk;
+                pbuf_free(_rx_buf);
+                _rx_buf = 0;
+                _rx_buf_offset = 0;
+            } else {
+                DEBUGV(":c %d, %d, %d\r\n", size, _rx_buf->len, _rx_buf->tot_len);
+                left -= chunk;
+                auto head = _rx_buf;
+                _rx_buf = _rx_buf->next;
+                _rx_buf_offset = 0;
+                pbuf_ref(_rx_buf);
+                pbuf_free(head);
+            }
         }
         if(_pcb)
             tcp_recved(_pcb, size);
@@ -628,12 +1125,18 @@ protected:
     void _error(err_t err)
     {
         (void) err;
-        DEBUGV(":er %d 0x%08x\r\n", (int) err, (uint32_t) _datasource);
+        DEBUGV(":er %d 0x%08x\r\n", (int) err, (uint32_t) _iov);
         tcp_arg(_pcb, NULL);
         tcp_sent(_pcb, NULL);
         tcp_recv(_pcb, NULL);
         tcp_err(_pcb, NULL);
         _pcb = nullptr;
+        // lwIP freed the pcb and its queue, drop the subscriber references
+        _release_shared();
+        if (_async_src) {
+            _async_notify(AsyncWriteEvent::CLOSED);
+            _async_stop();
+        }
         _notify_error();
     }
 
@@ -682,26 +1185,92 @@ protected:
     }
 
 private:
+    // Hot fields first: read()/peek() touch _pcb, _rx_buf and
+    // _rx_buf_offset on every call, write() additionally _datalen,
+    // _written and the ACK counters.  Keeping them together lets the
+    // common paths stay within the first 32-byte cache line of the
+    // object (see _layout_check() below).
     tcp_pcb* _pcb;
 
     pbuf* _rx_buf;
     size_t _rx_buf_offset;
 
-    discard_cb_t _discard_cb;
-    void* _discard_cb_arg;
-
-    const char* _datasource = nullptr;
     size_t _datalen = 0;
     size_t _written = 0;
-    uint32_t _timeout_ms = 5000;
+    size_t _tx_enqueued = 0; // bytes accepted by tcp_write() on this pcb
+    size_t _tx_acked = 0;    // bytes ACKed by the peer
+
+    // in-flight (vectored) write state, see _write_from_iov()
+    const client_iovec* _iov = nullptr;
+    int _iovcnt = 0;
+    int _iov_idx = 0;
+    size_t _iov_off = 0;
+    client_iovec _single_iov = { nullptr, 0 };
     uint32_t _op_start_time = 0;
     bool _send_waiting = false;
     bool _connect_pending = false;
 
+    // cold configuration, only consulted on timeouts and teardown
+    uint32_t _timeout_ms = 5000;
+    discard_cb_t _discard_cb;
+    void* _discard_cb_arg;
+
+    // non-blocking bulk-transfer state, see writeAsync()
+    Stream* _async_src = nullptr;
+    size_t _async_remaining = 0;
+    size_t _async_written = 0;
+    size_t _async_slice = 0;
+    async_write_cb_t _async_cb;
+    std::shared_ptr<bool> _async_token; // expires scheduled events on stop
+    bool _async_progress_pending = false;
+
+    // per-socket tuning state, see tune()
+    size_t _sndbuf_limit = 0;
+    char* _coalesce_buf = nullptr;   // TCP_MSS holding buffer for small writes
+    size_t _coalesce_len = 0;
+    uint16_t _coalesce_window_ms = 0;
+    bool _coalesce_armed = false;
+    std::shared_ptr<bool> _coalesce_token; // expires the window timer
+
+    // in-order accounting of shared (no-copy) broadcast payloads waiting
+    // for their ACK, see writeShared()/_acked()
+    struct SharedSendRef {
+        SharedSendBuffer* buf;
+        size_t end; // value of _tx_acked once this payload is fully ACKed
+        SharedSendRef* next;
+    };
+
+    // drop all outstanding subscriber references (connection went away
+    // before the payloads were acknowledged)
+    void _release_shared()
+    {
+        while (_shared_head) {
+            SharedSendRef* it = _shared_head;
+            _shared_head = it->next;
+            it->buf->unref(false);
+            free(it);
+        }
+        _shared_tail = nullptr;
+    }
+
+    SharedSendRef* _shared_head = nullptr;
+    SharedSendRef* _shared_tail = nullptr;
+
     int8_t _refcnt;
     ClientContext* _next;
 
     bool _sync;
+
+    // Layout guard: the hot read()/write() fields grouped at the top of
+    // the member block must fit the first 32-byte cache line on the
+    // 32-bit target; inert on 64-bit hosts where pointers are wider.
+    static void _layout_check()
+    {
+        static_assert(sizeof(void*) != 4
+            || (offsetof(ClientContext, _pcb) == 0
+                && offsetof(ClientContext, _tx_acked) + sizeof(size_t) <= 32),
+            "hot ClientContext fields spill past one cache line");
+    }
 };
 
 #endif//CLIENTCONTEXT_H
@@ -0,0 +1,172 @@
+/*
+    NetNameResponder.h - shared core for UDP name-resolution responders
+    (LLMNR, NetBIOS) announcing the device hostname.
+
+    Each responder used to keep its own copy of the hostname and its own UDP
+    plumbing. This header holds the pieces they have in common: one hostname
+    registration shared by all protocols, and a thin wrapper around the
+    zero-copy UdpContext receive path, so the per-protocol libraries only
+    contain the actual packet formats.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef NETNAMERESPONDER_H
+#define NETNAMERESPONDER_H
+
+#include <IPAddress.h>
+#include <lwip/udp.h>
+#include <lwip/igmp.h>
+#include <include/UdpContext.h>
+#include <include/McastGroups.h>
+#include <string.h>
+
+namespace esp8266
+{
+namespace netname
+{
+
+// Maximum length of a single DNS label, which is also the longest name any
+// of the responders can announce.
+constexpr uint8_t MAX_LABEL_LENGTH = 63;
+
+// The hostname announced by all discovery responders, registered once.
+// Lookups compare case-insensitively, so no per-protocol case-folded copy
+// of the name needs to be kept.
+class Registry
+{
+public:
+    // Register the hostname. Returns false if the name does not fit in a
+    // single DNS label. Protocols with stricter limits (NetBIOS) validate
+    // the length themselves on begin().
+    static bool set(const char* hostname)
+    {
+        const size_t n = strlen(hostname);
+        if (n > MAX_LABEL_LENGTH)
+            return false;
+        memcpy(s_hostname, hostname, n);
+        s_hostname[n] = '\0';
+        s_length = n;
+        return true;
+    }
+
+    static const char* hostname()
+    {
+        return s_hostname;
+    }
+
+    static uint8_t length()
+    {
+        return s_length;
+    }
+
+    static bool matches(const char* name)
+    {
+        return s_length && strcasecmp(name, s_hostname) == 0;
+    }
+
+private:
+    static inline char s_hostname[MAX_LABEL_LENGTH + 1] = { 0 };
+    static inline uint8_t s_length = 0;
+};
+
+// Shared UDP listener plumbing. The handler runs from the UdpContext receive
+// callback (tcp stack context), with the packet still in the lwIP pbuf chain,
+// and reads it through the context without an intermediate buffer copy.
+class UdpListener
+{
+public:
+    UdpListener() :
+        _conn(nullptr)
+    {
+    }
+
+    ~UdpListener()
+    {
+        end();
+    }
+
+    UdpListener(const UdpListener&) = delete;
+    UdpListener& operator=(const UdpListener&) = delete;
+
+    // Listen for unicast datagrams on the given port.
+    bool begin(uint16_t port, const UdpContext::rxhandler_t& handler)
+    {
+        end();
+        _conn = new (std::nothrow) UdpContext;
+        if (!_conn)
+            return false;
+        _conn->ref();
+        if (!_conn->listen(IP_ADDR_ANY, port))
+        {
+            end();
+            return false;
+        }
+        _conn->onRx(handler);
+        return true;
+    }
+
+    // As begin(), additionally joining the given multicast group. The
+    // membership is counted (see McastGroups.h) and released in end(), so
+    // responders restarting on every reconnect no longer pile up joins.
+    bool beginMulticast(uint16_t port, const IPAddress& group, int ttl, const UdpContext::rxhandler_t& handler)
+    {
+        end();
+        if (!mcast::Groups::join(IPAddress(), group))
+            return false;
+        _group = group;
+        _conn = new (std::nothrow) UdpContext;
+        if (!_conn)
+            return false;
+        _conn->ref();
+        if (!_conn->listen(IP_ADDR_ANY, port))
+        {
+            end();
+            return false;
+        }
+        _conn->setMulticastTTL(ttl);
+        _conn->onRx(handler);
+        _conn->connect(group, port);
+        return true;
+    }
+
+    void end()
+    {
+        if (_group.isSet())
+        {
+            mcast::Groups::leave(IPAddress(), _group);
+            _group = IPAddress();
+        }
+        if (_conn)
+        {
+            _conn->unref();
+            _conn = nullptr;
+        }
+    }
+
+    UdpContext* context() const
+    {
+        return _conn;
+    }
+
+private:
+    UdpContext* _conn;
+    IPAddress _group;
+};
+
+} // namespace netname
+} // namespace esp8266
+
+#endif // NETNAMERESPONDER_H
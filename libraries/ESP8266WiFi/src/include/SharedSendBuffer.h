@@ -0,0 +1,99 @@
+/*
+  SharedSendBuffer.h - reference-counted broadcast payload for the
+  ESP8266WiFi library.
+  Copyright (c) 2020 esp8266 Arduino core contributors
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef SHAREDSENDBUFFER_H
+#define SHAREDSENDBUFFER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// One shared copy of a payload fanned out to several TCP connections (see
+// WiFiClient::writeShared() and the ArduinoWiFiServer broadcast path).  The
+// bytes are handed to lwIP with the no-copy write flag, so this single copy
+// must stay alive until every subscriber has ACKed it: each successfully
+// queued subscriber holds a reference, dropped from its ACK or error path.
+// The creator holds the initial reference and gives it up with release()
+// once fan-out is done.  When the last reference goes, done_cb (if set)
+// reports how many subscribers ACKed the whole payload and how many dropped
+// out (connection error or close before the ACK).
+struct SharedSendBuffer
+{
+    typedef void (*done_cb_t)(void* arg, uint8_t ackedCount, uint8_t droppedCount);
+
+    static SharedSendBuffer* create(const uint8_t* data, size_t len)
+    {
+        SharedSendBuffer* b = (SharedSendBuffer*)malloc(sizeof(SharedSendBuffer) + len);
+        if (b) {
+            b->refcnt = 1; // the creator's reference, see release()
+            b->ackedCount = 0;
+            b->droppedCount = 0;
+            b->done_cb = nullptr;
+            b->done_cb_arg = nullptr;
+            b->len = len;
+            memcpy(b->payload, data, len);
+        }
+        return b;
+    }
+
+    void ref()
+    {
+        ++refcnt;
+    }
+
+    // Drop a subscriber's reference; acked tells whether the whole payload
+    // was acknowledged by that peer
+    void unref(bool acked)
+    {
+        if (acked) {
+            ++ackedCount;
+        } else {
+            ++droppedCount;
+        }
+        release();
+    }
+
+    // Drop the creator's reference (doesn't count as a subscriber outcome)
+    void release()
+    {
+        if (--refcnt == 0) {
+            if (done_cb) {
+                done_cb(done_cb_arg, ackedCount, droppedCount);
+            }
+            free(this);
+        }
+    }
+
+    void onDone(done_cb_t cb, void* arg)
+    {
+        done_cb = cb;
+        done_cb_arg = arg;
+    }
+
+    uint8_t refcnt;
+    uint8_t ackedCount;
+    uint8_t droppedCount;
+    done_cb_t done_cb;
+    void* done_cb_arg;
+    size_t len;
+    uint8_t payload[];
+};
+
+#endif // SHAREDSENDBUFFER_H
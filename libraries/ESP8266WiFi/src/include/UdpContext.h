@@ -42,6 +42,12 @@ public:
 
     typedef std::function<void(void)> rxhandler_t;
 
+    // zero-copy receive: handler gets the datagram pbuf as delivered by
+    // lwIP, payload accessible in place. Return true when consumed (the
+    // datagram then never enters the rx buffering chain), false to fall
+    // back to the buffered parsePacket()/read() path.
+    typedef std::function<bool(pbuf* pb, const ip_addr_t* srcaddr, uint16_t srcport)> rawrxhandler_t;
+
     UdpContext()
     : _pcb(0)
     , _rx_buf(0)
@@ -52,6 +58,9 @@ public:
     , _tx_buf_head(0)
     , _tx_buf_cur(0)
     , _tx_buf_offset(0)
+    , _tx_queue_head(0)
+    , _tx_queue_tail(0)
+    , _tx_queue_len(0)
     {
         _pcb = udp_new();
 #ifdef LWIP_MAYBE_XCC
@@ -77,6 +86,15 @@ public:
             _rx_buf_offset = 0;
             _rx_buf_size = 0;
         }
+        while (_tx_queue_head)
+        {
+            QueuedPacket* qp = _tx_queue_head;
+            _tx_queue_head = qp->next;
+            pbuf_free(qp->pb);
+            delete qp;
+        }
+        _tx_queue_tail = 0;
+        _tx_queue_len = 0;
     }
 
     void ref()
@@ -182,6 +200,16 @@ public:
         _on_rx = handler;
     }
 
+    // Deliver incoming datagrams straight from the lwIP callback with
+    // in-place payload access, skipping the per-socket pbuf chain and
+    // the copy through read(). A handler wanting to keep the pbuf past
+    // the call must pbuf_ref() it; several consumers can share the same
+    // datagram that way, the last pbuf_free() releases it.
+    // Same warning as onRx(): runs in tcp stack context.
+    void onRawRx(rawrxhandler_t handler) {
+        _on_raw_rx = handler;
+    }
+
 #ifdef DEBUG_ESP_CORE
     // this helper is ready to be used when debugging UDP
     void printChain (const pbuf* pb, const char* msg, size_t n) const
@@ -405,6 +433,83 @@ public:
         return trySend(addr, port, /* don't keep buffer */false) == ERR_OK;
     }
 
+    // Finish the packet being built and queue it instead of sending:
+    // the datagram is coalesced into its own pbuf together with its
+    // destination, and the staging chain is kept allocated for the next
+    // packet. Nothing is handed to lwIP until flushQueued(); when the
+    // queue is full it is flushed first, so this stays bounded.
+    bool queuePacket(const ip_addr_t* addr = 0, uint16_t port = 0)
+    {
+        if (_tx_queue_len >= txQueueMaxDepth)
+            flushQueued();
+
+        size_t data_size = _tx_buf_offset;
+        pbuf* tx_copy = pbuf_alloc(PBUF_TRANSPORT, data_size, PBUF_RAM);
+        if (!tx_copy)
+        {
+            DEBUGV("failed pbuf_alloc");
+            cancelBuffer();
+            return false;
+        }
+        uint8_t* dst = reinterpret_cast<uint8_t*>(tx_copy->payload);
+        for (pbuf* p = _tx_buf_head; p; p = p->next) {
+            size_t will_copy = (data_size < p->len) ? data_size : p->len;
+            memcpy(dst, p->payload, will_copy);
+            dst += will_copy;
+            data_size -= will_copy;
+        }
+
+        QueuedPacket* qp = new (std::nothrow) QueuedPacket;
+        if (!qp)
+        {
+            pbuf_free(tx_copy);
+            cancelBuffer();
+            return false;
+        }
+        if (!addr) {
+            addr = &_pcb->remote_ip;
+            port = _pcb->remote_port;
+        }
+        qp->next = 0;
+        qp->pb = tx_copy;
+        ip_addr_copy(qp->addr, *addr);
+        qp->port = port;
+
+        if (_tx_queue_tail)
+            _tx_queue_tail->next = qp;
+        else
+            _tx_queue_head = qp;
+        _tx_queue_tail = qp;
+        ++_tx_queue_len;
+
+        // keep the staging chain allocated for the next packet
+        _tx_buf_cur = _tx_buf_head;
+        _tx_buf_offset = 0;
+        return true;
+    }
+
+    // Hand all queued datagrams to lwIP back-to-back, in queue order.
+    // Returns the number of datagrams accepted by udp_sendto().
+    size_t flushQueued()
+    {
+        size_t sent = 0;
+        while (_tx_queue_head)
+        {
+            QueuedPacket* qp = _tx_queue_head;
+            _tx_queue_head = qp->next;
+            err_t err = udp_sendto(_pcb, qp->pb, &qp->addr, qp->port);
+            if (err == ERR_OK)
+                ++sent;
+            else
+                DEBUGV(":ust rc=%d\r\n", (int) err);
+            pbuf_free(qp->pb);
+            delete qp;
+            --_tx_queue_len;
+        }
+        _tx_queue_tail = 0;
+        return sent;
+    }
+
     bool sendTimeout(const ip_addr_t* addr, uint16_t port,
                      esp8266::polledTimeout::oneShotFastMs::timeType timeoutMs)
     {
@@ -513,6 +618,19 @@ private:
             const ip_addr_t *srcaddr, u16_t srcport)
     {
         (void) upcb;
+
+        if (_on_raw_rx)
+        {
+            // zero-copy dispatch: no chaining, no copy, the consumer
+            // reads the payload in place (and may pbuf_ref() to keep it)
+            if (_on_raw_rx(pb, srcaddr, srcport))
+            {
+                pbuf_free(pb);
+                return;
+            }
+            // not consumed: fall through to the buffered path
+        }
+
         // check receive pbuf chain depth
         // optimization path: cache the pbuf chain length
         {
@@ -599,7 +717,18 @@ private:
     pbuf* _tx_buf_head;
     pbuf* _tx_buf_cur;
     size_t _tx_buf_offset;
+    struct QueuedPacket
+    {
+        QueuedPacket* next;
+        pbuf* pb;
+        ip_addr_t addr;
+        uint16_t port;
+    };
+    QueuedPacket* _tx_queue_head;
+    QueuedPacket* _tx_queue_tail;
+    size_t _tx_queue_len;
     rxhandler_t _on_rx;
+    rawrxhandler_t _on_raw_rx;
 #ifdef LWIP_MAYBE_XCC
     uint16_t _mcast_ttl;
 #endif
@@ -618,6 +747,10 @@ private:
     // rx pbuf depth barrier (counter of buffered UDP received packets)
     // keep it small
     static constexpr int rxBufMaxDepth = 4;
+
+    // tx queue depth barrier (counter of datagrams queued for a deferred
+    // send), flushed automatically when reached
+    static constexpr size_t txQueueMaxDepth = 8;
 };
 
 
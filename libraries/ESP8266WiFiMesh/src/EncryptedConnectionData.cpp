@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "EncryptedConnectionData.h"
 #include "UtilityFunctions.h"
 #include "TypeConversionFunctions.h"
@@ -184,3 +186,5 @@ void EncryptedConnectionData::removeDuration()
 {
   _timeTracker = nullptr;
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
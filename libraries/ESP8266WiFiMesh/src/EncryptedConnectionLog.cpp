@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "EncryptedConnectionLog.h"
 
 namespace
@@ -93,3 +95,5 @@ void EncryptedConnectionLog::clearSoonestExpiringConnectionTracker()
 {
   _soonestExpiringConnectionTracker = nullptr;
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
@@ -14,6 +14,8 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include <ESP8266WiFi.h>
 extern "C" {
   #include <espnow.h>
@@ -583,3 +585,5 @@ uint64_t EspnowConnectionManager::generateMessageID(const EncryptedConnectionLog
 
   return _unsynchronizedMessageID++;
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
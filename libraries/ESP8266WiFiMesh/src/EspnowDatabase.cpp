@@ -14,6 +14,8 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "EspnowDatabase.h"
 #include "EspnowMeshBackend.h"
 #include "UtilityFunctions.h"
@@ -41,9 +43,18 @@ namespace
   std::list<ResponseData> _responsesToSend = {};
   std::list<PeerRequestLog> _peerRequestConfirmationsToSend = {};
 
-  std::map<std::pair<macAndType_td, messageID_td>, MessageData> _receivedEspnowTransmissions = {};
-  std::map<std::pair<peerMac_td, messageID_td>, RequestData> _sentRequests = {};
-  std::map<std::pair<peerMac_td, messageID_td>, TimeTracker> _receivedRequests = {};
+  EspnowDatabase::receivedTransmissionsMap_td _receivedEspnowTransmissions = {};
+  EspnowDatabase::sentRequestsMap_td _sentRequests = {};
+  EspnowDatabase::receivedRequestsMap_td _receivedRequests = {};
+
+  // Absolute millis() values before which the corresponding log container cannot contain an expired
+  // entry, updated by each expiry sweep. Lets clearOldLogEntries skip a container in O(1) instead of
+  // iterating all its entries on every maintenance pass. 0 means a sweep is due immediately.
+  uint32_t _receivedTransmissionsNextSweep = 0;
+  uint32_t _receivedRequestsNextSweep = 0;
+  uint32_t _sentRequestsNextSweep = 0;
+  uint32_t _responsesToSendNextSweep = 0;
+  uint32_t _peerRequestConfirmationsNextSweep = 0;
 
   std::shared_ptr<bool> _espnowConnectionQueueMutex = std::make_shared<bool>(false);
   std::shared_ptr<bool> _responsesToSendMutex = std::make_shared<bool>(false);
@@ -93,72 +104,108 @@ uint32_t EspnowDatabase::criticalHeapLevel()
 }
 
 template <typename T, typename U>
-void EspnowDatabase::deleteExpiredLogEntries(std::map<std::pair<U, uint64_t>, T> &logEntries, const uint32_t maxEntryLifetimeMs)
+uint32_t EspnowDatabase::deleteExpiredLogEntries(std::unordered_map<std::pair<U, uint64_t>, T, LogKeyHash> &logEntries, const uint32_t maxEntryLifetimeMs)
 {
-  for(typename std::map<std::pair<U, uint64_t>, T>::iterator entryIterator = logEntries.begin(); 
+  uint32_t timeUntilNextExpiry = maxEntryLifetimeMs;
+
+  for(typename std::unordered_map<std::pair<U, uint64_t>, T, LogKeyHash>::iterator entryIterator = logEntries.begin();
       entryIterator != logEntries.end(); )
   {
-    if(entryIterator->second.getTimeTracker().timeSinceCreation() > maxEntryLifetimeMs)
+    uint32_t timeSinceCreation = entryIterator->second.getTimeTracker().timeSinceCreation();
+
+    if(timeSinceCreation > maxEntryLifetimeMs)
     {
       entryIterator = logEntries.erase(entryIterator);
     }
     else
+    {
+      timeUntilNextExpiry = std::min(timeUntilNextExpiry, maxEntryLifetimeMs - timeSinceCreation);
       ++entryIterator;
+    }
   }
+
+  return timeUntilNextExpiry;
 }
 
 template <typename U>
-void EspnowDatabase::deleteExpiredLogEntries(std::map<std::pair<U, uint64_t>, TimeTracker> &logEntries, const uint32_t maxEntryLifetimeMs)
+uint32_t EspnowDatabase::deleteExpiredLogEntries(std::unordered_map<std::pair<U, uint64_t>, TimeTracker, LogKeyHash> &logEntries, const uint32_t maxEntryLifetimeMs)
 {
-  for(typename std::map<std::pair<U, uint64_t>, TimeTracker>::iterator entryIterator = logEntries.begin(); 
+  uint32_t timeUntilNextExpiry = maxEntryLifetimeMs;
+
+  for(typename std::unordered_map<std::pair<U, uint64_t>, TimeTracker, LogKeyHash>::iterator entryIterator = logEntries.begin();
       entryIterator != logEntries.end(); )
   {
-    if(entryIterator->second.timeSinceCreation() > maxEntryLifetimeMs)
+    uint32_t timeSinceCreation = entryIterator->second.timeSinceCreation();
+
+    if(timeSinceCreation > maxEntryLifetimeMs)
     {
       entryIterator = logEntries.erase(entryIterator);
     }
     else
+    {
+      timeUntilNextExpiry = std::min(timeUntilNextExpiry, maxEntryLifetimeMs - timeSinceCreation);
       ++entryIterator;
+    }
   }
+
+  return timeUntilNextExpiry;
 }
 
-void EspnowDatabase::deleteExpiredLogEntries(std::map<std::pair<peerMac_td, messageID_td>, RequestData> &logEntries, const uint32_t requestLifetimeMs, const uint32_t broadcastLifetimeMs)
+uint32_t EspnowDatabase::deleteExpiredLogEntries(sentRequestsMap_td &logEntries, const uint32_t requestLifetimeMs, const uint32_t broadcastLifetimeMs)
 {
-  for(typename std::map<std::pair<peerMac_td, messageID_td>, RequestData>::iterator entryIterator = logEntries.begin(); 
+  uint32_t timeUntilNextExpiry = std::min(requestLifetimeMs, broadcastLifetimeMs);
+
+  for(typename sentRequestsMap_td::iterator entryIterator = logEntries.begin();
       entryIterator != logEntries.end(); )
   {
     bool broadcast = entryIterator->first.first == EspnowProtocolInterpreter::uint64BroadcastMac;
+    uint32_t lifetimeMs = broadcast ? broadcastLifetimeMs : requestLifetimeMs;
     uint32_t timeSinceCreation = entryIterator->second.getTimeTracker().timeSinceCreation();
-    
-    if((!broadcast && timeSinceCreation > requestLifetimeMs) 
-        || (broadcast && timeSinceCreation > broadcastLifetimeMs))
+
+    if(timeSinceCreation > lifetimeMs)
     {
       entryIterator = logEntries.erase(entryIterator);
     }
     else
+    {
+      timeUntilNextExpiry = std::min(timeUntilNextExpiry, lifetimeMs - timeSinceCreation);
       ++entryIterator;
+    }
   }
+
+  return timeUntilNextExpiry;
 }
 
 template <typename T>
-void EspnowDatabase::deleteExpiredLogEntries(std::list<T> &logEntries, const uint32_t maxEntryLifetimeMs)
+uint32_t EspnowDatabase::deleteExpiredLogEntries(std::list<T> &logEntries, const uint32_t maxEntryLifetimeMs)
 {
-  for(typename std::list<T>::iterator entryIterator = logEntries.begin(); 
+  uint32_t timeUntilNextExpiry = maxEntryLifetimeMs;
+
+  for(typename std::list<T>::iterator entryIterator = logEntries.begin();
       entryIterator != logEntries.end(); )
   {
-    if(entryIterator->getTimeTracker().timeSinceCreation() > maxEntryLifetimeMs)
+    uint32_t timeSinceCreation = entryIterator->getTimeTracker().timeSinceCreation();
+
+    if(timeSinceCreation > maxEntryLifetimeMs)
     {
       entryIterator = logEntries.erase(entryIterator);
     }
     else
+    {
+      timeUntilNextExpiry = std::min(timeUntilNextExpiry, maxEntryLifetimeMs - timeSinceCreation);
       ++entryIterator;
+    }
   }
+
+  return timeUntilNextExpiry;
 }
 
-template <> 
-void EspnowDatabase::deleteExpiredLogEntries(std::list<PeerRequestLog> &logEntries, const uint32_t maxEntryLifetimeMs)
+template <>
+uint32_t EspnowDatabase::deleteExpiredLogEntries(std::list<PeerRequestLog> &logEntries, const uint32_t maxEntryLifetimeMs)
 {
-  for(typename std::list<PeerRequestLog>::iterator entryIterator = logEntries.begin(); 
+  uint32_t timeUntilNextExpiry = maxEntryLifetimeMs;
+
+  for(typename std::list<PeerRequestLog>::iterator entryIterator = logEntries.begin();
     entryIterator != logEntries.end(); )
   {
     auto timeTrackerPointer = entryIterator->temporary();
@@ -167,19 +214,33 @@ void EspnowDatabase::deleteExpiredLogEntries(std::list<PeerRequestLog> &logEntri
       entryIterator = logEntries.erase(entryIterator);
     }
     else
+    {
+      if(timeTrackerPointer)
+        timeUntilNextExpiry = std::min(timeUntilNextExpiry, maxEntryLifetimeMs - (uint32_t)timeTrackerPointer->elapsedTime());
+
       ++entryIterator;
+    }
   }
+
+  return timeUntilNextExpiry;
 }
 
 void EspnowDatabase::setLogEntryLifetimeMs(const uint32_t logEntryLifetimeMs)
 {
   _logEntryLifetimeMs = logEntryLifetimeMs;
+
+  // A shorter lifetime may make stored entries expire earlier than the cached sweep deadlines assume.
+  _receivedTransmissionsNextSweep = 0;
+  _receivedRequestsNextSweep = 0;
+  _sentRequestsNextSweep = 0;
+  _responsesToSendNextSweep = 0;
 }
 uint32_t EspnowDatabase::logEntryLifetimeMs() { return _logEntryLifetimeMs; }
 
 void EspnowDatabase::setBroadcastResponseTimeoutMs(const uint32_t broadcastResponseTimeoutMs)
 {
   _broadcastResponseTimeoutMs = broadcastResponseTimeoutMs;
+  _sentRequestsNextSweep = 0;
 }
 uint32_t EspnowDatabase::broadcastResponseTimeoutMs() { return _broadcastResponseTimeoutMs; }
 
@@ -229,6 +290,7 @@ void EspnowDatabase::deleteScheduledResponsesByRecipient(const uint8_t *recipien
 void EspnowDatabase::setEncryptionRequestTimeout(const uint32_t timeoutMs)
 {
   _encryptionRequestTimeoutMs = timeoutMs;
+  _peerRequestConfirmationsNextSweep = 0;
 }
 uint32_t EspnowDatabase::getEncryptionRequestTimeout() {return _encryptionRequestTimeoutMs;}
 
@@ -264,12 +326,25 @@ void EspnowDatabase::clearOldLogEntries(bool forced)
   }
   
   _logClearingCooldown.reset();
-  
-  deleteExpiredLogEntries(receivedEspnowTransmissions(), logEntryLifetimeMs());
-  deleteExpiredLogEntries(receivedRequests(), logEntryLifetimeMs()); // Just needs to be long enough to not accept repeated transmissions by mistake.
-  deleteExpiredLogEntries(sentRequests(), logEntryLifetimeMs(), broadcastResponseTimeoutMs());
-  deleteExpiredLogEntries(responsesToSend(), logEntryLifetimeMs());
-  deleteExpiredLogEntries(peerRequestConfirmationsToSend(), getEncryptionRequestTimeout());
+
+  // Each container remembers when its next entry can expire at the earliest, so most passes skip
+  // the sweeps entirely. Entries added after a sweep always expire later than that sweep's deadline.
+  uint32_t now = millis();
+
+  if(forced || (int32_t)(now - _receivedTransmissionsNextSweep) >= 0)
+    _receivedTransmissionsNextSweep = now + deleteExpiredLogEntries(receivedEspnowTransmissions(), logEntryLifetimeMs());
+
+  if(forced || (int32_t)(now - _receivedRequestsNextSweep) >= 0)
+    _receivedRequestsNextSweep = now + deleteExpiredLogEntries(receivedRequests(), logEntryLifetimeMs()); // Just needs to be long enough to not accept repeated transmissions by mistake.
+
+  if(forced || (int32_t)(now - _sentRequestsNextSweep) >= 0)
+    _sentRequestsNextSweep = now + deleteExpiredLogEntries(sentRequests(), logEntryLifetimeMs(), broadcastResponseTimeoutMs());
+
+  if(forced || (int32_t)(now - _responsesToSendNextSweep) >= 0)
+    _responsesToSendNextSweep = now + deleteExpiredLogEntries(responsesToSend(), logEntryLifetimeMs());
+
+  if(forced || (int32_t)(now - _peerRequestConfirmationsNextSweep) >= 0)
+    _peerRequestConfirmationsNextSweep = now + deleteExpiredLogEntries(peerRequestConfirmationsToSend(), getEncryptionRequestTimeout());
 }
 
 std::list<ResponseData>::const_iterator EspnowDatabase::getScheduledResponse(const uint32_t responseIndex)
@@ -342,7 +417,7 @@ void EspnowDatabase::storeReceivedRequest(const uint64_t senderBSSID, const uint
 
 EspnowMeshBackend *EspnowDatabase::getOwnerOfSentRequest(const uint64_t requestMac, const uint64_t requestID)
 {
-  std::map<std::pair<peerMac_td, messageID_td>, RequestData>::iterator sentRequest = sentRequests().find(std::make_pair(requestMac, requestID));
+  sentRequestsMap_td::iterator sentRequest = sentRequests().find(std::make_pair(requestMac, requestID));
   
   if(sentRequest != sentRequests().end())
   {
@@ -361,7 +436,7 @@ size_t EspnowDatabase::deleteSentRequestsByOwner(const EspnowMeshBackend *instan
 {
   size_t numberDeleted = 0;
   
-  for(std::map<std::pair<peerMac_td, messageID_td>, RequestData>::iterator requestIterator = sentRequests().begin(); 
+  for(sentRequestsMap_td::iterator requestIterator = sentRequests().begin(); 
       requestIterator != sentRequests().end(); )
   {
     if(&requestIterator->second.getMeshInstance() == instancePointer) // If instance at instancePointer made the request
@@ -378,6 +453,8 @@ size_t EspnowDatabase::deleteSentRequestsByOwner(const EspnowMeshBackend *instan
 
 std::list<ResponseData> & EspnowDatabase::responsesToSend() { return _responsesToSend; }
 std::list<PeerRequestLog> & EspnowDatabase::peerRequestConfirmationsToSend() { return _peerRequestConfirmationsToSend; }
-std::map<std::pair<macAndType_td, messageID_td>, MessageData> & EspnowDatabase::receivedEspnowTransmissions() { return _receivedEspnowTransmissions; }
-std::map<std::pair<peerMac_td, messageID_td>, RequestData> & EspnowDatabase::sentRequests() { return _sentRequests; }
-std::map<std::pair<peerMac_td, messageID_td>, TimeTracker> & EspnowDatabase::receivedRequests() { return _receivedRequests; }
+EspnowDatabase::receivedTransmissionsMap_td & EspnowDatabase::receivedEspnowTransmissions() { return _receivedEspnowTransmissions; }
+EspnowDatabase::sentRequestsMap_td & EspnowDatabase::sentRequests() { return _sentRequests; }
+EspnowDatabase::receivedRequestsMap_td & EspnowDatabase::receivedRequests() { return _receivedRequests; }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
@@ -25,6 +25,7 @@
 #include "EspnowProtocolInterpreter.h"
 #include <list>
 #include <map>
+#include <unordered_map>
 #include "MessageData.h"
 #include "MutexTracker.h"
 #include "PeerRequestLog.h"
@@ -69,12 +70,33 @@ public:
   using messageID_td = EspnowProtocolInterpreter::messageID_td;
   using peerMac_td = EspnowProtocolInterpreter::peerMac_td;
 
+  /**
+   * Hash for the (MAC, message ID) keys of the log containers. The MAC bytes and the message ID
+   * (which contains a session key or random bits) are already well distributed, so a cheap mix is enough.
+   */
+  struct LogKeyHash
+  {
+    template <typename T>
+    size_t operator()(const std::pair<T, messageID_td> &key) const
+    {
+      uint64_t mixed = static_cast<uint64_t>(key.first) ^ (key.second * 0x9E3779B97F4A7C15ull);
+      return (size_t)(mixed ^ (mixed >> 32));
+    }
+  };
+
+  // The log containers are hash tables rather than ordered maps so that the per-frame lookups in the
+  // receive path (duplicate request checks, sent request owner lookups, multi-part message merging)
+  // stay O(1) as the number of mesh nodes grows.
+  using receivedTransmissionsMap_td = std::unordered_map<std::pair<macAndType_td, messageID_td>, MessageData, LogKeyHash>;
+  using sentRequestsMap_td = std::unordered_map<std::pair<peerMac_td, messageID_td>, RequestData, LogKeyHash>;
+  using receivedRequestsMap_td = std::unordered_map<std::pair<peerMac_td, messageID_td>, TimeTracker, LogKeyHash>;
+
   static size_t deleteSentRequestsByOwner(const EspnowMeshBackend *instancePointer);
   static std::list<ResponseData> & responsesToSend();
   static std::list<PeerRequestLog> & peerRequestConfirmationsToSend();
-  static std::map<std::pair<macAndType_td, messageID_td>, MessageData> & receivedEspnowTransmissions();
-  static std::map<std::pair<peerMac_td, messageID_td>, RequestData> & sentRequests();
-  static std::map<std::pair<peerMac_td, messageID_td>, TimeTracker> & receivedRequests();
+  static receivedTransmissionsMap_td & receivedEspnowTransmissions();
+  static sentRequestsMap_td & sentRequests();
+  static receivedRequestsMap_td & receivedRequests();
   
   static bool requestReceived(const uint64_t requestMac, const uint64_t requestID);
 
@@ -135,57 +157,35 @@ public:
    * @param encryptedOnly If true, only entries sent/received by encrypted transmissions will be deleted.
    */
   template <typename T>
-  static void deleteEntriesByMac(std::map<std::pair<macAndType_td, uint64_t>, T> &logEntries, const uint8_t *peerMac, const bool encryptedOnly)
-  {    
-    bool macFound = false;
-    
-    for(typename std::map<std::pair<macAndType_td, uint64_t>, T>::iterator entryIterator = logEntries.begin(); 
+  static void deleteEntriesByMac(std::unordered_map<std::pair<macAndType_td, uint64_t>, T, LogKeyHash> &logEntries, const uint8_t *peerMac, const bool encryptedOnly)
+  {
+    for(typename std::unordered_map<std::pair<macAndType_td, uint64_t>, T, LogKeyHash>::iterator entryIterator = logEntries.begin();
         entryIterator != logEntries.end(); )
     {
-      if(macAndTypeToUint64Mac(entryIterator->first.first) == MeshTypeConversionFunctions::macToUint64(peerMac))
-      {
-        macFound = true;
-           
-        if(!encryptedOnly || EspnowProtocolInterpreter::usesEncryption(entryIterator->first.second))
-        {
-          entryIterator = logEntries.erase(entryIterator);
-          continue;
-        }
-      }
-      else if(macFound)
+      if(macAndTypeToUint64Mac(entryIterator->first.first) == MeshTypeConversionFunctions::macToUint64(peerMac)
+         && (!encryptedOnly || EspnowProtocolInterpreter::usesEncryption(entryIterator->first.second)))
       {
-        // Since the map is sorted by MAC, we know here that no more matching MAC will be found.
-        return;
+        entryIterator = logEntries.erase(entryIterator);
+        continue;
       }
-  
+
       ++entryIterator;
     }
   }
-  
+
   template <typename T>
-  static void deleteEntriesByMac(std::map<std::pair<uint64_t, uint64_t>, T> &logEntries, const uint8_t *peerMac, const bool encryptedOnly)
-  {    
-    bool macFound = false;
-    
-    for(typename std::map<std::pair<uint64_t, uint64_t>, T>::iterator entryIterator = logEntries.begin(); 
+  static void deleteEntriesByMac(std::unordered_map<std::pair<uint64_t, uint64_t>, T, LogKeyHash> &logEntries, const uint8_t *peerMac, const bool encryptedOnly)
+  {
+    for(typename std::unordered_map<std::pair<uint64_t, uint64_t>, T, LogKeyHash>::iterator entryIterator = logEntries.begin();
         entryIterator != logEntries.end(); )
     {
-      if(entryIterator->first.first == MeshTypeConversionFunctions::macToUint64(peerMac))
+      if(entryIterator->first.first == MeshTypeConversionFunctions::macToUint64(peerMac)
+         && (!encryptedOnly || EspnowProtocolInterpreter::usesEncryption(entryIterator->first.second)))
       {
-        macFound = true;
-           
-        if(!encryptedOnly || EspnowProtocolInterpreter::usesEncryption(entryIterator->first.second))
-        {
-          entryIterator = logEntries.erase(entryIterator);
-          continue;
-        }
+        entryIterator = logEntries.erase(entryIterator);
+        continue;
       }
-      else if(macFound)
-      {
-        // Since the map is sorted by MAC, we know here that no more matching MAC will be found.
-        return;
-      }
-  
+
       ++entryIterator;
     }
   }
@@ -203,16 +203,19 @@ private:
 
   uint32_t _autoEncryptionDuration = 50;
   
+  // Each variant returns the number of milliseconds until the next remaining entry can expire
+  // (the entry lifetime when the container ends up empty), so that clearOldLogEntries can skip
+  // sweeping a container entirely until then instead of iterating every entry on every pass.
   template <typename T, typename U>
-  static void deleteExpiredLogEntries(std::map<std::pair<U, uint64_t>, T> &logEntries, const uint32_t maxEntryLifetimeMs);
+  static uint32_t deleteExpiredLogEntries(std::unordered_map<std::pair<U, uint64_t>, T, LogKeyHash> &logEntries, const uint32_t maxEntryLifetimeMs);
 
   template <typename U>
-  static void deleteExpiredLogEntries(std::map<std::pair<U, uint64_t>, TimeTracker> &logEntries, const uint32_t maxEntryLifetimeMs);
+  static uint32_t deleteExpiredLogEntries(std::unordered_map<std::pair<U, uint64_t>, TimeTracker, LogKeyHash> &logEntries, const uint32_t maxEntryLifetimeMs);
 
-  static void deleteExpiredLogEntries(std::map<std::pair<peerMac_td, messageID_td>, RequestData> &logEntries, const uint32_t requestLifetimeMs, const uint32_t broadcastLifetimeMs);
+  static uint32_t deleteExpiredLogEntries(sentRequestsMap_td &logEntries, const uint32_t requestLifetimeMs, const uint32_t broadcastLifetimeMs);
 
   template <typename T>
-  static void deleteExpiredLogEntries(std::list<T> &logEntries, const uint32_t maxEntryLifetimeMs);
+  static uint32_t deleteExpiredLogEntries(std::list<T> &logEntries, const uint32_t maxEntryLifetimeMs);
 
   uint8_t _senderMac[6] = {0};
   uint8_t _senderAPMac[6] = {0};
@@ -14,6 +14,8 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include <ESP8266WiFi.h>
 extern "C" {
   #include <espnow.h>
@@ -719,3 +721,5 @@ String EspnowEncryptionBroker::flexibleEncryptionRequestBuilder(const uint32_t m
 
   return Serializer::createEncryptionRequestHmacMessage(FPSTR(temporaryEncryptionRequestHeader), requestNonce, hashKey, hashKeyLength, connectionDuration);
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
@@ -16,6 +16,8 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include <ESP8266WiFi.h>
 extern "C" {
   #include <espnow.h>
@@ -39,6 +41,11 @@ namespace
   EspnowMeshBackend *_espnowRequestManager = nullptr;
 }
 
+EspnowMeshBackend::EspnowFrameSlot EspnowMeshBackend::_espnowFrameSlots[EspnowMeshBackend::espnowFrameSlotCount];
+volatile uint8_t EspnowMeshBackend::_espnowFrameWriteIndex = 0;
+uint8_t EspnowMeshBackend::_espnowFrameReadIndex = 0;
+volatile uint32_t EspnowMeshBackend::_droppedEspnowFrames = 0;
+
 void espnowDelay(uint32_t durationMs)
 {
   ExpiringTimeTracker timeout(durationMs);
@@ -171,7 +178,14 @@ bool EspnowMeshBackend::deactivateEspnow()
     EspnowDatabase::receivedRequests().clear();
     EspnowConnectionManager::encryptedConnections().clear();
     EncryptedConnectionLog::setNewRemovalsScheduled(false);
-    
+
+    for(EspnowFrameSlot &slot : _espnowFrameSlots)
+    {
+      slot.occupied = false;
+    }
+    _espnowFrameWriteIndex = 0;
+    _espnowFrameReadIndex = 0;
+
     return true;
   }
   else
@@ -192,6 +206,9 @@ void EspnowMeshBackend::performEspnowMaintenance(const uint32_t estimatedMaxDura
     return;
   }
 
+  // Drain the receive staging ring first, so any responses the staged frames generate can be sent below.
+  processStagedEspnowFrames();
+
   EspnowDatabase::clearOldLogEntries(false);
 
   if(EncryptedConnectionLog::getSoonestExpiringConnectionTracker() && EncryptedConnectionLog::getSoonestExpiringConnectionTracker()->expired())
@@ -213,16 +230,54 @@ void EspnowMeshBackend::performEspnowMaintenance(const uint32_t estimatedMaxDura
 }
 
 void EspnowMeshBackend::espnowReceiveCallbackWrapper(uint8_t *macaddr, uint8_t *dataArray, const uint8_t len)
+{
+  // This callback runs in the WiFi task, where long processing delays frame reception and drops frames.
+  // We therefore only copy the frame into a free staging ring slot here; dedup, decryption checks and
+  // dispatch all happen in user context via processStagedEspnowFrames().
+  if(len < EspnowProtocolInterpreter::metadataSize()) // If we do not receive at least the metadata bytes, the transmission is invalid.
+    return;
+
+  EspnowFrameSlot &slot = _espnowFrameSlots[_espnowFrameWriteIndex];
+  if(slot.occupied)
+  {
+    // The consumer has not caught up and the ring is full. Dropping the frame here is no worse
+    // than the WiFi task dropping it for us because we blocked too long.
+    ++_droppedEspnowFrames;
+    return;
+  }
+
+  memcpy(slot.mac, macaddr, 6);
+  memcpy(slot.data, dataArray, len);
+  slot.length = len;
+  slot.occupied = true; // Publish last: the consumer only reads mac/data/length once occupied is set.
+  _espnowFrameWriteIndex = (_espnowFrameWriteIndex + 1) % espnowFrameSlotCount;
+}
+
+void EspnowMeshBackend::processStagedEspnowFrames()
+{
+  while(_espnowFrameSlots[_espnowFrameReadIndex].occupied)
+  {
+    EspnowFrameSlot &slot = _espnowFrameSlots[_espnowFrameReadIndex];
+
+    processEspnowFrame(slot.mac, slot.data, slot.length);
+
+    slot.occupied = false; // Release the slot only after processing, so the producer cannot overwrite it.
+    _espnowFrameReadIndex = (_espnowFrameReadIndex + 1) % espnowFrameSlotCount;
+  }
+}
+
+void EspnowMeshBackend::processEspnowFrame(uint8_t *macaddr, uint8_t *dataArray, const uint8_t len)
 {
   using namespace EspnowProtocolInterpreter;
 
-  // Since this callback can be called during any delay(), we should always consider all mutexes captured.
-  // This provides a consistent mutex environment, which facilitates development and debugging. 
+  // This method used to run directly in the WiFi task receive callback and the code below was written for
+  // an environment where all mutexes are considered captured. Keep that environment, which also facilitates
+  // development and debugging.
   // Otherwise we get issues such as EspnowTransmitter::_espnowTransmissionMutex will usually be free, but occasionally taken (when callback occurs in a delay() during attemptTransmission).
   MutexTracker captureBanTracker(MutexTracker::captureBan());
-  
+
   if(len >= metadataSize()) // If we do not receive at least the metadata bytes, the transmission is invalid.
-  {    
+  {
     //uint32_t callbackStart = millis();
 
     // If there is a espnowRequestManager, get it
@@ -356,25 +411,24 @@ void EspnowMeshBackend::espnowReceiveCallback(const uint8_t *macaddr, uint8_t *d
   /*
   if(messageStart)
   {
-    storeTransmission
+    storeTransmission (or merge into already buffered parts)
   }
   else
   {
     if(messageFound)
-      storeTransmission or (erase and return)
+      storeTransmission (out-of-order parts are buffered until their predecessors arrive)
     else
-      return
+      storeTransmission as the start of a new buffered message (except for broadcasts)
   }
-  
-  if(transmissionsRemaining != 0)
+
+  if(!messageComplete)
     return
-    
+
   processMessage
   */
   ////// </Method overview> //////
 
   char messageType = getMessageType(dataArray);
-  uint8_t transmissionsRemaining = getTransmissionsRemaining(dataArray);
   uint64_t uint64Mac = TypeCast::macToUint64(macaddr);
   
   // The MAC is 6 bytes so two bytes of uint64Mac are free. We must include the messageType there since it is possible that we will
@@ -410,45 +464,43 @@ void EspnowMeshBackend::espnowReceiveCallback(const uint8_t *macaddr, uint8_t *d
       }
     }
     else
-    {  
-      // Does nothing if key already in receivedEspnowTransmissions
-      EspnowDatabase::receivedEspnowTransmissions().insert(std::make_pair(std::make_pair(macAndType, messageID), MessageData(dataArray, len)));
+    {
+      EspnowDatabase::receivedTransmissionsMap_td::iterator storedMessageIterator = EspnowDatabase::receivedEspnowTransmissions().find(std::make_pair(macAndType, messageID));
+
+      if(storedMessageIterator != EspnowDatabase::receivedEspnowTransmissions().end())
+        storedMessageIterator->second.addToMessage(dataArray, len); // Later parts arrived before the start; merge. Does nothing for a duplicate start.
+      else
+        EspnowDatabase::receivedEspnowTransmissions().insert(std::make_pair(std::make_pair(macAndType, messageID), MessageData(dataArray, len)));
     }
   }
   else
   {
-    std::map<std::pair<macAndType_td, messageID_td>, MessageData>::iterator storedMessageIterator = EspnowDatabase::receivedEspnowTransmissions().find(std::make_pair(macAndType, messageID));
+    EspnowDatabase::receivedTransmissionsMap_td::iterator storedMessageIterator = EspnowDatabase::receivedEspnowTransmissions().find(std::make_pair(macAndType, messageID));
 
-    if(storedMessageIterator == EspnowDatabase::receivedEspnowTransmissions().end()) // If we have not stored the key already, we missed the first message part.
+    if(storedMessageIterator == EspnowDatabase::receivedEspnowTransmissions().end())
     {
-      return;
-    }
-    
-    if(!storedMessageIterator->second.addToMessage(dataArray, len))
-    {
-      // If we received the wrong message part, remove the whole message if we have missed a part.
-      // Otherwise just ignore the received part since it has already been stored.
-      
-      uint8_t transmissionsRemainingExpected = storedMessageIterator->second.getTransmissionsRemaining() - 1;
-      
-      if(transmissionsRemaining < transmissionsRemainingExpected)
-      {
-        EspnowDatabase::receivedEspnowTransmissions().erase(storedMessageIterator);
-        return;
-      }
+      // We have not seen the message start yet. A windowed sender (see EspnowTransmitter::setEspnowSendWindowSize)
+      // may retransmit the start after later parts, so store this part rather than dropping it.
+      // Broadcasts must pass the BroadcastFilter with their message start, so those are still dropped here.
+      if(messageType != 'B')
+        EspnowDatabase::receivedEspnowTransmissions().insert(std::make_pair(std::make_pair(macAndType, messageID), MessageData(dataArray, len)));
+
+      return; // A message without its start cannot be complete.
     }
+
+    storedMessageIterator->second.addToMessage(dataArray, len); // Parts ahead of a missed predecessor are buffered, duplicates are ignored.
   }
-  
+
   //Serial.println("methodStart storage done " + String(millis() - methodStart));
-  
-  if(transmissionsRemaining != 0)
+
+  EspnowDatabase::receivedTransmissionsMap_td::iterator storedMessageIterator = EspnowDatabase::receivedEspnowTransmissions().find(std::make_pair(macAndType, messageID));
+  assert(storedMessageIterator != EspnowDatabase::receivedEspnowTransmissions().end());
+
+  if(!storedMessageIterator->second.messageComplete())
   {
     return;
   }
 
-  std::map<std::pair<macAndType_td, messageID_td>, MessageData>::iterator storedMessageIterator = EspnowDatabase::receivedEspnowTransmissions().find(std::make_pair(macAndType, messageID));
-  assert(storedMessageIterator != EspnowDatabase::receivedEspnowTransmissions().end());
-
   // Copy totalMessage in case user callbacks (request/responseHandler) do something odd with receivedEspnowTransmissions list.
   String totalMessage = storedMessageIterator->second.getTotalMessage(); // https://stackoverflow.com/questions/134731/returning-a-const-reference-to-an-object-instead-of-a-copy It is likely that most compilers will perform Named Value Return Value Optimisation in this case
 
@@ -1042,3 +1094,5 @@ void EspnowMeshBackend::setWiFiChannel(const uint8 newWiFiChannel)
   MeshBackendBase::setWiFiChannel(newWiFiChannel);
   _database.setWiFiChannel(newWiFiChannel);
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
@@ -16,6 +16,12 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+// Build-time feature gate: compiling with -DESP8266WIFIMESH_DISABLE_ESPNOW removes the ESP-NOW backend
+// (EspnowMeshBackend, FloodingMesh and the connection/encryption bookkeeping behind them) from the build,
+// leaving only the TCP/IP backend. Sketches that use TcpIpMeshBackend exclusively save tens of KB of flash
+// and the static RAM of the ESP-NOW logs and maps. Compare the linker size report (or 'tools/sizes.py
+// --elf ...') with and without the define to measure the gain for your sketch.
+
 // ESP-NOW is faster for small data payloads (up to a few kB, split over multiple messages). Transfer of up to 234 bytes takes 4 ms.
 // In general ESP-NOW transfer time can be approximated with the following function: transferTime = ceil(bytesToTransfer / 234.0)*3 ms.
 // If you only transfer 234 bytes at a time, this adds up to around 56kB/s. Finally a chance to relive the glory of the olden days
@@ -1007,6 +1013,40 @@ private:
   static void espnowReceiveCallbackWrapper(uint8_t *macaddr, uint8_t *dataArray, const uint8_t len);
   void espnowReceiveCallback(const uint8_t *macaddr, uint8_t *data, const uint8_t len);
 
+  /**
+   * One slot of the receive staging ring. espnowReceiveCallbackWrapper (running in the WiFi task) only copies
+   * each received frame into a free slot; all actual processing (dedup lists, decryption checks, user callbacks)
+   * happens later in user context via processStagedEspnowFrames(), so the WiFi task is never stalled.
+   *
+   * The ring is single-producer (WiFi task) / single-consumer (user context): the producer publishes a slot by
+   * setting occupied last, the consumer releases it by clearing occupied after processing.
+   */
+  struct EspnowFrameSlot
+  {
+    volatile bool occupied = false;
+    uint8_t mac[6] = { 0 };
+    uint8_t length = 0;
+    uint8_t data[250] = { 0 }; // EspnowProtocolInterpreter::getMaxBytesPerTransmission() bytes
+  };
+
+  static constexpr uint8_t espnowFrameSlotCount = 8;
+
+  static EspnowFrameSlot _espnowFrameSlots[espnowFrameSlotCount];
+  static volatile uint8_t _espnowFrameWriteIndex;
+  static uint8_t _espnowFrameReadIndex;
+  static volatile uint32_t _droppedEspnowFrames;
+
+  /**
+   * Process (in user context) all frames staged by espnowReceiveCallbackWrapper since the last call.
+   * Called from performEspnowMaintenance().
+   */
+  static void processStagedEspnowFrames();
+
+  /**
+   * The former body of espnowReceiveCallbackWrapper: dedup, decryption checks and dispatch for one received frame.
+   */
+  static void processEspnowFrame(uint8_t *macaddr, uint8_t *dataArray, const uint8_t len);
+
   broadcastFilterType _broadcastFilter;
 
   bool _acceptsUnverifiedRequests = true;
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "EspnowNetworkInfo.h"
 #include <assert.h>
 
@@ -36,3 +38,5 @@ EspnowNetworkInfo::EspnowNetworkInfo(const uint8_t BSSID[6], const String &SSID,
                    : NetworkInfoBase(SSID, wifiChannel, BSSID, encryptionType, RSSI, isHidden)
 { }
                   
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
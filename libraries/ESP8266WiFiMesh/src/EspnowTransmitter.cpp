@@ -14,7 +14,10 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include <ESP8266WiFi.h>
+#include <memory>
 extern "C" {
   #include <espnow.h>
 }
@@ -47,6 +50,16 @@ namespace
   bool _espnowSendConfirmed = false;
 
   uint8_t _maxTransmissionsPerMessage = 3;
+
+  uint8_t _espnowSendWindowSize = 1;
+
+  // Sliding-window transmit state, see setEspnowSendWindowSize. Only valid while espnowSendToNodeUnsynchronized
+  // holds _espnowSendToNodeMutex. The counters are updated from the ESP-NOW send callback, which only runs
+  // during delay()/yield(), so no further synchronization is required.
+  constexpr uint32_t noWindowFailure = 0xFFFFFFFF;
+  bool _espnowWindowActive = false;
+  volatile uint32_t _espnowWindowCallbackCount = 0; // Send callbacks received since the current round started.
+  volatile uint32_t _espnowWindowFirstFailure = noWindowFailure; // Round-relative index of the first failed callback.
 }
 
 EspnowTransmitter::EspnowTransmitter(ConditionalPrinter &conditionalPrinterInstance, EspnowDatabase &databaseInstance, EspnowConnectionManager &connectionManagerInstance) 
@@ -56,6 +69,21 @@ EspnowTransmitter::EspnowTransmitter(ConditionalPrinter &conditionalPrinterInsta
 
 void EspnowTransmitter::espnowSendCallback(uint8_t* mac, uint8_t sendStatus)
 {
+  if(_espnowWindowActive)
+  {
+    // Send callbacks arrive in the order the frames were handed to esp_now_send, so the callback count
+    // identifies which in-flight frame of the current round this callback confirms.
+    if(MeshUtilityFunctions::macEqual(mac, _transmissionTargetBSSID))
+    {
+      if(sendStatus && _espnowWindowCallbackCount < _espnowWindowFirstFailure) // sendStatus == 0 when send was OK.
+        _espnowWindowFirstFailure = _espnowWindowCallbackCount;
+
+      ++_espnowWindowCallbackCount;
+    }
+
+    return;
+  }
+
   if(_espnowSendConfirmed)
     return;
   else if(!sendStatus && MeshUtilityFunctions::macEqual(mac, _transmissionTargetBSSID)) // sendStatus == 0 when send was OK.
@@ -109,6 +137,20 @@ void EspnowTransmitter::setMaxTransmissionsPerMessage(const uint8_t maxTransmiss
 
 uint8_t EspnowTransmitter::getMaxTransmissionsPerMessage() {return _maxTransmissionsPerMessage;}
 
+void EspnowTransmitter::setEspnowSendWindowSize(const uint8_t windowSize)
+{
+  assert(1 <= windowSize && windowSize <= 8);
+
+  MutexTracker mutexTracker(_espnowSendToNodeMutex);
+  if(!mutexTracker.mutexCaptured())
+  {
+    assert(false && String(F("ERROR! espnowSendToNode in progress. Don't call setEspnowSendWindowSize from non-hook callbacks since this may modify the ESP-NOW transmission parameters during ongoing transmissions! Aborting.")));
+  }
+
+  _espnowSendWindowSize = windowSize;
+}
+uint8_t EspnowTransmitter::getEspnowSendWindowSize() { return _espnowSendWindowSize; }
+
 uint32_t EspnowTransmitter::getMaxMessageLength()
 {
   return getMaxTransmissionsPerMessage() * EspnowProtocolInterpreter::getMaxMessageBytesPerTransmission();
@@ -272,6 +314,104 @@ TransmissionStatusType EspnowTransmitter::espnowSendToNodeUnsynchronized(const S
   bool messageStart = true;
   uint8_t espnowMetadataSize = metadataSize();
 
+  ////// Prepare sliding-window pipeline //////
+
+  // With a window size above 1 (see setEspnowSendWindowSize) we keep copies of up to windowSize frames in
+  // flight instead of waiting for the send callback after every frame, and only block when the window is full.
+  // Since send callbacks arrive in submission order, _espnowWindowFirstFailure tells us which in-flight frame
+  // was lost; everything from that frame onward is resent (go-back-N). The receiver buffers parts that arrive
+  // ahead of their predecessors and discards duplicates, so the resent frames are harmless.
+  uint8_t windowSize = (messageType == 'B' || transmissionsRequired <= 1) ? 1 : _espnowSendWindowSize;
+  struct WindowFrame { uint8_t size; uint8_t data[250]; }; // data sized to getMaxBytesPerTransmission()
+  std::unique_ptr<WindowFrame[]> windowFrames(windowSize > 1 ? new (std::nothrow) WindowFrame[windowSize] : nullptr);
+  if(windowSize > 1 && !windowFrames)
+    windowSize = 1; // OOM, fall back to stop-and-wait
+  uint32_t framesBuilt = 0; // Frames created so far. Frame i occupies windowFrames[i % windowSize] until confirmed.
+  uint32_t framesConfirmed = 0; // Length of the confirmed frame prefix of the message.
+  uint32_t roundStart = 0; // Frame index the current submission round started at.
+  uint32_t submittedInRound = 0;
+
+  // Account for newly received send callbacks, advancing framesConfirmed to cover the successful prefix
+  // of the current round. Handles the encrypted connection session key once the first frame is confirmed,
+  // like the stop-and-wait path does.
+  auto windowProcessCallbacks = [&]()
+  {
+    uint32_t confirmedInRound = std::min((uint32_t)_espnowWindowCallbackCount, (uint32_t)_espnowWindowFirstFailure);
+    if(roundStart + confirmedInRound > framesConfirmed)
+    {
+      if(framesConfirmed == 0 && encryptedConnection && !usesConstantSessionKey(messageType) && encryptedConnection->getOwnSessionKey() == messageID)
+      {
+        encryptedConnection->setDesync(false);
+        encryptedConnection->incrementOwnSessionKey();
+      }
+
+      framesConfirmed = roundStart + confirmedInRound;
+    }
+  };
+
+  // Hand one frame to esp_now_send, retrying until the SDK accepts it or the timeout expires.
+  auto windowSendFrame = [&](WindowFrame &frame, const ExpiringTimeTracker &transmissionTimeout) -> bool
+  {
+    while(!transmissionTimeout)
+    {
+      if(esp_now_send(_transmissionTargetBSSID, frame.data, frame.size) == 0) // == 0 => Success
+        return true;
+
+      delay(1);
+    }
+
+    return false;
+  };
+
+  // A frame was reported lost: let the callbacks of the remaining in-flight frames drain, then start a new
+  // round resending every frame from the lost one onward.
+  auto windowRecover = [&](const ExpiringTimeTracker &transmissionTimeout) -> bool
+  {
+    while(_espnowWindowCallbackCount < submittedInRound && !transmissionTimeout)
+      delay(1); // Note that callbacks can be called during delay time, so it is possible to receive a transmission during this delay.
+
+    if(_espnowWindowCallbackCount < submittedInRound)
+      return false;
+
+    windowProcessCallbacks();
+    roundStart = framesConfirmed;
+    _espnowWindowFirstFailure = noWindowFailure;
+    _espnowWindowCallbackCount = 0;
+    submittedInRound = 0;
+
+    for(uint32_t frameIndex = roundStart; frameIndex < framesBuilt; ++frameIndex)
+    {
+      if(!windowSendFrame(windowFrames[frameIndex % windowSize], transmissionTimeout))
+        return false;
+
+      ++submittedInRound;
+    }
+
+    return true;
+  };
+
+  auto windowFail = [&]() -> TransmissionStatusType
+  {
+    _espnowWindowActive = false;
+    ++_transmissionsFailed;
+
+    ConditionalPrinter::staticVerboseModePrint(String(F("espnowSendToNode failed!")));
+    ConditionalPrinter::staticVerboseModePrint(String(F("Frames confirmed: ")) + String(framesConfirmed) + String('/') + String(transmissionsRequired));
+    ConditionalPrinter::staticVerboseModePrint(String(F("Transmission fail rate (up) ")) + String(getTransmissionFailRate()));
+
+    if(framesConfirmed == 0 && encryptedConnection && !usesConstantSessionKey(messageType) && encryptedConnection->getOwnSessionKey() == messageID)
+      encryptedConnection->setDesync(true);
+
+    return TransmissionStatusType::TRANSMISSION_FAILED;
+  };
+
+  if(windowSize > 1)
+  {
+    _espnowWindowCallbackCount = 0;
+    _espnowWindowFirstFailure = noWindowFailure;
+    _espnowWindowActive = true;
+  }
+
   do
   {
     ////// Manage logs //////
@@ -339,10 +479,50 @@ TransmissionStatusType EspnowTransmitter::espnowSendToNodeUnsynchronized(const S
     
     ////// Transmit //////
 
+    if(windowSize > 1)
+    {
+      ExpiringTimeTracker transmissionTimeout([](){ return getEspnowTransmissionTimeout(); });
+      bool frameSubmitted = false;
+
+      while(!frameSubmitted && !transmissionTimeout)
+      {
+        if(_espnowWindowFirstFailure != noWindowFailure && !windowRecover(transmissionTimeout))
+          break;
+
+        windowProcessCallbacks();
+
+        if(framesBuilt - framesConfirmed >= windowSize)
+        {
+          // Window full. The slot of the next frame still holds an unconfirmed frame copy, so wait for
+          // the oldest in-flight frame to be confirmed before overwriting it.
+          delay(1);
+          continue;
+        }
+
+        WindowFrame &frame = windowFrames[framesBuilt % windowSize];
+        frame.size = transmissionSize;
+        std::copy_n(transmission, transmissionSize, frame.data);
+
+        if(windowSendFrame(frame, transmissionTimeout))
+        {
+          ++framesBuilt;
+          ++submittedInRound;
+          frameSubmitted = true;
+        }
+      }
+
+      if(!frameSubmitted)
+        return windowFail();
+
+      messageStart = false;
+      --transmissionsRemaining; // This is used when transferring multi-transmission messages.
+      continue;
+    }
+
     uint32_t retransmissions = 0;
     if(messageType == 'B')
       retransmissions = espnowInstance->getBroadcastTransmissionRedundancy();
-      
+
     for(uint32_t i = 0; i <= retransmissions; ++i)
     {
       _espnowSendConfirmed = false;
@@ -395,9 +575,38 @@ TransmissionStatusType EspnowTransmitter::espnowSendToNodeUnsynchronized(const S
     
   } while(transmissionsRemaining >= 0);
 
+  if(windowSize > 1)
+  {
+    // All frames are submitted. Wait for the tail of the window to be confirmed, recovering lost frames as above.
+    ExpiringTimeTracker transmissionTimeout([](){ return getEspnowTransmissionTimeout(); });
+
+    while(framesConfirmed < (uint32_t)transmissionsRequired && !transmissionTimeout)
+    {
+      if(_espnowWindowFirstFailure != noWindowFailure)
+      {
+        if(!windowRecover(transmissionTimeout))
+          break;
+
+        continue;
+      }
+
+      windowProcessCallbacks();
+
+      if(framesConfirmed < (uint32_t)transmissionsRequired)
+        delay(1); // Note that callbacks can be called during delay time, so it is possible to receive a transmission during this delay.
+    }
+
+    windowProcessCallbacks();
+
+    if(framesConfirmed < (uint32_t)transmissionsRequired)
+      return windowFail();
+
+    _espnowWindowActive = false;
+  }
+
   // Useful when debugging the protocol
-  //_conditionalPrinter.staticVerboseModePrint("Sent to Mac: " + TypeCast::macToString(_transmissionTargetBSSID) + " ID: " + TypeCast::uint64ToString(messageID)); 
-  
+  //_conditionalPrinter.staticVerboseModePrint("Sent to Mac: " + TypeCast::macToString(_transmissionTargetBSSID) + " ID: " + TypeCast::uint64ToString(messageID));
+
   return TransmissionStatusType::TRANSMISSION_COMPLETE;
 }
 
@@ -426,3 +635,5 @@ TransmissionStatusType EspnowTransmitter::sendResponse(const String &message, co
   
   return espnowSendToNodeUnsynchronized(message, encryptedConnection ? encryptedMac : targetBSSID, 'A', requestID, espnowInstance);
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
@@ -67,6 +67,21 @@ public:
   responseTransmittedHookType getResponseTransmittedHook() const;
   static void setMaxTransmissionsPerMessage(const uint8_t maxTransmissionsPerMessage);
   static uint8_t getMaxTransmissionsPerMessage();
+
+  /**
+   * Set how many ESP-NOW frames espnowSendToNode may keep in flight before waiting for send confirmations.
+   * The default of 1 gives the classic stop-and-wait behaviour. A larger window pipelines the frames of a
+   * multi-transmission message, so bulk transfers no longer pay the full confirmation round-trip per frame.
+   * Costs windowSize * 250 bytes of heap during windowed transmissions.
+   *
+   * Note that a lost frame is retransmitted after its successors, so all receiving nodes must run a library
+   * version that supports out-of-order message reassembly (this version does). Leave at 1 when older nodes
+   * may be present in the mesh. Broadcasts always use a window of 1 because of broadcast transmission redundancy.
+   *
+   * @param windowSize The maximum number of unconfirmed frames in flight. Valid values are 1 to 8.
+   */
+  static void setEspnowSendWindowSize(const uint8_t windowSize);
+  static uint8_t getEspnowSendWindowSize();
   static uint32_t getMaxMessageLength();
   static void setEspnowTransmissionTimeout(const uint32_t timeoutMs);
   static uint32_t getEspnowTransmissionTimeout();
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "FloodingMesh.h"
 #include "TypeConversionFunctions.h"
 #include "JsonTranslator.h"
@@ -573,3 +575,5 @@ bool FloodingMesh::_defaultResponseTransmittedHook(bool transmissionSuccessful,
 
   return true;
 }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "MessageData.h"
 #include "EspnowProtocolInterpreter.h"
 #include "EspnowMeshBackend.h"
@@ -38,22 +40,53 @@ MessageData::MessageData(const String &message, const uint8_t transmissionsRemai
 MessageData::MessageData(uint8_t *initialTransmission, const uint8_t transmissionLength, const uint32_t creationTimeMs) :
   _timeTracker(creationTimeMs)
 {
-  _transmissionsExpected = EspnowProtocolInterpreter::getTransmissionsRemaining(initialTransmission) + 1;
   addToMessage(initialTransmission, transmissionLength);
 }
 
 bool MessageData::addToMessage(uint8_t *transmission, const uint8_t transmissionLength)
 {
-  if(EspnowProtocolInterpreter::getTransmissionsRemaining(transmission) == getTransmissionsRemaining() - 1)
+  uint8_t transmissionsRemaining = EspnowProtocolInterpreter::getTransmissionsRemaining(transmission);
+
+  if(EspnowProtocolInterpreter::isMessageStart(transmission))
+  {
+    if(_transmissionsExpected != EXPECTED_UNKNOWN)
+      return false; // Duplicate message start.
+
+    _transmissionsExpected = transmissionsRemaining + 1;
+  }
+  else if(_transmissionsExpected != EXPECTED_UNKNOWN && transmissionsRemaining >= getTransmissionsRemaining())
+  {
+    return false; // Duplicate of a transmission already merged into _totalMessage.
+  }
+
+  String message = EspnowProtocolInterpreter::getHashKeyLength(transmission, transmissionLength);
+  assert(message.length() <= EspnowMeshBackend::getMaxMessageBytesPerTransmission()); // Should catch some cases where transmission is not null terminated.
+
+  if(_transmissionsExpected != EXPECTED_UNKNOWN && transmissionsRemaining == getTransmissionsRemaining() - 1)
   {
-    String message = EspnowProtocolInterpreter::getHashKeyLength(transmission, transmissionLength);
-    assert(message.length() <= EspnowMeshBackend::getMaxMessageBytesPerTransmission()); // Should catch some cases where transmission is not null terminated.
     _totalMessage += message;
     ++_transmissionsReceived;
+
+    // Merge any buffered parts that are now contiguous with the received prefix.
+    std::map<uint8_t, String>::iterator bufferedIterator;
+    while(getTransmissionsRemaining() > 0
+          && (bufferedIterator = _bufferedFragments.find(getTransmissionsRemaining() - 1)) != _bufferedFragments.end())
+    {
+      _totalMessage += bufferedIterator->second;
+      ++_transmissionsReceived;
+      _bufferedFragments.erase(bufferedIterator);
+    }
+
     return true;
   }
 
-  return false;
+  // The transmission arrived ahead of a not yet received predecessor (or ahead of the message start,
+  // when _transmissionsExpected is still unknown). Buffer it until the gap before it is filled.
+  if(_bufferedFragments.count(transmissionsRemaining))
+    return false; // Duplicate of an already buffered transmission.
+
+  _bufferedFragments.insert(std::make_pair(transmissionsRemaining, message));
+  return true;
 }
 
 uint8_t MessageData::getTransmissionsReceived() const
@@ -71,9 +104,16 @@ uint8_t MessageData::getTransmissionsRemaining() const
   return getTransmissionsExpected() - getTransmissionsReceived();
 }
 
+bool MessageData::messageComplete() const
+{
+  return _transmissionsExpected != EXPECTED_UNKNOWN && _transmissionsReceived == _transmissionsExpected;
+}
+
 String MessageData::getTotalMessage() const
 {
   return _totalMessage;
 }
 
 const TimeTracker &MessageData::getTimeTracker() const { return _timeTracker; }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
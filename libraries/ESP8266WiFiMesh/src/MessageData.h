@@ -27,6 +27,7 @@
 
 #include "TimeTracker.h"
 #include <Arduino.h>
+#include <map>
 
 class MessageData {
 
@@ -35,22 +36,39 @@ public:
   MessageData(const String &message, const uint8_t transmissionsRemaining, const uint32_t creationTimeMs = millis());
   MessageData(uint8_t *initialTransmission, const uint8_t transmissionLength, const uint32_t creationTimeMs = millis());
   /**
+   * Add one transmission to the message. Transmissions that arrive ahead of a not yet received predecessor
+   * (e.g. because the sender uses a transmission window above 1 and had to retransmit a lost frame)
+   * are buffered and merged into the message once the gap before them is filled.
+   *
    * @transmission A string of characters, including initial protocol bytes. Not const since that would increase heap consumption during processing.
    * @transmissionLength Length of transmission.
+   * @return True if the transmission was stored or buffered. False if it was a duplicate of an already stored transmission.
    */
   bool addToMessage(uint8_t *transmission, const uint8_t transmissionLength);
   uint8_t getTransmissionsReceived() const;
   uint8_t getTransmissionsExpected() const;
   uint8_t getTransmissionsRemaining() const;
+
+  /**
+   * True once the message start and every other expected transmission have been received.
+   */
+  bool messageComplete() const;
   String getTotalMessage() const;
   const TimeTracker &getTimeTracker() const;
 
 private:
 
+  // Used for _transmissionsExpected until the message start transmission (which carries the total) arrives.
+  // Valid transmission counts are at most 128, see EspnowTransmitter::setMaxTransmissionsPerMessage.
+  static constexpr uint8_t EXPECTED_UNKNOWN = 0xFF;
+
   TimeTracker _timeTracker;
   String _totalMessage;
+  // Message parts that arrived ahead of their predecessors, keyed by their transmissionsRemaining value.
+  // Drained into _totalMessage as the gaps before them are filled.
+  std::map<uint8_t, String> _bufferedFragments;
   uint8_t _transmissionsReceived = 0;
-  uint8_t _transmissionsExpected;
+  uint8_t _transmissionsExpected = EXPECTED_UNKNOWN;
 };
 
 #endif
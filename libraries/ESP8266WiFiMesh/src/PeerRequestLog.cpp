@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "PeerRequestLog.h"
 #include "EspnowMeshBackend.h"
 
@@ -58,3 +60,5 @@ uint8_t PeerRequestLog::getEncryptedConnectionsSoftLimit() const { return _encry
 
 void PeerRequestLog::setPeerRequestNonce(const String &nonce) { _peerRequestNonce = nonce; }
 String PeerRequestLog::getPeerRequestNonce() const { return _peerRequestNonce; }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
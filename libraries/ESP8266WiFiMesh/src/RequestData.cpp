@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 
+#ifndef ESP8266WIFIMESH_DISABLE_ESPNOW
+
 #include "RequestData.h"
 #include "EspnowMeshBackend.h"
 
@@ -31,3 +33,5 @@ RequestData::RequestData(EspnowMeshBackend &meshInstance, const uint32_t creatio
 
 EspnowMeshBackend &RequestData::getMeshInstance() const { return _meshInstance; }
 const TimeTracker &RequestData::getTimeTracker() const { return _timeTracker; }
+
+#endif // ESP8266WIFIMESH_DISABLE_ESPNOW
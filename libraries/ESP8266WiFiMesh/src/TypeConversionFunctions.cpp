@@ -141,9 +141,11 @@ namespace MeshTypeConversionFunctions
   
   String macToString(const uint8_t *mac)
   {
-    return MeshTypeConversionFunctions::uint8ArrayToHexString(mac, 6);
+    // Hot path for message IDs: encode into a stack buffer so the String is built in one go.
+    char macBuffer[13];
+    return String(experimental::TypeConversion::uint8ArrayToHexCString(mac, 6, macBuffer));
   }
-  
+
   uint8_t *stringToMac(const String &macString, uint8_t *macArray)
   {
     return MeshTypeConversionFunctions::hexStringToUint8Array(macString, macArray, 6);
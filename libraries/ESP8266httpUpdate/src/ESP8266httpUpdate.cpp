@@ -145,6 +145,8 @@ String ESP8266HTTPUpdate::getLastErrorString(void)
         return F("New Binary Does Not Fit Flash Size");
     case HTTP_UE_SERVER_UNAUTHORIZED:
         return F("Unauthorized (401)");
+    case HTTP_UE_DELTA_MALFORMED:
+        return F("Delta Patch Malformed");
     }
 
     return String();
@@ -173,6 +175,9 @@ HTTPUpdateResult ESP8266HTTPUpdate::handleUpdate(HTTPClient& http, const String&
     http.addHeader(F("x-ESP8266-free-space"), String(ESP.getFreeSketchSpace()));
     http.addHeader(F("x-ESP8266-sketch-size"), String(ESP.getSketchSize()));
     http.addHeader(F("x-ESP8266-sketch-md5"), String(ESP.getSketchMD5()));
+    // the server may answer a sketch request with a binary delta against
+    // the image identified by x-ESP8266-sketch-md5 (see runDeltaUpdate)
+    http.addHeader(F("x-ESP8266-accept-delta"), F("1"));
     http.addHeader(F("x-ESP8266-chip-size"), String(ESP.getFlashChipRealSize()));
     http.addHeader(F("x-ESP8266-sdk-version"), ESP.getSdkVersion());
 
@@ -291,6 +296,7 @@ HTTPUpdateResult ESP8266HTTPUpdate::handleUpdate(HTTPClient& http, const String&
                     DEBUG_HTTP_UPDATE("[httpUpdate] runUpdate flash...\n");
                 }
 
+                bool deltaUpdate = false;
                 if(!spiffs) {
                     uint8_t buf[4];
                     if(tcp->peekBytes(&buf[0], 4) != 4) {
@@ -300,6 +306,11 @@ HTTPUpdateResult ESP8266HTTPUpdate::handleUpdate(HTTPClient& http, const String&
                         return HTTP_UPDATE_FAILED;
                     }
 
+                    if(buf[0] == 'E' && buf[1] == 'P' && buf[2] == 'D' && buf[3] == '1') {
+                        // binary delta against the running image
+                        DEBUG_HTTP_UPDATE("[httpUpdate] delta patch detected\n");
+                        deltaUpdate = true;
+                    } else
                     // check for valid first magic byte
                     if(buf[0] != 0xE9 && buf[0] != 0x1f) {
                         DEBUG_HTTP_UPDATE("[httpUpdate] Magic header does not start with 0xE9\n");
@@ -325,7 +336,8 @@ HTTPUpdateResult ESP8266HTTPUpdate::handleUpdate(HTTPClient& http, const String&
                     }
 #endif
                 }
-                if(runUpdate(*tcp, len, md5, command)) {
+                if(deltaUpdate ? runDeltaUpdate(*tcp, len, md5, command)
+                               : runUpdate(*tcp, len, md5, command)) {
                     ret = HTTP_UPDATE_OK;
                     DEBUG_HTTP_UPDATE("[httpUpdate] Update ok\n");
                     http.end();
@@ -440,6 +452,152 @@ bool ESP8266HTTPUpdate::runUpdate(Stream& in, uint32_t size, const String& md5,
     return true;
 }
 
+/**
+ * apply a binary delta patch against the running image and write the
+ * reconstructed target through Update
+ *
+ * Patch layout (integers little-endian):
+ *   "EPD1" magic, uint32 target image size, then a stream of opcodes:
+ *     0x01 srcOffset:u32 length:u32   copy baseline bytes from flash
+ *     0x02 length:u32                 literal, length raw bytes follow
+ *     0x00                            end of patch
+ *
+ * The server picks the baseline from the x-ESP8266-sketch-md5 request
+ * header; x-MD5 still carries the md5 of the reconstructed target, so
+ * the usual end-of-update verification covers the patched result.
+ *
+ * @param in Stream&
+ * @param size uint32_t patch size as reported by the server (unused)
+ * @param md5 String md5 of the reconstructed target image
+ * @return true if Update ok
+ */
+bool ESP8266HTTPUpdate::runDeltaUpdate(Stream& in, uint32_t size, const String& md5, int command)
+{
+    (void) size;
+
+    StreamString error;
+
+    uint8_t header[8];
+    if(in.readBytes(header, sizeof(header)) != sizeof(header)
+            || header[0] != 'E' || header[1] != 'P' || header[2] != 'D' || header[3] != '1') {
+        _setLastError(HTTP_UE_DELTA_MALFORMED);
+        DEBUG_HTTP_UPDATE("[httpUpdate] delta header truncated\n");
+        return false;
+    }
+    uint32_t targetSize = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+
+    if (_cbProgress) {
+        Update.onProgress(_cbProgress);
+    }
+
+    if(!Update.begin(targetSize, command, _ledPin, _ledOn)) {
+        _setLastError(Update.getError());
+        Update.printError(error);
+        error.trim(); // remove line ending
+        DEBUG_HTTP_UPDATE("[httpUpdate] Update.begin failed! (%s)\n", error.c_str());
+        return false;
+    }
+
+    if (_cbProgress) {
+        _cbProgress(0, targetSize);
+    }
+
+    if(md5.length()) {
+        if(!Update.setMD5(md5.c_str())) {
+            _setLastError(HTTP_UE_SERVER_FAULTY_MD5);
+            DEBUG_HTTP_UPDATE("[httpUpdate] Update.setMD5 failed! (%s)\n", md5.c_str());
+            return false;
+        }
+    }
+
+    uint32_t written = 0;
+    alignas(alignof(uint32_t)) uint8_t buf[256];
+    bool complete = false;
+
+    for(;;) {
+        uint8_t op;
+        if(in.readBytes(&op, 1) != 1) {
+            break;
+        }
+        if(op == 0x00) {
+            complete = (written == targetSize);
+            break;
+        }
+        if(op != 0x01 && op != 0x02) {
+            break;
+        }
+
+        uint8_t args[8];
+        size_t argLen = (op == 0x01) ? 8 : 4;
+        if(in.readBytes(args, argLen) != argLen) {
+            break;
+        }
+        uint32_t srcOffset = 0;
+        uint32_t length;
+        if(op == 0x01) {
+            srcOffset = args[0] | (args[1] << 8) | (args[2] << 16) | ((uint32_t)args[3] << 24);
+            length = args[4] | (args[5] << 8) | (args[6] << 16) | ((uint32_t)args[7] << 24);
+        } else {
+            length = args[0] | (args[1] << 8) | (args[2] << 16) | ((uint32_t)args[3] << 24);
+        }
+        if(written + length > targetSize) {
+            break;
+        }
+
+        bool opFailed = false;
+        while(length) {
+            size_t chunk = length < sizeof(buf) ? length : sizeof(buf);
+            if(op == 0x01) {
+                // baseline bytes come from the running image in flash
+                if(!ESP.flashRead(srcOffset, buf, chunk)) {
+                    opFailed = true;
+                    break;
+                }
+                srcOffset += chunk;
+            } else {
+                if(in.readBytes(buf, chunk) != chunk) {
+                    opFailed = true;
+                    break;
+                }
+            }
+            if(Update.write(buf, chunk) != chunk) {
+                opFailed = true;
+                break;
+            }
+            written += chunk;
+            length -= chunk;
+        }
+        if(opFailed) {
+            break;
+        }
+        if(_cbProgress) {
+            _cbProgress(written, targetSize);
+        }
+    }
+
+    if(!complete) {
+        _setLastError(Update.hasError() ? Update.getError() : HTTP_UE_DELTA_MALFORMED);
+        Update.printError(error);
+        error.trim(); // remove line ending
+        DEBUG_HTTP_UPDATE("[httpUpdate] delta apply failed at %u/%u (%s)\n", written, targetSize, error.c_str());
+        return false;
+    }
+
+    if (_cbProgress) {
+        _cbProgress(targetSize, targetSize);
+    }
+
+    if(!Update.end()) {
+        _setLastError(Update.getError());
+        Update.printError(error);
+        error.trim(); // remove line ending
+        DEBUG_HTTP_UPDATE("[httpUpdate] Update.end failed! (%s)\n", error.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_HTTPUPDATE)
 ESP8266HTTPUpdate ESPhttpUpdate;
 #endif
@@ -53,6 +53,7 @@ constexpr int HTTP_UE_SERVER_FAULTY_MD5         = (-105);
 constexpr int HTTP_UE_BIN_VERIFY_HEADER_FAILED  = (-106);
 constexpr int HTTP_UE_BIN_FOR_WRONG_FLASH       = (-107);
 constexpr int HTTP_UE_SERVER_UNAUTHORIZED       = (-108);
+constexpr int HTTP_UE_DELTA_MALFORMED           = (-109);
 
 enum HTTPUpdateResult {
     HTTP_UPDATE_FAILED,
@@ -138,6 +139,7 @@ public:
 protected:
     t_httpUpdate_return handleUpdate(HTTPClient& http, const String& currentVersion, bool spiffs = false);
     bool runUpdate(Stream& in, uint32_t size, const String& md5, int command = U_FLASH);
+    bool runDeltaUpdate(Stream& in, uint32_t size, const String& md5, int command = U_FLASH);
 
     // Set the error and potentially use a CB to notify the application
     void _setLastError(int err) {
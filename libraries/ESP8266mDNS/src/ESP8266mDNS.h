@@ -22,6 +22,16 @@
     See 'src/LEAmDNS.h' for implementation details, configuration and usage information.
     See 'examples/LEAmDNS/' for examples of the new features.
 
+    Build-time feature gates (flash/RAM budget knobs):
+    - -DMDNS_NO_SERVICE_QUERY
+      Removes service-query support (queryService()/installServiceQuery() and the
+      answer cache) from the build; the responder side (presenting and announcing
+      services) is unaffected.  Sketches that only advertise services save the whole
+      stcMDNSServiceQuery machinery - several KB of flash, plus the per-answer heap
+      churn while a query is live.  Calling the query API with the gate set fails at
+      link time.  To measure the gain for your sketch, compare the linker size report
+      (or 'tools/sizes.py --elf ...') for a build with and without the define.
+
     LEAmDNS is expected to be compatible with the original ESP8266mDNS implementation, and it can be
     used as a drop-in replacement in existing projects.
 
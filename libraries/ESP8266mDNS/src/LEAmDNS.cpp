@@ -54,7 +54,8 @@ namespace MDNSImplementation
     */
     MDNSResponder::MDNSResponder(void) :
         m_pServices(0), m_pUDPContext(0), m_pcHostname(0), m_pServiceQueries(0),
-        m_fnServiceTxtCallback(0), m_bLwipCb(false), m_bRestarting(false)
+        m_fnServiceTxtCallback(0), m_bLwipCb(false), m_bRestarting(false), m_pu8TxBuffer(0),
+        m_u16TxBufferUsed(0), m_u16TxBufferCapacity(0), m_u8QueryDigestVictim(0)
     {
     }
 
@@ -68,6 +69,9 @@ namespace MDNSImplementation
         _releaseHostname();
         _releaseUDPContext();
         _releaseServices();
+
+        free(m_pu8TxBuffer);
+        m_pu8TxBuffer = 0;
     }
 
     /*
@@ -671,6 +675,8 @@ namespace MDNSImplementation
         return addDynamicServiceTxt(p_hService, p_pcKey, acBuffer);
     }
 
+#ifdef MDNS_QUERY_SUPPORT
+
     /**
         STATIC SERVICE QUERY (LEGACY)
     */
@@ -1000,6 +1006,35 @@ namespace MDNSImplementation
         return (pSQAnswer ? pSQAnswer->m_pcHostDomain : 0);
     }
 
+    /*
+        MDNSResponder::answerGeneration (query)
+
+        Returns the query's generation counter; it advances on every mutation
+        of the cached answers.  0 for an invalid handle.
+    */
+    uint32_t
+    MDNSResponder::answerGeneration(const MDNSResponder::hMDNSServiceQuery p_hServiceQuery)
+    {
+        stcMDNSServiceQuery* pServiceQuery = _findServiceQuery(p_hServiceQuery);
+        return (pServiceQuery ? pServiceQuery->m_u32Generation : 0);
+    }
+
+    /*
+        MDNSResponder::answerGeneration (answer)
+
+        Returns the generation counter of a single cached answer; it advances
+        only on mutations of that answer.  0 for an invalid handle or index.
+    */
+    uint32_t
+    MDNSResponder::answerGeneration(const MDNSResponder::hMDNSServiceQuery p_hServiceQuery,
+                                    const uint32_t                         p_u32AnswerIndex)
+    {
+        stcMDNSServiceQuery*            pServiceQuery = _findServiceQuery(p_hServiceQuery);
+        stcMDNSServiceQuery::stcAnswer* pSQAnswer
+            = (pServiceQuery ? pServiceQuery->answerAtIndex(p_u32AnswerIndex) : 0);
+        return (pSQAnswer ? pSQAnswer->m_u32Generation : 0);
+    }
+
 #ifdef MDNS_IP4_SUPPORT
     /*
         MDNSResponder::hasAnswerIP4Address
@@ -1149,6 +1184,8 @@ namespace MDNSImplementation
         return (pSQAnswer ? pSQAnswer->m_pcTxts : 0);
     }
 
+#endif  // MDNS_QUERY_SUPPORT
+
     /*
         PROBING
     */
@@ -173,6 +173,15 @@ namespace MDNSImplementation
 */
 #define MDNS_UDPCONTEXT_TIMEOUT 50
 
+/*
+    Known-answer suppression cache for incoming queries: number of remembered
+    question-set digests and the window (ms) within which a repetition of an
+    answered query is dropped unanswered (RFC 6762 6. limits multicasting of
+    an unchanged record to once per second)
+*/
+#define MDNS_QUERY_DIGEST_CACHE_SIZE 8
+#define MDNS_QUERY_SUPPRESSION_WINDOW 1000
+
     /**
         MDNSResponder
     */
@@ -404,6 +413,16 @@ namespace MDNSImplementation
                                         const uint32_t          p_u32AnswerIndex);
         const char* answerHostDomain(const hMDNSServiceQuery p_hServiceQuery,
                                      const uint32_t          p_u32AnswerIndex);
+        // Generation counters for delta detection: the query generation
+        // advances on every cached-answer mutation (answer added/removed or
+        // any component changed), the per-answer generation only on
+        // mutations of that answer.  A continuously browsing client stores
+        // the last seen generation and skips all accessor (and String
+        // construction) work while it is unchanged - steady state costs one
+        // comparison instead of a cache walk.
+        uint32_t answerGeneration(const hMDNSServiceQuery p_hServiceQuery);
+        uint32_t answerGeneration(const hMDNSServiceQuery p_hServiceQuery,
+                                  const uint32_t          p_u32AnswerIndex);
 #ifdef MDNS_IP4_SUPPORT
         bool      hasAnswerIP4Address(const hMDNSServiceQuery p_hServiceQuery,
                                       const uint32_t          p_u32AnswerIndex);
@@ -924,6 +943,8 @@ namespace MDNSImplementation
             // announcements
             bool               m_bConflict;
             bool               m_bTiebreakNeeded;
+            bool m_bPendingAnnounce;  // announcement due in the current update
+                                      // pass (coalesced into one batched send)
             MDNSHostProbeFn    m_fnHostProbeResultCallback;
             MDNSServiceProbeFn m_fnServiceProbeResultCallback;
 
@@ -932,6 +953,17 @@ namespace MDNSImplementation
             bool clear(bool p_bClearUserdata = false);
         };
 
+        /**
+            stcQueryDigest
+        */
+        struct stcQueryDigest
+        {
+            uint32_t                          m_u32Digest;      // FNV-1a over the question set
+            esp8266::polledTimeout::oneShotMs m_WindowTimeout;  // Suppression window
+
+            stcQueryDigest(void);
+        };
+
         /**
             stcMDNSService
         */
@@ -1057,6 +1089,9 @@ namespace MDNSImplementation
                     m_pIP6Addresses;  // 3. level answer (AAAA, using host domain), eg. 1234::09
 #endif
                 uint32_t m_u32ContentFlags;
+                // advances on every content mutation of this answer
+                // (see stcMDNSServiceQuery::contentChanged)
+                uint32_t m_u32Generation;
 
                 stcAnswer(void);
                 ~stcAnswer(void);
@@ -1102,6 +1137,9 @@ namespace MDNSImplementation
             esp8266::polledTimeout::oneShotMs m_ResendTimeout;
             bool                              m_bAwaitingAnswers;
             stcAnswer*                        m_pAnswers;
+            // advances on every cached-answer mutation (answer added or
+            // removed, or any answer component changed)
+            uint32_t m_u32Generation;
 
             stcMDNSServiceQuery(void);
             ~stcMDNSServiceQuery(void);
@@ -1116,6 +1154,9 @@ namespace MDNSImplementation
             bool addAnswer(stcAnswer* p_pAnswer);
             bool removeAnswer(stcAnswer* p_pAnswer);
 
+            // advance the query generation (and the answer's, when given)
+            void contentChanged(stcAnswer* p_pAnswer);
+
             stcAnswer* findAnswerForServiceDomain(const stcMDNS_RRDomain& p_ServiceDomain);
             stcAnswer* findAnswerForHostDomain(const stcMDNS_RRDomain& p_HostDomain);
         };
@@ -1128,18 +1169,22 @@ namespace MDNSImplementation
         protected:
             /**
                 stcDomainCacheItem
+
+                One slot of the open-addressing name->offset hash table below.
+                An empty slot is marked by a null m_pHostnameOrService.
             */
             struct stcDomainCacheItem
             {
-                stcDomainCacheItem* m_pNext;
                 const void* m_pHostnameOrService;  // Opaque id for host or service domain (pointer)
                 bool m_bAdditionalData;  // Opaque flag for special info (service domain included)
                 uint16_t m_u16Offset;    // Offset in UDP output buffer
-
-                stcDomainCacheItem(const void* p_pHostnameOrService, bool p_bAdditionalData,
-                                   uint32_t p_u16Offset);
             };
 
+            // With host + service names per advertised service, 16 slots cover
+            // ~6 services before compression opportunities start being dropped
+            // (a full table only costs message size, never correctness)
+            static constexpr uint16_t DomainCacheSlots = 16;
+
         public:
             uint16_t            m_u16ID;            // Query ID (used only in lagacy queries)
             stcMDNS_RRQuestion* m_pQuestions;       // A list of queries
@@ -1151,7 +1196,7 @@ namespace MDNSImplementation
             bool                m_bUnicast;         // Flag: Unicast response
             bool                m_bUnannounce;      // Flag: Unannounce service
             uint16_t m_u16Offset;  // Current offset in UDP write buffer (mainly for domain cache)
-            stcDomainCacheItem* m_pDomainCacheItems;  // Cached host and service domains
+            stcDomainCacheItem m_DomainCache[DomainCacheSlots];  // Cached host and service domains
 
             stcMDNSSendParameter(void);
             ~stcMDNSSendParameter(void);
@@ -1176,6 +1221,11 @@ namespace MDNSImplementation
         stcProbeInformation               m_HostProbeInformation;
         bool                              m_bLwipCb;
         bool                              m_bRestarting;
+        uint8_t* m_pu8TxBuffer;  // Staging buffer: a whole message is serialized
+        uint16_t m_u16TxBufferUsed;      // here and handed to the UDP context in
+        uint16_t m_u16TxBufferCapacity;  // one single append (see _udpAppendBuffer)
+        stcQueryDigest m_QueryDigestCache[MDNS_QUERY_DIGEST_CACHE_SIZE];
+        uint8_t        m_u8QueryDigestVictim;  // Next cache slot to recycle
 
         /** CONTROL **/
         /* MAINTENANCE */
@@ -1186,6 +1236,10 @@ namespace MDNSImplementation
         bool _parseMessage(void);
         bool _parseQuery(const stcMDNS_MsgHeader& p_Header);
 
+        uint32_t _queryDigestFold(uint32_t p_u32Digest, const stcMDNS_RRQuestion& p_Question) const;
+        bool     _isQuerySuppressed(uint32_t p_u32QueryDigest);
+        void     _rememberQueryDigest(uint32_t p_u32QueryDigest);
+
         bool _parseResponse(const stcMDNS_MsgHeader& p_Header);
         bool _processAnswers(const stcMDNS_RRAnswer* p_pPTRAnswers);
         bool _processPTRAnswer(const stcMDNS_RRAnswerPTR* p_pPTRAnswer,
@@ -1206,6 +1260,9 @@ namespace MDNSImplementation
         bool _hasProbesWaitingForAnswers(void) const;
         bool _sendHostProbe(void);
         bool _sendServiceProbe(stcMDNSService& p_rService);
+        bool _appendHostProbe(stcMDNSSendParameter& p_rSendParameter);
+        bool _appendServiceProbe(stcMDNSSendParameter& p_rSendParameter,
+                                 stcMDNSService&       p_rService);
         bool _cancelProbingForHost(void);
         bool _cancelProbingForService(stcMDNSService& p_rService);
 
@@ -1274,6 +1331,9 @@ namespace MDNSImplementation
         bool _udpRead16(uint16_t& p_ru16Value);
         bool _udpRead32(uint32_t& p_ru32Value);
 
+        bool _resetTxBuffer(void);
+        bool _flushTxBuffer(void);
+
         bool _udpAppendBuffer(const unsigned char* p_pcBuffer, size_t p_stLength);
         bool _udpAppend8(uint8_t p_u8Value);
         bool _udpAppend16(uint16_t p_u16Value);
@@ -84,8 +84,10 @@ namespace MDNSImplementation
         }
         else
         {
-            bResult = _updateProbeStatus() &&     // Probing
-                      _checkServiceQueryCache();  // Service query cache check
+            bResult = _updateProbeStatus();  // Probing
+#ifdef MDNS_QUERY_SUPPORT
+            bResult = bResult && _checkServiceQueryCache();  // Service query cache check
+#endif
         }
         return bResult;
     }
@@ -190,10 +192,73 @@ namespace MDNSImplementation
 
         stcMDNSSendParameter sendParameter;
         uint8_t              u8HostOrServiceReplies = 0;
+
+        // Read all questions up-front, folding each into a digest of the question
+        // set. A repetition of a recently answered query can then be dropped after
+        // the cache lookup below, without walking all our records for every
+        // question again.
+        stcMDNS_RRQuestion* pQuestions        = 0;
+        uint32_t            u32QueryDigest    = 2166136261UL;  // FNV-1a offset basis
+        bool                bUnicastRequested = false;
         for (uint16_t qd = 0; ((bResult) && (qd < p_MsgHeader.m_u16QDCount)); ++qd)
         {
-            stcMDNS_RRQuestion questionRR;
-            if ((bResult = _readRRQuestion(questionRR)))
+            stcMDNS_RRQuestion* pQuestion = new stcMDNS_RRQuestion;
+            if ((bResult = ((0 != pQuestion) && (_readRRQuestion(*pQuestion)))))
+            {
+                u32QueryDigest = _queryDigestFold(u32QueryDigest, *pQuestion);
+                if (pQuestion->m_bUnicast)
+                {
+                    bUnicastRequested = true;
+                }
+                pQuestion->m_pNext = pQuestions;
+                pQuestions         = pQuestion;
+            }
+            else
+            {
+                delete pQuestion;
+                DEBUG_EX_ERR(DEBUG_OUTPUT.printf_P(
+                    PSTR("[MDNSResponder] _parseQuery: FAILED to read question!\n")););
+            }
+        }
+
+        uint32_t u32Answers
+            = (p_MsgHeader.m_u16ANCount + p_MsgHeader.m_u16NSCount + p_MsgHeader.m_u16ARCount);
+
+        // While we (or one of our services) are probing, every query needs the full
+        // tiebreak evaluation below and MUST NOT be suppressed
+        bool bProbingInProgress
+            = (ProbingStatus_InProgress == m_HostProbeInformation.m_ProbingStatus);
+        for (stcMDNSService* pService = m_pServices; ((!bProbingInProgress) && (pService));
+             pService                 = pService->m_pNext)
+        {
+            bProbingInProgress
+                = (ProbingStatus_InProgress == pService->m_ProbeInformation.m_ProbingStatus);
+        }
+
+        if ((bResult) && (0 == u32Answers)
+            &&  // No known-answer/authority records to evaluate AND
+            (DNS_MQUERY_PORT == m_pUDPContext->getRemotePort())
+            &&                       // Multicast (non-legacy) query AND
+            (!bUnicastRequested) &&  // No unicast response asked for AND
+            (!bProbingInProgress) && (_isQuerySuppressed(u32QueryDigest)))
+        {
+            DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(
+                PSTR("[MDNSResponder] _parseQuery: Duplicate query (digest 0x%08X) within "
+                     "suppression window... dropped!\n"),
+                (unsigned)u32QueryDigest););
+            while (pQuestions)
+            {
+                stcMDNS_RRQuestion* pNext = pQuestions->m_pNext;
+                delete pQuestions;
+                pQuestions = pNext;
+            }
+            return true;
+        }
+
+        for (stcMDNS_RRQuestion* pQuestion = pQuestions; ((bResult) && (pQuestion));
+             pQuestion                     = pQuestion->m_pNext)
+        {
+            stcMDNS_RRQuestion& questionRR = *pQuestion;
             {
                 // Define host replies, BUT only answer queries after probing is done
                 u8HostOrServiceReplies = sendParameter.m_u8HostReplyMask
@@ -337,11 +402,6 @@ namespace MDNSImplementation
                     }
                 }
             }
-            else
-            {
-                DEBUG_EX_ERR(DEBUG_OUTPUT.printf_P(
-                    PSTR("[MDNSResponder] _parseQuery: FAILED to read question!\n")););
-            }
         }  // for questions
 
         // DEBUG_EX_INFO(if (u8HostOrServiceReplies) { DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder]
@@ -351,8 +411,6 @@ namespace MDNSImplementation
         // IPAddress(m_pUDPContext->getDestAddress()).toString().c_str()); } );
 
         // Handle known answers
-        uint32_t u32Answers
-            = (p_MsgHeader.m_u16ANCount + p_MsgHeader.m_u16NSCount + p_MsgHeader.m_u16ARCount);
         DEBUG_EX_INFO(if ((u8HostOrServiceReplies) && (u32Answers)) {
             DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _parseQuery: Known answers(%u):\n"),
                                   u32Answers);
@@ -666,6 +724,13 @@ namespace MDNSImplementation
                 sendParameter.m_bAuthorative = true;
 
                 bResult = _sendMDNSMessage(sendParameter);
+
+                if ((bResult) && (!sendParameter.m_bUnicast))
+                {
+                    // Remember the answered question set; repetitions within the
+                    // suppression window are dropped unanswered
+                    _rememberQueryDigest(u32QueryDigest);
+                }
             }
             DEBUG_EX_INFO(else {
                 DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _parseQuery: No reply needed\n"));
@@ -698,12 +763,84 @@ namespace MDNSImplementation
                 pService->m_ProbeInformation.m_bTiebreakNeeded = false;
             }
         }
+
+        while (pQuestions)
+        {
+            stcMDNS_RRQuestion* pNext = pQuestions->m_pNext;
+            delete pQuestions;
+            pQuestions = pNext;
+        }
         DEBUG_EX_ERR(if (!bResult) {
             DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _parseQuery: FAILED!\n"));
         });
         return bResult;
     }
 
+    /*
+        MDNSResponder::_queryDigestFold
+
+        Folds one question into the digest (FNV-1a) of an incoming query's question
+        set. The unicast-response bit has already been stripped from the class by
+        '_readRRQuestion', so unicast and multicast variants of the same question
+        fold equal (they are told apart before the cache lookup).
+    */
+    uint32_t MDNSResponder::_queryDigestFold(uint32_t                  p_u32Digest,
+                                             const stcMDNS_RRQuestion& p_Question) const
+    {
+        const stcMDNS_RRHeader& header = p_Question.m_Header;
+        for (uint16_t i = 0; i < header.m_Domain.m_u16NameLength; ++i)
+        {
+            p_u32Digest = ((p_u32Digest ^ (uint8_t)header.m_Domain.m_acName[i]) * 16777619UL);
+        }
+        p_u32Digest = ((p_u32Digest ^ (uint8_t)(header.m_Attributes.m_u16Type & 0xFF)) * 16777619UL);
+        p_u32Digest = ((p_u32Digest ^ (uint8_t)(header.m_Attributes.m_u16Type >> 8)) * 16777619UL);
+        p_u32Digest
+            = ((p_u32Digest ^ (uint8_t)(header.m_Attributes.m_u16Class & 0xFF)) * 16777619UL);
+        p_u32Digest = ((p_u32Digest ^ (uint8_t)(header.m_Attributes.m_u16Class >> 8)) * 16777619UL);
+        return p_u32Digest;
+    }
+
+    /*
+        MDNSResponder::_isQuerySuppressed
+
+        Returns true, if a query with the given question-set digest has been
+        answered (via multicast) within the suppression window, so that the
+        repetition may be dropped unanswered.
+    */
+    bool MDNSResponder::_isQuerySuppressed(uint32_t p_u32QueryDigest)
+    {
+        for (stcQueryDigest& digest : m_QueryDigestCache)
+        {
+            if ((p_u32QueryDigest == digest.m_u32Digest) && (!digest.m_WindowTimeout.expired()))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+        MDNSResponder::_rememberQueryDigest
+
+        Stores the digest of a just answered (multicast) query. An existing entry
+        is refreshed; otherwise the oldest slot is recycled round-robin.
+    */
+    void MDNSResponder::_rememberQueryDigest(uint32_t p_u32QueryDigest)
+    {
+        for (stcQueryDigest& digest : m_QueryDigestCache)
+        {
+            if (p_u32QueryDigest == digest.m_u32Digest)
+            {
+                digest.m_WindowTimeout.reset(MDNS_QUERY_SUPPRESSION_WINDOW);
+                return;
+            }
+        }
+        stcQueryDigest& victim = m_QueryDigestCache[m_u8QueryDigestVictim];
+        m_u8QueryDigestVictim  = ((m_u8QueryDigestVictim + 1) % MDNS_QUERY_DIGEST_CACHE_SIZE);
+        victim.m_u32Digest     = p_u32QueryDigest;
+        victim.m_WindowTimeout.reset(MDNS_QUERY_SUPPRESSION_WINDOW);
+    }
+
     /*
         MDNSResponder::_parseResponse
 
@@ -739,8 +876,11 @@ namespace MDNSImplementation
         bool bResult = false;
 
         // A response should be the result of a query or a probe
-        if ((_hasServiceQueriesWaitingForAnswers()) ||  // Waiting for query answers OR
-            (_hasProbesWaitingForAnswers()))            // Probe responses
+        if (
+#ifdef MDNS_QUERY_SUPPORT
+            (_hasServiceQueriesWaitingForAnswers()) ||  // Waiting for query answers OR
+#endif
+            (_hasProbesWaitingForAnswers()))  // Probe responses
         {
             DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(
                 PSTR("[MDNSResponder] _parseResponse: Received a response\n"));
@@ -791,7 +931,9 @@ namespace MDNSImplementation
             // Process answers
             if (bResult)
             {
+#ifdef MDNS_QUERY_SUPPORT
                 bResult = ((!pCollectedRRAnswers) || (_processAnswers(pCollectedRRAnswers)));
+#endif
             }
             else  // Some failure while reading answers
             {
@@ -1082,6 +1224,7 @@ namespace MDNSImplementation
                             pSQAnswer->m_u16Port = p_pSRVAnswer->m_u16Port;
                             pSQAnswer->m_u32ContentFlags
                                 |= ServiceQueryAnswerType_HostDomainAndPort;
+                            pServiceQuery->contentChanged(pSQAnswer);
 
                             p_rbFoundNewKeyAnswer = true;
                             if (pServiceQuery->m_fnCallback)
@@ -1149,6 +1292,7 @@ namespace MDNSImplementation
                             pSQAnswer->m_Txts = p_pTXTAnswer->m_Txts;
                             pSQAnswer->m_u32ContentFlags |= ServiceQueryAnswerType_Txts;
                             pSQAnswer->releaseTxts();
+                            pServiceQuery->contentChanged(pSQAnswer);
 
                             if (pServiceQuery->m_fnCallback)
                             {
@@ -1238,6 +1382,7 @@ namespace MDNSImplementation
                             if ((pIP4Address) && (pSQAnswer->addIP4Address(pIP4Address)))
                             {
                                 pSQAnswer->m_u32ContentFlags |= ServiceQueryAnswerType_IP4Address;
+                                pServiceQuery->contentChanged(pSQAnswer);
                                 if (pServiceQuery->m_fnCallback)
                                 {
                                     MDNSServiceInfo serviceInfo(
@@ -1327,6 +1472,7 @@ namespace MDNSImplementation
                             if ((pIP6Address) && (pSQAnswer->addIP6Address(pIP6Address)))
                             {
                                 pSQAnswer->m_u32ContentFlags |= ServiceQueryAnswerType_IP6Address;
+                                pServiceQuery->contentChanged(pSQAnswer);
 
                                 if (pServiceQuery->m_fnCallback)
                                 {
@@ -1376,6 +1522,18 @@ namespace MDNSImplementation
     {
         bool bResult = true;
 
+        // Probes and announcements falling due in the same pass are coalesced
+        // into (at most) one probe query and one announcement response per
+        // timing round - RFC 6762 allows several questions/answers per
+        // message - so registering several services at boot costs one
+        // multicast per round instead of one per service.
+        stcMDNSSendParameter probeParameter;
+        probeParameter.m_bCacheFlush = false;  // RFC 6762 10.2
+        bool     bProbeHost          = false;
+        uint32_t u32PendingProbes    = 0;
+        bool     bAnnounceHost       = false;
+        uint32_t u32PendingAnnounces = 0;
+
         //
         // Probe host domain
         if (ProbingStatus_ReadyToStart == m_HostProbeInformation.m_ProbingStatus)
@@ -1393,17 +1551,18 @@ namespace MDNSImplementation
         {
             if (MDNS_PROBE_COUNT > m_HostProbeInformation.m_u8SentCount)  // Send next probe
             {
-                if ((bResult = _sendHostProbe()))
+                if ((bResult = _appendHostProbe(probeParameter)))
                 {
+                    bProbeHost = true;
                     DEBUG_EX_INFO(
-                        DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _updateProbeStatus: Did sent "
-                                                   "host probe to all links \n\n")););
+                        DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _updateProbeStatus: Queued "
+                                                   "host probe for this round\n\n")););
                 }
                 else
                 {
                     DEBUG_EX_INFO(
                         DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _updateProbeStatus: Did not "
-                                                   "sent host probe to all links\n\n")););
+                                                   "queue host probe\n\n")););
                 }
                 m_HostProbeInformation.m_Timeout.reset(MDNS_PROBE_DELAY);
                 ++m_HostProbeInformation.m_u8SentCount;
@@ -1429,7 +1588,7 @@ namespace MDNSImplementation
         else if ((ProbingStatus_Done == m_HostProbeInformation.m_ProbingStatus)
                  && (m_HostProbeInformation.m_Timeout.expired()))
         {
-            _announce(true, false);  // Don't announce services here
+            bAnnounceHost = true;  // Coalesced into the batched announcement below
 
             ++m_HostProbeInformation.m_u8SentCount;
 
@@ -1448,6 +1607,11 @@ namespace MDNSImplementation
             }
         }
 
+        // Services starting to probe in the same pass share one jittered
+        // deadline, so all their following probe and announcement rounds keep
+        // falling due together and coalesce into the same batched message
+        esp8266::polledTimeout::oneShotMs::timeType serviceStartDelay = 0;
+
         //
         // Probe services
         for (stcMDNSService* pService = m_pServices; ((bResult) && (pService));
@@ -1456,8 +1620,14 @@ namespace MDNSImplementation
             if (ProbingStatus_ReadyToStart
                 == pService->m_ProbeInformation.m_ProbingStatus)  // Ready to get started
             {
-                pService->m_ProbeInformation.m_Timeout.reset(
-                    MDNS_PROBE_DELAY);  // More or equal than first probe for host domain
+                if (0 == serviceStartDelay)
+                {
+                    // More or equal than first probe for host domain; the added
+                    // jitter desynchronizes us from other responders that
+                    // restarted at the same moment (eg. after a power cut)
+                    serviceStartDelay = MDNS_PROBE_DELAY + (rand() % (MDNS_PROBE_DELAY / 4));
+                }
+                pService->m_ProbeInformation.m_Timeout.reset(serviceStartDelay);
                 pService->m_ProbeInformation.m_ProbingStatus = ProbingStatus_InProgress;
             }
             else if ((ProbingStatus_InProgress == pService->m_ProbeInformation.m_ProbingStatus)
@@ -1467,19 +1637,19 @@ namespace MDNSImplementation
                 if (MDNS_PROBE_COUNT
                     > pService->m_ProbeInformation.m_u8SentCount)  // Send next probe
                 {
-                    if ((bResult = _sendServiceProbe(*pService)))
+                    if ((bResult = _appendServiceProbe(probeParameter, *pService)))
                     {
+                        ++u32PendingProbes;
                         DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(
-                            PSTR("[MDNSResponder] _updateProbeStatus: Did sent service probe to "
-                                 "all links "
+                            PSTR("[MDNSResponder] _updateProbeStatus: Queued service probe for "
+                                 "this round "
                                  "(%u)\n\n"),
                             (pService->m_ProbeInformation.m_u8SentCount + 1)););
                     }
                     else
                     {
                         DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(
-                            PSTR("[MDNSResponder] _updateProbeStatus: Did not sent service probe "
-                                 "to all links"
+                            PSTR("[MDNSResponder] _updateProbeStatus: Did not queue service probe "
                                  "(%u)\n\n"),
                             (pService->m_ProbeInformation.m_u8SentCount + 1)););
                     }
@@ -1510,7 +1680,9 @@ namespace MDNSImplementation
             else if ((ProbingStatus_Done == pService->m_ProbeInformation.m_ProbingStatus)
                      && (pService->m_ProbeInformation.m_Timeout.expired()))
             {
-                _announceService(*pService);  // Announce service
+                // Coalesced into the batched announcement below
+                pService->m_ProbeInformation.m_bPendingAnnounce = true;
+                ++u32PendingAnnounces;
 
                 ++pService->m_ProbeInformation.m_u8SentCount;
 
@@ -1534,6 +1706,53 @@ namespace MDNSImplementation
                 }
             }
         }
+
+        // Send the batched probe query (host and/or service questions)
+        if ((bResult) && ((bProbeHost) || (0 != u32PendingProbes)))
+        {
+            DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(
+                PSTR("[MDNSResponder] _updateProbeStatus: Sending batched probe (host: %s, "
+                     "services: %u)\n\n"),
+                (bProbeHost ? "yes" : "no"), u32PendingProbes););
+            bResult = _sendMDNSMessage(probeParameter);
+        }
+
+        // Send the batched announcement; this MUST follow the probe message,
+        // as '_sendMDNSMessage' clears all service reply masks after sending
+        if ((bResult) && ((bAnnounceHost) || (0 != u32PendingAnnounces)))
+        {
+            stcMDNSSendParameter announceParameter;
+            announceParameter.m_bResponse
+                = true;  // Announces are 'Unsolicited authoritative responses'
+            announceParameter.m_bAuthorative = true;
+
+            if (bAnnounceHost)
+            {
+#ifdef MDNS_IP4_SUPPORT
+                announceParameter.m_u8HostReplyMask |= ContentFlag_A;        // A answer
+                announceParameter.m_u8HostReplyMask |= ContentFlag_PTR_IP4;  // PTR_IP4 answer
+#endif
+#ifdef MDNS_IP6_SUPPORT
+                announceParameter.m_u8HostReplyMask |= ContentFlag_AAAA;     // AAAA answer
+                announceParameter.m_u8HostReplyMask |= ContentFlag_PTR_IP6;  // PTR_IP6 answer
+#endif
+            }
+            for (stcMDNSService* pService = m_pServices; pService; pService = pService->m_pNext)
+            {
+                if (pService->m_ProbeInformation.m_bPendingAnnounce)
+                {
+                    // Announce service (service type, name, SRV (location) and TXTs)
+                    pService->m_u8ReplyMask = (ContentFlag_PTR_TYPE | ContentFlag_PTR_NAME
+                                               | ContentFlag_SRV | ContentFlag_TXT);
+                    pService->m_ProbeInformation.m_bPendingAnnounce = false;
+                }
+            }
+            DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(
+                PSTR("[MDNSResponder] _updateProbeStatus: Sending batched announcement (host: %s, "
+                     "services: %u)\n\n"),
+                (bAnnounceHost ? "yes" : "no"), u32PendingAnnounces););
+            bResult = _sendMDNSMessage(announceParameter);
+        }
         DEBUG_EX_ERR(if (!bResult) {
             DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _updateProbeStatus: FAILED!\n\n"));
         });
@@ -1598,44 +1817,62 @@ namespace MDNSImplementation
         DEBUG_EX_INFO(DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _sendHostProbe (%s, %lu)\n"),
                                             m_pcHostname, millis()););
 
-        bool bResult = true;
-
         // Requests for host domain
         stcMDNSSendParameter sendParameter;
         sendParameter.m_bCacheFlush = false;  // RFC 6762 10.2
 
-        sendParameter.m_pQuestions = new stcMDNS_RRQuestion;
-        if (((bResult = (0 != sendParameter.m_pQuestions)))
-            && ((bResult = _buildDomainForHost(m_pcHostname,
-                                               sendParameter.m_pQuestions->m_Header.m_Domain))))
+        bool bResult = _appendHostProbe(sendParameter);
+        DEBUG_EX_ERR(if (!bResult) {
+            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _sendHostProbe: FAILED!\n"));
+        });
+        return ((bResult) && (_sendMDNSMessage(sendParameter)));
+    }
+
+    /*
+        MDNSResponder::_appendHostProbe
+
+        Adds the probe question (and known answer flags) for the host domain to an
+        outgoing (probe) message. Several probe questions may share one message
+        (see '_updateProbeStatus').
+    */
+    bool MDNSResponder::_appendHostProbe(stcMDNSSendParameter& p_rSendParameter)
+    {
+        bool bResult = true;
+
+        stcMDNS_RRQuestion* pQuestion = new stcMDNS_RRQuestion;
+        if (((bResult = (0 != pQuestion)))
+            && ((bResult = _buildDomainForHost(m_pcHostname, pQuestion->m_Header.m_Domain))))
         {
-            // sendParameter.m_pQuestions->m_bUnicast = true;
-            sendParameter.m_pQuestions->m_Header.m_Attributes.m_u16Type = DNS_RRTYPE_ANY;
-            sendParameter.m_pQuestions->m_Header.m_Attributes.m_u16Class
+            // pQuestion->m_bUnicast = true;
+            pQuestion->m_Header.m_Attributes.m_u16Type = DNS_RRTYPE_ANY;
+            pQuestion->m_Header.m_Attributes.m_u16Class
                 = (0x8000 | DNS_RRCLASS_IN);  // Unicast & INternet
 
+            pQuestion->m_pNext           = p_rSendParameter.m_pQuestions;
+            p_rSendParameter.m_pQuestions = pQuestion;
+
             // Add known answers
 #ifdef MDNS_IP4_SUPPORT
-            sendParameter.m_u8HostReplyMask |= ContentFlag_A;  // Add A answer
+            p_rSendParameter.m_u8HostReplyMask |= ContentFlag_A;  // Add A answer
 #endif
 #ifdef MDNS_IP6_SUPPORT
-            sendParameter.m_u8HostReplyMask |= ContentFlag_AAAA;  // Add AAAA answer
+            p_rSendParameter.m_u8HostReplyMask |= ContentFlag_AAAA;  // Add AAAA answer
 #endif
         }
         else
         {
             DEBUG_EX_ERR(DEBUG_OUTPUT.printf_P(
-                PSTR("[MDNSResponder] _sendHostProbe: FAILED to create host question!\n")););
-            if (sendParameter.m_pQuestions)
+                PSTR("[MDNSResponder] _appendHostProbe: FAILED to create host question!\n")););
+            if (pQuestion)
             {
-                delete sendParameter.m_pQuestions;
-                sendParameter.m_pQuestions = 0;
+                delete pQuestion;
+                pQuestion = 0;
             }
         }
         DEBUG_EX_ERR(if (!bResult) {
-            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _sendHostProbe: FAILED!\n"));
+            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _appendHostProbe: FAILED!\n"));
         });
-        return ((bResult) && (_sendMDNSMessage(sendParameter)));
+        return bResult;
     }
 
     /*
@@ -1658,40 +1895,59 @@ namespace MDNSImplementation
                                   (p_rService.m_pcName ?: m_pcHostname), p_rService.m_pcService,
                                   p_rService.m_pcProtocol, millis()););
 
-        bool bResult = true;
-
         // Requests for service instance domain
         stcMDNSSendParameter sendParameter;
         sendParameter.m_bCacheFlush = false;  // RFC 6762 10.2
 
-        sendParameter.m_pQuestions = new stcMDNS_RRQuestion;
-        if (((bResult = (0 != sendParameter.m_pQuestions)))
-            && ((bResult = _buildDomainForService(p_rService, true,
-                                                  sendParameter.m_pQuestions->m_Header.m_Domain))))
+        bool bResult = _appendServiceProbe(sendParameter, p_rService);
+        DEBUG_EX_ERR(if (!bResult) {
+            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _sendServiceProbe: FAILED!\n"));
+        });
+        return ((bResult) && (_sendMDNSMessage(sendParameter)));
+    }
+
+    /*
+        MDNSResponder::_appendServiceProbe
+
+        Adds the probe question (and known answer flags) for a service instance domain
+        to an outgoing (probe) message. Several probe questions may share one message
+        (see '_updateProbeStatus').
+    */
+    bool MDNSResponder::_appendServiceProbe(stcMDNSSendParameter& p_rSendParameter,
+                                            stcMDNSService&       p_rService)
+    {
+        bool bResult = true;
+
+        stcMDNS_RRQuestion* pQuestion = new stcMDNS_RRQuestion;
+        if (((bResult = (0 != pQuestion)))
+            && ((bResult = _buildDomainForService(p_rService, true, pQuestion->m_Header.m_Domain))))
         {
-            sendParameter.m_pQuestions->m_bUnicast                      = true;
-            sendParameter.m_pQuestions->m_Header.m_Attributes.m_u16Type = DNS_RRTYPE_ANY;
-            sendParameter.m_pQuestions->m_Header.m_Attributes.m_u16Class
+            pQuestion->m_bUnicast                      = true;
+            pQuestion->m_Header.m_Attributes.m_u16Type = DNS_RRTYPE_ANY;
+            pQuestion->m_Header.m_Attributes.m_u16Class
                 = (0x8000 | DNS_RRCLASS_IN);  // Unicast & INternet
 
+            pQuestion->m_pNext            = p_rSendParameter.m_pQuestions;
+            p_rSendParameter.m_pQuestions = pQuestion;
+
             // Add known answers
             p_rService.m_u8ReplyMask
                 = (ContentFlag_SRV | ContentFlag_PTR_NAME);  // Add SRV and PTR NAME answers
         }
         else
         {
-            DEBUG_EX_ERR(DEBUG_OUTPUT.printf_P(
-                PSTR("[MDNSResponder] _sendServiceProbe: FAILED to create service question!\n")););
-            if (sendParameter.m_pQuestions)
+            DEBUG_EX_ERR(DEBUG_OUTPUT.printf_P(PSTR(
+                "[MDNSResponder] _appendServiceProbe: FAILED to create service question!\n")););
+            if (pQuestion)
             {
-                delete sendParameter.m_pQuestions;
-                sendParameter.m_pQuestions = 0;
+                delete pQuestion;
+                pQuestion = 0;
             }
         }
         DEBUG_EX_ERR(if (!bResult) {
-            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _sendServiceProbe: FAILED!\n"));
+            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _appendServiceProbe: FAILED!\n"));
         });
-        return ((bResult) && (_sendMDNSMessage(sendParameter)));
+        return bResult;
     }
 
     /*
@@ -2002,6 +2258,7 @@ namespace MDNSImplementation
 
                             // Remove content flags for deleted answer parts
                             pSQAnswer->m_u32ContentFlags &= ~u32ContentFlags;
+                            pServiceQuery->contentChanged(pSQAnswer);
                             if (pServiceQuery->m_fnCallback)
                             {
                                 MDNSServiceInfo serviceInfo(
@@ -2043,6 +2300,7 @@ namespace MDNSImplementation
 
                             // Remove content flags for deleted answer parts
                             pSQAnswer->m_u32ContentFlags &= ~ServiceQueryAnswerType_Txts;
+                            pServiceQuery->contentChanged(pSQAnswer);
 
                             if (pServiceQuery->m_fnCallback)
                             {
@@ -2106,6 +2364,7 @@ namespace MDNSImplementation
                                     pSQAnswer->m_u32ContentFlags
                                         &= ~ServiceQueryAnswerType_IP4Address;
                                 }
+                                pServiceQuery->contentChanged(pSQAnswer);
                                 // Notify client
                                 if (pServiceQuery->m_fnCallback)
                                 {
@@ -2172,6 +2431,7 @@ namespace MDNSImplementation
                                     pSQAnswer->m_u32ContentFlags
                                         &= ~ServiceQueryAnswerType_IP6Address;
                                 }
+                                pServiceQuery->contentChanged(pSQAnswer);
                                 // Notify client
                                 if (pServiceQuery->m_fnCallback)
                                 {
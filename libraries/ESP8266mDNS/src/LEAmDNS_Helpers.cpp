@@ -316,12 +316,16 @@ namespace MDNSImplementation
     */
     bool MDNSResponder::_releaseServiceQueries(void)
     {
+#ifdef MDNS_QUERY_SUPPORT
+        // without query support no query is ever allocated; keeping the loop out
+        // of the build lets --gc-sections drop the stcMDNSServiceQuery dtor chain
         while (m_pServiceQueries)
         {
             stcMDNSServiceQuery* pNext = m_pServiceQueries->m_pNext;
             delete m_pServiceQueries;
             m_pServiceQueries = pNext;
         }
+#endif
         return true;
     }
 
@@ -53,6 +53,15 @@ namespace MDNSImplementation
 // loop
 //#define ENABLE_ESP_MDNS_RESPONDER_PASSIV_MODE
 
+//
+// Service-query support (MDNS.queryService()/installServiceQuery() and the answer cache).
+// Responder-only sketches can build with -DMDNS_NO_SERVICE_QUERY to cut the query machinery
+// out of the update() path; --gc-sections then drops the whole stcMDNSServiceQuery apparatus
+// from the image. See the feature-gate notes in ESP8266mDNS.h.
+#ifndef MDNS_NO_SERVICE_QUERY
+#define MDNS_QUERY_SUPPORT
+#endif
+
 // Enable/disable debug trace macros
 #if defined(DEBUG_ESP_PORT) && defined(DEBUG_ESP_MDNS_RESPONDER)
 #define DEBUG_ESP_MDNS_INFO
@@ -152,6 +161,12 @@ namespace MDNSImplementation
 #define MDNS_SRV_PRIORITY 0
 #define MDNS_SRV_WEIGHT 0
 
+/*
+    Initial size of the message staging buffer; grows by doubling when a
+    response doesn't fit (typical responses stay below one MTU)
+*/
+#define MDNS_TX_BUFFER_MIN_SIZE 512
+
 /*
     Delay between and number of probes for host and service domains
     Delay between and number of announces for host and service domains
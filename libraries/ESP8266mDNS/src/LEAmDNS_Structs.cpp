@@ -1173,7 +1173,8 @@ namespace MDNSImplementation
     MDNSResponder::stcProbeInformation::stcProbeInformation(void) :
         m_ProbingStatus(ProbingStatus_WaitingForData), m_u8SentCount(0),
         m_Timeout(esp8266::polledTimeout::oneShotMs::neverExpires), m_bConflict(false),
-        m_bTiebreakNeeded(false), m_fnHostProbeResultCallback(0), m_fnServiceProbeResultCallback(0)
+        m_bTiebreakNeeded(false), m_bPendingAnnounce(false), m_fnHostProbeResultCallback(0),
+        m_fnServiceProbeResultCallback(0)
     {
     }
 
@@ -1185,8 +1186,9 @@ namespace MDNSImplementation
         m_ProbingStatus = ProbingStatus_WaitingForData;
         m_u8SentCount   = 0;
         m_Timeout.resetToNeverExpires();
-        m_bConflict       = false;
-        m_bTiebreakNeeded = false;
+        m_bConflict        = false;
+        m_bTiebreakNeeded  = false;
+        m_bPendingAnnounce = false;
         if (p_bClearUserdata)
         {
             m_fnHostProbeResultCallback    = 0;
@@ -1195,6 +1197,23 @@ namespace MDNSImplementation
         return true;
     }
 
+    /**
+        MDNSResponder::stcQueryDigest
+
+        One slot of the known-answer suppression cache: the digest of an answered
+        query's question set and the window within which a repetition of that
+        query may be dropped unanswered (see '_parseQuery').
+        An empty slot reports its window as expired, so it never suppresses.
+    */
+
+    /*
+        MDNSResponder::stcQueryDigest::stcQueryDigest constructor
+    */
+    MDNSResponder::stcQueryDigest::stcQueryDigest(void) :
+        m_u32Digest(0), m_WindowTimeout(esp8266::polledTimeout::oneShotMs::alwaysExpired)
+    {
+    }
+
     /**
         MDNSResponder::stcMDNSService
 
@@ -1561,7 +1580,7 @@ namespace MDNSImplementation
 #ifdef MDNS_IP6_SUPPORT
         m_pIP6Addresses(0),
 #endif
-        m_u32ContentFlags(0)
+        m_u32ContentFlags(0), m_u32Generation(0)
     {
     }
 
@@ -1971,7 +1990,7 @@ namespace MDNSImplementation
     MDNSResponder::stcMDNSServiceQuery::stcMDNSServiceQuery(void) :
         m_pNext(0), m_fnCallback(0), m_bLegacyQuery(false), m_u8SentCount(0),
         m_ResendTimeout(esp8266::polledTimeout::oneShotMs::neverExpires), m_bAwaitingAnswers(true),
-        m_pAnswers(0)
+        m_pAnswers(0), m_u32Generation(0)
     {
         clear();
     }
@@ -2076,7 +2095,8 @@ namespace MDNSImplementation
         {
             p_pAnswer->m_pNext = m_pAnswers;
             m_pAnswers         = p_pAnswer;
-            bResult            = true;
+            contentChanged(p_pAnswer);
+            bResult = true;
         }
         return bResult;
     }
@@ -2109,9 +2129,29 @@ namespace MDNSImplementation
                 bResult = true;
             }
         }
+        if (bResult)
+        {
+            contentChanged(0);
+        }
         return bResult;
     }
 
+    /*
+        MDNSResponder::stcMDNSServiceQuery::contentChanged
+
+        Advances the generation counters used by clients for delta
+        detection (see MDNSResponder::answerGeneration).
+    */
+    void MDNSResponder::stcMDNSServiceQuery::contentChanged(
+        MDNSResponder::stcMDNSServiceQuery::stcAnswer* p_pAnswer)
+    {
+        ++m_u32Generation;
+        if (p_pAnswer)
+        {
+            ++p_pAnswer->m_u32Generation;
+        }
+    }
+
     /*
         MDNSResponder::stcMDNSServiceQuery::findAnswerForServiceDomain
     */
@@ -2164,18 +2204,15 @@ namespace MDNSImplementation
         MDNSResponder::stcMDNSSendParameter::stcDomainCacheItem
 
         A cached host or service domain, incl. the offset in the UDP output buffer.
+        Kept in a small open-addressing hash table (keyed on the opaque pointer),
+        so lookups stay cheap even with many services advertised.
 
     */
 
-    /*
-        MDNSResponder::stcMDNSSendParameter::stcDomainCacheItem::stcDomainCacheItem constructor
-    */
-    MDNSResponder::stcMDNSSendParameter::stcDomainCacheItem::stcDomainCacheItem(
-        const void* p_pHostnameOrService, bool p_bAdditionalData, uint32_t p_u16Offset) :
-        m_pNext(0),
-        m_pHostnameOrService(p_pHostnameOrService), m_bAdditionalData(p_bAdditionalData),
-        m_u16Offset(p_u16Offset)
+    // Knuth multiplicative hash on the (aligned) object pointer
+    static inline uint16_t domainCacheHash(const void* p_pHostnameOrService)
     {
+        return (uint16_t)(((uintptr_t)p_pHostnameOrService >> 2) * 2654435761u);
     }
 
     /**
@@ -2185,8 +2222,7 @@ namespace MDNSImplementation
     /*
         MDNSResponder::stcMDNSSendParameter::stcMDNSSendParameter constructor
     */
-    MDNSResponder::stcMDNSSendParameter::stcMDNSSendParameter(void) :
-        m_pQuestions(0), m_pDomainCacheItems(0)
+    MDNSResponder::stcMDNSSendParameter::stcMDNSSendParameter(void) : m_pQuestions(0)
     {
         clear();
     }
@@ -2233,13 +2269,10 @@ namespace MDNSImplementation
     {
         m_u16Offset = 0;
 
-        while (m_pDomainCacheItems)
+        for (uint16_t u16Slot = 0; u16Slot < DomainCacheSlots; ++u16Slot)
         {
-            stcDomainCacheItem* pNext = m_pDomainCacheItems->m_pNext;
-            delete m_pDomainCacheItems;
-            m_pDomainCacheItems = pNext;
+            m_DomainCache[u16Slot] = stcDomainCacheItem { nullptr, false, 0 };
         }
-        m_pDomainCacheItems = nullptr;
 
         return true;
     }
@@ -2260,17 +2293,27 @@ namespace MDNSImplementation
                                                                  bool        p_bAdditionalData,
                                                                  uint16_t    p_u16Offset)
     {
-        bool bResult = false;
+        if ((!p_pHostnameOrService) || (!p_u16Offset))
+        {
+            return false;
+        }
 
-        stcDomainCacheItem* pNewItem = 0;
-        if ((p_pHostnameOrService) && (p_u16Offset)
-            && ((pNewItem
-                 = new stcDomainCacheItem(p_pHostnameOrService, p_bAdditionalData, p_u16Offset))))
+        uint16_t u16Slot = domainCacheHash(p_pHostnameOrService) % DomainCacheSlots;
+        for (uint16_t u16Probe = 0; u16Probe < DomainCacheSlots;
+             ++u16Probe, u16Slot = (u16Slot + 1) % DomainCacheSlots)
         {
-            pNewItem->m_pNext = m_pDomainCacheItems;
-            bResult           = ((m_pDomainCacheItems = pNewItem));
+            stcDomainCacheItem& rItem = m_DomainCache[u16Slot];
+            if ((!rItem.m_pHostnameOrService)
+                || ((rItem.m_pHostnameOrService == p_pHostnameOrService)
+                    && (rItem.m_bAdditionalData == p_bAdditionalData)))
+            {
+                rItem = stcDomainCacheItem { p_pHostnameOrService, p_bAdditionalData, p_u16Offset };
+                return true;
+            }
         }
-        return bResult;
+        // Table full: the name simply isn't compressed in later references,
+        // which costs message bytes but keeps the message valid
+        return true;
     }
 
     /*
@@ -2280,17 +2323,22 @@ namespace MDNSImplementation
     MDNSResponder::stcMDNSSendParameter::findCachedDomainOffset(const void* p_pHostnameOrService,
                                                                 bool        p_bAdditionalData) const
     {
-        const stcDomainCacheItem* pCacheItem = m_pDomainCacheItems;
-
-        for (; pCacheItem; pCacheItem = pCacheItem->m_pNext)
+        uint16_t u16Slot = domainCacheHash(p_pHostnameOrService) % DomainCacheSlots;
+        for (uint16_t u16Probe = 0; u16Probe < DomainCacheSlots;
+             ++u16Probe, u16Slot = (u16Slot + 1) % DomainCacheSlots)
         {
-            if ((pCacheItem->m_pHostnameOrService == p_pHostnameOrService)
-                && (pCacheItem->m_bAdditionalData == p_bAdditionalData))  // Found cache item
+            const stcDomainCacheItem& rItem = m_DomainCache[u16Slot];
+            if (!rItem.m_pHostnameOrService)  // Empty slot ends the probe chain
             {
                 break;
             }
+            if ((rItem.m_pHostnameOrService == p_pHostnameOrService)
+                && (rItem.m_bAdditionalData == p_bAdditionalData))  // Found cache item
+            {
+                return rItem.m_u16Offset;
+            }
         }
-        return (pCacheItem ? pCacheItem->m_u16Offset : 0);
+        return 0;
     }
 
 }  // namespace MDNSImplementation
@@ -168,6 +168,7 @@ namespace MDNSImplementation
         bool bResult = true;
         p_rSendParameter.clearCachedNames();  // Need to remove cached names, p_SendParameter might
                                               // have been used before on other interface
+        _resetTxBuffer();  // Message is staged here and flushed in one single append below
 
         // Prepare header; count answers
         stcMDNS_MsgHeader msgHeader(p_rSendParameter.m_u16ID, p_rSendParameter.m_bResponse, 0,
@@ -381,6 +382,9 @@ namespace MDNSImplementation
             DEBUG_EX_ERR(if (!bResult) DEBUG_OUTPUT.printf_P(
                 PSTR("[MDNSResponder] _prepareMDNSMessage: Loop %i FAILED!\n"), sequence););
         }  // for sequence
+
+        bResult = ((bResult) && (_flushTxBuffer()));
+
         DEBUG_EX_ERR(if (!bResult) DEBUG_OUTPUT.printf_P(
             PSTR("[MDNSResponder] _prepareMDNSMessage: FAILED!\n")););
         return bResult;
@@ -1155,14 +1159,75 @@ namespace MDNSImplementation
         return bResult;
     }
 
+    /*
+        MDNSResponder::_resetTxBuffer
+    */
+    bool MDNSResponder::_resetTxBuffer(void)
+    {
+        m_u16TxBufferUsed = 0;
+        return true;
+    }
+
+    /*
+        MDNSResponder::_flushTxBuffer
+
+        Hands the staged message to the UDP context in one single append, so
+        each message leaves as one datagram write instead of dozens of small
+        pbuf appends.
+    */
+    bool MDNSResponder::_flushTxBuffer(void)
+    {
+        bool bResult
+            = ((!m_u16TxBufferUsed)
+               || ((m_pUDPContext)
+                   && (m_u16TxBufferUsed
+                       == m_pUDPContext->append((const char*)m_pu8TxBuffer, m_u16TxBufferUsed))));
+        m_u16TxBufferUsed = 0;
+
+        DEBUG_EX_ERR(if (!bResult) {
+            DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _flushTxBuffer: FAILED!\n"));
+        });
+        return bResult;
+    }
+
     /*
         MDNSResponder::_udpAppendBuffer
+
+        Appends to the staging buffer (growing it by doubling when needed);
+        nothing touches the UDP context until _flushTxBuffer.
     */
     bool MDNSResponder::_udpAppendBuffer(const unsigned char* p_pcBuffer, size_t p_stLength)
     {
-        bool bResult
-            = ((m_pUDPContext) && (p_pcBuffer) && (p_stLength)
-               && (p_stLength == m_pUDPContext->append((const char*)p_pcBuffer, p_stLength)));
+        bool bResult = ((p_pcBuffer) && (p_stLength)
+                        && (((size_t)m_u16TxBufferUsed + p_stLength) <= 0xFFFFu));
+        if ((bResult) && ((size_t)(m_u16TxBufferCapacity - m_u16TxBufferUsed) < p_stLength))
+        {
+            size_t stNewCapacity
+                = (m_u16TxBufferCapacity ? m_u16TxBufferCapacity : MDNS_TX_BUFFER_MIN_SIZE);
+            while (stNewCapacity < ((size_t)m_u16TxBufferUsed + p_stLength))
+            {
+                stNewCapacity *= 2;
+            }
+            if (stNewCapacity > 0xFFFFu)  // capacity is tracked in an uint16_t
+            {
+                stNewCapacity = 0xFFFFu;
+            }
+            uint8_t* pu8NewBuffer = (uint8_t*)realloc(m_pu8TxBuffer, stNewCapacity);
+            if (pu8NewBuffer)
+            {
+                m_pu8TxBuffer         = pu8NewBuffer;
+                m_u16TxBufferCapacity = stNewCapacity;
+            }
+            else
+            {
+                bResult = false;
+            }
+        }
+        if (bResult)
+        {
+            memcpy(m_pu8TxBuffer + m_u16TxBufferUsed, p_pcBuffer, p_stLength);
+            m_u16TxBufferUsed += p_stLength;
+        }
         DEBUG_EX_ERR(if (!bResult) {
             DEBUG_OUTPUT.printf_P(PSTR("[MDNSResponder] _udpAppendBuffer: FAILED!\n"));
         });
@@ -0,0 +1,276 @@
+/*
+ EdgeSerial.cpp - software serial port driven by edge timestamps
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "EdgeSerial.h"
+#include <interrupts.h>
+#include <esp8266_peri.h>
+#include <PolledTimeout.h>
+
+// Longest run of equal bits fed into the frame assembler per edge interval.
+// Bounds the decode work for arbitrarily long breaks or idle-low glitches:
+// enough to finish any frame in progress and re-arm start bit hunting.
+static constexpr uint32_t MAX_BITS_PER_INTERVAL = 40;
+
+EdgeSerial::EdgeSerial(int8_t rxPin, int8_t txPin, bool invert)
+    : _rxPin(rxPin), _txPin(txPin), _invert(invert)
+{
+}
+
+EdgeSerial::~EdgeSerial()
+{
+    end();
+}
+
+bool EdgeSerial::begin(uint32_t baud, size_t rxBytes, size_t edgeCapacity)
+{
+    if (!baud) {
+        return false;
+    }
+    end();
+    // cycle counter runs at the CPU clock, so recompute on begin() rather
+    // than baking in F_CPU
+    _bitCcys = ESP.getCpuFreqMHz() * 1000000UL / baud;
+    if (_rxPin >= 0) {
+        if (_rxPin > 15 || isFlashInterfacePin(_rxPin)) {
+            return false;
+        }
+        _edges = new (std::nothrow) spsc_ringbuf<uint32_t>(edgeCapacity);
+        _rxBuf = new (std::nothrow) spsc_ringbuf<uint8_t>(rxBytes);
+        if (!_edges || !_rxBuf || !_edges->valid() || !_rxBuf->valid()) {
+            end();
+            return false;
+        }
+        pinMode(_rxPin, _invert ? INPUT : INPUT_PULLUP);
+        _lastEdgeCcy = ESP.getCycleCount();
+        _lastLevel = true;
+        _inFrame = false;
+        _rxOverflows = 0;
+        _framingErrors = 0;
+        attachInterruptArg(_rxPin, _rxEdgeISR, this, CHANGE);
+    }
+    if (_txPin >= 0) {
+        pinMode(_txPin, OUTPUT);
+        digitalWrite(_txPin, _invert ? LOW : HIGH); // idle mark
+    }
+    if (_txEnablePin >= 0) {
+        pinMode(_txEnablePin, OUTPUT);
+        digitalWrite(_txEnablePin, LOW);
+    }
+    _baud = baud;
+    return true;
+}
+
+void EdgeSerial::end()
+{
+    if (_edges) {
+        detachInterrupt(_rxPin);
+    }
+    delete _edges;
+    _edges = nullptr;
+    delete _rxBuf;
+    _rxBuf = nullptr;
+    _baud = 0;
+}
+
+void EdgeSerial::setTransmitEnablePin(int8_t pin)
+{
+    _txEnablePin = pin;
+    if (_txEnablePin >= 0 && _baud) {
+        pinMode(_txEnablePin, OUTPUT);
+        digitalWrite(_txEnablePin, LOW);
+    }
+}
+
+// Producer side: one bounded push per edge, no sampling loops. The new pin
+// level is folded into bit 0 of the timestamp; one cycle (12.5ns at 80MHz)
+// is far below any bit period, so the LSB is free.
+void IRAM_ATTR EdgeSerial::_rxEdgeISR(void* arg)
+{
+    EdgeSerial* self = static_cast<EdgeSerial*>(arg);
+    const uint32_t ccy = ESP.getCycleCount();
+    const uint32_t level = GPIP(self->_rxPin) ? 1 : 0;
+    if (!self->_edges->push((ccy & ~1UL) | level)) {
+        self->_rxOverflows = self->_rxOverflows + 1;
+    }
+}
+
+// Consumer side: turn each edge interval into a run of equal bits. Runs in
+// user context from available()/read(), so a delayed decode only delays data
+// delivery - it cannot corrupt the frame timing the ISR already captured.
+void EdgeSerial::_decode()
+{
+    if (!_edges) {
+        return;
+    }
+    uint32_t edge;
+    while (_edges->pop(edge)) {
+        const bool levelAfter = static_cast<bool>(edge & 1) ^ _invert;
+        const uint32_t ccy = edge & ~1UL;
+        const uint32_t bits = ((ccy - _lastEdgeCcy) + _bitCcys / 2) / _bitCcys;
+        _feedBits(bits, !levelAfter);
+        _lastEdgeCcy = ccy;
+        _lastLevel = levelAfter;
+    }
+    // Mid-frame with the line back at mark: no further edges arrive when the
+    // remaining data bits and the stop bit are all ones, so close the frame
+    // as soon as its time has fully elapsed.
+    if (_inFrame && _lastLevel) {
+        const uint32_t idleBits = (ESP.getCycleCount() - _lastEdgeCcy) / _bitCcys;
+        const uint32_t remaining = 9 - _frameBits; // data bits left plus stop
+        if (idleBits >= remaining) {
+            _feedBits(remaining, true);
+            _lastEdgeCcy += remaining * _bitCcys;
+        }
+    }
+}
+
+void EdgeSerial::_feedBits(uint32_t count, bool level)
+{
+    if (!_inFrame && level) {
+        // idle mark of any length
+        return;
+    }
+    if (count > MAX_BITS_PER_INTERVAL) {
+        count = MAX_BITS_PER_INTERVAL;
+    }
+    while (count--) {
+        if (!_inFrame) {
+            if (!level) {
+                // start bit
+                _inFrame = true;
+                _frameBits = 0;
+                _frameByte = 0;
+            }
+        }
+        else if (_frameBits < 8) {
+            // LSB arrives first
+            _frameByte = (_frameByte >> 1) | (level ? 0x80 : 0);
+            _frameBits++;
+        }
+        else {
+            // stop bit
+            if (level) {
+                _rxBuf->push(_frameByte);
+            }
+            else {
+                _framingErrors++;
+            }
+            _inFrame = false;
+        }
+    }
+}
+
+int EdgeSerial::available()
+{
+    _decode();
+    return _rxBuf ? _rxBuf->available() : 0;
+}
+
+int EdgeSerial::read()
+{
+    _decode();
+    uint8_t b;
+    if (_rxBuf && _rxBuf->pop(b)) {
+        return b;
+    }
+    return -1;
+}
+
+int EdgeSerial::peek()
+{
+    _decode();
+    if (_rxBuf) {
+        size_t contiguous;
+        const uint8_t* p = _rxBuf->peek(contiguous);
+        if (contiguous) {
+            return *p;
+        }
+    }
+    return -1;
+}
+
+int EdgeSerial::read(uint8_t* buffer, size_t size)
+{
+    _decode();
+    return _rxBuf ? _rxBuf->pop(buffer, size) : 0;
+}
+
+void EdgeSerial::flush()
+{
+    // TX is synchronous, every write() returns with the stop bit on the wire
+}
+
+void EdgeSerial::_writeByte(uint8_t b)
+{
+    // start bit (0), 8 data bits LSB first, stop bit (1)
+    uint32_t frame = (static_cast<uint32_t>(b) << 1) | 0x200;
+    if (_invert) {
+        frame = ~frame;
+    }
+    const uint32_t pinBit = 1UL << _txPin;
+    // Interrupts are held off for one frame only (~87us at 115200) so the
+    // bit deadlines cannot be stretched by WiFi or timer ISRs.
+    esp8266::InterruptLock lock;
+    esp8266::polledTimeout::periodicHighRes bitTime(_bitCcys);
+    for (uint8_t i = 0; i < 10; i++) {
+        if (frame & 1) {
+            if (16 == _txPin) {
+                GP16O |= 1;
+            }
+            else {
+                GPOS = pinBit;
+            }
+        }
+        else {
+            if (16 == _txPin) {
+                GP16O &= ~1;
+            }
+            else {
+                GPOC = pinBit;
+            }
+        }
+        frame >>= 1;
+        while (!bitTime.expired()) {
+        }
+    }
+}
+
+size_t EdgeSerial::write(uint8_t b)
+{
+    return write(&b, 1);
+}
+
+size_t EdgeSerial::write(const uint8_t* buffer, size_t size)
+{
+    if (_txPin < 0 || !_baud) {
+        return 0;
+    }
+    if (_txEnablePin >= 0) {
+        digitalWrite(_txEnablePin, HIGH);
+    }
+    for (size_t i = 0; i < size; i++) {
+        _writeByte(buffer[i]);
+    }
+    if (_txEnablePin >= 0) {
+        digitalWrite(_txEnablePin, LOW);
+    }
+    return size;
+}
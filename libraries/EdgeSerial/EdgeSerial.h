@@ -0,0 +1,118 @@
+/*
+ EdgeSerial.h - software serial port driven by edge timestamps
+
+ Copyright (c) 2026 esp8266/Arduino community. All rights reserved.
+ This file is part of the esp8266 core for Arduino environment.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+  Classic bit-banged software serial reconstructs each byte inside the GPIO
+  interrupt, spinning on the cycle counter for a whole frame and corrupting
+  data when WiFi activity delays the ISR. EdgeSerial keeps the interrupt
+  minimal instead: the RX ISR only records the cycle count and new pin level
+  of each edge into a lock-free ring, and the bits are reconstructed from the
+  edge intervals later, in user context, when the application calls
+  available()/read(). ISR time is bounded and independent of the baud rate,
+  several RX instances can run concurrently (one GPIO interrupt each), and
+  115200 baud decodes reliably as long as the edge ring is drained before it
+  fills (256 edges by default, about 25 frames of 8N1 worst-case data).
+
+  Frame format is 8N1. RX works on GPIO 0-15 (GPIO16 has no interrupt).
+  TX is optional and synchronous: write() bit-bangs the frame with interrupts
+  disabled for the duration of one byte (~87us at 115200). For RS485 buses a
+  transmit-enable pin can be registered; it is asserted around each write.
+*/
+
+#ifndef __EDGESERIAL_H
+#define __EDGESERIAL_H
+
+#include <Arduino.h>
+#include <Stream.h>
+#include <spsc_ringbuf.h>
+
+class EdgeSerial : public Stream
+{
+public:
+    // rxPin < 0 disables RX, txPin < 0 disables TX. invert flips the line
+    // polarity (idle low, start bit high) for inverted-logic transceivers.
+    EdgeSerial(int8_t rxPin, int8_t txPin = -1, bool invert = false);
+    virtual ~EdgeSerial();
+
+    // rxBytes sizes the decoded-byte buffer, edgeCapacity the raw edge ring
+    // (two edges per data bit worst case; both rounded up to powers of two).
+    // Returns false when a buffer could not be allocated or rxPin is invalid.
+    bool begin(uint32_t baud, size_t rxBytes = 64, size_t edgeCapacity = 256);
+    void end();
+
+    // RS485 driver-enable: held HIGH while transmitting, LOW otherwise.
+    void setTransmitEnablePin(int8_t pin);
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    int read(uint8_t* buffer, size_t size) override;
+    void flush() override;
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    operator bool() const
+    {
+        return _baud != 0;
+    }
+
+    // edges dropped because the ring was full; drain more often or enlarge
+    // edgeCapacity when this grows
+    uint32_t overflowCount() const
+    {
+        return _rxOverflows;
+    }
+    // frames whose stop bit sampled at the wrong level
+    uint32_t framingErrorCount() const
+    {
+        return _framingErrors;
+    }
+
+protected:
+    static void IRAM_ATTR _rxEdgeISR(void* arg);
+
+    void _decode();
+    void _feedBits(uint32_t count, bool level);
+    void _writeByte(uint8_t b);
+
+    spsc_ringbuf<uint32_t>* _edges = nullptr; // cycle count with new level in bit 0
+    spsc_ringbuf<uint8_t>* _rxBuf = nullptr;  // decoded bytes, user context only
+
+    uint32_t _baud = 0;
+    uint32_t _bitCcys = 0;
+    int8_t _rxPin;
+    int8_t _txPin;
+    int8_t _txEnablePin = -1;
+    bool _invert;
+
+    // decoder state, user context only
+    uint32_t _lastEdgeCcy = 0;
+    bool _lastLevel = true; // logical level since the last edge (true = mark)
+    bool _inFrame = false;
+    uint8_t _frameBits = 0;
+    uint8_t _frameByte = 0;
+
+    volatile uint32_t _rxOverflows = 0;
+    uint32_t _framingErrors = 0;
+};
+
+#endif // __EDGESERIAL_H
@@ -2,8 +2,26 @@
 #include "LittleFS.h"
 #include <spiffs_api.h>
 #include <Esp.h>
+#include <MD5Builder.h>
+#include <coredecls.h> // crc32()
 
 
+namespace
+{
+    //  RTC user memory slot (4-byte blocks) holding the migration journal;
+    //  the last three blocks of the 512 byte user area, well clear of the
+    //  low blocks commonly used by sketches and the OTA machinery
+    constexpr uint32_t journalOffset = 125;
+    constexpr uint32_t journalMagic = 0x46535431; // 'FST1'
+
+    struct MigrationJournal
+    {
+        uint32_t magic;
+        uint32_t phase;
+        uint32_t crc; //  over the fields above
+    };
+}
+
 
 #if defined(DEBUG_ESP_CORE)
 #define FSTOOLSDEBUG(_1, ...) { DEBUG_ESP_PORT.printf_P( PSTR(_1),##__VA_ARGS__); }
@@ -130,35 +148,49 @@ bool FSTools::moveFS(fs::FS & destinationFS)
 
     FS tempFS = FS(FSImplPtr(new littlefs_impl::LittleFSImpl(startSector, tempFSsize, FS_PHYS_PAGE, FS_PHYS_BLOCK, 5)));
 
-    if (tempFS.format() && tempFS.begin())
+    //  a journalled MIGRATION_TO_DEST means a previous run already filled
+    //  (and verified) the temp FS before losing power: skip straight to
+    //  rebuilding the destination instead of re-copying the source
+    uint32_t journalPhase = FST::MIGRATION_NONE;
+    bool resume = _journalRead(journalPhase) && (journalPhase == FST::MIGRATION_TO_DEST);
+
+    if (resume && tempFS.begin())
+    {
+        FSTOOLSDEBUG("Resuming interrupted migration from temp File System\n");
+    }
+    else
     {
-        if (_copyFS(*_pFS, tempFS))
+        resume = false;
+        if (!(tempFS.format() && tempFS.begin()))
         {
-            FSTOOLSDEBUG("Files copied to temp File System\n");
-            reset();
-            if (destinationFS.format() && destinationFS.begin()) //  must format then mount the new FS
-            {
-                if (_copyFS(tempFS, destinationFS))
-                {
-                    FSTOOLSDEBUG("Files copied back to new FS\n");
-                    result = true;
-                }
-            }
-            else
-            {
-                FSTOOLSDEBUG("Error Mounting\n");
-            }
+            FSTOOLSDEBUG("Failed to begin() TempFS\n");
+            return false;
         }
-        else
+        if (!_copyFS(*_pFS, tempFS))
         {
             FSTOOLSDEBUG("Copy Failed\n");
+            tempFS.end();
+            return false;
+        }
+        FSTOOLSDEBUG("Files copied to temp File System\n");
+        _journalWrite(FST::MIGRATION_TO_DEST);
+    }
+
+    reset();
+    if (destinationFS.format() && destinationFS.begin()) //  must format then mount the new FS
+    {
+        if (_copyFS(tempFS, destinationFS))
+        {
+            FSTOOLSDEBUG("Files copied back to new FS\n");
+            _journalWrite(FST::MIGRATION_NONE);
+            result = true;
         }
-        tempFS.end();
     }
     else
     {
-        FSTOOLSDEBUG("Failed to begin() TempFS\n");
+        FSTOOLSDEBUG("Error Mounting\n");
     }
+    tempFS.end();
     return result;
 };
 
@@ -217,38 +249,115 @@ void FSTools::_dumpFileInfo(File & f)
 bool FSTools::_copyFS(FS & sourceFS, FS & destFS)
 {
     uint32_t sourceFileCount = 0;
-    uint32_t sourceByteTotal = 0;
-
-    fileListIterator(sourceFS, "/", [&sourceFileCount, &sourceByteTotal](File & f)
-    {
-        if (f)
-        {
-            sourceFileCount++;
-            sourceByteTotal += f.size();
-        }
-    });
-
     size_t count = 0;
-    fileListIterator(sourceFS, "/", [&count, &destFS](File & sourceFile)
+
+    fileListIterator(sourceFS, "/", [&count, &sourceFileCount, &destFS, this](File & sourceFile)
     {
         if (sourceFile)
         {
-            File destFile = destFS.open(sourceFile.fullName(), "w");
-            if (destFile)
+            sourceFileCount++;
+            if (_copyFile(sourceFile, destFS))
             {
-                destFile.setTimeout(5000); //  this value was chosen empirically as it failed with default timeout. 
-                size_t written = destFile.write(sourceFile);
-                if (written == sourceFile.size())
-                {
-                    count++;
-                }
+                count++;
             }
-            destFile.close();
             sourceFile.close();
             yield();
         }
     });
 
     return (count == sourceFileCount);
+}
 
+//  Chunked copy through a fixed stack buffer with an MD5 read-back check, so
+//  a migrated file is only counted once the destination bytes are proven to
+//  match the source. Files a previous interrupted run already migrated are
+//  detected by digest and skipped, which makes _copyFS() resumable.
+bool FSTools::_copyFile(File & sourceFile, FS & destFS)
+{
+    String sourceMD5 = _fileMD5(sourceFile);
+    if (!sourceMD5.length())
+    {
+        return false;
+    }
+
+    if (destFS.exists(sourceFile.fullName()))
+    {
+        File existing = destFS.open(sourceFile.fullName(), "r");
+        if (existing && existing.size() == sourceFile.size() && _fileMD5(existing) == sourceMD5)
+        {
+            return true; //  already migrated by a previous run
+        }
+    }
+
+    File destFile = destFS.open(sourceFile.fullName(), "w");
+    if (!destFile)
+    {
+        return false;
+    }
+
+    uint8_t buffer[FST::migrationChunkSize];
+    sourceFile.seek(0);
+    size_t remaining = sourceFile.size();
+    while (remaining)
+    {
+        size_t chunk = (remaining < sizeof(buffer)) ? remaining : sizeof(buffer);
+        if (sourceFile.read(buffer, chunk) != chunk || destFile.write(buffer, chunk) != chunk)
+        {
+            destFile.close();
+            return false;
+        }
+        remaining -= chunk;
+        yield();
+    }
+    destFile.close();
+
+    File verify = destFS.open(sourceFile.fullName(), "r");
+    return verify && _fileMD5(verify) == sourceMD5;
+}
+
+String FSTools::_fileMD5(File & f)
+{
+    MD5Builder md5;
+    uint8_t buffer[FST::migrationChunkSize];
+
+    md5.begin();
+    f.seek(0);
+    size_t remaining = f.size();
+    while (remaining)
+    {
+        size_t chunk = (remaining < sizeof(buffer)) ? remaining : sizeof(buffer);
+        if (f.read(buffer, chunk) != chunk)
+        {
+            return emptyString;
+        }
+        md5.add(buffer, chunk);
+        remaining -= chunk;
+        yield();
+    }
+    md5.calculate();
+    return md5.toString();
+}
+
+bool FSTools::_journalRead(uint32_t & phase)
+{
+    MigrationJournal journal;
+    if (!ESP.rtcUserMemoryRead(journalOffset, reinterpret_cast<uint32_t *>(&journal), sizeof(journal)))
+    {
+        return false;
+    }
+    if (journal.magic != journalMagic || journal.crc != crc32(&journal, 2 * sizeof(uint32_t)))
+    {
+        return false;
+    }
+    phase = journal.phase;
+    return true;
+}
+
+void FSTools::_journalWrite(uint32_t phase)
+{
+    MigrationJournal journal;
+    journal.magic = (phase == FST::MIGRATION_NONE) ? 0 : journalMagic;
+    journal.phase = phase;
+    journal.crc = crc32(&journal, 2 * sizeof(uint32_t));
+    ESP.rtcUserMemoryWrite(journalOffset, reinterpret_cast<uint32_t *>(&journal), sizeof(journal));
 }
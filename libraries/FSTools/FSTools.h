@@ -60,6 +60,18 @@ namespace FST
 
     typedef std::function<void(File & f)> FileCb;
 
+    //  copy chunk used by moveFS(); small enough to leave the heap alone,
+    //  flash page sized so writes land page aligned
+    static constexpr size_t migrationChunkSize = 512;
+
+    //  phase of an in-flight moveFS(), journalled to RTC user memory so an
+    //  interrupted migration can resume after a power cut
+    enum MigrationPhase : uint32_t
+    {
+        MIGRATION_NONE = 0,   //  nothing in flight
+        MIGRATION_TO_DEST = 1 //  temp FS holds a verified copy; destination was being rebuilt
+    };
+
 };
 
 
@@ -83,6 +95,10 @@ private:
     void _dumpFileInfo(File & f);
 #endif
     bool _copyFS(FS & sourceFS, FS & destFS);
+    bool _copyFile(File & sourceFile, FS & destFS);
+    String _fileMD5(File & f);
+    bool _journalRead(uint32_t & phase);
+    void _journalWrite(uint32_t phase);
 
     std::unique_ptr<fs::FS> _pFS;
     bool _mounted{false};
@@ -94,3 +94,243 @@ String sha1(const String& data) {
     return sha1(data.c_str(), data.length());
 }
 
+
+// ---------------------------------------------------------------------------
+// SHA-256
+//
+// Local implementation instead of a BearSSL wrapper: the compression function
+// is unrolled and reads word-aligned input directly as 32-bit loads, which
+// avoids BearSSL's generic per-block vtable dispatch and byte-wise input
+// handling in the common (aligned) case.
+// ---------------------------------------------------------------------------
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define SHA256_S0(x) (SHA256_ROTR(x, 2) ^ SHA256_ROTR(x, 13) ^ SHA256_ROTR(x, 22))
+#define SHA256_S1(x) (SHA256_ROTR(x, 6) ^ SHA256_ROTR(x, 11) ^ SHA256_ROTR(x, 25))
+#define SHA256_s0(x) (SHA256_ROTR(x, 7) ^ SHA256_ROTR(x, 18) ^ ((x) >> 3))
+#define SHA256_s1(x) (SHA256_ROTR(x, 17) ^ SHA256_ROTR(x, 19) ^ ((x) >> 10))
+
+// One round, with the working variables a..h passed in rotated order by the caller.
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i)                                 \
+    do {                                                                        \
+        uint32_t t1 = h + SHA256_S1(e) + (((e) & (f)) ^ (~(e) & (g)))           \
+                      + sha256_k[i] + w[i];                                     \
+        uint32_t t2 = SHA256_S0(a) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c))); \
+        d += t1;                                                                \
+        h = t1 + t2;                                                            \
+    } while(0)
+
+static void sha256_transform(uint32_t state[8], const uint8_t block[64]) {
+    uint32_t w[64];
+
+    if(((uintptr_t)block & 3) == 0) {
+        // Aligned fast path: straight 32-bit loads plus a byte swap.
+        const uint32_t* words = (const uint32_t*)(const void*)block;
+        for(uint32_t i = 0; i < 16; i += 4) {
+            w[i] = __builtin_bswap32(words[i]);
+            w[i + 1] = __builtin_bswap32(words[i + 1]);
+            w[i + 2] = __builtin_bswap32(words[i + 2]);
+            w[i + 3] = __builtin_bswap32(words[i + 3]);
+        }
+    } else {
+        for(uint32_t i = 0; i < 16; i++) {
+            w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16)
+                   | ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+        }
+    }
+
+    for(uint32_t i = 16; i < 64; i += 2) {
+        w[i] = SHA256_s1(w[i - 2]) + w[i - 7] + SHA256_s0(w[i - 15]) + w[i - 16];
+        w[i + 1] = SHA256_s1(w[i - 1]) + w[i - 6] + SHA256_s0(w[i - 14]) + w[i - 15];
+    }
+
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+
+    // Eight rounds per iteration: the a..h rotation is done by argument order,
+    // so the working variables never have to be shuffled at runtime.
+    for(uint32_t i = 0; i < 64; i += 8) {
+        SHA256_ROUND(a, b, c, d, e, f, g, h, i);
+        SHA256_ROUND(h, a, b, c, d, e, f, g, i + 1);
+        SHA256_ROUND(g, h, a, b, c, d, e, f, i + 2);
+        SHA256_ROUND(f, g, h, a, b, c, d, e, i + 3);
+        SHA256_ROUND(e, f, g, h, a, b, c, d, i + 4);
+        SHA256_ROUND(d, e, f, g, h, a, b, c, i + 5);
+        SHA256_ROUND(c, d, e, f, g, h, a, b, i + 6);
+        SHA256_ROUND(b, c, d, e, f, g, h, a, i + 7);
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void sha256_init(sha256_context_t* ctx) {
+    ctx->state[0] = 0x6a09e667;
+    ctx->state[1] = 0xbb67ae85;
+    ctx->state[2] = 0x3c6ef372;
+    ctx->state[3] = 0xa54ff53a;
+    ctx->state[4] = 0x510e527f;
+    ctx->state[5] = 0x9b05688c;
+    ctx->state[6] = 0x1f83d9ab;
+    ctx->state[7] = 0x5be0cd19;
+    ctx->byteCount = 0;
+}
+
+void sha256_update(sha256_context_t* ctx, const uint8_t* data, uint32_t size) {
+    uint32_t buffered = (uint32_t)ctx->byteCount & 63;
+    ctx->byteCount += size;
+
+    if(buffered) {
+        uint32_t fill = 64 - buffered;
+        if(size < fill) {
+            memcpy(ctx->buffer + buffered, data, size);
+            return;
+        }
+        memcpy(ctx->buffer + buffered, data, fill);
+        sha256_transform(ctx->state, ctx->buffer);
+        data += fill;
+        size -= fill;
+    }
+
+    while(size >= 64) {
+        sha256_transform(ctx->state, data);
+        data += 64;
+        size -= 64;
+    }
+
+    if(size) {
+        memcpy(ctx->buffer, data, size);
+    }
+}
+
+void sha256_final(sha256_context_t* ctx, uint8_t hash[32]) {
+    uint64_t bitCount = ctx->byteCount << 3;
+    uint8_t padding[72] = { 0x80 };
+    uint32_t buffered = (uint32_t)ctx->byteCount & 63;
+    uint32_t padLength = (buffered < 56 ? 56 : 120) - buffered;
+
+    for(uint32_t i = 0; i < 8; i++) {
+        padding[padLength + i] = (uint8_t)(bitCount >> (56 - 8 * i));
+    }
+    sha256_update(ctx, padding, padLength + 8);
+
+    for(uint32_t i = 0; i < 8; i++) {
+        hash[i * 4] = (uint8_t)(ctx->state[i] >> 24);
+        hash[i * 4 + 1] = (uint8_t)(ctx->state[i] >> 16);
+        hash[i * 4 + 2] = (uint8_t)(ctx->state[i] >> 8);
+        hash[i * 4 + 3] = (uint8_t)ctx->state[i];
+    }
+}
+
+/**
+ * create a sha256 hash from data
+ * @param data uint8_t *
+ * @param size uint32_t
+ * @param hash uint8_t[32]
+ */
+void sha256(const uint8_t* data, uint32_t size, uint8_t hash[32]) {
+    sha256_context_t ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, size);
+    sha256_final(&ctx, hash);
+}
+
+void sha256(const char* data, uint32_t size, uint8_t hash[32]) {
+    sha256((const uint8_t *) data, size, hash);
+}
+
+void sha256(const String& data, uint8_t hash[32]) {
+    sha256(data.c_str(), data.length(), hash);
+}
+
+static String sha256ToHex(const uint8_t hash[32]) {
+    String hashStr((const char*)nullptr);
+    hashStr.reserve(32 * 2 + 1);
+
+    for(uint16_t i = 0; i < 32; i++) {
+        char hex[3];
+        snprintf(hex, sizeof(hex), "%02x", hash[i]);
+        hashStr += hex;
+    }
+
+    return hashStr;
+}
+
+String sha256(const uint8_t* data, uint32_t size) {
+    uint8_t hash[32];
+    sha256(&data[0], size, &hash[0]);
+    return sha256ToHex(hash);
+}
+
+String sha256(const char* data, uint32_t size) {
+    return sha256((const uint8_t*) data, size);
+}
+
+String sha256(const String& data) {
+    return sha256(data.c_str(), data.length());
+}
+
+/**
+ * create a HMAC-SHA256 authentication code from key and data
+ * @param key uint8_t *
+ * @param keySize uint32_t
+ * @param data uint8_t *
+ * @param size uint32_t
+ * @param hash uint8_t[32]
+ */
+void hmacSha256(const uint8_t* key, uint32_t keySize, const uint8_t* data, uint32_t size, uint8_t hash[32]) {
+    uint8_t keyBlock[64] = { 0 };
+    uint8_t pad[64];
+    sha256_context_t ctx;
+
+    if(keySize > sizeof(keyBlock)) {
+        sha256(key, keySize, keyBlock);
+    } else {
+        memcpy(keyBlock, key, keySize);
+    }
+
+    for(uint32_t i = 0; i < sizeof(pad); i++) {
+        pad[i] = keyBlock[i] ^ 0x36;
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, pad, sizeof(pad));
+    sha256_update(&ctx, data, size);
+    sha256_final(&ctx, hash);
+
+    for(uint32_t i = 0; i < sizeof(pad); i++) {
+        pad[i] = keyBlock[i] ^ 0x5c;
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, pad, sizeof(pad));
+    sha256_update(&ctx, hash, 32);
+    sha256_final(&ctx, hash);
+}
+
+String hmacSha256(const String& key, const String& data) {
+    uint8_t hash[32];
+    hmacSha256((const uint8_t*)key.c_str(), key.length(), (const uint8_t*)data.c_str(), data.length(), hash);
+    return sha256ToHex(hash);
+}
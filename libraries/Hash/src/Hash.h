@@ -35,4 +35,30 @@ String sha1(const uint8_t* data, uint32_t size);
 String sha1(const char* data, uint32_t size);
 String sha1(const String& data);
 
+// SHA-256 with a local unrolled compression core (no BearSSL dispatch per block).
+// Word-aligned input is processed directly as 32-bit loads.
+
+// Streaming interface, for data which arrives in chunks.
+struct sha256_context_t {
+    uint32_t state[8];
+    uint64_t byteCount;
+    uint8_t buffer[64];
+};
+
+void sha256_init(sha256_context_t* ctx);
+void sha256_update(sha256_context_t* ctx, const uint8_t* data, uint32_t size);
+void sha256_final(sha256_context_t* ctx, uint8_t hash[32]);
+
+void sha256(const uint8_t* data, uint32_t size, uint8_t hash[32]);
+void sha256(const char* data, uint32_t size, uint8_t hash[32]);
+void sha256(const String& data, uint8_t hash[32]);
+
+String sha256(const uint8_t* data, uint32_t size);
+String sha256(const char* data, uint32_t size);
+String sha256(const String& data);
+
+// HMAC-SHA256 (RFC 2104) on top of the core above. Keys longer than 64 bytes are hashed first.
+void hmacSha256(const uint8_t* key, uint32_t keySize, const uint8_t* data, uint32_t size, uint8_t hash[32]);
+String hmacSha256(const String& key, const String& data);
+
 #endif /* HASH_H_ */
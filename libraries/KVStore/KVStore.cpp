@@ -0,0 +1,525 @@
+/*
+  KVStore.cpp - log-structured key-value store in flash for esp8266
+
+  This file is part of the esp8266 core for Arduino environment.
+
+  On-flash layout: each sector starts with an 8-byte header (magic plus
+  a monotonic sequence number ordering the sectors), followed by records
+  appended back to back.  A record is an 8-byte header, the key bytes
+  and the value bytes, padded to the 4-byte flash write granularity.
+  Superseding or removing a key clears a bit in the old record's state
+  byte - a legal NOR program, no erase needed.  One sector of the region
+  is always kept erased; when the write sector fills, appends move into
+  the spare and the oldest sector's live records are relocated before it
+  is erased to become the new spare.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+#include "KVStore.h"
+#include "debug.h"
+#include "coredecls.h"
+
+#include <memory>
+
+static constexpr uint32_t kSectorMagic   = 0x4b565331;  // "KVS1"
+static constexpr uint16_t kRecordMagic   = 0x564b;      // "KV"
+static constexpr uint8_t  kStateValid    = 0xfe;        // bit 0 cleared on append
+static constexpr uint8_t  kStateObsolete = 0xfc;        // bit 1 cleared on supersede
+static constexpr uint32_t kSectorHeaderSize = 8;
+static constexpr uint32_t kOffsetEmpty = 0xffffffff;
+static constexpr uint32_t kOffsetTomb  = 0xfffffffe;
+static constexpr uint32_t kSeqBlank    = 0xffffffff;
+
+KVStoreClass::KVStoreClass(uint32_t sector, uint32_t sectorCount)
+: _sector(sector)
+, _sectorCount(sectorCount)
+{
+}
+
+KVStoreClass::~KVStoreClass() {
+  end();
+}
+
+uint32_t KVStoreClass::keyHash(const char* key, uint8_t len) {
+  uint32_t hash = crc32(key, len);
+  // 0 is reserved so an all-ones slot can't alias a real hash
+  return hash ? hash : 1;
+}
+
+bool KVStoreClass::begin(size_t maxKeys) {
+  if (_sectorCount < 3) {
+    DEBUGV("KVStoreClass::begin error, need at least 3 sectors\n");
+    return false;
+  }
+  if (!maxKeys) {
+    return false;
+  }
+
+  // keep the open-addressing load factor at or below 50%
+  size_t slots = 4;
+  while (slots < maxKeys * 2) {
+    slots *= 2;
+  }
+
+  if (_index && slots != _indexSize) {
+    delete[] _index;
+    _index = nullptr;
+  }
+  if (!_index) {
+    _index = new (std::nothrow) IndexEntry[slots];
+    if (!_index) {
+      return false;
+    }
+  }
+  _indexSize = slots;
+  _maxKeys = maxKeys;
+  for (size_t i = 0; i < _indexSize; i++) {
+    _index[i].offset = kOffsetEmpty;
+  }
+  _liveKeys = 0;
+
+  if (!mountScan()) {
+    DEBUGV("KVStoreClass::begin mount failed\n");
+    end();
+    return false;
+  }
+  return true;
+}
+
+bool KVStoreClass::end() {
+  if (_index) {
+    delete[] _index;
+    _index = nullptr;
+  }
+  _indexSize = 0;
+  _liveKeys = 0;
+  return true;
+}
+
+bool KVStoreClass::format() {
+  for (uint32_t i = 0; i < _sectorCount; i++) {
+    if (!ESP.flashEraseSector(_sector + i)) {
+      return false;
+    }
+  }
+  if (_index) {
+    for (size_t i = 0; i < _indexSize; i++) {
+      _index[i].offset = kOffsetEmpty;
+    }
+  }
+  _liveKeys = 0;
+  return openSector(0, 1);
+}
+
+bool KVStoreClass::openSector(uint32_t index, uint32_t seq) {
+  uint32_t addr = sectorBase(index);
+  uint32_t word;
+  if (!ESP.flashRead(addr, &word, 4)) {
+    return false;
+  }
+  if (word != 0xffffffff && !ESP.flashEraseSector(_sector + index)) {
+    return false;
+  }
+  uint32_t header[2] = { kSectorMagic, seq };
+  if (!ESP.flashWrite(addr, header, sizeof(header))) {
+    return false;
+  }
+  _writeSector = index;
+  _writeOffset = kSectorHeaderSize;
+  _seq = seq;
+  return true;
+}
+
+bool KVStoreClass::readRecordKey(uint32_t offset, RecordHeader& header, char* keyBuf) const {
+  if (!ESP.flashRead(offset, (uint8_t*)&header, sizeof(header))) {
+    return false;
+  }
+  if (header.magic != kRecordMagic || header.keyLen == 0 || header.keyLen > MaxKeyLength) {
+    return false;
+  }
+  return ESP.flashRead(offset + sizeof(header), (uint8_t*)keyBuf, header.keyLen);
+}
+
+KVStoreClass::IndexEntry* KVStoreClass::findEntry(const char* key, uint8_t keyLen, uint32_t hash) const {
+  if (!_index) {
+    return nullptr;
+  }
+  size_t slot = hash & (_indexSize - 1);
+  for (size_t n = 0; n < _indexSize; n++) {
+    IndexEntry& entry = _index[slot];
+    if (entry.offset == kOffsetEmpty) {
+      return nullptr;
+    }
+    if (entry.offset != kOffsetTomb && entry.hash == hash) {
+      RecordHeader header;
+      char keyBuf[MaxKeyLength];
+      if (readRecordKey(entry.offset, header, keyBuf)
+          && header.keyLen == keyLen
+          && memcmp(keyBuf, key, keyLen) == 0) {
+        return &entry;
+      }
+    }
+    slot = (slot + 1) & (_indexSize - 1);
+  }
+  return nullptr;
+}
+
+KVStoreClass::IndexEntry* KVStoreClass::insertSlot(uint32_t hash) {
+  size_t slot = hash & (_indexSize - 1);
+  for (size_t n = 0; n < _indexSize; n++) {
+    IndexEntry& entry = _index[slot];
+    if (entry.offset == kOffsetEmpty || entry.offset == kOffsetTomb) {
+      return &entry;
+    }
+    slot = (slot + 1) & (_indexSize - 1);
+  }
+  return nullptr;
+}
+
+bool KVStoreClass::markObsolete(uint32_t offset) const {
+  uint8_t state = kStateObsolete;
+  return ESP.flashWrite(offset + offsetof(RecordHeader, state), &state, 1);
+}
+
+bool KVStoreClass::scanSector(uint32_t index) {
+  uint32_t base = sectorBase(index);
+  uint32_t off = kSectorHeaderSize;
+
+  while (off + sizeof(RecordHeader) <= SectorSize) {
+    RecordHeader header;
+    if (!ESP.flashRead(base + off, (uint8_t*)&header, sizeof(header))) {
+      return false;
+    }
+    if (header.magic == 0xffff) {
+      break;  // erased tail: end of the log in this sector
+    }
+    if (header.magic != kRecordMagic || header.keyLen == 0
+        || header.keyLen > MaxKeyLength || header.valueLen > MaxValueLength) {
+      // torn or corrupt record: nothing after it can be trusted
+      DEBUGV("KVStoreClass: corrupt record at sector %d offset %d\n", (int)index, (int)off);
+      break;
+    }
+    uint32_t recLen = recordLength(header.keyLen, header.valueLen);
+    if (off + recLen > SectorSize) {
+      break;
+    }
+
+    if (header.state == kStateValid) {
+      // verify the checksum in chunks before trusting the record
+      uint8_t chunk[64];
+      uint32_t crc = 0xffffffff;
+      uint32_t left = (uint32_t)header.keyLen + header.valueLen;
+      uint32_t pos = base + off + sizeof(RecordHeader);
+      while (left) {
+        uint32_t take = left < sizeof(chunk) ? left : sizeof(chunk);
+        if (!ESP.flashRead(pos, chunk, take)) {
+          return false;
+        }
+        crc = crc32(chunk, take, crc);
+        pos += take;
+        left -= take;
+      }
+      if ((uint16_t)crc != header.crc) {
+        DEBUGV("KVStoreClass: bad crc at sector %d offset %d\n", (int)index, (int)off);
+        off += recLen;
+        continue;
+      }
+
+      char keyBuf[MaxKeyLength];
+      if (!ESP.flashRead(base + off + sizeof(RecordHeader), (uint8_t*)keyBuf, header.keyLen)) {
+        return false;
+      }
+      uint32_t hash = keyHash(keyBuf, header.keyLen);
+      IndexEntry* existing = findEntry(keyBuf, header.keyLen, hash);
+      if (existing) {
+        // later record wins; heal the missing obsolete mark on the older
+        markObsolete(existing->offset);
+        existing->offset = base + off;
+      } else {
+        IndexEntry* slot = insertSlot(hash);
+        if (!slot) {
+          DEBUGV("KVStoreClass: index full during mount\n");
+          return false;
+        }
+        slot->hash = hash;
+        slot->offset = base + off;
+        _liveKeys++;
+      }
+    }
+
+    off += recLen;
+  }
+
+  _writeSector = index;
+  _writeOffset = off;
+  return true;
+}
+
+bool KVStoreClass::mountScan() {
+  std::unique_ptr<uint32_t[]> seqs(new (std::nothrow) uint32_t[_sectorCount]);
+  if (!seqs) {
+    return false;
+  }
+
+  bool haveFormatted = false;
+  bool haveBlank = false;
+  for (uint32_t i = 0; i < _sectorCount; i++) {
+    uint32_t header[2];
+    if (!ESP.flashRead(sectorBase(i), header, sizeof(header))) {
+      return false;
+    }
+    if (header[0] == kSectorMagic && header[1] != kSeqBlank) {
+      seqs[i] = header[1];
+      haveFormatted = true;
+    } else {
+      seqs[i] = kSeqBlank;
+      if (header[0] == 0xffffffff) {
+        haveBlank = true;
+      }
+    }
+  }
+
+  if (!haveFormatted) {
+    return format();
+  }
+
+  // scan formatted sectors in sequence order; the last one scanned is
+  // the write sector and leaves _writeOffset at the log tail
+  uint32_t lastSeq = 0;
+  for (;;) {
+    uint32_t best = _sectorCount;
+    for (uint32_t i = 0; i < _sectorCount; i++) {
+      if (seqs[i] != kSeqBlank && seqs[i] > lastSeq
+          && (best == _sectorCount || seqs[i] < seqs[best])) {
+        best = i;
+      }
+    }
+    if (best == _sectorCount) {
+      break;
+    }
+    if (!scanSector(best)) {
+      return false;
+    }
+    lastSeq = seqs[best];
+    _seq = lastSeq;
+  }
+
+  // Restore the spare-sector invariant after an interrupted compaction:
+  // finish relocating the victim's live records and erase it.
+  if (!haveBlank) {
+    uint32_t victim = (_writeSector + 1) % _sectorCount;
+    if (!relocateLive(victim) || !ESP.flashEraseSector(_sector + victim)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t KVStoreClass::appendRecord(const char* key, uint8_t keyLen, const uint8_t* value, uint16_t valueLen) {
+  uint32_t recLen = recordLength(keyLen, valueLen);
+  if (_writeOffset + recLen > SectorSize) {
+    return 0;
+  }
+  uint32_t addr = sectorBase(_writeSector) + _writeOffset;
+
+  uint32_t crc = crc32(key, keyLen);
+  crc = crc32(value, valueLen, crc);
+
+  RecordHeader header;
+  header.magic = kRecordMagic;
+  header.state = kStateValid;
+  header.keyLen = keyLen;
+  header.valueLen = valueLen;
+  header.crc = (uint16_t)crc;
+
+  // header and key go out in one write; small values usually make the
+  // whole record a single page program
+  uint8_t buf[sizeof(RecordHeader) + MaxKeyLength];
+  memcpy(buf, &header, sizeof(header));
+  memcpy(buf + sizeof(header), key, keyLen);
+  if (!ESP.flashWrite(addr, buf, sizeof(header) + keyLen)) {
+    return 0;
+  }
+  if (valueLen && !ESP.flashWrite(addr + sizeof(header) + keyLen, value, valueLen)) {
+    return 0;
+  }
+  _writeOffset += recLen;
+  return addr;
+}
+
+bool KVStoreClass::relocateLive(uint32_t victim) {
+  uint32_t header[2];
+  if (!ESP.flashRead(sectorBase(victim), header, sizeof(header))) {
+    return false;
+  }
+  if (header[0] != kSectorMagic) {
+    return true;  // blank or unformatted: nothing to save
+  }
+
+  uint32_t base = sectorBase(victim);
+  for (size_t i = 0; i < _indexSize; i++) {
+    IndexEntry& entry = _index[i];
+    if (entry.offset == kOffsetEmpty || entry.offset == kOffsetTomb) {
+      continue;
+    }
+    if (entry.offset < base || entry.offset >= base + SectorSize) {
+      continue;
+    }
+
+    RecordHeader rec;
+    char keyBuf[MaxKeyLength];
+    if (!readRecordKey(entry.offset, rec, keyBuf)) {
+      return false;
+    }
+    std::unique_ptr<uint8_t[]> value(new (std::nothrow) uint8_t[rec.valueLen ? rec.valueLen : 1]);
+    if (!value) {
+      return false;
+    }
+    if (rec.valueLen && !ESP.flashRead(entry.offset + sizeof(rec) + rec.keyLen, value.get(), rec.valueLen)) {
+      return false;
+    }
+    uint32_t moved = appendRecord(keyBuf, rec.keyLen, value.get(), rec.valueLen);
+    if (!moved) {
+      return false;
+    }
+    entry.offset = moved;
+  }
+  return true;
+}
+
+bool KVStoreClass::advanceSector(uint32_t needed) {
+  // Move appends into the spare sector, then relocate the next sector in
+  // the ring and erase it so it becomes the new spare.  Each pass frees
+  // a whole sector, so a store whose live data fits the region always
+  // finds room.
+  for (uint32_t attempts = 0; attempts < _sectorCount; attempts++) {
+    uint32_t next = (_writeSector + 1) % _sectorCount;
+    uint32_t victim = (next + 1) % _sectorCount;
+    if (!openSector(next, _seq + 1)) {
+      return false;
+    }
+    if (!relocateLive(victim) || !ESP.flashEraseSector(_sector + victim)) {
+      return false;
+    }
+    if (_writeOffset + needed <= SectorSize) {
+      return true;
+    }
+  }
+  DEBUGV("KVStoreClass: region full\n");
+  return false;
+}
+
+bool KVStoreClass::putKey(const char* key, const uint8_t* value, uint16_t length) {
+  if (!_index || !key || (!value && length)) {
+    return false;
+  }
+  size_t keyLen = strlen(key);
+  if (!keyLen || keyLen > MaxKeyLength || length > MaxValueLength) {
+    return false;
+  }
+
+  uint32_t hash = keyHash(key, keyLen);
+  IndexEntry* existing = findEntry(key, keyLen, hash);
+  if (!existing && _liveKeys >= _maxKeys) {
+    DEBUGV("KVStoreClass::putKey index full\n");
+    return false;
+  }
+
+  uint32_t recLen = recordLength(keyLen, length);
+  if (_writeOffset + recLen > SectorSize && !advanceSector(recLen)) {
+    return false;
+  }
+  // advanceSector() relocation may have moved the existing record
+  if (existing) {
+    existing = findEntry(key, keyLen, hash);
+  }
+
+  uint32_t offset = appendRecord(key, keyLen, value, length);
+  if (!offset) {
+    return false;
+  }
+
+  if (existing) {
+    markObsolete(existing->offset);
+    existing->offset = offset;
+  } else {
+    IndexEntry* slot = insertSlot(hash);
+    if (!slot) {
+      return false;
+    }
+    slot->hash = hash;
+    slot->offset = offset;
+    _liveKeys++;
+  }
+  return true;
+}
+
+int KVStoreClass::getKey(const char* key, uint8_t* value, uint16_t maxLength) const {
+  if (!_index || !key) {
+    return -1;
+  }
+  size_t keyLen = strlen(key);
+  if (!keyLen || keyLen > MaxKeyLength) {
+    return -1;
+  }
+  IndexEntry* entry = findEntry(key, keyLen, keyHash(key, keyLen));
+  if (!entry) {
+    return -1;
+  }
+  RecordHeader header;
+  if (!ESP.flashRead(entry->offset, (uint8_t*)&header, sizeof(header))) {
+    return -1;
+  }
+  uint16_t take = header.valueLen < maxLength ? header.valueLen : maxLength;
+  if (take && !ESP.flashRead(entry->offset + sizeof(header) + header.keyLen, value, take)) {
+    return -1;
+  }
+  return header.valueLen;
+}
+
+String KVStoreClass::getKey(const char* key) const {
+  String result;
+  std::unique_ptr<uint8_t[]> buf(new (std::nothrow) uint8_t[MaxValueLength]);
+  if (!buf) {
+    return result;
+  }
+  int len = getKey(key, buf.get(), MaxValueLength);
+  if (len > 0) {
+    result.concat((const char*)buf.get(), len);
+  }
+  return result;
+}
+
+bool KVStoreClass::removeKey(const char* key) {
+  if (!_index || !key) {
+    return false;
+  }
+  size_t keyLen = strlen(key);
+  if (!keyLen || keyLen > MaxKeyLength) {
+    return false;
+  }
+  IndexEntry* entry = findEntry(key, keyLen, keyHash(key, keyLen));
+  if (!entry) {
+    return false;
+  }
+  if (!markObsolete(entry->offset)) {
+    return false;
+  }
+  entry->offset = kOffsetTomb;
+  _liveKeys--;
+  return true;
+}
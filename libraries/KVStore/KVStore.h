@@ -0,0 +1,130 @@
+/*
+  KVStore.h - log-structured key-value store in flash for esp8266
+
+  This file is part of the esp8266 core for Arduino environment.
+
+  Unlike the EEPROM emulation, which erases and rewrites a whole 4 KB
+  sector on every commit, this store appends small records across a
+  multi-sector flash region and keeps an in-RAM hash index built at
+  mount.  A typical update costs one small page write; sector erases
+  only happen when the log wraps, amortized over many updates.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef KVStore_h
+#define KVStore_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <WString.h>
+
+class KVStoreClass {
+public:
+  // Region of sectorCount flash sectors starting at the given sector
+  // index (counted from flash base, as in EEPROMClass).  At least 3
+  // sectors are required so one can always stay erased for compaction.
+  KVStoreClass(uint32_t sector, uint32_t sectorCount);
+  ~KVStoreClass();
+
+  // mount: scan the region and build the index; maxKeys bounds the
+  // number of distinct keys held at once
+  bool begin(size_t maxKeys = 32);
+  bool end();
+
+  // erase the whole region and start empty
+  bool format();
+
+  // append a record for this key, superseding any previous value
+  bool putKey(const char* key, const uint8_t* value, uint16_t length);
+  bool putKey(const char* key, const String& value) {
+    return putKey(key, (const uint8_t*)value.c_str(), value.length());
+  }
+
+  // Copy the current value into the buffer (truncated to maxLength) and
+  // return its stored length, or -1 when the key is absent.
+  int getKey(const char* key, uint8_t* value, uint16_t maxLength) const;
+  String getKey(const char* key) const;
+
+  // drop the key; its record is marked obsolete in place
+  bool removeKey(const char* key);
+
+  // typed convenience, mirroring EEPROM.put()/get()
+  template<typename T>
+  bool putKey(const char* key, const T& t) {
+    return putKey(key, (const uint8_t*)&t, sizeof(T));
+  }
+  template<typename T>
+  bool getKey(const char* key, T& t) const {
+    return getKey(key, (uint8_t*)&t, sizeof(T)) == (int)sizeof(T);
+  }
+
+  // number of distinct keys currently stored
+  size_t length() const { return _liveKeys; }
+
+  // Kept for familiarity with EEPROMClass: every putKey() is durable
+  // immediately, so there is nothing to flush.
+  bool commit() { return _index != nullptr; }
+
+  static constexpr uint8_t  MaxKeyLength = 64;
+  static constexpr uint16_t MaxValueLength = 1024;
+
+protected:
+  static constexpr uint32_t SectorSize = 4096;
+
+  struct IndexEntry {
+    uint32_t hash;
+    uint32_t offset;    // absolute flash offset of the record header
+  };
+
+  struct RecordHeader {
+    uint16_t magic;
+    uint8_t  state;
+    uint8_t  keyLen;
+    uint16_t valueLen;
+    uint16_t crc;       // over key bytes then value bytes
+  };
+
+  static uint32_t keyHash(const char* key, uint8_t len);
+  static uint32_t recordLength(uint8_t keyLen, uint16_t valueLen) {
+    return (sizeof(RecordHeader) + keyLen + valueLen + 3) & ~(uint32_t)3;
+  }
+  uint32_t sectorBase(uint32_t index) const {
+    return (_sector + index) * SectorSize;
+  }
+
+  bool mountScan();
+  bool scanSector(uint32_t index);
+  bool openSector(uint32_t index, uint32_t seq);
+  bool advanceSector(uint32_t needed);
+  bool relocateLive(uint32_t victim);
+  uint32_t appendRecord(const char* key, uint8_t keyLen, const uint8_t* value, uint16_t valueLen);
+  bool markObsolete(uint32_t offset) const;
+  bool readRecordKey(uint32_t offset, RecordHeader& header, char* keyBuf) const;
+  IndexEntry* findEntry(const char* key, uint8_t keyLen, uint32_t hash) const;
+  IndexEntry* insertSlot(uint32_t hash);
+
+  IndexEntry* _index = nullptr;
+  size_t   _indexSize = 0;     // slots, power of two
+  size_t   _maxKeys = 0;
+  size_t   _liveKeys = 0;
+  uint32_t _sector;
+  uint32_t _sectorCount;
+  uint32_t _writeSector = 0;   // region-relative index taking appends
+  uint32_t _writeOffset = 0;   // offset within the write sector
+  uint32_t _seq = 0;           // sequence number of the write sector
+};
+
+#endif
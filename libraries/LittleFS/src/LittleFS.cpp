@@ -61,7 +61,12 @@ FileImplPtr LittleFSImpl::open(const char* path, OpenMode openMode, AccessMode a
             char *ptr = strchr(pathStr, '/');
             while (ptr) {
                 *ptr = 0;
-                lfs_mkdir(&_lfs, pathStr);
+                // Skip the mkdir (a full metadata walk) when the dir is known
+                if (_pathCacheLookup(pathStr) != LFS_TYPE_DIR) {
+                    if (lfs_mkdir(&_lfs, pathStr) == 0) {
+                        _pathCacheInsert(pathStr, LFS_TYPE_DIR);
+                    }
+                }
                 *ptr = '/';
                 ptr = strchr(ptr+1, '/');
             }
@@ -73,15 +78,22 @@ FileImplPtr LittleFSImpl::open(const char* path, OpenMode openMode, AccessMode a
     if (_timeCallback && (openMode & OM_CREATE)) {
         // O_CREATE means we *may* make the file, but not if it already exists.
         // See if it exists, and only if not update the creation time
-        int rc = lfs_file_open(&_lfs, fd.get(), path, LFS_O_RDONLY);
-	if (rc == 0) {
-            lfs_file_close(&_lfs, fd.get()); // It exists, don't update create time
+        if (_pathCacheLookup(path) == LFS_TYPE_REG) {
+            // Known to exist, don't update create time
         } else {
-            creation = _timeCallback();  // File didn't exist or otherwise, so we're going to create this time
+            int rc = lfs_file_open(&_lfs, fd.get(), path, LFS_O_RDONLY);
+            if (rc == 0) {
+                lfs_file_close(&_lfs, fd.get()); // It exists, don't update create time
+            } else {
+                creation = _timeCallback();  // File didn't exist or otherwise, so we're going to create this time
+            }
         }
     }
 
     int rc = lfs_file_open(&_lfs, fd.get(), path, flags);
+    if (rc == 0) {
+        _pathCacheInsert(path, LFS_TYPE_REG);
+    }
     if (rc == LFS_ERR_ISDIR) {
         // To support the SD.openNextFile, a null FD indicates to the LittleFSFile this is just
         // a directory whose name we are carrying around but which cannot be read or written
@@ -49,6 +49,18 @@ class LittleFSConfig : public FSConfig
 public:
     static constexpr uint32_t FSId = 0x4c495454;
     LittleFSConfig(bool autoFormat = true) : FSConfig(FSId, autoFormat) { }
+
+    // Per-file read-ahead cache for sequential reads, rounded down to a
+    // multiple of 256 bytes.  When enabled, a streak of sequential read()s
+    // is served from a RAM window refilled in read-ahead sized chunks
+    // instead of hitting SPI flash per small read.  0 (default) disables
+    // the cache; streaming workloads profit from 512..2048 bytes.
+    LittleFSConfig setReadAhead(size_t bytes) {
+        _readAhead = (bytes / 256) * 256;
+        return *this;
+    }
+
+    size_t _readAhead = 0;
 };
 
 class LittleFSImpl : public FSImpl
@@ -94,8 +106,14 @@ public:
         if (!_mounted || !path || !path[0]) {
             return false;
         }
+        if (_pathCacheLookup(path)) {
+            return true;
+        }
         lfs_info info;
         int rc = lfs_stat(&_lfs, path, &info);
+        if (rc == 0) {
+            _pathCacheInsert(path, info.type);
+        }
         return rc == 0;
     }
 
@@ -108,6 +126,8 @@ public:
             DEBUGV("lfs_rename: rc=%d, from=`%s`, to=`%s`\n", rc, pathFrom, pathTo);
             return false;
         }
+        _pathCacheInvalidate(pathFrom);
+        _pathCacheInvalidate(pathTo);
         return true;
     }
 
@@ -122,6 +142,8 @@ public:
         info.maxPathLength = LFS_NAME_MAX;
         info.totalBytes = _size;
         info.usedBytes = _getUsedBlocks() * _blockSize;
+        info.pathCacheHits = _pathCacheHits;
+        info.pathCacheMisses = _pathCacheMisses;
         return true;
     }
 
@@ -148,13 +170,16 @@ public:
             DEBUGV("lfs_remove: rc=%d path=`%s`\n", rc, path);
             return false;
         }
+        _pathCacheInvalidate(path);
         // Now try and remove any empty subdirs this makes, silently
         char *pathStr = strdup(path);
         if (pathStr) {
             char *ptr = strrchr(pathStr, '/');
             while (ptr) {
                 *ptr = 0;
-                lfs_remove(&_lfs, pathStr); // Don't care if fails if there are files left
+                if (lfs_remove(&_lfs, pathStr) == 0) { // Don't care if fails if there are files left
+                    _pathCacheInvalidate(pathStr);
+                }
                 ptr = strrchr(pathStr, '/');
             }
             free(pathStr);
@@ -167,6 +192,9 @@ public:
             return false;
         }
         int rc = lfs_mkdir(&_lfs, path);
+        if (rc == 0) {
+            _pathCacheInsert(path, LFS_TYPE_DIR);
+        }
         return (rc==0);
     }
 
@@ -205,6 +233,7 @@ public:
         }
         lfs_unmount(&_lfs);
         _mounted = false;
+        _pathCacheClear();
     }
 
     bool format() override {
@@ -213,6 +242,7 @@ public:
             return false;
         }
 
+        _pathCacheClear();
         bool wasMounted = _mounted;
         if (_mounted) {
             lfs_unmount(&_lfs);
@@ -275,6 +305,10 @@ protected:
         return &_lfs;
     }
 
+    size_t getReadAheadSize() const {
+        return _cfg._readAhead;
+    }
+
     bool _tryMount() {
         if (_mounted) {
             lfs_unmount(&_lfs);
@@ -343,6 +377,65 @@ protected:
     static int lfs_flash_erase(const struct lfs_config *c, lfs_block_t block);
     static int lfs_flash_sync(const struct lfs_config *c);
 
+    // Path-existence cache: lfs walks the metadata pairs for every path
+    // component on each lookup, which is many flash reads on deep trees.
+    // Entries only assert "this path exists with this type", so plain file
+    // writes need no invalidation; remove/rename drop the affected subtree
+    // and format/end clear everything. Hit/miss counters are reported
+    // through FSInfo.
+    static constexpr size_t _pathCacheEntries = 8;
+    struct PathCacheEntry {
+        String path;
+        uint8_t type = 0; // LFS_TYPE_REG or LFS_TYPE_DIR, 0 = empty slot
+    };
+    PathCacheEntry _pathCache[_pathCacheEntries];
+    uint8_t  _pathCacheNext = 0;
+    uint32_t _pathCacheHits = 0;
+    uint32_t _pathCacheMisses = 0;
+
+    // Returns the cached LFS_TYPE_* for the path, or 0 on a miss
+    int _pathCacheLookup(const char* path) {
+        for (auto& e : _pathCache) {
+            if (e.type && e.path.equals(path)) {
+                _pathCacheHits++;
+                return e.type;
+            }
+        }
+        _pathCacheMisses++;
+        return 0;
+    }
+
+    void _pathCacheInsert(const char* path, uint8_t type) {
+        for (auto& e : _pathCache) {
+            if (e.type && e.path.equals(path)) {
+                e.type = type;
+                return;
+            }
+        }
+        _pathCache[_pathCacheNext].path = path;
+        _pathCache[_pathCacheNext].type = type;
+        _pathCacheNext = (_pathCacheNext + 1) % _pathCacheEntries;
+    }
+
+    // Drop the path itself and anything below it (covers dir removal/rename)
+    void _pathCacheInvalidate(const char* path) {
+        const size_t len = strlen(path);
+        for (auto& e : _pathCache) {
+            if (e.type && e.path.startsWith(path)
+                    && ((e.path.length() == len) || (e.path[len] == '/'))) {
+                e.type = 0;
+                e.path = String();
+            }
+        }
+    }
+
+    void _pathCacheClear() {
+        for (auto& e : _pathCache) {
+            e.type = 0;
+            e.path = String();
+        }
+    }
+
     lfs_t       _lfs;
     lfs_config  _lfs_cfg;
 
@@ -405,6 +498,7 @@ public:
             DEBUGV("lfs_write rc=%d\n", result);
             return 0;
         }
+        _raLen = 0; // written range may overlap the read-ahead window
         return result;
     }
 
@@ -412,6 +506,10 @@ public:
         if (!_opened || !_fd | !buf) {
             return 0;
         }
+        const size_t ra = _fs->getReadAheadSize();
+        if (ra) {
+            return _readCached(buf, size, ra);
+        }
         int result = lfs_file_read(_fs->getFS(), _getFD(), (void*) buf, size);
         if (result < 0) {
             DEBUGV("lfs_read rc=%d\n", result);
@@ -478,6 +576,7 @@ public:
             DEBUGV("lfs_file_truncate rc=%d\n", rc);
             return false;
         }
+        _raLen = 0; // window may extend past the new end of file
         return true;
     }
 
@@ -558,17 +657,117 @@ public:
         return (rc == 0) && (info.type == LFS_TYPE_DIR);
     }
 
+    const uint8_t* mapped(size_t& size) override {
+        size = 0;
+        if (!_opened || !_fd || (_flags & LFS_O_WRONLY)) {
+            return nullptr;
+        }
+        const auto f = _getFD();
+        if (f->flags & LFS_F_INLINE) {
+            // inline content lives inside a metadata pair, not at a stable offset
+            return nullptr;
+        }
+        if ((f->ctz.size == 0) || (f->ctz.size > _fs->_blockSize)) {
+            // multi-block files are chained through a CTZ skip-list and are
+            // not stored contiguously in flash
+            return nullptr;
+        }
+        // a single-block file is pure data from offset 0 of its only block
+        uint32_t phys = _fs->_start + (f->ctz.head * _fs->_blockSize);
+        if (phys + f->ctz.size > 0x100000) {
+            // filesystem area beyond the 1 MB mapped flash window
+            return nullptr;
+        }
+        size = f->ctz.size;
+        return (const uint8_t*) (0x40200000 + phys);
+    }
+
 protected:
     lfs_file_t *_getFD() const {
         return _fd.get();
     }
 
+    // read() with the read-ahead window from LittleFSConfig::setReadAhead().
+    // Small reads continuing a sequential streak are served from a RAM
+    // window refilled `ra` bytes at a time; random or large reads bypass it.
+    int _readCached(uint8_t* buf, size_t size, size_t ra) {
+        uint32_t pos = lfs_file_tell(_fs->getFS(), _getFD());
+        size_t copied = 0;
+
+        // a read picking up exactly where the previous one ended is sequential
+        if (pos == _seqPos) {
+            if (_seqStreak < 0xFF) {
+                ++_seqStreak;
+            }
+        } else {
+            _seqStreak = 0;
+        }
+
+        // serve whatever overlaps the cached window
+        if (_raLen && (pos >= _raPos) && (pos < _raPos + _raLen)) {
+            size_t n = _raPos + _raLen - pos;
+            if (n > size) {
+                n = size;
+            }
+            memcpy(buf, _raBuf.get() + (pos - _raPos), n);
+            if (lfs_file_seek(_fs->getFS(), _getFD(), pos + n, LFS_SEEK_SET) < 0) {
+                return 0;
+            }
+            copied += n;
+            pos += n;
+            size -= n;
+            if (!size) {
+                _seqPos = pos;
+                return copied;
+            }
+        }
+
+        int result = 0;
+        bool refill = (size < ra) && (_seqStreak >= 2);
+        if (refill && !_raBuf) {
+            _raBuf.reset(new (std::nothrow) uint8_t[ra]);
+            refill = (bool)_raBuf;
+        }
+        if (refill) {
+            // refill the window and copy out the head of it
+            int got = lfs_file_read(_fs->getFS(), _getFD(), (void*) _raBuf.get(), ra);
+            if (got < 0) {
+                DEBUGV("lfs_read rc=%d\n", got);
+                return copied;
+            }
+            _raPos = pos;
+            _raLen = got;
+            result = (size < (size_t) got) ? size : got;
+            memcpy(buf + copied, _raBuf.get(), result);
+            if (lfs_file_seek(_fs->getFS(), _getFD(), pos + result, LFS_SEEK_SET) < 0) {
+                _raLen = 0;
+                return copied;
+            }
+        } else {
+            // random or large read: go straight to lfs
+            result = lfs_file_read(_fs->getFS(), _getFD(), (void*) (buf + copied), size);
+            if (result < 0) {
+                DEBUGV("lfs_read rc=%d\n", result);
+                return copied;
+            }
+        }
+        _seqPos = pos + result;
+        return copied + result;
+    }
+
     LittleFSImpl                *_fs;
     std::shared_ptr<lfs_file_t>  _fd;
     std::shared_ptr<char>        _name;
     bool                         _opened;
     int                          _flags;
     time_t                       _creation;
+
+    // read-ahead window (see LittleFSConfig::setReadAhead)
+    std::unique_ptr<uint8_t[]>   _raBuf;
+    uint32_t                     _raPos = 0;
+    uint32_t                     _raLen = 0;
+    uint32_t                     _seqPos = 0;
+    uint8_t                      _seqStreak = 0;
 };
 
 class LittleFSDirImpl : public DirImpl
@@ -42,6 +42,10 @@ Netdump::~Netdump()
     {
         delete[] packetBuffer;
     }
+    if (ring)
+    {
+        delete[] ring;
+    }
 };
 
 void Netdump::setCallback(const Callback nc)
@@ -60,9 +64,15 @@ void Netdump::setFilter(const Filter nf)
     netDumpFilter = nf;
 }
 
+bool Netdump::setRawFilter(const String& expression)
+{
+    return rawFilter.compile(expression);
+}
+
 void Netdump::reset()
 {
     setCallback(nullptr, nullptr);
+    rawFilter.clear();
 }
 
 void Netdump::printDump(Print& out, Packet::PacketDetail ndd, const Filter nf)
@@ -107,6 +117,29 @@ bool Netdump::tcpDump(WiFiServer& tcpDumpServer, const Filter nf)
     return true;
 }
 
+bool Netdump::ringDump(WiFiServer& tcpDumpServer, const Filter nf)
+{
+    if (!ring)
+    {
+        ring = new (std::nothrow) RingSlot[ringSlots];
+
+        if (!ring)
+        {
+            return false;
+        }
+    }
+    ringWriteIdx = 0;
+    ringReadIdx  = 0;
+    ringDropped  = 0;
+
+    schedule_function(
+        [&tcpDumpServer, this, nf]()
+        {
+            ringDumpLoop(tcpDumpServer, nf);
+        });
+    return true;
+}
+
 void Netdump::capture(int netif_idx, const char* data, size_t len, int out, int success)
 {
     if (lwipCallback.execute(netif_idx, data, len, out, success) == 0)
@@ -120,6 +153,11 @@ void Netdump::netdumpCapture(int netif_idx, const char* data, size_t len, int ou
 {
     if (netDumpCallback)
     {
+        if (rawFilter.active() && !rawFilter.match(data, len))
+        {
+            // rejected on the raw bytes, before a Packet is even built
+            return;
+        }
         Packet np(millis(), netif_idx, data, len, out, success);
         if (netDumpFilter && !netDumpFilter(np))
         {
@@ -192,6 +230,115 @@ void Netdump::tcpDumpProcess(const Packet& np)
     }
 }
 
+void Netdump::writePcapngHeader(Stream& s) const
+{
+    uint32_t shb[7];
+    shb[0] = 0x0a0d0d0a;  // pcapng section header block
+    shb[1] = 28;          // block total length
+    shb[2] = 0x1a2b3c4d;  // byte-order magic
+    shb[3] = 0x00000001;  // pcapng major/minor version
+    shb[4] = 0xffffffff;  // section length unspecified
+    shb[5] = 0xffffffff;
+    shb[6] = 28;  // block total length (trailer)
+    s.write(reinterpret_cast<char*>(shb), 28);
+
+    uint32_t idb[5];
+    idb[0] = 1;               // pcapng interface description block
+    idb[1] = 20;              // block total length
+    idb[2] = 1;               // link type = ethernet (+ reserved)
+    idb[3] = ringSnapLength;  // snap length
+    idb[4] = 20;              // block total length (trailer)
+    s.write(reinterpret_cast<char*>(idb), 20);
+}
+
+void Netdump::ringCaptureProcess(const Packet& np)
+{
+    if (np.isTCP() && np.hasPort(tcpDumpClient.localPort()))
+    {
+        // skip myself
+        return;
+    }
+    if (ringWriteIdx - ringReadIdx >= ringSlots)
+    {
+        // ring full: drop and account, never grow or block in the capture
+        // hook - its cost must stay constant
+        ringDropped++;
+        return;
+    }
+    RingSlot& slot = ring[ringWriteIdx % ringSlots];
+    slot.cycles    = ESP.getCycleCount();
+    slot.origLen   = np.getPacketSize();
+    slot.inclLen   = slot.origLen > ringSnapLength ? ringSnapLength : slot.origLen;
+    memcpy(slot.data, np.rawData(), slot.inclLen);
+    ringWriteIdx = ringWriteIdx + 1;
+}
+
+void Netdump::ringDumpLoop(WiFiServer& tcpDumpServer, const Filter nf)
+{
+    if (tcpDumpServer.hasClient())
+    {
+        tcpDumpClient = tcpDumpServer.accept();
+        tcpDumpClient.setNoDelay(true);
+
+        ringWriteIdx   = 0;
+        ringReadIdx    = 0;
+        ringDropped    = 0;
+        ringBaseCycles = ESP.getCycleCount();
+        ringBaseUs     = micros64();
+        writePcapngHeader(tcpDumpClient);
+
+        setCallback(
+            [this](const Packet& ndp)
+            {
+                ringCaptureProcess(ndp);
+            },
+            nf);
+    }
+    if (!tcpDumpClient || !tcpDumpClient.connected())
+    {
+        setCallback(nullptr);
+    }
+
+    while (ringReadIdx != ringWriteIdx && tcpDumpClient
+           && tcpDumpClient.availableForWrite() >= (size_t)(32 + ringSnapLength + 4))
+    {
+        const RingSlot& slot = ring[ringReadIdx % ringSlots];
+
+        // Convert the captured cycle count to the pcapng microsecond clock.
+        // Moving the base forward with every record keeps the conversion
+        // wrap-safe as long as the ring is drained within one cycle-counter
+        // period (~50s).
+        ringBaseUs += (uint32_t)(slot.cycles - ringBaseCycles) / ESP.getCpuFreqMHz();
+        ringBaseCycles = slot.cycles;
+
+        uint32_t paddedLen = (slot.inclLen + 3) & ~3;
+        uint32_t epb[7];
+        epb[0] = 6;                            // pcapng enhanced packet block
+        epb[1] = 32 + paddedLen;               // block total length
+        epb[2] = 0;                            // interface id
+        epb[3] = (uint32_t)(ringBaseUs >> 32); // timestamp, microseconds
+        epb[4] = (uint32_t)ringBaseUs;
+        epb[5] = slot.inclLen;                 // captured length
+        epb[6] = slot.origLen;                 // original length
+        tcpDumpClient.write(reinterpret_cast<char*>(epb), 28);
+        tcpDumpClient.write(reinterpret_cast<const char*>(slot.data), slot.inclLen);
+
+        uint32_t trailer[2] = { 0, 32 + paddedLen };  // pad + block total length
+        tcpDumpClient.write(reinterpret_cast<char*>(trailer) + 4 - (paddedLen - slot.inclLen),
+                            4 + (paddedLen - slot.inclLen));
+        ringReadIdx = ringReadIdx + 1;
+    }
+
+    if (tcpDumpServer.status() != CLOSED)
+    {
+        schedule_function(
+            [&tcpDumpServer, this, nf]()
+            {
+                ringDumpLoop(tcpDumpServer, nf);
+            });
+    }
+}
+
 void Netdump::tcpDumpLoop(WiFiServer& tcpDumpServer, const Filter nf)
 {
     if (tcpDumpServer.hasClient())
@@ -27,6 +27,7 @@
 #include <lwipopts.h>
 #include <FS.h>
 #include "NetdumpPacket.h"
+#include "NetdumpRawFilter.h"
 #include <ESP8266WiFi.h>
 #include "CallBackList.h"
 
@@ -48,15 +49,37 @@ public:
     void setCallback(const Callback nc);
     void setCallback(const Callback nc, const Filter nf);
     void setFilter(const Filter nf);
+
+    // Compile a BPF-like expression (see NetdumpRawFilter.h) into a
+    // table-driven matcher executed on the raw frame bytes before any
+    // Packet object is built; much cheaper per rejected packet than a
+    // Filter callback.  Returns false and leaves no filter installed
+    // when the expression does not parse.
+    bool setRawFilter(const String& expression);
+
     void reset();
 
     void printDump(Print& out, Packet::PacketDetail ndd, const Filter nf = nullptr);
     void fileDump(File& outfile, const Filter nf = nullptr);
     bool tcpDump(WiFiServer& tcpDumpServer, const Filter nf = nullptr);
 
+    // Like tcpDump() but captures into a preallocated fixed-size ring at
+    // the phy_capture hook (truncated to ringSnapLength, cycle-count
+    // timestamped) and drains it opportunistically as a pcapng stream.
+    // Capture cost is constant and bounded so measuring does not perturb
+    // the traffic being measured; packets are dropped when the ring is
+    // full (see droppedPackets()).
+    bool ringDump(WiFiServer& tcpDumpServer, const Filter nf = nullptr);
+
+    uint32_t droppedPackets() const
+    {
+        return ringDropped;
+    }
+
 private:
-    Callback netDumpCallback = nullptr;
-    Filter   netDumpFilter   = nullptr;
+    Callback  netDumpCallback = nullptr;
+    Filter    netDumpFilter   = nullptr;
+    RawFilter rawFilter;
 
     static void capture(int netif_idx, const char* data, size_t len, int out, int success);
     static CallBackList<LwipCallback>           lwipCallback;
@@ -71,6 +94,10 @@ private:
 
     void writePcapHeader(Stream& s) const;
 
+    void ringCaptureProcess(const Packet& np);
+    void ringDumpLoop(WiFiServer& tcpDumpServer, const Filter nf);
+    void writePcapngHeader(Stream& s) const;
+
     WiFiClient tcpDumpClient;
     char*      packetBuffer = nullptr;
     int        bufferIndex  = 0;
@@ -78,6 +105,27 @@ private:
     static constexpr int      tcpBufferSize = 2048;
     static constexpr int      maxPcapLength = 1024;
     static constexpr uint32_t pcapMagic     = 0xa1b2c3d4;
+
+    static constexpr uint32_t ringSlots      = 32;
+    static constexpr uint16_t ringSnapLength = 128;
+
+    struct RingSlot
+    {
+        uint32_t cycles;
+        uint16_t origLen;
+        uint16_t inclLen;
+        uint8_t  data[ringSnapLength];
+    };
+
+    // free-running indices, capture writes / drain loop reads
+    RingSlot*         ring         = nullptr;
+    volatile uint32_t ringWriteIdx = 0;
+    volatile uint32_t ringReadIdx  = 0;
+    uint32_t          ringDropped  = 0;
+
+    // cycle-count to microsecond conversion base, moved forward at drain
+    uint32_t ringBaseCycles = 0;
+    uint64_t ringBaseUs     = 0;
 };
 
 }  // namespace NetCapture
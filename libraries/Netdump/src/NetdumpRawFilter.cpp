@@ -0,0 +1,216 @@
+/*
+    NetdumpRawFilter.cpp
+
+    NetDump library - tcpdump-like packet logger facility
+
+    This file is part of the esp8266 core for Arduino environment.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "NetdumpRawFilter.h"
+#include <IPAddress.h>
+
+namespace NetCapture
+{
+
+static String nextToken(const String& s, unsigned int& pos)
+{
+    while (pos < s.length() && s[pos] == ' ')
+    {
+        pos++;
+    }
+    unsigned int start = pos;
+    while (pos < s.length() && s[pos] != ' ')
+    {
+        pos++;
+    }
+    return s.substring(start, pos);
+}
+
+bool RawFilter::compile(const String& expression)
+{
+    ops.clear();
+
+    unsigned int pos = 0;
+    bool         neg = false;
+    while (true)
+    {
+        String token = nextToken(expression, pos);
+        if (!token.length())
+        {
+            break;
+        }
+        if (token == F("not"))
+        {
+            neg = !neg;
+            continue;
+        }
+        if (token == F("and"))
+        {
+            // adjacency already means "and"
+            continue;
+        }
+        if (token == F("or"))
+        {
+            if (neg || ops.empty() || ops.back().code == Op::Or)
+            {
+                ops.clear();
+                return false;
+            }
+            ops.push_back({ Op::Or, false, 0 });
+            continue;
+        }
+
+        Op op{ Op::Ethertype, neg, 0 };
+        if (token == F("arp"))
+        {
+            op.value = 0x0806;
+        }
+        else if (token == F("ip"))
+        {
+            op.value = 0x0800;
+        }
+        else if (token == F("icmp"))
+        {
+            op = { Op::IpProto, neg, 1 };
+        }
+        else if (token == F("tcp"))
+        {
+            op = { Op::IpProto, neg, 6 };
+        }
+        else if (token == F("udp"))
+        {
+            op = { Op::IpProto, neg, 17 };
+        }
+        else if (token == F("port"))
+        {
+            long port = nextToken(expression, pos).toInt();
+            if (port <= 0 || port > 65535)
+            {
+                ops.clear();
+                return false;
+            }
+            op = { Op::Port, neg, (uint32_t)port };
+        }
+        else if (token == F("host"))
+        {
+            IPAddress addr;
+            if (!addr.fromString(nextToken(expression, pos)) || !addr.isV4())
+            {
+                ops.clear();
+                return false;
+            }
+            op = { Op::Host, neg, addr.v4() };
+        }
+        else
+        {
+            ops.clear();
+            return false;
+        }
+        ops.push_back(op);
+        neg = false;
+    }
+
+    if (neg || (!ops.empty() && ops.back().code == Op::Or))
+    {
+        // dangling "not" / "or"
+        ops.clear();
+        return false;
+    }
+    return true;
+}
+
+bool RawFilter::match(const char* data, size_t len) const
+{
+    if (ops.empty())
+    {
+        return true;
+    }
+    if (len < 14)
+    {
+        return false;
+    }
+
+    // decode the few fields the ops can refer to, straight from the frame
+    const uint8_t* f         = (const uint8_t*)data;
+    uint16_t       ethertype = (f[12] << 8) | f[13];
+    bool           isIp      = ethertype == 0x0800 && len >= 34;
+    uint8_t        ipProto   = isIp ? f[23] : 0;
+
+    uint16_t srcPort = 0;
+    uint16_t dstPort = 0;
+    if (isIp && (ipProto == 6 || ipProto == 17))
+    {
+        size_t l4 = 14 + (f[14] & 0x0f) * 4;
+        // ports are only valid in the first fragment
+        bool firstFrag = (((f[20] & 0x1f) << 8) | f[21]) == 0;
+        if (firstFrag && len >= l4 + 4)
+        {
+            srcPort = (f[l4] << 8) | f[l4 + 1];
+            dstPort = (f[l4 + 2] << 8) | f[l4 + 3];
+        }
+    }
+
+    uint32_t srcAddr = 0;
+    uint32_t dstAddr = 0;
+    if (isIp)
+    {
+        memcpy(&srcAddr, f + 26, 4);
+        memcpy(&dstAddr, f + 30, 4);
+    }
+
+    bool result = true;
+    for (auto& op : ops)
+    {
+        if (op.code == Op::Or)
+        {
+            if (result)
+            {
+                return true;
+            }
+            result = true;
+            continue;
+        }
+        if (!result)
+        {
+            // alternative already failed, skip to next "or"
+            continue;
+        }
+
+        bool v = false;
+        switch (op.code)
+        {
+        case Op::Ethertype:
+            v = ethertype == op.value;
+            break;
+        case Op::IpProto:
+            v = isIp && ipProto == op.value;
+            break;
+        case Op::Port:
+            v = srcPort && (srcPort == op.value || dstPort == op.value);
+            break;
+        case Op::Host:
+            v = isIp && (srcAddr == op.value || dstAddr == op.value);
+            break;
+        default:
+            break;
+        }
+        result = op.neg ? !v : v;
+    }
+    return result;
+}
+
+} /* namespace NetCapture */
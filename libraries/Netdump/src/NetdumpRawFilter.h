@@ -0,0 +1,89 @@
+/*
+    NetdumpRawFilter.h
+
+    NetDump library - tcpdump-like packet logger facility
+
+    This file is part of the esp8266 core for Arduino environment.
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef LIBRARIES_NETDUMP_SRC_NETDUMPRAWFILTER_H_
+#define LIBRARIES_NETDUMP_SRC_NETDUMPRAWFILTER_H_
+
+#include "Arduino.h"
+#include <vector>
+
+namespace NetCapture
+{
+
+/*
+    Small BPF-like packet filter running on the raw ethernet frame bytes,
+    before any Packet object is constructed.  A filter expression is
+    compiled once into a flat op table; match() then walks the table with
+    a handful of integer compares, so rejected traffic costs tens of
+    cycles instead of a Packet construction plus std::function call.
+
+    Expression grammar (whitespace separated):
+        arp | ip | icmp | tcp | udp       protocol primitives
+        port <n>                          TCP/UDP source or destination port
+        host <a.b.c.d>                    IPv4 source or destination address
+        not <primitive>                   negation
+        or                                alternative; adjacency means "and"
+
+    e.g. "tcp port 80", "not arp", "host 192.168.1.20 or udp"
+*/
+class RawFilter
+{
+public:
+    // compile an expression into the op table, false (and inactive) on error
+    bool compile(const String& expression);
+
+    void clear()
+    {
+        ops.clear();
+    }
+
+    bool active() const
+    {
+        return !ops.empty();
+    }
+
+    // run the op table against a raw ethernet frame
+    bool match(const char* data, size_t len) const;
+
+private:
+    struct Op
+    {
+        enum OpCode : uint8_t
+        {
+            Ethertype,  // value = ethertype
+            IpProto,    // value = IPv4 protocol number
+            Port,       // value = TCP/UDP port, either direction
+            Host,       // value = IPv4 address (network byte order), either direction
+            Or,         // alternative separator
+        };
+
+        OpCode   code;
+        bool     neg;
+        uint32_t value;
+    };
+
+    std::vector<Op> ops;
+};
+
+} /* namespace NetCapture */
+
+#endif /* LIBRARIES_NETDUMP_SRC_NETDUMPRAWFILTER_H_ */
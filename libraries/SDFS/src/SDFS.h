@@ -27,7 +27,9 @@
  License along with this library; if not, write to the Free Software
  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <assert.h>
 #include <FSImpl.h>
 #include "debug.h"
@@ -62,11 +64,20 @@ public:
         _part = part;
         return *this;
     }
+    // Per-file read-ahead in bytes (rounded up to whole sectors by use).
+    // Small sequential reads are served from this buffer, which is refilled
+    // in one large SdFat read so the card sees multi-block streaming
+    // transfers (CMD18) instead of single-sector exchanges. 0 disables.
+    SDFSConfig setReadAhead(uint16_t bytes) {
+        _readAhead = bytes;
+        return *this;
+    }
 
     // Inherit _type and _autoFormat
     uint8_t   _csPin;
     uint8_t   _part;
     uint32_t  _spiSettings;
+    uint16_t  _readAhead = 2048;
 };
 
 class SDFSImpl : public fs::FSImpl
@@ -222,6 +233,10 @@ public:
         *dosTime = (tiempo->tm_hour << 11) | (tiempo->tm_min << 5) | tiempo->tm_sec;
     }
 
+    uint16_t getReadAhead() const {
+        return _cfg._readAhead;
+    }
+
 protected:
     friend class SDFileImpl;
     friend class SDFSDirImpl;
@@ -262,7 +277,7 @@ class SDFSFileImpl : public fs::FileImpl
 {
 public:
     SDFSFileImpl(SDFSImpl *fs, std::shared_ptr<File32> fd, const char *name)
-        : _fs(fs), _fd(fd), _opened(true)
+        : _fs(fs), _fd(fd), _opened(true), _raSize(fs->getReadAhead())
     {
         _name = std::shared_ptr<char>(new char[strlen(name) + 1], std::default_delete<char[]>());
         strcpy(_name.get(), name);
@@ -281,12 +296,50 @@ public:
 
     size_t write(const uint8_t *buf, size_t size) override
     {
-        return _opened ? _fd->write(buf, size) : -1;
+        if (!_opened) {
+            return -1;
+        }
+        _raDiscard(); // reposition before writing past stale read-ahead
+        return _fd->write(buf, size);
     }
 
     int read(uint8_t* buf, size_t size) override
     {
-        return _opened ? _fd->read(buf, size) : -1;
+        if (!_opened) {
+            return -1;
+        }
+        if (!_raSize || size >= _raSize) {
+            // Large reads go straight through - SdFat already streams them
+            // as multi-block transfers. Drop any buffered span first.
+            _raDiscard();
+            return _fd->read(buf, size);
+        }
+        if (!_raBuf) {
+            _raBuf.reset(new (std::nothrow) uint8_t[_raSize]);
+            if (!_raBuf) {
+                _raSize = 0;
+                return _fd->read(buf, size);
+            }
+        }
+        // Serve small sequential reads from the read-ahead buffer; each
+        // refill is one large read, so the card sees a multi-block
+        // streaming transfer instead of per-call single-sector exchanges.
+        size_t done = 0;
+        while (done < size) {
+            if (_raOff == _raLen) {
+                int got = _fd->read(_raBuf.get(), _raSize);
+                if (got <= 0) {
+                    break;
+                }
+                _raLen = got;
+                _raOff = 0;
+            }
+            size_t chunk = std::min(size - done, (size_t)(_raLen - _raOff));
+            memcpy(buf + done, _raBuf.get() + _raOff, chunk);
+            _raOff += chunk;
+            done += chunk;
+        }
+        return done;
     }
 
     void flush() override
@@ -301,6 +354,7 @@ public:
         if (!_opened) {
             return false;
         }
+        _raDiscard(); // rewinds fd to the logical position first
         switch (mode) {
             case fs::SeekSet:
                 return _fd->seekSet(pos);
@@ -318,7 +372,8 @@ public:
 
     size_t position() const override
     {
-        return _opened ? _fd->curPosition() : 0;
+        // fd runs ahead of the logical position by the unread buffered span
+        return _opened ? (_fd->curPosition() - (_raLen - _raOff)) : 0;
     }
 
     size_t size() const override
@@ -332,6 +387,7 @@ public:
             DEBUGV("SDFSFileImpl::truncate: file not opened\n");
             return false;
         }
+        _raDiscard();
         return _fd->truncate(size);
     }
 
@@ -398,9 +454,24 @@ public:
 
 protected:
     SDFSImpl*                _fs;
+    // Forget buffered read-ahead, rewinding the fd to the logical position
+    // so that subsequent writes/seeks land where the caller expects.
+    void _raDiscard()
+    {
+        if (_raLen > _raOff) {
+            _fd->seekSet(_fd->curPosition() - (_raLen - _raOff));
+        }
+        _raOff = 0;
+        _raLen = 0;
+    }
+
     std::shared_ptr<File32>  _fd;
     std::shared_ptr<char>    _name;
     bool                     _opened;
+    std::unique_ptr<uint8_t[]> _raBuf;
+    uint16_t                 _raSize = 0; // from SDFSConfig::setReadAhead()
+    uint16_t                 _raOff = 0;
+    uint16_t                 _raLen = 0;
 };
 
 class SDFSDirImpl : public fs::DirImpl
@@ -21,6 +21,8 @@
 
 #include "SPI.h"
 #include "HardwareSerial.h"
+#include "interrupts.h"
+#include <ets_sys.h>
 
 #define SPI_PINS_HSPI			0 // Normal HSPI mode (MISO = GPIO12, MOSI = GPIO13, SCLK = GPIO14);
 #define SPI_PINS_HSPI_OVERLAP	1 // HSPI Overllaped in spi0 pins (MISO = SD0, MOSI = SDD1, SCLK = CLK);
@@ -617,6 +619,174 @@ void SPIClass::transferBytes_(const uint8_t * out, uint8_t * in, uint8_t size) {
     }
 }
 
+/**
+ * Queued asynchronous mode.
+ *
+ * The queue is advanced from the SPI1 transfer-done interrupt
+ * (SPISTRIE/SPISTRIS, shared ETS_SPI line dispatched via SPIIR):
+ * each interrupt drains the FIFO of the finished 64-byte chunk and
+ * starts the next one, so the CPU is free between chunks.
+ * FIFO fill/drain is done byte-wise so application buffers need not
+ * be 32-bit aligned (an op spends ~us on the wire per FIFO word,
+ * the gather loop is noise in comparison).
+ */
+
+#define SPI_ASYNC_QUEUE_SIZE 8
+
+typedef struct {
+    const uint8_t * out;
+    uint8_t * in;
+    uint32_t size;
+    uint32_t offset;
+    SPIClass::spi_async_cb_t callback;
+} spi_async_op_t;
+
+static spi_async_op_t _spi_async_queue[SPI_ASYNC_QUEUE_SIZE];
+// free running, ISR advances head, submitters advance tail
+static volatile uint8_t _spi_async_head = 0;
+static volatile uint8_t _spi_async_tail = 0;
+static volatile bool _spi_async_running = false;
+static bool _spi_async_attached = false;
+
+#define SPI_ASYNC_INT_STATUS (SPISTRIS | SPISWSIS | SPISRSIS | SPISWBIS | SPISRBIS)
+
+static void IRAM_ATTR _spi_async_setDataBits(uint16_t bits) {
+    const uint32_t mask = ~((SPIMMOSI << SPILMOSI) | (SPIMMISO << SPILMISO));
+    bits--;
+    SPI1U1 = ((SPI1U1 & mask) | ((bits << SPILMOSI) | (bits << SPILMISO)));
+}
+
+static void IRAM_ATTR _spi_async_start_chunk() {
+    spi_async_op_t * op = &_spi_async_queue[_spi_async_head % SPI_ASYNC_QUEUE_SIZE];
+    uint32_t chunk = op->size - op->offset;
+    if (chunk > 64) {
+        chunk = 64;
+    }
+
+    _spi_async_setDataBits(chunk * 8);
+
+    volatile uint32_t * fifoPtr = &SPI1W0;
+    uint32_t words = (chunk + 3) / 4;
+    if (op->out) {
+        const uint8_t * data = op->out + op->offset;
+        uint32_t left = chunk;
+        while (words--) {
+            uint32_t w = 0xFFFFFFFF;
+            uint8_t * wb = (uint8_t *)&w;
+            for (uint32_t b = 0; b < 4 && left; b++, left--) {
+                wb[b] = *(data++);
+            }
+            *(fifoPtr++) = w;
+        }
+    } else {
+        // no out data, only read, fill with dummy data!
+        while (words--) {
+            *(fifoPtr++) = 0xFFFFFFFF;
+        }
+    }
+
+    __sync_synchronize();
+    SPI1CMD |= SPIBUSY;
+}
+
+static void IRAM_ATTR _spi_async_isr(void *) {
+    if (!(SPIIR & (1 << SPII1))) {
+        // SPI0 or I2S raised the shared interrupt line, not us
+        return;
+    }
+    SPI1S &= ~SPI_ASYNC_INT_STATUS; // ack
+
+    if (!_spi_async_running) {
+        return;
+    }
+
+    spi_async_op_t * op = &_spi_async_queue[_spi_async_head % SPI_ASYNC_QUEUE_SIZE];
+    uint32_t chunk = op->size - op->offset;
+    if (chunk > 64) {
+        chunk = 64;
+    }
+
+    if (op->in) {
+        uint8_t * in = op->in + op->offset;
+        volatile uint32_t * fifoPtr = &SPI1W0;
+        uint32_t left = chunk;
+        while (left) {
+            uint32_t w = *(fifoPtr++);
+            uint8_t * wb = (uint8_t *)&w;
+            for (uint32_t b = 0; b < 4 && left; b++, left--) {
+                *(in++) = wb[b];
+            }
+        }
+    }
+    op->offset += chunk;
+
+    if (op->offset >= op->size) {
+        SPIClass::spi_async_cb_t callback = op->callback;
+        _spi_async_head = _spi_async_head + 1;
+        if (_spi_async_head == _spi_async_tail) {
+            _spi_async_running = false;
+            SPI1S &= ~SPISTRIE;
+        } else {
+            _spi_async_start_chunk();
+        }
+        if (callback) {
+            callback(); // interrupt context!
+        }
+    } else {
+        _spi_async_start_chunk();
+    }
+}
+
+bool SPIClass::transferBytesAsync(const uint8_t * out, uint8_t * in, uint32_t size, spi_async_cb_t callback) {
+    if (!size) {
+        return false;
+    }
+    if ((uint8_t)(_spi_async_tail - _spi_async_head) >= SPI_ASYNC_QUEUE_SIZE) {
+        // queue full (head only ever advances, stale reads are safe)
+        return false;
+    }
+
+    esp8266::InterruptLock lock;
+
+    spi_async_op_t * op = &_spi_async_queue[_spi_async_tail % SPI_ASYNC_QUEUE_SIZE];
+    op->out = out;
+    op->in = in;
+    op->size = size;
+    op->offset = 0;
+    op->callback = callback;
+    __sync_synchronize();
+    _spi_async_tail = _spi_async_tail + 1;
+
+    if (!_spi_async_running) {
+        if (!_spi_async_attached) {
+            ETS_SPI_INTR_ATTACH(_spi_async_isr, nullptr);
+            ETS_SPI_INTR_ENABLE();
+            _spi_async_attached = true;
+        }
+        // let a possible synchronous transfer finish first
+        while(SPI1CMD & SPIBUSY) {}
+        SPI1S &= ~SPI_ASYNC_INT_STATUS;
+        SPI1S |= SPISTRIE;
+        _spi_async_running = true;
+        _spi_async_start_chunk();
+    }
+    return true;
+}
+
+bool SPIClass::writeBytesAsync(const uint8_t * data, uint32_t size, spi_async_cb_t callback) {
+    return transferBytesAsync(data, nullptr, size, callback);
+}
+
+bool SPIClass::asyncPending() const {
+    return _spi_async_running;
+}
+
+void SPIClass::flushAsync() {
+    while (_spi_async_running) {
+        optimistic_yield(1000);
+    }
+}
+
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SPI)
 SPIClass SPI;
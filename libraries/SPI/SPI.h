@@ -73,6 +73,22 @@ public:
   void writePattern(const uint8_t * data, uint8_t size, uint32_t repeat);
   void transferBytes(const uint8_t * out, uint8_t * in, uint32_t size);
   void endTransaction(void);
+
+  // ---- queued asynchronous mode ----
+  // Operations are appended to a small command queue which the SPI
+  // transfer-done interrupt advances one 64-byte FIFO chunk at a time,
+  // so large transfers (display refresh etc.) overlap with loop() work
+  // instead of spinning on SPIBUSY.
+  // The optional completion callback runs in interrupt context: keep it
+  // short, IRAM-safe, and use schedule_function() for real work.
+  // Do not issue synchronous transfers while asyncPending() is true.
+  typedef void (*spi_async_cb_t)(void);
+  // false when the queue is full (or size is 0), op not queued
+  bool writeBytesAsync(const uint8_t * data, uint32_t size, spi_async_cb_t callback = nullptr);
+  bool transferBytesAsync(const uint8_t * out, uint8_t * in, uint32_t size, spi_async_cb_t callback = nullptr);
+  bool asyncPending() const;
+  // block (yielding) until the queue has drained
+  void flushAsync();
 private:
   bool useHwCs;
   uint8_t pinSet;
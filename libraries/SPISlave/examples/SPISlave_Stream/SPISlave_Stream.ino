@@ -0,0 +1,54 @@
+/*
+    SPI Slave Streaming Demo Sketch
+    Connect the SPI Master device to the following pins on the esp8266:
+
+    GPIO    NodeMCU   Name  |   STM32 / Uno
+  =========================================
+     15       D8       SS   |   D10
+     13       D7      MOSI  |   D11
+     12       D6      MISO  |   D12
+     14       D5      SCK   |   D13
+
+    Bulk transfer protocol, sender side (master):
+    - every 32-byte write starts with a running sequence number in byte 0,
+      the remaining 31 bytes are payload
+    - the master may read the slave's status register at any time; it holds
+      the sequence number of the last window the slave received, so the
+      master can throttle when it gets too far ahead of the acknowledgments
+    - lost windows show up as sequence gaps and are counted by
+      SPISlave.streamDropped()
+
+    The ISR advances through a ring of 32-byte windows on its own; the
+    onStreamData callback fires once per completed ring half and runs in
+    interrupt context, so only copy or hand the data off there.
+*/
+
+#include "SPISlave.h"
+
+volatile uint32_t received = 0;
+
+void setup() {
+  Serial.begin(115200);
+
+  // one callback per ring half (4 windows = 128 bytes with the ring below)
+  SPISlave.onStreamData([](uint8_t *data, size_t len) {
+    // byte 0 of each 32-byte window is the sequence number,
+    // bytes 1..31 are payload
+    (void)data;
+    received += len;
+  });
+
+  // 8 windows of 32 bytes, callback fires per half (128 bytes)
+  if (!SPISlave.beginStream(4, 8)) {
+    Serial.println("beginStream failed (no memory)");
+  }
+}
+
+void loop() {
+  static uint32_t last = 0;
+  if (millis() - last >= 1000) {
+    last = millis();
+    Serial.printf("received %u bytes, %u windows dropped\n", received, SPISlave.streamDropped());
+    received = 0;
+  }
+}
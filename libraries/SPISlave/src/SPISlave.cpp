@@ -47,6 +47,12 @@ void SPISlaveClass::_status_tx(void)
         _status_sent_cb();
     }
 }
+void SPISlaveClass::_stream_rx(uint8_t * data, uint8_t windows)
+{
+    if(_stream_cb) {
+        _stream_cb(data, (size_t)windows * 32);
+    }
+}
 void SPISlaveClass::_s_data_rx(void *arg, uint8_t * data, uint8_t len)
 {
     reinterpret_cast<SPISlaveClass*>(arg)->_data_rx(data,len);
@@ -63,6 +69,10 @@ void SPISlaveClass::_s_status_tx(void *arg)
 {
     reinterpret_cast<SPISlaveClass*>(arg)->_status_tx();
 }
+void SPISlaveClass::_s_stream_rx(void *arg, uint8_t * data, uint8_t windows)
+{
+    reinterpret_cast<SPISlaveClass*>(arg)->_stream_rx(data, windows);
+}
 void SPISlaveClass::begin() //backwards compatibility
 {
     begin(4);
@@ -77,12 +87,49 @@ void SPISlaveClass::begin(uint8_t statusLength)
 }
 void SPISlaveClass::end()
 {
+    endStream();
     hspi_slave_onData(nullptr);
     hspi_slave_onDataSent(nullptr);
     hspi_slave_onStatus(nullptr);
     hspi_slave_onStatusSent(nullptr);
     hspi_slave_end();
 }
+bool SPISlaveClass::beginStream(uint8_t statusLength, uint8_t windows)
+{
+    if(_ring) {
+        endStream();
+    }
+    windows &= ~1; //whole halves only
+    if(windows < 2) {
+        windows = 2;
+    } else if(windows > 16) {
+        windows = 16; //512 byte ring
+    }
+    _ring = (uint8_t *)malloc((size_t)windows * 32);
+    if(!_ring) {
+        return false;
+    }
+    begin(statusLength);
+    hspi_slave_streamBegin(_ring, windows, &_s_stream_rx);
+    return true;
+}
+void SPISlaveClass::endStream()
+{
+    if(!_ring) {
+        return;
+    }
+    hspi_slave_streamEnd();
+    free(_ring);
+    _ring = NULL;
+}
+void SPISlaveClass::onStreamData(SpiSlaveDataHandler cb)
+{
+    _stream_cb = cb;
+}
+uint32_t SPISlaveClass::streamDropped()
+{
+    return hspi_slave_streamDropped();
+}
 void SPISlaveClass::setData(uint8_t * data, size_t len)
 {
     if(len > 32) {
@@ -35,25 +35,45 @@ protected:
     SpiSlaveStatusHandler _status_cb;
     SpiSlaveSentHandler _data_sent_cb;
     SpiSlaveSentHandler _status_sent_cb;
+    SpiSlaveDataHandler _stream_cb;
+    uint8_t * _ring;
     void _data_rx(uint8_t * data, uint8_t len);
     void _status_rx(uint32_t data);
     void _data_tx(void);
     void _status_tx(void);
+    void _stream_rx(uint8_t * data, uint8_t windows);
     static void _s_data_rx(void *arg, uint8_t * data, uint8_t len);
     static void _s_status_rx(void *arg, uint32_t data);
     static void _s_data_tx(void *arg);
     static void _s_status_tx(void *arg);
+    static void _s_stream_rx(void *arg, uint8_t * data, uint8_t windows);
 public:
     SPISlaveClass()
         : _data_cb(NULL)
         , _status_cb(NULL)
         , _data_sent_cb(NULL)
         , _status_sent_cb(NULL)
+        , _stream_cb(NULL)
+        , _ring(NULL)
     {}
     ~SPISlaveClass() {}
     void begin();
     void begin(uint8_t statusLength);
     void end();
+
+    // Bulk streaming mode for sustained transfers: the ISR auto-advances
+    // through a ring of 'windows' 32-byte buffers and the onStreamData
+    // callback fires once per completed ring half, so per-window callback
+    // overhead disappears and the sender keeps clocking into one half while
+    // the sketch consumes the other.  Protocol: the sender puts a running
+    // sequence number in byte 0 of every window (31 payload bytes follow)
+    // and may read the status register, which acknowledges the last
+    // sequence received; gaps are counted in streamDropped().  The
+    // callback runs in interrupt context - keep it short, or just copy.
+    bool beginStream(uint8_t statusLength = 4, uint8_t windows = 8);
+    void endStream();
+    void onStreamData(SpiSlaveDataHandler cb);
+    uint32_t streamDropped();
     void setData(uint8_t * data, size_t len);
     void setData(const char * data)
     {
@@ -28,6 +28,14 @@ static void (*_hspi_slave_rx_status_cb)(void * arg, uint32_t data) = NULL;
 static void (*_hspi_slave_tx_status_cb)(void * arg) = NULL;
 static uint8_t _hspi_slave_buffer[33];
 
+//streaming mode state
+static uint8_t * _hspi_slave_ring = NULL;
+static uint8_t _hspi_slave_ring_windows = 0;
+static volatile uint8_t _hspi_slave_ring_wpos = 0;
+static volatile uint8_t _hspi_slave_ring_seq = 0;
+static volatile uint32_t _hspi_slave_ring_dropped = 0;
+static void (*_hspi_slave_half_cb)(void * arg, uint8_t * data, uint8_t windows) = NULL;
+
 void IRAM_ATTR _hspi_slave_isr_handler(void *arg, void *frame)
 {
     (void) frame;
@@ -53,7 +61,42 @@ void IRAM_ATTR _hspi_slave_isr_handler(void *arg, void *frame)
             uint32_t s = SPI1WS;
             _hspi_slave_rx_status_cb(arg, s);
         }
-        if((status & SPISWBIS) != 0 && (_hspi_slave_rx_data_cb)) {
+        if((status & SPISWBIS) != 0 && (_hspi_slave_ring)) {
+            //streaming mode: unpack straight into the next ring window,
+            //only a completed ring half leaves the ISR
+            uint8_t * dst = _hspi_slave_ring + ((uint32_t)_hspi_slave_ring_wpos << 5);
+            uint8_t half = _hspi_slave_ring_windows >> 1;
+            uint8_t next;
+            uint8_t i;
+            uint32_t data;
+            for(i=0; i<8; i++) {
+                data=SPI1W(i);
+                dst[i<<2] = data & 0xff;
+                dst[(i<<2)+1] = (data >> 8) & 0xff;
+                dst[(i<<2)+2] = (data >> 16) & 0xff;
+                dst[(i<<2)+3] = (data >> 24) & 0xff;
+            }
+            //first byte of every window carries the sender's sequence number
+            if(dst[0] != _hspi_slave_ring_seq) {
+                _hspi_slave_ring_dropped += (uint8_t)(dst[0] - _hspi_slave_ring_seq);
+            }
+            _hspi_slave_ring_seq = dst[0] + 1;
+            //acknowledge it in the status register for sender-side flow control
+            SPI1WS = dst[0];
+
+            next = _hspi_slave_ring_wpos + 1;
+            if(next == half) {
+                if(_hspi_slave_half_cb) {
+                    _hspi_slave_half_cb(arg, _hspi_slave_ring, half);
+                }
+            } else if(next == _hspi_slave_ring_windows) {
+                if(_hspi_slave_half_cb) {
+                    _hspi_slave_half_cb(arg, _hspi_slave_ring + ((uint32_t)half << 5), half);
+                }
+                next = 0;
+            }
+            _hspi_slave_ring_wpos = next;
+        } else if((status & SPISWBIS) != 0 && (_hspi_slave_rx_data_cb)) {
             uint8_t i;
             uint32_t data;
             _hspi_slave_buffer[32] = 0;
@@ -148,6 +191,29 @@ void hspi_slave_setData(uint8_t *data, uint8_t len)
     }
 }
 
+void hspi_slave_streamBegin(uint8_t *ring, uint8_t windows, void (*half_cb)(void *, uint8_t *, uint8_t))
+{
+    _hspi_slave_ring_wpos = 0;
+    _hspi_slave_ring_seq = 0;
+    _hspi_slave_ring_dropped = 0;
+    _hspi_slave_ring_windows = windows;
+    _hspi_slave_half_cb = half_cb;
+    _hspi_slave_ring = ring;
+}
+
+void hspi_slave_streamEnd()
+{
+    //detach the ring before the caller frees it
+    _hspi_slave_ring = NULL;
+    _hspi_slave_half_cb = NULL;
+    _hspi_slave_ring_windows = 0;
+}
+
+uint32_t hspi_slave_streamDropped()
+{
+    return _hspi_slave_ring_dropped;
+}
+
 void hspi_slave_onData(void (*rxd_cb)(void *, uint8_t *, uint8_t))
 {
     _hspi_slave_rx_data_cb = rxd_cb;
@@ -41,4 +41,15 @@ void hspi_slave_onDataSent(void (*txd_cb)(void *));
 void hspi_slave_onStatus(void (*rxs_cb)(void *, uint32_t));
 void hspi_slave_onStatusSent(void (*txs_cb)(void *));
 
+//bulk streaming mode: the ISR copies each 32-byte transaction into the next
+//window of 'ring' (windows * 32 bytes, an even window count) and calls
+//half_cb once per completed ring half with the half's start and its window
+//count.  The first byte of every window is the sender's sequence number; it
+//is acknowledged in the status register after each window so the master can
+//throttle, and gaps are counted for hspi_slave_streamDropped().
+//Replaces the per-window onData delivery until hspi_slave_streamEnd().
+void hspi_slave_streamBegin(uint8_t *ring, uint8_t windows, void (*half_cb)(void *, uint8_t *, uint8_t));
+void hspi_slave_streamEnd();
+uint32_t hspi_slave_streamDropped();
+
 #endif
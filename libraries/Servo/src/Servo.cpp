@@ -22,9 +22,12 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
 
 #include <Arduino.h>
 #include <Servo.h>
+#include <Schedule.h>
 #include "core_esp8266_waveform.h"
 
 uint32_t Servo::_servoMap = 0;
+uint32_t Servo::_slotMap = 0;
+uint8_t Servo::_slotPin[MAX_SERVOS];
 
 // similar to map but will have increased accuracy that provides a more
 // symmetrical api (call it and use result to reverse will provide the original value)
@@ -69,6 +72,15 @@ uint8_t Servo::attach(int pin, uint16_t minUs, uint16_t maxUs)
 uint8_t Servo::attach(int pin, uint16_t minUs, uint16_t maxUs, int value)
 {
   if (!_attached) {
+    // claim the lowest free slot in the shared refresh frame; the pulse for
+    // this channel is emitted at the slot's fixed phase offset
+    uint32_t freeSlots = ~_slotMap & ((1UL << MAX_SERVOS) - 1);
+    if (!freeSlots) {
+      return 0;
+    }
+    _slot = __builtin_ffs(freeSlots) - 1;
+    _slotMap |= (1UL << _slot);
+    _slotPin[_slot] = pin;
     pinMode(pin, OUTPUT);
     digitalWrite(pin, LOW);
     _pin = pin;
@@ -90,6 +102,7 @@ void Servo::detach()
 {
   if (_attached) {
     _servoMap &= ~(1 << _pin);
+    _slotMap &= ~(1UL << _slot);
     startWaveform(_pin, 0, REFRESH_INTERVAL, 1);
     delay(REFRESH_INTERVAL / 1000); // long enough to complete active period under all circumstances.
     stopWaveform(_pin);
@@ -114,15 +127,134 @@ void Servo::writeMicroseconds(int value)
   _valueUs = value;
   if (_attached) {
     _servoMap &= ~(1 << _pin);
-    // Find the first GPIO being generated by checking GCC's find-first-set (returns 1 + the bit of the first 1 in an int32_t)
-    int phaseReference = __builtin_ffs(_servoMap) - 1;
-    if (startWaveform(_pin, _valueUs, REFRESH_INTERVAL - _valueUs, 0, phaseReference))
+    // Phase lock this channel into its frame slot: reference the earliest
+    // slot already generating a waveform, offset by the slot distance. The
+    // phase parameters only take effect when the waveform is first started;
+    // later calls merely latch the new duty cycle at the next period start.
+    int8_t phaseReference = -1;
+    uint32_t phaseOffsetUs = 0;
+    for (uint8_t slot = 0; slot < MAX_SERVOS; slot++) {
+      if ((slot != _slot) && (_slotMap & (1UL << slot)) && (_servoMap & (1UL << _slotPin[slot]))) {
+        phaseReference = _slotPin[slot];
+        int32_t offsetUs = ((int32_t)_slot - (int32_t)slot) * SERVO_FRAME_SLOT_WIDTH;
+        if (offsetUs < 0) {
+          offsetUs += REFRESH_INTERVAL;
+        }
+        phaseOffsetUs = offsetUs;
+        break;
+      }
+    }
+    if (startWaveform(_pin, _valueUs, REFRESH_INTERVAL - _valueUs, 0, phaseReference, phaseOffsetUs))
     {
       _servoMap |= (1 << _pin);
     }
   }
 }
 
+bool Servo::writeSynchronized(Servo* const servos[], const int valuesUs[], size_t count)
+{
+  bool ok = true;
+  for (size_t i = 0; i < count; i++) {
+    if (servos[i] && servos[i]->_attached) {
+      servos[i]->writeMicroseconds(valuesUs[i]);
+    }
+    else {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+void Servo::_latchMicroseconds(uint16_t valueUs)
+{
+  if (_attached && (_servoMap & (1UL << _pin))) {
+    // channel already phase locked and running: latch the new duty cycle
+    // only, it takes effect at the next period start
+    _valueUs = valueUs;
+    startWaveform(_pin, _valueUs, REFRESH_INTERVAL - _valueUs, 0);
+    return;
+  }
+  // waveform not running yet (first frame after attach): full path
+  writeMicroseconds(valueUs);
+}
+
+//-------------------------------------------------------------------
+// ServoTrajectory class methods
+
+bool ServoTrajectory::begin(Servo* const servos[], size_t channelCount)
+{
+  if (_playing || !servos || channelCount == 0 || channelCount > maxChannels) {
+    return false;
+  }
+  for (size_t i = 0; i < channelCount; i++) {
+    if (!servos[i] || !servos[i]->_attached) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < channelCount; i++) {
+    _servos[i] = servos[i];
+  }
+  _channels = channelCount;
+  _head = _tail = _count = 0;
+  return true;
+}
+
+bool ServoTrajectory::push(const int valuesUs[], uint32_t atMs)
+{
+  if (!_channels || !valuesUs || _count >= maxFrames) {
+    return false;
+  }
+  Frame& frame = _frames[_tail];
+  frame.atMs = atMs;
+  for (size_t i = 0; i < _channels; i++) {
+    // clamp against the channel's calibrated range now, so consuming the
+    // frame later does no per-value work beyond the latch
+    const Servo& s = *_servos[i];
+    frame.valueUs[i] = constrain(valuesUs[i], (int)s._minUs, (int)s._maxUs);
+  }
+  _tail = (_tail + 1) % maxFrames;
+  _count++;
+  return true;
+}
+
+bool ServoTrajectory::start()
+{
+  if (_playing || !_channels) {
+    return false;
+  }
+  _startMs = millis();
+  _playing = true;
+  if (!schedule_recurrent_function_us([this]() { return _consume(); }, 1000)) {
+    _playing = false;
+    return false;
+  }
+  return true;
+}
+
+void ServoTrajectory::stop()
+{
+  // the scheduled consumer sees the flag and unschedules itself
+  _playing = false;
+}
+
+bool ServoTrajectory::_consume()
+{
+  if (!_playing) {
+    return false;
+  }
+  // latch every frame that has come due; catching up after a long loop()
+  // iteration still lands each value at a period start, in order
+  while (_count && (int32_t)(millis() - _startMs - _frames[_head].atMs) >= 0) {
+    const Frame& frame = _frames[_head];
+    for (size_t i = 0; i < _channels; i++) {
+      _servos[i]->_latchMicroseconds(frame.valueUs[i]);
+    }
+    _head = (_head + 1) % maxFrames;
+    _count--;
+  }
+  return true;
+}
+
 int Servo::read() // return the value as degrees
 {
   // read returns the angle for an assumed 0-180
@@ -34,6 +34,7 @@
 //
 //   write()     - Sets the servo angle in degrees.  (invalid angle that is valid as pulse in microseconds is treated as microseconds)
 //   writeMicroseconds() - Sets the servo pulse width in microseconds
+//   writeSynchronized() - Sets the pulse widths of several servos so that all take effect within the same refresh frame
 //   read()      - Gets the last written servo pulse width as an angle between 0 and 180.
 //   readMicroseconds()   - Gets the last written servo pulse width in microseconds. (was read_us() in first release)
 //   attached()  - Returns true if there is a servo attached.
@@ -54,8 +55,13 @@
 #define DEFAULT_MIN_PULSE_WIDTH      1000 // uncalibrated default, the shortest duty cycle sent to a servo
 #define DEFAULT_MAX_PULSE_WIDTH      2000 // uncalibrated default, the longest duty cycle sent to a servo 
 #define DEFAULT_NEUTRAL_PULSE_WIDTH  1500 // default duty cycle when servo is attached
-#define REFRESH_INTERVAL            20000 // classic default period to refresh servos in microseconds 
+#define REFRESH_INTERVAL            20000 // classic default period to refresh servos in microseconds
 #define MAX_SERVOS                      9 // D0-D8
+// Each attached servo claims a fixed slot inside the shared refresh frame and
+// emits its pulse at the slot's phase offset. Pulses therefore fire in slot
+// order instead of all rising at once, which spreads the supply current and
+// keeps the waveform NMI to one edge at a time.
+#define SERVO_FRAME_SLOT_WIDTH      (REFRESH_INTERVAL / MAX_SERVOS)
 
 #if !defined(ESP8266)
 
@@ -83,14 +89,84 @@ public:
     void writeMicroseconds(int value); // Write pulse width in microseconds 
     int read();                        // returns current pulse width as an angle between 0 and 180 degrees
     int readMicroseconds();            // returns current pulse width in microseconds for this servo (was read_us() in first release)
-    bool attached();                   // return true if this servo is attached, otherwise false 
+    bool attached();                   // return true if this servo is attached, otherwise false
+    // Writes the pulse widths of several servos back-to-back. The waveform
+    // generator latches a new duty cycle at each channel's next period start,
+    // and all channels are phase locked into one refresh frame, so every
+    // setpoint takes effect within the following frame - suitable for gait
+    // control where the channels must not update across frame boundaries.
+    // Returns false if any entry was null or not attached (the rest are still written).
+    static bool writeSynchronized(Servo* const servos[], const int valuesUs[], size_t count);
 private:
+    friend class ServoTrajectory;
+    // playback fast path: latch a pre-clamped duty cycle on a channel whose
+    // waveform is already running, skipping the clamp and phase-lock search
+    void _latchMicroseconds(uint16_t valueUs);
     static uint32_t _servoMap;
+    static uint32_t _slotMap;
+    static uint8_t  _slotPin[MAX_SERVOS];
     bool     _attached;
     uint8_t  _pin;
+    uint8_t  _slot;
     uint16_t _minUs;                   
     uint16_t _maxUs;                   
     uint16_t _valueUs;
 };
 
+//   ServoTrajectory - fixed-capacity setpoint streaming for a servo group.
+//
+//   Frames of per-channel pulse widths with a playback timestamp are pushed
+//   into a ring buffer; values are clamped to each channel's calibrated range
+//   at submit time, so consuming a frame is a plain latch into the running
+//   waveform with no recomputation and no allocation. A scheduled consumer
+//   (run from loop()/yield() context) latches every frame that has come due;
+//   the waveform generator applies each latched value at the channel's next
+//   period start, which keeps the pulse train itself jitter-free regardless
+//   of when the frame was consumed within the period.
+//
+//   Push more frames while playback runs to stream a long trajectory: an
+//   empty buffer idles (underrun) until the next push or stop(), it does not
+//   end playback.
+//
+//   begin(servos, count) - bind up to 8 attached servos as the channel group
+//   push(valuesUs, atMs) - append one frame, due atMs after start(); false when full
+//   start()/stop()       - run / end playback
+//   playing(), pending() - playback state and frames not yet consumed
+class ServoTrajectory
+{
+public:
+    static constexpr size_t maxChannels = 8;
+    static constexpr size_t maxFrames   = 32;
+
+    bool begin(Servo* const servos[], size_t channelCount);
+    bool push(const int valuesUs[], uint32_t atMs);
+    bool start();
+    void stop();
+    bool playing() const
+    {
+        return _playing;
+    }
+    size_t pending() const
+    {
+        return _count;
+    }
+
+private:
+    bool _consume();
+
+    struct Frame
+    {
+        uint32_t atMs;
+        uint16_t valueUs[maxChannels];
+    };
+    Servo*   _servos[maxChannels];
+    size_t   _channels = 0;
+    Frame    _frames[maxFrames];
+    size_t   _head = 0;
+    size_t   _tail = 0;
+    size_t   _count = 0;
+    uint32_t _startMs = 0;
+    bool     _playing = false;
+};
+
 #endif
@@ -57,8 +57,124 @@ Ticker& Ticker::operator=(Ticker&& other) noexcept
     return *this;
 }
 
+// Coalescing scheduler: one shared os_timer drives a deadline-ordered,
+// intrusive list of opted-in tickers (see setSlack()).  Every wakeup fires
+// all tickers whose deadline falls within their own slack window, so a
+// handful of loosely-timed tickers costs a single SDK timer and far fewer
+// wakeups.  os_timer callbacks and CONT code are serialized by the SDK, so
+// the list needs no locking.
+
+static ETSTimer _ticker_shared_timer;
+static bool _ticker_shared_init = false;
+static Ticker* _ticker_coalesce_head = nullptr;
+
+void Ticker::_coalesceInsert(Ticker* ticker)
+{
+    Ticker** where = &_ticker_coalesce_head;
+    while (*where && (int32_t)((*where)->_deadline_ms - ticker->_deadline_ms) <= 0) {
+        where = &(*where)->_nextCoalesced;
+    }
+    ticker->_nextCoalesced = *where;
+    *where = ticker;
+    ticker->_coalesceQueued = true;
+}
+
+void Ticker::_coalesceRemove(Ticker* ticker)
+{
+    for (Ticker** where = &_ticker_coalesce_head; *where; where = &(*where)->_nextCoalesced) {
+        if (*where == ticker) {
+            *where = ticker->_nextCoalesced;
+            break;
+        }
+    }
+    ticker->_nextCoalesced = nullptr;
+    ticker->_coalesceQueued = false;
+}
+
+void Ticker::_coalesceRearm()
+{
+    if (!_ticker_shared_init) {
+        return;
+    }
+    os_timer_disarm(&_ticker_shared_timer);
+    if (!_ticker_coalesce_head) {
+        return;
+    }
+    int32_t togo = _ticker_coalesce_head->_deadline_ms - millis();
+    if (togo < 1) {
+        togo = 1;
+    }
+    os_timer_arm(&_ticker_shared_timer, togo, false);
+}
+
+void Ticker::_sharedTimerCallback(void*)
+{
+    // Restart the scan after every callback: a callback may attach or
+    // detach arbitrary tickers and reshape the list under us.
+    while (true) {
+        const uint32_t now = millis();
+        Ticker* due = nullptr;
+        for (Ticker* t = _ticker_coalesce_head; t; t = t->_nextCoalesced) {
+            int32_t togo = t->_deadline_ms - now;
+            if (togo <= 0 || (uint32_t)togo <= t->_slack_ms) {
+                // due, or close enough to batch into this wakeup
+                due = t;
+                break;
+            }
+        }
+        if (!due) {
+            break;
+        }
+        _coalesceRemove(due);
+        if (due->_repeat) {
+            // advance from the nominal deadline to keep the phase stable
+            due->_deadline_ms += due->_period_ms;
+            if ((int32_t)(due->_deadline_ms - now) <= 0) {
+                due->_deadline_ms = now + due->_period_ms;
+            }
+            _coalesceInsert(due);
+        }
+        due->_static_callback();
+    }
+    _coalesceRearm();
+}
+
+void Ticker::_attachCoalesced(Ticker::Milliseconds milliseconds, bool repeat)
+{
+    if (_coalesceQueued) {
+        _coalesceRemove(this);
+    }
+    if (_timer) {
+        // switching over from a private os_timer
+        os_timer_disarm(_timer);
+        _timer = nullptr;
+        _tick.reset(nullptr);
+    }
+    if (!_ticker_shared_init) {
+        os_timer_setfn(&_ticker_shared_timer, _sharedTimerCallback, nullptr);
+        _ticker_shared_init = true;
+    }
+
+    _repeat = repeat;
+    _period_ms = milliseconds.count() ? milliseconds.count() : 1;
+    _deadline_ms = millis() + _period_ms;
+    _coalesceInsert(this);
+    _coalesceRearm();
+}
+
 void Ticker::_attach(Ticker::Milliseconds milliseconds, bool repeat)
 {
+    if (_slack_ms) {
+        _attachCoalesced(milliseconds, repeat);
+        return;
+    }
+
+    if (_coalesceQueued) {
+        // switching back to a private os_timer
+        _coalesceRemove(this);
+        _coalesceRearm();
+    }
+
     if (_timer) {
         os_timer_disarm(_timer);
     } else {
@@ -98,12 +214,16 @@ void Ticker::detach()
         _timer = nullptr;
         _tick.reset(nullptr);
         _callback = std::monostate{};
+    } else if (_coalesceQueued) {
+        _coalesceRemove(this);
+        _coalesceRearm();
+        _callback = std::monostate{};
     }
 }
 
 bool Ticker::active() const
 {
-    return _timer != nullptr;
+    return _timer != nullptr || _coalesceQueued;
 }
 
 void Ticker::_static_callback()
@@ -130,9 +250,10 @@ void Ticker::_static_callback()
     }, tmp);
 
     // ...and move ourselves back only when object is in a valid state
-    // * ticker was not detached, zeroing timer pointer
+    // * ticker was not detached, zeroing timer pointer (or dequeueing it
+    //   from the coalescing scheduler)
     // * nothing else replaced callback variant
-    if ((_timer == nullptr) || !std::holds_alternative<std::monostate>(_callback)) {
+    if (!active() || !std::holds_alternative<std::monostate>(_callback)) {
         return;
     }
 
@@ -163,6 +163,18 @@ public:
         _attach(Milliseconds(milliseconds), false);
     }
 
+    // Opt this ticker into the shared coalescing scheduler.  Instead of
+    // owning an os_timer, the ticker joins a single shared timer keeping a
+    // deadline-ordered list; when it fires, every ticker whose deadline is
+    // within its own slack window is batched into the same wakeup (i.e. the
+    // callback may run up to `milliseconds` early).  Fewer wakeups means
+    // longer uninterrupted light-sleep windows.  Call before attach()/once();
+    // setSlack(0) reverts to a private os_timer on the next attach.
+    void setSlack(uint32_t milliseconds)
+    {
+        _slack_ms = milliseconds;
+    }
+
     // if active(), disables currently running timer
     void detach();
 
@@ -192,6 +204,13 @@ protected:
 
     void _static_callback();
 
+    // coalescing scheduler internals, see setSlack()
+    void _attachCoalesced(Milliseconds milliseconds, bool repeat);
+    static void _sharedTimerCallback(void*);
+    static void _coalesceInsert(Ticker* ticker);
+    static void _coalesceRemove(Ticker* ticker);
+    static void _coalesceRearm();
+
     void _attach(Milliseconds milliseconds, bool repeat);
     void _attach(Seconds seconds, bool repeat)
     {
@@ -203,6 +222,13 @@ protected:
 
     ETSTimer* _timer = nullptr;
 
+    // coalescing scheduler state, only used while setSlack() is non-zero
+    uint32_t _slack_ms = 0;
+    uint32_t _period_ms = 0;
+    uint32_t _deadline_ms = 0;
+    bool _coalesceQueued = false;
+    Ticker* _nextCoalesced = nullptr;
+
 private:
     struct callback_ptr_t
     {
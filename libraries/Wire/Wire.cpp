@@ -53,6 +53,9 @@ uint8_t TwoWire::transmitting = 0;
 void (*TwoWire::user_onRequest)(void);
 void (*TwoWire::user_onReceive)(size_t);
 
+size_t TwoWire::asyncRequestSize = 0;
+void (*TwoWire::user_onRequestDone)(uint8_t);
+
 static int default_sda_pin = SDA;
 static int default_scl_pin = SCL;
 
@@ -132,6 +135,36 @@ size_t TwoWire::requestFrom(uint8_t address, size_t size, bool sendStop)
     return read;
 }
 
+void TwoWire::onAsyncRequestDone(uint8_t status)
+{
+    rxBufferIndex  = 0;
+    rxBufferLength = (status == 0) ? asyncRequestSize : 0;
+    if (user_onRequestDone)
+    {
+        user_onRequestDone(status);
+    }
+}
+
+bool TwoWire::requestFromAsync(uint8_t address, size_t size, bool sendStop,
+                               void (*done)(uint8_t status))
+{
+    if (size > I2C_BUFFER_LENGTH)
+    {
+        size = I2C_BUFFER_LENGTH;
+    }
+    // invalidate the rx buffer until the transfer lands
+    rxBufferIndex      = 0;
+    rxBufferLength     = 0;
+    asyncRequestSize   = size;
+    user_onRequestDone = done;
+    return twi_readFromAsync(address, rxBuffer, size, sendStop, onAsyncRequestDone) == 0;
+}
+
+bool TwoWire::asyncBusy()
+{
+    return twi_asyncBusy();
+}
+
 uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
 {
     return requestFrom(address, static_cast<size_t>(quantity), static_cast<bool>(sendStop));
@@ -51,6 +51,10 @@ private:
     static void onRequestService(void);
     static void onReceiveService(uint8_t*, size_t);
 
+    static size_t asyncRequestSize;
+    static void (*user_onRequestDone)(uint8_t);
+    static void onAsyncRequestDone(uint8_t);
+
 public:
     TwoWire();
     void    begin(int sda, int scl);
@@ -66,6 +70,13 @@ public:
     uint8_t endTransmission(void);
     uint8_t endTransmission(uint8_t);
     size_t  requestFrom(uint8_t address, size_t size, bool sendStop);
+    // Non-blocking requestFrom: returns true when the transfer was queued.
+    // The bus is worked one byte at a time between loop() turns; `done`
+    // receives the twi status code (0 = success), after which the received
+    // bytes are ready through available()/read().
+    bool    requestFromAsync(uint8_t address, size_t size, bool sendStop,
+                             void (*done)(uint8_t status));
+    bool    asyncBusy();
     uint8_t status();
 
     uint8_t requestFrom(uint8_t, uint8_t);
@@ -21,15 +21,28 @@ PPPServer::PPPServer(Stream* sio) : _sio(sio), _cb(netif_status_cb_s), _enabled(
 bool PPPServer::handlePackets()
 {
     size_t avail;
-    if ((avail = _sio->available()) > 0)
+    if (_sio->hasPeekBufferAPI())
     {
-        // XXX block peeking would be useful here
-        if (avail > _bufsize)
+        // feed PPP straight out of the driver RX buffer, no intermediate copy
+        while ((avail = _sio->peekAvailable()) > 0)
         {
-            avail = _bufsize;
+            pppos_input(_ppp, (u8_t*)_sio->peekBuffer(), avail);
+            _sio->peekConsume(avail);
+        }
+    }
+    else
+    {
+        // drain everything that arrived since the last pass, not just one
+        // buffer's worth, so throughput is not capped by the poll interval
+        while ((avail = _sio->available()) > 0)
+        {
+            if (avail > _bufsize)
+            {
+                avail = _bufsize;
+            }
+            avail = _sio->readBytes(_buf, avail);
+            pppos_input(_ppp, _buf, avail);
         }
-        avail = _sio->readBytes(_buf, avail);
-        pppos_input(_ppp, _buf, avail);
     }
     return _enabled;
 }
@@ -170,6 +183,14 @@ bool PPPServer::begin(const IPAddress& ourAddress, const IPAddress& peer)
     // ppp_set_auth(_ppp, PPPAUTHTYPE_ANY, "login", "password");
     // ppp_set_auth_required(_ppp, 1);
 
+    if (_mru)
+    {
+        // ask the peer to send frames up to _mru bytes; larger frames
+        // amortize the per-frame HDLC and FCS cost over more payload
+        _ppp->lcp_wantoptions.neg_mru = 1;
+        _ppp->lcp_wantoptions.mru = (_mru > PPP_MAXMRU) ? PPP_MAXMRU : _mru;
+    }
+
     ppp_set_silent(_ppp, 1);
     ppp_listen(_ppp);
     netif_set_status_callback(&_netif, _cb);
@@ -180,7 +201,7 @@ bool PPPServer::begin(const IPAddress& ourAddress, const IPAddress& peer)
             {
                 return this->handlePackets();
             },
-            1000))
+            _pollIntervalUs))
     {
         netif_remove(&_netif);
         return false;
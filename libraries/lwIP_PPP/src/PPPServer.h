@@ -48,6 +48,21 @@ public:
     {
         _cb = cb;
     }
+
+    // Request a specific MRU from the peer during LCP negotiation instead of
+    // the compile-time default (clamped to PPP_MAXMRU); call before begin().
+    // Larger frames mean fewer HDLC flag/FCS overheads per payload byte.
+    void setMRU(uint16_t mru)
+    {
+        _mru = mru;
+    }
+
+    // Interval of the scheduled serial drain (default 1000 us); lower it for
+    // high baudrates so the UART RX buffer is emptied before it overflows
+    void setPollInterval(uint32_t us)
+    {
+        _pollIntervalUs = us;
+    }
     const ip_addr_t* getPeerAddress() const
     {
         return &_netif.gw;
@@ -61,6 +76,8 @@ protected:
     void (*_cb)(netif*);
     uint8_t _buf[_bufsize];
     bool    _enabled;
+    uint16_t _mru = 0;
+    uint32_t _pollIntervalUs = 1000;
 
     // feed ppp from stream - to call on a regular basis or on interrupt
     bool handlePackets();
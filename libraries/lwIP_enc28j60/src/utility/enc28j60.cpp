@@ -34,6 +34,7 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include <RawNicSpi.h>
 
 #include <stdint.h>
 #include <stdio.h>
@@ -257,14 +258,11 @@ void ENC28J60::setregbank(uint8_t new_bank)
 /*---------------------------------------------------------------------------*/
 void ENC28J60::writedata(const uint8_t* data, int datalen)
 {
-    int i;
     enc28j60_arch_spi_select();
     /* The Write Buffer Memory (WBM) command is 0 1 1 1 1 0 1 0  */
     SPI.transfer(0x7a);
-    for (i = 0; i < datalen; i++)
-    {
-        SPI.transfer(data[i]);
-    }
+    /* the buffer pointer auto-increments, stream the payload in one burst */
+    rawnic::burstWrite(SPI, data, datalen);
     enc28j60_arch_spi_deselect();
 }
 /*---------------------------------------------------------------------------*/
@@ -275,16 +273,13 @@ void ENC28J60::writedatabyte(uint8_t byte)
 /*---------------------------------------------------------------------------*/
 int ENC28J60::readdata(uint8_t* buf, int len)
 {
-    int i;
     enc28j60_arch_spi_select();
     /* THe Read Buffer Memory (RBM) command is 0 0 1 1 1 0 1 0 */
     SPI.transfer(0x3a);
-    for (i = 0; i < len; i++)
-    {
-        buf[i] = SPI.transfer(0);
-    }
+    /* the buffer pointer auto-increments, stream the payload in one burst */
+    rawnic::burstRead(SPI, buf, len);
     enc28j60_arch_spi_deselect();
-    return i;
+    return len;
 }
 /*---------------------------------------------------------------------------*/
 uint8_t ENC28J60::readdatabyte(void)
@@ -654,21 +649,26 @@ uint16_t ENC28J60::readFrameSize()
     PRINTF("enc28j60: EPKTCNT 0x%02x\n", n);
 
     setregbank(ERXTX_BANK);
-    /* Read the next packet pointer */
-    nxtpkt[0] = readdatabyte();
-    nxtpkt[1] = readdatabyte();
+    /* The six-byte receive status vector (next packet pointer, length,
+       status) is contiguous in the FIFO: read it in one RBM burst instead
+       of six chip-select cycles */
+    uint8_t rsv[6];
+    readdata(rsv, sizeof(rsv));
+
+    nxtpkt[0] = rsv[0];
+    nxtpkt[1] = rsv[1];
     _next     = (nxtpkt[1] << 8) + nxtpkt[0];
 
     PRINTF("enc28j60: nxtpkt 0x%02x%02x\n", _nxtpkt[1], _nxtpkt[0]);
 
-    length[0] = readdatabyte();
-    length[1] = readdatabyte();
+    length[0] = rsv[2];
+    length[1] = rsv[3];
     _len      = (length[1] << 8) + length[0];
 
     PRINTF("enc28j60: length 0x%02x%02x\n", length[1], length[0]);
 
-    status[0] = readdatabyte();
-    status[1] = readdatabyte();
+    status[0] = rsv[4];
+    status[1] = rsv[5];
 
     /* This statement is just to avoid a compiler warning: */
     (void)status[0];
@@ -689,10 +689,13 @@ uint16_t ENC28J60::readFrameData(uint8_t* buffer, uint16_t framesize)
     {
         buffer = nullptr;
 
-        /* flush rx fifo */
-        for (uint16_t i = 0; i < _len; i++)
+        /* flush rx fifo through the shared scratch, a chunk per burst */
+        uint16_t remaining = _len;
+        while (remaining > 0)
         {
-            readdatabyte();
+            uint16_t chunk = (remaining < rawnic::scratchSize) ? remaining : rawnic::scratchSize;
+            readdata(rawnic::scratch(), chunk);
+            remaining -= chunk;
         }
     }
     else
@@ -33,6 +33,7 @@
 // original sources: https://github.com/njh/W5100MacRaw
 
 #include <SPI.h>
+#include <RawNicSpi.h>
 #include "w5100.h"
 
 uint8_t Wiznet5100::wizchip_read(uint16_t address)
@@ -51,15 +52,18 @@ uint8_t Wiznet5100::wizchip_read(uint16_t address)
 
 uint16_t Wiznet5100::wizchip_read_word(uint16_t address)
 {
-    return ((uint16_t)wizchip_read(address) << 8) + wizchip_read(address + 1);
+    uint8_t buf[2];
+    wizchip_read_buf(address, buf, 2);
+    return ((uint16_t)buf[0] << 8) + buf[1];
 }
 
 void Wiznet5100::wizchip_read_buf(uint16_t address, uint8_t* pBuf, uint16_t len)
 {
-    for (uint16_t i = 0; i < len; i++)
-    {
-        pBuf[i] = wizchip_read(address + i);
-    }
+    // the command units stream back-to-back with chip select held, one
+    // FIFO burst per chunk instead of four transfers per payload byte
+    wizchip_cs_select();
+    rawnic::readUnitBurst(_spi, 0x0F, address, pBuf, len);
+    wizchip_cs_deselect();
 }
 
 void Wiznet5100::wizchip_write(uint16_t address, uint8_t wb)
@@ -74,16 +78,15 @@ void Wiznet5100::wizchip_write(uint16_t address, uint8_t wb)
 
 void Wiznet5100::wizchip_write_word(uint16_t address, uint16_t word)
 {
-    wizchip_write(address, (uint8_t)(word >> 8));
-    wizchip_write(address + 1, (uint8_t)word);
+    uint8_t buf[2] = { (uint8_t)(word >> 8), (uint8_t)word };
+    wizchip_write_buf(address, buf, 2);
 }
 
 void Wiznet5100::wizchip_write_buf(uint16_t address, const uint8_t* pBuf, uint16_t len)
 {
-    for (uint16_t i = 0; i < len; i++)
-    {
-        wizchip_write(address + i, pBuf[i]);
-    }
+    wizchip_cs_select();
+    rawnic::writeUnitBurst(_spi, 0xF0, address, pBuf, len);
+    wizchip_cs_deselect();
 }
 
 void Wiznet5100::setSn_CR(uint8_t cr)
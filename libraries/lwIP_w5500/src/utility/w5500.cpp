@@ -33,6 +33,7 @@
 // original sources: https://github.com/njh/W5500MacRaw
 
 #include <SPI.h>
+#include <RawNicSpi.h>
 #include "w5500.h"
 
 uint8_t Wiznet5500::wizchip_read(uint8_t block, uint16_t address)
@@ -55,13 +56,13 @@ uint8_t Wiznet5500::wizchip_read(uint8_t block, uint16_t address)
 
 uint16_t Wiznet5500::wizchip_read_word(uint8_t block, uint16_t address)
 {
-    return ((uint16_t)wizchip_read(block, address) << 8) + wizchip_read(block, address + 1);
+    uint8_t buf[2];
+    wizchip_read_buf(block, address, buf, 2);
+    return ((uint16_t)buf[0] << 8) + buf[1];
 }
 
 void Wiznet5500::wizchip_read_buf(uint8_t block, uint16_t address, uint8_t* pBuf, uint16_t len)
 {
-    uint16_t i;
-
     wizchip_cs_select();
 
     block |= AccessModeRead;
@@ -69,10 +70,10 @@ void Wiznet5500::wizchip_read_buf(uint8_t block, uint16_t address, uint8_t* pBuf
     wizchip_spi_write_byte((address & 0xFF00) >> 8);
     wizchip_spi_write_byte((address & 0x00FF) >> 0);
     wizchip_spi_write_byte(block);
-    for (i = 0; i < len; i++)
-    {
-        pBuf[i] = wizchip_spi_read_byte();
-    }
+    // the chip is in sequential-read mode (VDM, auto-incrementing
+    // address), so the whole burst is one variable-length transaction
+    // streamed through the hardware FIFO instead of a byte-wise loop
+    rawnic::burstRead(_spi, pBuf, len);
 
     wizchip_cs_deselect();
 }
@@ -93,15 +94,13 @@ void Wiznet5500::wizchip_write(uint8_t block, uint16_t address, uint8_t wb)
 
 void Wiznet5500::wizchip_write_word(uint8_t block, uint16_t address, uint16_t word)
 {
-    wizchip_write(block, address, (uint8_t)(word >> 8));
-    wizchip_write(block, address + 1, (uint8_t)word);
+    uint8_t buf[2] = { (uint8_t)(word >> 8), (uint8_t)word };
+    wizchip_write_buf(block, address, buf, 2);
 }
 
 void Wiznet5500::wizchip_write_buf(uint8_t block, uint16_t address, const uint8_t* pBuf,
                                    uint16_t len)
 {
-    uint16_t i;
-
     wizchip_cs_select();
 
     block |= AccessModeWrite;
@@ -109,10 +108,8 @@ void Wiznet5500::wizchip_write_buf(uint8_t block, uint16_t address, const uint8_
     wizchip_spi_write_byte((address & 0xFF00) >> 8);
     wizchip_spi_write_byte((address & 0x00FF) >> 0);
     wizchip_spi_write_byte(block);
-    for (i = 0; i < len; i++)
-    {
-        wizchip_spi_write_byte(pBuf[i]);
-    }
+    // single burst write through the FIFO, see wizchip_read_buf()
+    rawnic::burstWrite(_spi, pBuf, len);
 
     wizchip_cs_deselect();
 }
@@ -100,7 +100,26 @@ public:
 protected:
     static constexpr bool interruptIsPossible()
     {
-        return false;
+        return true;
+    }
+
+    /**
+        Configure the chip to assert the INTn pin on frame reception
+        (socket 0 RECV interrupt)
+    */
+    void enableInterrupt()
+    {
+        setSn_IMR(Sn_IR_RECV);
+        wizchip_write(BlockSelectCReg, SIMR, 0x01);
+    }
+
+    /**
+        Acknowledge the receive interrupt so INTn releases;
+        call once the receive buffer has been drained
+    */
+    void ackInterrupt()
+    {
+        setSn_IR(Sn_IR_RECV);
     }
 
     /**
@@ -0,0 +1,225 @@
+/*
+    Interrupt latency conformance test.
+
+    Measures GPIO edge -> ISR entry latency with the cycle counter and
+    reports percentiles over many edges, under several background loads.
+    The numbers are printed so they can be tracked release to release;
+    the CHECKs only enforce loose ceilings so the test flags gross
+    regressions (a mis-placed IRAM_ATTR, a new critical section) without
+    flaking on environmental noise.
+
+    Loopback: on the esp8266 the GPIO input path follows the output
+    register, so an interrupt attached to the pin we drive sees our own
+    edges - no external jumper needed.
+
+    Background loads approximate the production culprits without needing
+    a network peer:
+      - flash-read: random PROGMEM reads across a table larger than the
+        32KB SPI cache, the same icache/dcache pressure a TLS handshake
+        causes when it pulls its tables through the cache
+      - flash-write: sequential 256-byte programs into the EEPROM scratch
+        sector (re-erased on wrap), the OTA write pattern; non-IRAM code
+        cannot run while the SPI bus is busy, so this is the worst case
+      - uart: TX bursts on Serial1 keep the uart ISR firing, standing in
+        for mDNS-storm style interrupt pressure
+
+    Defaults to 100000 edges per load so the full run stays under a few
+    minutes; build with -DLATENCY_EDGES=1000000 for release qualification.
+*/
+
+#include <Arduino.h>
+#include <BSTest.h>
+#include <ESP8266WiFi.h>
+#include <flash_hal.h>
+
+BS_ENV_DECLARE();
+
+#ifndef LATENCY_EDGES
+#define LATENCY_EDGES 100000
+#endif
+
+// loose ceilings (microseconds), override per-release from the build
+#ifndef LATENCY_IDLE_P99_US
+#define LATENCY_IDLE_P99_US 15
+#endif
+#ifndef LATENCY_FLASHREAD_P99_US
+#define LATENCY_FLASHREAD_P99_US 50
+#endif
+#ifndef LATENCY_FLASHWRITE_P50_US
+#define LATENCY_FLASHWRITE_P50_US 25
+#endif
+#ifndef LATENCY_UART_P99_US
+#define LATENCY_UART_P99_US 30
+#endif
+
+static constexpr uint8_t TRIGGER_PIN = 5;  // D1, free on common boards
+
+// 16-cycle buckets up to 16384 cycles (~204us at 80MHz); slower edges
+// clamp into the last bucket and show up in 'max'
+static constexpr size_t HIST_BUCKETS = 1024;
+static constexpr uint32_t HIST_SHIFT = 4;
+
+static uint32_t hist[HIST_BUCKETS];
+static uint32_t histCount;
+static uint32_t maxCycles;
+static uint32_t missedEdges;
+
+static volatile uint32_t isrEntryCycles;
+
+static void IRAM_ATTR edgeIsr() {
+  isrEntryCycles = ESP.getCycleCount();
+}
+
+static void histReset() {
+  memset(hist, 0, sizeof(hist));
+  histCount = 0;
+  maxCycles = 0;
+  missedEdges = 0;
+}
+
+static void histRecord(uint32_t cycles) {
+  size_t bucket = cycles >> HIST_SHIFT;
+  if (bucket >= HIST_BUCKETS) {
+    bucket = HIST_BUCKETS - 1;
+  }
+  hist[bucket]++;
+  histCount++;
+  if (cycles > maxCycles) {
+    maxCycles = cycles;
+  }
+}
+
+// cycle count below which 'percent' of the edges landed
+static uint32_t histPercentile(uint32_t percent) {
+  uint64_t needed = (uint64_t)histCount * percent / 100;
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < HIST_BUCKETS; bucket++) {
+    seen += hist[bucket];
+    if (seen >= needed) {
+      return (bucket + 1) << HIST_SHIFT;
+    }
+  }
+  return maxCycles;
+}
+
+static uint32_t cyclesToUs(uint32_t cycles) {
+  return cycles / clockCyclesPerMicrosecond();
+}
+
+typedef void (*background_fn_t)(uint32_t iteration);
+
+static void runEdges(const char* name, background_fn_t background) {
+  histReset();
+  for (uint32_t i = 0; i < LATENCY_EDGES; i++) {
+    if (background) {
+      background(i);
+    }
+    isrEntryCycles = 0;
+    const uint32_t t0 = ESP.getCycleCount();
+    GPOS = 1 << TRIGGER_PIN;  // rising edge, minimal trigger overhead
+    // spin for the ISR; give up after 100ms (e.g. wiring/flag problem)
+    while (!isrEntryCycles && ESP.getCycleCount() - t0 < F_CPU / 10) {
+    }
+    if (isrEntryCycles) {
+      histRecord(isrEntryCycles - t0);
+    } else {
+      missedEdges++;
+    }
+    GPOC = 1 << TRIGGER_PIN;
+    if ((i & 1023) == 0) {
+      yield();  // feed the soft watchdog between batches
+    }
+  }
+  Serial.printf("latency[%s]: n=%u p50=%uus p90=%uus p99=%uus max=%uus missed=%u\n",
+                name, histCount,
+                cyclesToUs(histPercentile(50)), cyclesToUs(histPercentile(90)),
+                cyclesToUs(histPercentile(99)), cyclesToUs(maxCycles), missedEdges);
+}
+
+// ------------------------------------------------------------------
+// background loads
+
+// spans two SPI cache sizes so random reads keep missing
+static constexpr size_t FLASH_TABLE_WORDS = 16384;  // 64KB
+static const uint32_t flashTable[FLASH_TABLE_WORDS] PROGMEM = { 1 };
+
+static void flashReadLoad(uint32_t i) {
+  static uint32_t sink;
+  uint32_t index = (i * 2654435761u) % FLASH_TABLE_WORDS;
+  sink += pgm_read_dword(&flashTable[index]);
+  (void)sink;
+}
+
+static void flashWriteLoad(uint32_t i) {
+  static uint32_t offset = SPI_FLASH_SEC_SIZE;  // force erase on first use
+  static uint32_t page[64];                     // 256 bytes
+  if ((i & 63) != 0) {
+    return;  // one program every 64 edges, like a paced OTA download
+  }
+  const uint32_t sector = (EEPROM_start - 0x40200000) / SPI_FLASH_SEC_SIZE;
+  if (offset >= SPI_FLASH_SEC_SIZE) {
+    ESP.flashEraseSector(sector);
+    offset = 0;
+  }
+  for (size_t w = 0; w < 64; w++) {
+    page[w] = i + w;
+  }
+  ESP.flashWrite(sector * SPI_FLASH_SEC_SIZE + offset, page, sizeof(page));
+  offset += sizeof(page);
+}
+
+static void uartLoad(uint32_t i) {
+  if ((i & 15) == 0) {
+    Serial1.write("0123456789abcdef", 16);
+  }
+}
+
+// ------------------------------------------------------------------
+
+void setup() {
+  Serial.begin(115200);
+  BS_RUN(Serial);
+}
+
+bool pretest() {
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_OFF);
+  Serial1.begin(115200);  // TX only (GPIO2), used by the uart load
+  pinMode(TRIGGER_PIN, OUTPUT);
+  digitalWrite(TRIGGER_PIN, LOW);
+  attachInterrupt(digitalPinToInterrupt(TRIGGER_PIN), edgeIsr, RISING);
+  return true;
+}
+
+TEST_CASE("GPIO edge latency, idle", "[latency]")
+{
+  runEdges("idle", nullptr);
+  CHECK(missedEdges == 0);
+  CHECK(cyclesToUs(histPercentile(99)) <= LATENCY_IDLE_P99_US);
+}
+
+TEST_CASE("GPIO edge latency, flash cache pressure", "[latency]")
+{
+  runEdges("flash-read", flashReadLoad);
+  CHECK(missedEdges == 0);
+  CHECK(cyclesToUs(histPercentile(99)) <= LATENCY_FLASHREAD_P99_US);
+}
+
+TEST_CASE("GPIO edge latency, flash writes (OTA pattern)", "[latency]")
+{
+  runEdges("flash-write", flashWriteLoad);
+  CHECK(missedEdges == 0);
+  // p99/max include edges that land inside an erase; only the median is
+  // meaningful as a regression tripwire here
+  CHECK(cyclesToUs(histPercentile(50)) <= LATENCY_FLASHWRITE_P50_US);
+}
+
+TEST_CASE("GPIO edge latency, uart interrupt pressure", "[latency]")
+{
+  runEdges("uart", uartLoad);
+  CHECK(missedEdges == 0);
+  CHECK(cyclesToUs(histPercentile(99)) <= LATENCY_UART_P99_US);
+}
+
+void loop() {
+}
@@ -0,0 +1,82 @@
+/*
+ bench.h - tiny host-side microbenchmark fixture
+
+ Wraps an operation in warmup + auto-calibrated iteration timing and
+ emits one machine-readable CSV line per benchmark:
+
+    BENCH,<suite>,<name>,<iterations>,<ns_per_op>,<mb_per_s>
+
+ so throughput can be charted across core releases. Benchmarks live in
+ hidden catch test cases (tag "[.][bench]") and run via `make benchmark`.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace bench
+{
+
+inline uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Keep a value alive so the optimizer can't elide the benchmarked op
+template <typename T>
+inline void doNotOptimize(T const& value)
+{
+    asm volatile("" : : "g"(value) : "memory");
+}
+
+// Run op a few times to warm caches, then double the iteration count
+// until a measurement window of at least minMs is filled, and report.
+// bytesPerOp of 0 suppresses the throughput column (prints 0.0).
+template <typename Op>
+inline double run(const char* suite, const char* name, size_t bytesPerOp, Op&& op,
+                  uint32_t minMs = 20)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        op();
+    }
+    const uint64_t minNs = (uint64_t)minMs * 1000000;
+    uint64_t       iters = 1;
+    for (;;)
+    {
+        const uint64_t t0 = nowNs();
+        for (uint64_t i = 0; i < iters; i++)
+        {
+            op();
+        }
+        const uint64_t dt = nowNs() - t0;
+        if (dt >= minNs || iters >= (1ull << 30))
+        {
+            const double nsPerOp = (double)dt / iters;
+            const double mbPerS  = bytesPerOp ? bytesPerOp * 1000.0 / nsPerOp : 0.0;
+            printf("BENCH,%s,%s,%llu,%.1f,%.1f\n", suite, name, (unsigned long long)iters,
+                   nsPerOp, mbPerS);
+            return nsPerOp;
+        }
+        iters *= 2;
+    }
+}
+
+}  // namespace bench
+
+#endif  // BENCH_H
@@ -0,0 +1,66 @@
+/*
+ bench_base64.cpp - base64 encode/decode microbenchmarks
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <base64.h>
+#include <StreamString.h>
+#include "bench.h"
+
+TEST_CASE("bench base64", "[.][bench]")
+{
+    uint8_t raw[4096];
+    for (size_t i = 0; i < sizeof(raw); i++)
+    {
+        raw[i] = (uint8_t)(i * 7 + 13);
+    }
+
+    bench::run("base64", "encode_64", 64,
+               [&]() { bench::doNotOptimize(base64::encode(raw, 64, false)); });
+
+    bench::run("base64", "encode_4k", sizeof(raw),
+               [&]() { bench::doNotOptimize(base64::encode(raw, sizeof(raw), false)); });
+
+    bench::run("base64", "encode_4k_newlines", sizeof(raw),
+               [&]() { bench::doNotOptimize(base64::encode(raw, sizeof(raw), true)); });
+
+    String encoded = base64::encode(raw, sizeof(raw), false);
+    S2Stream encStream(encoded, 0);
+    // Don't block in readBytes() once the source stream is drained
+    encStream.setTimeout(0);
+    StreamString decoded;
+    decoded.reserve(sizeof(raw));
+
+    bench::run("base64", "decode_stream_4k", encoded.length(), [&]() {
+        encStream.resetPointer();
+        decoded.clear();
+        bench::doNotOptimize(base64::decode(encStream, decoded));
+    });
+
+    String plain((const char*)nullptr);
+    plain.reserve(sizeof(raw));
+    for (size_t i = 0; i < sizeof(raw); i++)
+    {
+        plain += (char)('a' + i % 26);
+    }
+    S2Stream plainStream(plain, 0);
+    plainStream.setTimeout(0);
+    StreamString encOut;
+    encOut.reserve(sizeof(raw) * 4 / 3 + 8);
+
+    bench::run("base64", "encode_stream_4k", sizeof(raw), [&]() {
+        plainStream.resetPointer();
+        encOut.clear();
+        bench::doNotOptimize(base64::encode(plainStream, encOut));
+    });
+}
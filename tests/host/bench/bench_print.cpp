@@ -0,0 +1,60 @@
+/*
+ bench_print.cpp - Print formatting microbenchmarks
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <Print.h>
+#include "bench.h"
+
+namespace
+{
+
+// Counts bytes and discards them, so only formatting cost is measured
+class NullPrint : public Print
+{
+public:
+    size_t count = 0;
+    size_t write(uint8_t) override
+    {
+        count++;
+        return 1;
+    }
+    size_t write(const uint8_t*, size_t size) override
+    {
+        count += size;
+        return size;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("bench Print", "[.][bench]")
+{
+    NullPrint out;
+
+    bench::run("Print", "print_cstr", 26, [&]() { out.print("abcdefghijklmnopqrstuvwxyz"); });
+
+    bench::run("Print", "print_int", 0, [&]() { out.print(-1234567); });
+
+    bench::run("Print", "print_uint_hex", 0, [&]() { out.print(0xdeadbeefu, HEX); });
+
+    bench::run("Print", "print_double", 0, [&]() { out.print(3.14159265, 5); });
+
+    bench::run("Print", "printf_mixed", 0,
+               [&]() { out.printf("v=%d s=%s f=%.2f\n", 42, "str", 1.5); });
+
+    const String s("a String of moderate length for printing");
+    bench::run("Print", "print_String", s.length(), [&]() { out.print(s); });
+
+    bench::doNotOptimize(out.count);
+}
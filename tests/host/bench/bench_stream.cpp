@@ -0,0 +1,68 @@
+/*
+ bench_stream.cpp - Stream::send* copy microbenchmarks
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <StreamString.h>
+#include "bench.h"
+
+static String makePayload(size_t size)
+{
+    String data;
+    data.reserve(size);
+    while (data.length() < size)
+    {
+        data += "0123456789abcdef";
+    }
+    return data;
+}
+
+TEST_CASE("bench StreamSend", "[.][bench]")
+{
+    String payload4k = makePayload(4096);
+    String payload64 = makePayload(64);
+
+    // Peek-pointer source: sendAll uses the zero-copy peekBuffer path
+    S2Stream     in4k(payload4k, 0);
+    S2Stream     in64(payload64, 0);
+    StreamString out;
+    out.reserve(4096);
+
+    bench::run("StreamSend", "sendAll_4k", 4096, [&]() {
+        in4k.resetPointer();
+        out.clear();
+        bench::doNotOptimize(in4k.sendAll(out));
+    });
+
+    bench::run("StreamSend", "sendAll_64", 64, [&]() {
+        in64.resetPointer();
+        out.clear();
+        bench::doNotOptimize(in64.sendAll(out));
+    });
+
+    bench::run("StreamSend", "sendSize_4x1k", 4096, [&]() {
+        in4k.resetPointer();
+        out.clear();
+        for (int i = 0; i < 4; i++)
+        {
+            bench::doNotOptimize(in4k.sendSize(&out, 1024));
+        }
+    });
+
+    // Consuming source: exercises the read()-based fallback path
+    bench::run("StreamSend", "sendAll_4k_consume", 4096, [&]() {
+        StreamString src(payload4k);
+        out.clear();
+        bench::doNotOptimize(src.sendAll(out));
+    });
+}
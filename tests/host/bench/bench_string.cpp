@@ -0,0 +1,72 @@
+/*
+ bench_string.cpp - WString microbenchmarks
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <WString.h>
+#include "bench.h"
+
+TEST_CASE("bench WString", "[.][bench]")
+{
+    bench::run("WString", "ctor_sso", 0, []() {
+        String s("short str");  // fits SSO, no heap
+        bench::doNotOptimize(s);
+    });
+
+    bench::run("WString", "ctor_heap", 24, []() {
+        String s("twenty-four bytes here!!");
+        bench::doNotOptimize(s);
+    });
+
+    bench::run("WString", "concat_10x16", 160, []() {
+        String s;
+        for (int i = 0; i < 10; i++)
+        {
+            s += "0123456789abcdef";
+        }
+        bench::doNotOptimize(s);
+    });
+
+    bench::run("WString", "concat_10x16_reserved", 160, []() {
+        String s;
+        s.reserve(160);
+        for (int i = 0; i < 10; i++)
+        {
+            s += "0123456789abcdef";
+        }
+        bench::doNotOptimize(s);
+    });
+
+    String haystack;
+    for (int i = 0; i < 16; i++)
+    {
+        haystack += "the quick brown fox jumps over the lazy dog ";
+    }
+    haystack += "needle";
+
+    bench::run("WString", "indexOf", haystack.length(), [&]() {
+        bench::doNotOptimize(haystack.indexOf("needle"));
+    });
+
+    bench::run("WString", "replace", haystack.length(), [&]() {
+        String s(haystack);
+        s.replace("fox", "cat");
+        bench::doNotOptimize(s);
+    });
+
+    const String num("-1234567");
+    bench::run("WString", "toInt", 0, [&]() { bench::doNotOptimize(num.toInt()); });
+
+    const String flt("3.14159265");
+    bench::run("WString", "toFloat", 0, [&]() { bench::doNotOptimize(flt.toFloat()); });
+}
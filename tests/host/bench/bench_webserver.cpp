@@ -0,0 +1,311 @@
+/*
+ bench_webserver.cpp - scripted load benchmarks for ESP8266WebServer
+
+ Instantiates ESP8266WebServerTemplate over an in-memory scripted
+ server/client pair (no sockets, no WiFi mock) and drives handleClient()
+ with connection traces: bursts of short-lived clients, a pipelined
+ keep-alive client, and idle slowloris-style slot holders. Reports the
+ usual BENCH lines plus derived requests/s, and - on glibc hosts - heap
+ allocator calls per served request by interposing malloc/realloc/calloc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <ESP8266WebServer.h>
+#include "bench.h"
+#include "AllocCount.h"
+
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// One scripted connection: the bytes the "peer" will send, and counters
+// for what the server wrote back. Shared between the server-side client
+// copies, like the real WiFiClient shares its ClientContext.
+struct TraceState
+{
+    String rx;
+    size_t rxPos   = 0;
+    size_t txBytes = 0;
+    bool   open    = true;
+    // peer half-closes once its script is consumed (false emulates a
+    // slowloris peer holding the connection open)
+    bool closeWhenDrained = true;
+};
+
+using TracePtr = std::shared_ptr<TraceState>;
+
+class TraceClient : public Stream
+{
+public:
+    TraceClient() { }
+    explicit TraceClient(TracePtr state) : _state(state) { }
+
+    // like WiFiClient: keep Print's const char*/String overloads visible
+    // next to the uint8_t* overrides below
+    using Print::write;
+
+    explicit operator bool() const
+    {
+        return (bool)_state;
+    }
+
+    uint8_t connected()
+    {
+        return _state && (_state->open || pending());
+    }
+
+    void stop()
+    {
+        if (_state)
+        {
+            _state->open = false;
+        }
+    }
+
+    int available() override
+    {
+        return pending();
+    }
+
+    int read() override
+    {
+        if (!pending())
+        {
+            return -1;
+        }
+        char c = _state->rx[_state->rxPos++];
+        maybeClose();
+        return (unsigned char)c;
+    }
+
+    int read(uint8_t* buffer, size_t len) override
+    {
+        size_t take = (size_t)pending();
+        if (take > len)
+        {
+            take = len;
+        }
+        memcpy(buffer, _state->rx.c_str() + _state->rxPos, take);
+        _state->rxPos += take;
+        maybeClose();
+        return take;
+    }
+
+    int peek() override
+    {
+        return pending() ? (unsigned char)_state->rx[_state->rxPos] : -1;
+    }
+
+    // advertise write space, or sendSize() spins until the send timeout
+    int availableForWrite() override
+    {
+        return _state ? 65535 : 0;
+    }
+
+    size_t write(uint8_t) override
+    {
+        if (!_state)
+        {
+            return 0;
+        }
+        _state->txBytes++;
+        return 1;
+    }
+
+    size_t write(const uint8_t*, size_t size) override
+    {
+        if (!_state)
+        {
+            return 0;
+        }
+        _state->txBytes += size;
+        return size;
+    }
+
+    void flush() override { }
+
+private:
+    int pending() const
+    {
+        return _state ? (int)(_state->rx.length() - _state->rxPos) : 0;
+    }
+
+    void maybeClose()
+    {
+        if (_state->closeWhenDrained && _state->rxPos >= _state->rx.length())
+        {
+            _state->open = false;
+        }
+    }
+
+    TracePtr _state;
+};
+
+class TraceServer
+{
+public:
+    using ClientType = TraceClient;
+
+    TraceServer(int) { }
+    TraceServer(IPAddress, int) { }
+
+    void begin() { }
+    void begin(uint16_t) { }
+    void close()
+    {
+        pending().clear();
+    }
+
+    bool hasClient()
+    {
+        return !pending().empty();
+    }
+
+    bool hasClientData()
+    {
+        return hasClient(); // scripted bytes are always buffered
+    }
+
+    bool hasMaxPendingClients()
+    {
+        return false;
+    }
+
+    TraceClient accept()
+    {
+        TracePtr state = pending().front();
+        pending().pop_front();
+        return TraceClient(state);
+    }
+
+    // scripted connection backlog; static so the benchmark can enqueue
+    // traces into the server instance living inside the template
+    static std::deque<TracePtr>& pending()
+    {
+        static std::deque<TracePtr> queue;
+        return queue;
+    }
+};
+
+using LoadServer = esp8266webserver::ESP8266WebServerTemplate<TraceServer>;
+
+constexpr char requestClose[] = "GET /hello HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n";
+constexpr char requestKeep[]  = "GET /hello HTTP/1.1\r\nHost: bench\r\n\r\n";
+
+TracePtr makeTrace(const char* request, size_t copies, bool closeWhenDrained = true)
+{
+    auto state = std::make_shared<TraceState>();
+    state->rx.reserve(strlen(request) * copies);
+    for (size_t i = 0; i < copies; i++)
+    {
+        state->rx += request;
+    }
+    state->closeWhenDrained = closeWhenDrained;
+    return state;
+}
+
+// run handleClient() until every enqueued trace has been accepted and
+// fully consumed (the response is written in the same pass that drains
+// the last request of a trace)
+void serveAll(LoadServer& server, const std::vector<TracePtr>& traces)
+{
+    bool busy = true;
+    while (busy)
+    {
+        server.handleClient();
+        busy = !TraceServer::pending().empty();
+        for (size_t i = 0; !busy && i < traces.size(); i++)
+        {
+            busy = traces[i]->open;
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("bench WebServer load", "[.][bench]")
+{
+    LoadServer server(80);
+    size_t     served = 0;
+    server.on("/hello", [&]() {
+        served++;
+        server.send(200, F("text/plain"), F("hello"));
+    });
+    server.begin();
+
+    // burst: 16 independent close-after-response connections per op
+    double nsPerOp = bench::run("WebServer", "burst16_close", 0, [&]() {
+        std::vector<TracePtr> traces;
+        for (int i = 0; i < 16; i++)
+        {
+            traces.push_back(makeTrace(requestClose, 1));
+            TraceServer::pending().push_back(traces.back());
+        }
+        serveAll(server, traces);
+    });
+    printf("BENCH,WebServer,burst16_close_reqs_per_s,16,%.0f,0.0\n", 16e9 / nsPerOp);
+
+    // pipelining: one keep-alive connection carrying 16 buffered requests
+    nsPerOp = bench::run("WebServer", "pipelined16", 0, [&]() {
+        std::vector<TracePtr> traces;
+        traces.push_back(makeTrace(requestKeep, 16));
+        TraceServer::pending().push_back(traces.back());
+        serveAll(server, traces);
+    });
+    printf("BENCH,WebServer,pipelined16_reqs_per_s,16,%.0f,0.0\n", 16e9 / nsPerOp);
+
+    // slowloris: connected peers that never send a byte occupy all
+    // connection slots; measures the idle per-pass service overhead
+    {
+        std::vector<TracePtr> stuck;
+        for (int i = 0; i < WEBSERVER_MAX_CLIENTS; i++)
+        {
+            stuck.push_back(makeTrace("", 0, false));
+            TraceServer::pending().push_back(stuck.back());
+        }
+        server.handleClient(); // accept them into the slots
+        bench::run("WebServer", "slowloris_idle_pass", 0, [&]() {
+            server.handleClient();
+        });
+        for (auto& trace : stuck)
+        {
+            trace->open = false;
+        }
+        serveAll(server, stuck);
+    }
+
+    if (alloccount::available())
+    {
+        constexpr int         requests = 64;
+        std::vector<TracePtr> traces;
+        for (int i = 0; i < requests; i++)
+        {
+            traces.push_back(makeTrace(requestClose, 1));
+            TraceServer::pending().push_back(traces.back());
+        }
+        alloccount::reset();
+        alloccount::setEnabled(true);
+        serveAll(server, traces);
+        alloccount::setEnabled(false);
+        // third column: requests measured, fourth: allocator calls/request
+        printf("BENCH,WebServer,allocs_per_request,%d,%.1f,0.0\n", requests,
+               (double)alloccount::current() / requests);
+    }
+
+    // every scripted request must actually have reached the handler
+    REQUIRE(served > 0);
+}
@@ -0,0 +1,109 @@
+/*
+ AllocCount.cpp - counting allocator shim for host tests
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include "AllocCount.h"
+
+#include <stddef.h>
+
+#if defined(__GLIBC__)
+
+// glibc exports its allocator under these aliases, so the public symbols
+// can be redefined here to count and forward. String uses realloc directly
+// (not operator new), hence all three entry points are interposed.
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void  __libc_free(void* ptr);
+}
+
+static uint64_t s_calls   = 0;
+static bool     s_enabled = false;
+
+extern "C" void* malloc(size_t size)
+{
+    if (s_enabled)
+    {
+        s_calls++;
+    }
+    return __libc_malloc(size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    if (s_enabled)
+    {
+        s_calls++;
+    }
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+    if (s_enabled)
+    {
+        s_calls++;
+    }
+    return __libc_calloc(count, size);
+}
+
+extern "C" void free(void* ptr)
+{
+    __libc_free(ptr);
+}
+
+namespace alloccount
+{
+bool available()
+{
+    return true;
+}
+
+void setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+void reset()
+{
+    s_calls = 0;
+}
+
+uint64_t current()
+{
+    return s_calls;
+}
+}  // namespace alloccount
+
+#else  // !__GLIBC__
+
+namespace alloccount
+{
+bool available()
+{
+    return false;
+}
+
+void setEnabled(bool) { }
+
+void reset() { }
+
+uint64_t current()
+{
+    return 0;
+}
+}  // namespace alloccount
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ AllocCount.h - counting allocator shim for host tests
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#ifndef test_alloccount_h
+#define test_alloccount_h
+
+#include <stdint.h>
+
+// Counts calls into the C allocator (malloc/realloc/calloc - operator new
+// funnels into it) while enabled, so tests can pin how many allocations an
+// operation performs and a regression fails here instead of fragmenting the
+// device heap. Counting works by interposing the glibc allocator; on other
+// hosts available() returns false and the pins become no-ops.
+namespace alloccount
+{
+bool     available();
+void     setEnabled(bool enabled);
+void     reset();
+uint64_t current();
+
+// drives a CHECK_ALLOCATIONS() block; counting stops when it goes out of
+// scope even if the block throws
+class Scope
+{
+public:
+    Scope()
+    {
+        reset();
+    }
+    ~Scope()
+    {
+        setEnabled(false);
+    }
+    bool run()
+    {
+        if (_ran)
+        {
+            return false;
+        }
+        _ran = true;
+        setEnabled(true);
+        return true;
+    }
+    void finish()
+    {
+        setEnabled(false);
+        _observed = current();
+    }
+    uint64_t observed() const
+    {
+        return _observed;
+    }
+
+private:
+    bool     _ran      = false;
+    uint64_t _observed = 0;
+};
+}  // namespace alloccount
+
+// Pin the number of allocator calls a block performs:
+//
+//     CHECK_ALLOCATIONS(1)
+//     {
+//         String s;
+//         s.reserve(100);
+//     }
+//
+// The count is checked with CHECK() once the block completes; on hosts
+// where the allocator cannot be interposed the block still runs but the
+// count is not asserted. Requires catch.hpp to be included first.
+#define CHECK_ALLOCATIONS(expected)                                                                \
+    for (::alloccount::Scope _alloc_scope_; _alloc_scope_.run(); [&]() {                           \
+             _alloc_scope_.finish();                                                               \
+             if (::alloccount::available())                                                        \
+             {                                                                                     \
+                 CHECK(_alloc_scope_.observed() == (uint64_t)(expected));                          \
+             }                                                                                     \
+         }())
+
+#endif
@@ -62,6 +62,15 @@ extern "C" void optimistic_yield(uint32_t interval_us)
     (void)interval_us;
 }
 
+extern "C" uint32_t esp_cycles_at_resume()
+{
+    return 0;
+}
+
+extern "C" uint32_t esp_cooperative_overruns = 0;
+
+extern "C" void esp_cooperative_slice() { }
+
 extern "C" void esp_suspend() { }
 
 extern "C" void esp_schedule() { }
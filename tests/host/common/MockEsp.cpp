@@ -35,6 +35,11 @@
 #include <sys/time.h>
 
 #include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 #include <user_interface.h>
 struct rst_info resetInfo;
@@ -171,9 +176,24 @@ void EspClass::getHeapStats(uint32_t* hfree, uint32_t* hmax, uint8_t* hfrag)
         *hfrag = 100 - (sqrt(hm) * 100) / hf;
 }
 
+// RAM-backed sketch flash, so code staging an update and reading it back
+// (Updater verification) sees its own data instead of a no-op.  Sectors
+// are allocated lazily because the mock address space is sparse; unwritten
+// ranges read as erased flash (0xff).
+static constexpr uint32_t                               flashSectorSize = 4096;
+static std::unordered_map<uint32_t, std::vector<uint8_t>> s_flash;
+
+static uint8_t* flash_sector(uint32_t sector)
+{
+    auto& page = s_flash[sector];
+    if (page.empty())
+        page.assign(flashSectorSize, 0xff);
+    return page.data();
+}
+
 bool EspClass::flashEraseSector(uint32_t sector)
 {
-    (void)sector;
+    memset(flash_sector(sector), 0xff, flashSectorSize);
     return true;
 }
 
@@ -190,33 +210,39 @@ FlashMode_t EspClass::magicFlashChipMode(uint8_t byte)
 
 bool EspClass::flashWrite(uint32_t offset, const uint32_t* data, size_t size)
 {
-    (void)offset;
-    (void)data;
-    (void)size;
-    return true;
+    return flashWrite(offset, reinterpret_cast<const uint8_t*>(data), size);
 }
 
 bool EspClass::flashWrite(uint32_t offset, const uint8_t* data, size_t size)
 {
-    (void)offset;
-    (void)data;
-    (void)size;
+    while (size)
+    {
+        size_t in = offset % flashSectorSize;
+        size_t n  = std::min(size, (size_t)(flashSectorSize - in));
+        memcpy(flash_sector(offset / flashSectorSize) + in, data, n);
+        offset += n;
+        data += n;
+        size -= n;
+    }
     return true;
 }
 
 bool EspClass::flashRead(uint32_t offset, uint32_t* data, size_t size)
 {
-    (void)offset;
-    (void)data;
-    (void)size;
-    return true;
+    return flashRead(offset, reinterpret_cast<uint8_t*>(data), size);
 }
 
 bool EspClass::flashRead(uint32_t offset, uint8_t* data, size_t size)
 {
-    (void)offset;
-    (void)data;
-    (void)size;
+    while (size)
+    {
+        size_t in = offset % flashSectorSize;
+        size_t n  = std::min(size, (size_t)(flashSectorSize - in));
+        memcpy(data, flash_sector(offset / flashSectorSize) + in, n);
+        offset += n;
+        data += n;
+        size -= n;
+    }
     return true;
 }
 
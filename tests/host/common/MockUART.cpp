@@ -245,6 +245,20 @@ extern "C"
         return uart && uart->rx_enabled ? uart->rx_buffer->size : 0;
     }
 
+    // on host, writes never block: the tx ring is not emulated
+    size_t uart_resize_tx_buffer(uart_t* uart, size_t new_size)
+    {
+        (void)uart;
+        (void)new_size;
+        return 0;
+    }
+
+    size_t uart_get_tx_buffer_size(uart_t* uart)
+    {
+        (void)uart;
+        return 0;
+    }
+
     size_t uart_write_char(uart_t* uart, char c)
     {
         if (uart == NULL || !uart->tx_enabled)
@@ -480,3 +494,24 @@ void uart_peek_consume(uart_t* uart, size_t consume)
     (void)uart;
     (void)consume;
 }
+
+// RX line framing is not emulated on host
+bool uart_set_rx_framing(uart_t* uart, int terminator, size_t fixed_length,
+                         uart_frame_notify_t notify, void* notify_arg)
+{
+    (void)uart;
+    (void)terminator;
+    (void)fixed_length;
+    (void)notify;
+    (void)notify_arg;
+    return false;
+}
+
+size_t uart_rx_deliver_frames(uart_t* uart, void (*cb)(void* arg, const char* data, size_t len),
+                              void* arg)
+{
+    (void)uart;
+    (void)cb;
+    (void)arg;
+    return 0;
+}
@@ -103,10 +103,14 @@ typedef enum
 #define ICACHE_RODATA_ATTR                                                                         \
     __attribute__((section("\".irom.text." __FILE__ "." __ICACHE_STRINGIZE(                        \
         __LINE__) "." __ICACHE_STRINGIZE(__COUNTER__) "\"")))
+#define IRAM_HOT(pri)                                                                              \
+    __attribute__((section("\".iram.text.hot." __ICACHE_STRINGIZE(pri) "." __FILE__                \
+                           "." __ICACHE_STRINGIZE(__LINE__) "." __ICACHE_STRINGIZE(__COUNTER__) "\"")))
 #else
 #define ICACHE_FLASH_ATTR
 #define IRAM_ATTR
 #define ICACHE_RODATA_ATTR
+#define IRAM_HOT(pri)
 #endif /* ICACHE_FLASH */
 
 // counterpart https://github.com/espressif/arduino-esp32/blob/master/cores/esp32/esp8266-compat.h
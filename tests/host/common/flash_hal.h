@@ -17,6 +17,14 @@ extern "C"
     extern uint32_t s_phys_block;
     extern uint8_t* s_phys_data;
 
+    // Simulated flash latency knobs (see flash_hal_mock.cpp); used by the
+    // fs/bench_fs.cpp benchmark suite, all zero by default
+    extern uint32_t s_flash_read_base_ns;
+    extern uint32_t s_flash_read_byte_ns;
+    extern uint32_t s_flash_prog_page_us;
+    extern uint32_t s_flash_erase_sector_us;
+    extern uint64_t s_flash_time_ns;
+
     extern int32_t flash_hal_read(uint32_t addr, uint32_t size, uint8_t* dst);
     extern int32_t flash_hal_write(uint32_t addr, uint32_t size, const uint8_t* src);
     extern int32_t flash_hal_erase(uint32_t addr, uint32_t size);
@@ -12,16 +12,83 @@ extern "C"
     uint32_t s_phys_page  = 0;
     uint32_t s_phys_block = 0;
     uint8_t* s_phys_data  = nullptr;
+
+    // Injectable flash-latency model.  No real sleeping happens; each HAL
+    // call adds its modeled cost to s_flash_time_ns so benchmarks measure
+    // deterministic simulated time instead of noisy host wall clock.  All
+    // costs default to 0, leaving the regular tests unaffected.
+    uint32_t s_flash_read_base_ns     = 0;  // per read call (command + addr phase)
+    uint32_t s_flash_read_byte_ns     = 0;  // per byte transferred (read or program)
+    uint32_t s_flash_prog_page_us     = 0;  // per 256-byte page programmed
+    uint32_t s_flash_erase_sector_us  = 0;  // per 4KB sector erased
+    uint64_t s_flash_time_ns          = 0;  // accumulated simulated flash time
+}
+
+// Wear/latency counters, fed from the modeled costs above so tests can
+// assert on deterministic numbers.  Persistence is not emulated.
+static flash_hal_stats_t s_stats = {};
+
+static void stats_latency(uint32_t* hist, uint32_t us)
+{
+    uint32_t bucket = 0;
+    while (us > 1 && bucket < FLASH_HAL_STATS_LAT_BUCKETS - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+    hist[bucket]++;
+}
+
+const flash_hal_stats_t* flash_hal_stats(void)
+{
+    return &s_stats;
+}
+
+uint32_t flash_hal_stats_max_erase(void)
+{
+    uint32_t maxErase = 0;
+    for (uint32_t i = 0; i < FLASH_HAL_STATS_REGIONS; ++i)
+    {
+        if (s_stats.eraseCount[i] > maxErase)
+        {
+            maxErase = s_stats.eraseCount[i];
+        }
+    }
+    return maxErase;
+}
+
+void flash_hal_stats_begin(uint32_t sector)
+{
+    (void)sector;
+}
+
+int32_t flash_hal_stats_commit(void)
+{
+    return FLASH_HAL_OK;
+}
+
+void flash_hal_stats_reset(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
 }
 
 int32_t flash_hal_read(uint32_t addr, uint32_t size, uint8_t* dst)
 {
+    const uint64_t cost_ns = s_flash_read_base_ns + (uint64_t)size * s_flash_read_byte_ns;
+    s_flash_time_ns += cost_ns;
+    stats_latency(s_stats.readLatency, cost_ns / 1000);
     memcpy(dst, s_phys_data + addr, size);
     return 0;
 }
 
 int32_t flash_hal_write(uint32_t addr, uint32_t size, const uint8_t* src)
 {
+    // Programming crosses a page boundary at most every 256 bytes
+    const uint32_t pages = (addr % 256 + size + 255) / 256;
+    const uint64_t cost_ns = (uint64_t)pages * s_flash_prog_page_us * 1000
+                             + (uint64_t)size * s_flash_read_byte_ns;
+    s_flash_time_ns += cost_ns;
+    stats_latency(s_stats.writeLatency, cost_ns / 1000);
     memcpy(s_phys_data + addr, src, size);
     return 0;
 }
@@ -34,8 +101,17 @@ int32_t flash_hal_erase(uint32_t addr, uint32_t size)
     }
     const uint32_t sector      = addr / FLASH_SECTOR_SIZE;
     const uint32_t sectorCount = size / FLASH_SECTOR_SIZE;
+    s_flash_time_ns += (uint64_t)sectorCount * s_flash_erase_sector_us * 1000;
     for (uint32_t i = 0; i < sectorCount; ++i)
     {
+        uint32_t region = FLASH_HAL_STATS_REGIONS;
+        const uint32_t sectorAddr = (sector + i) * FLASH_SECTOR_SIZE;
+        if (s_phys_size && sectorAddr - s_phys_addr < s_phys_size)
+        {
+            region = (uint64_t)(sectorAddr - s_phys_addr) * FLASH_HAL_STATS_REGIONS
+                     / s_phys_size;
+        }
+        s_stats.eraseCount[region]++;
         memset(s_phys_data + (sector + i) * FLASH_SECTOR_SIZE, 0xff, FLASH_SECTOR_SIZE);
     }
     return 0;
@@ -26,8 +26,20 @@ class WiFiClient;
 
 #include <assert.h>
 
+#include <include/SharedSendBuffer.h>
+
 bool getDefaultPrivateGlobalSyncValue();
 
+#ifndef CLIENT_IOVEC_DEFINED
+#define CLIENT_IOVEC_DEFINED
+// fragment descriptor for scatter-gather writes (WiFiClient::writev()),
+// layout-compatible with POSIX struct iovec
+struct client_iovec {
+    const void* iov_base;
+    size_t      iov_len;
+};
+#endif // CLIENT_IOVEC_DEFINED
+
 typedef void (*discard_cb_t)(void*, ClientContext*);
 
 class ClientContext
@@ -104,12 +116,34 @@ public:
         return mockConnect(addr->addr, _sock, port);
     }
 
+    // emulation is synchronous: the outcome is already in state()
+    int connectAsync(const ip_addr_t* addr, uint16_t port)
+    {
+        return connect(addr, port);
+    }
+
+    bool connecting() const
+    {
+        return false;
+    }
+
     size_t availableForWrite()
     {
         // XXXFIXME be smarter
         return 512;
     }
 
+    size_t txQueueDepth()
+    {
+        // the mock socket write is synchronous, nothing stays queued
+        return 0;
+    }
+
+    int rttEstimateMs()
+    {
+        return 0;
+    }
+
     void setNoDelay(bool nodelay)
     {
         mockverbose("TODO setNoDelay(%d)\n", (int)nodelay);
@@ -232,6 +266,32 @@ public:
         return ret;
     }
 
+    bool writeShared(SharedSendBuffer* shared)
+    {
+        // synchronous socket write, the payload is "ACKed" immediately
+        if (!shared || !shared->len)
+            return false;
+        if (write((const char*)shared->payload, shared->len) != shared->len)
+            return false;
+        shared->ref();
+        shared->unref(true);
+        return true;
+    }
+
+    size_t writev(const client_iovec* iov, int iovcnt)
+    {
+        // no scatter-gather on the mock socket, write fragments in sequence
+        size_t written = 0;
+        for (int i = 0; i < iovcnt; i++)
+        {
+            size_t ret = write((const char*)iov[i].iov_base, iov[i].iov_len);
+            written += ret;
+            if (ret != iov[i].iov_len)
+                break;
+        }
+        return written;
+    }
+
     void keepAlive(uint16_t idle_sec = TCP_DEFAULT_KEEPALIVE_IDLE_SEC,
                    uint16_t intv_sec = TCP_DEFAULT_KEEPALIVE_INTERVAL_SEC,
                    uint8_t  count    = TCP_DEFAULT_KEEPALIVE_COUNT)
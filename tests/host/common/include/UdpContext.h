@@ -22,6 +22,7 @@
 #define UDPCONTEXT_H
 
 #include <functional>
+#include <vector>
 
 #include <MocklwIP.h>
 #include <IPAddress.h>
@@ -239,6 +240,33 @@ public:
         return trySend(addr, port, false) == ERR_OK;
     }
 
+    bool queuePacket(ip_addr_t* addr = 0, uint16_t port = 0)
+    {
+        if (_queued.size() >= 8)
+            flushQueued();
+        QueuedPacket qp;
+        qp.data.assign(_outbuf, _outbuf + _outbufsize);
+        qp.dst  = addr ? addr->addr : _dst.addr;
+        qp.port = port ?: _dstport;
+        _queued.push_back(std::move(qp));
+        _outbufsize = 0;
+        return true;
+    }
+
+    size_t flushQueued()
+    {
+        size_t sent = 0;
+        for (auto& qp : _queued)
+        {
+            if (mockUDPWrite(_sock, (const uint8_t*)qp.data.data(), qp.data.size(), _timeout_ms,
+                             qp.dst, qp.port)
+                == qp.data.size())
+                ++sent;
+        }
+        _queued.clear();
+        return sent;
+    }
+
     bool sendTimeout(ip_addr_t* addr, uint16_t port,
                      esp8266::polledTimeout::oneShotFastMs::timeType timeoutMs)
     {
@@ -288,6 +316,14 @@ private:
     char   _outbuf[CCBUFSIZE];
     size_t _outbufsize = 0;
 
+    struct QueuedPacket
+    {
+        std::vector<char> data;
+        uint32_t          dst;
+        uint16_t          port;
+    };
+    std::vector<QueuedPacket> _queued;
+
     int _timeout_ms = 0;
 
     uint8_t addrsize;
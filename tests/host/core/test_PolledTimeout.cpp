@@ -238,3 +238,51 @@ TEST_CASE("OneShot Timeout 3000ms reset to 1000ms custom yield", "[polledTimeout
 
     REQUIRE(fuzzycomp(delta, (timeType)1000));
 }
+
+TEST_CASE("OneShot HighRes timeout 0.5s in cycles", "[polledTimeout]")
+{
+    using esp8266::polledTimeout::oneShotHighRes;
+    using timeType = oneShotHighRes::timeType;
+    timeType before, after, delta;
+
+    Serial.println("OneShot HighRes timeout 0.5s in cycles");
+
+    oneShotHighRes timeout(microsecondsToClockCycles(500000));
+    before = micros();
+    while (!timeout.expired())
+        yield();
+    after = micros();
+
+    delta = after - before;
+    Serial.printf("delta = %u\n", delta);
+
+    REQUIRE(fuzzycomp(delta / 1000, (timeType)500));
+}
+
+TEST_CASE("Periodic HighRes period catch-up", "[polledTimeout]")
+{
+    using esp8266::polledTimeout::periodicHighRes;
+
+    Serial.println("Periodic HighRes period catch-up");
+
+    periodicHighRes period(microsecondsToClockCycles(100000));
+
+    // single-period retrigger (polled faster than the period)
+    int triggers = 0;
+    decltype(micros()) start = micros();
+    while (micros() - start < 550000)
+    {
+        if (period.expired())
+            triggers++;
+        yield();
+    }
+    REQUIRE(triggers >= 4);
+    REQUIRE(triggers <= 6);
+
+    // several periods elapse unpolled: one trigger, then back in phase
+    start = micros();
+    while (micros() - start < 350000)
+        yield();
+    REQUIRE(period.expired());
+    REQUIRE(!period.expired());
+}
@@ -53,3 +53,81 @@ TEST_CASE("Updater fails when writes overflow requested size", "[core][Updater]"
     REQUIRE(!u->write(buff, 2048));
     delete u;
 }
+
+TEST_CASE("Updater reports per-chunk detail through onProgressDetail", "[core][Updater]")
+{
+    UpdaterClass          u;
+    uint8_t               buff[4096];
+    int                   calls = 0;
+    UpdaterProgressDetail last;
+    memset(buff, 0xa5, sizeof(buff));
+    u.onProgressDetail(
+        [&](const UpdaterProgressDetail& detail)
+        {
+            calls++;
+            last = detail;
+        });
+    REQUIRE(u.begin(8192));
+    REQUIRE(u.write(buff, 4096));
+    REQUIRE(u.write(buff, 4096));
+    // one callback per sector-sized chunk reaching flash
+    REQUIRE(calls == 2);
+    REQUIRE(last.size == 8192);
+    REQUIRE(last.progress == 8192);
+}
+
+// gzip of a fake 1024-byte image (0xE9 header), generated with python3 zlib
+static const uint8_t imageGz[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x7b, 0xc9,
+    0xcc, 0xe0, 0xc0, 0xc0, 0xce, 0x27, 0x2a, 0xa3, 0xac, 0x65, 0x68, 0x61,
+    0xef, 0xe6, 0x1b, 0x12, 0x9d, 0x94, 0x59, 0x50, 0x5e, 0xd7, 0xda, 0x33,
+    0x79, 0xd6, 0xc2, 0x15, 0xeb, 0xb7, 0xed, 0x3d, 0x72, 0xfa, 0xd2, 0xcd,
+    0x07, 0xcf, 0xdf, 0x7d, 0xfd, 0xc3, 0xcc, 0x25, 0x28, 0x21, 0xaf, 0xa6,
+    0x6b, 0x62, 0xed, 0xe4, 0x19, 0x10, 0x1e, 0x97, 0x9a, 0x53, 0x5c, 0xd5,
+    0xd8, 0xd1, 0x3f, 0x6d, 0xee, 0x92, 0xd5, 0x9b, 0x76, 0x1e, 0x38, 0x7e,
+    0xee, 0xea, 0x9d, 0xc7, 0xaf, 0x3e, 0xfe, 0xf8, 0xcf, 0xc6, 0x2b, 0x22,
+    0xad, 0xa4, 0x69, 0x60, 0x6e, 0xe7, 0xea, 0x13, 0x1c, 0x95, 0x98, 0x91,
+    0x5f, 0x56, 0xdb, 0xd2, 0x3d, 0x69, 0xe6, 0x82, 0xe5, 0xeb, 0xb6, 0xee,
+    0x39, 0x7c, 0xea, 0xe2, 0x8d, 0xfb, 0xcf, 0xde, 0x7e, 0xf9, 0xcd, 0xc4,
+    0x29, 0x20, 0x2e, 0xa7, 0xaa, 0x63, 0x6c, 0xe5, 0xe8, 0xe1, 0x1f, 0x16,
+    0x9b, 0x92, 0x5d, 0x54, 0xd9, 0xd0, 0xde, 0x37, 0x75, 0xce, 0xe2, 0x55,
+    0x1b, 0x77, 0xec, 0x3f, 0x76, 0xf6, 0xca, 0xed, 0x47, 0x2f, 0x3f, 0x7c,
+    0xff, 0xc7, 0xca, 0x23, 0x2c, 0xa5, 0xa8, 0xa1, 0x6f, 0x66, 0xeb, 0xe2,
+    0x1d, 0x14, 0x99, 0x90, 0x9e, 0x57, 0x5a, 0xd3, 0xdc, 0x35, 0x71, 0xc6,
+    0xfc, 0x65, 0x6b, 0xb7, 0xec, 0x3e, 0x74, 0xf2, 0xc2, 0xf5, 0x7b, 0x4f,
+    0xdf, 0x7c, 0xfe, 0xc5, 0xc8, 0xc1, 0x2f, 0x26, 0xab, 0xa2, 0x6d, 0x64,
+    0xe9, 0xe0, 0xee, 0x17, 0x1a, 0x93, 0x9c, 0x55, 0x58, 0x51, 0xdf, 0xd6,
+    0x3b, 0x65, 0xf6, 0xa2, 0x95, 0x1b, 0xb6, 0xef, 0x3b, 0x7a, 0xe6, 0xf2,
+    0xad, 0x87, 0x2f, 0xde, 0x7f, 0xfb, 0xcb, 0xc2, 0x2d, 0x24, 0xa9, 0xa0,
+    0xae, 0x67, 0x6a, 0xe3, 0xec, 0x15, 0x18, 0x11, 0x9f, 0x96, 0x5b, 0x52,
+    0xdd, 0xd4, 0x39, 0x61, 0xfa, 0xbc, 0xa5, 0x6b, 0x36, 0xef, 0x3a, 0x78,
+    0xe2, 0xfc, 0xb5, 0xbb, 0x4f, 0x5e, 0x7f, 0xfa, 0x39, 0xea, 0xff, 0x51,
+    0xff, 0x8f, 0x54, 0xff, 0x03, 0x00, 0x69, 0xf7, 0x93, 0x05, 0x00, 0x04,
+    0x00, 0x00,
+};
+
+TEST_CASE("Updater verifies staged GZIP images", "[core][Updater]")
+{
+    // an intact compressed image passes end() and reports its inflated size
+    {
+        UpdaterClass u;
+        uint8_t      buff[sizeof(imageGz)];
+        memcpy(buff, imageGz, sizeof(imageGz));
+        REQUIRE(u.begin(sizeof(imageGz)));
+        REQUIRE(u.write(buff, sizeof(imageGz)));
+        REQUIRE(u.end());
+        REQUIRE(u.decompressedSize() == 1024);
+    }
+
+    // corrupting the deflate stream must fail the update
+    {
+        UpdaterClass u;
+        uint8_t      buff[sizeof(imageGz)];
+        memcpy(buff, imageGz, sizeof(imageGz));
+        buff[40] ^= 0xff;
+        REQUIRE(u.begin(sizeof(imageGz)));
+        REQUIRE(u.write(buff, sizeof(imageGz)));
+        REQUIRE(!u.end());
+        REQUIRE(u.getError() == UPDATE_ERROR_GZIP);
+    }
+}
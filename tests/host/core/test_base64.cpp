@@ -0,0 +1,97 @@
+/*
+ test_base64.cpp - base64 encode/decode tests
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ */
+
+#include <catch.hpp>
+#include <base64.h>
+#include <StreamString.h>
+
+static String streamEncode(const String& input, bool doNewLines)
+{
+    StreamString in;
+    in.print(input);
+    StreamString out;
+    size_t written = base64::encode(in, out, doNewLines);
+    REQUIRE(written == out.length());
+    return out;
+}
+
+TEST_CASE("base64::encode(Stream&, Print&) matches the buffer encoder", "[core][base64]")
+{
+    // RFC 4648 test vectors
+    REQUIRE(streamEncode("", false) == "");
+    REQUIRE(streamEncode("f", false) == "Zg==");
+    REQUIRE(streamEncode("fo", false) == "Zm8=");
+    REQUIRE(streamEncode("foo", false) == "Zm9v");
+    REQUIRE(streamEncode("foob", false) == "Zm9vYg==");
+    REQUIRE(streamEncode("fooba", false) == "Zm9vYmE=");
+    REQUIRE(streamEncode("foobar", false) == "Zm9vYmFy");
+
+    String longText;
+    for (int i = 0; i < 50; i++)
+    {
+        longText += "The quick brown fox jumps over the lazy dog. ";
+    }
+    REQUIRE(streamEncode(longText, false) == base64::encode(longText, false));
+}
+
+TEST_CASE("base64::encode(Stream&, Print&) inserts newlines like libb64", "[core][base64]")
+{
+    String text;
+    for (int i = 0; i < 20; i++)
+    {
+        text += "0123456789";
+    }
+    String expected = base64::encode(text, true);
+    // the buffer encoder NUL-terminates without a trailing newline
+    REQUIRE(streamEncode(text, true) == expected);
+}
+
+TEST_CASE("base64::decode round-trips the encoder output", "[core][base64]")
+{
+    REQUIRE(base64::decode(String("")) == "");
+    REQUIRE(base64::decode("Zg==") == "f");
+    REQUIRE(base64::decode("Zm8=") == "fo");
+    REQUIRE(base64::decode("Zm9v") == "foo");
+    REQUIRE(base64::decode("Zm9vYg==") == "foob");
+    REQUIRE(base64::decode("Zm9vYmE=") == "fooba");
+    REQUIRE(base64::decode("Zm9vYmFy") == "foobar");
+
+    // unpadded input decodes too
+    REQUIRE(base64::decode("Zm9vYmE") == "fooba");
+
+    String binary;
+    for (int i = 0; i < 256; i++)
+    {
+        binary += (char)(i ? i : 1); // String cannot hold NUL bytes
+    }
+    REQUIRE(base64::decode(base64::encode(binary, false)) == binary);
+}
+
+TEST_CASE("base64::decode skips newlines in wrapped input", "[core][base64]")
+{
+    String text;
+    for (int i = 0; i < 20; i++)
+    {
+        text += "0123456789";
+    }
+    String wrapped = base64::encode(text, true);
+    REQUIRE(wrapped.indexOf('\n') >= 0);
+    REQUIRE(base64::decode(wrapped) == text);
+
+    StreamString in;
+    in.print(wrapped);
+    StreamString out;
+    REQUIRE(base64::decode(in, out) == text.length());
+    REQUIRE(out == text);
+}
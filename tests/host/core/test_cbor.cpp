@@ -0,0 +1,181 @@
+/*
+ test_cbor.cpp - CBOR encoder/decoder tests
+
+ Copyright © 2026 esp8266/Arduino community.  All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to
+ deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <Cbor.h>
+#include <StreamString.h>
+
+static String hex(const String& s)
+{
+    String out;
+    for (size_t i = 0; i < s.length(); i++)
+    {
+        char buf[4];
+        snprintf(buf, sizeof(buf), "%02x", (uint8_t)s[i]);
+        out += buf;
+    }
+    return out;
+}
+
+// records every visitor callback as a compact token stream
+struct LogVisitor : CborReader::Visitor
+{
+    String log;
+    void onUnsigned(uint64_t v) override
+    {
+        log += "u" + String((unsigned long)v) + " ";
+    }
+    void onNegative(int64_t v) override
+    {
+        log += "i" + String((long)v) + " ";
+    }
+    void onText(const char* s, size_t len, bool last) override
+    {
+        log += "t'";
+        log.concat(s, len);
+        log += last ? "'! " : "' ";
+    }
+    void onBytes(const uint8_t*, size_t len, bool last) override
+    {
+        log += "b" + String(len) + (last ? "! " : " ");
+    }
+    void onArray(size_t count, bool indefinite) override
+    {
+        log += indefinite ? String("arr* ") : "arr" + String(count) + " ";
+    }
+    void onMap(size_t pairs, bool indefinite) override
+    {
+        log += indefinite ? String("map* ") : "map" + String(pairs) + " ";
+    }
+    void onContainerEnd() override
+    {
+        log += "end ";
+    }
+    void onTag(uint64_t t) override
+    {
+        log += "tag" + String((unsigned long)t) + " ";
+    }
+    void onBool(bool b) override
+    {
+        log += b ? "true " : "false ";
+    }
+    void onNull() override
+    {
+        log += "null ";
+    }
+    void onFloat(double v) override
+    {
+        log += "f" + String(v, 2) + " ";
+    }
+};
+
+TEST_CASE("CborWriter emits shortest-form encodings", "[core][Cbor]")
+{
+    StreamString out;
+    CborWriter w(out);
+    w.value(0).value(23).value(24).value(500).value(-1).value(-500);
+    REQUIRE(hex(out) == "001718181901f4203901f3");
+
+    StreamString out2;
+    CborWriter w2(out2);
+    w2.value(true).value("hi").nullValue().value(1.5f);
+    REQUIRE(hex(out2) == "f5626869f6fa3fc00000");
+}
+
+TEST_CASE("CBOR definite containers round-trip", "[core][Cbor]")
+{
+    StreamString buf;
+    buf.setTimeout(0);
+    CborWriter w(buf);
+    w.beginMap(3)
+        .property(F("up"), 123)
+        .key("tags")
+        .beginArray(3)
+        .value(1)
+        .value(-2)
+        .value("x")
+        .property(F("ok"), true);
+    REQUIRE(w.ok());
+
+    LogVisitor v;
+    CborReader r(buf, v);
+    REQUIRE(r.parse());
+    REQUIRE(v.log == "map3 t'up'! u123 t'tags'! arr3 u1 i-2 t'x'! end t'ok'! true end ");
+}
+
+TEST_CASE("CBOR indefinite containers and tags round-trip", "[core][Cbor]")
+{
+    StreamString buf;
+    buf.setTimeout(0);
+    CborWriter w(buf);
+    w.beginArrayIndefinite()
+        .tag(1)
+        .value(1700000000)
+        .beginMapIndefinite()
+        .property("n", 7)
+        .end()
+        .end();
+    REQUIRE(w.ok());
+
+    LogVisitor v;
+    CborReader r(buf, v);
+    REQUIRE(r.parse());
+    REQUIRE(v.log == "arr* tag1 u1700000000 map* t'n'! u7 end end ");
+
+    // end() without an open indefinite container clears ok()
+    StreamString dummy;
+    CborWriter bad(dummy);
+    bad.end();
+    REQUIRE(!bad.ok());
+}
+
+TEST_CASE("CborReader rejects malformed input", "[core][Cbor]")
+{
+    // truncated: map of 2 pairs with a single item
+    {
+        StreamString buf;
+        buf.setTimeout(0);
+        buf.write((uint8_t)0xa2);
+        buf.write((uint8_t)0x01);
+        LogVisitor v;
+        CborReader r(buf, v);
+        REQUIRE(!r.parse());
+    }
+
+    // stray break byte
+    {
+        StreamString buf;
+        buf.setTimeout(0);
+        buf.write((uint8_t)0xff);
+        LogVisitor v;
+        CborReader r(buf, v);
+        REQUIRE(!r.parse());
+    }
+
+    // nesting past MaxDepth
+    {
+        StreamString buf;
+        buf.setTimeout(0);
+        for (int i = 0; i < CborReader::MaxDepth + 1; i++)
+        {
+            buf.write((uint8_t)0x81);  // array(1)
+        }
+        buf.write((uint8_t)0x00);
+        LogVisitor v;
+        CborReader r(buf, v);
+        REQUIRE(!r.parse());
+    }
+}
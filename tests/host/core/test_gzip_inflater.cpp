@@ -0,0 +1,221 @@
+/*
+ test_gzip_inflater.cpp - streaming gzip/deflate decoder tests
+
+ Copyright © 2026 esp8266/Arduino community.  All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to
+ deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <GzipInflater.h>
+#include <StreamString.h>
+
+#include <algorithm>
+
+// reference blobs generated with python3 zlib (level 9)
+
+// gzip of "hello world\n"
+static const uint8_t smallGz[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xcb, 0x48,
+    0xcd, 0xc9, 0xc9, 0x57, 0x28, 0xcf, 0x2f, 0xca, 0x49, 0xe1, 0x02, 0x00,
+    0x2d, 0x3b, 0x08, 0xaf, 0x0c, 0x00, 0x00, 0x00,
+};
+
+// zlib-wrapped deflate of "hello world\n"
+static const uint8_t smallZlib[] = {
+    0x78, 0xda, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57, 0x28, 0xcf, 0x2f, 0xca,
+    0x49, 0xe1, 0x02, 0x00, 0x1e, 0x72, 0x04, 0x67,
+};
+
+// raw deflate of "hello world\n"
+static const uint8_t smallRaw[] = {
+    0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57, 0x28, 0xcf, 0x2f, 0xca, 0x49, 0xe1,
+    0x02, 0x00,
+};
+
+// gzip of bigBody() (13890 bytes), compressed with a 512-byte window
+// (zlib wbits=9) so it decodes within a matching small inflater window
+static const uint8_t bigGz[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x85, 0xcf,
+    0xbd, 0xad, 0x14, 0x06, 0x10, 0x85, 0xd1, 0x1c, 0xc9, 0x3d, 0x50, 0x01,
+    0x3b, 0x77, 0xfe, 0xa7, 0x00, 0xf4, 0x1c, 0x3a, 0x78, 0x0d, 0x20, 0x8b,
+    0xc0, 0x91, 0x11, 0xc8, 0xae, 0x9f, 0x8c, 0x25, 0x58, 0xe9, 0xcb, 0x4f,
+    0x72, 0xde, 0x3e, 0xbf, 0x7f, 0x7c, 0x7c, 0xf9, 0xf6, 0xcf, 0xe3, 0x7f,
+    0x7b, 0x7c, 0xff, 0xfa, 0xe3, 0xdf, 0xff, 0xbe, 0xff, 0xfd, 0xf5, 0x61,
+    0x1f, 0xff, 0x7c, 0x7f, 0xff, 0xeb, 0xa1, 0x4f, 0xfa, 0xe3, 0xc3, 0xdb,
+    0x2f, 0xa0, 0x27, 0xd0, 0x4b, 0xe0, 0x4f, 0xe0, 0x2f, 0x41, 0x3c, 0x41,
+    0xbc, 0x04, 0xf9, 0x04, 0xf9, 0x12, 0xd4, 0x13, 0xd4, 0x4b, 0xd0, 0x4f,
+    0xd0, 0x2f, 0xc1, 0x6f, 0xcd, 0xa1, 0xe6, 0x52, 0xf3, 0xa8, 0x29, 0xa3,
+    0xa7, 0x44, 0x51, 0x39, 0x4d, 0x15, 0x54, 0x55, 0xd2, 0x55, 0x45, 0x59,
+    0x35, 0x6e, 0x07, 0xb7, 0x8b, 0xdb, 0xa3, 0xad, 0x1b, 0x6d, 0x5d, 0xb4,
+    0x75, 0xa7, 0xad, 0x07, 0x6d, 0x3d, 0x69, 0xeb, 0x45, 0x5b, 0x6f, 0xdc,
+    0x0e, 0x6e, 0x17, 0xb7, 0x47, 0xdb, 0x30, 0xda, 0x86, 0x68, 0x1b, 0x4e,
+    0xdb, 0x08, 0xda, 0x46, 0xd2, 0x36, 0x8a, 0xb6, 0xd1, 0xb8, 0x1d, 0xdc,
+    0x2e, 0x6e, 0x8f, 0xb6, 0x69, 0xb4, 0x4d, 0xd1, 0x36, 0x9d, 0xb6, 0x19,
+    0xb4, 0xcd, 0xa4, 0x6d, 0x16, 0x6d, 0xb3, 0x71, 0x3b, 0xb8, 0x5d, 0xdc,
+    0x1e, 0x6d, 0xcb, 0x68, 0x5b, 0xa2, 0x6d, 0x39, 0x6d, 0x2b, 0x68, 0x5b,
+    0x49, 0xdb, 0x2a, 0xda, 0x56, 0xe3, 0x76, 0x70, 0xbb, 0xb8, 0x3d, 0xda,
+    0xb6, 0xd1, 0xb6, 0x45, 0xdb, 0x76, 0xda, 0x76, 0xd0, 0xb6, 0x93, 0xb6,
+    0x5d, 0xb4, 0xed, 0xc6, 0xed, 0xe0, 0x76, 0x71, 0x7b, 0xb4, 0x1d, 0xa3,
+    0xed, 0x88, 0xb6, 0xe3, 0xb4, 0x9d, 0xa0, 0xed, 0x24, 0x6d, 0xa7, 0x68,
+    0x3b, 0x8d, 0xdb, 0xc1, 0xed, 0xe2, 0xf6, 0x68, 0xbb, 0x46, 0xdb, 0x15,
+    0x6d, 0xd7, 0x69, 0xbb, 0x41, 0xdb, 0x4d, 0xda, 0x6e, 0xd1, 0x76, 0x1b,
+    0xb7, 0x83, 0xdb, 0xc5, 0xed, 0xd1, 0xf6, 0x8c, 0xb6, 0x27, 0xda, 0x9e,
+    0xd3, 0xf6, 0x82, 0xb6, 0x97, 0xb4, 0xbd, 0xa2, 0xed, 0x35, 0x6e, 0x07,
+    0xb7, 0x8b, 0xdb, 0xa3, 0xad, 0xcc, 0xa8, 0x2b, 0x13, 0x7d, 0x65, 0x4e,
+    0x61, 0x59, 0xd0, 0x58, 0x96, 0x54, 0x96, 0x15, 0x9d, 0x65, 0xcd, 0xe9,
+    0xe1, 0xf4, 0x72, 0xfa, 0x30, 0x2d, 0xc3, 0xb4, 0x84, 0x69, 0x39, 0xa6,
+    0x15, 0x98, 0x56, 0x62, 0x5a, 0x85, 0x69, 0x35, 0xa7, 0x87, 0xd3, 0xcb,
+    0xe9, 0xc3, 0xb4, 0x1b, 0xa6, 0x5d, 0x98, 0x76, 0xc7, 0xb4, 0x07, 0xa6,
+    0x3d, 0x31, 0xed, 0x85, 0x69, 0x6f, 0x4e, 0x0f, 0xa7, 0x97, 0xd3, 0x87,
+    0xe9, 0x30, 0x4c, 0x87, 0x30, 0x1d, 0x8e, 0xe9, 0x08, 0x4c, 0x47, 0x62,
+    0x3a, 0x0a, 0xd3, 0xd1, 0x9c, 0x1e, 0x4e, 0x2f, 0xa7, 0x0f, 0xd3, 0x69,
+    0x98, 0x4e, 0x61, 0x3a, 0x1d, 0xd3, 0x19, 0x98, 0xce, 0xc4, 0x74, 0x16,
+    0xa6, 0xb3, 0x39, 0x3d, 0x9c, 0x5e, 0x4e, 0x1f, 0xa6, 0xcb, 0x30, 0x5d,
+    0xc2, 0x74, 0x39, 0xa6, 0x2b, 0x30, 0x5d, 0x89, 0xe9, 0x2a, 0x4c, 0x57,
+    0x73, 0x7a, 0x38, 0xbd, 0x9c, 0x3e, 0x4c, 0xb7, 0x61, 0xba, 0x85, 0xe9,
+    0x76, 0x4c, 0x77, 0x60, 0xba, 0x13, 0xd3, 0x5d, 0x98, 0xee, 0xe6, 0xf4,
+    0x70, 0x7a, 0x39, 0x7d, 0x98, 0x1e, 0xc3, 0xf4, 0x08, 0xd3, 0xe3, 0x98,
+    0x9e, 0xc0, 0xf4, 0x24, 0xa6, 0xa7, 0x30, 0x3d, 0xcd, 0xe9, 0xe1, 0xf4,
+    0x72, 0xfa, 0x30, 0xbd, 0x86, 0xe9, 0x15, 0xa6, 0xd7, 0x31, 0xbd, 0x81,
+    0xe9, 0x4d, 0x4c, 0x6f, 0x61, 0x7a, 0x9b, 0xd3, 0xc3, 0xe9, 0xe5, 0xf4,
+    0x61, 0xfa, 0x0c, 0xd3, 0x27, 0x4c, 0x9f, 0x63, 0xfa, 0x02, 0xd3, 0x97,
+    0x98, 0xbe, 0xc2, 0xf4, 0x35, 0xa7, 0x87, 0xd3, 0xcb, 0xe9, 0xa3, 0xb4,
+    0x9b, 0x51, 0xda, 0x4d, 0x94, 0x76, 0x73, 0x4a, 0xbb, 0x05, 0xa5, 0xdd,
+    0x92, 0xd2, 0x6e, 0x45, 0x69, 0xb7, 0xe6, 0xf4, 0x70, 0x7a, 0x39, 0x7d,
+    0x98, 0x96, 0x61, 0x5a, 0xc2, 0xb4, 0x1c, 0xd3, 0x0a, 0x4c, 0x2b, 0x31,
+    0xad, 0xc2, 0xb4, 0x9a, 0xd3, 0xc3, 0xe9, 0xe5, 0xf4, 0x61, 0xda, 0x0d,
+    0xd3, 0x2e, 0x4c, 0xbb, 0x63, 0xda, 0x03, 0xd3, 0x9e, 0x98, 0xf6, 0xc2,
+    0xb4, 0x37, 0xa7, 0x87, 0xd3, 0xcb, 0xe9, 0xc3, 0x74, 0x18, 0xa6, 0x43,
+    0x98, 0x0e, 0xc7, 0x74, 0x04, 0xa6, 0x23, 0x31, 0x1d, 0x85, 0xe9, 0x68,
+    0x4e, 0x0f, 0xa7, 0x97, 0xd3, 0x87, 0xe9, 0x34, 0x4c, 0xa7, 0x30, 0x9d,
+    0x8e, 0xe9, 0x0c, 0x4c, 0x67, 0x62, 0x3a, 0x0b, 0xd3, 0xd9, 0x9c, 0x1e,
+    0x4e, 0x2f, 0xa7, 0x0f, 0xd3, 0x65, 0x98, 0x2e, 0x61, 0xba, 0x1c, 0xd3,
+    0x15, 0x98, 0xae, 0xc4, 0x74, 0x15, 0xa6, 0xab, 0x39, 0x3d, 0x9c, 0x5e,
+    0x4e, 0x1f, 0xa6, 0xdb, 0x30, 0xdd, 0xc2, 0x74, 0x3b, 0xa6, 0x3b, 0x30,
+    0xdd, 0x89, 0xe9, 0x2e, 0x4c, 0x77, 0x73, 0x7a, 0x38, 0xbd, 0x9c, 0x3e,
+    0x4c, 0x8f, 0x61, 0x7a, 0x84, 0xe9, 0x71, 0x4c, 0x4f, 0x60, 0x7a, 0x12,
+    0xd3, 0x53, 0x98, 0x9e, 0xe6, 0xf4, 0x70, 0x7a, 0x39, 0x7d, 0x98, 0x5e,
+    0xc3, 0xf4, 0x0a, 0xd3, 0xeb, 0x98, 0xde, 0xc0, 0xf4, 0x26, 0xa6, 0xb7,
+    0x30, 0xbd, 0xcd, 0xe9, 0xe1, 0xf4, 0x72, 0xfa, 0x30, 0x7d, 0x86, 0xe9,
+    0x13, 0xa6, 0xcf, 0x31, 0x7d, 0x81, 0xe9, 0x4b, 0x4c, 0x5f, 0x61, 0xfa,
+    0x9a, 0xd3, 0xc3, 0xe9, 0xe5, 0xf4, 0x51, 0x3a, 0xcc, 0x28, 0x1d, 0x26,
+    0x4a, 0x87, 0x39, 0xa5, 0xc3, 0x82, 0xd2, 0x61, 0x49, 0xe9, 0xb0, 0xa2,
+    0x74, 0x58, 0x73, 0x7a, 0x38, 0xbd, 0x9c, 0x3e, 0x4c, 0xcb, 0x30, 0x2d,
+    0x61, 0x5a, 0x8e, 0x69, 0x05, 0xa6, 0x95, 0x98, 0x56, 0x61, 0x5a, 0xcd,
+    0xe9, 0xe1, 0xf4, 0x72, 0xfa, 0x30, 0xed, 0x86, 0x69, 0x17, 0xa6, 0xdd,
+    0x31, 0xed, 0x81, 0x69, 0x4f, 0x4c, 0x7b, 0x61, 0xda, 0x9b, 0xd3, 0xc3,
+    0xe9, 0xe5, 0xf4, 0x61, 0x3a, 0x0c, 0xd3, 0x21, 0x4c, 0x87, 0x63, 0x3a,
+    0x02, 0xd3, 0x91, 0x98, 0x8e, 0xc2, 0x74, 0x34, 0xa7, 0x87, 0xd3, 0xcb,
+    0xe9, 0xc3, 0x74, 0x1a, 0xa6, 0x53, 0x98, 0x4e, 0xc7, 0x74, 0x06, 0xa6,
+    0x33, 0x31, 0x9d, 0x85, 0xe9, 0x6c, 0x4e, 0x0f, 0xa7, 0x97, 0xd3, 0x87,
+    0xe9, 0x32, 0x4c, 0x97, 0x30, 0x5d, 0x8e, 0xe9, 0x0a, 0x4c, 0x57, 0x62,
+    0xba, 0x0a, 0xd3, 0xd5, 0x9c, 0x1e, 0x4e, 0x2f, 0xa7, 0x0f, 0xd3, 0x6d,
+    0x98, 0x6e, 0x61, 0xba, 0x1d, 0xd3, 0x1d, 0x98, 0xee, 0xc4, 0x74, 0x17,
+    0xa6, 0xbb, 0x39, 0x3d, 0x9c, 0x5e, 0x4e, 0x1f, 0xa6, 0xc7, 0x30, 0x3d,
+    0xc2, 0xf4, 0x38, 0xa6, 0x27, 0x30, 0x3d, 0x89, 0xe9, 0x29, 0x4c, 0x4f,
+    0x73, 0x7a, 0x38, 0xbd, 0x9c, 0x3e, 0x4c, 0xaf, 0x61, 0x7a, 0x85, 0xe9,
+    0x75, 0x4c, 0x6f, 0x60, 0x7a, 0x13, 0xd3, 0x5b, 0x98, 0xde, 0xe6, 0xf4,
+    0x70, 0x7a, 0x39, 0x7d, 0x98, 0x3e, 0xc3, 0xf4, 0x09, 0xd3, 0xe7, 0x98,
+    0xbe, 0xc0, 0xf4, 0x25, 0xa6, 0xaf, 0x30, 0x7d, 0xcd, 0xe9, 0xe1, 0xf4,
+    0x72, 0xfa, 0x7e, 0x23, 0x3f, 0x01, 0x68, 0xc7, 0x3a, 0xcd, 0x42, 0x36,
+    0x00, 0x00,
+};
+
+// a memory-backed source handing out at most 'granularity' bytes per call
+static GzipInflater::Source memSource(const uint8_t* data, size_t len, size_t& pos, size_t granularity = 64)
+{
+    return [data, len, &pos, granularity](uint8_t* buf, size_t want) -> int {
+        if (pos >= len)
+            return 0;
+        size_t n = std::min({ want, granularity, len - pos });
+        memcpy(buf, data + pos, n);
+        pos += n;
+        return (int)n;
+    };
+}
+
+static String bigBody()
+{
+    String body;
+    body.reserve(14000);
+    for (int i = 0; i < 400; i++)
+    {
+        char line[48];
+        snprintf(line, sizeof(line), "GET /api/v%d/resource/%d HTTP/1.1\r\n", i % 7, i);
+        body += line;
+    }
+    return body;
+}
+
+TEST_CASE("gzip stream decodes and verifies its trailer", "[core][GzipInflater]")
+{
+    size_t pos = 0;
+    GzipInflater inf(memSource(smallGz, sizeof(smallGz), pos));
+    REQUIRE(inf.valid());
+
+    StreamString out;
+    REQUIRE(inf.inflate(out) == 12);
+    REQUIRE(out == "hello world\n");
+}
+
+TEST_CASE("back-references work across a small wrapped window", "[core][GzipInflater]")
+{
+    String expect = bigBody();
+
+    // byte-at-a-time source, 512-byte window matching the encoder
+    size_t pos = 0;
+    GzipInflater inf(memSource(bigGz, sizeof(bigGz), pos, 1), 9);
+    REQUIRE(inf.valid());
+
+    StreamString out;
+    REQUIRE(inf.inflate(out) == (int)expect.length());
+    REQUIRE(out == expect);
+}
+
+TEST_CASE("deflate accepts zlib-wrapped and raw streams", "[core][GzipInflater]")
+{
+    size_t pos = 0;
+    GzipInflater zl(memSource(smallZlib, sizeof(smallZlib), pos));
+    StreamString out;
+    REQUIRE(zl.inflate(out, GzipInflater::FORMAT_DEFLATE) == 12);
+    REQUIRE(out == "hello world\n");
+
+    size_t rawPos = 0;
+    GzipInflater raw(memSource(smallRaw, sizeof(smallRaw), rawPos));
+    StreamString rawOut;
+    REQUIRE(raw.inflate(rawOut, GzipInflater::FORMAT_DEFLATE) == 12);
+    REQUIRE(rawOut == "hello world\n");
+}
+
+TEST_CASE("corrupt input is rejected", "[core][GzipInflater]")
+{
+    StreamString out;
+
+    // flipped CRC byte in the trailer
+    uint8_t badCrc[sizeof(smallGz)];
+    memcpy(badCrc, smallGz, sizeof(smallGz));
+    badCrc[sizeof(smallGz) - 6] ^= 0xff;
+    size_t pos = 0;
+    GzipInflater crc(memSource(badCrc, sizeof(badCrc), pos));
+    REQUIRE(crc.inflate(out) == GzipInflater::ERR_CHECKSUM);
+
+    // truncated mid-stream
+    size_t shortPos = 0;
+    GzipInflater trunc(memSource(smallGz, sizeof(smallGz) / 2, shortPos));
+    REQUIRE(trunc.inflate(out) == GzipInflater::ERR_INPUT);
+
+    // not gzip at all
+    static const uint8_t junk[] = { 'h', 't', 'm', 'l', '>' };
+    size_t junkPos = 0;
+    GzipInflater bad(memSource(junk, sizeof(junk), junkPos));
+    REQUIRE(bad.inflate(out) == GzipInflater::ERR_FORMAT);
+}
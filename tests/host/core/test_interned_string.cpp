@@ -0,0 +1,58 @@
+/*
+ test_interned_string.cpp - string interning pool tests
+
+ Copyright © 2026 esp8266/Arduino community.  All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to
+ deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <InternedString.h>
+
+TEST_CASE("interning deduplicates by content", "[core][InternedString]")
+{
+    size_t before = InternedString::count();
+
+    InternedString a = InternedString::get("sensors/kitchen/temp");
+    InternedString b = InternedString::get("sensors/kitchen/temp");
+    InternedString c = InternedString::get("sensors/kitchen/humidity");
+
+    REQUIRE(a == b);
+    REQUIRE(a.c_str() == b.c_str());
+    REQUIRE(a != c);
+    REQUIRE(InternedString::count() == before + 2);
+
+    // a third request for known content adds nothing
+    InternedString::get("sensors/kitchen/humidity");
+    REQUIRE(InternedString::count() == before + 2);
+}
+
+TEST_CASE("flash and String requests share pool entries", "[core][InternedString]")
+{
+    InternedString flash = InternedString::get(F("mqtt/status/online"));
+    InternedString ram = InternedString::get(String("mqtt/status/online"));
+
+    REQUIRE(flash == ram);
+    REQUIRE(flash.equals("mqtt/status/online"));
+    REQUIRE_FALSE(flash.equals("mqtt/status/offline"));
+}
+
+TEST_CASE("handles convert for String usage", "[core][InternedString]")
+{
+    InternedString topic = InternedString::get("device/42/state");
+
+    String composed = String("publish:") + topic;
+    REQUIRE(composed == "publish:device/42/state");
+
+    InternedString unset;
+    REQUIRE_FALSE(static_cast<bool>(unset));
+    REQUIRE(String(unset).length() == 0);
+}
@@ -0,0 +1,101 @@
+/*
+ test_json_writer.cpp - streaming JSON emitter tests
+ Copyright © 2026 esp8266/Arduino community
+ This file is part of the esp8266 core for Arduino environment.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <StreamString.h>
+#include <JsonWriter.h>
+
+TEST_CASE("JsonWriter flat object", "[core][JsonWriter]")
+{
+    StreamString out;
+    JsonWriter json(out);
+    json.beginObject()
+        .property("str", "hi")
+        .property("num", 42)
+        .property("neg", -7L)
+        .property("on", true)
+        .name("none")
+        .nullValue()
+        .endObject();
+    REQUIRE(json.ok());
+    REQUIRE(json.depth() == 0);
+    REQUIRE(out == "{\"str\":\"hi\",\"num\":42,\"neg\":-7,\"on\":true,\"none\":null}");
+}
+
+TEST_CASE("JsonWriter nesting and arrays", "[core][JsonWriter]")
+{
+    StreamString out;
+    JsonWriter json(out);
+    json.beginObject().name("list").beginArray();
+    for (int i = 1; i <= 3; i++)
+    {
+        json.value(i);
+    }
+    json.endArray().name("obj").beginObject().property("k", "v");
+    json.close();  // closes obj and the root
+    REQUIRE(json.ok());
+    REQUIRE(out == "{\"list\":[1,2,3],\"obj\":{\"k\":\"v\"}}");
+}
+
+TEST_CASE("JsonWriter string escaping", "[core][JsonWriter]")
+{
+    StreamString out;
+    JsonWriter json(out);
+    json.beginArray().value("a\"b\\c\n\t").value(String("\x01")).endArray();
+    REQUIRE(json.ok());
+    REQUIRE(out == "[\"a\\\"b\\\\c\\n\\t\",\"\\u0001\"]");
+}
+
+TEST_CASE("JsonWriter numbers", "[core][JsonWriter]")
+{
+    StreamString out;
+    JsonWriter json(out, 3);
+    json.beginArray()
+        .value(2.5)
+        .value(0.0 / 0.0)               // NaN -> null
+        .value(4294967295UL)
+        .value(1234567890123456789LL)
+        .endArray();
+    REQUIRE(json.ok());
+    REQUIRE(out == "[2.500,null,4294967295,1234567890123456789]");
+}
+
+TEST_CASE("JsonWriter misuse is detected", "[core][JsonWriter]")
+{
+    StreamString out;
+    JsonWriter json(out);
+    json.beginObject().value(1);  // value without name()
+    REQUIRE_FALSE(json.ok());
+
+    StreamString out2;
+    JsonWriter json2(out2);
+    json2.beginArray().endObject();  // wrong terminator
+    REQUIRE_FALSE(json2.ok());
+
+    StreamString out3;
+    JsonWriter json3(out3);
+    json3.beginArray().name("x");  // name inside an array
+    REQUIRE_FALSE(json3.ok());
+}
+
+TEST_CASE("JsonWriter flash strings", "[core][JsonWriter]")
+{
+    StreamString out;
+    JsonWriter json(out);
+    json.beginObject().property(F("key"), F("val\"ue")).endObject();
+    REQUIRE(json.ok());
+    REQUIRE(out == "{\"key\":\"val\\\"ue\"}");
+}
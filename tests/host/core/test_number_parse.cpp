@@ -0,0 +1,210 @@
+/*
+ test_number_parse.cpp - tests for the numfmt_parse_* family
+
+ Copyright © 2026 esp8266/Arduino community.  All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to
+ deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <NumberFormat.h>
+#include <WString.h>
+
+#include <cmath>
+#include <cstring>
+
+// convenience: parse a whole C string
+template<typename Fn, typename T>
+static numfmt_parse_result parse(Fn fn, const char* s, T& out, unsigned base = 10)
+{
+    return fn(s, s + strlen(s), out, base);
+}
+
+TEST_CASE("numfmt_parse_u32 basics", "[core][NumberFormat]")
+{
+    uint32_t v = 42;
+
+    auto res = parse(numfmt_parse_u32, "0", v);
+    REQUIRE(res.ok);
+    REQUIRE(v == 0);
+
+    res = parse(numfmt_parse_u32, "4294967295", v);
+    REQUIRE(res.ok);
+    REQUIRE(v == 4294967295u);
+
+    // partial consume: ptr lands on the first non-digit
+    const char* s = "123abc";
+    res = numfmt_parse_u32(s, s + 6, v);
+    REQUIRE(res.ok);
+    REQUIRE(v == 123);
+    REQUIRE(res.ptr == s + 3);
+
+    // no digits: out untouched, nothing consumed
+    v = 7;
+    res = parse(numfmt_parse_u32, "abc", v);
+    REQUIRE(!res.ok);
+    REQUIRE(v == 7);
+    res = parse(numfmt_parse_u32, "", v);
+    REQUIRE(!res.ok);
+
+    // unsigned means unsigned: a sign is not a digit
+    res = parse(numfmt_parse_u32, "-1", v);
+    REQUIRE(!res.ok);
+    REQUIRE(v == 7);
+}
+
+TEST_CASE("numfmt_parse_u32 range and bases", "[core][NumberFormat]")
+{
+    uint32_t v = 7;
+
+    // out of range: digits are consumed but out stays untouched, so the
+    // caller can tell "garbage" from "too big"
+    const char* s = "4294967296";
+    auto res = numfmt_parse_u32(s, s + strlen(s), v);
+    REQUIRE(!res.ok);
+    REQUIRE(v == 7);
+    REQUIRE(res.ptr == s + strlen(s));
+
+    res = parse(numfmt_parse_u32, "ff", v, 16);
+    REQUIRE(res.ok);
+    REQUIRE(v == 0xff);
+    res = parse(numfmt_parse_u32, "DEADbeef", v, 16);
+    REQUIRE(res.ok);
+    REQUIRE(v == 0xdeadbeef);
+    res = parse(numfmt_parse_u32, "101", v, 2);
+    REQUIRE(res.ok);
+    REQUIRE(v == 5);
+    // digit not valid in the base stops the parse
+    res = parse(numfmt_parse_u32, "129", v, 8);
+    REQUIRE(res.ok);
+    REQUIRE(v == 012);
+}
+
+TEST_CASE("numfmt_parse_i32 signs and limits", "[core][NumberFormat]")
+{
+    int32_t v = 0;
+
+    auto res = parse(numfmt_parse_i32, "-123", v);
+    REQUIRE(res.ok);
+    REQUIRE(v == -123);
+    res = parse(numfmt_parse_i32, "+123", v);
+    REQUIRE(res.ok);
+    REQUIRE(v == 123);
+
+    res = parse(numfmt_parse_i32, "2147483647", v);
+    REQUIRE(res.ok);
+    REQUIRE(v == INT32_MAX);
+    res = parse(numfmt_parse_i32, "-2147483648", v);
+    REQUIRE(res.ok);
+    REQUIRE(v == INT32_MIN);
+
+    // one past either limit is a range error
+    res = parse(numfmt_parse_i32, "2147483648", v);
+    REQUIRE(!res.ok);
+    res = parse(numfmt_parse_i32, "-2147483649", v);
+    REQUIRE(!res.ok);
+
+    // a lone sign is not consumed
+    const char* s = "-x";
+    res = numfmt_parse_i32(s, s + 2, v);
+    REQUIRE(!res.ok);
+    REQUIRE(res.ptr == s);
+}
+
+TEST_CASE("numfmt_parse 64-bit", "[core][NumberFormat]")
+{
+    uint64_t u = 0;
+    auto res = parse(numfmt_parse_u64, "18446744073709551615", u);
+    REQUIRE(res.ok);
+    REQUIRE(u == UINT64_MAX);
+    res = parse(numfmt_parse_u64, "18446744073709551616", u);
+    REQUIRE(!res.ok);
+
+    int64_t i = 0;
+    res = parse(numfmt_parse_i64, "-9223372036854775808", i);
+    REQUIRE(res.ok);
+    REQUIRE(i == INT64_MIN);
+}
+
+static double parse_double(const char* s, bool* okOut = nullptr)
+{
+    double v = NAN;
+    numfmt_parse_result res = numfmt_parse_double(s, s + strlen(s), v);
+    if (okOut)
+    {
+        *okOut = res.ok;
+    }
+    return v;
+}
+
+TEST_CASE("numfmt_parse_double formats", "[core][NumberFormat]")
+{
+    REQUIRE(parse_double("0") == 0.0);
+    REQUIRE(parse_double("3.5") == 3.5);
+    REQUIRE(parse_double("-0.25") == -0.25);
+    REQUIRE(parse_double(".5") == 0.5);
+    REQUIRE(parse_double("2.") == 2.0);
+    REQUIRE(parse_double("1e3") == 1000.0);
+    REQUIRE(parse_double("1E-2") == 0.01);
+    REQUIRE(parse_double("-1.5e2") == -150.0);
+    REQUIRE(parse_double("3.14159") == Approx(3.14159));
+    // long mantissas keep their magnitude even past integer precision
+    REQUIRE(parse_double("123456789012345678901234") == Approx(1.23456789012345678901234e23));
+
+    bool ok;
+    parse_double("", &ok);
+    REQUIRE(!ok);
+    parse_double(".", &ok);
+    REQUIRE(!ok);
+    parse_double("-", &ok);
+    REQUIRE(!ok);
+    parse_double("e5", &ok);
+    REQUIRE(!ok);
+
+    // a dangling exponent marker is left unconsumed
+    const char* s = "10elephants";
+    double v = 0;
+    auto res = numfmt_parse_double(s, s + strlen(s), v);
+    REQUIRE(res.ok);
+    REQUIRE(v == 10.0);
+    REQUIRE(res.ptr == s + 2);
+
+    // out of double range
+    parse_double("1e400", &ok);
+    REQUIRE(!ok);
+    // underflow quietly becomes zero
+    REQUIRE(parse_double("1e-400", &ok) == 0.0);
+    REQUIRE(ok);
+}
+
+TEST_CASE("numfmt_parse_float range", "[core][NumberFormat]")
+{
+    float f = 0;
+    const char* s = "1e20";
+    auto res = numfmt_parse_float(s, s + 4, f);
+    REQUIRE(res.ok);
+    REQUIRE(f == Approx(1e20f));
+    // fits a double, not a float
+    s = "1e60";
+    res = numfmt_parse_float(s, s + 4, f);
+    REQUIRE(!res.ok);
+}
+
+TEST_CASE("String conversions ride on numfmt_parse", "[core][NumberFormat]")
+{
+    // atoi-style leniency is preserved: leading whitespace, trailing junk
+    REQUIRE(String("  42abc").toInt() == 42);
+    REQUIRE(String("junk").toInt() == 0);
+    REQUIRE(String(" 2.5volts").toFloat() == 2.5f);
+    // out of range saturates instead of being undefined
+    REQUIRE(String("99999999999999999999").toInt() == std::numeric_limits<long>::max());
+    REQUIRE(String("-99999999999999999999").toInt() == std::numeric_limits<long>::min());
+}
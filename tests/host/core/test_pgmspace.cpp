@@ -54,3 +54,44 @@ TEST_CASE("strstr_P works as strstr", "[core][pgmspace]")
     t("_foo_foo", "foo");
     t("A", "a");
 }
+
+TEST_CASE("memcpy_P_fast/memcmp_P_fast/strlen_P_fast work at every alignment", "[core][pgmspace]")
+{
+    // 32-bit aligned backing store with data at every offset
+    alignas(4) static const char source[] = "@The quick brown fox jumps over the lazy dog 0123456789";
+
+    for (size_t srcOffset = 0; srcOffset < 4; ++srcOffset)
+    {
+        const char* src = source + srcOffset;
+        size_t srcLen = strlen(src);
+        REQUIRE(strlen_P_fast(src) == srcLen);
+
+        for (size_t destOffset = 0; destOffset < 4; ++destOffset)
+        {
+            for (size_t count : {size_t(0), size_t(1), size_t(3), size_t(4), size_t(7), size_t(17), srcLen})
+            {
+                char dest[sizeof(source) + 8];
+                memset(dest, '#', sizeof(dest));
+                REQUIRE(memcpy_P_fast(dest + destOffset, src, count) == dest + destOffset);
+                REQUIRE(memcmp(dest + destOffset, src, count) == 0);
+                REQUIRE(dest[destOffset + count] == '#'); // no overrun
+
+                REQUIRE(memcmp_P_fast(dest + destOffset, src, count) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("memcmp_P_fast orders like memcmp", "[core][pgmspace]")
+{
+    alignas(4) static const char a[] = "abcdefghijklmnopqrstuvwxyz";
+    alignas(4) static const char b[] = "abcdefghijklmnopqrstuvwxyy";
+    alignas(4) static const char c[] = "abcdefghijklmnopqrstuvwxz";
+
+    REQUIRE(memcmp_P_fast(a, b, sizeof(a)) > 0);
+    REQUIRE(memcmp_P_fast(b, a, sizeof(a)) < 0);
+    REQUIRE(memcmp_P_fast(a, c, 24) == 0);
+    REQUIRE(memcmp_P_fast(a, c, 25) < 0);
+    // differing byte inside an aligned word, unaligned RAM side
+    REQUIRE(memcmp_P_fast(a + 1, b + 1, sizeof(a) - 1) > 0);
+}
@@ -0,0 +1,106 @@
+/*
+ test_printf.cpp - Print::printf tests
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ */
+
+#include <catch.hpp>
+#include <string.h>
+#include <StreamString.h>
+
+// Compare Print::printf output against the host's own printf
+template<typename... Args>
+static void checkPrintf(const char* format, Args... args)
+{
+    char expected[512];
+    int expectedLength = snprintf(expected, sizeof(expected), format, args...);
+    REQUIRE(expectedLength >= 0);
+    REQUIRE((size_t)expectedLength < sizeof(expected));
+
+    StreamString out;
+    size_t written = out.printf(format, args...);
+    CAPTURE(format);
+    REQUIRE(out == expected);
+    REQUIRE(written == (size_t)expectedLength);
+}
+
+TEST_CASE("Print::printf integer conversions", "[core][Print]")
+{
+    checkPrintf("%d", 0);
+    checkPrintf("%d", 42);
+    checkPrintf("%d", -42);
+    checkPrintf("%i", -2147483647);
+    checkPrintf("%u", 4294967295u);
+    checkPrintf("%x", 0xdeadbeef);
+    checkPrintf("%X", 0xdeadbeef);
+    checkPrintf("%o", 0755);
+    checkPrintf("%ld", -1234567890L);
+    checkPrintf("%lu", 1234567890UL);
+    checkPrintf("%lld", -9223372036854775807LL);
+    checkPrintf("%llu", 18446744073709551615ULL);
+    checkPrintf("%llx", 0x123456789abcdef0ULL);
+    checkPrintf("%zu", (size_t)123456);
+    checkPrintf("%hd", (int)-32768);
+    checkPrintf("%hhu", (int)200);
+}
+
+TEST_CASE("Print::printf flags, width and precision", "[core][Print]")
+{
+    checkPrintf("%8d|", 42);
+    checkPrintf("%-8d|", 42);
+    checkPrintf("%08d|", -42);
+    checkPrintf("%+d %+d", 42, -42);
+    checkPrintf("% d % d", 42, -42);
+    checkPrintf("%08x", 0xbeef);
+    checkPrintf("%.5d", 42);
+    checkPrintf("%8.5d|", -42);
+    checkPrintf("%.0d|%.0d|", 0, 1);
+    checkPrintf("%*d|", 10, 42);
+    checkPrintf("%*d|", -10, 42);
+    checkPrintf("%.*s|", 3, "abcdef");
+    checkPrintf("%10s|", "abc");
+    checkPrintf("%-10s|", "abc");
+    checkPrintf("%5c|", 'x');
+    checkPrintf("%-5c|", 'x');
+}
+
+TEST_CASE("Print::printf strings and chars", "[core][Print]")
+{
+    checkPrintf("plain text, no conversions");
+    checkPrintf("%s", "hello");
+    checkPrintf("%s %s %c%c", "several", "arguments", '!', '?');
+    checkPrintf("100%% done");
+
+    // output much longer than the old 64-byte stack buffer
+    const char* lorem = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+                        "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.";
+    checkPrintf("[%s][%s][%s]", lorem, lorem, lorem);
+}
+
+TEST_CASE("Print::printf pointer conversion", "[core][Print]")
+{
+    int dummy;
+    StreamString out;
+    out.printf("%p", (void*)&dummy);
+    REQUIRE(out.startsWith("0x"));
+    REQUIRE(strtoull(out.c_str() + 2, nullptr, 16) == (unsigned long long)(uintptr_t)&dummy);
+}
+
+TEST_CASE("Print::printf falls back for unsupported conversions", "[core][Print]")
+{
+    checkPrintf("%f", 3.14159);
+    checkPrintf("%.2f volts", -12.5);
+    checkPrintf("%e", 12345.6789);
+    checkPrintf("%g", 0.000123);
+    checkPrintf("%#x %#o", 0xbeef, 0755);
+    // long output through the fallback still works (heap path)
+    checkPrintf("%128.64f|", 1.0 / 3.0);
+}
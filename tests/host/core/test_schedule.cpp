@@ -0,0 +1,113 @@
+/*
+ test_schedule.cpp - scheduling-order tests for Schedule.cpp
+
+ Copyright © 2026 esp8266/Arduino community.  All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to
+ deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <Schedule.h>
+#include <Arduino.h>
+
+// The ordering rules checked here are what the rest of the core leans on
+// (lwIP glue, Ticker, the yield fast path); a silent change shows up on
+// the device as shifted interrupt-to-handler latency, so keep them pinned.
+
+TEST_CASE("one-shot scheduled functions run in FIFO order", "[core][Schedule]")
+{
+    String order;
+    for (char c = 'a'; c <= 'e'; c++)
+    {
+        REQUIRE(schedule_function([&order, c]() { order += c; }));
+    }
+    REQUIRE(scheduled_functions_pending());
+    run_scheduled_functions();
+    REQUIRE(order == "abcde");
+    REQUIRE(!scheduled_functions_pending());
+}
+
+TEST_CASE("functions scheduled during a pass run on the next pass", "[core][Schedule]")
+{
+    String order;
+    schedule_function([&order]() {
+        order += 'A';
+        schedule_function([&order]() { order += 'B'; });
+    });
+    run_scheduled_functions();
+    REQUIRE(order == "A");  // B was queued after the pass snapshot
+    run_scheduled_functions();
+    REQUIRE(order == "AB");
+}
+
+TEST_CASE("one-shot pool exhausts cleanly and recovers", "[core][Schedule]")
+{
+    int ran = 0;
+    for (int i = 0; i < SCHEDULED_FN_MAX_COUNT; i++)
+    {
+        REQUIRE(schedule_function([&ran]() { ran++; }));
+    }
+    // pool is full: the next registration must fail, not block or drop
+    REQUIRE(!schedule_function([&ran]() { ran++; }));
+    run_scheduled_functions();
+    REQUIRE(ran == SCHEDULED_FN_MAX_COUNT);
+    // nodes are recycled, scheduling works again
+    REQUIRE(schedule_function([&ran]() { ran++; }));
+    run_scheduled_functions();
+    REQUIRE(ran == SCHEDULED_FN_MAX_COUNT + 1);
+}
+
+TEST_CASE("recurrent functions drain by priority class, FIFO within a class", "[core][Schedule]")
+{
+    String order;
+    auto once = [&order](char c) {
+        return [&order, c]() {
+            order += c;
+            return false;  // self-cancel after one run
+        };
+    };
+    // registration order deliberately inverts the priority order
+    REQUIRE(schedule_recurrent_function_us(once('l'), 0, nullptr, SCHEDULE_PRIO_LOW));
+    REQUIRE(schedule_recurrent_function_us(once('n'), 0, nullptr, SCHEDULE_PRIO_NORMAL));
+    REQUIRE(schedule_recurrent_function_us(once('m'), 0, nullptr, SCHEDULE_PRIO_NORMAL));
+    REQUIRE(schedule_recurrent_function_us(once('h'), 0, nullptr, SCHEDULE_PRIO_HIGH));
+    run_scheduled_recurrent_functions();
+    REQUIRE(order == "hnml");
+}
+
+TEST_CASE("recurrent interval and alarm semantics", "[core][Schedule]")
+{
+    // interval: not called before repeat_us has elapsed
+    int intervalCalls = 0;
+    REQUIRE(schedule_recurrent_function_us([&intervalCalls]() {
+        intervalCalls++;
+        return false;
+    }, 5000));
+    run_scheduled_recurrent_functions();
+    REQUIRE(intervalCalls == 0);
+
+    // alarm: overrides the remaining delay, polled every pass
+    int alarmCalls = 0;
+    REQUIRE(schedule_recurrent_function_us([&alarmCalls]() {
+        alarmCalls++;
+        return alarmCalls < 2;
+    }, 5000, []() { return true; }));
+    // an armed alarm means "work may be due now" for the sleep governor
+    REQUIRE(compute_scheduled_recurrent_delay_us() == 0);
+    run_scheduled_recurrent_functions();
+    run_scheduled_recurrent_functions();
+    REQUIRE(alarmCalls == 2);
+
+    // let the interval expire so the first function can remove itself
+    delay(6);
+    run_scheduled_recurrent_functions();
+    REQUIRE(intervalCalls == 1);
+}
@@ -0,0 +1,87 @@
+/*
+ test_spsc_ringbuf.cpp - lock-free SPSC ring buffer tests
+ Copyright © 2026 esp8266/Arduino community
+ This file is part of the esp8266 core for Arduino environment.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <spsc_ringbuf.h>
+
+TEST_CASE("spsc_ringbuf sizing and basic push/pop", "[core][spsc_ringbuf]")
+{
+    spsc_ringbuf<uint8_t> rb(100);
+    REQUIRE(rb.valid());
+    REQUIRE(rb.size() == 128); // rounded up to a power of two
+    REQUIRE(rb.empty());
+    REQUIRE(rb.room() == 128);
+
+    REQUIRE(rb.push(42));
+    REQUIRE(rb.available() == 1);
+    uint8_t v = 0;
+    REQUIRE(rb.pop(v));
+    REQUIRE(v == 42);
+    REQUIRE(rb.empty());
+}
+
+TEST_CASE("spsc_ringbuf fills to full capacity and drops newest when full", "[core][spsc_ringbuf]")
+{
+    spsc_ringbuf<uint8_t> rb(4);
+    for (int i = 0; i < 4; i++)
+        REQUIRE(rb.push((uint8_t)i));
+    REQUIRE(rb.full());
+    REQUIRE(!rb.push(99)); // dropped, ring unchanged
+    uint8_t v;
+    for (int i = 0; i < 4; i++)
+    {
+        REQUIRE(rb.pop(v));
+        REQUIRE(v == i);
+    }
+    REQUIRE(!rb.pop(v));
+}
+
+TEST_CASE("spsc_ringbuf peek/consume across the wrap point", "[core][spsc_ringbuf]")
+{
+    spsc_ringbuf<uint8_t> rb(8);
+    uint8_t data[6] = { 0, 1, 2, 3, 4, 5 };
+    REQUIRE(rb.push(data, 6) == 6);
+    uint8_t out[6];
+    REQUIRE(rb.pop(out, 6) == 6);
+
+    // write index is now at 6 of 8: the next 6 bytes wrap
+    REQUIRE(rb.push(data, 6) == 6);
+    size_t contiguous;
+    const uint8_t* p = rb.peek(contiguous);
+    REQUIRE(contiguous == 2); // up to the end of the backing array
+    REQUIRE(p[0] == 0);
+    REQUIRE(p[1] == 1);
+    rb.consume(contiguous);
+    p = rb.peek(contiguous);
+    REQUIRE(contiguous == 4);
+    REQUIRE(p[0] == 2);
+    rb.consume(contiguous);
+    REQUIRE(rb.empty());
+}
+
+TEST_CASE("spsc_ringbuf free-running indices survive many wraps", "[core][spsc_ringbuf]")
+{
+    spsc_ringbuf<uint8_t> rb(16);
+    uint8_t v;
+    for (int i = 0; i < 10000; i++)
+    {
+        REQUIRE(rb.push((uint8_t)(i & 0xff)));
+        REQUIRE(rb.pop(v));
+        REQUIRE(v == (uint8_t)(i & 0xff));
+    }
+    rb.flush();
+    REQUIRE(rb.empty());
+}
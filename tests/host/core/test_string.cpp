@@ -14,7 +14,9 @@
  */
 
 #include <ArduinoCatch.hpp>
+#include <AllocCount.h>
 #include <StreamString.h>
+#include <StringBuilder.h>
 
 #include <string>
 #include <cstring>
@@ -704,3 +706,237 @@ TEST_CASE("String operator =(value) #8430", "[core][String]")
         REQUIRE(str == "123.45");
     }
 }
+
+TEST_CASE("String integer conversion boundaries", "[core][String]")
+{
+    // exercises the two-digit LUT paths (NumberFormat.h)
+    REQUIRE(String(0) == "0");
+    REQUIRE(String(7) == "7");
+    REQUIRE(String(100) == "100");
+    REQUIRE(String((unsigned int)4294967295u) == "4294967295");
+    REQUIRE(String((int)-2147483647 - 1) == "-2147483648");
+    REQUIRE(String((unsigned long long)18446744073709551615ull) == "18446744073709551615");
+    REQUIRE(String((long long)-9223372036854775807ll - 1) == "-9223372036854775808");
+    // non-decimal bases stay on the generic path
+    REQUIRE(String(255, 16) == "ff");
+}
+
+TEST_CASE("dtostrf fixed-point rendering", "[core][String]")
+{
+    // String(double, decimals) routes through dtostrf
+    REQUIRE(String(1.999, 2) == "2.00");   // rounding carries into the integer part
+    REQUIRE(String(0.0, 2) == "0.00");
+    REQUIRE(String(-5.125, 2) == "-5.13"); // round-half-up, exact binary fraction
+    REQUIRE(String(42.0, 0) == "42");
+    REQUIRE(String(123.456, 1) == "123.5");
+    REQUIRE(String(1234567890.25, 2) == "1234567890.25");
+    // fraction digits past double precision are zero-padded
+    REQUIRE(String(0.5, 20) == "0.50000000000000000000");
+    // huge values still render all integer digits
+    REQUIRE(String(1e20, 0).length() == 21);
+}
+
+TEST_CASE("String::reserveExact", "[core][String]")
+{
+    String str;
+    REQUIRE(str.reserveExact(100));
+    const char* addr = str.c_str();
+    // an exact reservation must be usable up to the requested size
+    // without triggering another reallocation
+    for (int i = 0; i < 100; i++) {
+        str += 'x';
+    }
+    REQUIRE(str.length() == 100);
+    REQUIRE(str.c_str() == addr);
+
+    // behaves like reserve() for SSO-sized requests
+    String small;
+    REQUIRE(small.reserveExact(4));
+    small += "abcd";
+    REQUIRE(small == "abcd");
+}
+
+TEST_CASE("StringBuilder accumulates and materializes once", "[core][StringBuilder]")
+{
+    StringBuilder builder(16);
+    for (int i = 0; i < 10; i++) {
+        builder.print("fragment-");
+        builder.print(i);
+        builder.print(';');
+    }
+    REQUIRE(builder.length() == 110);
+
+    String flat = builder.toString();
+    REQUIRE(flat.length() == builder.length());
+    REQUIRE(flat.startsWith("fragment-0;fragment-1;"));
+    REQUIRE(flat.endsWith("fragment-9;"));
+
+    // printTo() streams the same bytes without flattening
+    StreamString sink;
+    REQUIRE(builder.printTo(sink) == builder.length());
+    REQUIRE(sink == flat);
+
+    builder.clear();
+    REQUIRE(builder.length() == 0);
+    REQUIRE(builder.toString() == "");
+}
+
+TEST_CASE("Print::fill emits block-wise padding", "[core][Print]")
+{
+    StreamString s;
+    REQUIRE(s.fill(' ', 0) == 0);
+    REQUIRE(s.length() == 0);
+
+    REQUIRE(s.fill('-', 5) == 5);
+    REQUIRE(s == "-----");
+
+    // crosses the internal staging buffer several times
+    StreamString t;
+    REQUIRE(t.fill('x', 150) == 150);
+    REQUIRE(t.length() == 150);
+    for (unsigned i = 0; i < t.length(); i++)
+        REQUIRE(t[i] == 'x');
+}
+
+TEST_CASE("FixedStreamString stream contract over caller storage", "[core][StreamString]")
+{
+    char storage[8];
+    FixedStreamString fss(storage, sizeof(storage));
+
+    REQUIRE(fss.availableForWrite() == 7);
+    REQUIRE(fss.write((const uint8_t*)"abcde", 5) == 5);
+    REQUIRE(fss.length() == 5);
+    REQUIRE(strcmp(fss.c_str(), "abcde") == 0);
+
+    // short write when full, never past the caller's buffer
+    REQUIRE(fss.write((const uint8_t*)"fghij", 5) == 2);
+    REQUIRE(fss.length() == 7);
+    REQUIRE(strcmp(fss.c_str(), "abcdefg") == 0);
+    REQUIRE(fss.write('x') == 0);
+
+    // consuming reads
+    REQUIRE(fss.read() == 'a');
+    uint8_t buf[4];
+    REQUIRE(fss.read(buf, 4) == 4);
+    REQUIRE(memcmp(buf, "bcde", 4) == 0);
+    REQUIRE(fss.available() == 2);
+    REQUIRE(strcmp(fss.c_str(), "fg") == 0);
+
+    // freed room is writable again
+    REQUIRE(fss.write('h') == 1);
+    REQUIRE(fss.peek() == 'f');
+
+    // peek-pointer mode rereads without consuming
+    fss.resetPointer();
+    REQUIRE(fss.read() == 'f');
+    REQUIRE(fss.read() == 'g');
+    REQUIRE(fss.length() == 3);
+    fss.resetPointer();
+    REQUIRE(fss.peekAvailable() == 3);
+    REQUIRE(fss.peekBuffer()[0] == 'f');
+    fss.peekConsume(2);
+    REQUIRE(fss.read() == 'h');
+    REQUIRE(fss.read() == -1);
+
+    fss.setConsume();
+    fss.clear();
+    REQUIRE(fss.length() == 0);
+    REQUIRE(fss.availableForWrite() == 7);
+}
+
+namespace
+{
+// Regular Stream source without the peek-buffer API, to exercise the
+// block staging in Stream::SendGenericRegular()
+class BytewiseSource: public Stream
+{
+public:
+    BytewiseSource(const String& data): data(data) { }
+    int available() override
+    {
+        return data.length() - pos;
+    }
+    int read() override
+    {
+        return pos < data.length() ? data[pos++] : -1;
+    }
+    int peek() override
+    {
+        return pos < data.length() ? data[pos] : -1;
+    }
+    size_t write(uint8_t) override
+    {
+        return 0;
+    }
+    bool inputCanTimeout() override
+    {
+        return false;
+    }
+
+private:
+    const String& data;
+    unsigned pos = 0;
+};
+} // namespace
+
+TEST_CASE("sendGeneric stages bulk transfers in negotiated blocks", "[core][Stream]")
+{
+    String src;
+    src.reserve(5000);
+    for (int i = 0; i < 5000; i++)
+        src += (char)('a' + i % 23);
+
+    // wide destination window: heap staging block
+    BytewiseSource source(src);
+    StreamString dest;
+    REQUIRE(source.sendAll(dest) == 5000);
+    REQUIRE(dest == src);
+
+    // narrow destination: stack buffer path, stops at the sink's capacity
+    char room[33];
+    FixedStreamString small(room, sizeof(room));
+    BytewiseSource source2(src);
+    REQUIRE(source2.sendSize(small, 100) == 32);
+    REQUIRE(memcmp(small.c_str(), src.c_str(), 32) == 0);
+}
+
+TEST_CASE("String allocator traffic is pinned", "[core][String]")
+{
+    // a short string lives in the SSO buffer, never touching the heap
+    CHECK_ALLOCATIONS(0)
+    {
+        String s("sso");
+        s += "fit";
+    }
+
+    // reserve() allocates once and the appends stay inside it
+    CHECK_ALLOCATIONS(1)
+    {
+        String s;
+        s.reserve(100);
+        for (int i = 0; i < 100; i++)
+            s += 'x';
+    }
+}
+
+TEST_CASE("StreamSend allocator traffic is pinned", "[core][Stream]")
+{
+    StreamString source;
+    source.reserve(200);
+    for (int i = 0; i < 200; i++)
+        source += (char)('a' + i % 23);
+
+    StreamString dest;
+    dest.reserve(256);
+
+    // both ends expose their buffers, so the transfer itself must not
+    // allocate; keep the assertions outside the counted block since the
+    // test framework itself may use the heap
+    size_t sent = 0;
+    CHECK_ALLOCATIONS(0)
+    {
+        sent = source.sendSize(dest, 200);
+    }
+    REQUIRE(sent == 200);
+    REQUIRE(dest.length() == 200);
+}
@@ -0,0 +1,72 @@
+/*
+ test_tokenlog.cpp - deferred tokenized logging tests
+ Copyright © 2026 esp8266/Arduino community
+ This file is part of the esp8266 core for Arduino environment.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <StreamString.h>
+#include <TokenLog.h>
+
+TEST_CASE("TokenLog defers formatting to drain time", "[core][TokenLog]")
+{
+    REQUIRE(tokenlog::begin(8));
+
+    REQUIRE(TLOG("plain\n"));
+    REQUIRE(TLOG("x=%u y=%d\n", 42u, -7));
+    CHECK(tokenlog::pending() == 2);
+
+    StreamString out;
+    CHECK(tokenlog::drain(out) == 2);
+    CHECK(out == String("plain\nx=42 y=-7\n"));
+    CHECK(tokenlog::pending() == 0);
+
+    tokenlog::end();
+    CHECK_FALSE(TLOG("after end\n"));
+}
+
+TEST_CASE("TokenLog raw records carry the token and argument words", "[core][TokenLog]")
+{
+    REQUIRE(tokenlog::begin(4));
+
+    PGM_P fmt = PSTR("a=%u b=%u c=%u\n");
+    REQUIRE(tokenlog::log(fmt, 1u, 2u, 3u));
+
+    tokenlog::Record rec;
+    REQUIRE(tokenlog::pop(rec));
+    CHECK(rec.fmt == fmt);
+    CHECK(rec.nargs == 3);
+    CHECK(rec.args[0] == 1);
+    CHECK(rec.args[1] == 2);
+    CHECK(rec.args[2] == 3);
+    CHECK_FALSE(tokenlog::pop(rec));
+
+    tokenlog::end();
+}
+
+TEST_CASE("TokenLog drops the newest record when full", "[core][TokenLog]")
+{
+    REQUIRE(tokenlog::begin(4));
+
+    for (int i = 0; i < 4; i++)
+        REQUIRE(TLOG("n=%d\n", i));
+    CHECK_FALSE(TLOG("n=%d\n", 4));
+    CHECK(tokenlog::dropped() == 1);
+    CHECK(tokenlog::pending() == 4);
+
+    StreamString out;
+    CHECK(tokenlog::drain(out) == 4);
+    CHECK(out == String("n=0\nn=1\nn=2\nn=3\n"));
+
+    tokenlog::end();
+}
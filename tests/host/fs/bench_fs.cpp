@@ -0,0 +1,223 @@
+/*
+ bench_fs.cpp - host side file system benchmarks
+
+ Measures open/read/write/seek/gc latency distributions for SPIFFS,
+ LittleFS and SDFS on top of the host mocks, with injectable flash
+ read/program/erase latencies (see common/flash_hal_mock.cpp) so the
+ numbers model real parts instead of host RAM speed.  The tests are
+ hidden from the default run; build and execute them with
+
+    make -C tests/host benchmark
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+*/
+
+#include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <FS.h>
+#include "../common/spiffs_mock.h"
+#include "../common/littlefs_mock.h"
+#include "../common/sdfs_mock.h"
+#include <spiffs/spiffs.h>
+#include <LittleFS.h>
+#include "../../../libraries/SDFS/src/SDFS.h"
+
+namespace fs_bench
+{
+
+// Latency models for representative SPI NOR parts.  read_byte covers the
+// SPI transfer cost of both read and program data phases.
+struct FlashModel
+{
+    const char* name;
+    uint32_t    readBaseNs;      // command + address phase per read
+    uint32_t    readByteNs;      // per byte on the bus
+    uint32_t    progPageUs;      // tPP, per 256-byte page
+    uint32_t    eraseSectorUs;   // tSE, per 4KB sector
+};
+
+static const FlashModel models[] = {
+    // Bus only, no array timing - isolates driver overhead
+    { "ideal", 0, 0, 0, 0 },
+    // Typical 40MHz QIO part (GD25Q32/W25Q32 class, datasheet typicals)
+    { "40MHz NOR", 2000, 200, 700, 45000 },
+    // Worst-case 20MHz DIO part at datasheet maximums
+    { "20MHz NOR slow", 4000, 400, 3000, 400000 },
+};
+
+static void applyModel(const FlashModel& m)
+{
+    s_flash_read_base_ns    = m.readBaseNs;
+    s_flash_read_byte_ns    = m.readByteNs;
+    s_flash_prog_page_us    = m.progPageUs;
+    s_flash_erase_sector_us = m.eraseSectorUs;
+    s_flash_time_ns         = 0;
+}
+
+// One latency distribution: simulated flash time plus host wall clock
+// (the wall clock column is what matters for the RAM-backed SDFS mock,
+// which bypasses the flash HAL entirely).
+struct Samples
+{
+    std::vector<uint64_t> flashNs;
+    std::vector<uint64_t> wallNs;
+
+    static uint64_t percentile(std::vector<uint64_t>& v, int p)
+    {
+        if (v.empty())
+        {
+            return 0;
+        }
+        std::sort(v.begin(), v.end());
+        return v[(v.size() - 1) * p / 100];
+    }
+
+    void report(const char* fsname, const char* model, const char* op)
+    {
+        printf("%-8s %-16s %-10s n=%4zu  flash p50=%8llu p99=%8llu max=%8llu us"
+               "  wall p50=%6llu max=%6llu us\n",
+               fsname, model, op, flashNs.size(),
+               (unsigned long long)(percentile(flashNs, 50) / 1000),
+               (unsigned long long)(percentile(flashNs, 99) / 1000),
+               (unsigned long long)(percentile(flashNs, 100) / 1000),
+               (unsigned long long)(percentile(wallNs, 50) / 1000),
+               (unsigned long long)(percentile(wallNs, 100) / 1000));
+    }
+};
+
+template <typename Op>
+static void measure(Samples& s, Op&& op)
+{
+    const uint64_t f0 = s_flash_time_ns;
+    const auto     w0 = std::chrono::steady_clock::now();
+    op();
+    const auto w1 = std::chrono::steady_clock::now();
+    s.flashNs.push_back(s_flash_time_ns - f0);
+    s.wallNs.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(w1 - w0).count());
+}
+
+// Common op mix run against every filesystem: 24 files of 4KB written in
+// 256-byte records, re-opened and read back sequentially, random seeks,
+// then half the files deleted and the space garbage collected.
+static void benchFS(FS& fs, const char* fsname, const char* model)
+{
+    constexpr int    files     = 24;
+    constexpr size_t recordLen = 256;
+    constexpr int    records   = 16;  // 4KB per file
+    uint8_t          buf[recordLen];
+    memset(buf, 0xa5, sizeof(buf));
+    char path[32];
+
+    Samples create, write, open, read, seek, gc;
+
+    for (int f = 0; f < files; f++)
+    {
+        snprintf(path, sizeof(path), "/bench%02d.bin", f);
+        File file;
+        measure(create, [&]() { file = fs.open(path, "w"); });
+        REQUIRE(file);
+        for (int r = 0; r < records; r++)
+        {
+            measure(write, [&]() { REQUIRE(file.write(buf, recordLen) == recordLen); });
+        }
+        file.close();
+    }
+    create.report(fsname, model, "create");
+    write.report(fsname, model, "write256");
+
+    for (int f = 0; f < files; f++)
+    {
+        snprintf(path, sizeof(path), "/bench%02d.bin", f);
+        File file;
+        measure(open, [&]() { file = fs.open(path, "r"); });
+        REQUIRE(file);
+        for (int r = 0; r < records; r++)
+        {
+            measure(read, [&]() { REQUIRE(file.read(buf, recordLen) == (int)recordLen); });
+        }
+        // Deterministic pseudo-random seek+read pattern
+        uint32_t rnd = 0x12345678 + f;
+        for (int r = 0; r < records; r++)
+        {
+            rnd = rnd * 1664525 + 1013904223;
+            const uint32_t pos = (rnd >> 8) % (records * recordLen - 64);
+            measure(seek, [&]() {
+                REQUIRE(file.seek(pos, SeekSet));
+                REQUIRE(file.read(buf, 64) == 64);
+            });
+        }
+        file.close();
+    }
+    open.report(fsname, model, "open");
+    read.report(fsname, model, "read256");
+    seek.report(fsname, model, "seek+64");
+
+    for (int f = 0; f < files; f += 2)
+    {
+        snprintf(path, sizeof(path), "/bench%02d.bin", f);
+        REQUIRE(fs.remove(path));
+    }
+    measure(gc, [&]() { fs.gc(); });
+    bool more = true;
+    while (more)
+    {
+        measure(gc, [&]() { more = fs.gcStep(5000); });
+    }
+    gc.report(fsname, model, "gc");
+}
+
+}  // namespace fs_bench
+
+using namespace fs_bench;
+
+TEST_CASE("Filesystem benchmark - SPIFFS", "[.][bench]")
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    for (auto& m : models)
+    {
+        SPIFFS_MOCK_DECLARE(512, 8, 512, "");
+        applyModel(m);
+        REQUIRE(SPIFFS.begin());
+        benchFS(SPIFFS, "SPIFFS", m.name);
+        SPIFFS.end();
+        applyModel(models[0]);
+    }
+#pragma GCC diagnostic pop
+}
+
+TEST_CASE("Filesystem benchmark - LittleFS", "[.][bench]")
+{
+    for (auto& m : models)
+    {
+        LITTLEFS_MOCK_DECLARE(512, 8, 512, "");
+        applyModel(m);
+        REQUIRE(LittleFS.begin());
+        benchFS(LittleFS, "LittleFS", m.name);
+        LittleFS.end();
+        applyModel(models[0]);
+    }
+}
+
+TEST_CASE("Filesystem benchmark - SDFS", "[.][bench]")
+{
+    // The SD mock is RAM-backed and does not go through the flash HAL, so
+    // only the wall clock column is meaningful here; it still exercises
+    // the FatLib + read-ahead paths with the same op mix.
+    SDFS_MOCK_DECLARE(512, 8, 512, "");
+    applyModel(models[0]);
+    REQUIRE(SDFS.begin());
+    benchFS(SDFS, "SDFS", "n/a");
+    SDFS.end();
+}
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+# Generate a compact on-device symbol table from the linked ELF
+#
+# Produces <out>: a binary table of {address, fnv1a(name)} pairs covering
+# the code segments, sorted by address, preceded by a small header with a
+# build id. Flashed to a spare region and registered with
+# postmortem_symtab_set(), it lets the postmortem report print
+# function-relative frames (see cores/esp8266/postmortem_symtab.h).
+# A <out>.txt dictionary maps the name hashes back to full symbol names on
+# the host.
+#
+# Copyright (C) 2026 - esp8266/Arduino community
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import argparse
+import os
+import struct
+import subprocess
+import sys
+
+sys.stdout = sys.stderr
+
+SYMTAB_MAGIC = 0x544D5953  # "SYMT"
+SYMTAB_VERSION = 1
+
+# IRAM and mapped flash; everything else is not executable
+CODE_RANGES = ((0x40100000, 0x40110000), (0x40200000, 0x40300000))
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def get_symbols(elf, path):
+    nm = os.path.join(path, "xtensa-lx106-elf-nm")
+    out = subprocess.check_output([nm, "-C", "--defined-only", elf])
+    seen = {}
+    for line in out.decode("utf-8", "ignore").splitlines():
+        parts = line.split(None, 2)
+        if len(parts) != 3:
+            continue
+        addr, kind, name = parts
+        if kind.lower() != "t":
+            continue
+        addr = int(addr, 16)
+        if not any(lo <= addr < hi for (lo, hi) in CODE_RANGES):
+            continue
+        if addr not in seen:
+            seen[addr] = name
+    return sorted(seen.items())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate on-device symbol table")
+    parser.add_argument("--elf", action="store", required=True, help="Linked ELF")
+    parser.add_argument("--path", action="store", required=True, help="Toolchain bin path")
+    parser.add_argument("--out", action="store", required=True, help="Output table file")
+    args = parser.parse_args()
+
+    syms = get_symbols(args.elf, args.path)
+
+    # build id over the sorted symbol list: stable for identical links,
+    # different whenever any function moves or changes name
+    build_id = fnv1a(
+        b"".join(("%08x %s\n" % (a, n)).encode("utf-8") for (a, n) in syms)
+    )
+
+    with open(args.out, "wb") as f:
+        f.write(struct.pack("<IIII", SYMTAB_MAGIC, SYMTAB_VERSION, len(syms), build_id))
+        for addr, name in syms:
+            f.write(struct.pack("<II", addr, fnv1a(name.encode("utf-8"))))
+
+    with open(args.out + ".txt", "w") as f:
+        f.write("# build-id %08x\n" % build_id)
+        for addr, name in syms:
+            f.write("%08x %08x %s\n" % (fnv1a(name.encode("utf-8")), addr, name))
+
+    print(
+        "Symbol table: %d functions, build id %08x, %d bytes"
+        % (len(syms), build_id, 16 + 8 * len(syms))
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
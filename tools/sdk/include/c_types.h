@@ -88,9 +88,16 @@ typedef enum {
 #define __ICACHE_STRINGIZE(A) __ICACHE_STRINGIZE_NX(A)
 #define ICACHE_FLASH_ATTR  __attribute__((section("\".irom0.text." __FILE__ "." __ICACHE_STRINGIZE(__LINE__) "." __ICACHE_STRINGIZE(__COUNTER__) "\"")))
 #define IRAM_ATTR __attribute__((section("\".iram.text." __FILE__ "." __ICACHE_STRINGIZE(__LINE__) "." __ICACHE_STRINGIZE(__COUNTER__) "\"")))
+// Prioritized IRAM placement: pri is a single digit, 0 (hottest, e.g. ISRs)
+// through 9 (nice to have).  The linker lays tiers out in ascending order at
+// the start of IRAM, so when space runs out the overflow lands in the highest
+// tiers and the per-function report (tools/sizes.py --iram-report) names the
+// demotion candidates.
+#define IRAM_HOT(pri) __attribute__((section("\".iram.text.hot." __ICACHE_STRINGIZE(pri) "." __FILE__ "." __ICACHE_STRINGIZE(__LINE__) "." __ICACHE_STRINGIZE(__COUNTER__) "\"")))
 #else
 #define ICACHE_FLASH_ATTR
 #define IRAM_ATTR
+#define IRAM_HOT(pri)
 #endif /* ICACHE_FLASH */
 
 // counterpart https://github.com/espressif/arduino-esp32/blob/master/cores/esp32/esp8266-compat.h
@@ -262,6 +262,9 @@ SECTIONS
 
   .text1 : ALIGN(4)
   {
+    /* IRAM_HOT(pri) tiers first, hottest (0) to coldest (9): the coldest
+       tier sits next to the overflow point when IRAM runs out */
+    *(SORT_BY_NAME(.iram.text.hot.*))
     *(.literal .text .iram.literal .iram.text .iram.text.* .literal.* .text.* .stub .gnu.warning .gnu.linkonce.literal.* .gnu.linkonce.t.*.literal .gnu.linkonce.t.*)
 #ifdef VTABLES_IN_IRAM
     *(.rodata._ZTV*) /* C++ vtables */
@@ -18,7 +18,9 @@
 # along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 import argparse
+import json
 import os
+import re
 import subprocess
 import sys
 import locale
@@ -99,6 +101,116 @@ def get_segment_sizes(elf, path, mmu):
     return sizes
 
 
+def get_iram_symbols(elf, path):
+    # IRAM (iram1_0_seg) lives at 0x40100000; everything below 0x40108000
+    # plus the optional MMU extension is code pinned with IRAM_ATTR/IRAM_HOT
+    iram_base = 0x40100000
+    iram_top = 0x40110000
+
+    symbols = []
+    cmd = [os.path.join(path, "xtensa-lx106-elf-nm"), "--print-size", "--radix=d", elf]
+    with subprocess.Popen(cmd, stdout=subprocess.PIPE, universal_newlines=True, encoding=get_encoding()) as proc:
+        for line in proc.stdout.readlines():
+            words = line.split()
+            if len(words) != 4:
+                continue
+            address, size, kind, name = words
+            if kind.lower() not in ("t", "w"):
+                continue
+            address = int(address)
+            if not (iram_base <= address < iram_top):
+                continue
+            symbols.append((int(size), name))
+
+    symbols.sort(reverse=True)
+    return symbols
+
+
+def get_duplicate_strings(elf, path):
+    # Post-link, PSTR literals (the *.irom0.pstr.* input sections) sit in
+    # .irom0.text; readelf -p lists the printable strings there, so any
+    # duplicates that survived the linker's SHF_MERGE folding can be
+    # totalled up.  Returns (wasted bytes, copies, text) tuples.
+    strings = {}
+    cmd = [os.path.join(path, "xtensa-lx106-elf-readelf"), "-p", ".irom0.text", elf]
+    with subprocess.Popen(cmd, stdout=subprocess.PIPE, universal_newlines=True, encoding=get_encoding()) as proc:
+        for line in proc.stdout.readlines():
+            # "  [offset]  contents"
+            bracket = line.find("]")
+            if not line.lstrip().startswith("[") or bracket < 0:
+                continue
+            text = line[bracket + 1 :].strip()
+            if len(text) < 4:
+                continue
+            strings[text] = strings.get(text, 0) + 1
+
+    duplicates = []
+    for text, count in strings.items():
+        if count > 1:
+            duplicates.append(((count - 1) * (len(text) + 1), count, text))
+
+    duplicates.sort(reverse=True)
+    return duplicates
+
+
+# input sections counted towards each budget; .rodata lives in DRAM on
+# the esp8266, so it belongs to RAM, not flash
+def classify_section(section):
+    if section == "COMMON" or section.startswith((".bss", ".data", ".rodata")):
+        return "RAM"
+    if section.startswith(".irom0.text"):
+        return "IROM"
+    if section.startswith((".text", ".iram")):
+        return "IRAM"
+    return None
+
+
+def library_name(origin):
+    # "path/libfoo.a(bar.cpp.o)" -> libfoo.a, bare objects keep their name
+    member = origin.rfind("(")
+    if member >= 0:
+        return os.path.basename(origin[:member])
+    return os.path.basename(origin)
+
+
+def get_library_sizes(map_path):
+    # Aggregate the linker map's per-input-section lines by originating
+    # archive/object. Section name and size/origin may share a line or
+    # span two, depending on the section name length.
+    contribution = re.compile(
+        r"^ (?P<section>\S+)?\s+0x[0-9a-f]+\s+0x(?P<size>[0-9a-f]+)\s+(?P<origin>\S.*\.o\)?)$"
+    )
+    libraries = {}
+    pending_section = None
+
+    with open(map_path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.rstrip()
+            if line.startswith(" .") or line.startswith(" COMMON"):
+                if " 0x" not in line:
+                    pending_section = line.strip()
+                    continue
+            match = contribution.match(line)
+            if not match:
+                pending_section = None
+                continue
+            section = match.group("section") or pending_section
+            pending_section = None
+            if not section:
+                continue
+            budget = classify_section(section)
+            if not budget:
+                continue
+            size = int(match.group("size"), 16)
+            if not size:
+                continue
+            library = library_name(match.group("origin"))
+            libraries.setdefault(library, {"RAM": 0, "IRAM": 0, "IROM": 0})
+            libraries[library][budget] += size
+
+    return libraries
+
+
 def percentage(lhs, rhs):
     return "{}%".format(int(100.0 * float(lhs) / float(rhs)))
 
@@ -164,6 +276,34 @@ def main():
     parser.add_argument(
         "-i", "--mmu", action="store", required=False, help="MMU build options"
     )
+    parser.add_argument(
+        "-r",
+        "--iram-report",
+        action="store",
+        type=int,
+        default=0,
+        required=False,
+        help="List the N largest functions occupying IRAM (0 disables)",
+    )
+    parser.add_argument(
+        "-s",
+        "--pstr-report",
+        action="store",
+        type=int,
+        default=0,
+        required=False,
+        help="List the N most duplicated flash string literals (0 disables)",
+    )
+    parser.add_argument(
+        "-m",
+        "--ram-report",
+        action="store",
+        type=int,
+        default=0,
+        required=False,
+        help="List the N libraries using the most RAM, with diffs against"
+        " the previous link (0 disables)",
+    )
 
     args = parser.parse_args()
     sizes = get_segment_sizes(args.elf, args.path, args.mmu)
@@ -183,6 +323,94 @@ def main():
                 print(f"{safe_prefix(n, number)} ", end="")
             print(f"{segment:<8} {size:<8} {HINTS[segment]:<16}")
 
+    if args.iram_report > 0:
+        symbols = get_iram_symbols(args.elf, args.path)
+        shown = symbols[: args.iram_report]
+        number = len(shown)
+
+        print(
+            f". IRAM budget, {number} largest of {len(symbols)} functions"
+            " (demote cold entries to free IRAM)"
+        )
+        try:
+            print("║   BYTES    FUNCTION")
+        except UnicodeEncodeError:
+            print("|   BYTES    FUNCTION")
+        for n, (size, name) in enumerate(shown, start=1):
+            try:
+                print(f"{prefix(n, number)} ", end="")
+            except UnicodeEncodeError:
+                print(f"{safe_prefix(n, number)} ", end="")
+            print(f"{size:<8} {name}")
+
+    if args.pstr_report > 0:
+        duplicates = get_duplicate_strings(args.elf, args.path)
+        wasted = sum(waste for waste, _, _ in duplicates)
+        shown = duplicates[: args.pstr_report]
+        number = len(shown)
+
+        print(
+            f". Flash strings, {len(duplicates)} duplicated literals waste"
+            f" {wasted} bytes (fold them with PSTR_DEDUP)"
+        )
+        try:
+            print("║   WASTE    COPIES   STRING")
+        except UnicodeEncodeError:
+            print("|   WASTE    COPIES   STRING")
+        for n, (waste, copies, text) in enumerate(shown, start=1):
+            if len(text) > 48:
+                text = text[:45] + "..."
+            try:
+                print(f"{prefix(n, number)} ", end="")
+            except UnicodeEncodeError:
+                print(f"{safe_prefix(n, number)} ", end="")
+            print(f"{waste:<8} {copies:<8} {text!r}")
+
+    if args.ram_report > 0:
+        map_path = os.path.splitext(args.elf)[0] + ".map"
+        snapshot_path = args.elf + ".ram.json"
+        if not os.path.exists(map_path):
+            print(f". RAM per library: no linker map at {map_path}")
+        else:
+            libraries = get_library_sizes(map_path)
+            previous = {}
+            try:
+                with open(snapshot_path, encoding="utf-8") as f:
+                    previous = json.load(f)
+            except (OSError, ValueError):
+                pass
+
+            ranked = sorted(
+                libraries.items(), key=lambda kv: kv[1]["RAM"], reverse=True
+            )
+            shown = ranked[: args.ram_report]
+            number = len(shown)
+
+            print(
+                ". RAM per library (data+rodata+bss),"
+                " delta vs previous link in parentheses"
+            )
+            try:
+                print("║   RAM      IRAM     IROM     LIBRARY")
+            except UnicodeEncodeError:
+                print("|   RAM      IRAM     IROM     LIBRARY")
+            for n, (library, sizes) in enumerate(shown, start=1):
+                delta = sizes["RAM"] - previous.get(library, {}).get("RAM", 0)
+                try:
+                    print(f"{prefix(n, number)} ", end="")
+                except UnicodeEncodeError:
+                    print(f"{safe_prefix(n, number)} ", end="")
+                print(
+                    f"{sizes['RAM']:<8} {sizes['IRAM']:<8} {sizes['IROM']:<8}"
+                    f" {library} ({delta:+d})"
+                )
+
+            try:
+                with open(snapshot_path, "w", encoding="utf-8") as f:
+                    json.dump(libraries, f)
+            except OSError:
+                pass
+
 
 if __name__ == "__main__":
     main()